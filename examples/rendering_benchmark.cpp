@@ -0,0 +1,2700 @@
+/*
+ * rendering_benchmark.cpp
+ *
+ * Headless CPU benchmarks for the RenderingPlugin components.
+ * Uses the LLGL Null renderer so only the CPU side of command recording is measured.
+ *
+ * Usage: rendering_benchmark [benchmark]
+ *   batch  - per-object draws vs. instanced batches for 10k-100k objects
+ *   queue  - sort-key render queue: sort time and binds saved vs. submission order
+ *   parallel - per-object recording of 100k objects on 1..N threads
+ *   frames - CPU wait per frame with 1..3 frames in flight
+ *   upload - per-draw matrix updates vs. one upload allocator write per frame
+ *   handles - resource lookup and churn: unordered_map vs. generational handle pool
+ *   scene  - frustum culling and draw list building for 100k-200k objects: AoS vs. SoA scene store
+ *   geocache - spawning 10k primitives: regenerate each vs. shared geometry cache
+ *   mesh   - large mesh load: regenerate vs. memory-mapped mesh file vs. raw file read
+ *   stream - texture streaming: blocking load vs. per-frame budgeted async creation
+ *   geometry - bounds, transform, normals and merge of a 4M vertex mesh: scalar vs. blocked vs. threaded
+ *   optimize - vertex cache ACMR/ATVR of shuffled meshes before and after MeshOptimizer
+ *   quantize - vertex memory, conversion time, accuracy and streaming reads: Vertex vs. QuantizedVertex, drawn with the decode block
+ *   shadercache - compiling 200 programs with a cold vs. warm on-disk shader cache
+ *   shaderparallel - compiling 200 programs serially vs. as a batch preprocessed in parallel vs. asynchronously
+ *   variants - startup compile cost of an 8-keyword shader: all 256 variants vs. lazy vs. precompile list
+ *   shaderkeys - program cache lookups for large shader sources: concatenated string keys vs. ShaderManager's hashed program cache
+ *   includes - expanding 500 shaders sharing an include tree: re-read per shader vs. include cache
+ *   lod    - triangles submitted for a deep scene: full detail vs. generated LOD chains
+ *   software - CPU rasterizer frame time at 1080p on 1..N threads
+ *   readback - frames per second read back at 1080p and 4K: blocking reads vs. staging buffer ring
+ *   farm   - thumbnail jobs per second: a renderer per job vs. one batch renderer, software and Null device
+ *   graph  - deferred frame as a render graph at 1080p and 4K: culled passes and transient memory with vs. without aliasing
+ *   gpucull - CPU cost of culling and drawing 10k-200k objects: SceneStore on the CPU vs. compute culling with indirect draws
+ */
+
+#include "AsyncResourceLoader.h"
+#include "BatchRenderer.h"
+#include "FrameReadback.h"
+#include "GeometryCache.h"
+#include "GeometryGenerator.h"
+#include "GpuCulling.h"
+#include "HandlePool.h"
+#include "LodChain.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+#include "ParallelCommandRecorder.h"
+#include "QuantizedMesh.h"
+#include "RenderCommands.h"
+#include "RenderGraph.h"
+#include "RenderQueue.h"
+#include "ResourceManager.h"
+#include "SceneStore.h"
+#include "ShaderIncludeCache.h"
+#include "ShaderManager.h"
+#include "ShaderVariants.h"
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+#include "UploadAllocator.h"
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace RenderingPlugin;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+const char* kVertexShader = R"(
+#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 4) in mat4 world;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+void main() {
+    gl_Position = projectionMatrix * viewMatrix * world * vec4(position, 1.0);
+}
+)";
+
+const char* kFragmentShader = R"(
+#version 330 core
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(1.0);
+}
+)";
+
+/**
+ * @brief Shared benchmark context: render system, command buffer and resource manager
+ */
+struct BenchmarkContext {
+    LLGL::RenderSystemPtr renderSystem;
+    LLGL::CommandBuffer* commandBuffer = nullptr;
+    std::unique_ptr<ResourceManager> resourceManager;
+    
+    bool Initialize() {
+        const char* modules[] = { "Null", "OpenGL" };
+        for (const char* module : modules) {
+            LLGL::Report report;
+            renderSystem = LLGL::RenderSystem::Load(module, &report);
+            if (renderSystem) {
+                std::cout << "Using LLGL renderer: " << module << std::endl;
+                break;
+            }
+        }
+        
+        if (!renderSystem) {
+            std::cerr << "No LLGL renderer available for benchmarking" << std::endl;
+            return false;
+        }
+        
+        commandBuffer = renderSystem->CreateCommandBuffer();
+        if (!commandBuffer) {
+            std::cerr << "Failed to create command buffer" << std::endl;
+            return false;
+        }
+        
+        resourceManager = std::make_unique<ResourceManager>(renderSystem.get());
+        return true;
+    }
+    
+    void Submit() {
+        renderSystem->GetCommandQueue()->Submit(*commandBuffer);
+        renderSystem->GetCommandQueue()->WaitIdle();
+    }
+};
+
+/**
+ * @brief Create a small set of meshes and pipelines shared by the benchmark objects
+ */
+bool CreateSceneResources(BenchmarkContext& context, std::vector<RenderObject>& prototypes, ResourceId& matrixBuffer) {
+    ResourceManager& resources = *context.resourceManager;
+    
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "position", LLGL::Format::RGB32Float });
+    vertexFormat.AppendAttribute({ "normal", LLGL::Format::RGB32Float });
+    vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float });
+    vertexFormat.AppendAttribute({ "color", LLGL::Format::RGB32Float });
+    
+    ResourceId vertexShader = resources.CreateShader(LLGL::ShaderType::Vertex, kVertexShader, "main");
+    ResourceId fragmentShader = resources.CreateShader(LLGL::ShaderType::Fragment, kFragmentShader, "main");
+    if (!vertexShader || !fragmentShader) {
+        return false;
+    }
+    
+    // Two pipelines (e.g. opaque and wireframe) to exercise state grouping
+    std::vector<ResourceId> pipelines;
+    for (LLGL::PolygonMode mode : { LLGL::PolygonMode::Fill, LLGL::PolygonMode::Wireframe }) {
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertexShader = resources.GetShader(vertexShader);
+        pipelineDesc.fragmentShader = resources.GetShader(fragmentShader);
+        pipelineDesc.rasterizer.polygonMode = mode;
+        pipelines.push_back(resources.CreateGraphicsPipelineState(pipelineDesc));
+    }
+    
+    // Four meshes of different sizes
+    for (std::uint32_t meshIndex = 0; meshIndex < 4; ++meshIndex) {
+        const std::uint32_t vertexCount = 24 * (meshIndex + 1);
+        std::vector<RenderingPlugin::Vertex> vertices(vertexCount);
+        std::vector<std::uint32_t> indices(vertexCount * 3 / 2);
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<std::uint32_t>(i % vertexCount);
+        }
+        
+        ResourceId vertexBuffer = resources.CreateVertexBuffer(vertices.data(), vertices.size() * sizeof(RenderingPlugin::Vertex), vertexFormat);
+        ResourceId indexBuffer = resources.CreateIndexBuffer(indices.data(), indices.size() * sizeof(std::uint32_t), LLGL::Format::R32UInt);
+        
+        for (ResourceId pipeline : pipelines) {
+            RenderObject prototype;
+            prototype.vertexBufferId = vertexBuffer;
+            prototype.indexBufferId = indexBuffer;
+            prototype.pipelineStateId = pipeline;
+            prototype.indexCount = static_cast<std::uint32_t>(indices.size());
+            prototypes.push_back(prototype);
+        }
+    }
+    
+    matrixBuffer = resources.CreateConstantBuffer(sizeof(Matrices));
+    return matrixBuffer != 0;
+}
+
+void PrintRow(const char* mode, std::size_t objectCount, const RenderCommandStats& stats, double frameMs) {
+    std::cout << std::left << std::setw(12) << mode
+              << std::right << std::setw(10) << objectCount
+              << std::setw(12) << stats.drawCalls
+              << std::setw(12) << stats.pipelineBinds
+              << std::setw(12) << stats.vertexBufferBinds
+              << std::setw(14) << std::fixed << std::setprecision(3) << frameMs << std::endl;
+}
+
+/**
+ * @brief Compare per-object draws against instanced batching
+ */
+int RunBatchBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    RenderCommands commands(context.commandBuffer, context.resourceManager.get());
+    commands.SetMatrixBuffer(matrixBuffer);
+    
+    const int framesPerRun = 5;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    
+    std::cout << std::endl << std::left << std::setw(12) << "mode"
+              << std::right << std::setw(10) << "objects"
+              << std::setw(12) << "draws"
+              << std::setw(12) << "pipelines"
+              << std::setw(12) << "vbBinds"
+              << std::setw(14) << "cpu ms/frame" << std::endl;
+    
+    for (std::size_t objectCount : { 10000u, 50000u, 100000u }) {
+        std::vector<RenderObject> objects(objectCount);
+        std::vector<Matrices> matrices(objectCount);
+        for (std::size_t i = 0; i < objectCount; ++i) {
+            objects[i] = prototypes[rng() % prototypes.size()];
+            matrices[i].world.At(0, 3) = position(rng);
+            matrices[i].world.At(1, 3) = position(rng);
+            matrices[i].world.At(2, 3) = position(rng);
+        }
+        
+        // Per-object: one state setup, matrix update and draw per object
+        double perObjectMs = 0.0;
+        RenderCommandStats perObjectStats;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            commands.ResetStatistics();
+            commands.BeginFrame();
+            auto start = Clock::now();
+            context.commandBuffer->Begin();
+            for (std::size_t i = 0; i < objectCount; ++i) {
+                commands.RenderObject(objects[i], matrices[i]);
+            }
+            context.commandBuffer->End();
+            perObjectMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            perObjectStats = commands.GetStatistics();
+            context.Submit();
+        }
+        PrintRow("per-object", objectCount, perObjectStats, perObjectMs / framesPerRun);
+        
+        // Batched: grouped by state, one instanced draw per group
+        double batchedMs = 0.0;
+        RenderCommandStats batchedStats;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            commands.ResetStatistics();
+            commands.BeginFrame();
+            auto start = Clock::now();
+            context.commandBuffer->Begin();
+            commands.BeginBatch(context.resourceManager->GetPipelineState(prototypes[0].pipelineStateId));
+            for (std::size_t i = 0; i < objectCount; ++i) {
+                commands.AddToBatch(objects[i], matrices[i].world);
+            }
+            commands.EndBatch(matrices[0].view, matrices[0].projection);
+            context.commandBuffer->End();
+            batchedMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            batchedStats = commands.GetStatistics();
+            context.Submit();
+        }
+        PrintRow("batched", objectCount, batchedStats, batchedMs / framesPerRun);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Measure sort-key ordering against recording packets in submission order
+ */
+int RunQueueBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    ResourceManager& resources = *context.resourceManager;
+    RenderCommands commands(context.commandBuffer, &resources);
+    RenderQueue queue;
+    
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+    
+    std::cout << std::endl << std::left << std::setw(10) << "packets"
+              << std::right << std::setw(14) << "unsorted"
+              << std::setw(14) << "sorted"
+              << std::setw(14) << "binds saved"
+              << std::setw(12) << "sort ms"
+              << std::setw(12) << "record ms" << std::endl;
+    
+    for (std::size_t packetCount : { 10000u, 50000u, 100000u }) {
+        std::vector<DrawPacket> packets(packetCount);
+        for (DrawPacket& packet : packets) {
+            const RenderObject& prototype = prototypes[rng() % prototypes.size()];
+            packet.pipelineState = resources.GetPipelineState(prototype.pipelineStateId);
+            packet.vertexBuffer = resources.GetVertexBuffer(prototype.vertexBufferId);
+            packet.indexBuffer = resources.GetIndexBuffer(prototype.indexBufferId);
+            packet.indexCount = prototype.indexCount;
+            packet.sortKey = RenderQueue::MakeSortKey(0,
+                                                      static_cast<std::uint16_t>(prototype.pipelineStateId),
+                                                      static_cast<std::uint16_t>(prototype.vertexBufferId),
+                                                      depth(rng));
+        }
+        
+        // Baseline: every key identical, so packets are recorded in submission order
+        for (DrawPacket packet : packets) {
+            packet.sortKey = 0;
+            queue.Submit(packet);
+        }
+        commands.ResetStatistics();
+        context.commandBuffer->Begin();
+        queue.Flush(commands);
+        context.commandBuffer->End();
+        context.Submit();
+        const RenderQueueStats unsorted = queue.GetStatistics();
+        
+        for (const DrawPacket& packet : packets) {
+            queue.Submit(packet);
+        }
+        commands.ResetStatistics();
+        context.commandBuffer->Begin();
+        queue.Flush(commands);
+        context.commandBuffer->End();
+        context.Submit();
+        const RenderQueueStats sorted = queue.GetStatistics();
+        
+        const std::uint32_t unsortedBinds = unsorted.pipelineBinds + unsorted.vertexBufferBinds + unsorted.indexBufferBinds;
+        const std::uint32_t sortedBinds = sorted.pipelineBinds + sorted.vertexBufferBinds + sorted.indexBufferBinds;
+        std::cout << std::left << std::setw(10) << packetCount
+                  << std::right << std::setw(14) << unsortedBinds
+                  << std::setw(14) << sortedBinds
+                  << std::setw(14) << sorted.bindsSaved
+                  << std::setw(12) << std::fixed << std::setprecision(3) << sorted.sortTimeMs
+                  << std::setw(12) << sorted.recordTimeMs << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Measure how command recording scales with worker threads
+ */
+int RunParallelBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    const std::size_t objectCount = 100000;
+    const int framesPerRun = 5;
+    
+    std::mt19937 rng(1234);
+    std::vector<RenderObject> objects(objectCount);
+    std::vector<Matrices> matrices(objectCount);
+    for (std::size_t i = 0; i < objectCount; ++i) {
+        objects[i] = prototypes[rng() % prototypes.size()];
+    }
+    
+    std::cout << std::endl << std::left << std::setw(10) << "threads"
+              << std::right << std::setw(10) << "chunks"
+              << std::setw(14) << "wall ms"
+              << std::setw(14) << "chunk sum ms"
+              << std::setw(14) << "slowest ms" << std::endl;
+    
+    const std::size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        ThreadPool threadPool(threadCount);
+        ParallelCommandRecorder recorder(context.renderSystem.get(), context.resourceManager.get(), &threadPool);
+        recorder.SetMatrixBuffer(matrixBuffer);
+        
+        ParallelRecordStats average;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            recorder.Record(objectCount, [&objects, &matrices](RenderCommands& commands, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    commands.RenderObject(objects[i], matrices[i]);
+                }
+            });
+            
+            context.commandBuffer->Begin();
+            recorder.Execute(*context.commandBuffer);
+            context.commandBuffer->End();
+            context.Submit();
+            
+            const ParallelRecordStats& stats = recorder.GetStatistics();
+            average.chunkCount = stats.chunkCount;
+            average.wallTimeMs += stats.wallTimeMs / framesPerRun;
+            average.totalChunkTimeMs += stats.totalChunkTimeMs / framesPerRun;
+            average.maxChunkTimeMs += stats.maxChunkTimeMs / framesPerRun;
+        }
+        
+        std::cout << std::left << std::setw(10) << threadCount
+                  << std::right << std::setw(10) << average.chunkCount
+                  << std::setw(14) << std::fixed << std::setprecision(3) << average.wallTimeMs
+                  << std::setw(14) << average.totalChunkTimeMs
+                  << std::setw(14) << average.maxChunkTimeMs << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Measure CPU wait per frame with fenced frames in flight
+ * @details Mirrors RenderingSystem's frame loop: each slot owns a command buffer, a fence,
+ *          a constant buffer ring slot and an instance stream, and the CPU only waits when
+ *          it wraps around to a slot the GPU may still be using.
+ */
+int RunFramesBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    ResourceManager& resources = *context.resourceManager;
+    LLGL::CommandQueue* commandQueue = context.renderSystem->GetCommandQueue();
+    
+    const std::size_t objectCount = 50000;
+    const int frameCount = 60;
+    
+    std::mt19937 rng(1234);
+    std::vector<RenderObject> objects(objectCount);
+    std::vector<Matrices> matrices(objectCount);
+    for (std::size_t i = 0; i < objectCount; ++i) {
+        objects[i] = prototypes[rng() % prototypes.size()];
+    }
+    
+    std::cout << std::endl << std::left << std::setw(10) << "in flight"
+              << std::right << std::setw(14) << "wait ms"
+              << std::setw(14) << "max wait ms"
+              << std::setw(14) << "frame ms" << std::endl;
+    
+    for (std::uint32_t framesInFlight = 1; framesInFlight <= 3; ++framesInFlight) {
+        std::vector<LLGL::CommandBuffer*> commandBuffers(framesInFlight);
+        std::vector<LLGL::Fence*> fences(framesInFlight);
+        std::vector<bool> submitted(framesInFlight, false);
+        for (std::uint32_t i = 0; i < framesInFlight; ++i) {
+            commandBuffers[i] = context.renderSystem->CreateCommandBuffer();
+            fences[i] = context.renderSystem->CreateFence();
+        }
+        
+        ResourceId matrixRing = resources.CreateConstantBufferRing(sizeof(Matrices), framesInFlight);
+        RenderCommands commands(commandBuffers[0], &resources);
+        
+        double totalWaitMs = 0.0;
+        double maxWaitMs = 0.0;
+        auto runStart = Clock::now();
+        
+        for (int frame = 0; frame < frameCount; ++frame) {
+            const std::uint32_t slot = static_cast<std::uint32_t>(frame) % framesInFlight;
+            
+            auto waitStart = Clock::now();
+            if (submitted[slot]) {
+                commandQueue->WaitFence(*fences[slot], ~0ull);
+            }
+            const double waitMs = std::chrono::duration<double, std::milli>(Clock::now() - waitStart).count();
+            totalWaitMs += waitMs;
+            maxWaitMs = std::max(maxWaitMs, waitMs);
+            
+            // Record into this slot's command buffer, matrix buffer and instance stream
+            commands.SetCommandBuffer(commandBuffers[slot]);
+            commands.SetMatrixBuffer(resources.GetConstantBufferRing(matrixRing, slot));
+            commands.BeginFrame(slot);
+            commandBuffers[slot]->Begin();
+            commands.BeginBatch(resources.GetPipelineState(prototypes[0].pipelineStateId));
+            for (std::size_t i = 0; i < objectCount; ++i) {
+                commands.AddToBatch(objects[i], matrices[i].world);
+            }
+            commands.EndBatch(matrices[0].view, matrices[0].projection);
+            commandBuffers[slot]->End();
+            
+            commandQueue->Submit(*commandBuffers[slot]);
+            commandQueue->Submit(*fences[slot]);
+            submitted[slot] = true;
+        }
+        
+        commandQueue->WaitIdle();
+        const double frameMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count() / frameCount;
+        
+        std::cout << std::left << std::setw(10) << framesInFlight
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(3) << totalWaitMs / frameCount
+                  << std::setw(14) << maxWaitMs
+                  << std::setw(14) << frameMs << std::endl;
+        
+        resources.ReleaseBuffer(matrixRing);
+        for (std::uint32_t i = 0; i < framesInFlight; ++i) {
+            context.renderSystem->Release(*fences[i]);
+            context.renderSystem->Release(*commandBuffers[i]);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Compare per-draw matrix buffer updates against the upload allocator
+ */
+int RunUploadBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    ResourceManager& resources = *context.resourceManager;
+    
+    // Layout whose only heap binding is the per-draw Matrices block
+    LLGL::PipelineLayoutDescriptor layoutDesc;
+    layoutDesc.heapBindings = {
+        LLGL::BindingDescriptor{ "Matrices", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer,
+                                 LLGL::StageFlags::VertexStage, 0 }
+    };
+    LLGL::PipelineLayout* matrixLayout = resources.GetPipelineLayout(resources.CreatePipelineLayout(layoutDesc));
+    if (!matrixLayout) {
+        std::cerr << "Failed to create matrix pipeline layout" << std::endl;
+        return 1;
+    }
+    
+    const int framesPerRun = 5;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    
+    std::cout << std::endl << std::left << std::setw(12) << "mode"
+              << std::right << std::setw(10) << "objects"
+              << std::setw(12) << "updates"
+              << std::setw(12) << "writes"
+              << std::setw(14) << "bytes"
+              << std::setw(14) << "cpu ms/frame" << std::endl;
+    
+    for (std::size_t objectCount : { 1000u, 10000u, 50000u }) {
+        std::vector<RenderObject> objects(objectCount);
+        std::vector<Matrices> matrices(objectCount);
+        for (std::size_t i = 0; i < objectCount; ++i) {
+            objects[i] = prototypes[rng() % prototypes.size()];
+            matrices[i].world.At(0, 3) = position(rng);
+        }
+        
+        RenderCommands commands(context.commandBuffer, &resources);
+        commands.SetMatrixBuffer(matrixBuffer);
+        
+        // Per-draw: one command buffer update of the shared matrix buffer per object
+        double updateMs = 0.0;
+        RenderCommandStats updateStats;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            commands.ResetStatistics();
+            commands.BeginFrame();
+            auto start = Clock::now();
+            context.commandBuffer->Begin();
+            for (std::size_t i = 0; i < objectCount; ++i) {
+                commands.RenderObject(objects[i], matrices[i]);
+            }
+            context.commandBuffer->End();
+            updateMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            updateStats = commands.GetStatistics();
+            context.Submit();
+        }
+        
+        std::cout << std::left << std::setw(12) << "per-draw"
+                  << std::right << std::setw(10) << objectCount
+                  << std::setw(12) << updateStats.bufferUpdates
+                  << std::setw(12) << updateStats.bufferUpdates
+                  << std::setw(14) << updateStats.bufferUpdates * sizeof(Matrices)
+                  << std::setw(14) << std::fixed << std::setprecision(3) << updateMs / framesPerRun << std::endl;
+        
+        // Upload allocator: per-draw blocks bump-allocated and written once per frame
+        UploadAllocator allocator(context.renderSystem.get(), objectCount * 256 + 65536, 1);
+        if (!commands.SetUploadAllocator(&allocator, matrixLayout)) {
+            std::cout << "Matrix blocks need slot-based bindings, skipping the allocator row" << std::endl;
+            continue;
+        }
+        
+        double uploadMs = 0.0;
+        UploadAllocatorStats uploadStats;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            commands.ResetStatistics();
+            commands.BeginFrame();
+            allocator.BeginFrame(0);
+            auto start = Clock::now();
+            context.commandBuffer->Begin();
+            for (std::size_t i = 0; i < objectCount; ++i) {
+                commands.RenderObject(objects[i], matrices[i]);
+            }
+            context.commandBuffer->End();
+            allocator.Flush();
+            uploadMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            uploadStats = allocator.GetStatistics();
+            context.Submit();
+        }
+        
+        std::cout << std::left << std::setw(12) << "allocator"
+                  << std::right << std::setw(10) << objectCount
+                  << std::setw(12) << uploadStats.allocations
+                  << std::setw(12) << uploadStats.bufferWrites
+                  << std::setw(14) << uploadStats.bytesFlushed
+                  << std::setw(14) << std::fixed << std::setprecision(3) << uploadMs / framesPerRun << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Compare the previous unordered_map resource tables against HandlePool
+ */
+int RunHandlesBenchmark() {
+    const std::size_t resourceCount = 10000;
+    const std::size_t lookupCount = 10000000;
+    const std::size_t churnCount = 1000000;
+    
+    std::mt19937 rng(1234);
+    std::vector<LLGL::Buffer*> values(resourceCount);
+    for (std::size_t i = 0; i < resourceCount; ++i) {
+        values[i] = reinterpret_cast<LLGL::Buffer*>((i + 1) * 16);
+    }
+    
+    std::unordered_map<ResourceId, LLGL::Buffer*> map;
+    std::vector<ResourceId> mapIds;
+    for (std::size_t i = 0; i < resourceCount; ++i) {
+        const ResourceId id = static_cast<ResourceId>(i + 1);
+        map[id] = values[i];
+        mapIds.push_back(id);
+    }
+    
+    HandlePool<LLGL::Buffer*> pool(1);
+    std::vector<ResourceId> poolIds;
+    for (std::size_t i = 0; i < resourceCount; ++i) {
+        poolIds.push_back(pool.Insert(values[i]));
+    }
+    
+    std::vector<std::uint32_t> order(lookupCount);
+    for (std::uint32_t& index : order) {
+        index = static_cast<std::uint32_t>(rng() % resourceCount);
+    }
+    
+    // Random lookups, as done by every draw resolving its buffers and pipeline
+    std::uintptr_t checksum = 0;
+    auto start = Clock::now();
+    for (std::uint32_t index : order) {
+        auto it = map.find(mapIds[index]);
+        checksum += reinterpret_cast<std::uintptr_t>(it != map.end() ? it->second : nullptr);
+    }
+    const double mapLookupMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    start = Clock::now();
+    for (std::uint32_t index : order) {
+        LLGL::Buffer* const* entry = pool.Get(poolIds[index]);
+        checksum += reinterpret_cast<std::uintptr_t>(entry ? *entry : nullptr);
+    }
+    const double poolLookupMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    // Churn: release a random resource and create a replacement
+    ResourceId nextMapId = static_cast<ResourceId>(resourceCount + 1);
+    start = Clock::now();
+    for (std::size_t i = 0; i < churnCount; ++i) {
+        const std::size_t index = order[i % lookupCount];
+        map.erase(mapIds[index]);
+        mapIds[index] = nextMapId++;
+        map[mapIds[index]] = values[index];
+    }
+    const double mapChurnMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    std::size_t staleRejected = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < churnCount; ++i) {
+        const std::size_t index = order[i % lookupCount];
+        const ResourceId released = poolIds[index];
+        pool.Erase(released);
+        poolIds[index] = pool.Insert(values[index]);
+        staleRejected += pool.Contains(released) ? 0 : 1;
+    }
+    const double poolChurnMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    std::cout << std::endl << std::left << std::setw(16) << "table"
+              << std::right << std::setw(16) << "lookup ns"
+              << std::setw(16) << "churn ns" << std::endl;
+    std::cout << std::left << std::setw(16) << "unordered_map"
+              << std::right << std::setw(16) << std::fixed << std::setprecision(2) << mapLookupMs * 1e6 / lookupCount
+              << std::setw(16) << mapChurnMs * 1e6 / churnCount << std::endl;
+    std::cout << std::left << std::setw(16) << "HandlePool"
+              << std::right << std::setw(16) << poolLookupMs * 1e6 / lookupCount
+              << std::setw(16) << poolChurnMs * 1e6 / churnCount << std::endl;
+    std::cout << "Stale handles rejected: " << staleRejected << "/" << churnCount
+              << " (checksum " << (checksum & 0xFFFF) << ")" << std::endl;
+    
+    return 0;
+}
+
+/**
+ * @brief Scalar mesh kernels as GeometryGenerator implemented them before the chunked versions
+ */
+void ReferenceBounds(const MeshData& mesh, Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds) {
+    minBounds = mesh.vertices[0].position;
+    maxBounds = mesh.vertices[0].position;
+    for (const auto& vertex : mesh.vertices) {
+        if (vertex.position.x < minBounds.x) minBounds.x = vertex.position.x;
+        if (vertex.position.y < minBounds.y) minBounds.y = vertex.position.y;
+        if (vertex.position.z < minBounds.z) minBounds.z = vertex.position.z;
+        if (vertex.position.x > maxBounds.x) maxBounds.x = vertex.position.x;
+        if (vertex.position.y > maxBounds.y) maxBounds.y = vertex.position.y;
+        if (vertex.position.z > maxBounds.z) maxBounds.z = vertex.position.z;
+    }
+}
+
+void ReferenceTransform(MeshData& mesh, const Gs::Matrix4f& transform) {
+    for (auto& vertex : mesh.vertices) {
+        const Gs::Vector3f p = vertex.position;
+        const Gs::Vector3f n = vertex.normal;
+        vertex.position = {
+            transform.At(0, 0) * p.x + transform.At(0, 1) * p.y + transform.At(0, 2) * p.z + transform.At(0, 3),
+            transform.At(1, 0) * p.x + transform.At(1, 1) * p.y + transform.At(1, 2) * p.z + transform.At(1, 3),
+            transform.At(2, 0) * p.x + transform.At(2, 1) * p.y + transform.At(2, 2) * p.z + transform.At(2, 3)
+        };
+        Gs::Vector3f normal = {
+            transform.At(0, 0) * n.x + transform.At(0, 1) * n.y + transform.At(0, 2) * n.z,
+            transform.At(1, 0) * n.x + transform.At(1, 1) * n.y + transform.At(1, 2) * n.z,
+            transform.At(2, 0) * n.x + transform.At(2, 1) * n.y + transform.At(2, 2) * n.z
+        };
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (length > 0.0f) {
+            normal = { normal.x / length, normal.y / length, normal.z / length };
+        }
+        vertex.normal = normal;
+    }
+}
+
+MeshData ReferenceMerge(const MeshData* meshes, std::size_t meshCount) {
+    MeshData result;
+    std::uint32_t vertexOffset = 0;
+    for (std::size_t i = 0; i < meshCount; ++i) {
+        result.vertices.insert(result.vertices.end(), meshes[i].vertices.begin(), meshes[i].vertices.end());
+        for (std::uint32_t index : meshes[i].indices) {
+            result.indices.push_back(index + vertexOffset);
+        }
+        vertexOffset += static_cast<std::uint32_t>(meshes[i].vertices.size());
+    }
+    return result;
+}
+
+void ReferenceNormals(MeshData& mesh) {
+    for (auto& vertex : mesh.vertices) {
+        vertex.normal = { 0.0f, 0.0f, 0.0f };
+    }
+    for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        auto& v0 = mesh.vertices[mesh.indices[i]];
+        auto& v1 = mesh.vertices[mesh.indices[i + 1]];
+        auto& v2 = mesh.vertices[mesh.indices[i + 2]];
+        const Gs::Vector3f e1 = v1.position - v0.position;
+        const Gs::Vector3f e2 = v2.position - v0.position;
+        Gs::Vector3f normal = { e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+        const float faceLength = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (faceLength > 0.0f) {
+            normal = { normal.x / faceLength, normal.y / faceLength, normal.z / faceLength };
+        }
+        v0.normal = v0.normal + normal;
+        v1.normal = v1.normal + normal;
+        v2.normal = v2.normal + normal;
+    }
+    for (auto& vertex : mesh.vertices) {
+        const Gs::Vector3f& n = vertex.normal;
+        const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        if (length > 0.0f) {
+            vertex.normal = { n.x / length, n.y / length, n.z / length };
+        }
+    }
+}
+
+/**
+ * @brief Compare the scalar mesh kernels against the blocked and multi-threaded GeometryGenerator versions
+ */
+int RunGeometryBenchmark() {
+    const std::uint32_t segments = 1999;
+    const int iterations = 3;
+    
+    MeshData mesh = GeometryGenerator::GeneratePlane(10.0f, 10.0f, segments, segments);
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> height(-0.25f, 0.25f);
+    for (auto& vertex : mesh.vertices) {
+        vertex.position.y = height(rng);
+    }
+    std::cout << "Mesh: " << mesh.GetVertexCount() << " vertices, " << mesh.GetIndexCount() / 3 << " triangles" << std::endl;
+    
+    Gs::Matrix4f transform;
+    transform.LoadIdentity();
+    transform.At(0, 0) = 0.8f;
+    transform.At(0, 2) = -0.6f;
+    transform.At(2, 0) = 0.6f;
+    transform.At(2, 2) = 0.8f;
+    transform.At(0, 3) = 1.0f;
+    transform.At(1, 3) = 2.0f;
+    
+    ThreadPool pool;
+    
+    // Best of several runs; every run works on a fresh copy where the kernel modifies the mesh
+    auto measure = [&](const std::function<void(MeshData&)>& kernel) {
+        double best = 0.0;
+        for (int i = 0; i < iterations; ++i) {
+            MeshData copy = mesh;
+            const auto start = Clock::now();
+            kernel(copy);
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            best = (i == 0) ? ms : std::min(best, ms);
+        }
+        return best;
+    };
+    
+    struct Row {
+        const char* name;
+        double referenceMs;
+        double serialMs;
+        double parallelMs;
+    };
+    std::vector<Row> rows;
+    
+    Gs::Vector3f minBounds, maxBounds;
+    rows.push_back({ "bounds",
+        measure([&](MeshData& m) { ReferenceBounds(m, minBounds, maxBounds); }),
+        measure([&](MeshData& m) { GeometryGenerator::CalculateBounds(m, minBounds, maxBounds); }),
+        measure([&](MeshData& m) { GeometryGenerator::CalculateBounds(m, minBounds, maxBounds, &pool); }) });
+    
+    rows.push_back({ "transform",
+        measure([&](MeshData& m) { ReferenceTransform(m, transform); }),
+        measure([&](MeshData& m) { GeometryGenerator::TransformMesh(m, transform); }),
+        measure([&](MeshData& m) { GeometryGenerator::TransformMesh(m, transform, &pool); }) });
+    
+    rows.push_back({ "normals",
+        measure([&](MeshData& m) { ReferenceNormals(m); }),
+        measure([&](MeshData& m) { GeometryGenerator::GenerateNormals(m); }),
+        measure([&](MeshData& m) { GeometryGenerator::GenerateNormals(m, true, &pool); }) });
+    
+    const MeshData parts[4] = { mesh, mesh, mesh, mesh };
+    std::size_t mergedIndices = 0;
+    rows.push_back({ "merge x4",
+        measure([&](MeshData&) { mergedIndices = ReferenceMerge(parts, 4).indices.size(); }),
+        measure([&](MeshData&) { mergedIndices = GeometryGenerator::MergeMeshes(parts, 4).indices.size(); }),
+        measure([&](MeshData&) { mergedIndices = GeometryGenerator::MergeMeshes(parts, 4, &pool).indices.size(); }) });
+    
+    std::cout << std::endl << std::left << std::setw(12) << "kernel"
+              << std::right << std::setw(16) << "scalar ms"
+              << std::setw(16) << "blocked ms"
+              << std::setw(16) << "threads ms"
+              << std::setw(12) << "speedup" << std::endl;
+    for (const Row& row : rows) {
+        std::cout << std::left << std::setw(12) << row.name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(16) << row.referenceMs
+                  << std::setw(16) << row.serialMs
+                  << std::setw(16) << row.parallelMs
+                  << std::setw(11) << row.referenceMs / row.parallelMs << "x" << std::endl;
+    }
+    std::cout << "Threads: " << pool.GetThreadCount() << ", merged indices: " << mergedIndices << std::endl;
+    
+    return 0;
+}
+
+/**
+ * @brief Measure vertex cache efficiency of shuffled meshes before and after MeshOptimizer
+ */
+int RunOptimizeBenchmark() {
+    struct Case {
+        const char* name;
+        MeshData mesh;
+    };
+    std::vector<Case> cases;
+    cases.push_back({ "plane", GeometryGenerator::GeneratePlane(10.0f, 10.0f, 700, 700) });
+    cases.push_back({ "sphere", GeometryGenerator::GenerateSphere(1.0f, 512, 256) });
+    cases.push_back({ "torus", GeometryGenerator::GenerateTorus(1.0f, 0.3f, 512, 256) });
+    
+    std::cout << std::endl << std::left << std::setw(10) << "mesh"
+              << std::right << std::setw(12) << "triangles"
+              << std::setw(12) << "ACMR in"
+              << std::setw(12) << "ACMR out"
+              << std::setw(12) << "ATVR in"
+              << std::setw(12) << "ATVR out"
+              << std::setw(12) << "vertices"
+              << std::setw(12) << "ms" << std::endl;
+    
+    std::mt19937 rng(42);
+    for (Case& test : cases) {
+        // Imported meshes often arrive in arbitrary triangle order; the generators are already fairly coherent
+        MeshData& mesh = test.mesh;
+        std::vector<std::uint32_t> order(mesh.GetTriangleCount());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            order[i] = static_cast<std::uint32_t>(i);
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        
+        std::vector<std::uint32_t> shuffled;
+        shuffled.reserve(mesh.indices.size());
+        for (std::uint32_t triangle : order) {
+            shuffled.insert(shuffled.end(), mesh.indices.begin() + triangle * 3, mesh.indices.begin() + triangle * 3 + 3);
+        }
+        mesh.indices.swap(shuffled);
+        
+        const MeshOptimizerStats stats = MeshOptimizer::Optimize(mesh);
+        std::cout << std::left << std::setw(10) << test.name
+                  << std::right << std::setw(12) << mesh.GetTriangleCount()
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << stats.before.acmr
+                  << std::setw(12) << stats.after.acmr
+                  << std::setw(12) << stats.before.atvr
+                  << std::setw(12) << stats.after.atvr
+                  << std::setw(12) << stats.vertexCountAfter
+                  << std::setprecision(1) << std::setw(12) << stats.optimizeMs << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Compare vertex memory, accuracy and streaming reads of the standard and quantized layouts
+ * @details Each quantized mesh is also drawn once with the built-in quantized shader and its
+ *          QuantizedDecode block; "block err" decodes positions the way that shader does.
+ */
+int RunQuantizeBenchmark(BenchmarkContext& context) {
+    ResourceManager& resources = *context.resourceManager;
+    
+    // Layout whose only heap binding is the per-mesh QuantizedDecode block
+    LLGL::PipelineLayoutDescriptor layoutDesc;
+    layoutDesc.heapBindings = {
+        LLGL::BindingDescriptor{ "QuantizedDecode", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer,
+                                 LLGL::StageFlags::VertexStage, 1 }
+    };
+    LLGL::PipelineLayout* decodeLayout = resources.GetPipelineLayout(resources.CreatePipelineLayout(layoutDesc));
+    
+    ShaderManager shaderManager(context.renderSystem.get(), &resources);
+    ResourceId vertexShader = resources.CreateShader(LLGL::ShaderType::Vertex,
+                                                     shaderManager.GetBuiltInShader("quantized_vertex"), "main");
+    ResourceId fragmentShader = resources.CreateShader(LLGL::ShaderType::Fragment, kFragmentShader, "main");
+    if (!decodeLayout || !vertexShader || !fragmentShader) {
+        std::cerr << "Failed to create quantized pipeline resources" << std::endl;
+        return 1;
+    }
+    
+    LLGL::GraphicsPipelineDescriptor pipelineDesc;
+    pipelineDesc.pipelineLayout = decodeLayout;
+    pipelineDesc.vertexShader = resources.GetShader(vertexShader);
+    pipelineDesc.fragmentShader = resources.GetShader(fragmentShader);
+    LLGL::PipelineState* pipeline = resources.GetPipelineState(resources.CreateGraphicsPipelineState(pipelineDesc));
+    if (!pipeline) {
+        std::cerr << "Failed to create quantized pipeline" << std::endl;
+        return 1;
+    }
+    
+    struct Case {
+        const char* name;
+        MeshData mesh;
+    };
+    std::vector<Case> cases;
+    cases.push_back({ "plane", GeometryGenerator::GeneratePlane(100.0f, 100.0f, 1000, 1000) });
+    cases.push_back({ "sphere", GeometryGenerator::GenerateSphere(1.0f, 1024, 512) });
+    cases.push_back({ "torus", GeometryGenerator::GenerateTorus(1.0f, 0.3f, 1024, 512) });
+    const int iterations = 10;
+    double checksum = 0.0;
+    
+    std::cout << std::endl << std::left << std::setw(10) << "mesh"
+              << std::right << std::setw(12) << "vertices"
+              << std::setw(10) << "MB in"
+              << std::setw(10) << "MB out"
+              << std::setw(10) << "ratio"
+              << std::setw(12) << "encode ms"
+              << std::setw(12) << "pos err"
+              << std::setw(12) << "nrm deg"
+              << std::setw(12) << "block err"
+              << std::setw(12) << "read ms"
+              << std::setw(12) << "read q ms" << std::endl;
+    
+    for (Case& test : cases) {
+        const MeshData& mesh = test.mesh;
+        
+        auto start = Clock::now();
+        const QuantizedMeshData quantized = VertexQuantizer::Quantize(mesh);
+        const double encodeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        const MeshData decoded = VertexQuantizer::Dequantize(quantized);
+        float positionError = 0.0f;
+        float normalCos = 1.0f;
+        for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+            const auto& original = mesh.vertices[i];
+            const auto& restored = decoded.vertices[i];
+            positionError = std::max(positionError, std::abs(original.position.x - restored.position.x));
+            positionError = std::max(positionError, std::abs(original.position.y - restored.position.y));
+            positionError = std::max(positionError, std::abs(original.position.z - restored.position.z));
+            normalCos = std::min(normalCos, original.normal.x * restored.normal.x +
+                                            original.normal.y * restored.normal.y +
+                                            original.normal.z * restored.normal.z);
+        }
+        const double normalDegrees = std::acos(std::min(1.0, static_cast<double>(normalCos))) * 180.0 / 3.14159265358979;
+        
+        // Decode as the quantized vertex shader does, from the block contents and the unorm attribute
+        const QuantizedDecodeParams decodeParams = VertexQuantizer::GetDecodeParams(quantized);
+        float blockError = 0.0f;
+        for (std::size_t i = 0; i < quantized.vertices.size(); ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                const float unorm = static_cast<float>(quantized.vertices[i].position[axis]) / 65535.0f;
+                const float position = decodeParams.positionOffset[axis] + decodeParams.positionScale[axis] * unorm;
+                blockError = std::max(blockError, std::abs(position - decoded.vertices[i].position[axis]));
+            }
+        }
+        
+        // Draw the mesh with its decode block bound in the resource heap
+        ResourceId vertexBuffer = 0;
+        ResourceId indexBuffer = 0;
+        ResourceId decodeBuffer = VertexQuantizer::CreateDecodeBuffer(quantized, resources);
+        if (!decodeBuffer || !VertexQuantizer::CreateBuffers(quantized, resources, vertexBuffer, indexBuffer)) {
+            std::cerr << "Failed to create quantized mesh buffers" << std::endl;
+            return 1;
+        }
+        LLGL::ResourceHeapDescriptor heapDesc;
+        heapDesc.pipelineLayout = decodeLayout;
+        heapDesc.numResourceViews = 1;
+        const std::vector<LLGL::ResourceViewDescriptor> resourceViews = { resources.GetConstantBuffer(decodeBuffer) };
+        LLGL::ResourceHeap* decodeHeap = context.renderSystem->CreateResourceHeap(heapDesc, resourceViews);
+        if (!decodeHeap) {
+            std::cerr << "Failed to create quantized decode heap" << std::endl;
+            return 1;
+        }
+        context.commandBuffer->Begin();
+        context.commandBuffer->SetPipelineState(*pipeline);
+        context.commandBuffer->SetVertexBuffer(*resources.GetVertexBuffer(vertexBuffer));
+        context.commandBuffer->SetIndexBuffer(*resources.GetIndexBuffer(indexBuffer));
+        context.commandBuffer->SetResourceHeap(*decodeHeap);
+        context.commandBuffer->DrawIndexed(static_cast<std::uint32_t>(quantized.indices.size()), 0);
+        context.commandBuffer->End();
+        context.Submit();
+        context.renderSystem->Release(*decodeHeap);
+        resources.ReleaseBuffer(decodeBuffer);
+        resources.ReleaseBuffer(vertexBuffer);
+        resources.ReleaseBuffer(indexBuffer);
+        
+        // Streaming read of positions and normals, standing in for vertex fetch bandwidth
+        double readMs = 0.0;
+        double quantizedReadMs = 0.0;
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            start = Clock::now();
+            float sum = 0.0f;
+            for (const auto& vertex : mesh.vertices) {
+                sum += vertex.position.x + vertex.position.y + vertex.position.z + vertex.normal.x;
+            }
+            readMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            checksum += sum;
+            
+            start = Clock::now();
+            std::uint32_t quantizedSum = 0;
+            for (const QuantizedVertex& vertex : quantized.vertices) {
+                quantizedSum += vertex.position[0] + vertex.position[1] + vertex.position[2] +
+                                static_cast<std::uint16_t>(vertex.normal[0]);
+            }
+            quantizedReadMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            checksum += quantizedSum;
+        }
+        
+        const double bytesIn = static_cast<double>(mesh.vertices.size() * sizeof(RenderingPlugin::Vertex));
+        const double bytesOut = static_cast<double>(quantized.vertices.size() * sizeof(QuantizedVertex));
+        std::cout << std::left << std::setw(10) << test.name
+                  << std::right << std::setw(12) << mesh.vertices.size()
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(10) << bytesIn / (1024.0 * 1024.0)
+                  << std::setw(10) << bytesOut / (1024.0 * 1024.0)
+                  << std::setw(10) << bytesIn / bytesOut
+                  << std::setw(12) << encodeMs
+                  << std::scientific << std::setprecision(1)
+                  << std::setw(12) << positionError
+                  << std::setw(12) << normalDegrees
+                  << std::setw(12) << blockError
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << readMs / iterations
+                  << std::setw(12) << quantizedReadMs / iterations << std::endl;
+    }
+    std::cout << "(checksum " << std::setprecision(0) << checksum << ")" << std::endl;
+    
+    return 0;
+}
+
+/**
+ * @brief Compare regenerating every spawned primitive against the shared geometry cache
+ */
+int RunGeometryCacheBenchmark(BenchmarkContext& context) {
+    const std::size_t spawnCount = 10000;
+    
+    // A scene's worth of primitives drawn from a few distinct shapes
+    const GeometryKey shapes[] = {
+        GeometryKey::Sphere(1.0f, 32, 16),
+        GeometryKey::Icosphere(1.0f, 3),
+        GeometryKey::Cube(1.0f),
+        GeometryKey::Cylinder(0.5f, 0.5f, 2.0f, 32, 4),
+        GeometryKey::Torus(1.0f, 0.25f, 48, 24),
+        GeometryKey::Capsule(0.5f, 1.0f, 24, 8),
+    };
+    const std::size_t shapeCount = sizeof(shapes) / sizeof(shapes[0]);
+    
+    std::mt19937 rng(1234);
+    std::vector<std::size_t> spawns(spawnCount);
+    for (std::size_t& shape : spawns) {
+        shape = rng() % shapeCount;
+    }
+    
+    std::size_t vertexChecksum = 0;
+    auto start = Clock::now();
+    for (std::size_t shape : spawns) {
+        vertexChecksum += GeometryCache::Generate(shapes[shape]).GetVertexCount();
+    }
+    const double generateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    GeometryCache cache(context.resourceManager.get());
+    start = Clock::now();
+    for (std::size_t shape : spawns) {
+        vertexChecksum -= cache.GetMesh(shapes[shape])->GetVertexCount();
+    }
+    const double cachedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    start = Clock::now();
+    std::size_t bufferFailures = 0;
+    for (std::size_t shape : spawns) {
+        bufferFailures += cache.GetBuffers(shapes[shape]).IsValid() ? 0 : 1;
+    }
+    const double buffersMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    const GeometryCacheStats stats = cache.GetStatistics();
+    std::cout << std::endl << std::left << std::setw(24) << "path"
+              << std::right << std::setw(12) << "ms" << std::endl;
+    std::cout << std::left << std::setw(24) << "regenerate each"
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3) << generateMs << std::endl;
+    std::cout << std::left << std::setw(24) << "GeometryCache mesh"
+              << std::right << std::setw(12) << cachedMs << std::endl;
+    std::cout << std::left << std::setw(24) << "GeometryCache buffers"
+              << std::right << std::setw(12) << buffersMs << std::endl;
+    std::cout << "Hits: " << stats.hits << ", misses: " << stats.misses
+              << ", hit rate: " << std::setprecision(2) << stats.GetHitRate() * 100.0 << "%, memory: "
+              << stats.memoryUsed / 1024 << " KiB" << std::endl;
+    
+    if (vertexChecksum != 0 || bufferFailures != 0) {
+        std::cerr << "Cached meshes do not match generated meshes" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Compare regenerating a large mesh against loading it from a mapped mesh file
+ */
+int RunMeshBenchmark(BenchmarkContext& context) {
+    const std::uint32_t segments = 1000;
+    ResourceManager& resources = *context.resourceManager;
+    
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "rendering_benchmark_mesh.psmf";
+    
+    // Regenerate on every start, as done without an on-disk format
+    auto start = Clock::now();
+    MeshData mesh = GeometryGenerator::GeneratePlane(100.0f, 100.0f, segments, segments);
+    const double generateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    LLGL::Buffer* vertexBuffer = nullptr;
+    LLGL::Buffer* indexBuffer = nullptr;
+    start = Clock::now();
+    GeometryGenerator::CreateBuffersFromMesh(mesh, &resources, vertexBuffer, indexBuffer);
+    const double generateUploadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    if (!MeshFile::Write(filename.string(), mesh)) {
+        return 1;
+    }
+    const std::uintmax_t fileSize = std::filesystem::file_size(filename);
+    
+    // Reference: plain read of the whole file into memory
+    start = Clock::now();
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::vector<char> contents(static_cast<std::size_t>(fileSize));
+        file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+    const double readMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    
+    // Mapped file straight into the buffers
+    ResourceId vertexBufferId = 0;
+    ResourceId indexBufferId = 0;
+    start = Clock::now();
+    MeshFile meshFile;
+    if (!meshFile.Open(filename.string()) || !meshFile.CreateBuffers(resources, vertexBufferId, indexBufferId)) {
+        std::cerr << "Failed to load mesh file" << std::endl;
+        return 1;
+    }
+    const double mappedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    meshFile.Close();
+    
+    std::cout << std::endl << "Mesh: " << mesh.GetVertexCount() << " vertices, " << mesh.GetIndexCount()
+              << " indices, file " << fileSize / (1024 * 1024) << " MiB" << std::endl;
+    std::cout << std::left << std::setw(24) << "path" << std::right << std::setw(12) << "ms" << std::endl;
+    std::cout << std::left << std::setw(24) << "generate + upload"
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3) << generateMs + generateUploadMs << std::endl;
+    std::cout << std::left << std::setw(24) << "file read (reference)"
+              << std::right << std::setw(12) << readMs << std::endl;
+    std::cout << std::left << std::setw(24) << "mapped mesh file"
+              << std::right << std::setw(12) << mappedMs << std::endl;
+    
+    resources.ReleaseBuffer(vertexBufferId);
+    resources.ReleaseBuffer(indexBufferId);
+    std::filesystem::remove(filename);
+    return 0;
+}
+
+/**
+ * @brief Write binary PPM textures used by the streaming benchmark
+ */
+std::vector<std::string> WriteStreamingTextures(const std::filesystem::path& directory, std::size_t count, std::uint32_t size) {
+    std::filesystem::create_directories(directory);
+    
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(size) * size * 3);
+    std::vector<std::string> filenames;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::fill(pixels.begin(), pixels.end(), static_cast<std::uint8_t>(i));
+        
+        const std::filesystem::path filename = directory / ("texture_" + std::to_string(i) + ".ppm");
+        std::ofstream file(filename, std::ios::binary);
+        file << "P6\n" << size << " " << size << "\n255\n";
+        file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+        filenames.push_back(filename.string());
+    }
+    return filenames;
+}
+
+/**
+ * @brief Compare a blocking texture load against budgeted per-frame creation
+ */
+int RunStreamBenchmark(BenchmarkContext& context) {
+    const std::size_t textureCount = 256;
+    const std::uint32_t textureSize = 512;
+    const std::uint64_t frameBudget = 4 * 1024 * 1024;
+    
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "rendering_benchmark_stream";
+    const std::vector<std::string> filenames = WriteStreamingTextures(directory, textureCount, textureSize);
+    
+    std::cout << std::endl << std::left << std::setw(16) << "mode"
+              << std::right << std::setw(10) << "frames"
+              << std::setw(16) << "max frame ms"
+              << std::setw(12) << "total ms" << std::endl;
+    
+    // Blocking: everything is read, decoded and created before the next frame
+    {
+        AsyncResourceLoader loader(context.resourceManager.get());
+        std::vector<LoadHandle> handles;
+        
+        auto start = Clock::now();
+        for (const std::string& filename : filenames) {
+            handles.push_back(loader.LoadTexture(filename));
+        }
+        loader.WaitIdle();
+        loader.Update(~0ull);
+        const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        std::cout << std::left << std::setw(16) << "blocking"
+                  << std::right << std::setw(10) << 1
+                  << std::setw(16) << std::fixed << std::setprecision(3) << totalMs
+                  << std::setw(12) << totalMs << std::endl;
+        
+        for (LoadHandle handle : handles) {
+            loader.Release(handle);
+        }
+    }
+    
+    // Streaming: the frame loop keeps running and creates at most frameBudget bytes per frame
+    {
+        AsyncResourceLoader loader(context.resourceManager.get());
+        std::vector<LoadHandle> handles;
+        
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < filenames.size(); ++i) {
+            // Nearby assets first: the first quarter is requested with a higher priority
+            handles.push_back(loader.LoadTexture(filenames[i], (i < filenames.size() / 4) ? 1 : 0));
+        }
+        
+        std::size_t frames = 0;
+        std::size_t ready = 0;
+        double maxFrameMs = 0.0;
+        while (ready < handles.size()) {
+            auto frameStart = Clock::now();
+            ready += loader.Update(frameBudget);
+            maxFrameMs = std::max(maxFrameMs, std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+            frames++;
+            
+            if (loader.GetStatistics().failed > 0) {
+                std::cerr << "Streaming benchmark failed to load textures" << std::endl;
+                return 1;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        std::cout << std::left << std::setw(16) << "streaming"
+                  << std::right << std::setw(10) << frames
+                  << std::setw(16) << maxFrameMs
+                  << std::setw(12) << totalMs << std::endl;
+        
+        for (LoadHandle handle : handles) {
+            loader.Release(handle);
+        }
+    }
+    
+    std::filesystem::remove_all(directory);
+    return 0;
+}
+
+/**
+ * @brief Build a right-handed perspective projection (depth range [-1, 1])
+ */
+Gs::Matrix4f MakePerspective(float fovY, float aspect, float nearPlane, float farPlane) {
+    const float f = 1.0f / std::tan(fovY * 0.5f);
+    Gs::Matrix4f projection;
+    projection.LoadIdentity();
+    projection.At(0, 0) = f / aspect;
+    projection.At(1, 1) = f;
+    projection.At(2, 2) = (farPlane + nearPlane) / (nearPlane - farPlane);
+    projection.At(2, 3) = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    projection.At(3, 2) = -1.0f;
+    projection.At(3, 3) = 0.0f;
+    return projection;
+}
+
+/**
+ * @brief Compare per-object culling of RenderObject structs against SceneStore::Cull
+ */
+int RunSceneBenchmark() {
+    const std::size_t objectCounts[] = { 100000, 200000 };
+    const int iterations = 20;
+    const float objectRadius = 0.5f;
+    
+    Gs::Matrix4f view;
+    view.LoadIdentity();
+    const Gs::Matrix4f projection = MakePerspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+    
+    // Frustum planes for the AoS path, same extraction as SceneStore::SetCamera
+    float planes[6][4];
+    const Gs::Matrix4f clip = projection * view;
+    for (int plane = 0; plane < 6; ++plane) {
+        const int row = plane / 2;
+        const float sign = (plane % 2 == 0) ? 1.0f : -1.0f;
+        float length = 0.0f;
+        for (int column = 0; column < 4; ++column) {
+            planes[plane][column] = clip.At(3, column) + sign * clip.At(row, column);
+            if (column < 3) {
+                length += planes[plane][column] * planes[plane][column];
+            }
+        }
+        length = std::sqrt(length);
+        for (int column = 0; column < 4; ++column) {
+            planes[plane][column] /= length;
+        }
+    }
+    
+    std::cout << std::endl << std::left << std::setw(16) << "storage"
+              << std::right << std::setw(10) << "objects"
+              << std::setw(10) << "visible"
+              << std::setw(12) << "cull ms"
+              << std::setw(12) << "build ms" << std::endl;
+    
+    for (std::size_t objectCount : objectCounts) {
+        // Objects scattered in front of and around the camera, roughly half of them visible
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> lateral(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> depth(-450.0f, 50.0f);
+        
+        std::vector<RenderObject> objects(objectCount);
+        SceneStore scene;
+        for (std::size_t i = 0; i < objectCount; ++i) {
+            RenderObject& object = objects[i];
+            object.indexCount = 36;
+            object.pipelineStateId = static_cast<ResourceId>(1 + i % 8);
+            object.transform.world.LoadIdentity();
+            object.transform.world.At(0, 3) = lateral(rng);
+            object.transform.world.At(1, 3) = lateral(rng) * 0.25f;
+            object.transform.world.At(2, 3) = depth(rng);
+            
+            MeshDraw draw;
+            draw.pipelineStateId = object.pipelineStateId;
+            draw.indexCount = object.indexCount;
+            scene.AddObject(draw, object.transform.world, Gs::Vector3f(0.0f, 0.0f, 0.0f), objectRadius,
+                            object.pipelineStateId);
+        }
+        scene.SetCamera(view, projection);
+        
+        // AoS: walk the RenderObject structs, early-out per plane, push visible objects
+        std::vector<std::uint32_t> drawList;
+        double aosCullMs = 0.0;
+        double aosBuildMs = 0.0;
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            auto start = Clock::now();
+            drawList.clear();
+            for (std::size_t i = 0; i < objectCount; ++i) {
+                const RenderObject& object = objects[i];
+                if (!object.visible) {
+                    continue;
+                }
+                
+                const Gs::Matrix4f& world = object.transform.world;
+                const float x = world.At(0, 3);
+                const float y = world.At(1, 3);
+                const float z = world.At(2, 3);
+                
+                bool inside = true;
+                for (int plane = 0; plane < 6 && inside; ++plane) {
+                    inside = planes[plane][0] * x + planes[plane][1] * y + planes[plane][2] * z + planes[plane][3] >= -objectRadius;
+                }
+                if (inside) {
+                    drawList.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            auto cullEnd = Clock::now();
+            std::stable_sort(drawList.begin(), drawList.end(), [&objects](std::uint32_t a, std::uint32_t b) {
+                return objects[a].pipelineStateId < objects[b].pipelineStateId;
+            });
+            auto end = Clock::now();
+            
+            aosCullMs += std::chrono::duration<double, std::milli>(cullEnd - start).count();
+            aosBuildMs += std::chrono::duration<double, std::milli>(end - cullEnd).count();
+        }
+        
+        // SoA: one pass over the bounds arrays, then compaction and key sort
+        double soaCullMs = 0.0;
+        double soaBuildMs = 0.0;
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            scene.Cull(true);
+            soaCullMs += scene.GetStatistics().cullTimeMs;
+            soaBuildMs += scene.GetStatistics().buildTimeMs;
+        }
+        
+        std::cout << std::left << std::setw(16) << "RenderObject"
+                  << std::right << std::setw(10) << objectCount
+                  << std::setw(10) << drawList.size()
+                  << std::setw(12) << std::fixed << std::setprecision(3) << aosCullMs / iterations
+                  << std::setw(12) << aosBuildMs / iterations << std::endl;
+        std::cout << std::left << std::setw(16) << "SceneStore"
+                  << std::right << std::setw(10) << objectCount
+                  << std::setw(10) << scene.GetDrawList().size()
+                  << std::setw(12) << soaCullMs / iterations
+                  << std::setw(12) << soaBuildMs / iterations << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Release the LLGL objects of compiled programs
+ */
+void ReleasePrograms(ShaderManager& shaderManager, std::vector<CompiledShaderProgram>& programs) {
+    for (CompiledShaderProgram& program : programs) {
+        shaderManager.ReleaseShaderProgram(program);
+    }
+    programs.clear();
+}
+
+/**
+ * @brief Compare compiling a set of programs with a cold and a warm disk cache
+ * @details Each pass uses a new ShaderManager, as a new process would. Renderers without
+ *          pipeline cache support produce no blobs, so every pass stays a miss there.
+ */
+int RunShaderCacheBenchmark(BenchmarkContext& context) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "rendering_benchmark_shader_cache";
+    std::filesystem::remove_all(directory);
+    const int programCount = 200;
+    
+    std::vector<ShaderProgramDesc> programs(programCount);
+    for (int i = 0; i < programCount; ++i) {
+        ShaderProgramDesc& desc = programs[i];
+        desc.name = "program" + std::to_string(i);
+        desc.vertexShader = ShaderSource(ShaderType::Vertex, kVertexShader);
+        std::string fragmentShader = kFragmentShader;
+        fragmentShader.replace(fragmentShader.find("vec4(1.0)"), 9, "vec4(" + std::to_string(i / float(programCount)) + ")");
+        desc.fragmentShader = ShaderSource(ShaderType::Fragment, fragmentShader);
+    }
+    
+    std::cout << std::endl << std::left << std::setw(12) << "pass"
+              << std::right << std::setw(10) << "programs"
+              << std::setw(10) << "hits"
+              << std::setw(10) << "misses"
+              << std::setw(10) << "writes"
+              << std::setw(12) << "total ms"
+              << std::setw(12) << "disk ms" << std::endl;
+    
+    for (const char* pass : { "none", "cold", "warm" }) {
+        ShaderManager shaderManager(context.renderSystem.get(), context.resourceManager.get());
+        if (std::string(pass) != "none") {
+            shaderManager.SetDiskCacheDirectory(directory.string());
+        }
+        
+        auto start = Clock::now();
+        int compiled = 0;
+        std::vector<CompiledShaderProgram> results;
+        for (const ShaderProgramDesc& desc : programs) {
+            results.push_back(shaderManager.CompileShaderProgram(desc));
+            compiled += results.back().isValid ? 1 : 0;
+        }
+        const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        ReleasePrograms(shaderManager, results);
+        
+        const ShaderDiskCacheStats stats = shaderManager.GetDiskCacheStatistics();
+        std::cout << std::left << std::setw(12) << pass
+                  << std::right << std::setw(10) << compiled
+                  << std::setw(10) << stats.hits
+                  << std::setw(10) << stats.misses
+                  << std::setw(10) << stats.writes
+                  << std::setw(12) << std::fixed << std::setprecision(2) << totalMs
+                  << std::setw(12) << stats.readTimeMs + stats.writeTimeMs << std::endl;
+    }
+    
+    std::filesystem::remove_all(directory);
+    return 0;
+}
+
+/**
+ * @brief Compare compiling a set of programs serially, as a batch preprocessed in parallel and asynchronously
+ * @details Reports the wall-clock time against the summed per-program compile time. The async pass
+ *          pumps ProcessPendingCompilations once per simulated 1 ms loading screen frame.
+ */
+int RunShaderParallelBenchmark(BenchmarkContext& context) {
+    const int programCount = 200;
+    
+    std::vector<ShaderProgramDesc> programs(programCount);
+    for (int i = 0; i < programCount; ++i) {
+        ShaderProgramDesc& desc = programs[i];
+        desc.name = "program" + std::to_string(i);
+        desc.vertexShader = ShaderSource(ShaderType::Vertex, kVertexShader);
+        std::string fragmentShader = kFragmentShader;
+        fragmentShader.replace(fragmentShader.find("vec4(1.0)"), 9, "vec4(" + std::to_string(i / float(programCount)) + ")");
+        desc.fragmentShader = ShaderSource(ShaderType::Fragment, fragmentShader);
+    }
+    
+    ThreadPool threadPool;
+    std::cout << std::endl << "Worker threads: " << threadPool.GetThreadCount() << std::endl;
+    std::cout << std::left << std::setw(20) << "mode"
+              << std::right << std::setw(10) << "programs"
+              << std::setw(12) << "wall ms"
+              << std::setw(12) << "summed ms"
+              << std::setw(14) << "preprocess ms"
+              << std::setw(10) << "speedup"
+              << std::setw(10) << "frames" << std::endl;
+    
+    auto printRow = [](const char* mode, int compiled, const ShaderCompileTiming& timing, int frames) {
+        std::cout << std::left << std::setw(20) << mode
+                  << std::right << std::setw(10) << compiled
+                  << std::setw(12) << std::fixed << std::setprecision(2) << timing.wallTimeMs
+                  << std::setw(12) << timing.summedTimeMs
+                  << std::setw(14) << timing.preprocessTimeMs
+                  << std::setw(9) << (timing.wallTimeMs > 0.0 ? timing.summedTimeMs / timing.wallTimeMs : 0.0) << "x"
+                  << std::setw(10) << frames << std::endl;
+    };
+    auto countValid = [](const std::vector<CompiledShaderProgram>& results) {
+        return static_cast<int>(std::count_if(results.begin(), results.end(),
+                                              [](const CompiledShaderProgram& program) { return program.isValid; }));
+    };
+    
+    for (const char* mode : { "serial", "batch", "batch+creation" }) {
+        ShaderManager shaderManager(context.renderSystem.get(), context.resourceManager.get());
+        if (std::string(mode) != "serial") {
+            shaderManager.SetThreadPool(&threadPool);
+            shaderManager.SetParallelCreationEnabled(std::string(mode) == "batch+creation");
+        }
+        
+        std::vector<CompiledShaderProgram> results = shaderManager.CompileShaderPrograms(programs);
+        printRow(mode, countValid(results), shaderManager.GetLastCompileTiming(), 0);
+        ReleasePrograms(shaderManager, results);
+    }
+    
+    // Async: the render thread keeps producing frames while programs finish
+    {
+        ShaderManager shaderManager(context.renderSystem.get(), context.resourceManager.get());
+        shaderManager.SetThreadPool(&threadPool);
+        
+        auto start = Clock::now();
+        std::vector<std::future<CompiledShaderProgram>> futures;
+        for (const ShaderProgramDesc& desc : programs) {
+            futures.push_back(shaderManager.CompileShaderProgramAsync(desc));
+        }
+        
+        int frames = 0;
+        while (shaderManager.GetPendingCompilationCount() > 0) {
+            shaderManager.ProcessPendingCompilations();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++frames;
+        }
+        
+        std::vector<CompiledShaderProgram> results;
+        for (std::future<CompiledShaderProgram>& future : futures) {
+            results.push_back(future.get());
+        }
+        
+        ShaderCompileTiming timing;
+        timing.wallTimeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        for (const auto& entry : shaderManager.GetCompilationStatistics()) {
+            if (entry.first.compare(0, 7, "program") == 0) {
+                timing.summedTimeMs += entry.second;
+            }
+        }
+        printRow("async", countValid(results), timing, frames);
+        ReleasePrograms(shaderManager, results);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Compare startup compile cost of a shader with 8 keywords: all 256 variants vs. lazy vs. precompiled
+ * @details The scene uses 12 keyword combinations. The lazy pass requests them over simulated 1 ms
+ *          frames and draws with the fallback until each is ready; the precompile pass compiles the
+ *          list the lazy pass recorded.
+ */
+int RunShaderVariantBenchmark(BenchmarkContext& context) {
+    const std::vector<std::string> keywords = {
+        "NORMAL_MAP", "SKINNED", "SHADOWS", "FOG", "ALPHA_TEST", "EMISSIVE", "VERTEX_COLOR", "INSTANCED"
+    };
+    const ShaderVariantMask usedMasks[] = { 0x00, 0x01, 0x03, 0x05, 0x07, 0x0C, 0x11, 0x21, 0x45, 0x85, 0x87, 0xFF };
+    
+    ShaderProgramDesc baseDesc;
+    baseDesc.name = "lit";
+    baseDesc.vertexShader = ShaderSource(ShaderType::Vertex, kVertexShader);
+    baseDesc.fragmentShader = ShaderSource(ShaderType::Fragment, kFragmentShader);
+    
+    ThreadPool threadPool;
+    std::cout << std::endl << std::left << std::setw(12) << "mode"
+              << std::right << std::setw(12) << "startup ms"
+              << std::setw(10) << "compiled"
+              << std::setw(10) << "frames"
+              << std::setw(12) << "fallbacks" << std::endl;
+    
+    auto printRow = [](const char* mode, double startupMs, std::size_t compiled, int frames, std::uint64_t fallbacks) {
+        std::cout << std::left << std::setw(12) << mode
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(2) << startupMs
+                  << std::setw(10) << compiled
+                  << std::setw(10) << frames
+                  << std::setw(12) << fallbacks << std::endl;
+    };
+    
+    std::vector<ShaderVariantMask> recorded;
+    for (const char* mode : { "all", "lazy", "precompile" }) {
+        ShaderManager shaderManager(context.renderSystem.get(), context.resourceManager.get());
+        shaderManager.SetThreadPool(&threadPool);
+        ShaderVariantSet variants(shaderManager, baseDesc, keywords);
+        
+        auto start = Clock::now();
+        if (std::string(mode) == "all") {
+            std::vector<ShaderVariantMask> allMasks;
+            for (ShaderVariantMask mask = 0; mask < (ShaderVariantMask(1) << keywords.size()); ++mask) {
+                allMasks.push_back(mask);
+            }
+            variants.Precompile(allMasks);
+        } else if (std::string(mode) == "precompile") {
+            variants.Precompile(recorded);
+        }
+        
+        // First frame draws with whatever is available; startup ends once it is submitted
+        for (ShaderVariantMask mask : usedMasks) {
+            variants.GetVariant(mask);
+        }
+        const double startupMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        int frames = 1;
+        while (variants.GetStatistics().pending > 0) {
+            shaderManager.ProcessPendingCompilations();
+            variants.Update();
+            for (ShaderVariantMask mask : usedMasks) {
+                variants.GetVariant(mask);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++frames;
+        }
+        
+        const ShaderVariantStats stats = variants.GetStatistics();
+        printRow(mode, startupMs, stats.compiled, frames, stats.fallbackUses);
+        if (std::string(mode) == "lazy") {
+            recorded = variants.GetRequestedVariants();
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Compare expanding the includes of many shaders with a fresh include cache per shader
+ *        (every include read and rescanned again, as before the cache) against one shared cache
+ * @details Twelve include files of ~8 KB form a tree three levels deep; each shader includes
+ *          the four top-level files. The last pass touches one leaf include, which reloads only
+ *          that file and the includes above it.
+ */
+int RunShaderIncludeBenchmark() {
+    const int shaderCount = 500;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "rendering_benchmark_includes";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "include");
+    
+    std::string padding;
+    while (padding.size() < 8 * 1024) {
+        padding += "vec3 Helper" + std::to_string(padding.size()) + "(vec3 v) { return v * " + std::to_string(padding.size() % 7) + ".0; }\n";
+    }
+    // Files 0-3 include 4-7, which include 8-11
+    for (int i = 0; i < 12; ++i) {
+        std::ofstream file(directory / "include" / ("part" + std::to_string(i) + ".glsl"));
+        file << "#ifndef PART" << i << "\n#define PART" << i << "\n";
+        if (i < 8) {
+            file << "#include \"part" << (i + 4) << ".glsl\"\n";
+        }
+        file << padding << "#endif\n";
+    }
+    
+    std::vector<std::string> shaders(shaderCount);
+    for (int i = 0; i < shaderCount; ++i) {
+        shaders[i] = "#version 330 core\n#include \"include/part0.glsl\"\n#include \"include/part1.glsl\"\n"
+                     "#include \"include/part2.glsl\"\n#include \"include/part3.glsl\"\n"
+                     "out vec4 color;\nvoid main() { color = vec4(" + std::to_string(i) + ".0); }\n";
+    }
+    const std::string shaderPath = (directory / "shader.frag").string();
+    
+    int reads = 0;
+    ShaderIncludeCache::Loader loader = [&reads](const std::string& includePath, const std::string& currentPath) {
+        ++reads;
+        std::ifstream file(std::filesystem::path(currentPath).parent_path() / includePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    
+    std::cout << std::endl << std::left << std::setw(20) << "mode"
+              << std::right << std::setw(12) << "ms"
+              << std::setw(12) << "us/shader"
+              << std::setw(12) << "file reads" << std::endl;
+    
+    std::size_t expandedBytes = 0;
+    auto run = [&](const char* mode, const std::function<std::string(const std::string&)>& expand) {
+        reads = 0;
+        std::size_t bytes = 0;
+        const auto start = Clock::now();
+        for (const std::string& shader : shaders) {
+            bytes += expand(shader).size();
+        }
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::cout << std::left << std::setw(20) << mode
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << ms
+                  << std::setw(12) << ms * 1000.0 / shaderCount
+                  << std::setw(12) << reads << std::endl;
+        if (expandedBytes != 0 && bytes != expandedBytes) {
+            std::cerr << "Expanded sources differ between modes" << std::endl;
+        }
+        expandedBytes = bytes;
+    };
+    
+    run("re-read", [&](const std::string& shader) {
+        ShaderIncludeCache fresh;
+        return fresh.Expand(shader, shaderPath, loader);
+    });
+    
+    ShaderIncludeCache cache;
+    run("cached (cold)", [&](const std::string& shader) { return cache.Expand(shader, shaderPath, loader); });
+    run("cached (warm)", [&](const std::string& shader) { return cache.Expand(shader, shaderPath, loader); });
+    
+    const std::filesystem::path leaf = directory / "include" / "part11.glsl";
+    std::filesystem::last_write_time(leaf, std::filesystem::last_write_time(leaf) + std::chrono::seconds(1));
+    run("cached (leaf edit)", [&](const std::string& shader) { return cache.Expand(shader, shaderPath, loader); });
+    
+    const ShaderIncludeCacheStats stats = cache.GetStatistics();
+    std::cout << "include cache: " << cache.GetEntryCount() << " entries, " << stats.hits << " hits, "
+              << stats.loads << " loads, " << cache.GetDependents(leaf.string()).size() << " dependents of part11" << std::endl;
+    
+    std::filesystem::remove_all(directory);
+    return 0;
+}
+
+/**
+ * @brief Program cache key as ShaderManager built it before hashed keys: the full sources concatenated
+ */
+std::string ReferenceProgramKey(const ShaderProgramDesc& desc) {
+    std::string key;
+    for (const ShaderSource* stage : { &desc.vertexShader, &desc.fragmentShader }) {
+        key += stage->source + "|" + stage->entryPoint + "|" + stage->profile + "|" + std::to_string(static_cast<int>(stage->type));
+        key += "|" + std::to_string(desc.compileOptions.enableDebugInfo) + "|" + std::to_string(desc.compileOptions.enableOptimization) +
+               "|" + std::to_string(desc.compileOptions.treatWarningsAsErrors);
+        for (const std::string& define : desc.compileOptions.defines) {
+            key += "|" + define + "=1";
+        }
+        key += "|";
+    }
+    return key;
+}
+
+/**
+ * @brief Compare program cache lookups keyed by concatenated sources against ShaderManager's hashed program cache
+ * @details "compile us/first" is a cache miss of CompileShaderProgram, "hit us/look" a repeated
+ *          CompileShaderProgram of the same description served from the in-memory program cache.
+ */
+int RunShaderKeysBenchmark(BenchmarkContext& context) {
+    const int programCount = 64;
+    const int lookupRounds = 20;
+    
+    std::cout << std::endl << std::left << std::setw(12) << "source KB"
+              << std::right << std::setw(16) << "string us/look"
+              << std::setw(18) << "compile us/first"
+              << std::setw(16) << "hit us/look"
+              << std::setw(12) << "key bytes" << std::endl;
+    
+    for (std::size_t sourceKB : { 4u, 64u, 512u }) {
+        // Large sources that differ only near the end, as generated variants of an uber-shader do
+        std::string body;
+        while (body.size() < sourceKB * 1024) {
+            body += "    color += texture(layer" + std::to_string(body.size() % 97) + ", uv) * weights[" + std::to_string(body.size() % 13) + "];\n";
+        }
+        std::vector<ShaderProgramDesc> programs(programCount);
+        for (int i = 0; i < programCount; ++i) {
+            programs[i].vertexShader = ShaderSource(ShaderType::Vertex, kVertexShader);
+            programs[i].fragmentShader = ShaderSource(ShaderType::Fragment, body + "// variant " + std::to_string(i) + "\n");
+            programs[i].compileOptions.AddDefine("VARIANT=" + std::to_string(i));
+        }
+        
+        std::unordered_map<std::string, int> stringCache;
+        for (int i = 0; i < programCount; ++i) {
+            stringCache.emplace(ReferenceProgramKey(programs[i]), i);
+        }
+        
+        auto start = Clock::now();
+        int found = 0;
+        for (int round = 0; round < lookupRounds; ++round) {
+            for (const ShaderProgramDesc& desc : programs) {
+                found += stringCache.count(ReferenceProgramKey(desc)) > 0 ? 1 : 0;
+            }
+        }
+        const double stringUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / (lookupRounds * programCount);
+        
+        ShaderManager shaderManager(context.renderSystem.get(), context.resourceManager.get());
+        std::vector<CompiledShaderProgram> results;
+        results.reserve(programCount * (lookupRounds + 1));
+        start = Clock::now();
+        for (const ShaderProgramDesc& desc : programs) {
+            results.push_back(shaderManager.CompileShaderProgram(desc));
+        }
+        const double firstUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / programCount;
+        
+        start = Clock::now();
+        for (int round = 0; round < lookupRounds; ++round) {
+            for (const ShaderProgramDesc& desc : programs) {
+                results.push_back(shaderManager.CompileShaderProgram(desc));
+            }
+        }
+        const double hashUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / (lookupRounds * programCount);
+        
+        auto statistics = shaderManager.GetCompilationStatistics();
+        found += static_cast<int>(statistics["programCache.hits"]);
+        ReleasePrograms(shaderManager, results);
+        if (found != 2 * lookupRounds * programCount || static_cast<std::size_t>(statistics["programCache.entries"]) != stringCache.size()) {
+            std::cerr << "Cache lookups disagree" << std::endl;
+            return 1;
+        }
+        
+        std::cout << std::left << std::setw(12) << sourceKB
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(16) << stringUs
+                  << std::setw(18) << firstUs
+                  << std::setw(16) << hashUs
+                  << std::setw(12) << stringCache.begin()->first.size() << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Compare triangles submitted for a deep scene with and without LOD chains
+ */
+int RunLodBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    ResourceManager& resources = *context.resourceManager;
+    RenderCommands commands(context.commandBuffer, &resources);
+    commands.SetMatrixBuffer(matrixBuffer);
+    LLGL::PipelineState* pipeline = resources.GetPipelineState(prototypes[0].pipelineStateId);
+    
+    // Chain generation cost and the levels it produces
+    const MeshData sources[] = {
+        GeometryGenerator::GenerateSphere(1.0f, 96, 48),
+        GeometryGenerator::GenerateTorus(1.0f, 0.35f, 96, 48)
+    };
+    std::vector<LodChain> chains;
+    
+    std::cout << std::endl << std::left << std::setw(10) << "mesh"
+              << std::right << std::setw(10) << "gen ms"
+              << "  levels (triangles/error)" << std::endl;
+    const char* names[] = { "sphere", "torus" };
+    for (std::size_t meshIndex = 0; meshIndex < 2; ++meshIndex) {
+        auto start = Clock::now();
+        const LodMesh lodMesh = LodGenerator::Generate(sources[meshIndex]);
+        const double generateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        std::cout << std::left << std::setw(10) << names[meshIndex]
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << generateMs << " ";
+        for (const LodLevel& level : lodMesh.levels) {
+            std::cout << " " << level.indexCount / 3 << "/" << std::setprecision(4) << level.error;
+        }
+        std::cout << std::endl;
+        
+        chains.push_back(LodGenerator::CreateChain(lodMesh, resources));
+        if (!chains.back().IsValid()) {
+            std::cerr << "Failed to create LOD chain buffers" << std::endl;
+            return 1;
+        }
+    }
+    
+    Gs::Matrix4f view;
+    view.LoadIdentity();
+    const Gs::Matrix4f projection = MakePerspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const int framesPerRun = 5;
+    
+    std::cout << std::endl << std::left << std::setw(12) << "mode"
+              << std::right << std::setw(10) << "objects"
+              << std::setw(10) << "visible"
+              << std::setw(14) << "triangles"
+              << std::setw(14) << "cpu ms/frame" << std::endl;
+    
+    for (std::size_t objectCount : { 10000u, 50000u }) {
+        // Objects spread from just in front of the camera to the far plane
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> lateral(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> depth(2.0f, 900.0f);
+        
+        SceneStore fullScene;
+        SceneStore lodScene;
+        for (std::size_t i = 0; i < objectCount; ++i) {
+            const LodChain& chain = chains[i % chains.size()];
+            const float z = depth(rng);
+            Gs::Matrix4f world;
+            world.LoadIdentity();
+            world.At(0, 3) = lateral(rng) * z * 0.8f;
+            world.At(1, 3) = lateral(rng) * z * 0.4f;
+            world.At(2, 3) = -z;
+            
+            const MeshDraw draw = chain.GetDraw(0);
+            fullScene.AddObject(draw, world, chain.boundsCenter, chain.boundsRadius);
+            const ResourceId objectId = lodScene.AddObject(draw, world, chain.boundsCenter, chain.boundsRadius);
+            lodScene.SetLodChain(objectId, &chain);
+        }
+        
+        SceneStore* scenes[] = { &fullScene, &lodScene };
+        const char* modes[] = { "full detail", "lod" };
+        for (int sceneIndex = 0; sceneIndex < 2; ++sceneIndex) {
+            SceneStore& scene = *scenes[sceneIndex];
+            scene.SetCamera(view, projection);
+            scene.SetLodParameters(1080.0f, 1.0f);
+            
+            double frameMs = 0.0;
+            for (int frame = 0; frame < framesPerRun; ++frame) {
+                commands.BeginFrame();
+                auto start = Clock::now();
+                context.commandBuffer->Begin();
+                scene.Cull(true);
+                scene.Submit(commands, pipeline);
+                context.commandBuffer->End();
+                frameMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                context.Submit();
+            }
+            
+            const SceneCullStats& stats = scene.GetStatistics();
+            std::cout << std::left << std::setw(12) << modes[sceneIndex]
+                      << std::right << std::setw(10) << objectCount
+                      << std::setw(10) << stats.visibleCount
+                      << std::setw(14) << stats.trianglesSubmitted
+                      << std::setw(14) << std::fixed << std::setprecision(3) << frameMs / framesPerRun << std::endl;
+        }
+    }
+    
+    for (LodChain& chain : chains) {
+        LodGenerator::ReleaseChain(chain, resources);
+    }
+    return 0;
+}
+
+/**
+ * @brief Measure CPU rasterizer frames of lit spheres at 1080p on 1..N threads
+ */
+int RunSoftwareBenchmark() {
+    const int width = 1920;
+    const int height = 1080;
+    const int gridSize = 20;
+    const int framesPerRun = 10;
+    const MeshData sphere = GeometryGenerator::GenerateSphere(1.0f, 48, 24);
+    
+    RenderObject object;
+    object.vertexBufferId = 1;
+    object.indexBufferId = 2;
+    object.indexCount = static_cast<std::uint32_t>(sphere.indices.size());
+    object.transform.projection = MakePerspective(1.0f, static_cast<float>(width) / height, 0.1f, 100.0f);
+    
+    std::cout << std::endl << std::left << std::setw(10) << "threads"
+              << std::right << std::setw(12) << "triangles"
+              << std::setw(12) << "pixels"
+              << std::setw(12) << "ms/frame"
+              << std::setw(12) << "vertex ms"
+              << std::setw(12) << "setup ms"
+              << std::setw(12) << "raster ms" << std::endl;
+    
+    std::vector<std::uint8_t> reference;
+    std::vector<std::uint8_t> image;
+    const std::size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        ThreadPool threadPool(threadCount);
+        SoftwareRasterizer rasterizer(threadCount > 1 ? &threadPool : nullptr);
+        rasterizer.Resize(width, height);
+        rasterizer.SetVertexBuffer(object.vertexBufferId, sphere.vertices);
+        rasterizer.SetIndexBuffer(object.indexBufferId, sphere.indices);
+        rasterizer.SetBackFaceCulling(true);
+        
+        double frameMs = 0.0;
+        SoftwareRasterizerStats total;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            const auto start = Clock::now();
+            rasterizer.Clear(RenderingPlugin::Color(0.1f, 0.1f, 0.2f));
+            for (int i = 0; i < gridSize * gridSize; ++i) {
+                object.transform.world.At(0, 3) = (static_cast<float>(i % gridSize) - gridSize * 0.5f) * 2.5f;
+                object.transform.world.At(1, 3) = (static_cast<float>(i / gridSize) - gridSize * 0.5f) * 1.5f;
+                object.transform.world.At(2, 3) = -10.0f - static_cast<float>(i / gridSize) * 2.0f;
+                rasterizer.Draw(object);
+            }
+            rasterizer.Flush();
+            frameMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            
+            const SoftwareRasterizerStats& stats = rasterizer.GetStatistics();
+            total.trianglesRasterized += stats.trianglesRasterized;
+            total.pixelsWritten += stats.pixelsWritten;
+            total.vertexTimeMs += stats.vertexTimeMs;
+            total.setupTimeMs += stats.setupTimeMs;
+            total.rasterTimeMs += stats.rasterTimeMs;
+        }
+        
+        // Every thread count must produce the same image
+        rasterizer.ReadPixels(image);
+        if (reference.empty()) {
+            reference = image;
+        } else if (image != reference) {
+            std::cerr << "Image differs with " << threadCount << " threads" << std::endl;
+            return 1;
+        }
+        
+        std::cout << std::left << std::setw(10) << threadCount
+                  << std::right << std::setw(12) << total.trianglesRasterized / framesPerRun
+                  << std::setw(12) << total.pixelsWritten / framesPerRun
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << frameMs / framesPerRun
+                  << std::setw(12) << total.vertexTimeMs / framesPerRun
+                  << std::setw(12) << total.setupTimeMs / framesPerRun
+                  << std::setw(12) << total.rasterTimeMs / framesPerRun << std::endl;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Stand-in for an encoder: touches every byte of a frame
+ */
+std::uint64_t ChecksumFrame(const std::uint8_t* data, std::uint32_t width, std::uint32_t height, std::size_t rowPitch) {
+    std::uint64_t checksum = 0;
+    for (std::uint32_t y = 0; y < height; ++y) {
+        const std::uint8_t* row = data + y * rowPitch;
+        for (std::size_t i = 0; i + 8 <= width * 4u; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, row + i, sizeof(word));
+            checksum = (checksum ^ word) * 0x100000001b3ull;
+        }
+    }
+    return checksum;
+}
+
+/**
+ * @brief Measure readback throughput of a render target at 1080p and 4K
+ */
+int RunReadbackBenchmark(BenchmarkContext& context) {
+    const int framesPerRun = 60;
+    const std::uint32_t sizes[][2] = { { 1920, 1080 }, { 3840, 2160 } };
+    
+    std::cout << std::endl << std::left << std::setw(12) << "size"
+              << std::setw(10) << "mode"
+              << std::right << std::setw(10) << "fps"
+              << std::setw(14) << "render ms"
+              << std::setw(12) << "stall ms"
+              << std::setw(12) << "copy ms"
+              << std::setw(12) << "sink ms" << std::endl;
+    
+    for (const auto& size : sizes) {
+        LLGL::TextureDescriptor textureDesc;
+        textureDesc.type = LLGL::TextureType::Texture2D;
+        textureDesc.bindFlags = LLGL::BindFlags::ColorAttachment | LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc;
+        textureDesc.format = LLGL::Format::RGBA8UNorm;
+        textureDesc.extent = { size[0], size[1], 1 };
+        textureDesc.mipLevels = 1;
+        
+        LLGL::Texture* texture = context.renderSystem->CreateTexture(textureDesc);
+        if (!texture) {
+            std::cerr << "Failed to create " << size[0] << "x" << size[1] << " render target" << std::endl;
+            return 1;
+        }
+        
+        const std::string label = std::to_string(size[0]) + "x" + std::to_string(size[1]);
+        std::uint64_t checksums[2] = {};
+        
+        // Blocking: every frame waits for its own readback and encodes on the render thread
+        {
+            std::vector<std::uint8_t> pixels(static_cast<std::size_t>(size[0]) * size[1] * 4);
+            LLGL::TextureRegion region;
+            region.extent = { size[0], size[1], 1 };
+            
+            double readMs = 0.0;
+            double sinkMs = 0.0;
+            const auto start = Clock::now();
+            for (int frame = 0; frame < framesPerRun; ++frame) {
+                const auto readStart = Clock::now();
+                context.renderSystem->ReadTexture(*texture, region, LLGL::MutableImageView{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, pixels.data(), pixels.size() });
+                const auto sinkStart = Clock::now();
+                checksums[0] += ChecksumFrame(pixels.data(), size[0], size[1], size[0] * 4u);
+                readMs += std::chrono::duration<double, std::milli>(sinkStart - readStart).count();
+                sinkMs += std::chrono::duration<double, std::milli>(Clock::now() - sinkStart).count();
+            }
+            const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            
+            std::cout << std::left << std::setw(12) << label << std::setw(10) << "blocking"
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << framesPerRun * 1000.0 / totalMs
+                      << std::setprecision(2)
+                      << std::setw(14) << totalMs / framesPerRun
+                      << std::setw(12) << readMs / framesPerRun
+                      << std::setw(12) << 0.0
+                      << std::setw(12) << sinkMs / framesPerRun << std::endl;
+        }
+        
+        // Ring: the render thread submits copies and moves finished frames to the delivery thread
+        {
+            FrameReadback readback(context.renderSystem.get(), 3);
+            readback.SetSink([&checksums](const ReadbackFrame& frame) {
+                checksums[1] += ChecksumFrame(frame.data, frame.width, frame.height, frame.rowPitch);
+            });
+            readback.Resize(size[0], size[1]);
+            
+            double renderMs = 0.0;
+            const auto start = Clock::now();
+            for (int frame = 0; frame < framesPerRun; ++frame) {
+                const auto frameStart = Clock::now();
+                readback.Request(*texture, static_cast<std::uint64_t>(frame));
+                readback.Poll();
+                renderMs += std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+            }
+            readback.Flush();
+            const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            
+            const FrameReadbackStats stats = readback.GetStatistics();
+            std::cout << std::left << std::setw(12) << label << std::setw(10) << "ring"
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << stats.framesDelivered * 1000.0 / totalMs
+                      << std::setprecision(2)
+                      << std::setw(14) << renderMs / framesPerRun
+                      << std::setw(12) << stats.stallTimeMs / framesPerRun
+                      << std::setw(12) << stats.copyTimeMs / framesPerRun
+                      << std::setw(12) << stats.sinkTimeMs / framesPerRun << std::endl;
+        }
+        
+        context.renderSystem->Release(*texture);
+        
+        if (checksums[0] != checksums[1]) {
+            std::cerr << "Ring readback differs from blocking readback at " << label << std::endl;
+            return 1;
+        }
+    }
+    
+    std::cout << std::endl << "render ms: render thread time per frame spent on readback" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Build a thumbnail job of a few objects; sizes and colors cycle with the index
+ */
+BatchRenderJob MakeFarmJob(int index, const RenderObject* prototypes, std::size_t prototypeCount) {
+    const std::uint32_t sizes[][2] = { { 128, 128 }, { 256, 256 }, { 512, 288 } };
+    
+    BatchRenderJob job;
+    job.width = sizes[index % 3][0];
+    job.height = sizes[index % 3][1];
+    job.clearColor = RenderingPlugin::Color(static_cast<float>(index % 10) / 10.0f, 0.2f, 0.3f);
+    for (int i = 0; i < 8; ++i) {
+        RenderObject object = prototypes[(index + i) % prototypeCount];
+        object.transform.world.At(0, 3) = static_cast<float>(i % 4) * 1.5f - 2.25f;
+        object.transform.world.At(1, 3) = static_cast<float>(i / 4) * 1.5f - 0.75f;
+        object.transform.world.At(2, 3) = -6.0f - static_cast<float>(index % 5);
+        object.transform.projection = MakePerspective(1.0f, static_cast<float>(job.width) / job.height, 0.1f, 100.0f);
+        job.objects.push_back(object);
+    }
+    return job;
+}
+
+void PrintFarmRow(const char* backend, const char* mode, std::size_t jobCount, double totalMs, std::uint64_t targetsCreated) {
+    std::cout << std::left << std::setw(10) << backend
+              << std::setw(10) << mode
+              << std::right << std::setw(8) << jobCount
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << jobCount * 1000.0 / totalMs
+              << std::setprecision(3)
+              << std::setw(12) << totalMs / jobCount
+              << std::setw(10) << targetsCreated << std::endl;
+}
+
+/**
+ * @brief Measure thumbnail jobs per second: a renderer initialized per job vs. one batch renderer
+ */
+int RunFarmBenchmark(BenchmarkContext& context) {
+    const int softwareJobs = 300;
+    const int deviceJobs = 1000;
+    const int deviceJobsPerRenderer = 20;
+    
+    std::cout << std::endl << std::left << std::setw(10) << "backend"
+              << std::setw(10) << "mode"
+              << std::right << std::setw(8) << "jobs"
+              << std::setw(12) << "jobs/s"
+              << std::setw(12) << "ms/job"
+              << std::setw(10) << "targets" << std::endl;
+    
+    // Software: a fresh rasterizer with its own mesh copy per job vs. pooled rasterizers on all cores
+    {
+        const MeshData sphere = GeometryGenerator::GenerateSphere(0.6f, 32, 16);
+        RenderObject sphereObject;
+        sphereObject.vertexBufferId = 1;
+        sphereObject.indexBufferId = 2;
+        sphereObject.indexCount = static_cast<std::uint32_t>(sphere.indices.size());
+        
+        std::vector<BatchRenderJob> jobs;
+        for (int i = 0; i < softwareJobs; ++i) {
+            jobs.push_back(MakeFarmJob(i, &sphereObject, 1));
+        }
+        
+        std::uint64_t checksums[2] = {};
+        std::vector<std::uint8_t> pixels;
+        auto start = Clock::now();
+        for (const BatchRenderJob& job : jobs) {
+            SoftwareRasterizer rasterizer;
+            rasterizer.Resize(static_cast<int>(job.width), static_cast<int>(job.height));
+            rasterizer.SetVertexBuffer(sphereObject.vertexBufferId, sphere.vertices);
+            rasterizer.SetIndexBuffer(sphereObject.indexBufferId, sphere.indices);
+            rasterizer.Clear(job.clearColor);
+            for (const RenderObject& object : job.objects) {
+                rasterizer.Draw(object);
+            }
+            rasterizer.Flush();
+            rasterizer.ReadPixels(pixels);
+            checksums[0] += ChecksumFrame(pixels.data(), job.width, job.height, job.width * 4u);
+        }
+        PrintFarmRow("software", "per job", jobs.size(), std::chrono::duration<double, std::milli>(Clock::now() - start).count(), jobs.size());
+        
+        ThreadPool threadPool;
+        BatchRenderer batch(&threadPool);
+        batch.SetVertexBuffer(sphereObject.vertexBufferId, sphere.vertices);
+        batch.SetIndexBuffer(sphereObject.indexBufferId, sphere.indices);
+        
+        std::vector<std::future<BatchRenderResult>> results;
+        start = Clock::now();
+        for (const BatchRenderJob& job : jobs) {
+            results.push_back(batch.Submit(job));
+        }
+        for (auto& future : results) {
+            const BatchRenderResult result = future.get();
+            checksums[1] += ChecksumFrame(result.pixels.data(), result.width, result.height, result.width * 4u);
+        }
+        PrintFarmRow("software", "batch", jobs.size(), std::chrono::duration<double, std::milli>(Clock::now() - start).count(), batch.GetStatistics().targetsCreated);
+        
+        if (checksums[0] != checksums[1]) {
+            std::cerr << "Batch images differ from per-job images" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Device: load the render system and scene resources per job vs. targets pooled across jobs
+    {
+        std::vector<RenderObject> prototypes;
+        ResourceId matrixBuffer = 0;
+        if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+            std::cerr << "Failed to create scene resources" << std::endl;
+            return 1;
+        }
+        
+        auto start = Clock::now();
+        for (int i = 0; i < deviceJobsPerRenderer; ++i) {
+            BenchmarkContext jobContext;
+            LLGL::Report report;
+            jobContext.renderSystem = LLGL::RenderSystem::Load("Null", &report);
+            if (!jobContext.renderSystem) {
+                std::cerr << "Null renderer required for the per-job device run" << std::endl;
+                return 1;
+            }
+            jobContext.resourceManager = std::make_unique<ResourceManager>(jobContext.renderSystem.get());
+            
+            std::vector<RenderObject> jobPrototypes;
+            ResourceId jobMatrixBuffer = 0;
+            CreateSceneResources(jobContext, jobPrototypes, jobMatrixBuffer);
+            
+            BatchRenderer renderer(jobContext.renderSystem.get(), jobContext.resourceManager.get(), 1);
+            renderer.SetMatrixBuffer(jobMatrixBuffer);
+            std::future<BatchRenderResult> result = renderer.Submit(MakeFarmJob(i, jobPrototypes.data(), jobPrototypes.size()));
+            renderer.WaitIdle();
+            result.get();
+        }
+        PrintFarmRow("device", "per job", deviceJobsPerRenderer, std::chrono::duration<double, std::milli>(Clock::now() - start).count(), deviceJobsPerRenderer);
+        
+        BatchRenderer batch(context.renderSystem.get(), context.resourceManager.get(), 4);
+        batch.SetMatrixBuffer(matrixBuffer);
+        
+        std::vector<std::future<BatchRenderResult>> results;
+        start = Clock::now();
+        for (int i = 0; i < deviceJobs; ++i) {
+            results.push_back(batch.Submit(MakeFarmJob(i, prototypes.data(), prototypes.size())));
+            batch.Update();
+        }
+        batch.WaitIdle();
+        for (auto& future : results) {
+            future.get();
+        }
+        PrintFarmRow("device", "batch", deviceJobs, std::chrono::duration<double, std::milli>(Clock::now() - start).count(), batch.GetStatistics().targetsCreated);
+    }
+    
+    std::cout << std::endl << "targets: offscreen targets created; per job runs initialize a renderer for every image" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Declare a deferred frame: shadow map, G-buffer, SSAO, lighting, bloom and tonemapping
+ *        into the output, plus a debug view nothing reads
+ */
+void BuildDeferredFrame(RenderGraph& graph, std::uint32_t width, std::uint32_t height, LLGL::Texture* output) {
+    const RenderingPlugin::Color black(0.0f, 0.0f, 0.0f, 1.0f);
+    const std::uint32_t halfWidth = std::max(width / 2, 1u);
+    const std::uint32_t halfHeight = std::max(height / 2, 1u);
+    const std::uint32_t quarterWidth = std::max(width / 4, 1u);
+    const std::uint32_t quarterHeight = std::max(height / 4, 1u);
+    
+    const RenderGraphResource shadow = graph.CreateTexture("ShadowMap", { 2048, 2048, LLGL::Format::D32Float });
+    const RenderGraphResource albedo = graph.CreateTexture("Albedo", { width, height, LLGL::Format::RGBA8UNorm });
+    const RenderGraphResource normal = graph.CreateTexture("Normal", { width, height, LLGL::Format::RGBA16Float });
+    const RenderGraphResource material = graph.CreateTexture("Material", { width, height, LLGL::Format::RGBA8UNorm });
+    const RenderGraphResource depth = graph.CreateTexture("Depth", { width, height, LLGL::Format::D32Float });
+    const RenderGraphResource occlusion = graph.CreateTexture("Occlusion", { width, height, LLGL::Format::R8UNorm });
+    const RenderGraphResource hdr = graph.CreateTexture("HDR", { width, height, LLGL::Format::RGBA16Float });
+    const RenderGraphResource bright = graph.CreateTexture("BloomBright", { halfWidth, halfHeight, LLGL::Format::RGBA16Float });
+    const RenderGraphResource down = graph.CreateTexture("BloomDown", { quarterWidth, quarterHeight, LLGL::Format::RGBA16Float });
+    const RenderGraphResource blurX = graph.CreateTexture("BloomBlurX", { quarterWidth, quarterHeight, LLGL::Format::RGBA16Float });
+    const RenderGraphResource blurY = graph.CreateTexture("BloomBlurY", { quarterWidth, quarterHeight, LLGL::Format::RGBA16Float });
+    const RenderGraphResource debugView = graph.CreateTexture("DebugView", { width, height, LLGL::Format::RGBA8UNorm });
+    const RenderGraphResource target = graph.ImportTexture("Output", output);
+    
+    graph.AddPass("Shadow", [&](RenderGraphBuilder& builder) {
+        builder.WriteDepth(shadow);
+    }, nullptr);
+    graph.AddPass("GBuffer", [&](RenderGraphBuilder& builder) {
+        builder.WriteColor(albedo, black);
+        builder.WriteColor(normal, black);
+        builder.WriteColor(material, black);
+        builder.WriteDepth(depth);
+    }, nullptr);
+    graph.AddPass("SSAO", [&](RenderGraphBuilder& builder) {
+        builder.Read(normal);
+        builder.Read(depth);
+        builder.WriteColor(occlusion);
+    }, nullptr);
+    graph.AddPass("Lighting", [&](RenderGraphBuilder& builder) {
+        for (RenderGraphResource input : { shadow, albedo, normal, material, depth, occlusion }) {
+            builder.Read(input);
+        }
+        builder.WriteColor(hdr, black);
+    }, nullptr);
+    graph.AddPass("DebugNormals", [&](RenderGraphBuilder& builder) {
+        builder.Read(normal);
+        builder.WriteColor(debugView, black);
+    }, nullptr);
+    graph.AddPass("BloomBright", [&](RenderGraphBuilder& builder) {
+        builder.Read(hdr);
+        builder.WriteColor(bright);
+    }, nullptr);
+    graph.AddPass("BloomDown", [&](RenderGraphBuilder& builder) {
+        builder.Read(bright);
+        builder.WriteColor(down);
+    }, nullptr);
+    graph.AddPass("BloomBlurX", [&](RenderGraphBuilder& builder) {
+        builder.Read(down);
+        builder.WriteColor(blurX);
+    }, nullptr);
+    graph.AddPass("BloomBlurY", [&](RenderGraphBuilder& builder) {
+        builder.Read(blurX);
+        builder.WriteColor(blurY);
+    }, nullptr);
+    graph.AddPass("Tonemap", [&](RenderGraphBuilder& builder) {
+        builder.Read(hdr);
+        builder.Read(blurY);
+        builder.WriteColor(target);
+        builder.SetSideEffect();
+    }, nullptr);
+}
+
+/**
+ * @brief Measure pass culling and transient texture memory of a deferred frame graph
+ */
+int RunGraphBenchmark(BenchmarkContext& context) {
+    const std::uint32_t sizes[][2] = { { 1920, 1080 }, { 3840, 2160 } };
+    const int framesPerRun = 200;
+    const double megabyte = 1024.0 * 1024.0;
+    
+    std::cout << std::endl << std::left << std::setw(12) << "size"
+              << std::right << std::setw(8) << "passes"
+              << std::setw(8) << "culled"
+              << std::setw(10) << "textures"
+              << std::setw(10) << "physical"
+              << std::setw(14) << "unaliased MB"
+              << std::setw(12) << "aliased MB"
+              << std::setw(14) << "compile ms"
+              << std::setw(14) << "execute ms" << std::endl;
+    
+    RenderCommands commands(context.commandBuffer, context.resourceManager.get());
+    
+    for (const auto& size : sizes) {
+        LLGL::TextureDescriptor textureDesc;
+        textureDesc.type = LLGL::TextureType::Texture2D;
+        textureDesc.bindFlags = LLGL::BindFlags::ColorAttachment | LLGL::BindFlags::Sampled;
+        textureDesc.format = LLGL::Format::RGBA8UNorm;
+        textureDesc.extent = { size[0], size[1], 1 };
+        textureDesc.mipLevels = 1;
+        
+        LLGL::Texture* output = context.renderSystem->CreateTexture(textureDesc);
+        if (!output) {
+            std::cerr << "Failed to create " << size[0] << "x" << size[1] << " output texture" << std::endl;
+            return 1;
+        }
+        
+        RenderGraph graph(context.renderSystem.get());
+        
+        // Declaring and compiling the graph is paid every frame
+        auto start = Clock::now();
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            graph.Reset();
+            BuildDeferredFrame(graph, size[0], size[1], output);
+            if (!graph.Compile()) {
+                std::cerr << "Failed to compile the frame graph" << std::endl;
+                context.renderSystem->Release(*output);
+                return 1;
+            }
+        }
+        const double compileMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / framesPerRun;
+        
+        // Recording reuses the pooled textures and render targets after the first frame
+        double executeMs = 0.0;
+        for (int frame = 0; frame < framesPerRun; ++frame) {
+            graph.Reset();
+            BuildDeferredFrame(graph, size[0], size[1], output);
+            
+            const auto executeStart = Clock::now();
+            context.commandBuffer->Begin();
+            commands.SetCommandBuffer(context.commandBuffer);
+            const bool executed = graph.Execute(commands);
+            context.commandBuffer->End();
+            executeMs += std::chrono::duration<double, std::milli>(Clock::now() - executeStart).count();
+            context.Submit();
+            
+            if (!executed) {
+                std::cerr << "Failed to execute the frame graph" << std::endl;
+                context.renderSystem->Release(*output);
+                return 1;
+            }
+        }
+        
+        const RenderGraphStats& stats = graph.GetStatistics();
+        std::cout << std::left << std::setw(12) << (std::to_string(size[0]) + "x" + std::to_string(size[1]))
+                  << std::right << std::setw(8) << stats.passesDeclared
+                  << std::setw(8) << stats.passesDeclared - stats.passesExecuted
+                  << std::setw(10) << stats.transientTextures
+                  << std::setw(10) << stats.physicalTextures
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << stats.unaliasedMemoryBytes / megabyte
+                  << std::setw(12) << stats.transientMemoryBytes / megabyte
+                  << std::setprecision(4)
+                  << std::setw(14) << compileMs
+                  << std::setw(14) << executeMs / framesPerRun << std::endl;
+        
+        graph.ReleaseTextures();
+        context.renderSystem->Release(*output);
+    }
+    
+    std::cout << std::endl << "unaliased MB: one texture per transient; aliased MB: pooled textures shared by transients with disjoint lifetimes" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Compare CPU culling and per-batch submission against compute culling with indirect draws
+ */
+int RunGpuCullBenchmark(BenchmarkContext& context) {
+    std::vector<RenderObject> prototypes;
+    ResourceId matrixBuffer = 0;
+    if (!CreateSceneResources(context, prototypes, matrixBuffer)) {
+        std::cerr << "Failed to create benchmark resources" << std::endl;
+        return 1;
+    }
+    
+    ResourceManager& resources = *context.resourceManager;
+    RenderCommands commands(context.commandBuffer, &resources);
+    commands.SetMatrixBuffer(matrixBuffer);
+    LLGL::PipelineState* pipeline = resources.GetPipelineState(prototypes[0].pipelineStateId);
+    
+    GpuCulling culling(context.renderSystem.get(), &resources);
+    if (!culling.IsGpuCullingActive()) {
+        std::cout << "Compute culling is not supported by this renderer, both rows use SceneStore on the CPU" << std::endl;
+    }
+    
+    Gs::Matrix4f view;
+    view.LoadIdentity();
+    const Gs::Matrix4f projection = MakePerspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+    const int framesPerRun = 20;
+    
+    std::cout << std::endl << std::left << std::setw(10) << "mode"
+              << std::right << std::setw(10) << "objects"
+              << std::setw(10) << "moving"
+              << std::setw(10) << "draws"
+              << std::setw(12) << "upload KB"
+              << std::setw(12) << "cull ms"
+              << std::setw(12) << "submit ms" << std::endl;
+    
+    for (std::size_t objectCount : { 10000u, 50000u, 200000u }) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> lateral(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> depth(-450.0f, 50.0f);
+        
+        SceneStore scene;
+        std::vector<ResourceId> objectIds;
+        for (std::size_t i = 0; i < objectCount; ++i) {
+            const RenderObject& prototype = prototypes[i % prototypes.size()];
+            Gs::Matrix4f world;
+            world.LoadIdentity();
+            world.At(0, 3) = lateral(rng);
+            world.At(1, 3) = lateral(rng) * 0.25f;
+            world.At(2, 3) = depth(rng);
+            
+            MeshDraw draw;
+            draw.vertexBufferId = prototype.vertexBufferId;
+            draw.indexBufferId = prototype.indexBufferId;
+            draw.pipelineStateId = prototype.pipelineStateId;
+            draw.indexCount = prototype.indexCount;
+            objectIds.push_back(scene.AddObject(draw, world, Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f, prototype.pipelineStateId));
+        }
+        scene.SetCamera(view, projection);
+        
+        // A static scene and one where 1% of the objects move every frame
+        for (std::size_t movingCount : { std::size_t(0), objectCount / 100 }) {
+            for (bool gpu : { false, true }) {
+                culling.SetGpuCullingEnabled(gpu);
+                
+                double cullMs = 0.0;
+                double submitMs = 0.0;
+                std::uint64_t uploadedBytes = 0;
+                for (int frame = 0; frame < framesPerRun; ++frame) {
+                    for (std::size_t i = 0; i < movingCount; ++i) {
+                        Gs::Matrix4f world;
+                        world.LoadIdentity();
+                        world.At(0, 3) = lateral(rng);
+                        world.At(2, 3) = depth(rng);
+                        scene.SetTransform(objectIds[(frame * movingCount + i) % objectCount], world);
+                    }
+                    
+                    commands.BeginFrame();
+                    context.commandBuffer->Begin();
+                    culling.Cull(commands, scene);
+                    culling.Submit(commands, scene, pipeline);
+                    context.commandBuffer->End();
+                    context.Submit();
+                    
+                    // The first GPU frame uploads the whole scene
+                    const GpuCullingStats& stats = culling.GetStatistics();
+                    if (frame > 0) {
+                        cullMs += stats.cullCpuTimeMs;
+                        submitMs += stats.submitCpuTimeMs;
+                        uploadedBytes += stats.uploadedBytes;
+                    }
+                }
+                
+                const GpuCullingStats& stats = culling.GetStatistics();
+                std::cout << std::left << std::setw(10) << (stats.gpuCulling ? "gpu" : "cpu")
+                          << std::right << std::setw(10) << objectCount
+                          << std::setw(10) << movingCount
+                          << std::setw(10) << stats.drawCommands
+                          << std::setw(12) << std::fixed << std::setprecision(1) << uploadedBytes / 1024.0 / (framesPerRun - 1)
+                          << std::setprecision(3)
+                          << std::setw(12) << cullMs / (framesPerRun - 1)
+                          << std::setw(12) << submitMs / (framesPerRun - 1) << std::endl;
+            }
+        }
+    }
+    
+    std::cout << std::endl << "draws: draw commands recorded per frame; upload KB: object and draw records uploaded per frame" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string benchmark = (argc > 1) ? argv[1] : "batch";
+    
+    if (benchmark == "handles") {
+        return RunHandlesBenchmark();
+    }
+    if (benchmark == "scene") {
+        return RunSceneBenchmark();
+    }
+    if (benchmark == "geometry") {
+        return RunGeometryBenchmark();
+    }
+    if (benchmark == "optimize") {
+        return RunOptimizeBenchmark();
+    }
+    if (benchmark == "includes") {
+        return RunShaderIncludeBenchmark();
+    }
+    if (benchmark == "software") {
+        return RunSoftwareBenchmark();
+    }
+    
+    BenchmarkContext context;
+    if (!context.Initialize()) {
+        return 1;
+    }
+    
+    if (benchmark == "batch") {
+        return RunBatchBenchmark(context);
+    }
+    if (benchmark == "queue") {
+        return RunQueueBenchmark(context);
+    }
+    if (benchmark == "parallel") {
+        return RunParallelBenchmark(context);
+    }
+    if (benchmark == "frames") {
+        return RunFramesBenchmark(context);
+    }
+    if (benchmark == "upload") {
+        return RunUploadBenchmark(context);
+    }
+    if (benchmark == "quantize") {
+        return RunQuantizeBenchmark(context);
+    }
+    if (benchmark == "geocache") {
+        return RunGeometryCacheBenchmark(context);
+    }
+    if (benchmark == "mesh") {
+        return RunMeshBenchmark(context);
+    }
+    if (benchmark == "stream") {
+        return RunStreamBenchmark(context);
+    }
+    if (benchmark == "shadercache") {
+        return RunShaderCacheBenchmark(context);
+    }
+    if (benchmark == "shaderparallel") {
+        return RunShaderParallelBenchmark(context);
+    }
+    if (benchmark == "shaderkeys") {
+        return RunShaderKeysBenchmark(context);
+    }
+    if (benchmark == "variants") {
+        return RunShaderVariantBenchmark(context);
+    }
+    if (benchmark == "lod") {
+        return RunLodBenchmark(context);
+    }
+    if (benchmark == "readback") {
+        return RunReadbackBenchmark(context);
+    }
+    if (benchmark == "farm") {
+        return RunFarmBenchmark(context);
+    }
+    if (benchmark == "graph") {
+        return RunGraphBenchmark(context);
+    }
+    if (benchmark == "gpucull") {
+        return RunGpuCullBenchmark(context);
+    }
+    
+    std::cerr << "Unknown benchmark: " << benchmark << std::endl;
+    std::cerr << "Available benchmarks: batch, queue, parallel, frames, upload, handles, scene, geocache, mesh, stream, geometry, optimize, quantize, shadercache, shaderparallel, variants, shaderkeys, includes, lod, software, readback, farm, graph, gpucull" << std::endl;
+    return 1;
+}
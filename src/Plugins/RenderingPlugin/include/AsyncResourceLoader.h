@@ -0,0 +1,261 @@
+/**
+ * @file AsyncResourceLoader.h
+ * @brief Asynchronous texture and shader loading for ResourceManager
+ * @details File I/O and decoding run on background workers. GPU resources are created on the
+ *          calling thread in Update(), which the application calls once per frame at a point
+ *          where resource creation is safe, with a byte budget so large asset sets stream in
+ *          over several frames instead of stalling one.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "ResourceManager.h"
+#include "HandlePool.h"
+#include "ThreadPool.h"
+#include <LLGL/LLGL.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Load request handle returned by AsyncResourceLoader
+ */
+using LoadHandle = std::uint32_t;
+
+/**
+ * @brief Readiness of an asynchronously loaded resource
+ */
+enum class LoadState : std::uint8_t {
+    Placeholder,  ///< Queued; GetResourceId returns the placeholder
+    Loading,      ///< Being read and decoded, or waiting for GPU creation
+    Ready,        ///< GPU resource created
+    Failed,       ///< File could not be read, decoded or created
+    Cancelled     ///< Cancelled before the GPU resource was created
+};
+
+/**
+ * @brief Decoded texture data (RGBA8, tightly packed rows)
+ */
+struct DecodedImage {
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::vector<std::uint8_t> pixels;
+};
+
+/**
+ * @brief Image decoder called on a worker thread
+ * @details Receives the complete file contents; returns false if the data cannot be decoded.
+ */
+using ImageDecoder = std::function<bool(const std::vector<std::uint8_t>& fileData, DecodedImage& image)>;
+
+/**
+ * @brief Asynchronous loader statistics
+ */
+struct AsyncLoaderStats {
+    std::uint32_t requested = 0;         ///< Load requests issued
+    std::uint32_t completed = 0;         ///< Resources created
+    std::uint32_t failed = 0;            ///< Requests that failed
+    std::uint32_t cancelled = 0;         ///< Requests cancelled before creation
+    std::size_t queued = 0;              ///< Requests not picked up by a worker at the last Update()
+    std::size_t awaitingCreation = 0;    ///< Decoded requests left for a later Update()
+    std::uint32_t createdLastUpdate = 0; ///< Resources created by the last Update()
+    std::uint64_t bytesLastUpdate = 0;   ///< Decoded bytes consumed by the last Update()
+    double lastUpdateMs = 0.0;           ///< Duration of the last Update()
+};
+
+/**
+ * @brief Asynchronous resource loader
+ * @details Requests are picked up by workers in priority order (highest first, FIFO within a
+ *          priority). All methods except the decoder itself must be called from the thread
+ *          that owns the ResourceManager. Created resources belong to the ResourceManager and
+ *          are released with Release() or ResourceManager::ReleaseAllResources().
+ *          Without a ResourceManager nothing is created: Update() marks decoded requests Ready
+ *          with resource 0, so the queueing can be used and tested without a device.
+ */
+class RENDERING_PLUGIN_API AsyncResourceLoader {
+public:
+    /**
+     * @brief Constructor
+     * @param resourceManager Resource manager that creates the GPU resources (may be nullptr for CPU-only use)
+     * @param workerCount Number of I/O and decode threads
+     */
+    AsyncResourceLoader(ResourceManager* resourceManager, std::size_t workerCount = 2);
+    
+    /**
+     * @brief Destructor; cancels outstanding requests and joins the workers
+     */
+    ~AsyncResourceLoader();
+    
+    AsyncResourceLoader(const AsyncResourceLoader&) = delete;
+    AsyncResourceLoader& operator=(const AsyncResourceLoader&) = delete;
+    
+    // === Requests ===
+    
+    /**
+     * @brief Queue a texture load
+     * @details Binary PPM (P6) is decoded by default; see SetImageDecoder for other formats.
+     * @param filename Texture file path
+     * @param priority Load priority, higher values are loaded first
+     * @return Load handle, or 0 on failure
+     */
+    LoadHandle LoadTexture(const std::string& filename, int priority = 0);
+    
+    /**
+     * @brief Queue a shader load
+     * @param type Shader type
+     * @param filename Shader source file path
+     * @param entryPoint Shader entry point
+     * @param priority Load priority, higher values are loaded first
+     * @return Load handle, or 0 on failure
+     */
+    LoadHandle LoadShader(LLGL::ShaderType type, const std::string& filename,
+                          const std::string& entryPoint = "main", int priority = 0);
+    
+    /**
+     * @brief Change the priority of a request
+     * @details Affects requests not yet picked up by a worker and the creation order in Update().
+     * @param handle Load handle
+     * @param priority New priority
+     * @return true on success, false if the handle is not valid
+     */
+    bool SetPriority(LoadHandle handle, int priority);
+    
+    /**
+     * @brief Cancel a request
+     * @param handle Load handle
+     * @return true if the request was cancelled, false if it already finished or the handle is not valid
+     */
+    bool Cancel(LoadHandle handle);
+    
+    /**
+     * @brief Cancel a request if needed, release its resource and invalidate the handle
+     * @param handle Load handle
+     */
+    void Release(LoadHandle handle);
+    
+    // === Frame Processing ===
+    
+    /**
+     * @brief Create GPU resources for decoded requests
+     * @details Call once per frame from the render thread, outside command recording. At least
+     *          one resource is created per call, so a request larger than the budget still finishes.
+     * @param uploadBudgetBytes Decoded bytes to turn into GPU resources this call
+     * @return Number of resources created
+     */
+    std::size_t Update(std::uint64_t uploadBudgetBytes = 16 * 1024 * 1024);
+    
+    /**
+     * @brief Block until every queued request has been read and decoded
+     * @details Intended for loading screens; follow with Update() to create the resources.
+     */
+    void WaitIdle();
+    
+    // === Access ===
+    
+    /**
+     * @brief Get the state of a request
+     * @param handle Load handle
+     * @return Load state, LoadState::Failed for invalid handles
+     */
+    LoadState GetState(LoadHandle handle) const;
+    
+    /**
+     * @brief Get the resource of a request
+     * @param handle Load handle
+     * @return The loaded resource when ready, otherwise the placeholder texture for texture
+     *         requests and 0 for shader requests
+     */
+    ResourceId GetResourceId(LoadHandle handle) const;
+    
+    /**
+     * @brief Get the placeholder texture (2x2 white) used until textures are ready
+     * @return Texture ID
+     */
+    ResourceId GetPlaceholderTexture() const;
+    
+    /**
+     * @brief Set the decoder used for texture files
+     * @param decoder Decoder called on worker threads; nullptr restores the PPM decoder
+     */
+    void SetImageDecoder(ImageDecoder decoder);
+    
+    /**
+     * @brief Get loader statistics
+     * @return Loader statistics
+     */
+    const AsyncLoaderStats& GetStatistics() const;
+
+private:
+    /**
+     * @brief Kind of resource a request produces
+     */
+    enum class RequestType : std::uint8_t {
+        Texture,
+        Shader
+    };
+    
+    /**
+     * @brief Load request shared between the render thread and the workers
+     */
+    struct LoadRequest {
+        RequestType type = RequestType::Texture;
+        std::string filename;
+        std::string entryPoint;
+        LLGL::ShaderType shaderType = LLGL::ShaderType::Vertex;
+        int priority = 0;
+        std::uint64_t sequence = 0;
+        
+        std::atomic<LoadState> state{ LoadState::Placeholder };
+        std::atomic<bool> cancelled{ false };
+        
+        // Written by the worker before the request is moved to completed_
+        bool decoded = false;
+        DecodedImage image;
+        std::string source;
+        
+        ResourceId resourceId = 0;
+    };
+    
+    using RequestPtr = std::shared_ptr<LoadRequest>;
+    
+    /**
+     * @brief Register a request and schedule a worker for it
+     */
+    LoadHandle Submit(RequestPtr request);
+    
+    /**
+     * @brief Worker task: read and decode the highest-priority queued request
+     */
+    void ProcessNext();
+    
+    /**
+     * @brief Create the GPU resource of a decoded request
+     */
+    void CreateResource(LoadRequest& request);
+    
+    ResourceManager* resourceManager_;
+    ResourceId placeholderTexture_;
+    
+    HandlePool<RequestPtr> requests_;
+    std::uint64_t nextSequence_;
+    
+    // Shared with workers, guarded by mutex_
+    std::mutex mutex_;
+    std::vector<RequestPtr> queued_;
+    std::vector<RequestPtr> completed_;
+    ImageDecoder decoder_;
+    
+    AsyncLoaderStats stats_;
+    
+    std::unique_ptr<ThreadPool> workers_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,305 @@
+/**
+ * @file BatchRenderer.h
+ * @brief Headless batch rendering of many small scenes with one long-lived renderer
+ * @details Render farm nodes draw thousands of thumbnails and previews per process. Instead of
+ *          initializing a rendering system for every image, jobs are queued against one renderer
+ *          that keeps a pool of offscreen targets of every size in use and hands the image of
+ *          each job back through a future.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "SoftwareRasterizer.h"
+#include <LLGL/LLGL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace RenderingPlugin {
+
+class RenderCommands;
+class ThreadPool;
+
+/**
+ * @brief Where batch jobs are rendered
+ */
+enum class BatchBackend {
+    Software,   ///< CPU rasterizers, one job per worker thread
+    Device      ///< LLGL render system, several jobs in flight on the GPU
+};
+
+/**
+ * @brief Scene description of one batch job
+ */
+struct BatchRenderJob {
+    std::uint32_t width = 256;           ///< Image width in pixels
+    std::uint32_t height = 256;          ///< Image height in pixels
+    Color clearColor;                    ///< Background
+    std::vector<RenderObject> objects;   ///< Drawn in order with their own transforms
+};
+
+/**
+ * @brief Image produced by a batch job
+ */
+struct BatchRenderResult {
+    bool success = false;               ///< false if a draw referenced missing resources
+    std::uint32_t width = 0;            ///< Image width in pixels
+    std::uint32_t height = 0;           ///< Image height in pixels
+    std::vector<std::uint8_t> pixels;   ///< Tightly packed RGBA8 rows, top row first
+};
+
+/**
+ * @brief Batch renderer statistics
+ */
+struct BatchRendererStats {
+    std::uint64_t jobsSubmitted = 0;    ///< Jobs passed to Submit
+    std::uint64_t jobsCompleted = 0;    ///< Jobs whose image was delivered
+    std::uint64_t jobsFailed = 0;       ///< Completed jobs with a failed draw
+    std::uint64_t targetsCreated = 0;   ///< Offscreen targets created
+    std::uint64_t targetsReused = 0;    ///< Jobs rendered into a pooled target
+    std::uint64_t targetsEvicted = 0;   ///< Idle targets destroyed to respect the pool limit
+};
+
+/**
+ * @brief Job queue rendering scene descriptions into pooled offscreen targets
+ * @details With the software backend each queued job is picked up by a worker of the thread pool
+ *          and rasterized whole on that worker, so a backlog keeps every worker busy without
+ *          any synchronization inside a job. With the device backend Update() retires finished
+ *          jobs and records queued ones, each into its own command buffer with a copy of the
+ *          target into a readback buffer, keeping up to maxJobsInFlight jobs on the GPU.
+ *          Submit is thread-safe; Update and WaitIdle must be called from the thread owning
+ *          the render system.
+ */
+class RENDERING_PLUGIN_API BatchRenderer {
+public:
+    /**
+     * @brief Create a batch renderer on CPU rasterizers
+     * @param threadPool Workers rendering the jobs, must outlive the renderer
+     */
+    explicit BatchRenderer(ThreadPool* threadPool);
+    
+    /**
+     * @brief Create a batch renderer on an LLGL render system
+     * @details Pipelines referenced by jobs must be compatible with a render target of an RGBA8
+     *          color and a D32 depth attachment.
+     * @param renderSystem Render system creating the targets
+     * @param resourceManager Resources referenced by the jobs' render objects
+     * @param maxJobsInFlight Jobs submitted to the GPU at once
+     */
+    BatchRenderer(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager,
+                  std::uint32_t maxJobsInFlight = 4);
+    
+    /**
+     * @brief Destructor, finishes all queued jobs and destroys the targets
+     */
+    ~BatchRenderer();
+    
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+    
+    /**
+     * @brief Get the backend jobs are rendered with
+     * @return Backend chosen at construction
+     */
+    BatchBackend GetBackend() const;
+    
+    // === Scene Data ===
+    
+    /**
+     * @brief Register the vertices of a mesh for the software backend
+     * @details Shared by every rasterizer of the pool. Jobs already running keep the previous
+     *          vertices.
+     * @param id Vertex buffer ID used by render objects
+     * @param vertices Vertices
+     */
+    void SetVertexBuffer(ResourceId id, std::vector<Vertex> vertices);
+    
+    /**
+     * @brief Register the indices of a mesh for the software backend
+     * @param id Index buffer ID used by render objects
+     * @param indices Triangle list indices
+     */
+    void SetIndexBuffer(ResourceId id, std::vector<std::uint32_t> indices);
+    
+    /**
+     * @brief Set the lighting of the software backend
+     * @param lighting Lighting for jobs started afterwards
+     */
+    void SetLighting(const SoftwareLighting& lighting);
+    
+    /**
+     * @brief Set the constant buffer receiving per-draw matrices on the device backend
+     * @param constantBufferId Resource ID of a constant buffer holding a Matrices struct
+     */
+    void SetMatrixBuffer(ResourceId constantBufferId);
+    
+    // === Jobs ===
+    
+    /**
+     * @brief Queue a job
+     * @param job Scene to render
+     * @return Future receiving the image
+     */
+    std::future<BatchRenderResult> Submit(BatchRenderJob job);
+    
+    /**
+     * @brief Deliver finished device jobs and start queued ones, without blocking
+     * @details Call regularly, e.g. once per loop iteration of the job feeder. Does nothing
+     *          with the software backend, whose workers run on their own.
+     * @return Number of jobs delivered
+     */
+    std::size_t Update();
+    
+    /**
+     * @brief Wait until every submitted job has been delivered
+     */
+    void WaitIdle();
+    
+    /**
+     * @brief Get the number of jobs submitted but not yet delivered
+     * @return Queued and running jobs
+     */
+    std::size_t GetPendingCount() const;
+    
+    // === Target Pool ===
+    
+    /**
+     * @brief Limit the number of idle offscreen targets kept for reuse
+     * @details The least recently used targets are destroyed first. Defaults to 16.
+     * @param count Maximum idle targets
+     */
+    void SetMaxIdleTargets(std::size_t count);
+    
+    /**
+     * @brief Get the number of idle offscreen targets
+     * @return Pooled targets not used by a job
+     */
+    std::size_t GetIdleTargetCount() const;
+    
+    /**
+     * @brief Destroy all idle offscreen targets
+     */
+    void ReleaseIdleTargets();
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get batch statistics
+     * @return Statistics since the last reset
+     */
+    BatchRendererStats GetStatistics() const;
+    
+    /**
+     * @brief Reset batch statistics
+     */
+    void ResetStatistics();
+
+private:
+    /**
+     * @brief Queued job and the promise of its result
+     */
+    struct PendingJob {
+        BatchRenderJob job;
+        std::promise<BatchRenderResult> promise;
+    };
+    
+    /**
+     * @brief Render target, depth buffer and readback buffer of one size on the device backend
+     */
+    struct DeviceTarget {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        LLGL::Texture* color = nullptr;
+        LLGL::Texture* depth = nullptr;
+        LLGL::RenderTarget* renderTarget = nullptr;
+        LLGL::Buffer* readback = nullptr;
+        std::uint32_t rowPitch = 0;
+    };
+    
+    /**
+     * @brief Command buffer and fence of one device job in flight
+     */
+    struct DeviceSlot {
+        LLGL::CommandBuffer* commandBuffer = nullptr;
+        LLGL::Fence* fence = nullptr;
+        std::unique_ptr<DeviceTarget> target;
+        PendingJob pending;
+        bool success = true;
+    };
+    
+    /**
+     * @brief Worker task of the software backend: render the oldest queued job
+     */
+    void RenderNextSoftwareJob();
+    
+    /**
+     * @brief Take a pooled rasterizer of a size or create one
+     */
+    std::unique_ptr<SoftwareRasterizer> AcquireRasterizer(std::uint32_t width, std::uint32_t height);
+    
+    /**
+     * @brief Return a rasterizer to the pool, evicting the least recently used idle ones
+     * @details Its buffers are removed; the next job registers the ones it draws.
+     */
+    void ReleaseRasterizer(std::unique_ptr<SoftwareRasterizer> rasterizer);
+    
+    /**
+     * @brief Take a pooled device target of a size or create one
+     * @return Target, or null if it could not be created
+     */
+    std::unique_ptr<DeviceTarget> AcquireDeviceTarget(std::uint32_t width, std::uint32_t height);
+    
+    /**
+     * @brief Return a device target to the pool, evicting the least recently used idle ones
+     */
+    void ReleaseDeviceTarget(std::unique_ptr<DeviceTarget> target);
+    
+    /**
+     * @brief Destroy the objects of a device target
+     */
+    void DestroyDeviceTarget(DeviceTarget& target);
+    
+    /**
+     * @brief Record and submit the oldest queued job on a free slot
+     */
+    void StartDeviceJob(std::size_t slotIndex);
+    
+    /**
+     * @brief Read back and deliver the oldest device job, waiting for its fence if asked to
+     * @return false if the job has not finished and wait is false
+     */
+    bool FinishDeviceJob(bool wait);
+    
+    BatchBackend backend_;
+    ThreadPool* threadPool_;
+    LLGL::RenderSystem* renderSystem_;
+    ResourceManager* resourceManager_;
+    
+    mutable std::mutex mutex_;
+    std::condition_variable idleCondition_;   ///< Signaled when the last pending job is delivered
+    std::deque<PendingJob> queue_;
+    std::size_t pendingJobs_;                 ///< Queued and running jobs
+    std::size_t maxIdleTargets_;
+    BatchRendererStats stats_;
+    
+    // Software backend, guarded by mutex_
+    std::unordered_map<ResourceId, std::shared_ptr<const std::vector<Vertex>>> vertexBuffers_;
+    std::unordered_map<ResourceId, std::shared_ptr<const std::vector<std::uint32_t>>> indexBuffers_;
+    SoftwareLighting lighting_;
+    std::vector<std::unique_ptr<SoftwareRasterizer>> idleRasterizers_;
+    
+    // Device backend, owner thread only apart from idleTargets_
+    std::unique_ptr<RenderCommands> commands_;
+    std::vector<DeviceSlot> slots_;
+    std::deque<std::size_t> runningSlots_;   ///< In submission order
+    std::vector<std::unique_ptr<DeviceTarget>> idleTargets_;
+};
+
+} // namespace RenderingPlugin
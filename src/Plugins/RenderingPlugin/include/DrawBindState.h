@@ -0,0 +1,71 @@
+/**
+ * @file DrawBindState.h
+ * @brief Bind order tracking between draws
+ * @details Kept free of command buffer calls, so RenderCommands' bind order can be checked
+ *          without a device.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <LLGL/LLGL.h>
+#include <cstdint>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Binding state of a command buffer between draws
+ * @details Tracks the bound pipeline and material resource heap, and the per-draw matrix block
+ *          queued through an upload allocator. A pipeline or resource heap bind may drop the
+ *          block's binding, so the block is bound lazily right before each draw, after the
+ *          pipeline and material heap: pipeline -> material heap -> matrix block -> draw.
+ */
+class RENDERING_PLUGIN_API DrawBindState {
+public:
+    /**
+     * @brief Record that a pipeline state was bound
+     * @details Resource heap bindings do not survive a pipeline change.
+     * @param pipelineState Bound pipeline state
+     */
+    void PipelineBound(LLGL::PipelineState* pipelineState);
+    
+    /**
+     * @brief Record that a material resource heap was bound
+     * @param resourceHeap Bound resource heap
+     */
+    void ResourceHeapBound(LLGL::ResourceHeap* resourceHeap);
+    
+    /**
+     * @brief Queue the matrix block for the next draw
+     * @param blockHeap Upload allocator block heap, or nullptr to clear
+     * @param blockIndex Descriptor set of the block in blockHeap
+     */
+    void SetMatrixBlock(LLGL::ResourceHeap* blockHeap, std::uint32_t blockIndex);
+    
+    /**
+     * @brief Get the matrix block if it has to be bound before the next draw
+     * @details Binding the block leaves the material heap tracked as bound, which holds on
+     *          backends with slot-based bindings only (see UploadAllocator::SupportsBlockBinding).
+     * @param blockHeap Receives the block heap
+     * @param blockIndex Receives the block's descriptor set
+     * @return true if the block is queued and not bound since the last pipeline or heap bind
+     */
+    bool TakeMatrixBlock(LLGL::ResourceHeap*& blockHeap, std::uint32_t& blockIndex);
+    
+    /**
+     * @brief Forget all bindings, e.g. for a new command buffer
+     */
+    void Reset();
+    
+    LLGL::PipelineState* GetPipelineState() const { return pipelineState_; }
+    LLGL::ResourceHeap* GetResourceHeap() const { return resourceHeap_; }
+
+private:
+    LLGL::PipelineState* pipelineState_ = nullptr;
+    LLGL::ResourceHeap* resourceHeap_ = nullptr;
+    LLGL::ResourceHeap* matrixBlockHeap_ = nullptr;
+    std::uint32_t matrixBlockIndex_ = 0;
+    bool matrixBlockBound_ = false;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,288 @@
+/**
+ * @file FrameReadback.h
+ * @brief Asynchronous readback of rendered frames for headless rendering
+ * @details A frame is copied into one of a ring of staging buffers when it is requested and handed
+ *          to the sink a few frames later, once the GPU has finished the copy, so the render loop
+ *          never waits for the frame it just submitted. The sink reads the mapped staging buffer
+ *          directly on a delivery thread, in frame order; a slow consumer such as a video encoder
+ *          overlaps with rendering instead of adding to the frame time.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <LLGL/LLGL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RenderingPlugin {
+
+class SoftwareRasterizer;
+
+/**
+ * @brief A frame handed to a readback sink
+ */
+struct ReadbackFrame {
+    std::uint64_t frameNumber = 0;        ///< Frame number given to Request
+    std::uint32_t width = 0;              ///< Width in pixels
+    std::uint32_t height = 0;             ///< Height in pixels
+    std::uint32_t rowPitch = 0;           ///< Bytes between the starts of two rows, at least width * 4
+    const std::uint8_t* data = nullptr;   ///< RGBA8 rows, valid only during the sink call
+};
+
+/**
+ * @brief Consumer of read back frames, called on the delivery thread
+ */
+using ReadbackSink = std::function<void(const ReadbackFrame&)>;
+
+/**
+ * @brief Readback statistics
+ */
+struct FrameReadbackStats {
+    std::uint64_t framesRequested = 0;   ///< Successful Request calls
+    std::uint64_t framesDelivered = 0;   ///< Frames passed to the sink
+    std::uint64_t framesDropped = 0;     ///< Frames skipped because the sink fell behind
+    std::uint64_t bytesDelivered = 0;    ///< Pixel bytes passed to the sink, without row padding
+    double copyTimeMs = 0.0;             ///< Render thread time mapping staging buffers and copying rasterizer images
+    double stallTimeMs = 0.0;            ///< Render thread time waiting for the GPU or the sink
+    double sinkTimeMs = 0.0;             ///< Delivery thread time spent in the sink
+};
+
+/**
+ * @brief Ring of staging buffers that reads frames back without stalling the render loop
+ * @details Usage per frame: render into an RGBA8 texture, submit, then Request(texture, frame)
+ *          and Poll() once. Request only records and submits a texture-to-buffer copy with a
+ *          fence; Poll maps the staging buffers whose fence has signaled, oldest first, and
+ *          queues them for the sink. A staging buffer is reused once the sink has returned and
+ *          it was unmapped by Poll or Request. The render thread only waits when the next buffer
+ *          is still being copied or, unless frames may be dropped, still being read by the sink.
+ *          Request and Poll must be called from the thread owning the render system.
+ */
+class RENDERING_PLUGIN_API FrameReadback {
+public:
+    /**
+     * @brief Constructor
+     * @param renderSystem LLGL render system for texture readbacks, may be null if only the CPU
+     *                     rasterizer is read back
+     * @param ringSize Number of staging buffers, and of image copies for the CPU rasterizer
+     */
+    explicit FrameReadback(LLGL::RenderSystem* renderSystem, std::uint32_t ringSize = 3);
+    
+    /**
+     * @brief Destructor, delivers all requested frames and stops the delivery thread
+     */
+    ~FrameReadback();
+    
+    FrameReadback(const FrameReadback&) = delete;
+    FrameReadback& operator=(const FrameReadback&) = delete;
+    
+    // === Configuration ===
+    
+    /**
+     * @brief Set the consumer of read back frames
+     * @details Delivers all frames requested so far to the previous sink first. Frames read back
+     *          without a sink are discarded.
+     * @param sink Called on the delivery thread, one frame at a time, in request order
+     */
+    void SetSink(ReadbackSink sink);
+    
+    /**
+     * @brief Drop frames instead of waiting when the sink falls behind
+     * @details Off by default, so batch jobs receive every frame; turn on for live previews.
+     * @param enabled true to drop frames
+     */
+    void SetDropFramesWhenBehind(bool enabled);
+    
+    /**
+     * @brief Set the frame size and allocate the staging buffers
+     * @details Called by Request when the source size changes. Delivers all pending frames first.
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @return true if the staging buffers were created
+     */
+    bool Resize(std::uint32_t width, std::uint32_t height);
+    
+    /**
+     * @brief Get the frame width
+     * @return Width in pixels
+     */
+    std::uint32_t GetWidth() const;
+    
+    /**
+     * @brief Get the frame height
+     * @return Height in pixels
+     */
+    std::uint32_t GetHeight() const;
+    
+    /**
+     * @brief Get the number of staging buffers
+     * @return Ring size
+     */
+    std::uint32_t GetRingSize() const;
+    
+    // === Readback ===
+    
+    /**
+     * @brief Start reading back a texture
+     * @details Call after the commands rendering the texture were submitted. The copy is
+     *          submitted on the render system's command queue and completes asynchronously.
+     * @param texture RGBA8 texture created with the CopySrc bind flag
+     * @param frameNumber Number reported with the frame
+     * @return true if the copy was submitted
+     */
+    bool Request(LLGL::Texture& texture, std::uint64_t frameNumber);
+    
+    /**
+     * @brief Read back the image of the CPU rasterizer
+     * @details Flushes the rasterizer and copies its image right away; only the delivery is
+     *          asynchronous.
+     * @param rasterizer Rasterizer holding the frame
+     * @param frameNumber Number reported with the frame
+     * @return true if the frame was queued or dropped by the drop policy
+     */
+    bool Request(SoftwareRasterizer& rasterizer, std::uint64_t frameNumber);
+    
+    /**
+     * @brief Queue every texture readback whose copy has finished and recycle delivered buffers
+     * @details Never blocks on the GPU or the sink.
+     * @return Number of frames queued for the sink
+     */
+    std::size_t Poll();
+    
+    /**
+     * @brief Wait until every requested frame has been passed to the sink
+     */
+    void Flush();
+    
+    /**
+     * @brief Get the number of frames requested but not yet passed to the sink
+     * @return Frames being copied, queued, or in the sink
+     */
+    std::size_t GetPendingCount() const;
+    
+    // === Sinks ===
+    
+    /**
+     * @brief Create a sink writing raw RGBA8 frames to a file
+     * @details Writes tightly packed rows. Works with a pipe to an encoder (e.g. popen of ffmpeg
+     *          with -f rawvideo -pix_fmt rgba) or a file in shared memory such as /dev/shm. The
+     *          file is not closed.
+     * @param file Open file, must outlive the readback
+     * @return Sink
+     */
+    static ReadbackSink CreateFileSink(std::FILE* file);
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get readback statistics
+     * @return Statistics since the last reset
+     */
+    FrameReadbackStats GetStatistics() const;
+    
+    /**
+     * @brief Reset readback statistics
+     */
+    void ResetStatistics();
+
+private:
+    /**
+     * @brief Stage of a staging buffer, advancing in ring order
+     */
+    enum class SlotState {
+        Idle,         ///< Free for the next request
+        Copying,      ///< GPU copy submitted, fence not yet seen
+        Delivering,   ///< Mapped and queued for or read by the sink
+        Delivered     ///< Sink finished, waiting to be unmapped on the render thread
+    };
+    
+    /**
+     * @brief Staging buffer of one texture readback
+     */
+    struct Slot {
+        LLGL::Buffer* buffer = nullptr;
+        LLGL::CommandBuffer* commandBuffer = nullptr;
+        LLGL::Fence* fence = nullptr;
+        std::uint64_t frameNumber = 0;
+        SlotState state = SlotState::Idle;   ///< Guarded by mutex_
+    };
+    
+    /**
+     * @brief Frame waiting for the sink: a mapped staging buffer or a copied rasterizer image
+     */
+    struct QueuedFrame {
+        std::uint64_t frameNumber = 0;
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t rowPitch = 0;
+        const std::uint8_t* mapped = nullptr;   ///< Staging memory of slot
+        std::size_t slot = 0;
+        std::vector<std::uint8_t> pixels;       ///< Image copy when mapped is null
+    };
+    
+    /**
+     * @brief Map the oldest copying slot, waiting for its fence, and queue it
+     */
+    void DeliverOldestCopy();
+    
+    /**
+     * @brief Unmap the slots the sink has finished with
+     */
+    void RecycleSlots();
+    
+    /**
+     * @brief Take a rasterizer image copy, waiting for the sink unless frames may be dropped
+     * @return false if the frame is dropped
+     */
+    bool AcquireImage(QueuedFrame& frame);
+    
+    /**
+     * @brief Hand a frame to the delivery thread, starting it on first use
+     */
+    void QueueFrame(QueuedFrame&& frame);
+    
+    /**
+     * @brief Delivery thread main loop
+     */
+    void DeliveryLoop();
+    
+    /**
+     * @brief Destroy the staging buffers; all slots must be idle
+     */
+    void ReleaseSlots();
+    
+    LLGL::RenderSystem* renderSystem_;
+    std::uint32_t ringSize_;
+    std::uint32_t width_;
+    std::uint32_t height_;
+    std::uint32_t rowPitch_;    ///< Row stride in the staging buffers
+    bool dropFramesWhenBehind_;
+    
+    // Staging ring, render thread only apart from slot states
+    std::vector<Slot> slots_;
+    std::size_t nextSlot_;
+    std::deque<std::size_t> copyingSlots_;   ///< In submission order
+    
+    // Delivery, guarded by mutex_
+    mutable std::mutex mutex_;
+    std::condition_variable queueCondition_;    ///< Signaled when a frame is queued or on shutdown
+    std::condition_variable releaseCondition_;  ///< Signaled when the sink finishes a frame
+    std::deque<QueuedFrame> queue_;
+    std::vector<std::vector<std::uint8_t>> freeImages_;
+    std::uint32_t imagesInUse_;    ///< Rasterizer image copies queued or in the sink
+    std::uint32_t framesInUse_;    ///< Frames queued or in the sink
+    ReadbackSink sink_;
+    bool stopping_;
+    std::thread deliveryThread_;
+    
+    FrameReadbackStats stats_;
+};
+
+} // namespace RenderingPlugin
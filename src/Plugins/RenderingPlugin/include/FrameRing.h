@@ -0,0 +1,131 @@
+/**
+ * @file FrameRing.h
+ * @brief Frame-in-flight slot ring with deferred resource releases
+ * @details Tracks which frame slot is recorded, whether the GPU may still use a slot, and the
+ *          releases queued while a slot was recorded. RenderingSystem owns the command buffers
+ *          and fences; the ring only decides when to wait and when a release is safe, so the
+ *          bookkeeping can be used without a device.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Function that runs a release once the GPU no longer uses the resource
+ * @details Components that free GPU objects take one of these; bind it to
+ *          RenderingSystem::DeferRelease. An empty scheduler releases immediately.
+ */
+using ReleaseScheduler = std::function<void(std::function<void()>)>;
+
+/**
+ * @brief Ring of frame-in-flight slots
+ * @details Usage per frame: BeginSlot() before recording, DeferRelease() while recording,
+ *          MarkSubmitted() once the slot's work and fence are submitted, then Advance().
+ *          A release queued in a slot runs when that slot begins again, after waiting for the
+ *          GPU to finish the frame it was queued in. Not thread-safe.
+ */
+class RENDERING_PLUGIN_API FrameRing {
+public:
+    /**
+     * @brief Function that blocks until the GPU finished the given slot's last submission
+     */
+    using WaitFunction = std::function<void(std::uint32_t slot)>;
+    
+    /**
+     * @brief Constructor
+     * @param slotCount Number of frames in flight, 0 for none
+     */
+    explicit FrameRing(std::uint32_t slotCount = 0);
+    
+    /**
+     * @brief Destructor, runs the pending releases
+     */
+    ~FrameRing();
+    
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+    
+    /**
+     * @brief Run all pending releases and resize the ring
+     * @details The caller has to make sure the GPU is idle.
+     * @param slotCount Number of frames in flight, 0 for none
+     */
+    void Reset(std::uint32_t slotCount);
+    
+    /**
+     * @brief Begin recording the current slot
+     * @details If the slot was submitted, waits for it and then runs the releases queued while
+     *          it was last recorded.
+     * @param wait Called with the slot index if the GPU may still use the slot
+     * @return true if wait was called
+     */
+    bool BeginSlot(const WaitFunction& wait);
+    
+    /**
+     * @brief Mark the current slot as submitted to the GPU
+     */
+    void MarkSubmitted();
+    
+    /**
+     * @brief Move to the next slot, wrapping around after the last one
+     */
+    void Advance();
+    
+    /**
+     * @brief Queue a release until the current slot's frame is finished
+     * @details Runs the release immediately if the ring has no slots.
+     * @param release Function releasing the resource
+     */
+    void DeferRelease(std::function<void()> release);
+    
+    /**
+     * @brief Run all pending releases of all slots
+     * @details The caller has to make sure the GPU is idle.
+     */
+    void ReleaseAll();
+    
+    /**
+     * @brief Get number of slots
+     * @return Frames in flight
+     */
+    std::uint32_t GetSlotCount() const;
+    
+    /**
+     * @brief Get the slot being recorded
+     * @return Slot index in [0, GetSlotCount())
+     */
+    std::uint32_t GetSlotIndex() const;
+    
+    /**
+     * @brief Check if the GPU may still use a slot
+     * @param slot Slot index
+     * @return true if the slot was submitted and not waited for
+     */
+    bool IsSubmitted(std::uint32_t slot) const;
+    
+    /**
+     * @brief Get number of queued releases
+     * @return Pending releases over all slots
+     */
+    std::size_t GetPendingReleaseCount() const;
+
+private:
+    struct Slot {
+        bool submitted = false;
+        std::vector<std::function<void()>> pendingReleases;
+    };
+    
+    static void RunReleases(Slot& slot);
+    
+    std::vector<Slot> slots_;
+    std::uint32_t slotIndex_;
+};
+
+} // namespace RenderingPlugin
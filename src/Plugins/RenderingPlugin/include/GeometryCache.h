@@ -0,0 +1,260 @@
+/**
+ * @file GeometryCache.h
+ * @brief Cache of procedurally generated meshes keyed by generator parameters
+ * @details Identical GeometryGenerator calls share one immutable MeshData and, optionally, one
+ *          pair of GPU buffers. Memory is bounded by a least-recently-used eviction policy.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "FrameRing.h"
+#include "GeometryGenerator.h"
+#include "ResourceManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief GeometryGenerator function a cache entry is produced by
+ */
+enum class GeometryType : std::uint8_t {
+    Triangle,
+    Quad,
+    Cube,
+    Box,
+    Sphere,
+    UVSphere,
+    Icosphere,
+    Cylinder,
+    Cone,
+    Capsule,
+    Torus,
+    Plane,
+    Circle,
+    Ring,
+    Tetrahedron,
+    Octahedron,
+    Dodecahedron,
+    Icosahedron
+};
+
+/**
+ * @brief Generator type and arguments identifying a cached mesh
+ * @details Use the factory functions, which take the same arguments and defaults as the
+ *          matching GeometryGenerator::Generate* function.
+ */
+struct RENDERING_PLUGIN_API GeometryKey {
+    GeometryType type = GeometryType::Cube;
+    float sizes[3] = { 0.0f, 0.0f, 0.0f };     ///< Float arguments in declaration order
+    std::uint32_t counts[2] = { 0, 0 };        ///< Segment/subdivision arguments in declaration order
+    GeometryParams params;
+    
+    static GeometryKey Triangle(float size = 1.0f, const GeometryParams& params = {});
+    static GeometryKey Quad(float width = 1.0f, float height = 1.0f, const GeometryParams& params = {});
+    static GeometryKey Cube(float size = 1.0f, const GeometryParams& params = {});
+    static GeometryKey Box(float width, float height, float depth, const GeometryParams& params = {});
+    static GeometryKey Sphere(float radius = 1.0f, std::uint32_t slices = 32, std::uint32_t stacks = 16,
+                              const GeometryParams& params = {});
+    static GeometryKey UVSphere(float radius = 1.0f, std::uint32_t longitudeSegments = 32,
+                                std::uint32_t latitudeSegments = 16, const GeometryParams& params = {});
+    static GeometryKey Icosphere(float radius = 1.0f, std::uint32_t subdivisions = 2, const GeometryParams& params = {});
+    static GeometryKey Cylinder(float topRadius = 1.0f, float bottomRadius = 1.0f, float height = 2.0f,
+                                std::uint32_t slices = 32, std::uint32_t stacks = 1, const GeometryParams& params = {});
+    static GeometryKey Cone(float radius = 1.0f, float height = 2.0f, std::uint32_t slices = 32,
+                            std::uint32_t stacks = 1, const GeometryParams& params = {});
+    static GeometryKey Capsule(float radius = 1.0f, float height = 2.0f, std::uint32_t slices = 32,
+                               std::uint32_t stacks = 8, const GeometryParams& params = {});
+    static GeometryKey Torus(float majorRadius = 1.0f, float minorRadius = 0.3f, std::uint32_t majorSegments = 32,
+                             std::uint32_t minorSegments = 16, const GeometryParams& params = {});
+    static GeometryKey Plane(float width = 1.0f, float depth = 1.0f, std::uint32_t widthSegments = 1,
+                             std::uint32_t depthSegments = 1, const GeometryParams& params = {});
+    static GeometryKey Circle(float radius = 1.0f, std::uint32_t segments = 32, const GeometryParams& params = {});
+    static GeometryKey Ring(float innerRadius = 0.5f, float outerRadius = 1.0f, std::uint32_t segments = 32,
+                            const GeometryParams& params = {});
+    static GeometryKey Tetrahedron(float size = 1.0f, const GeometryParams& params = {});
+    static GeometryKey Octahedron(float size = 1.0f, const GeometryParams& params = {});
+    static GeometryKey Dodecahedron(float size = 1.0f, const GeometryParams& params = {});
+    static GeometryKey Icosahedron(float size = 1.0f, const GeometryParams& params = {});
+    
+    /**
+     * @brief Compare type, arguments and parameters
+     */
+    bool operator==(const GeometryKey& other) const;
+};
+
+/**
+ * @brief Hash function for GeometryKey
+ */
+struct RENDERING_PLUGIN_API GeometryKeyHash {
+    std::size_t operator()(const GeometryKey& key) const;
+};
+
+/**
+ * @brief Shared GPU buffers of a cached mesh
+ */
+struct GeometryBuffers {
+    ResourceId vertexBufferId = 0;
+    ResourceId indexBufferId = 0;
+    std::uint32_t indexCount = 0;
+    std::shared_ptr<const void> pin;  ///< Keeps the cache from evicting the buffers while held
+    
+    /**
+     * @brief Check if the buffers were created
+     * @return true if both buffers exist, false otherwise
+     */
+    bool IsValid() const { return vertexBufferId != 0 && indexBufferId != 0; }
+};
+
+/**
+ * @brief Geometry cache statistics
+ */
+struct GeometryCacheStats {
+    std::uint64_t hits = 0;          ///< Lookups served from the cache
+    std::uint64_t misses = 0;        ///< Lookups that generated the mesh
+    std::uint64_t evictions = 0;     ///< Entries dropped to stay within the budget
+    std::size_t entryCount = 0;      ///< Cached meshes
+    std::size_t memoryUsed = 0;      ///< Bytes of cached mesh data plus GPU buffers
+    std::size_t memoryBudget = 0;    ///< Byte limit enforced by eviction
+    
+    /**
+     * @brief Get the fraction of lookups served from the cache
+     * @return Hit rate in [0, 1]
+     */
+    double GetHitRate() const {
+        const std::uint64_t lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+/**
+ * @brief LRU cache of generated meshes
+ * @details GetMesh() is thread-safe. GetBuffers() creates GPU resources and must be called from
+ *          the render thread. Meshes handed out stay valid after eviction because they are shared.
+ *          Entries whose GeometryBuffers are still held are skipped by eviction; once the last
+ *          copy is dropped the entry can be evicted again, and its buffers are released through
+ *          the release scheduler so frames in flight can finish using them.
+ */
+class RENDERING_PLUGIN_API GeometryCache {
+public:
+    /**
+     * @brief Constructor
+     * @param resourceManager Resource manager for GetBuffers (may be nullptr for CPU-only use)
+     * @param memoryBudget Byte limit for cached mesh data and GPU buffers
+     */
+    explicit GeometryCache(ResourceManager* resourceManager = nullptr, std::size_t memoryBudget = 64 * 1024 * 1024);
+    
+    /**
+     * @brief Destructor; releases all cached GPU buffers, including ones still held
+     */
+    ~GeometryCache();
+    
+    GeometryCache(const GeometryCache&) = delete;
+    GeometryCache& operator=(const GeometryCache&) = delete;
+    
+    /**
+     * @brief Get shared mesh data, generating it on a miss
+     * @param key Generator type and arguments
+     * @return Immutable mesh data
+     */
+    std::shared_ptr<const MeshData> GetMesh(const GeometryKey& key);
+    
+    /**
+     * @brief Get shared GPU buffers, generating and uploading the mesh on a miss
+     * @details The buffer IDs stay valid as long as the returned GeometryBuffers, or a copy of
+     *          it, is held: the entry is pinned and not evicted, even over budget. Drop it once
+     *          the buffers are no longer recorded into new frames.
+     * @param key Generator type and arguments
+     * @return Buffers, invalid if no resource manager is set or creation failed
+     */
+    GeometryBuffers GetBuffers(const GeometryKey& key);
+    
+    /**
+     * @brief Check if a mesh is cached, without affecting its LRU position or the statistics
+     * @param key Generator type and arguments
+     * @return true if cached, false otherwise
+     */
+    bool Contains(const GeometryKey& key) const;
+    
+    /**
+     * @brief Change the memory budget, evicting entries if needed
+     * @param memoryBudget Byte limit
+     */
+    void SetMemoryBudget(std::size_t memoryBudget);
+    
+    /**
+     * @brief Drop all entries not pinned by held GeometryBuffers and release their GPU buffers
+     */
+    void Clear();
+    
+    /**
+     * @brief Set how evicted GPU buffers are released
+     * @details Bind to RenderingSystem::DeferRelease so buffers recorded into frames still in
+     *          flight outlive those frames. Without a scheduler buffers are released immediately.
+     * @param scheduler Release scheduler, or nullptr
+     */
+    void SetReleaseScheduler(ReleaseScheduler scheduler);
+    
+    /**
+     * @brief Get cache statistics
+     * @return Snapshot of the statistics
+     */
+    GeometryCacheStats GetStatistics() const;
+    
+    /**
+     * @brief Generate the mesh a key describes, bypassing the cache
+     * @param key Generator type and arguments
+     * @return Generated mesh data
+     */
+    static MeshData Generate(const GeometryKey& key);
+
+private:
+    /**
+     * @brief Cached mesh and its buffers
+     */
+    struct Entry {
+        GeometryKey key;
+        std::shared_ptr<const MeshData> mesh;
+        GeometryBuffers buffers;
+        std::size_t memorySize = 0;
+    };
+    
+    using EntryList = std::list<Entry>;
+    
+    /**
+     * @brief Find or generate an entry and move it to the front of the LRU list; mutex_ must be held
+     */
+    Entry& Acquire(const GeometryKey& key);
+    
+    /**
+     * @brief Evict least recently used entries until the budget is met; mutex_ must be held
+     * @details Entries pinned by held GeometryBuffers are skipped.
+     * @param keep Entry that must not be evicted (may be nullptr)
+     */
+    void EvictToBudget(const Entry* keep);
+    
+    /**
+     * @brief Check if GeometryBuffers handed out for an entry are still held
+     */
+    static bool IsPinned(const Entry& entry);
+    
+    /**
+     * @brief Release an entry's GPU buffers through the release scheduler
+     */
+    void ReleaseBuffers(Entry& entry);
+    
+    ResourceManager* resourceManager_;
+    ReleaseScheduler releaseScheduler_;
+    
+    mutable std::mutex mutex_;
+    EntryList entries_;  ///< Most recently used first
+    std::unordered_map<GeometryKey, EntryList::iterator, GeometryKeyHash> lookup_;
+    GeometryCacheStats stats_;
+};
+
+} // namespace RenderingPlugin
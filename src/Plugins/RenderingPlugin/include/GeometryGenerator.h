@@ -17,6 +17,7 @@ namespace RenderingPlugin {
 // Forward declarations
 struct Vertex;
 class ResourceManager;
+class ThreadPool;
 
 /**
  * @brief Mesh data structure
@@ -291,8 +292,10 @@ public:
      * @param meshData Mesh data
      * @param minBounds Output minimum bounds
      * @param maxBounds Output maximum bounds
+     * @param threadPool Pool to split large meshes across (may be nullptr)
      */
-    static void CalculateBounds(const MeshData& meshData, Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds);
+    static void CalculateBounds(const MeshData& meshData, Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds,
+                                ThreadPool* threadPool = nullptr);
     
     /**
      * @brief Calculate mesh center point
@@ -303,25 +306,32 @@ public:
     
     /**
      * @brief Transform mesh vertices
+     * @details Positions are transformed by the affine part of the matrix, normals by its inverse
+     *          transpose and renormalized.
      * @param meshData Mesh data to transform
      * @param transform Transformation matrix
+     * @param threadPool Pool to split large meshes across (may be nullptr)
      */
-    static void TransformMesh(MeshData& meshData, const Gs::Matrix4f& transform);
+    static void TransformMesh(MeshData& meshData, const Gs::Matrix4f& transform, ThreadPool* threadPool = nullptr);
     
     /**
      * @brief Merge multiple meshes into one
      * @param meshes Array of meshes to merge
      * @param meshCount Number of meshes
-     * @return Merged mesh data
+     * @param threadPool Pool to run the index offset pass on (may be nullptr)
+     * @return Merged mesh data, empty if the vertices do not fit 32-bit indices
      */
-    static MeshData MergeMeshes(const MeshData* meshes, std::size_t meshCount);
+    static MeshData MergeMeshes(const MeshData* meshes, std::size_t meshCount, ThreadPool* threadPool = nullptr);
     
     /**
      * @brief Generate normals for mesh data
+     * @details Smooth normals of large meshes are accumulated per chunk of triangles in separate
+     *          buffers, which costs one extra normal per vertex for each additional chunk.
      * @param meshData Mesh data to generate normals for
      * @param smooth Whether to generate smooth normals (true) or flat normals (false)
+     * @param threadPool Pool to split smooth normal generation across (may be nullptr)
      */
-    static void GenerateNormals(MeshData& meshData, bool smooth = true);
+    static void GenerateNormals(MeshData& meshData, bool smooth = true, ThreadPool* threadPool = nullptr);
     
     /**
      * @brief Generate tangent vectors for mesh data
@@ -0,0 +1,235 @@
+/**
+ * @file GpuCulling.h
+ * @brief GPU-driven frustum culling of a SceneStore with indirect draw submission
+ * @details The transforms and bounds of all scene objects live in GPU storage buffers that are
+ *          only updated where the scene changed. Each frame a compute pass tests every object
+ *          against the camera frustum and compacts the world matrices of the visible ones into
+ *          an instance buffer, counting the instances of each mesh in its indirect draw record.
+ *          Drawing then records one indirect draw per run of meshes sharing pipeline and
+ *          buffers, so the CPU cost of a frame depends on the number of meshes, not objects.
+ */
+
+#pragma once
+
+#include "FrameRing.h"
+#include "RenderingPluginExport.h"
+#include "ResourceManager.h"
+#include <LLGL/LLGL.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace RenderingPlugin {
+
+class RenderCommands;
+class SceneStore;
+
+/**
+ * @brief Statistics of the last Cull and Submit
+ */
+struct GpuCullingStats {
+    bool gpuCulling = false;             ///< Culled by the compute pass, otherwise by SceneStore::Cull
+    std::size_t objectCount = 0;         ///< Objects in the scene
+    std::size_t drawGroups = 0;          ///< Indirect draw records, one per distinct mesh draw
+    std::uint32_t drawCommands = 0;      ///< Draw commands recorded by Submit
+    std::uint32_t uploadedObjects = 0;   ///< Object records uploaded by Cull
+    std::uint64_t uploadedBytes = 0;     ///< Bytes uploaded by Cull, including draw records
+    double cullCpuTimeMs = 0.0;          ///< CPU time of Cull
+    double submitCpuTimeMs = 0.0;        ///< CPU time of Submit
+};
+
+/**
+ * @brief Frustum culling and draw submission of a SceneStore on the GPU
+ * @details Objects are drawn instanced with their world matrix streamed from slot 1, like
+ *          batches (see RenderCommands::GetInstanceVertexFormat), so the same pipelines work
+ *          with both paths. Objects with an LOD chain are drawn with the level they were given
+ *          last instead of a per-frame selection.
+ *          Without compute shaders, storage buffers or indirect draws, or without GLSL 4.30
+ *          for the built-in culling shader, Cull and Submit fall back to SceneStore::Cull and
+ *          SceneStore::Submit. A GpuCulling instance consumes the scene's dirty range, so only
+ *          one instance may mirror a scene.
+ */
+class RENDERING_PLUGIN_API GpuCulling {
+public:
+    /**
+     * @brief Create the culling pipeline if the render system supports it
+     * @param renderSystem Render system creating the buffers
+     * @param resourceManager Resources referenced by the scene's draws
+     */
+    GpuCulling(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager);
+    
+    /**
+     * @brief Destructor, releases the GPU buffers and the culling pipeline
+     */
+    ~GpuCulling();
+    
+    GpuCulling(const GpuCulling&) = delete;
+    GpuCulling& operator=(const GpuCulling&) = delete;
+    
+    /**
+     * @brief Check if a render system can run GPU culling
+     * @param renderSystem Render system
+     * @return true with compute shaders, storage buffers, indirect draws and GLSL 4.30
+     */
+    static bool IsSupported(const LLGL::RenderSystem* renderSystem);
+    
+    /**
+     * @brief Check if Cull and Submit use the GPU path
+     * @return false if unsupported, if the pipeline failed to build or if disabled
+     */
+    bool IsGpuCullingActive() const;
+    
+    /**
+     * @brief Switch between the GPU path and the CPU fallback
+     * @details Switching back to the GPU path uploads the whole scene again.
+     * @param enabled Use the GPU path when supported (default: true)
+     */
+    void SetGpuCullingEnabled(bool enabled);
+    
+    /**
+     * @brief Set how replaced GPU buffers are released
+     * @details Bind to RenderingSystem::DeferRelease so buffers recorded into frames still in
+     *          flight outlive those frames. Without a scheduler buffers are released immediately,
+     *          so the caller has to make sure the GPU is idle when the scene grows.
+     * @param scheduler Release scheduler, or nullptr
+     */
+    void SetReleaseScheduler(ReleaseScheduler scheduler);
+    
+    // === Frame ===
+    
+    /**
+     * @brief Upload scene changes and record the culling pass
+     * @details Must be recorded outside of a render pass, e.g. in a render graph pass without
+     *          attachments. Uses the scene's camera.
+     * @param commands Render commands recording the frame
+     * @param scene Scene to cull
+     */
+    void Cull(RenderCommands& commands, SceneStore& scene);
+    
+    /**
+     * @brief Record the draws of the objects that passed the last Cull
+     * @param commands Render commands recording the frame, inside a render pass
+     * @param scene Scene passed to Cull
+     * @param defaultPipeline Pipeline state for objects without their own pipeline state
+     */
+    void Submit(RenderCommands& commands, SceneStore& scene, LLGL::PipelineState* defaultPipeline);
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get statistics of the last Cull and Submit
+     * @return Culling statistics
+     */
+    const GpuCullingStats& GetStatistics() const;
+
+private:
+    /**
+     * @brief Object as read by the culling shader (std430)
+     */
+    struct ObjectRecord {
+        float world[16];           ///< World matrix, copied into the instance buffer if visible
+        float sphere[4];           ///< World-space bounding sphere, negative radius if disabled
+        std::uint32_t group;       ///< Draw record of the object's mesh
+        std::uint32_t padding[3];
+    };
+    
+    /**
+     * @brief Constant buffer of the culling shader (std140)
+     */
+    struct CullParams {
+        float planes[6][4];
+        std::uint32_t objectCount;
+        std::uint32_t padding[3];
+    };
+    
+    /**
+     * @brief Objects sharing one mesh draw, drawn by one indirect draw record
+     */
+    struct DrawGroup {
+        MeshDraw draw;
+        std::uint32_t objectCount = 0;
+        std::uint32_t firstInstance = 0;   ///< Start of the group's range in the instance buffer
+    };
+    
+    using GroupKey = std::tuple<ResourceId, ResourceId, ResourceId, ResourceId, std::uint32_t, std::uint32_t>;
+    
+    /**
+     * @brief Build the culling shader, layout and compute pipeline
+     * @return false if any of them failed
+     */
+    bool CreatePipeline();
+    
+    /**
+     * @brief Grow the GPU buffers to hold a number of objects and draw records
+     * @return false if creation failed; the previous buffers are released either way
+     */
+    bool EnsureCapacity(std::uint32_t objectCount, std::uint32_t groupCount);
+    
+    /**
+     * @brief Release all GPU buffers, the resource heap and the buffer arrays through the release scheduler
+     */
+    void ReleaseBuffers();
+    
+    /**
+     * @brief Bring the GPU copy of the scene up to date
+     * @return false if the buffers could not be created
+     */
+    bool SyncScene(RenderCommands& commands, SceneStore& scene);
+    
+    /**
+     * @brief Forget the GPU copy, so the next sync uploads the whole scene
+     */
+    void ResetMirror();
+    
+    /**
+     * @brief Get the draw group of a mesh draw, adding it if new
+     */
+    std::uint32_t AcquireGroup(const MeshDraw& draw);
+    
+    /**
+     * @brief Record a buffer update in chunks the command buffer accepts
+     */
+    void UploadBuffer(RenderCommands& commands, LLGL::Buffer* buffer, const void* data,
+                      std::uint64_t size, std::uint64_t offset);
+    
+    /**
+     * @brief Get the buffer array of a mesh vertex buffer and the instance buffer
+     */
+    LLGL::BufferArray* GetBufferArray(ResourceId vertexBufferId);
+    
+    LLGL::RenderSystem* renderSystem_;
+    ResourceManager* resourceManager_;
+    bool supported_;
+    bool enabled_;
+    
+    // Culling pipeline, owned through the resource manager
+    ResourceId shaderId_;
+    ResourceId pipelineLayoutId_;
+    ResourceId pipelineId_;
+    
+    // GPU copy of the scene
+    LLGL::Buffer* paramsBuffer_;
+    LLGL::Buffer* objectBuffer_;
+    LLGL::Buffer* drawBuffer_;       ///< Indirect draw records, instance counts written by the culling pass
+    LLGL::Buffer* instanceBuffer_;   ///< Compacted world matrices, bound as vertex stream 1
+    LLGL::ResourceHeap* resourceHeap_;
+    std::uint32_t objectCapacity_;
+    std::uint32_t groupCapacity_;
+    std::unordered_map<ResourceId, LLGL::BufferArray*> bufferArrays_;   ///< Mesh VB -> {mesh VB, instance buffer}
+    ReleaseScheduler releaseScheduler_;
+    
+    // CPU side of the copy
+    std::vector<DrawGroup> groups_;
+    std::map<GroupKey, std::uint32_t> groupLookup_;
+    std::vector<std::uint32_t> objectGroups_;                  ///< Group of each uploaded object, by storage index
+    std::vector<ObjectRecord> staging_;
+    std::vector<LLGL::DrawIndexedIndirectArguments> drawRecords_;
+    bool mirrorValid_;                                         ///< GPU copy matches the scene up to its dirty range
+    
+    GpuCullingStats stats_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,231 @@
+/**
+ * @file HandlePool.h
+ * @brief Dense generational slot pool addressed by 32-bit handles
+ * @details Values are stored contiguously and addressed through a slot table. A handle packs
+ *          a type tag, the slot generation and the slot index, so lookups are two array reads
+ *          and handles of released or foreign-typed resources are rejected.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Dense generational slot pool
+ * @details Handle layout: [type tag : 4][generation : 8][slot index : 20]. The type tag is
+ *          non-zero, so 0 is never a valid handle. A slot whose generation would wrap is
+ *          retired instead of reused. Pointers returned by Get() stay valid until the next
+ *          Insert() or Erase(). Concurrent Get() calls are safe while nothing is inserted or erased.
+ * @tparam T Stored value type
+ */
+template <typename T>
+class HandlePool {
+public:
+    static constexpr std::uint32_t kIndexBits = 20;
+    static constexpr std::uint32_t kGenerationBits = 8;
+    static constexpr std::uint32_t kTypeBits = 4;
+    static constexpr std::uint32_t kMaxSlots = 1u << kIndexBits;
+    
+    /**
+     * @brief Constructor
+     * @param typeTag Tag stored in every handle of this pool (1-15)
+     */
+    explicit HandlePool(std::uint8_t typeTag)
+        : typeTag_(typeTag & ((1u << kTypeBits) - 1)) {
+    }
+    
+    /**
+     * @brief Insert a value
+     * @param value Value to store
+     * @return Handle of the value, or 0 if all slots are exhausted
+     */
+    std::uint32_t Insert(T value) {
+        std::uint32_t slotIndex;
+        if (!freeSlots_.empty()) {
+            slotIndex = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            if (slots_.size() >= kMaxSlots) {
+                return 0;
+            }
+            slotIndex = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot());
+        }
+        
+        Slot& slot = slots_[slotIndex];
+        slot.denseIndex = static_cast<std::uint32_t>(values_.size());
+        values_.push_back(std::move(value));
+        denseToSlot_.push_back(slotIndex);
+        
+        return MakeHandle(slotIndex, slot.generation);
+    }
+    
+    /**
+     * @brief Look up a value
+     * @param handle Handle returned by Insert()
+     * @return Pointer to the value, or nullptr if the handle is stale or belongs to another pool
+     */
+    T* Get(std::uint32_t handle) {
+        const std::uint32_t denseIndex = Resolve(handle);
+        return (denseIndex != kInvalidIndex) ? &values_[denseIndex] : nullptr;
+    }
+    
+    /**
+     * @brief Look up a value
+     * @param handle Handle returned by Insert()
+     * @return Pointer to the value, or nullptr if the handle is stale or belongs to another pool
+     */
+    const T* Get(std::uint32_t handle) const {
+        const std::uint32_t denseIndex = Resolve(handle);
+        return (denseIndex != kInvalidIndex) ? &values_[denseIndex] : nullptr;
+    }
+    
+    /**
+     * @brief Check if a handle refers to a live value
+     * @param handle Handle to check
+     * @return true if the handle is valid, false otherwise
+     */
+    bool Contains(std::uint32_t handle) const {
+        return Resolve(handle) != kInvalidIndex;
+    }
+    
+    /**
+     * @brief Remove a value; its handle becomes stale
+     * @param handle Handle of the value to remove
+     * @param removed Receives the removed value (optional)
+     * @return true if a value was removed, false if the handle was not valid
+     */
+    bool Erase(std::uint32_t handle, T* removed = nullptr) {
+        const std::uint32_t denseIndex = Resolve(handle);
+        if (denseIndex == kInvalidIndex) {
+            return false;
+        }
+        
+        if (removed) {
+            *removed = std::move(values_[denseIndex]);
+        }
+        
+        const std::uint32_t slotIndex = handle & (kMaxSlots - 1);
+        
+        // Keep values contiguous: move the last value into the hole
+        const std::uint32_t lastIndex = static_cast<std::uint32_t>(values_.size() - 1);
+        if (denseIndex != lastIndex) {
+            values_[denseIndex] = std::move(values_[lastIndex]);
+            denseToSlot_[denseIndex] = denseToSlot_[lastIndex];
+            slots_[denseToSlot_[denseIndex]].denseIndex = denseIndex;
+        }
+        values_.pop_back();
+        denseToSlot_.pop_back();
+        
+        Slot& slot = slots_[slotIndex];
+        slot.denseIndex = kInvalidIndex;
+        if (++slot.generation < (1u << kGenerationBits)) {
+            freeSlots_.push_back(slotIndex);
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Remove all values, invalidating every handle
+     */
+    void Clear() {
+        for (std::uint32_t slotIndex : denseToSlot_) {
+            Slot& slot = slots_[slotIndex];
+            slot.denseIndex = kInvalidIndex;
+            if (++slot.generation < (1u << kGenerationBits)) {
+                freeSlots_.push_back(slotIndex);
+            }
+        }
+        values_.clear();
+        denseToSlot_.clear();
+    }
+    
+    /**
+     * @brief Get number of live values
+     * @return Value count
+     */
+    std::size_t Size() const {
+        return values_.size();
+    }
+    
+    /**
+     * @brief Call a function for every live value, in storage order
+     * @param func Function called with (handle, value)
+     */
+    template <typename Func>
+    void ForEach(Func&& func) {
+        for (std::size_t i = 0; i < values_.size(); ++i) {
+            const std::uint32_t slotIndex = denseToSlot_[i];
+            func(MakeHandle(slotIndex, slots_[slotIndex].generation), values_[i]);
+        }
+    }
+    
+    /**
+     * @brief Call a function for every live value, in storage order
+     * @param func Function called with (handle, value)
+     */
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (std::size_t i = 0; i < values_.size(); ++i) {
+            const std::uint32_t slotIndex = denseToSlot_[i];
+            func(MakeHandle(slotIndex, slots_[slotIndex].generation), values_[i]);
+        }
+    }
+    
+    /**
+     * @brief Get the type tag stored in a handle
+     * @param handle Handle to inspect
+     * @return Type tag, 0 for the null handle
+     */
+    static std::uint8_t GetTypeTag(std::uint32_t handle) {
+        return static_cast<std::uint8_t>(handle >> (kIndexBits + kGenerationBits));
+    }
+
+private:
+    static constexpr std::uint32_t kInvalidIndex = ~0u;
+    
+    /**
+     * @brief Slot table entry
+     */
+    struct Slot {
+        std::uint32_t denseIndex = kInvalidIndex;  ///< Index into values_, kInvalidIndex if free
+        std::uint32_t generation = 0;              ///< Incremented on every release
+    };
+    
+    /**
+     * @brief Pack a slot index and generation into a handle of this pool
+     */
+    std::uint32_t MakeHandle(std::uint32_t slotIndex, std::uint32_t generation) const {
+        return (static_cast<std::uint32_t>(typeTag_) << (kIndexBits + kGenerationBits)) |
+               (generation << kIndexBits) | slotIndex;
+    }
+    
+    /**
+     * @brief Map a handle to its value index
+     * @return Index into values_, or kInvalidIndex if the handle is not live in this pool
+     */
+    std::uint32_t Resolve(std::uint32_t handle) const {
+        const std::uint32_t slotIndex = handle & (kMaxSlots - 1);
+        const std::uint32_t generation = (handle >> kIndexBits) & ((1u << kGenerationBits) - 1);
+        
+        if (GetTypeTag(handle) != typeTag_ || slotIndex >= slots_.size()) {
+            return kInvalidIndex;
+        }
+        
+        const Slot& slot = slots_[slotIndex];
+        return (slot.generation == generation) ? slot.denseIndex : kInvalidIndex;
+    }
+    
+    std::uint8_t typeTag_;
+    std::vector<T> values_;                  ///< Live values, contiguous
+    std::vector<std::uint32_t> denseToSlot_; ///< Slot index of each value
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,166 @@
+/**
+ * @file LodChain.h
+ * @brief Level-of-detail chains built by mesh simplification, and screen-space LOD selection
+ * @details All levels of a chain index one shared vertex buffer and are stored back to back in
+ *          one index buffer, so switching levels only changes firstIndex/indexCount of a draw and
+ *          objects at the same level still batch into one instanced draw.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "GeometryGenerator.h"
+#include "ResourceManager.h"
+#include <Gauss/Matrix.h>
+#include <Gauss/Vector3.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief One detail level inside a shared index buffer
+ */
+struct LodLevel {
+    std::uint32_t firstIndex = 0;
+    std::uint32_t indexCount = 0;
+    float error = 0.0f;            ///< Geometric error against level 0, in mesh units
+};
+
+/**
+ * @brief LOD chain generation settings
+ */
+struct RENDERING_PLUGIN_API LodChainSettings {
+    std::uint32_t maxLevels = 6;          ///< Levels including the full detail mesh
+    float reduction = 0.5f;               ///< Index count of each level relative to the previous one
+    std::uint32_t minTriangles = 32;      ///< Stop before a level would have fewer triangles
+    float maxError = 0.05f;               ///< Largest level error, relative to the bounding radius
+    bool optimizeVertexCache = true;      ///< Reorder each level's triangles for the vertex cache
+};
+
+/**
+ * @brief CPU-side LOD chain: shared vertices, all levels' indices and bounds
+ */
+struct LodMesh {
+    MeshData mesh;                        ///< Vertices and the concatenated indices of all levels
+    std::vector<LodLevel> levels;         ///< Finest first
+    Gs::Vector3f boundsCenter;            ///< Center of the object-space bounding sphere
+    float boundsRadius = 0.0f;            ///< Radius of the object-space bounding sphere
+};
+
+/**
+ * @brief GPU-side LOD chain
+ */
+struct LodChain {
+    ResourceId vertexBufferId = 0;
+    ResourceId indexBufferId = 0;
+    std::vector<LodLevel> levels;
+    Gs::Vector3f boundsCenter;
+    float boundsRadius = 0.0f;
+    
+    /**
+     * @brief Check if the buffers were created
+     * @return true if both buffers exist and there is at least one level, false otherwise
+     */
+    bool IsValid() const { return vertexBufferId != 0 && indexBufferId != 0 && !levels.empty(); }
+    
+    /**
+     * @brief Build the draw of one level
+     * @param level Level index, clamped to the coarsest level
+     * @param pipelineStateId Pipeline state of the draw (0 for the batch default)
+     * @param resourceHeapId Resource heap of the draw (may be 0)
+     * @return Mesh draw referencing the shared buffers
+     */
+    MeshDraw GetDraw(std::uint32_t level, ResourceId pipelineStateId = 0, ResourceId resourceHeapId = 0) const;
+};
+
+/**
+ * @brief Builds LOD chains from meshes
+ */
+class RENDERING_PLUGIN_API LodGenerator {
+public:
+    /**
+     * @brief Simplify a mesh into a chain of detail levels
+     * @details Each level is simplified from the previous one; level errors accumulate so they
+     *          stay upper bounds against the full detail mesh.
+     * @param meshData Full detail mesh
+     * @param settings Generation settings
+     * @return LOD mesh, with only level 0 if the mesh cannot be simplified
+     */
+    static LodMesh Generate(const MeshData& meshData, const LodChainSettings& settings = {});
+    
+    /**
+     * @brief Upload an LOD mesh into one vertex and one index buffer
+     * @param lodMesh LOD mesh to upload
+     * @param resourceManager Resource manager to create the buffers with
+     * @return LOD chain, invalid on failure
+     */
+    static LodChain CreateChain(const LodMesh& lodMesh, ResourceManager& resourceManager);
+    
+    /**
+     * @brief Release the buffers of an LOD chain
+     * @param chain LOD chain to release
+     * @param resourceManager Resource manager the buffers were created with
+     */
+    static void ReleaseChain(LodChain& chain, ResourceManager& resourceManager);
+};
+
+/**
+ * @brief Picks detail levels from the projected size of their error on screen
+ */
+class RENDERING_PLUGIN_API LodSelector {
+public:
+    /**
+     * @brief Constructor
+     */
+    LodSelector();
+    
+    /**
+     * @brief Set the camera used for projection
+     * @param viewMatrix View matrix
+     * @param projectionMatrix Perspective projection matrix
+     * @param viewportHeight Viewport height in pixels
+     */
+    void SetCamera(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix, float viewportHeight);
+    
+    /**
+     * @brief Set the largest error allowed on screen
+     * @param pixels Projected error threshold in pixels (default 1)
+     */
+    void SetPixelError(float pixels);
+    
+    /**
+     * @brief Select the coarsest level whose projected error stays below the threshold
+     * @param levels Levels, finest first
+     * @param worldCenter World-space center of the bounding sphere
+     * @param worldRadius World-space radius of the bounding sphere
+     * @param worldScale Largest scale of the world transform, converting level errors to world units
+     * @return Level index
+     */
+    std::uint32_t SelectLevel(const std::vector<LodLevel>& levels, const Gs::Vector3f& worldCenter,
+                              float worldRadius, float worldScale) const;
+    
+    /**
+     * @brief Select a level of a chain for an object
+     * @param chain LOD chain
+     * @param worldMatrix World transformation matrix of the object
+     * @return Level index
+     */
+    std::uint32_t SelectLevel(const LodChain& chain, const Gs::Matrix4f& worldMatrix) const;
+    
+    /**
+     * @brief Point a render object at the level selected for its transform
+     * @param renderObject Render object to update (uses transform.world)
+     * @param chain LOD chain the object draws
+     * @return Selected level index
+     */
+    std::uint32_t Apply(RenderObject& renderObject, const LodChain& chain) const;
+
+private:
+    Gs::Vector3f cameraPosition_;
+    float pixelsPerUnit_;     ///< Pixels covered by one world unit at distance 1
+    float pixelError_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,214 @@
+/**
+ * @file MeshFile.h
+ * @brief Versioned binary mesh container, loaded by memory mapping
+ * @details Layout: MeshFileHeader, MeshFileAttribute[attributeCount], then the vertex and
+ *          index blobs, each starting at a kMeshFileBlobAlignment boundary. The blobs are in
+ *          GPU layout, so a mapped file is passed to ResourceManager without being copied or
+ *          converted. All values are little-endian.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "ResourceManager.h"
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <Gauss/Vector3.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace RenderingPlugin {
+
+// Forward declarations
+struct MeshData;
+
+static constexpr std::uint32_t kMeshFileMagic = 0x464D5350;   ///< "PSMF"
+static constexpr std::uint32_t kMeshFileVersion = 1;
+static constexpr std::uint64_t kMeshFileBlobAlignment = 64;
+
+/**
+ * @brief Vertex attribute semantics stored in mesh files
+ */
+enum class MeshAttribute : std::uint32_t {
+    Position = 0,
+    Normal,
+    TexCoord,
+    Color,
+    Tangent
+};
+
+/**
+ * @brief Mesh file header
+ */
+struct MeshFileHeader {
+    std::uint32_t magic = kMeshFileMagic;
+    std::uint32_t version = kMeshFileVersion;
+    std::uint32_t attributeCount = 0;  ///< Number of MeshFileAttribute entries after the header
+    std::uint32_t vertexStride = 0;    ///< Bytes per vertex
+    std::uint32_t indexSize = 0;       ///< Bytes per index (2 or 4)
+    std::uint32_t reserved = 0;
+    std::uint64_t vertexCount = 0;
+    std::uint64_t indexCount = 0;
+    std::uint64_t vertexOffset = 0;    ///< File offset of the vertex blob
+    std::uint64_t indexOffset = 0;     ///< File offset of the index blob
+    float boundsMin[3] = { 0.0f, 0.0f, 0.0f };
+    float boundsMax[3] = { 0.0f, 0.0f, 0.0f };
+};
+
+/**
+ * @brief Vertex layout entry of a mesh file
+ */
+struct MeshFileAttribute {
+    MeshAttribute semantic = MeshAttribute::Position;
+    LLGL::Format format = LLGL::Format::Undefined;
+    std::uint32_t offset = 0;          ///< Byte offset within a vertex
+    std::uint32_t reserved = 0;
+};
+
+static_assert(sizeof(MeshFileHeader) == 80, "MeshFileHeader layout is part of the file format");
+static_assert(sizeof(MeshFileAttribute) == 16, "MeshFileAttribute layout is part of the file format");
+
+/**
+ * @brief Read-only memory-mapped mesh file
+ * @details The mapping stays valid until Close() or destruction; pointers returned by
+ *          GetVertexData()/GetIndexData() point into it.
+ */
+class RENDERING_PLUGIN_API MeshFile {
+public:
+    /**
+     * @brief Constructor
+     */
+    MeshFile();
+    
+    /**
+     * @brief Destructor; unmaps the file
+     */
+    ~MeshFile();
+    
+    MeshFile(const MeshFile&) = delete;
+    MeshFile& operator=(const MeshFile&) = delete;
+    
+    // === Writing ===
+    
+    /**
+     * @brief Write mesh data in the standard Vertex layout
+     * @details Indices are stored as 16-bit values when every vertex is addressable with them.
+     * @param filename Output file path
+     * @param meshData Mesh data to write
+     * @return true on success, false otherwise
+     */
+    static bool Write(const std::string& filename, const MeshData& meshData);
+    
+    /**
+     * @brief Write raw vertex and index blobs with a custom layout
+     * @param filename Output file path
+     * @param header Header with counts, stride, index size and bounds; offsets are filled in
+     * @param attributes Vertex layout, header.attributeCount entries
+     * @param vertexData Vertex blob, header.vertexCount * header.vertexStride bytes
+     * @param indexData Index blob, header.indexCount * header.indexSize bytes
+     * @return true on success, false otherwise
+     */
+    static bool Write(const std::string& filename, MeshFileHeader header, const MeshFileAttribute* attributes,
+                      const void* vertexData, const void* indexData);
+    
+    // === Loading ===
+    
+    /**
+     * @brief Map a mesh file and validate its header
+     * @param filename Mesh file path
+     * @return true on success, false if the file is missing, truncated or of another version
+     */
+    bool Open(const std::string& filename);
+    
+    /**
+     * @brief Unmap the file
+     */
+    void Close();
+    
+    /**
+     * @brief Check if a file is mapped
+     * @return true if open, false otherwise
+     */
+    bool IsOpen() const;
+    
+    /**
+     * @brief Create GPU buffers straight from the mapped blobs
+     * @param resourceManager Resource manager to create the buffers with
+     * @param vertexBufferId Output vertex buffer ID
+     * @param indexBufferId Output index buffer ID
+     * @return true on success, false otherwise
+     */
+    bool CreateBuffers(ResourceManager& resourceManager, ResourceId& vertexBufferId, ResourceId& indexBufferId) const;
+    
+    /**
+     * @brief Copy the mesh into MeshData, for CPU-side processing
+     * @param meshData Output mesh data
+     * @return true on success, false if the file does not use the standard Vertex layout
+     */
+    bool ToMeshData(MeshData& meshData) const;
+    
+    // === Access ===
+    
+    /**
+     * @brief Get the file header
+     * @return Header of the mapped file
+     */
+    const MeshFileHeader& GetHeader() const;
+    
+    /**
+     * @brief Get a vertex layout entry
+     * @param index Attribute index, less than GetHeader().attributeCount
+     * @return Attribute
+     */
+    const MeshFileAttribute& GetAttribute(std::uint32_t index) const;
+    
+    /**
+     * @brief Build the LLGL vertex format of the file's vertex layout
+     * @return Vertex format
+     */
+    LLGL::VertexFormat GetVertexFormat() const;
+    
+    /**
+     * @brief Get the index format
+     * @return LLGL::Format::R16UInt or LLGL::Format::R32UInt
+     */
+    LLGL::Format GetIndexFormat() const;
+    
+    /**
+     * @brief Get the mapped vertex blob
+     * @return Pointer into the mapping, or nullptr if not open
+     */
+    const void* GetVertexData() const;
+    
+    /**
+     * @brief Get the mapped index blob
+     * @return Pointer into the mapping, or nullptr if not open
+     */
+    const void* GetIndexData() const;
+    
+    /**
+     * @brief Get the mesh bounding box
+     * @param minBounds Output minimum bounds
+     * @param maxBounds Output maximum bounds
+     */
+    void GetBounds(Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds) const;
+
+private:
+    /**
+     * @brief Check the header and blob ranges of the mapping
+     */
+    bool Validate() const;
+    
+    const std::uint8_t* data_;
+    std::size_t size_;
+    const MeshFileHeader* header_;
+    const MeshFileAttribute* attributes_;
+
+#if defined(_WIN32)
+    void* fileHandle_;
+    void* mappingHandle_;
+#endif
+};
+
+} // namespace RenderingPlugin
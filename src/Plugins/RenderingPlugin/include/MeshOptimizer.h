@@ -0,0 +1,133 @@
+/**
+ * @file MeshOptimizer.h
+ * @brief Post-processing passes that reorder MeshData for faster rendering
+ * @details Run on generated or imported meshes before GeometryGenerator::CreateBuffersFromMesh.
+ *          The passes only reorder or merge data; every triangle keeps its vertices and winding.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "GeometryGenerator.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Post-transform vertex cache efficiency of an index buffer
+ */
+struct VertexCacheStats {
+    std::uint32_t verticesTransformed = 0;  ///< Cache misses in the simulated FIFO cache
+    float acmr = 0.0f;                      ///< Average cache miss ratio: transformed vertices per triangle (0.5 is ideal)
+    float atvr = 0.0f;                      ///< Average transformed vertex ratio: transformed per unique vertex (1.0 is ideal)
+};
+
+/**
+ * @brief Passes run by MeshOptimizer::Optimize
+ */
+struct RENDERING_PLUGIN_API MeshOptimizerSettings {
+    bool weldVertices = true;           ///< Merge vertices with identical attributes
+    float weldEpsilon = 0.0f;           ///< Attribute tolerance for welding, 0 for exact matches
+    bool optimizeVertexCache = true;    ///< Reorder triangles for post-transform cache reuse
+    std::uint32_t cacheSize = 32;       ///< Cache size assumed by the vertex cache and overdraw passes
+    bool optimizeOverdraw = true;       ///< Reorder triangle clusters to draw outward-facing ones first
+    float overdrawThreshold = 1.05f;    ///< Largest ACMR increase the overdraw pass may cause
+    bool optimizeVertexFetch = true;    ///< Reorder vertices by first use and drop unused ones
+};
+
+/**
+ * @brief Result of MeshOptimizer::Optimize
+ */
+struct MeshOptimizerStats {
+    VertexCacheStats before;            ///< Cache efficiency of the input
+    VertexCacheStats after;             ///< Cache efficiency of the output
+    std::size_t vertexCountBefore = 0;
+    std::size_t vertexCountAfter = 0;
+    double optimizeMs = 0.0;            ///< Time spent in all passes
+};
+
+/**
+ * @brief Mesh optimization passes
+ * @details All passes expect a triangle list; meshes whose index count is not a multiple of
+ *          three, or that reference missing vertices, are left unchanged.
+ */
+class RENDERING_PLUGIN_API MeshOptimizer {
+public:
+    /**
+     * @brief Run the enabled passes in order: weld, vertex cache, overdraw, vertex fetch
+     * @param meshData Mesh data to optimize in place
+     * @param settings Passes to run
+     * @return Cache efficiency and vertex counts before and after
+     */
+    static MeshOptimizerStats Optimize(MeshData& meshData, const MeshOptimizerSettings& settings = {});
+    
+    /**
+     * @brief Merge vertices whose attributes are equal
+     * @details With a tolerance, attributes are snapped to a grid of that spacing before
+     *          comparison, so vertices on either side of a grid line are kept apart.
+     * @param meshData Mesh data to weld in place
+     * @param epsilon Attribute tolerance, 0 for exact matches
+     * @return Number of vertices removed
+     */
+    static std::size_t WeldVertices(MeshData& meshData, float epsilon = 0.0f);
+    
+    /**
+     * @brief Reorder triangles to maximize post-transform vertex cache hits
+     * @details Forsyth's linear-speed algorithm with an LRU cache model.
+     * @param meshData Mesh data to reorder in place
+     * @param cacheSize Cache size the scores are tuned for
+     */
+    static void OptimizeVertexCache(MeshData& meshData, std::uint32_t cacheSize = 32);
+    
+    /**
+     * @brief Reorder clusters of triangles to reduce overdraw
+     * @details Splits the (cache optimized) index buffer into clusters at cache restarts and
+     *          sorts them so clusters facing away from the mesh center are drawn first; those
+     *          are the most likely to occlude the rest.
+     * @param meshData Mesh data to reorder in place
+     * @param threshold Largest allowed ACMR increase over the input order, e.g. 1.05
+     * @param cacheSize Simulated FIFO cache size
+     */
+    static void OptimizeOverdraw(MeshData& meshData, float threshold = 1.05f, std::uint32_t cacheSize = 16);
+    
+    /**
+     * @brief Reorder vertices in the order the index buffer first references them
+     * @details Makes vertex fetches sequential; unreferenced vertices are removed.
+     * @param meshData Mesh data to reorder in place
+     * @return Number of vertices removed
+     */
+    static std::size_t OptimizeVertexFetch(MeshData& meshData);
+    
+    /**
+     * @brief Reduce the triangle count by collapsing edges in order of quadric error
+     * @details Vertices are only collapsed onto neighbouring vertices, so the result indexes the
+     *          unchanged vertex array and several detail levels can share one vertex buffer.
+     *          Vertices on open borders and attribute seams (several vertices at one position)
+     *          are never moved, which keeps outlines and texture seams intact.
+     * @param meshData Mesh to simplify
+     * @param targetIndexCount Index count to reduce to
+     * @param maxError Largest allowed error, as a distance in mesh units
+     * @param resultError Optional output for the error of the returned indices, in mesh units
+     * @return Simplified index buffer, the input indices if the mesh is not a valid triangle list
+     */
+    static std::vector<std::uint32_t> Simplify(const MeshData& meshData, std::size_t targetIndexCount,
+                                               float maxError, float* resultError = nullptr);
+    
+    /**
+     * @brief Simulate a FIFO post-transform vertex cache over an index buffer
+     * @param meshData Mesh data to analyze
+     * @param cacheSize Simulated cache size
+     * @return Cache statistics
+     */
+    static VertexCacheStats AnalyzeVertexCache(const MeshData& meshData, std::uint32_t cacheSize = 16);
+
+private:
+    /**
+     * @brief Check that the mesh is a triangle list referencing existing vertices
+     */
+    static bool IsValidTriangleList(const MeshData& meshData);
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,151 @@
+/**
+ * @file ParallelCommandRecorder.h
+ * @brief Multi-threaded command recording into secondary command buffers
+ * @details Splits a range of draw work across worker threads. Each chunk is recorded into its
+ *          own secondary command buffer and the chunks are executed in chunk order, so the
+ *          submitted command stream does not depend on thread scheduling.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "ResourceManager.h"
+#include <LLGL/LLGL.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace RenderingPlugin {
+
+// Forward declarations
+class RenderCommands;
+class ThreadPool;
+
+/**
+ * @brief Statistics of the last parallel recording
+ */
+struct ParallelRecordStats {
+    std::size_t itemCount = 0;       ///< Items recorded
+    std::size_t chunkCount = 0;      ///< Chunks (secondary command buffers) used
+    double wallTimeMs = 0.0;         ///< Elapsed time of Record()
+    double totalChunkTimeMs = 0.0;   ///< Sum of per-chunk recording times
+    double maxChunkTimeMs = 0.0;     ///< Slowest chunk
+    bool usedSecondaryBuffers = false;  ///< false if recording fell back to the primary command buffer
+    std::size_t rerecordedChunks = 0;   ///< Chunks recorded again on the calling thread to create instance buffers
+};
+
+/**
+ * @brief Multi-threaded command recorder
+ * @details Record functions run concurrently on worker threads. ResourceManager is not
+ *          thread-safe, so a record function may:
+ *          - look up existing resources through the ResourceManager (GetPipelineState, ...)
+ *          - record through the RenderCommands it is given: binds, draws, batches, UpdateBuffer
+ *          It must not create, release or write resources through the ResourceManager or the
+ *          LLGL render system. Chunk RenderCommands record in worker mode (see
+ *          RenderCommands::SetWorkerRecording): the calling thread rewinds their instance
+ *          streams before recording and writes the staged instances afterwards. A chunk whose
+ *          batches outgrow its instance buffer is recorded again on the calling thread, so a
+ *          record function can be called twice for the same range in one frame.
+ *          Call Record and Execute once per frame; the secondary command buffers are reused by
+ *          the next Record.
+ */
+class RENDERING_PLUGIN_API ParallelCommandRecorder {
+public:
+    /**
+     * @brief Record function
+     * @details Called with the chunk's RenderCommands and the item range [begin, end) it has to record
+     */
+    using RecordFunction = std::function<void(RenderCommands&, std::size_t, std::size_t)>;
+    
+    /**
+     * @brief Constructor
+     * @param renderSystem LLGL render system used to create secondary command buffers
+     * @param resourceManager Resource manager shared by all chunks
+     * @param threadPool Thread pool that executes the chunks
+     * @param renderPass Render pass the secondary command buffers are executed in (optional)
+     * @param minItemsPerChunk Smallest range worth recording on a separate thread
+     */
+    ParallelCommandRecorder(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager,
+                            ThreadPool* threadPool, const LLGL::RenderPass* renderPass = nullptr,
+                            std::size_t minItemsPerChunk = 256);
+    
+    /**
+     * @brief Destructor
+     */
+    ~ParallelCommandRecorder();
+    
+    /**
+     * @brief Record a range of items in parallel
+     * @param itemCount Number of items to record
+     * @param record Function recording a sub-range of items
+     * @param frameIndex Frame-in-flight slot selecting the chunks' instance streams
+     * @return true if recording succeeded, false otherwise
+     */
+    bool Record(std::size_t itemCount, const RecordFunction& record, std::uint32_t frameIndex = 0);
+    
+    /**
+     * @brief Execute the recorded chunks in chunk order
+     * @details Must be called while the primary command buffer is recording, in the same
+     *          render pass the secondary command buffers were created for.
+     * @param primaryCommandBuffer Primary command buffer
+     */
+    void Execute(LLGL::CommandBuffer& primaryCommandBuffer);
+    
+    /**
+     * @brief Set the matrix constant buffer used by all chunk RenderCommands
+     * @param constantBufferId Resource ID of a constant buffer holding a Matrices struct
+     */
+    void SetMatrixBuffer(ResourceId constantBufferId);
+    
+    /**
+     * @brief Check if secondary command buffers are available
+     * @return true if chunks are recorded on worker threads, false if recording falls back to the primary buffer
+     */
+    bool SupportsParallelRecording() const;
+    
+    /**
+     * @brief Get statistics of the last recording
+     * @return Parallel recording statistics
+     */
+    const ParallelRecordStats& GetStatistics() const;
+
+private:
+    /**
+     * @brief Per-chunk recording context
+     */
+    struct ChunkContext {
+        LLGL::CommandBuffer* commandBuffer = nullptr;
+        std::unique_ptr<RenderCommands> commands;
+        double recordTimeMs = 0.0;
+    };
+    
+    /**
+     * @brief Create secondary command buffers for all chunks
+     * @param chunkCount Number of chunk contexts to create
+     * @return true if all command buffers were created, false otherwise
+     */
+    bool CreateChunkContexts(std::size_t chunkCount);
+    
+    LLGL::RenderSystem* renderSystem_;
+    ResourceManager* resourceManager_;
+    ThreadPool* threadPool_;
+    const LLGL::RenderPass* renderPass_;
+    std::size_t minItemsPerChunk_;
+    
+    std::vector<ChunkContext> chunks_;
+    std::size_t recordedChunks_;
+    bool secondaryBuffersSupported_;
+    
+    // Fallback when secondary command buffers are unavailable: record on Execute()
+    RecordFunction deferredRecord_;
+    std::size_t deferredItemCount_;
+    std::uint32_t deferredFrameIndex_;
+    std::unique_ptr<RenderCommands> primaryCommands_;
+    ResourceId matrixBufferId_;
+    
+    ParallelRecordStats stats_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,150 @@
+/**
+ * @file QuantizedMesh.h
+ * @brief Compact 20-byte vertex layout and conversion from MeshData
+ * @details Positions are 16-bit unorm relative to the mesh bounds, normals are octahedral
+ *          encoded into two snorm16 values, texture coordinates are half floats and colors are
+ *          unorm8. The built-in "quantized_vertex" and "quantized_instanced_vertex" shaders of
+ *          ShaderManager decode this layout; they read the mesh's position offset and scale from
+ *          the "QuantizedDecode" constant block (QuantizedDecodeParams), which is bound per mesh in
+ *          its resource heap next to the material resources, see VertexQuantizer::CreateDecodeBuffer.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "GeometryGenerator.h"
+#include "ResourceManager.h"
+#include <LLGL/Utils/VertexFormat.h>
+#include <Gauss/Vector3.h>
+#include <Gauss/Vector4.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Quantized vertex, 20 bytes instead of the 44 of Vertex
+ */
+struct QuantizedVertex {
+    std::uint16_t position[4];   ///< RGBA16UNorm: xyz in [0, 1] over the mesh bounds, w unused
+    std::int16_t normal[2];      ///< RG16SNorm: octahedral encoded unit normal
+    std::uint16_t texCoord[2];   ///< RG16Float: half-float texture coordinates
+    std::uint8_t color[4];       ///< RGBA8UNorm: color, alpha is always 255
+};
+
+static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex must match GetVertexFormat()");
+
+/**
+ * @brief Quantized mesh with the transform that decodes its positions
+ */
+struct RENDERING_PLUGIN_API QuantizedMeshData {
+    std::vector<QuantizedVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    Gs::Vector3f positionOffset;  ///< Minimum of the mesh bounds
+    Gs::Vector3f positionScale;   ///< Extent of the mesh bounds; position = offset + scale * unorm
+    
+    /**
+     * @brief Check if mesh data is empty
+     * @return true if empty, false otherwise
+     */
+    bool IsEmpty() const { return vertices.empty() || indices.empty(); }
+};
+
+/**
+ * @brief Contents of the "QuantizedDecode" constant block of the quantized vertex shaders
+ * @details std140 layout; the w components are unused.
+ */
+struct QuantizedDecodeParams {
+    Gs::Vector4f positionOffset;  ///< xyz: QuantizedMeshData::positionOffset
+    Gs::Vector4f positionScale;   ///< xyz: QuantizedMeshData::positionScale
+};
+
+static_assert(sizeof(QuantizedDecodeParams) == 32, "QuantizedDecodeParams must match the std140 block");
+
+/**
+ * @brief Converts meshes between the standard and the quantized vertex layout
+ */
+class RENDERING_PLUGIN_API VertexQuantizer {
+public:
+    /**
+     * @brief Quantize a mesh
+     * @param meshData Mesh data in the standard Vertex layout
+     * @return Quantized mesh; indices are copied unchanged
+     */
+    static QuantizedMeshData Quantize(const MeshData& meshData);
+    
+    /**
+     * @brief Decode a quantized mesh, e.g. for CPU-side processing or accuracy checks
+     * @param quantizedMesh Quantized mesh
+     * @return Mesh data with the decoded attributes
+     */
+    static MeshData Dequantize(const QuantizedMeshData& quantizedMesh);
+    
+    /**
+     * @brief Get the LLGL vertex format of QuantizedVertex
+     * @return Vertex format with position, normal, texCoord and color attributes
+     */
+    static LLGL::VertexFormat GetVertexFormat();
+    
+    /**
+     * @brief Create GPU buffers for a quantized mesh
+     * @param quantizedMesh Quantized mesh
+     * @param resourceManager Resource manager to create the buffers with
+     * @param vertexBufferId Output vertex buffer ID
+     * @param indexBufferId Output index buffer ID
+     * @return true on success, false otherwise
+     */
+    static bool CreateBuffers(const QuantizedMeshData& quantizedMesh, ResourceManager& resourceManager,
+                              ResourceId& vertexBufferId, ResourceId& indexBufferId);
+    
+    /**
+     * @brief Get the decode block contents of a quantized mesh
+     * @param quantizedMesh Quantized mesh
+     * @return Position offset and scale padded to the std140 layout
+     */
+    static QuantizedDecodeParams GetDecodeParams(const QuantizedMeshData& quantizedMesh);
+    
+    /**
+     * @brief Create the constant buffer of the "QuantizedDecode" block for a quantized mesh
+     * @details Put it in the resource heap the mesh is drawn with; its binding must not overlap
+     *          the matrix block binding of RenderCommands::SetUploadAllocator.
+     * @param quantizedMesh Quantized mesh
+     * @param resourceManager Resource manager to create the buffer with
+     * @return Resource ID of the constant buffer, or 0 on failure
+     */
+    static ResourceId CreateDecodeBuffer(const QuantizedMeshData& quantizedMesh, ResourceManager& resourceManager);
+    
+    // === Encoding Helpers ===
+    
+    /**
+     * @brief Octahedral encode a unit normal
+     * @details Picks the snorm16 rounding of the two components that decodes closest to the input.
+     * @param normal Normal to encode; it does not need to be normalized
+     * @param encoded Output snorm16 pair
+     */
+    static void EncodeOctahedral(const Gs::Vector3f& normal, std::int16_t encoded[2]);
+    
+    /**
+     * @brief Decode an octahedral encoded normal
+     * @param encoded snorm16 pair
+     * @return Unit normal
+     */
+    static Gs::Vector3f DecodeOctahedral(const std::int16_t encoded[2]);
+    
+    /**
+     * @brief Convert a float to IEEE half precision, rounding to nearest even
+     * @param value Value to convert; values beyond the half range become infinity
+     * @return Half-float bits
+     */
+    static std::uint16_t FloatToHalf(float value);
+    
+    /**
+     * @brief Convert IEEE half precision bits to a float
+     * @param half Half-float bits
+     * @return Float value
+     */
+    static float HalfToFloat(std::uint16_t half);
+};
+
+} // namespace RenderingPlugin
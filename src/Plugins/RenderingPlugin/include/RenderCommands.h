@@ -7,22 +7,40 @@
 #pragma once
 
 #include "RenderingPluginExport.h"
+#include "DrawBindState.h"
 #include <memory>
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <unordered_map>
 
 // Include LLGL headers
 #include <LLGL/LLGL.h>
 #include "RenderingPluginBase.h"
+#include "ResourceManager.h"
 #include <Gauss/Matrix.h>
 
 namespace RenderingPlugin {
 
 // Forward declarations
-class ResourceManager;
-struct RenderObject;
-struct Matrices;
+class UploadAllocator;
+
+/**
+ * @brief Per-frame command statistics collected by RenderCommands
+ */
+struct RenderCommandStats {
+    std::uint32_t drawCalls = 0;          ///< Draw commands issued
+    std::uint32_t pipelineBinds = 0;      ///< Pipeline state changes
+    std::uint32_t resourceHeapBinds = 0;  ///< Resource heap changes
+    std::uint32_t vertexBufferBinds = 0;  ///< Vertex buffer (array) changes
+    std::uint32_t batchedObjects = 0;     ///< Objects submitted through batches
+    std::uint32_t batchGroups = 0;        ///< Instanced draws emitted by batches
+    std::uint32_t bufferUpdates = 0;      ///< Buffer updates recorded into the command buffer
+    std::uint32_t uploadAllocations = 0;  ///< Per-draw blocks sub-allocated from the upload allocator
+    std::uint32_t indirectDraws = 0;      ///< Draws read from indirect argument buffers
+    std::uint32_t dispatches = 0;         ///< Compute dispatches
+    double batchCpuTimeMs = 0.0;          ///< CPU time spent in EndBatch
+};
 
 /**
  * @brief Rendering commands interface class
@@ -42,6 +60,72 @@ public:
      */
     ~RenderCommands();
     
+    // === Frame Management ===
+    
+    /**
+     * @brief Reset per-frame state
+     * @details Selects the instance stream of the given frame slot, rewinds it and releases
+     *          instance buffers that slot retired by growth. Each frame in flight needs its own
+     *          slot so matrices are never written into a buffer the GPU is still reading.
+     *          Call once per frame before recording.
+     * @param frameIndex Frame-in-flight slot (see RenderingSystem::GetFrameIndex)
+     */
+    void BeginFrame(std::uint32_t frameIndex = 0);
+    
+    /**
+     * @brief Record into a different command buffer
+     * @details Used with frames in flight, where each frame slot records into its own
+     *          command buffer. Resets bound-state tracking.
+     * @param commandBuffer Command buffer to record into
+     */
+    void SetCommandBuffer(LLGL::CommandBuffer* commandBuffer);
+    
+    /**
+     * @brief Set the constant buffer that receives per-draw matrices
+     * @param constantBufferId Resource ID of a constant buffer holding a Matrices struct
+     */
+    void SetMatrixBuffer(ResourceId constantBufferId);
+    
+    /**
+     * @brief Stream per-draw matrices through an upload allocator instead of the matrix buffer
+     * @details Each draw sub-allocates its Matrices block and binds it by offset through the
+     *          allocator's block heap for matrixLayout. The block is bound after the pipeline
+     *          and the object's resource heap (see DrawBindState), so matrixLayout's binding
+     *          must not overlap the material bindings. That only keeps the material heap bound
+     *          on backends with slot-based bindings (see UploadAllocator::SupportsBlockBinding);
+     *          elsewhere the allocator is rejected and the matrix buffer stays in use. The caller
+     *          calls allocator->BeginFrame() and Flush() around recording.
+     * @param allocator Upload allocator, or nullptr to go back to the matrix buffer
+     * @param matrixLayout Pipeline layout with a single Matrices constant buffer heap binding
+     * @return false if the allocator was rejected
+     */
+    bool SetUploadAllocator(UploadAllocator* allocator, LLGL::PipelineLayout* matrixLayout);
+    
+    /**
+     * @brief Record on a worker thread without modifying the resource manager
+     * @details ResourceManager is not thread-safe, so while enabled batches never create,
+     *          release or write resources: instance matrices are staged until
+     *          FlushStagedInstances() and a batch that needs a larger instance buffer or a new
+     *          buffer array is skipped and reported by NeedsResourceCreation(). The owning
+     *          thread then flushes, or re-records the frame with worker recording disabled.
+     *          BeginFrame() releases retired buffers and must be called on the owning thread.
+     * @param enabled Enable worker recording (default: disabled)
+     */
+    void SetWorkerRecording(bool enabled);
+    
+    /**
+     * @brief Check if a batch was skipped because worker recording could not create resources
+     * @return true if the frame has to be re-recorded with worker recording disabled
+     */
+    bool NeedsResourceCreation() const;
+    
+    /**
+     * @brief Write the instance matrices staged by worker recording
+     * @details Call on the owning thread after recording, before the commands are submitted.
+     * @return false if the write failed
+     */
+    bool FlushStagedInstances();
+    
     // === Basic Rendering Commands ===
     
     /**
@@ -107,6 +191,12 @@ public:
      */
     void BindIndexBuffer(LLGL::Buffer* indexBuffer, LLGL::Format format = LLGL::Format::R32UInt);
     
+    /**
+     * @brief Bind several vertex streams at once
+     * @param bufferArray Buffer array, e.g. a mesh vertex buffer and an instance buffer
+     */
+    void BindVertexBufferArray(LLGL::BufferArray* bufferArray);
+    
     // === Drawing Commands ===
     
     /**
@@ -146,6 +236,39 @@ public:
                              std::uint32_t firstIndex = 0, std::int32_t vertexOffset = 0,
                              std::uint32_t firstInstance = 0);
     
+    /**
+     * @brief Draw primitives with arguments read from a buffer
+     * @param argumentsBuffer Buffer of LLGL::DrawIndirectArguments records
+     * @param offset Byte offset of the first record
+     * @param drawCount Number of records to draw (default: 1)
+     * @param stride Byte distance between records (default: tightly packed)
+     */
+    void DrawIndirect(LLGL::Buffer* argumentsBuffer, std::uint64_t offset, std::uint32_t drawCount = 1,
+                      std::uint32_t stride = sizeof(LLGL::DrawIndirectArguments));
+    
+    /**
+     * @brief Draw indexed primitives with arguments read from a buffer
+     * @details The arguments can be written by the GPU, e.g. by a culling compute pass, so the
+     *          CPU never learns how many instances are drawn.
+     * @param argumentsBuffer Buffer of LLGL::DrawIndexedIndirectArguments records
+     * @param offset Byte offset of the first record
+     * @param drawCount Number of records to draw (default: 1)
+     * @param stride Byte distance between records (default: tightly packed)
+     */
+    void DrawIndexedIndirect(LLGL::Buffer* argumentsBuffer, std::uint64_t offset, std::uint32_t drawCount = 1,
+                             std::uint32_t stride = sizeof(LLGL::DrawIndexedIndirectArguments));
+    
+    // === Compute Commands ===
+    
+    /**
+     * @brief Dispatch the bound compute pipeline
+     * @details Must be recorded outside of a render pass.
+     * @param groupsX Work groups in X
+     * @param groupsY Work groups in Y (default: 1)
+     * @param groupsZ Work groups in Z (default: 1)
+     */
+    void Dispatch(std::uint32_t groupsX, std::uint32_t groupsY = 1, std::uint32_t groupsZ = 1);
+    
     // === High-Level Rendering Commands ===
     
     /**
@@ -169,6 +292,8 @@ public:
     
     /**
      * @brief Render multiple objects with the same pipeline state
+     * @details Objects are drawn instanced; consecutive entries with the same view and projection
+     *          share one batch, so sort the entries by camera to keep the batches large.
      * @param renderObjects Array of render objects
      * @param objectCount Number of objects
      * @param matrices Array of transformation matrices (one per object)
@@ -248,11 +373,31 @@ public:
      */
     ResourceManager* GetResourceManager() const;
     
+    /**
+     * @brief Get command statistics accumulated since the last reset
+     * @return Command statistics
+     */
+    const RenderCommandStats& GetStatistics() const;
+    
+    /**
+     * @brief Reset command statistics
+     */
+    void ResetStatistics();
+    
     // === Batch Rendering Support ===
     
+    /**
+     * @brief Get the per-instance vertex format used by batched draws
+     * @details The world matrix is streamed from slot 1 as four RGBA32Float columns
+     *          at locations 4-7 with an instance divisor of 1. Pipelines used with
+     *          batches must append these attributes to their vertex input.
+     * @return Instance vertex format
+     */
+    static const LLGL::VertexFormat& GetInstanceVertexFormat();
+    
     /**
      * @brief Begin a batch rendering session
-     * @param pipelineState Pipeline state to use for the batch
+     * @param pipelineState Pipeline state used for objects without their own pipeline state
      */
     void BeginBatch(LLGL::PipelineState* pipelineState);
     
@@ -263,12 +408,31 @@ public:
      */
     void AddToBatch(const struct RenderObject& renderObject, const Gs::Matrix4f& worldMatrix);
     
+    /**
+     * @brief Add a mesh to the current batch
+     * @param draw Mesh resources to draw
+     * @param worldMatrix World transformation matrix
+     */
+    void AddToBatch(const MeshDraw& draw, const Gs::Matrix4f& worldMatrix);
+    
     /**
      * @brief End the current batch and render all batched objects
+     * @details Objects are grouped by pipeline state, resource heap, vertex and index buffer.
+     *          World matrices are packed into the per-frame instance buffer and each group
+     *          is drawn with a single DrawIndexedInstanced call.
      * @param viewMatrix View transformation matrix
      * @param projectionMatrix Projection transformation matrix
      */
     void EndBatch(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix);
+    
+    /**
+     * @brief Set the camera matrices of instanced draws recorded outside of a batch
+     * @details Uses the matrix buffer or upload allocator like EndBatch, e.g. before indirect
+     *          draws whose world matrices are streamed from an instance buffer.
+     * @param viewMatrix View transformation matrix
+     * @param projectionMatrix Projection transformation matrix
+     */
+    void SetCameraMatrices(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix);
 
 private:
     // === Private Methods ===
@@ -281,22 +445,103 @@ private:
     
     /**
      * @brief Setup matrices for rendering
+     * @details With an upload allocator the block is queued and bound by the next draw.
      * @param matrices Matrix data to setup
      */
     void SetupMatrices(const Matrices& matrices);
     
+    /**
+     * @brief Bind the queued matrix block if a pipeline or heap bind dropped it
+     */
+    void BindMatrixBlock();
+    
+    /**
+     * @brief Bind resources and draw a single object
+     */
+    void DrawSingle(LLGL::PipelineState* pipelineState, LLGL::ResourceHeap* resourceHeap,
+                    LLGL::Buffer* vertexBuffer, LLGL::Buffer* indexBuffer,
+                    std::uint32_t indexCount, std::uint32_t firstIndex, const Matrices& matrices);
+    
+    /**
+     * @brief Make sure the instance buffer can hold additional instances this frame
+     * @param instanceCount Number of instances to append
+     * @return true if enough space is available, false otherwise
+     */
+    bool EnsureInstanceCapacity(std::uint32_t instanceCount);
+    
+    /**
+     * @brief Get a buffer array combining a mesh vertex buffer and the instance buffer
+     * @param vertexBufferId Resource ID of mesh vertex buffer
+     * @return Buffer array, or nullptr on failure
+     */
+    LLGL::BufferArray* GetInstancedBufferArray(ResourceId vertexBufferId);
+    
+    /**
+     * @brief Queued batch entry
+     */
+    struct BatchItem {
+        LLGL::PipelineState* pipelineState;
+        LLGL::ResourceHeap* resourceHeap;
+        ResourceId vertexBufferId;
+        LLGL::Buffer* indexBuffer;
+        std::uint32_t indexCount;
+        std::uint32_t firstIndex;
+        Gs::Matrix4f worldMatrix;
+    };
+    
     // === Private Members ===
     
     LLGL::CommandBuffer* commandBuffer_;     ///< Pointer to LLGL command buffer
     ResourceManager* resourceManager_;       ///< Pointer to resource manager
     
     // State tracking
-    LLGL::PipelineState* currentPipelineState_;
-    LLGL::ResourceHeap* currentResourceHeap_;
+    DrawBindState bindState_;
+    
+    LLGL::Buffer* currentIndexBuffer_;
+    ResourceId currentVertexBufferId_;
     
     // Debug and utility state
     int debugGroupDepth_;
     bool batchingEnabled_;
+    
+    // Batch state
+    LLGL::PipelineState* batchPipelineState_;
+    std::vector<BatchItem> batchItems_;
+    std::vector<std::uint32_t> batchOrder_;
+    std::vector<Gs::Matrix4f> instanceData_;
+    
+    /**
+     * @brief Instance buffer of one frame-in-flight slot
+     */
+    struct InstanceStream {
+        ResourceId bufferId = 0;
+        std::uint32_t capacity = 0;
+        std::uint32_t cursor = 0;
+        std::unordered_map<ResourceId, ResourceId> bufferArrays;  ///< Mesh VB -> {mesh VB, instance buffer}
+        std::vector<ResourceId> retiredBuffers;
+        std::vector<ResourceId> retiredBufferArrays;
+    };
+    
+    /**
+     * @brief Release a stream's buffer arrays and buffers, including retired ones
+     * @param stream Instance stream to release
+     */
+    void ReleaseInstanceStream(InstanceStream& stream);
+    
+    // Per-frame instance streams, one per frame in flight
+    ResourceId matrixBufferId_;
+    UploadAllocator* uploadAllocator_;
+    LLGL::PipelineLayout* matrixLayout_;
+    std::vector<InstanceStream> instanceStreams_;
+    std::uint32_t streamIndex_;
+    
+    // Worker recording: instance matrices written by FlushStagedInstances
+    bool workerRecording_;
+    bool needsResourceCreation_;
+    std::uint32_t stagedBaseInstance_;
+    std::vector<Gs::Matrix4f> stagedInstances_;
+    
+    RenderCommandStats stats_;
 };
 
 } // namespace RenderingPlugin
\ No newline at end of file
@@ -0,0 +1,457 @@
+/**
+ * @file RenderGraph.h
+ * @brief Frame graph of render passes with pass culling and transient texture aliasing
+ * @details Passes declare the textures they read and write instead of binding render targets
+ *          themselves. Compiling the graph culls passes whose results are never used, orders the
+ *          resource transitions between passes, and lets transient textures with disjoint
+ *          lifetimes share one GPU texture, so multi-pass effects such as shadow maps, G-buffers
+ *          and post-processing chains only pay for the textures alive at the same time.
+ */
+
+#pragma once
+
+#include "FrameRing.h"
+#include "RenderingPluginExport.h"
+#include "RenderingSystem.h"
+#include <LLGL/LLGL.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace RenderingPlugin {
+
+class RenderCommands;
+class RenderGraph;
+
+/**
+ * @brief Handle of a texture in a render graph, 0 is invalid
+ */
+using RenderGraphResource = std::uint32_t;
+
+/**
+ * @brief Description of a transient render graph texture
+ */
+struct RenderGraphTextureDesc {
+    std::uint32_t width = 0;                          ///< Width in pixels
+    std::uint32_t height = 0;                         ///< Height in pixels
+    LLGL::Format format = LLGL::Format::RGBA8UNorm;   ///< Color or depth format
+};
+
+/**
+ * @brief How a pass accesses a texture
+ */
+enum class RenderGraphUsage {
+    Undefined,         ///< Not accessed yet in this frame
+    ColorAttachment,   ///< Rendered to as a color attachment
+    DepthAttachment,   ///< Rendered to as the depth attachment
+    Sampled,           ///< Read in shaders
+    Storage            ///< Read and written as a storage texture
+};
+
+/**
+ * @brief Transition of a texture before a pass
+ */
+struct RenderGraphBarrier {
+    RenderGraphResource resource = 0;
+    RenderGraphUsage before = RenderGraphUsage::Undefined;   ///< Usage by the previous pass, or by the texture sharing its memory
+    RenderGraphUsage after = RenderGraphUsage::Undefined;    ///< Usage by this pass
+};
+
+/**
+ * @brief Render graph statistics of the last compiled frame
+ */
+struct RenderGraphStats {
+    std::uint32_t passesDeclared = 0;       ///< Passes added this frame
+    std::uint32_t passesExecuted = 0;       ///< Passes left after culling
+    std::uint32_t transientTextures = 0;    ///< Transient textures used by executed passes
+    std::uint32_t physicalTextures = 0;     ///< GPU textures backing them after aliasing
+    std::uint32_t texturesCreated = 0;      ///< GPU textures created this frame
+    std::uint32_t texturesReleased = 0;     ///< Pooled GPU textures released after going unused
+    std::uint32_t barriers = 0;             ///< Resource transitions between passes
+    std::uint64_t transientMemoryBytes = 0; ///< Memory of the GPU textures used this frame
+    std::uint64_t unaliasedMemoryBytes = 0; ///< Memory if every transient texture had its own GPU texture
+    std::uint64_t pooledMemoryBytes = 0;    ///< Memory of all GPU textures held by the graph
+};
+
+/**
+ * @brief Declares the textures a pass accesses, passed to the setup function of AddPass
+ */
+class RENDERING_PLUGIN_API RenderGraphBuilder {
+public:
+    /**
+     * @brief Sample a texture written by an earlier pass
+     * @param resource Texture
+     */
+    void Read(RenderGraphResource resource);
+    
+    /**
+     * @brief Read and write a texture as a storage texture
+     * @param resource Texture
+     */
+    void ReadWrite(RenderGraphResource resource);
+    
+    /**
+     * @brief Render to a texture, keeping its contents
+     * @details Attachments are bound in the order they are declared.
+     * @param resource Color texture or imported render target
+     */
+    void WriteColor(RenderGraphResource resource);
+    
+    /**
+     * @brief Render to a texture after clearing it
+     * @param resource Color texture or imported render target
+     * @param clearColor Clear color
+     */
+    void WriteColor(RenderGraphResource resource, const Color& clearColor);
+    
+    /**
+     * @brief Use a texture as the depth attachment
+     * @param resource Depth texture
+     * @param clear true to clear it to 1.0 first
+     */
+    void WriteDepth(RenderGraphResource resource, bool clear = true);
+    
+    /**
+     * @brief Never cull the pass, e.g. for readbacks or GPU timers
+     */
+    void SetSideEffect();
+
+private:
+    friend class RenderGraph;
+    
+    RenderGraphBuilder(RenderGraph& graph, std::uint32_t pass);
+    
+    RenderGraph& graph_;
+    std::uint32_t pass_;
+};
+
+/**
+ * @brief Command recording state handed to the execute function of a pass
+ */
+class RENDERING_PLUGIN_API RenderGraphContext {
+public:
+    /**
+     * @brief Get the render commands recording the frame
+     * @return Render commands, bound to the pass's render target
+     */
+    RenderCommands& GetCommands() const;
+    
+    /**
+     * @brief Get the command buffer recording the frame
+     * @return Command buffer
+     */
+    LLGL::CommandBuffer& GetCommandBuffer() const;
+    
+    /**
+     * @brief Get the GPU texture of a resource, e.g. to bind a texture written by an earlier pass
+     * @param resource Texture
+     * @return Texture, or null for imported render targets
+     */
+    LLGL::Texture* GetTexture(RenderGraphResource resource) const;
+    
+    /**
+     * @brief Get the width of the pass's attachments
+     * @return Width in pixels, 0 for passes without attachments
+     */
+    std::uint32_t GetWidth() const;
+    
+    /**
+     * @brief Get the height of the pass's attachments
+     * @return Height in pixels, 0 for passes without attachments
+     */
+    std::uint32_t GetHeight() const;
+
+private:
+    friend class RenderGraph;
+    
+    RenderGraphContext(const RenderGraph& graph, RenderCommands& commands, std::uint32_t width, std::uint32_t height);
+    
+    const RenderGraph& graph_;
+    RenderCommands& commands_;
+    std::uint32_t width_;
+    std::uint32_t height_;
+};
+
+/**
+ * @brief Setup function of a pass, declares its resource accesses
+ */
+using RenderGraphSetup = std::function<void(RenderGraphBuilder&)>;
+
+/**
+ * @brief Execute function of a pass, records its commands
+ */
+using RenderGraphExecute = std::function<void(RenderGraphContext&)>;
+
+/**
+ * @brief Frame graph executed on the RenderCommands layer
+ * @details Usage per frame: Reset(), create or import textures, add passes in execution order,
+ *          then Execute() between Begin and End of the frame's command buffer. Passes are kept
+ *          if they write an imported resource or have side effects, or if a kept pass reads what
+ *          they write; a cleared write hides all earlier writes. Transient textures are allocated
+ *          from a pool that persists across frames: two textures of the same size and format
+ *          share a GPU texture when no executed pass lies within both lifetimes, and pooled
+ *          textures are released after several frames without use, through the release
+ *          scheduler if one is set. Barriers between storage writes and later accesses are
+ *          issued explicitly; attachment and sampling transitions are done by the LLGL backend
+ *          at render pass boundaries.
+ */
+class RENDERING_PLUGIN_API RenderGraph {
+public:
+    /**
+     * @brief Constructor
+     * @param renderSystem LLGL render system creating the transient textures, may be null to
+     *                     only compile graphs
+     */
+    explicit RenderGraph(LLGL::RenderSystem* renderSystem);
+    
+    /**
+     * @brief Destructor, releases all pooled textures
+     */
+    ~RenderGraph();
+    
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+    
+    // === Graph Building ===
+    
+    /**
+     * @brief Remove the passes and resources of the previous frame, keeping the texture pool
+     */
+    void Reset();
+    
+    /**
+     * @brief Declare a transient texture, valid for the current frame
+     * @param name Debug name
+     * @param desc Size and format
+     * @return Resource handle
+     */
+    RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+    
+    /**
+     * @brief Import a texture owned by the caller, e.g. a history buffer
+     * @details Passes writing imported resources are never culled. Render targets created for
+     *          imported attachments are cached by texture; call ReleaseTextures before
+     *          destroying such a texture.
+     * @param name Debug name
+     * @param texture Texture, must stay valid until the frame was executed
+     * @return Resource handle, 0 if texture is null
+     */
+    RenderGraphResource ImportTexture(const std::string& name, LLGL::Texture* texture);
+    
+    /**
+     * @brief Import a render target owned by the caller, e.g. the swap chain
+     * @details A pass writing it may not use other attachments.
+     * @param name Debug name
+     * @param renderTarget Render target, must stay valid until the frame was executed
+     * @return Resource handle, 0 if renderTarget is null
+     */
+    RenderGraphResource ImportRenderTarget(const std::string& name, LLGL::RenderTarget* renderTarget);
+    
+    /**
+     * @brief Add a pass
+     * @param name Debug name, also used as debug group when recording
+     * @param setup Called immediately to declare the pass's resource accesses
+     * @param execute Called by Execute if the pass is not culled
+     * @return Pass index in execution order
+     */
+    std::uint32_t AddPass(const std::string& name, const RenderGraphSetup& setup, RenderGraphExecute execute);
+    
+    // === Compilation and Execution ===
+    
+    /**
+     * @brief Cull passes, compute transitions and assign transient textures to pooled ones
+     * @details Called by Execute if the graph changed since the last compilation. Does not
+     *          create GPU textures.
+     * @return false if a pass has inconsistent attachments
+     */
+    bool Compile();
+    
+    /**
+     * @brief Record all passes that were not culled
+     * @details The command buffer of commands must be recording and outside a render pass.
+     *          Creates the missing GPU textures and render targets.
+     * @param commands Render commands recording the frame
+     * @return false if compilation or texture creation failed
+     */
+    bool Execute(RenderCommands& commands);
+    
+    /**
+     * @brief Check if a pass was culled by the last compilation
+     * @param pass Pass index returned by AddPass
+     * @return true if the pass is not executed
+     */
+    bool IsPassCulled(std::uint32_t pass) const;
+    
+    /**
+     * @brief Get the transitions issued before a pass by the last compilation
+     * @param pass Pass index returned by AddPass
+     * @return Barriers, empty for culled passes
+     */
+    const std::vector<RenderGraphBarrier>& GetBarriers(std::uint32_t pass) const;
+    
+    /**
+     * @brief Check if two transient textures share a GPU texture in the last compilation
+     * @param first First texture
+     * @param second Second texture
+     * @return true if both are backed by the same pooled texture
+     */
+    bool AreAliased(RenderGraphResource first, RenderGraphResource second) const;
+    
+    /**
+     * @brief Get the GPU texture of a resource after execution started
+     * @param resource Texture
+     * @return Texture, or null for imported render targets and culled textures
+     */
+    LLGL::Texture* GetTexture(RenderGraphResource resource) const;
+    
+    /**
+     * @brief Release all pooled textures and cached render targets
+     * @details Without a release scheduler the GPU must have finished all frames using them,
+     *          e.g. after waiting for the command queue on resize.
+     */
+    void ReleaseTextures();
+    
+    /**
+     * @brief Set how pooled textures and render targets are released
+     * @details Bind to RenderingSystem::DeferRelease so textures of frames still in flight
+     *          outlive those frames. Without a scheduler they are released immediately, so the
+     *          graph must not be reset more often than frames complete.
+     * @param scheduler Release scheduler, or nullptr
+     */
+    void SetReleaseScheduler(ReleaseScheduler scheduler);
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get statistics of the last compiled frame
+     * @return Pass, barrier and memory statistics
+     */
+    const RenderGraphStats& GetStatistics() const;
+    
+    /**
+     * @brief Get the memory a texture occupies
+     * @param desc Size and format
+     * @return Bytes, without driver padding
+     */
+    static std::uint64_t GetTextureMemory(const RenderGraphTextureDesc& desc);
+
+private:
+    friend class RenderGraphBuilder;
+    
+    /**
+     * @brief Texture declared in the current frame
+     */
+    struct ResourceNode {
+        std::string name;
+        RenderGraphTextureDesc desc;
+        LLGL::Texture* importedTexture = nullptr;
+        LLGL::RenderTarget* importedTarget = nullptr;
+        long bindFlags = 0;              ///< Usage by all passes, for transient textures
+        std::uint32_t firstPass = 0;     ///< Lifetime over executed passes
+        std::uint32_t lastPass = 0;
+        std::size_t physical = kNone;    ///< Index into physicalTextures_ of transient textures
+        
+        bool IsImported() const { return importedTexture || importedTarget; }
+    };
+    
+    /**
+     * @brief Attachment written by a pass
+     */
+    struct Attachment {
+        RenderGraphResource resource = 0;
+        bool clear = false;
+        float clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    };
+    
+    /**
+     * @brief Pass declared in the current frame
+     */
+    struct PassNode {
+        std::string name;
+        RenderGraphExecute execute;
+        std::vector<RenderGraphResource> reads;
+        std::vector<RenderGraphResource> storage;
+        std::vector<Attachment> colorAttachments;
+        Attachment depthAttachment;
+        bool sideEffect = false;
+        bool culled = false;
+        std::vector<RenderGraphBarrier> barriers;
+    };
+    
+    /**
+     * @brief Pooled GPU texture shared by transient textures of one size and format
+     */
+    struct PhysicalTexture {
+        RenderGraphTextureDesc desc;
+        long bindFlags = 0;
+        LLGL::Texture* texture = nullptr;
+        std::uint64_t lastFrame = 0;           ///< Last frame the texture was assigned in
+        std::uint32_t lastPass = 0;            ///< Last pass using it in the current frame
+        bool assigned = false;                 ///< Used in the current frame
+        RenderGraphUsage usage = RenderGraphUsage::Undefined;
+    };
+    
+    /**
+     * @brief Render target created for a set of attachments
+     */
+    struct CachedRenderTarget {
+        std::vector<LLGL::Texture*> attachments;   ///< Color attachments, then depth or null
+        LLGL::RenderTarget* renderTarget = nullptr;
+        std::uint64_t lastFrame = 0;
+    };
+    
+    static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+    
+    /**
+     * @brief Get a resource node, or null for invalid handles
+     */
+    ResourceNode* FindResource(RenderGraphResource resource);
+    const ResourceNode* FindResource(RenderGraphResource resource) const;
+    
+    /**
+     * @brief Mark passes not contributing to an imported resource or side effect as culled
+     */
+    void CullPasses();
+    
+    /**
+     * @brief Assign executed transient textures to pooled textures by lifetime
+     */
+    void AssignPhysicalTextures();
+    
+    /**
+     * @brief Record the transitions before each executed pass
+     */
+    void ComputeBarriers();
+    
+    /**
+     * @brief Release pooled textures and render targets unused for several frames
+     */
+    void ReleaseUnusedTextures();
+    
+    /**
+     * @brief Release render targets and textures now or through the release scheduler
+     */
+    void ReleaseObjects(std::vector<LLGL::RenderTarget*> renderTargets, std::vector<LLGL::Texture*> textures);
+    
+    /**
+     * @brief Get or create the render target of a pass's attachments
+     * @return Render target, or null on failure
+     */
+    LLGL::RenderTarget* AcquireRenderTarget(const PassNode& pass, std::uint32_t width, std::uint32_t height);
+    
+    LLGL::RenderSystem* renderSystem_;
+    std::vector<ResourceNode> resources_;   ///< Index + 1 is the resource handle
+    std::vector<PassNode> passes_;
+    bool compiled_;
+    std::uint64_t frame_;
+    
+    std::vector<PhysicalTexture> physicalTextures_;
+    std::vector<CachedRenderTarget> renderTargets_;
+    ReleaseScheduler releaseScheduler_;
+    
+    RenderGraphStats stats_;
+};
+
+} // namespace RenderingPlugin
@@ -7,12 +7,23 @@
 #pragma once
 
 #include "RenderingPluginExport.h"
+#include "FrameRing.h"
 #include <LLGL/LLGL.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace RenderingPlugin {
 
+// Forward declarations
+class RenderCommands;
+class RenderGraph;
+class SoftwareRasterizer;
+class ThreadPool;
+
 /**
  * @brief Enumeration of supported rendering APIs
  */
@@ -76,6 +87,19 @@ struct SystemGraphicsInfo {
     bool supportsDirectX = false;
 };
 
+/**
+ * @brief Per-frame timing information
+ */
+struct FrameStats {
+    std::uint64_t frameNumber = 0;   ///< Monotonic frame counter
+    std::uint32_t frameIndex = 0;    ///< Slot in the frames-in-flight ring
+    double cpuWaitMs = 0.0;          ///< Time BeginFrame blocked waiting for the GPU to release the slot
+    double cpuFrameMs = 0.0;         ///< Time between the previous and the current BeginFrame
+    std::uint64_t transientMemoryBytes = 0;   ///< Render graph textures used by the frame, after aliasing
+    std::uint64_t unaliasedMemoryBytes = 0;   ///< Render graph textures the frame would use without aliasing
+    std::uint64_t pooledMemoryBytes = 0;      ///< All textures held by the render graph's pool
+};
+
 /**
  * @brief Core rendering system management class
  * @details Handles LLGL render system initialization, API selection, window creation, and frame operations
@@ -110,12 +134,15 @@ public:
     
     /**
      * @brief Initialize software rendering mode
+     * @details Tries OpenGL with a software driver first and falls back to the CPU rasterizer,
+     *          see GetSoftwareRasterizer.
      * @return true if software rendering was enabled, false otherwise
      */
     bool InitializeSoftwareRenderer();
     
     /**
      * @brief Initialize headless rendering mode
+     * @details Falls back to the CPU rasterizer when no GPU API is available.
      * @return true if headless rendering was enabled, false otherwise
      */
     bool InitializeHeadlessRenderer();
@@ -167,6 +194,57 @@ public:
      */
     bool EndFrame();
     
+    /**
+     * @brief Set number of frames the CPU may record ahead of the GPU
+     * @details Takes effect when the window is created. Each frame in flight owns its own
+     *          command buffer and fence; BeginFrame only blocks when the oldest frame's slot
+     *          is still in use by the GPU.
+     * @param count Number of frames in flight (1 to 4)
+     */
+    void SetFramesInFlight(std::uint32_t count);
+    
+    /**
+     * @brief Get number of frames in flight
+     * @return Frames in flight
+     */
+    std::uint32_t GetFramesInFlight() const;
+    
+    /**
+     * @brief Get ring slot of the frame being recorded
+     * @details Use to select per-frame resources (ring-buffered constant buffers, descriptor sets)
+     * @return Frame index in [0, GetFramesInFlight())
+     */
+    std::uint32_t GetFrameIndex() const;
+    
+    /**
+     * @brief Get number of the frame being recorded
+     * @return Monotonic frame number
+     */
+    std::uint64_t GetFrameNumber() const;
+    
+    /**
+     * @brief Queue a release that must wait until the GPU finished the current frame
+     * @param release Function releasing the resource
+     */
+    void DeferRelease(std::function<void()> release);
+    
+    /**
+     * @brief Get timing information of the frame being recorded
+     * @return Frame statistics
+     */
+    const FrameStats& GetFrameStats() const;
+    
+    /**
+     * @brief Record a render graph into the current frame, once between BeginFrame and EndFrame
+     * @details Replaces the swap chain render pass begun by BeginFrame, so the graph decides the
+     *          passes of the frame; import the swap chain with RenderGraph::ImportRenderTarget to
+     *          render into it. The graph's memory use is added to the frame statistics.
+     * @param graph Graph of the frame
+     * @param commands Render commands, switched to the frame's command buffer
+     * @return true if the graph was recorded
+     */
+    bool ExecuteRenderGraph(RenderGraph& graph, RenderCommands& commands);
+    
     /**
      * @brief Clear the frame buffer
      * @param color Clear color
@@ -229,7 +307,7 @@ public:
     LLGL::SwapChain* GetSwapChain() const;
     
     /**
-     * @brief Get the command buffer
+     * @brief Get the command buffer of the frame being recorded
      * @return Pointer to command buffer, or nullptr if not available
      */
     LLGL::CommandBuffer* GetCommandBuffer() const;
@@ -239,6 +317,22 @@ public:
      * @return Pointer to surface, or nullptr if not available
      */
     LLGL::Surface* GetSurface() const;
+    
+    /**
+     * @brief Get the worker thread pool shared by rendering components
+     * @details Created on first use with one thread per hardware thread
+     * @return Pointer to thread pool
+     */
+    ThreadPool* GetThreadPool();
+    
+    /**
+     * @brief Get the CPU rasterizer used when no GPU render system could be loaded
+     * @details Frames are drawn into its image: BeginFrame, Clear, SetViewport and EndFrame act on
+     *          it, and render objects are drawn with SoftwareRasterizer::Draw. There is no swap
+     *          chain; the window size is the image size.
+     * @return Pointer to the rasterizer, or nullptr when rendering through LLGL
+     */
+    SoftwareRasterizer* GetSoftwareRasterizer() const;
 
 private:
     // === Private Methods ===
@@ -265,12 +359,38 @@ private:
      */
     bool TryInitializeAPI(RenderAPI api, std::string& errorMessage);
     
+    /**
+     * @brief Start rendering with the CPU rasterizer
+     * @param mode Software or headless mode
+     * @return true if the rasterizer was created
+     */
+    bool InitializeCpuRasterizer(RenderingMode mode);
+    
     /**
      * @brief Get macOS-specific graphics information
      * @return macOS graphics information string
      */
     std::string GetMacOSGraphicsInfo() const;
     
+    /**
+     * @brief Create command buffers and fences for all frames in flight
+     * @return true if successful, false otherwise
+     */
+    bool CreateFrameResources();
+    
+    /**
+     * @brief Wait for all frames, run pending releases and destroy per-frame objects
+     */
+    void ReleaseFrameResources();
+    
+    /**
+     * @brief Per-frame-in-flight resources, indexed by frameRing_'s slot
+     */
+    struct FrameContext {
+        LLGL::CommandBuffer* commandBuffer = nullptr;
+        LLGL::Fence* fence = nullptr;
+    };
+    
     // === Private Members ===
     
     // LLGL objects
@@ -290,6 +410,21 @@ private:
     
     // Offscreen rendering support
     LLGL::RenderTarget* offscreenRenderTarget_;
+    
+    // Frames in flight
+    std::vector<FrameContext> frames_;
+    FrameRing frameRing_;        ///< Slot index, submitted flags and pending releases
+    std::uint32_t framesInFlight_;
+    std::uint64_t frameNumber_;
+    bool swapChainPassActive_;   ///< BeginFrame's render pass is open
+    FrameStats frameStats_;
+    std::chrono::high_resolution_clock::time_point lastFrameStart_;
+    
+    // Worker threads for parallel recording
+    std::unique_ptr<ThreadPool> threadPool_;
+    
+    // CPU rendering without a GPU render system, uses threadPool_
+    std::unique_ptr<SoftwareRasterizer> softwareRasterizer_;
 };
 
 } // namespace RenderingPlugin
\ No newline at end of file
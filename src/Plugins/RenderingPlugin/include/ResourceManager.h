@@ -8,6 +8,7 @@
 
 #include "RenderingPluginExport.h"
 #include "MathTypes.h"
+#include "HandlePool.h"
 #include <LLGL/LLGL.h>
 #include <memory>
 #include <string>
@@ -18,9 +19,40 @@ namespace RenderingPlugin {
 
 /**
  * @brief Resource ID type for internal resource tracking
+ * @details Generational handle (see HandlePool); 0 is never a valid ID
  */
 using ResourceId = std::uint32_t;
 
+/**
+ * @brief Resource kind encoded in the type tag of every ResourceId
+ */
+enum class ResourceKind : std::uint8_t {
+    None = 0,
+    VertexBuffer,
+    IndexBuffer,
+    ConstantBuffer,
+    Texture,
+    Sampler,
+    Shader,
+    PipelineLayout,
+    PipelineState,
+    ResourceHeap,
+    BufferArray,
+    ConstantBufferRing,
+    RenderObject,
+    SceneObject,
+    LoadRequest
+};
+
+/**
+ * @brief Get the kind of resource an ID refers to
+ * @param id Resource ID
+ * @return Resource kind, ResourceKind::None for 0
+ */
+inline ResourceKind GetResourceKind(ResourceId id) {
+    return static_cast<ResourceKind>(HandlePool<int>::GetTypeTag(id));
+}
+
 /**
  * @brief Vertex structure for rendering
  */
@@ -70,7 +102,9 @@ struct RenderObject {
     ResourceId vertexBufferId = 0;
     ResourceId indexBufferId = 0;
     ResourceId pipelineStateId = 0;
+    ResourceId resourceHeapId = 0;
     uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;      ///< First index, e.g. of an LOD level in a shared index buffer
     Matrices transform;
     bool visible = true;
     
@@ -90,6 +124,18 @@ struct RenderObject {
     RenderObject& operator=(RenderObject&&) = default;
 };
 
+/**
+ * @brief Resources needed to draw one mesh, without per-object transforms
+ */
+struct MeshDraw {
+    ResourceId vertexBufferId = 0;
+    ResourceId indexBufferId = 0;
+    ResourceId pipelineStateId = 0;
+    ResourceId resourceHeapId = 0;
+    uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;      ///< First index, e.g. of an LOD level in a shared index buffer
+};
+
 /**
  * @brief Resource statistics structure
  */
@@ -103,6 +149,7 @@ struct ResourceStats {
     size_t pipelineLayoutCount;
     size_t resourceHeapCount;
     size_t pipelineStateCount;
+    size_t bufferArrayCount;
     size_t renderObjectCount;
     size_t totalResourceCount;
 };
@@ -158,6 +205,39 @@ public:
      */
     ResourceId CreateConstantBuffer(size_t size, const void* initialData = nullptr);
     
+    /**
+     * @brief Create a ring of constant buffers, one per frame in flight
+     * @details Each frame writes only its own slot, so updating a ring never stalls on
+     *          a buffer the GPU is still reading from an earlier frame.
+     * @param size Size of each buffer in bytes
+     * @param frameCount Number of slots (see RenderingSystem::GetFramesInFlight)
+     * @return Resource ID of created ring, or 0 on failure
+     */
+    ResourceId CreateConstantBufferRing(size_t size, std::uint32_t frameCount);
+    
+    /**
+     * @brief Get the constant buffer of a ring slot
+     * @param ringId Resource ID of the ring
+     * @param frameIndex Frame-in-flight slot (wraps around the ring size)
+     * @return Resource ID of the slot's constant buffer, or 0 if the ring does not exist
+     */
+    ResourceId GetConstantBufferRing(ResourceId ringId, std::uint32_t frameIndex) const;
+    
+    /**
+     * @brief Create a dynamic per-instance vertex buffer
+     * @param size Size of buffer in bytes
+     * @param format Per-instance vertex format (attributes with instance divisor)
+     * @return Resource ID of created instance buffer, or 0 on failure
+     */
+    ResourceId CreateInstanceBuffer(size_t size, const LLGL::VertexFormat& format);
+    
+    /**
+     * @brief Create a vertex buffer array for binding several vertex streams at once
+     * @param vertexBufferIds Resource IDs of the vertex buffers, in slot order
+     * @return Resource ID of created buffer array, or 0 on failure
+     */
+    ResourceId CreateBufferArray(const std::vector<ResourceId>& vertexBufferIds);
+    
     /**
      * @brief Update buffer data
      * @param bufferId Resource ID of buffer to update
@@ -336,7 +416,8 @@ public:
     LLGL::PipelineLayout* GetPipelineLayout(ResourceId id) const;
     LLGL::ResourceHeap* GetResourceHeap(ResourceId id) const;
     LLGL::PipelineState* GetPipelineState(ResourceId id) const;
-    const RenderObject* GetRenderObject(ResourceId id) const;
+    LLGL::BufferArray* GetBufferArray(ResourceId id) const;
+    const RenderObject* GetRenderObject(ResourceId id) const;  ///< Valid until the next render object is created or released
     
     // Resource release
     void ReleaseBuffer(ResourceId id);
@@ -346,6 +427,7 @@ public:
     void ReleasePipelineLayout(ResourceId id);
     void ReleaseResourceHeap(ResourceId id);
     void ReleasePipelineState(ResourceId id);
+    void ReleaseBufferArray(ResourceId id);
     
     // Resource statistics
     ResourceStats GetResourceStats() const;
@@ -399,18 +481,19 @@ private:
     std::uint32_t shaderCount_;
     std::uint32_t pipelineCount_;
     
-    // Resource storage maps
-    ResourceId nextResourceId_;
-    std::unordered_map<ResourceId, LLGL::Buffer*> vertexBuffers_;
-    std::unordered_map<ResourceId, LLGL::Buffer*> indexBuffers_;
-    std::unordered_map<ResourceId, LLGL::Buffer*> constantBuffers_;
-    std::unordered_map<ResourceId, LLGL::Texture*> textures_;
-    std::unordered_map<ResourceId, LLGL::Sampler*> samplers_;
-    std::unordered_map<ResourceId, LLGL::Shader*> shaders_;
-    std::unordered_map<ResourceId, LLGL::PipelineLayout*> pipelineLayouts_;
-    std::unordered_map<ResourceId, LLGL::PipelineState*> pipelineStates_;
-    std::unordered_map<ResourceId, LLGL::ResourceHeap*> resourceHeaps_;
-    std::unordered_map<ResourceId, std::unique_ptr<RenderObject>> renderObjects_;
+    // Resource storage pools, addressed by generational ResourceIds
+    HandlePool<LLGL::Buffer*> vertexBuffers_;
+    HandlePool<LLGL::Buffer*> indexBuffers_;
+    HandlePool<LLGL::Buffer*> constantBuffers_;
+    HandlePool<LLGL::Texture*> textures_;
+    HandlePool<LLGL::Sampler*> samplers_;
+    HandlePool<LLGL::Shader*> shaders_;
+    HandlePool<LLGL::PipelineLayout*> pipelineLayouts_;
+    HandlePool<LLGL::PipelineState*> pipelineStates_;
+    HandlePool<LLGL::ResourceHeap*> resourceHeaps_;
+    HandlePool<LLGL::BufferArray*> bufferArrays_;
+    HandlePool<std::vector<ResourceId>> constantBufferRings_;  ///< Ring -> per-slot constant buffers
+    HandlePool<RenderObject> renderObjects_;
 };
 
 } // namespace RenderingPlugin
\ No newline at end of file
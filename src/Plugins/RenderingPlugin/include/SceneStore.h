@@ -0,0 +1,278 @@
+/**
+ * @file SceneStore.h
+ * @brief Data-oriented scene storage and visibility pass
+ * @details Render objects are stored as parallel arrays (structure of arrays): world
+ *          transforms, world-space bounding spheres, enable/visibility flags, draw keys and
+ *          mesh resources. View and projection are stored once for the camera. Culling reads
+ *          only the bounds arrays and produces the visible draw list in one linear pass.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "ResourceManager.h"
+#include "HandlePool.h"
+#include "LodChain.h"
+#include <Gauss/Matrix.h>
+#include <Gauss/Vector3.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RenderingPlugin {
+
+// Forward declarations
+class RenderCommands;
+
+/**
+ * @brief Statistics of the last visibility pass
+ */
+struct SceneCullStats {
+    std::size_t objectCount = 0;   ///< Objects in the scene
+    std::size_t visibleCount = 0;  ///< Objects in the draw list
+    double cullTimeMs = 0.0;       ///< Frustum test over all objects
+    double buildTimeMs = 0.0;      ///< Draw list compaction and sorting
+    std::uint64_t trianglesSubmitted = 0;  ///< Triangles in the last Submit, after LOD selection
+};
+
+/**
+ * @brief Structure-of-arrays scene store
+ * @details Objects are addressed by generational handles; removal keeps the arrays dense by
+ *          moving the last object into the hole. Bounds are transformed to world space when a
+ *          transform is set, so the visibility pass never touches matrices.
+ */
+class RENDERING_PLUGIN_API SceneStore {
+public:
+    /**
+     * @brief Constructor
+     */
+    SceneStore();
+    
+    // === Object Management ===
+    
+    /**
+     * @brief Add an object
+     * @param draw Mesh resources used to draw the object
+     * @param worldMatrix World transformation matrix
+     * @param boundsCenter Center of the object-space bounding sphere
+     * @param boundsRadius Radius of the object-space bounding sphere
+     * @param drawKey Sort key of the object in the draw list (see RenderQueue::MakeSortKey)
+     * @return Object ID, or 0 on failure
+     */
+    ResourceId AddObject(const MeshDraw& draw, const Gs::Matrix4f& worldMatrix,
+                         const Gs::Vector3f& boundsCenter, float boundsRadius, std::uint64_t drawKey = 0);
+    
+    /**
+     * @brief Remove an object
+     * @param objectId Object ID
+     * @return true if the object was removed, false if the ID is not valid
+     */
+    bool RemoveObject(ResourceId objectId);
+    
+    /**
+     * @brief Set the world transform of an object
+     * @param objectId Object ID
+     * @param worldMatrix World transformation matrix
+     * @return true on success, false if the ID is not valid
+     */
+    bool SetTransform(ResourceId objectId, const Gs::Matrix4f& worldMatrix);
+    
+    /**
+     * @brief Enable or disable an object; disabled objects are never visible
+     * @param objectId Object ID
+     * @param enabled Enable state
+     * @return true on success, false if the ID is not valid
+     */
+    bool SetEnabled(ResourceId objectId, bool enabled);
+    
+    /**
+     * @brief Set the draw key of an object
+     * @param objectId Object ID
+     * @param drawKey Sort key of the object in the draw list
+     * @return true on success, false if the ID is not valid
+     */
+    bool SetDrawKey(ResourceId objectId, std::uint64_t drawKey);
+    
+    /**
+     * @brief Draw an object with an LOD chain, selecting the level per frame in Submit()
+     * @details The object's bounds are replaced by the chain's bounds. Pipeline state and resource
+     *          heap of the object's draw are kept. The chain must outlive its use by the store.
+     * @param objectId Object ID
+     * @param chain LOD chain, or nullptr to keep drawing the current level
+     * @return true on success, false if the ID is stale
+     */
+    bool SetLodChain(ResourceId objectId, const LodChain* chain);
+    
+    /**
+     * @brief Remove all objects
+     */
+    void Clear();
+    
+    // === Camera ===
+    
+    /**
+     * @brief Set the camera used by the visibility pass and Submit
+     * @param viewMatrix View transformation matrix
+     * @param projectionMatrix Projection transformation matrix
+     */
+    void SetCamera(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix);
+    
+    /**
+     * @brief Set the screen-space error threshold for LOD selection
+     * @param viewportHeight Viewport height in pixels
+     * @param pixelError Largest projected LOD error in pixels
+     */
+    void SetLodParameters(float viewportHeight, float pixelError);
+    
+    // === Visibility ===
+    
+    /**
+     * @brief Test all objects against the camera frustum and build the visible draw list
+     * @param sortByDrawKey Sort the draw list by draw key instead of storage order
+     * @return Storage indices of the visible objects, valid until the scene changes
+     */
+    const std::vector<std::uint32_t>& Cull(bool sortByDrawKey = false);
+    
+    /**
+     * @brief Record the last draw list as one instanced batch
+     * @param commands Render commands to record into
+     * @param defaultPipeline Pipeline state for objects without their own pipeline state
+     */
+    void Submit(RenderCommands& commands, LLGL::PipelineState* defaultPipeline);
+    
+    /**
+     * @brief Check if an object passed the last visibility pass
+     * @param objectId Object ID
+     * @return true if visible, false otherwise
+     */
+    bool IsVisible(ResourceId objectId) const;
+    
+    // === Access ===
+    
+    /**
+     * @brief Get number of objects
+     * @return Object count
+     */
+    std::size_t GetObjectCount() const;
+    
+    /**
+     * @brief Get the world transform of the object at a storage index
+     * @param index Storage index, e.g. from the draw list
+     * @return World transformation matrix
+     */
+    const Gs::Matrix4f& GetWorldMatrix(std::uint32_t index) const;
+    
+    /**
+     * @brief Get the mesh resources of the object at a storage index
+     * @param index Storage index, e.g. from the draw list
+     * @return Mesh resources
+     */
+    const MeshDraw& GetDraw(std::uint32_t index) const;
+    
+    /**
+     * @brief Get the last draw list
+     * @return Storage indices of the visible objects
+     */
+    const std::vector<std::uint32_t>& GetDrawList() const;
+    
+    /**
+     * @brief Get the world-space bounding sphere of the object at a storage index
+     * @param index Storage index
+     * @param center Receives the sphere center
+     * @param radius Receives the sphere radius
+     */
+    void GetWorldBounds(std::uint32_t index, Gs::Vector3f& center, float& radius) const;
+    
+    /**
+     * @brief Check if the object at a storage index is enabled
+     * @param index Storage index
+     * @return Enable state
+     */
+    bool IsEnabledAt(std::uint32_t index) const;
+    
+    /**
+     * @brief Get the camera view matrix
+     * @return View matrix set with SetCamera
+     */
+    const Gs::Matrix4f& GetViewMatrix() const;
+    
+    /**
+     * @brief Get the camera projection matrix
+     * @return Projection matrix set with SetCamera
+     */
+    const Gs::Matrix4f& GetProjectionMatrix() const;
+    
+    /**
+     * @brief Get the camera frustum planes
+     * @return Six normalized planes (a, b, c, d), a point is inside where ax + by + cz + d >= 0
+     */
+    const float* GetFrustumPlanes() const;
+    
+    /**
+     * @brief Take the range of storage indices changed since the last call
+     * @details Covers added, removed, moved, transformed, enabled or disabled objects and draw
+     *          changes, so a copy of the store, e.g. on the GPU, only updates what changed.
+     *          Indices at or past the object count belong to removed objects. Meant for a
+     *          single consumer.
+     * @param begin Receives the first changed index
+     * @param end Receives one past the last changed index
+     * @return false if nothing changed
+     */
+    bool TakeDirtyRange(std::uint32_t& begin, std::uint32_t& end);
+    
+    /**
+     * @brief Get statistics of the last visibility pass
+     * @return Cull statistics
+     */
+    const SceneCullStats& GetStatistics() const;
+
+private:
+    /**
+     * @brief Recompute the world-space bounding sphere of an object
+     * @param index Storage index
+     */
+    void UpdateWorldBounds(std::uint32_t index);
+    
+    /**
+     * @brief Add storage indices to the dirty range
+     * @param begin First changed index
+     * @param end One past the last changed index
+     */
+    void MarkDirty(std::uint32_t begin, std::uint32_t end);
+    
+    // Object handles -> storage index
+    HandlePool<std::uint32_t> handles_;
+    std::vector<ResourceId> indexToHandle_;
+    
+    // Per-object arrays, all indexed by storage index
+    std::vector<Gs::Matrix4f> worldMatrices_;
+    std::vector<Gs::Vector3f> localCenters_;
+    std::vector<float> localRadii_;
+    std::vector<float> centerX_;
+    std::vector<float> centerY_;
+    std::vector<float> centerZ_;
+    std::vector<float> radii_;
+    std::vector<std::uint8_t> enabled_;
+    std::vector<std::uint8_t> visible_;
+    std::vector<std::uint64_t> drawKeys_;
+    std::vector<MeshDraw> draws_;
+    std::vector<const LodChain*> lodChains_;
+    
+    // Camera, stored once
+    Gs::Matrix4f viewMatrix_;
+    Gs::Matrix4f projectionMatrix_;
+    float frustumPlanes_[6][4];
+    
+    // LOD selection, using the stored camera
+    LodSelector lodSelector_;
+    float viewportHeight_;
+    
+    std::vector<std::uint32_t> drawList_;
+    SceneCullStats stats_;
+    
+    // Storage indices changed since the last TakeDirtyRange, empty if begin >= end
+    std::uint32_t dirtyBegin_;
+    std::uint32_t dirtyEnd_;
+};
+
+} // namespace RenderingPlugin
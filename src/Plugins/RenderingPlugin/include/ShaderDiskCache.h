@@ -0,0 +1,140 @@
+/**
+ * @file ShaderDiskCache.h
+ * @brief Persistent key/blob store for compiled shader and pipeline cache data
+ * @details One file per entry, named after the 128-bit content key. Every entry records the
+ *          backend it was produced by and a checksum of its payload, so entries from another
+ *          driver or truncated writes are rejected and deleted instead of being handed to LLGL.
+ *          Entries are written to a temporary file and renamed, so concurrent writers and
+ *          crashed processes never leave a partial entry behind.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "ShaderHash.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RenderingPlugin {
+
+static constexpr std::uint32_t kShaderCacheMagic = 0x43535350;   ///< "PSSC"
+static constexpr std::uint32_t kShaderCacheVersion = 2;
+
+/**
+ * @brief Header of a shader cache entry file
+ */
+struct ShaderCacheEntryHeader {
+    std::uint32_t magic = kShaderCacheMagic;
+    std::uint32_t version = kShaderCacheVersion;
+    std::uint64_t backendHash = 0;     ///< Hash of the backend/driver the payload was produced by
+    std::uint64_t payloadSize = 0;     ///< Bytes following the header
+    std::uint64_t payloadHash = 0;     ///< Checksum of the payload (low half of its ShaderHash)
+};
+
+static_assert(sizeof(ShaderCacheEntryHeader) == 32, "ShaderCacheEntryHeader layout is part of the file format");
+
+/**
+ * @brief Shader disk cache statistics
+ */
+struct ShaderDiskCacheStats {
+    std::uint64_t hits = 0;            ///< Loads that returned a valid entry
+    std::uint64_t misses = 0;          ///< Loads without a valid entry
+    std::uint64_t writes = 0;          ///< Entries stored
+    std::uint64_t rejected = 0;        ///< Entries deleted for a backend mismatch or corruption (counted as misses too)
+    double readTimeMs = 0.0;           ///< Time spent reading entries
+    double writeTimeMs = 0.0;          ///< Time spent writing entries
+};
+
+/**
+ * @brief Directory of cached shader/pipeline blobs
+ * @details Thread-safe; entries for different keys can be loaded and stored concurrently.
+ */
+class RENDERING_PLUGIN_API ShaderDiskCache {
+public:
+    /**
+     * @brief Constructor
+     */
+    ShaderDiskCache();
+    
+    // === Setup ===
+    
+    /**
+     * @brief Use a directory for the cache, creating it if needed
+     * @param directory Cache directory
+     * @param backendId Backend and driver description; entries written under another ID are rejected
+     * @return true on success, false if the directory cannot be created
+     */
+    bool Open(const std::string& directory, const std::string& backendId);
+    
+    /**
+     * @brief Stop using the cache directory; entries stay on disk
+     */
+    void Close();
+    
+    /**
+     * @brief Check if a cache directory is in use
+     * @return true if open, false otherwise
+     */
+    bool IsOpen() const;
+    
+    /**
+     * @brief Get the cache directory
+     * @return Directory path, empty if closed
+     */
+    const std::string& GetDirectory() const;
+    
+    // === Entries ===
+    
+    /**
+     * @brief Load an entry
+     * @param key Content key
+     * @param blob Output payload
+     * @return true on a hit, false if the entry is missing, stale or corrupt
+     */
+    bool Load(const ShaderHash& key, std::vector<std::uint8_t>& blob);
+    
+    /**
+     * @brief Store an entry, replacing an existing one
+     * @param key Content key
+     * @param data Payload
+     * @param size Payload size in bytes
+     * @return true on success, false otherwise
+     */
+    bool Store(const ShaderHash& key, const void* data, std::size_t size);
+    
+    /**
+     * @brief Delete all entries in the cache directory
+     * @return Number of entries deleted
+     */
+    std::size_t Clear();
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get cache statistics
+     * @return Statistics since Open() or ResetStatistics()
+     */
+    ShaderDiskCacheStats GetStatistics() const;
+    
+    /**
+     * @brief Reset cache statistics
+     */
+    void ResetStatistics();
+
+private:
+    /**
+     * @brief Get the file path of an entry
+     */
+    std::string GetEntryPath(const ShaderHash& key) const;
+    
+    std::string directory_;
+    std::uint64_t backendHash_;
+    
+    mutable std::mutex statsMutex_;
+    ShaderDiskCacheStats stats_;
+};
+
+} // namespace RenderingPlugin
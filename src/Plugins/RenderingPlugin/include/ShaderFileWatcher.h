@@ -0,0 +1,132 @@
+/**
+ * @file ShaderFileWatcher.h
+ * @brief Event-driven change notification for shader source files
+ * @details On Linux a background thread blocks on inotify, so nothing runs while no file changes.
+ *          The parent directories of the files are watched rather than the files themselves, so
+ *          editors that save by renaming a temporary file over the original are still seen. Events
+ *          are collected until none arrived for the debounce interval and then published as one
+ *          batch, which turns an editor's save burst into a single change per file.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Watches a set of files and reports changed ones in debounced batches
+ */
+class RENDERING_PLUGIN_API ShaderFileWatcher {
+public:
+    /**
+     * @brief Constructor
+     */
+    ShaderFileWatcher();
+    
+    /**
+     * @brief Destructor, stops the watcher thread
+     */
+    ~ShaderFileWatcher();
+    
+    ShaderFileWatcher(const ShaderFileWatcher&) = delete;
+    ShaderFileWatcher& operator=(const ShaderFileWatcher&) = delete;
+    
+    // === Setup ===
+    
+    /**
+     * @brief Check if event-driven watching is available on this platform
+     * @return true on Linux, false otherwise
+     */
+    static bool IsSupported();
+    
+    /**
+     * @brief Start the watcher thread and watch all files added so far
+     * @param debounce Quiet time after the last event before changes are published
+     * @return true if running, false if unsupported or inotify could not be initialized
+     */
+    bool Start(std::chrono::milliseconds debounce = std::chrono::milliseconds(100));
+    
+    /**
+     * @brief Stop the watcher thread; the file list is kept
+     */
+    void Stop();
+    
+    /**
+     * @brief Check if the watcher thread is running
+     * @return true if running, false otherwise
+     */
+    bool IsRunning() const;
+    
+    // === Files ===
+    
+    /**
+     * @brief Add a file to watch; it does not need to exist yet
+     * @param filePath File path
+     * @return true if the file is watched or will be once started, false if its directory cannot be watched
+     */
+    bool AddFile(const std::string& filePath);
+    
+    /**
+     * @brief Get the number of watched files
+     * @return File count
+     */
+    std::size_t GetFileCount() const;
+    
+    /**
+     * @brief Convert a path to the absolute, normalized form used in change reports
+     * @param filePath File path
+     * @return Normalized path
+     */
+    static std::string NormalizePath(const std::string& filePath);
+    
+    // === Changes ===
+    
+    /**
+     * @brief Check for published changes without locking
+     * @return true if TakeChanges() would return files
+     */
+    bool HasChanges() const;
+    
+    /**
+     * @brief Take the changed files published since the last call
+     * @return Normalized paths of changed files, each once
+     */
+    std::vector<std::string> TakeChanges();
+
+private:
+    /**
+     * @brief Watcher thread main loop
+     */
+    void WatchLoop();
+    
+    /**
+     * @brief Watch the directory of a file if it is not watched yet; requires mutex_
+     */
+    bool WatchDirectory(const std::string& directory);
+    
+    int inotifyFd_;
+    int wakeFd_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::chrono::milliseconds debounce_;
+    
+    mutable std::mutex mutex_;
+    std::unordered_set<std::string> files_;
+    std::unordered_map<int, std::string> watchDirectories_;   ///< Watch descriptor to directory
+    std::unordered_map<std::string, int> directoryWatches_;   ///< Directory to watch descriptor
+    std::vector<std::string> changes_;
+    std::atomic<bool> hasChanges_;
+};
+
+} // namespace RenderingPlugin
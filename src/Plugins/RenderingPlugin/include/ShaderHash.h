@@ -0,0 +1,112 @@
+/**
+ * @file ShaderHash.h
+ * @brief 128-bit streaming content hash used for shader cache keys
+ * @details Four 64-bit lanes consume 32-byte stripes with the xxHash64 round and are folded into
+ *          two independently avalanched 64-bit halves. Hashing runs at memory speed, so a shader
+ *          source is hashed once and the 16-byte result is what cache lookups compare.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief 128-bit hash value
+ */
+struct ShaderHash {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+    
+    bool operator==(const ShaderHash& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const ShaderHash& other) const { return !(*this == other); }
+    bool operator<(const ShaderHash& other) const { return high != other.high ? high < other.high : low < other.low; }
+    
+    /**
+     * @brief Format as 32 lowercase hex digits, high half first
+     * @return Hex string
+     */
+    std::string ToString() const;
+};
+
+/**
+ * @brief Hash functor for unordered containers keyed by ShaderHash
+ */
+struct ShaderHashHasher {
+    std::size_t operator()(const ShaderHash& hash) const { return static_cast<std::size_t>(hash.low ^ (hash.high * 0x9E3779B97F4A7C15ull)); }
+};
+
+/**
+ * @brief Incremental 128-bit hasher
+ * @details Feeding data in one call or in many pieces gives the same result.
+ */
+class RENDERING_PLUGIN_API ShaderHasher {
+public:
+    /**
+     * @brief Constructor
+     * @param seed Hash seed
+     */
+    explicit ShaderHasher(std::uint64_t seed = 0);
+    
+    /**
+     * @brief Add raw bytes
+     * @param data Bytes to hash
+     * @param size Number of bytes
+     * @return This hasher
+     */
+    ShaderHasher& Update(const void* data, std::size_t size);
+    
+    /**
+     * @brief Add a string prefixed by its length, so adjacent fields cannot run into each other
+     * @param text String to hash
+     * @return This hasher
+     */
+    ShaderHasher& Update(const std::string& text);
+    
+    /**
+     * @brief Add another hash, e.g. to combine per-stage hashes into a program hash
+     * @param hash Hash to add
+     * @return This hasher
+     */
+    ShaderHasher& Update(const ShaderHash& hash);
+    
+    /**
+     * @brief Add a trivially copyable value by its bytes
+     * @param value Value to hash
+     * @return This hasher
+     */
+    template <typename T>
+    ShaderHasher& UpdateValue(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "UpdateValue requires a trivially copyable type");
+        return Update(&value, sizeof(value));
+    }
+    
+    /**
+     * @brief Compute the hash of everything added so far; the hasher can keep being updated
+     * @return Hash value
+     */
+    ShaderHash Finalize() const;
+    
+    /**
+     * @brief Hash a buffer in one call
+     * @param data Bytes to hash
+     * @param size Number of bytes
+     * @param seed Hash seed
+     * @return Hash value
+     */
+    static ShaderHash Hash(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+private:
+    std::uint64_t lanes_[4];
+    std::uint8_t buffer_[32];
+    std::size_t bufferSize_;
+    std::uint64_t totalSize_;
+    std::uint64_t seed_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,146 @@
+/**
+ * @file ShaderIncludeCache.h
+ * @brief Cache of expanded shader includes and the include dependency graph
+ * @details Every include file is loaded and expanded once and reused while neither it nor anything
+ *          it includes has changed on disk. An entry remembers the modification time of its file
+ *          and of every file it pulls in, so checking an entry costs a stat per file instead of a
+ *          read and a rescan. Includes that do not exist on disk (e.g. generated by the loader)
+ *          cannot be checked and are loaded every time, as without the cache.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Include cache statistics
+ */
+struct ShaderIncludeCacheStats {
+    std::uint64_t hits = 0;            ///< Includes served from the cache
+    std::uint64_t loads = 0;           ///< Includes loaded and expanded
+    std::uint64_t invalidations = 0;   ///< Entries dropped by Invalidate
+};
+
+/**
+ * @brief Expanded include files keyed by normalized path, validated by modification time
+ * @details Thread-safe; includes can be expanded from several threads at once. Two threads missing
+ *          the same entry both load it and the later one is kept.
+ */
+class RENDERING_PLUGIN_API ShaderIncludeCache {
+public:
+    /**
+     * @brief Loader called with the include path and the path of the including file
+     */
+    using Loader = std::function<std::string(const std::string&, const std::string&)>;
+    
+    // === Expansion ===
+    
+    /**
+     * @brief Replace the include directives of a source, recursively, by the included text
+     * @details Includes resolve against the directory of the including file.
+     * @param source Shader source code
+     * @param currentPath Path of the file the source belongs to, may be empty
+     * @param loader Returns the contents of an include; only called for missing or stale entries
+     * @param includedFiles Optional output of the normalized paths of all resolved includes
+     * @return Source with includes expanded
+     */
+    std::string Expand(const std::string& source, const std::string& currentPath, const Loader& loader,
+                       std::vector<std::string>* includedFiles = nullptr);
+    
+    // === Dependency Graph ===
+    
+    /**
+     * @brief Get the files a cached include includes directly
+     * @param filePath Include file
+     * @return Normalized paths, empty if the file is not cached
+     */
+    std::vector<std::string> GetIncludes(const std::string& filePath) const;
+    
+    /**
+     * @brief Get every cached include that includes a file, directly or indirectly
+     * @param filePath Any file
+     * @return Normalized paths, sorted
+     */
+    std::vector<std::string> GetDependents(const std::string& filePath) const;
+    
+    /**
+     * @brief Drop a file and every include depending on it
+     * @details Only needed for changes that keep the modification time, e.g. on file systems with
+     *          coarse timestamps; other changes are detected when an entry is used.
+     * @param filePath Changed file
+     * @return Number of entries dropped
+     */
+    std::size_t Invalidate(const std::string& filePath);
+    
+    /**
+     * @brief Drop all entries
+     */
+    void Clear();
+    
+    /**
+     * @brief Get the number of cached includes
+     * @return Entry count
+     */
+    std::size_t GetEntryCount() const;
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get cache statistics
+     * @return Statistics since the last reset
+     */
+    ShaderIncludeCacheStats GetStatistics() const;
+    
+    /**
+     * @brief Reset cache statistics
+     */
+    void ResetStatistics();
+
+private:
+    /**
+     * @brief One expanded include
+     */
+    struct Entry {
+        std::string expanded;                  ///< Contents with nested includes expanded
+        std::vector<std::string> includes;     ///< Direct includes, normalized
+        std::vector<std::pair<std::string, std::filesystem::file_time_type>> files; ///< This file, then all nested includes
+        bool cacheable = true;                 ///< Every file in files exists on disk
+    };
+    
+    /**
+     * @brief Expand the includes of a source, collecting the entries it includes directly
+     */
+    std::string ExpandSource(const std::string& source, const std::string& currentPath, const Loader& loader,
+                             std::vector<std::shared_ptr<const Entry>>& children, std::vector<std::string>& stack);
+    
+    /**
+     * @brief Get the cached entry of an include, loading it if missing or stale
+     */
+    std::shared_ptr<const Entry> GetEntry(const std::string& includePath, const std::string& currentPath,
+                                          const Loader& loader, std::vector<std::string>& stack);
+    
+    /**
+     * @brief Check that no file of an entry changed since it was loaded
+     */
+    static bool IsCurrent(const Entry& entry);
+    
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const Entry>> entries_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> dependents_;  ///< Reverse include edges
+    ShaderIncludeCacheStats stats_;
+};
+
+} // namespace RenderingPlugin
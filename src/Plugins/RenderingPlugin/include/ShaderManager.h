@@ -6,8 +6,18 @@
 
 #pragma once
 
+#include "FrameRing.h"
 #include "RenderingPluginExport.h"
+#include "ShaderDiskCache.h"
+#include "ShaderFileWatcher.h"
+#include "ShaderHash.h"
+#include "ShaderIncludeCache.h"
+#include "ThreadPool.h"
 #include <LLGL/LLGL.h>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <map>
@@ -65,6 +75,33 @@ struct RENDERING_PLUGIN_API ShaderSource {
                 const std::string& entry = "main", const std::string& shaderProfile = "",
                 const std::string& sourceFilePath = "")
         : type(shaderType), source(sourceCode), entryPoint(entry), profile(shaderProfile), filePath(sourceFilePath) {}
+    
+    /**
+     * @brief Get the content hash of type, source, entry point and profile
+     * @details Computed on first use and memoized, so large sources are hashed once. Call
+     *          InvalidateHash() after changing any of these fields.
+     * @return 128-bit content hash
+     */
+    const ShaderHash& GetHash() const {
+        if (!hashValid_) {
+            ShaderHasher hasher;
+            hasher.UpdateValue(type).Update(source).Update(entryPoint).Update(profile);
+            hash_ = hasher.Finalize();
+            hashValid_ = true;
+        }
+        return hash_;
+    }
+    
+    /**
+     * @brief Discard the memoized content hash
+     */
+    void InvalidateHash() {
+        hashValid_ = false;
+    }
+
+private:
+    mutable ShaderHash hash_;
+    mutable bool hashValid_ = false;
 };
 
 /**
@@ -123,8 +160,11 @@ struct RENDERING_PLUGIN_API CompiledShaderProgram {
     LLGL::Shader* vertexShader;                ///< Vertex shader
     LLGL::Shader* fragmentShader;              ///< Fragment shader
     LLGL::Shader* geometryShader;              ///< Geometry shader
+    LLGL::Shader* tessControlShader;           ///< Tessellation control shader
+    LLGL::Shader* tessEvaluationShader;        ///< Tessellation evaluation shader
     std::unordered_map<std::string, std::uint32_t> uniformLocations; ///< Uniform locations cache
     std::unordered_map<std::string, std::uint32_t> attributeLocations; ///< Attribute locations cache
+    std::vector<std::string> sourceFiles;       ///< Normalized paths of the stage files and resolved includes
     bool isValid;                               ///< Whether the program is valid
     std::string errorLog;                       ///< Compilation error log (if any)
     
@@ -132,7 +172,8 @@ struct RENDERING_PLUGIN_API CompiledShaderProgram {
      * @brief Constructor
      */
     CompiledShaderProgram() : pipelineState(nullptr), vertexShader(nullptr), 
-                             fragmentShader(nullptr), geometryShader(nullptr), isValid(false) {}
+                             fragmentShader(nullptr), geometryShader(nullptr),
+                             tessControlShader(nullptr), tessEvaluationShader(nullptr), isValid(false) {}
     
     /**
      * @brief Get uniform location by name
@@ -155,6 +196,18 @@ struct RENDERING_PLUGIN_API CompiledShaderProgram {
     }
 };
 
+/**
+ * @brief Timing of the last synchronous compilation batch
+ * @details With programs or stages compiling in parallel, wallTimeMs drops below summedTimeMs;
+ *          the ratio of the two is the speedup over compiling one after another.
+ */
+struct RENDERING_PLUGIN_API ShaderCompileTiming {
+    std::size_t programCount = 0;   ///< Programs in the batch
+    double wallTimeMs = 0.0;        ///< Elapsed time of the whole batch
+    double summedTimeMs = 0.0;      ///< Sum of the per-program preprocessing and compile times
+    double preprocessTimeMs = 0.0;  ///< Part of summedTimeMs spent on include resolution, hashing and disk cache reads
+};
+
 /**
  * @brief Cached shader information
  */
@@ -162,7 +215,7 @@ struct CachedShader {
     LLGL::Shader* shader;           ///< LLGL shader object
     ShaderSource source;            ///< Original shader source
     ShaderCompileOptions options;   ///< Compilation options used
-    std::string cacheKey;           ///< Cache key for this shader
+    ShaderHash cacheKey;            ///< Cache key for this shader
     
     CachedShader() : shader(nullptr) {}
 };
@@ -209,6 +262,8 @@ public:
     
     /**
      * @brief Load multiple shaders from directory
+     * @details Files are read and their includes resolved on the thread pool if one is set.
+     *          Results are sorted by file path.
      * @param directoryPath Directory containing shader files
      * @param fileExtensions Map of file extensions to shader types (e.g., {".vert", ShaderType::Vertex})
      * @return Vector of loaded shader sources
@@ -220,6 +275,10 @@ public:
     
     /**
      * @brief Compile shader program
+     * @details The defines of programDesc.compileOptions and of options are inserted after the
+     *          #version line of every stage. With caching enabled, compiling the same sources with
+     *          the same options again returns the cached program; its LLGL objects are shared and
+     *          reference counted, so every returned program is released or registered once as usual.
      * @param programDesc Shader program description
      * @param options Compilation options
      * @return Compiled shader program
@@ -240,6 +299,86 @@ public:
         const std::vector<LLGL::VertexAttribute>& vertexAttributes = {},
         const ShaderCompileOptions& options = {});
     
+    // === Parallel Compilation ===
+    
+    /**
+     * @brief Use a worker pool for shader preprocessing and compilation
+     * @details Include resolution, hashing and disk cache reads then always run on the pool.
+     *          The compile functions must not be called from tasks running on this pool.
+     * @param threadPool Worker pool, owned by the caller; nullptr to compile on the calling thread
+     */
+    void SetThreadPool(ThreadPool* threadPool);
+    
+    /**
+     * @brief Get the worker pool used for compilation
+     * @return Worker pool, or nullptr if none is set
+     */
+    ThreadPool* GetThreadPool() const;
+    
+    /**
+     * @brief Allow LLGL shaders and pipelines to be created on the worker pool
+     * @details LLGL render systems do not synchronize their object lists in every version, so
+     *          the manager serializes its own LLGL calls behind a mutex: workers create objects one
+     *          at a time while preprocessing, reflection and disk cache I/O still overlap, and
+     *          asynchronous compilations finish without ProcessPendingCompilations(). Disabled by
+     *          default, since the application must not create or release LLGL objects on other
+     *          threads meanwhile. OpenGL objects can only be created on the context thread, so the
+     *          OpenGL backends ignore this setting.
+     * @param enable Whether to create LLGL objects on the worker pool
+     */
+    void SetParallelCreationEnabled(bool enable);
+    
+    /**
+     * @brief Check if programs are created on the worker pool
+     * @return true if a pool is set, parallel creation is enabled and the backend allows it
+     */
+    bool IsParallelCreationSupported() const;
+    
+    /**
+     * @brief Compile independent shader programs as one batch
+     * @details Programs are preprocessed in parallel, then created on the worker pool if
+     *          IsParallelCreationSupported(), otherwise on the calling thread; the LLGL calls of
+     *          different programs never overlap.
+     * @param programDescs Program descriptions
+     * @param options Compilation options applied to every program
+     * @return Compiled programs in the order of programDescs
+     */
+    std::vector<CompiledShaderProgram> CompileShaderPrograms(const std::vector<ShaderProgramDesc>& programDescs,
+                                                             const ShaderCompileOptions& options = {});
+    
+    /**
+     * @brief Compile a shader program without blocking the calling thread
+     * @details Preprocessing runs on the worker pool. Unless IsParallelCreationSupported(), the
+     *          LLGL objects are created by ProcessPendingCompilations(), which the render thread
+     *          calls once per frame, e.g. while drawing a loading screen. Without a pool the
+     *          program is compiled immediately and the returned future is ready.
+     * @param programDesc Shader program description, copied
+     * @param options Compilation options
+     * @return Future for the compiled program
+     */
+    std::future<CompiledShaderProgram> CompileShaderProgramAsync(const ShaderProgramDesc& programDesc,
+                                                                 const ShaderCompileOptions& options = {});
+    
+    /**
+     * @brief Finish asynchronous compilations whose preprocessing is done
+     * @details Must be called on the thread that owns the render system.
+     * @param maxPrograms Maximum number of programs to create in this call
+     * @return Number of futures fulfilled
+     */
+    std::size_t ProcessPendingCompilations(std::size_t maxPrograms = SIZE_MAX);
+    
+    /**
+     * @brief Get the number of asynchronous compilations waiting for ProcessPendingCompilations()
+     * @return Pending compilation count
+     */
+    std::size_t GetPendingCompilationCount() const;
+    
+    /**
+     * @brief Get the timing of the last CompileShaderProgram() or CompileShaderPrograms() call
+     * @return Wall-clock and summed compile times
+     */
+    ShaderCompileTiming GetLastCompileTiming() const;
+    
     // === Shader Management ===
     
     /**
@@ -281,6 +420,13 @@ public:
      */
     void ClearAllShaderPrograms();
     
+    /**
+     * @brief Release the pipeline state and shaders of a program that was not registered
+     * @details Objects shared through the program cache are released with their last user.
+     * @param program Program to release; its pointers are reset and it becomes invalid
+     */
+    void ReleaseShaderProgram(CompiledShaderProgram& program);
+    
     // === Built-in Shaders ===
     
     /**
@@ -346,6 +492,17 @@ public:
      */
     std::string PreprocessShaderSource(const std::string& source, const ShaderCompileOptions& options);
     
+    /**
+     * @brief Get the stages of a program as CompileShaderProgram() passes them to LLGL
+     * @details Resolves the includes of every stage, then inserts the defines of
+     *          programDesc.compileOptions followed by those of options after the #version line.
+     *          Does not use the render system.
+     * @param programDesc Program description
+     * @param options Compilation options
+     * @return Description with the preprocessed stage sources
+     */
+    ShaderProgramDesc PreprocessShaderProgram(const ShaderProgramDesc& programDesc, const ShaderCompileOptions& options = {});
+    
     /**
      * @brief Validate shader source syntax
      * @param source Shader source code
@@ -354,8 +511,31 @@ public:
      */
     bool ValidateShaderSource(const std::string& source, ShaderType type);
     
+    /**
+     * @brief Set include resolver for shader preprocessing
+     * @details Called with the include path and the path of the including file. With a thread
+     *          pool set it is called from worker threads, so it must be thread-safe. Includes are
+     *          tracked for hot reload as paths relative to the including file. Expanded includes
+     *          are cached by path and modification time, so the resolver is called once per file
+     *          until it changes; replacing the resolver clears the cache.
+     * @param resolver Function returning the contents of an include
+     */
+    void SetIncludeResolver(IncludeResolver resolver);
+    
+    /**
+     * @brief Get the include cache, e.g. for its statistics or include dependency graph
+     * @return Include cache
+     */
+    const ShaderIncludeCache& GetIncludeCache() const;
+    
     /**
      * @brief Get shader compilation statistics
+     * @details Besides the per-program times, the map holds the disk cache counters under
+     *          "diskCache.hits", "diskCache.misses", "diskCache.writes" and "diskCache.rejected",
+     *          the include cache counters under "includeCache.hits" and "includeCache.loads", the
+     *          reflection cache counters under "reflection.hits" and "reflection.misses", the
+     *          in-memory program cache under "programCache.hits" and "programCache.entries", and the
+     *          last batch timing under "lastBatch.wallTimeMs" and "lastBatch.summedTimeMs".
      * @return Map of shader program names to compilation times (in milliseconds)
      */
     std::unordered_map<std::string, double> GetCompilationStatistics() const;
@@ -373,14 +553,36 @@ public:
     bool IsCachingEnabled() const;
     
     /**
-     * @brief Clear shader cache
+     * @brief Clear shader cache, including the entries of the disk cache
+     * @details Programs returned from the in-memory cache stay valid until they are released.
      */
     void ClearCache();
     
+    /**
+     * @brief Persist compiled pipelines in a directory across process starts
+     * @details Programs are keyed by a hash of their include-resolved sources, entry points,
+     *          profiles, compile options and the renderer/driver description, and their LLGL
+     *          pipeline cache blob is stored on first compilation. Later compilations of the same
+     *          program create the pipeline from the stored blob, skipping the driver's compile
+     *          and link of the program binary.
+     * @param directory Cache directory, created if needed; empty to disable the disk cache
+     * @return true if the disk cache is in use, false otherwise
+     */
+    bool SetDiskCacheDirectory(const std::string& directory);
+    
+    /**
+     * @brief Get disk cache statistics
+     * @return Hits, misses, writes and I/O time of the disk cache
+     */
+    ShaderDiskCacheStats GetDiskCacheStatistics() const;
+    
     // === Hot Reload Support ===
     
     /**
      * @brief Enable hot reload for shader files
+     * @details Watches the files and includes of programs compiled by CompileShaderProgramFromFiles.
+     *          On Linux an inotify watcher thread reports changes, so CheckForShaderChanges() costs
+     *          no system calls while nothing changes; elsewhere the modification times are polled.
      * @param enable Whether to enable hot reload
      */
     void SetHotReloadEnabled(bool enable);
@@ -392,7 +594,17 @@ public:
     bool IsHotReloadEnabled() const;
     
     /**
-     * @brief Check for shader file changes and reload if necessary
+     * @brief Check if changes are reported by the event-driven file watcher
+     * @return true if the watcher runs, false if hot reload is off or modification times are polled
+     */
+    bool IsFileWatcherActive() const;
+    
+    /**
+     * @brief Check for shader file changes and reload if necessary; call once per frame
+     * @details Registered programs that depend on a changed file or include are recompiled in the
+     *          background and replaced in a later call once they compiled successfully. Without
+     *          parallel creation this call also runs ProcessPendingCompilations() while reloads are pending.
+     * @return true if a registered program was replaced in this call
      */
     bool CheckForShaderChanges();
     
@@ -402,8 +614,80 @@ public:
      * @return true if successful, false otherwise
      */
     bool ReloadShaderProgram(const std::string& programName);
+    
+    /**
+     * @brief Set how programs replaced by a reload are released
+     * @details Bind to RenderingSystem::DeferRelease so frames still in flight can finish with the
+     *          old pipeline. The scheduler has to run its releases before this manager is destroyed.
+     *          Without a scheduler replaced programs are released immediately.
+     * @param scheduler Release scheduler, or nullptr
+     */
+    void SetReleaseScheduler(ReleaseScheduler scheduler);
+    
+    // === Built-in Shaders ===
+    
+    /**
+     * @brief Get built-in shader source, e.g. "quantized_vertex" for meshes of VertexQuantizer
+     * @param name Shader name
+     * @return Shader source code; throws std::runtime_error for an unknown name
+     */
+    std::string GetBuiltInShader(const std::string& name) const;
+    
+    /**
+     * @brief Get all built-in shader names
+     * @return Vector of shader names
+     */
+    std::vector<std::string> GetBuiltInShaderNames() const;
 
 private:
+    /**
+     * @brief Shader program after the steps that do not touch LLGL
+     */
+    struct PreparedShaderProgram {
+        ShaderProgramDesc desc;             ///< Description with include-resolved and preprocessed sources
+        ShaderCompileOptions options;       ///< Compilation options
+        ShaderHash diskCacheKey;            ///< Disk cache key, if the disk cache is used
+        std::vector<std::uint8_t> cachedBlob; ///< Pipeline cache blob loaded from disk
+        bool useDiskCache = false;          ///< Whether the disk cache is used
+        bool diskCacheHit = false;          ///< Whether cachedBlob holds a valid entry
+        std::vector<std::string> includedFiles; ///< Normalized paths of the resolved includes
+        double prepareTimeMs = 0.0;         ///< Time spent preparing
+    };
+    
+    /**
+     * @brief Asynchronous compilation waiting for its LLGL objects to be created
+     */
+    struct PendingCompilation {
+        std::future<PreparedShaderProgram> prepared;
+        std::promise<CompiledShaderProgram> result;
+    };
+    
+    /**
+     * @brief Program whose LLGL objects are shared through the in-memory program cache
+     */
+    struct SharedProgram {
+        CompiledShaderProgram program;
+        std::uint32_t references = 0;       ///< The cache entry plus every returned copy not yet released
+    };
+    
+    /**
+     * @brief Arguments a program was compiled from files with, reused when it is reloaded
+     */
+    struct ProgramFiles {
+        std::unordered_map<ShaderType, std::string> shaderFiles;
+        std::vector<LLGL::VertexAttribute> vertexAttributes;
+        ShaderCompileOptions options;
+    };
+    
+    /**
+     * @brief Background recompilation of a registered program
+     */
+    struct PendingReload {
+        std::string programName;
+        std::future<CompiledShaderProgram> result;
+        bool reloadAgain = false;           ///< A file changed again while compiling
+    };
+    
     // === Private Methods ===
     
     /**
@@ -420,80 +704,212 @@ private:
      */
     std::string ReadFileContents(const std::string& filePath) const;
     
+    /**
+     * @brief Uniform and attribute names found in one shader stage
+     */
+    struct ShaderReflection {
+        std::vector<std::string> uniforms;     ///< Uniform names in declaration order
+        std::vector<std::string> attributes;   ///< Input names in declaration order
+    };
+    
+    /**
+     * @brief Get the reflection of a stage, scanning the source only once per content hash
+     * @param source Preprocessed shader source
+     * @return Shared reflection result
+     */
+    std::shared_ptr<const ShaderReflection> GetShaderReflection(const ShaderSource& source);
+    
     /**
      * @brief Extract uniform and attribute locations from shader program
-     * @param program Compiled shader program to extract from
+     * @details Uniforms of all stages and the vertex stage inputs are numbered in declaration order.
+     * @param programDesc Preprocessed program the shaders were created from
+     * @param program Compiled shader program to extract into
      */
-    void ExtractShaderReflection(CompiledShaderProgram& program);
+    void ExtractShaderReflection(const ShaderProgramDesc& programDesc, CompiledShaderProgram& program);
     
     /**
      * @brief Generate cache key for shader source
+     * @details Combines the memoized ShaderSource hash with the options, so the source text
+     *          is not rehashed on every lookup.
      * @param source Shader source
      * @param options Compilation options
-     * @return Cache key string
+     * @return Cache key
      */
-    std::string GenerateCacheKey(const ShaderSource& source, const ShaderCompileOptions& options) const;
+    ShaderHash GenerateCacheKey(const ShaderSource& source, const ShaderCompileOptions& options) const;
     
     /**
      * @brief Generate cache key for shader program
      * @param programDesc Program description
-     * @return Cache key string
+     * @return Cache key combining the keys of all present stages
      */
-    std::string GenerateProgramCacheKey(const ShaderProgramDesc& programDesc) const;
+    ShaderHash GenerateProgramCacheKey(const ShaderProgramDesc& programDesc) const;
     
     /**
-     * @brief Release all cached shaders and shader programs
+     * @brief Generate the in-memory cache key of a program compiled with additional options
+     * @param programDesc Program description
+     * @param options Compilation options passed with the program
+     * @return GenerateProgramCacheKey() combined with the options
      */
-    void ReleaseAllShaders();
+    ShaderHash GenerateProgramCacheKey(const ShaderProgramDesc& programDesc, const ShaderCompileOptions& options) const;
     
     /**
-     * @brief Reload shader from file
-     * @param filePath Path to shader file
+     * @brief Take a reference to a cached program
+     * @param key Program cache key
+     * @param program Output copy sharing the cached objects
+     * @return true on a cache hit
+     */
+    bool AcquireCachedProgram(const ShaderHash& key, CompiledShaderProgram& program);
+    
+    /**
+     * @brief Share a newly compiled program through the cache
+     * @details The cache and the returned program each hold a reference.
+     * @param key Program cache key
+     * @param program Valid program just compiled
+     */
+    void AddCachedProgram(const ShaderHash& key, const CompiledShaderProgram& program);
+    
+    /**
+     * @brief Drop the cache's references, releasing programs nobody else holds
      */
-    void ReloadShader(const std::string& filePath);
+    void ReleaseCachedPrograms();
     
     /**
-     * @brief Reload affected shader programs
+     * @brief Release the LLGL objects of a program regardless of the program cache
+     * @param program Program to release; its pointers are reset and it becomes invalid
+     */
+    void ReleaseProgramObjects(CompiledShaderProgram& program);
+    
+    /**
+     * @brief Generate the disk cache key of a shader program
+     * @param programDesc Program description
+     * @param options Compilation options passed with the program
+     * @return Content hash of the program and the current backend
+     */
+    ShaderHash GenerateDiskCacheKey(const ShaderProgramDesc& programDesc, const ShaderCompileOptions& options) const;
+    
+    /**
+     * @brief Resolve includes, insert defines, compute the disk cache key and load the cached pipeline blob
+     * @details Does not use the render system, so it is safe on any thread.
+     * @param programDesc Program description
+     * @param options Compilation options
+     * @param parallelStages Whether to resolve the stages' includes on the thread pool
+     * @return Prepared program
+     */
+    PreparedShaderProgram PrepareShaderProgram(const ShaderProgramDesc& programDesc,
+                                               const ShaderCompileOptions& options, bool parallelStages);
+    
+    /**
+     * @brief Create the LLGL shaders and pipeline state of a prepared program
+     * @details The LLGL calls hold creationMutex_; reflection and the disk cache write do not.
+     * @param prepared Prepared program
+     * @param compileTimeMs Output summed stage and pipeline creation time
+     * @return Compiled program; on failure no LLGL objects are kept
+     */
+    CompiledShaderProgram CreateShaderProgramObjects(const PreparedShaderProgram& prepared, double& compileTimeMs);
+    
+    /**
+     * @brief Create one stage of a program
+     * @param source Stage source
+     * @param type LLGL shader type
+     * @param stageName Stage name for the error log, e.g. "Vertex"
+     * @param errorLog Output error message on failure
+     * @return Created shader, or nullptr on failure
+     */
+    LLGL::Shader* CreateStageShader(const ShaderSource& source, LLGL::ShaderType type,
+                                    const std::string& stageName, std::string& errorLog);
+    
+    /**
+     * @brief Record the compile time of a program for GetCompilationStatistics()
+     * @param program Compiled program
+     * @param timeMs Compile time
+     */
+    void RecordCompilationTime(const CompiledShaderProgram& program, double timeMs);
+    
+    /**
+     * @brief Block until no asynchronous compilation task references this manager
+     */
+    void WaitForAsyncCompilations();
+    
+    /**
+     * @brief Mark the end of an asynchronous compilation task
+     */
+    void EndAsyncCompilation();
+    
+    /**
+     * @brief Release all cached shaders and shader programs
+     */
+    void ReleaseAllShaders();
+    
+    /**
+     * @brief Start background reloads of the registered programs that depend on a file
      * @param filePath Path to changed shader file
      */
     void ReloadAffectedPrograms(const std::string& filePath);
     
     /**
-     * @brief Reload changed shaders
+     * @brief Compare the modification times of all tracked files, for platforms without a file watcher
+     * @return Changed files
      */
-    void ReloadChangedShaders();
+    std::vector<std::string> PollChangedFiles();
     
     /**
-     * @brief Create shader from source
-     * @param source Shader source
-     * @param options Compilation options
-     * @return Created shader pointer
+     * @brief Start recompiling a registered program from its files on the thread pool
+     * @param programName Program name
      */
-    LLGL::Shader* CreateShader(const ShaderSource& source, const ShaderCompileOptions& options);
+    void StartProgramReload(const std::string& programName);
     
     /**
-     * @brief Initialize built-in shaders
+     * @brief Replace registered programs whose background reload finished
+     * @return Number of programs replaced
      */
-    void InitializeBuiltInShaders();
+    std::size_t FinishProgramReloads();
     
     /**
-     * @brief Get built-in shader source
-     * @param name Shader name
-     * @return Shader source code
+     * @brief Track the files of a program for hot reload
+     * @param programName Program name
+     * @param sourceFiles Normalized stage and include files
      */
-    std::string GetBuiltInShader(const std::string& name) const;
+    void TrackProgramFiles(const std::string& programName, const std::vector<std::string>& sourceFiles);
     
     /**
-     * @brief Get all built-in shader names
-     * @return Vector of shader names
+     * @brief Release a program replaced by a reload through the release scheduler
+     * @param program Replaced program
      */
-    std::vector<std::string> GetBuiltInShaderNames() const;
+    void ReleaseReplacedProgram(CompiledShaderProgram program);
     
     /**
-     * @brief Set include resolver for shader preprocessing
-     * @param resolver Function to resolve include paths
+     * @brief Read the stage files of a program into a description; thread-safe
+     * @param programName Program name
+     * @param shaderFiles Map of shader types to file paths
+     * @param options Compilation options stored in the description
+     * @return Program description
+     * @throws std::runtime_error if a file cannot be read
      */
-    void SetIncludeResolver(IncludeResolver resolver);
+    ShaderProgramDesc MakeProgramDescFromFiles(const std::string& programName,
+                                               const std::unordered_map<ShaderType, std::string>& shaderFiles,
+                                               const ShaderCompileOptions& options) const;
+    
+    /**
+     * @brief Compile asynchronously with the description built on the worker
+     * @param makeDesc Function building the description, called on the thread pool
+     * @param options Compilation options
+     * @return Future for the compiled program
+     */
+    std::future<CompiledShaderProgram> StartAsyncCompilation(std::function<ShaderProgramDesc()> makeDesc,
+                                                             const ShaderCompileOptions& options);
+    
+    /**
+     * @brief Create shader from source
+     * @param source Shader source
+     * @param options Compilation options
+     * @return Created shader pointer
+     */
+    LLGL::Shader* CreateShader(const ShaderSource& source, const ShaderCompileOptions& options);
+    
+    /**
+     * @brief Initialize built-in shaders
+     */
+    void InitializeBuiltInShaders();
     
     /**
      * @brief Preprocess shader source
@@ -521,9 +937,11 @@ private:
      * @brief Process include directives in shader source
      * @param source Shader source code
      * @param currentPath Current file path for relative includes
+     * @param includedFiles Optional output of the normalized paths of all resolved includes
      * @return Processed source with includes resolved
      */
-    std::string ProcessIncludes(const std::string& source, const std::string& currentPath);
+    std::string ProcessIncludes(const std::string& source, const std::string& currentPath,
+                                std::vector<std::string>* includedFiles = nullptr);
     
     // === Private Members ===
     
@@ -535,21 +953,49 @@ private:
     
     // Caching
     bool cachingEnabled_;
-    std::unordered_map<std::string, CompiledShaderProgram> shaderCache_;
+    mutable std::mutex shaderCacheMutex_;      ///< Guards the program cache, also used by asynchronous compilations
+    std::unordered_map<ShaderHash, LLGL::PipelineState*, ShaderHashHasher> shaderCache_;  ///< Program key to shared program
+    std::unordered_map<LLGL::PipelineState*, SharedProgram> sharedPrograms_;
+    std::uint64_t programCacheHits_;
+    ShaderDiskCache diskCache_;
+    std::string backendId_;                    ///< Renderer/driver description mixed into disk cache keys
     
     // Hot reload
     bool hotReloadEnabled_;
-    std::unordered_map<std::string, std::unordered_map<ShaderType, std::string>> shaderFilePaths_;
+    std::unordered_map<std::string, ProgramFiles> programFileSources_;
     std::unordered_map<std::string, std::filesystem::file_time_type> fileModificationTimes_;
+    std::unordered_map<std::string, std::vector<std::string>> programFiles_;  ///< Normalized stage and include files per program
+    ShaderFileWatcher fileWatcher_;
+    std::vector<PendingReload> pendingReloads_;
+    ReleaseScheduler releaseScheduler_;
     
-    // Statistics
+    // Statistics, also written by asynchronous compilations
+    mutable std::mutex statsMutex_;
     std::unordered_map<std::string, double> compilationTimes_;
+    ShaderCompileTiming lastCompileTiming_;
+    
+    // Parallel compilation
+    ThreadPool* threadPool_;
+    bool parallelCreationEnabled_;
+    bool contextBoundBackend_;                 ///< Backend creates objects on the context thread only (OpenGL)
+    std::mutex creationMutex_;                 ///< Serializes this manager's LLGL object creation and release
+    std::deque<PendingCompilation> pendingCompilations_;
+    std::mutex asyncMutex_;
+    std::condition_variable asyncCondition_;
+    std::size_t asyncCompilations_;            ///< Pool tasks still referencing this manager
     
     // Built-in shaders
     std::unordered_map<std::string, std::string> builtInShaders_;
     
     // Include resolver for shader preprocessing
     IncludeResolver includeResolver_;
+    ShaderIncludeCache includeCache_;
+    
+    // Reflection results per preprocessed stage content, shared by programs and variants
+    mutable std::mutex reflectionMutex_;
+    std::unordered_map<ShaderHash, std::shared_ptr<const ShaderReflection>, ShaderHashHasher> reflectionCache_;
+    std::uint64_t reflectionHits_;
+    std::uint64_t reflectionMisses_;
 };
 
 } // namespace RenderingPlugin
\ No newline at end of file
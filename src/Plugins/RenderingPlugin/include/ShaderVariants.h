@@ -0,0 +1,200 @@
+/**
+ * @file ShaderVariants.h
+ * @brief Keyword-based shader permutations compiled on demand
+ * @details A variant set holds one program description and up to 64 feature keywords. A variant
+ *          is the program compiled with the keywords of a bitmask defined, and is looked up by
+ *          that mask instead of by a hash of its sources. Only variants that are requested or
+ *          listed for precompilation are compiled; until a requested variant is ready, lookups
+ *          return the fallback variant.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "ShaderManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Set of enabled keywords, bit i for keyword i
+ */
+using ShaderVariantMask = std::uint64_t;
+
+/**
+ * @brief Variant set statistics
+ */
+struct ShaderVariantStats {
+    std::size_t compiled = 0;          ///< Variants compiled successfully
+    std::size_t pending = 0;           ///< Variants still compiling
+    std::size_t failed = 0;            ///< Variants that failed to compile (served by the fallback)
+    std::uint64_t fallbackUses = 0;    ///< Lookups answered with the fallback variant
+    double compileTimeMs = 0.0;        ///< Time spent in synchronous compilation (fallback and precompile)
+};
+
+/**
+ * @brief Permutations of one shader program
+ * @details Not thread-safe; use it on the render thread. Asynchronous variants need the
+ *          ShaderManager's ProcessPendingCompilations() to be called as usual.
+ */
+class RENDERING_PLUGIN_API ShaderVariantSet {
+public:
+    /**
+     * @brief Maximum number of keywords
+     */
+    static constexpr std::size_t kMaxKeywords = 64;
+    
+    /**
+     * @brief Constructor
+     * @param shaderManager Manager that compiles the variants; must outlive the set
+     * @param baseDesc Program description shared by all variants; keywords are added to its defines
+     * @param keywords Feature keywords, at most kMaxKeywords; extra keywords are ignored
+     */
+    ShaderVariantSet(ShaderManager& shaderManager, const ShaderProgramDesc& baseDesc,
+                     const std::vector<std::string>& keywords);
+    
+    /**
+     * @brief Destructor, finishes pending variants and releases all compiled ones
+     */
+    ~ShaderVariantSet();
+    
+    ShaderVariantSet(const ShaderVariantSet&) = delete;
+    ShaderVariantSet& operator=(const ShaderVariantSet&) = delete;
+    
+    // === Keywords ===
+    
+    /**
+     * @brief Get the declared keywords
+     * @return Keywords in bit order
+     */
+    const std::vector<std::string>& GetKeywords() const;
+    
+    /**
+     * @brief Get the mask of one keyword
+     * @param keyword Keyword name
+     * @return Mask with the keyword's bit set, or 0 if the keyword is not declared
+     */
+    ShaderVariantMask GetKeywordMask(const std::string& keyword) const;
+    
+    /**
+     * @brief Build a mask from keyword names
+     * @param keywords Keyword names; undeclared names are ignored
+     * @return Variant mask
+     */
+    ShaderVariantMask MakeMask(const std::vector<std::string>& keywords) const;
+    
+    /**
+     * @brief Get a readable name of a variant, e.g. "lit[NORMAL_MAP|SKINNED]"
+     * @param mask Variant mask
+     * @return Program name of the variant
+     */
+    std::string GetVariantName(ShaderVariantMask mask) const;
+    
+    // === Variants ===
+    
+    /**
+     * @brief Set the variant served while a requested variant is not ready
+     * @details The fallback is compiled synchronously the first time it is needed. Default is 0,
+     *          the variant without keywords.
+     * @param mask Fallback variant mask
+     */
+    void SetFallbackVariant(ShaderVariantMask mask);
+    
+    /**
+     * @brief Get the fallback variant mask
+     * @return Fallback variant mask
+     */
+    ShaderVariantMask GetFallbackVariant() const;
+    
+    /**
+     * @brief Get a variant, starting its compilation on first request
+     * @param mask Variant mask; bits of undeclared keywords are ignored
+     * @return The variant if compiled, otherwise the fallback variant; nullptr if the fallback failed too
+     */
+    const CompiledShaderProgram* GetVariant(ShaderVariantMask mask);
+    
+    /**
+     * @brief Get a variant only if it is already compiled
+     * @param mask Variant mask
+     * @return Compiled variant, or nullptr
+     */
+    const CompiledShaderProgram* FindVariant(ShaderVariantMask mask) const;
+    
+    /**
+     * @brief Start compiling a variant asynchronously if it has not been requested yet
+     * @param mask Variant mask
+     */
+    void RequestVariant(ShaderVariantMask mask);
+    
+    /**
+     * @brief Compile variants synchronously as one parallel batch, e.g. from a list recorded in a previous run
+     * @param masks Variant masks; variants already requested are skipped
+     * @return Number of variants compiled successfully
+     */
+    std::size_t Precompile(const std::vector<ShaderVariantMask>& masks);
+    
+    /**
+     * @brief Collect finished asynchronous variants; call once per frame
+     * @return Number of variants that finished in this call
+     */
+    std::size_t Update();
+    
+    /**
+     * @brief Block until every requested variant has finished
+     * @details Pumps the ShaderManager's pending compilations, so it must run on the render thread.
+     */
+    void WaitForPendingVariants();
+    
+    /**
+     * @brief Get the masks of all variants requested so far
+     * @details Saved at shutdown, this is the precompile list of the next run.
+     * @return Requested variant masks, sorted
+     */
+    std::vector<ShaderVariantMask> GetRequestedVariants() const;
+    
+    /**
+     * @brief Get variant statistics
+     * @return Statistics
+     */
+    ShaderVariantStats GetStatistics() const;
+
+private:
+    /**
+     * @brief State of one variant
+     */
+    struct VariantEntry {
+        CompiledShaderProgram program;
+        std::future<CompiledShaderProgram> pending;
+        bool compiling = false;
+    };
+    
+    /**
+     * @brief Build the program description of a variant
+     */
+    ShaderProgramDesc MakeVariantDesc(ShaderVariantMask mask) const;
+    
+    /**
+     * @brief Store a finished compilation in its entry
+     */
+    void FinishVariant(ShaderVariantMask mask, VariantEntry& entry, CompiledShaderProgram program);
+    
+    /**
+     * @brief Compile the fallback variant synchronously if it has not been compiled yet
+     */
+    const CompiledShaderProgram* GetFallback();
+    
+    ShaderManager& shaderManager_;
+    ShaderProgramDesc baseDesc_;
+    std::vector<std::string> keywords_;
+    ShaderVariantMask keywordMask_;            ///< Bits of all declared keywords
+    ShaderVariantMask fallbackMask_;
+    std::unordered_map<ShaderVariantMask, VariantEntry> variants_;
+    ShaderVariantStats stats_;
+};
+
+} // namespace RenderingPlugin
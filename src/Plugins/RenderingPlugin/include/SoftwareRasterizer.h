@@ -0,0 +1,376 @@
+/**
+ * @file SoftwareRasterizer.h
+ * @brief Multithreaded CPU rasterizer for machines without a GPU render system
+ * @details Draws RenderObjects the way the default shader program does: vertices are transformed
+ *          and normals rotated by the world matrix, and every pixel is lit with one directional
+ *          light plus ambient. Vertex colors take the place of the diffuse texture.
+ *          Flush runs three parallel passes over the thread pool: vertex processing, triangle
+ *          clipping and setup with binning into 64x64 pixel tiles, and rasterization of whole
+ *          tiles with fixed-point edge functions and a depth test, four pixels at a time where
+ *          SSE2 is available. The image does not depend on the number of threads.
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include "RenderingSystem.h"
+#include "ResourceManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace RenderingPlugin {
+
+// Forward declarations
+class ThreadPool;
+
+/**
+ * @brief Light parameters of the default shader program
+ */
+struct SoftwareLighting {
+    Gs::Vector3f lightDirection = Gs::Vector3f(0.0f, -1.0f, 0.0f);  ///< Direction the light travels in
+    Gs::Vector3f lightColor = Gs::Vector3f(1.0f, 1.0f, 1.0f);        ///< Diffuse light color
+    Gs::Vector3f ambientColor = Gs::Vector3f(0.2f, 0.2f, 0.2f);      ///< Ambient light color
+};
+
+/**
+ * @brief Per-flush rasterizer statistics
+ */
+struct SoftwareRasterizerStats {
+    std::uint32_t drawCount = 0;            ///< Draws flushed
+    std::uint64_t trianglesSubmitted = 0;   ///< Triangles in the flushed draws
+    std::uint64_t trianglesRasterized = 0;  ///< Triangles left after clipping, culling and dropping empty ones
+    std::uint64_t pixelsWritten = 0;        ///< Pixels that passed the depth test
+    double vertexTimeMs = 0.0;              ///< Time spent transforming vertices
+    double setupTimeMs = 0.0;               ///< Time spent clipping, setting up and binning triangles
+    double rasterTimeMs = 0.0;              ///< Time spent rasterizing tiles
+};
+
+/**
+ * @brief Tile-binned CPU rasterizer with a color and a depth buffer
+ * @details Draws are recorded and executed by Flush. Not thread-safe; Flush must not be called
+ *          from a task of the thread pool it uses.
+ */
+class RENDERING_PLUGIN_API SoftwareRasterizer {
+public:
+    static constexpr int kTileSize = 64;     ///< Tile edge length in pixels
+    static constexpr int kMaxSize = 8192;    ///< Largest supported width and height
+    
+    /**
+     * @brief Constructor
+     * @param threadPool Worker threads, may be null to rasterize on the calling thread
+     */
+    explicit SoftwareRasterizer(ThreadPool* threadPool = nullptr);
+    
+    /**
+     * @brief Destructor
+     */
+    ~SoftwareRasterizer();
+    
+    // === Configuration ===
+    
+    /**
+     * @brief Resize the color and depth buffers
+     * @details Pending draws are flushed first. Resets the viewport to the whole image and
+     *          clears both buffers.
+     * @param width Width in pixels, 1 to kMaxSize
+     * @param height Height in pixels, 1 to kMaxSize
+     * @return true if the size is supported
+     */
+    bool Resize(int width, int height);
+    
+    /**
+     * @brief Get the image width
+     * @return Width in pixels
+     */
+    int GetWidth() const { return width_; }
+    
+    /**
+     * @brief Get the image height
+     * @return Height in pixels
+     */
+    int GetHeight() const { return height_; }
+    
+    /**
+     * @brief Set the viewport of subsequent draws
+     * @details Nothing is drawn outside the viewport or the image.
+     * @param x Left edge in pixels
+     * @param y Top edge in pixels
+     * @param width Width in pixels
+     * @param height Height in pixels
+     */
+    void SetViewport(int x, int y, int width, int height);
+    
+    /**
+     * @brief Set the worker threads
+     * @param threadPool Worker threads, may be null to rasterize on the calling thread
+     */
+    void SetThreadPool(ThreadPool* threadPool);
+    
+    /**
+     * @brief Set the light of subsequent draws
+     * @param lighting Light parameters
+     */
+    void SetLighting(const SoftwareLighting& lighting);
+    
+    /**
+     * @brief Get the light of subsequent draws
+     * @return Light parameters
+     */
+    const SoftwareLighting& GetLighting() const { return lighting_; }
+    
+    /**
+     * @brief Enable or disable culling of back faces
+     * @details Front faces are clockwise in normalized device coordinates, as in LLGL's default
+     *          rasterizer state. Disabled by default, as in the default pipeline state.
+     * @param enabled Whether counter-clockwise triangles are skipped
+     */
+    void SetBackFaceCulling(bool enabled);
+    
+    // === Buffers ===
+    
+    /**
+     * @brief Register the CPU copy of a vertex buffer
+     * @details The caller picks the ID; it must match the vertexBufferId of the RenderObjects that
+     *          should draw these vertices. No GPU buffer is involved, so meshes reach the CPU path
+     *          only through this call and SetIndexBuffer.
+     *          Pending draws are flushed first if the ID is already registered.
+     * @param id Vertex buffer ID
+     * @param vertices Vertices
+     */
+    void SetVertexBuffer(ResourceId id, std::vector<Vertex> vertices);
+    
+    /**
+     * @brief Register vertices shared with other rasterizers, without copying them
+     * @param id Vertex buffer ID
+     * @param vertices Vertices, must not be null
+     */
+    void SetVertexBuffer(ResourceId id, std::shared_ptr<const std::vector<Vertex>> vertices);
+    
+    /**
+     * @brief Register the CPU copy of an index buffer
+     * @details Pending draws are flushed first if the ID is already registered.
+     * @param id Index buffer ID
+     * @param indices Triangle list indices
+     */
+    void SetIndexBuffer(ResourceId id, std::vector<std::uint32_t> indices);
+    
+    /**
+     * @brief Register indices shared with other rasterizers, without copying them
+     * @param id Index buffer ID
+     * @param indices Triangle list indices, must not be null
+     */
+    void SetIndexBuffer(ResourceId id, std::shared_ptr<const std::vector<std::uint32_t>> indices);
+    
+    /**
+     * @brief Remove a registered vertex or index buffer
+     * @param id Buffer ID
+     */
+    void RemoveBuffer(ResourceId id);
+    
+    /**
+     * @brief Remove every registered vertex and index buffer
+     * @details Pending draws are flushed first. BatchRenderer calls this when it pools a
+     *          rasterizer, so idle ones do not keep the meshes of earlier jobs alive.
+     */
+    void RemoveAllBuffers();
+    
+    // === Drawing ===
+    
+    /**
+     * @brief Clear the color and depth buffers
+     * @details Pending draws are flushed first. The viewport does not limit the clear.
+     * @param color Clear color
+     * @param depth Clear depth
+     */
+    void Clear(const Color& color, float depth = 1.0f);
+    
+    /**
+     * @brief Record a draw of a render object with its own transform
+     * @param object Render object whose buffers are registered
+     * @return false if a buffer is not registered or the index range is out of bounds
+     */
+    bool Draw(const RenderObject& object);
+    
+    /**
+     * @brief Record a draw of a render object
+     * @param object Render object whose buffers are registered
+     * @param matrices World, view and projection matrices
+     * @return false if a buffer is not registered or the index range is out of bounds
+     */
+    bool Draw(const RenderObject& object, const Matrices& matrices);
+    
+    /**
+     * @brief Record a draw of vertices owned by the caller
+     * @details The arrays must stay alive until the next Flush. Triangles with an index past the
+     *          last vertex are skipped.
+     * @param vertices Vertices
+     * @param vertexCount Number of vertices
+     * @param indices Triangle list indices, or null to draw the vertices in order
+     * @param indexCount Number of indices, or of vertices to draw without indices
+     * @param matrices World, view and projection matrices
+     * @return false if the vertices are missing or fewer than drawn without indices
+     */
+    bool DrawMesh(const Vertex* vertices, std::size_t vertexCount, const std::uint32_t* indices,
+                  std::size_t indexCount, const Matrices& matrices);
+    
+    /**
+     * @brief Execute all recorded draws in submission order
+     */
+    void Flush();
+    
+    /**
+     * @brief Get the number of recorded draws not yet flushed
+     * @return Draw count
+     */
+    std::size_t GetPendingDrawCount() const { return draws_.size(); }
+    
+    // === Readback ===
+    
+    /**
+     * @brief Copy the image into a tightly packed RGBA8 array, top row first
+     * @param pixels Output, resized to width * height * 4 bytes
+     */
+    void ReadPixels(std::vector<std::uint8_t>& pixels) const;
+    
+    /**
+     * @brief Get one pixel of the image
+     * @param x Column
+     * @param y Row, 0 is the top
+     * @return Pixel as R | G << 8 | B << 16 | A << 24, 0 outside the image
+     */
+    std::uint32_t GetPixel(int x, int y) const;
+    
+    /**
+     * @brief Get one value of the depth buffer
+     * @param x Column
+     * @param y Row, 0 is the top
+     * @return Depth in [0, 1], 1 outside the image
+     */
+    float GetDepth(int x, int y) const;
+    
+    // === Statistics ===
+    
+    /**
+     * @brief Get statistics of the last flush
+     * @return Statistics
+     */
+    const SoftwareRasterizerStats& GetStatistics() const { return stats_; }
+
+private:
+    /**
+     * @brief A recorded draw
+     */
+    struct DrawCall {
+        const Vertex* vertices = nullptr;
+        std::size_t vertexCount = 0;
+        const std::uint32_t* indices = nullptr;   ///< Null for vertices in order
+        std::size_t indexCount = 0;
+        Matrices matrices;
+        SoftwareLighting lighting;
+        int viewport[4] = { 0, 0, 0, 0 };         ///< x, y, width, height
+        bool cullBackFaces = false;
+        std::size_t firstVertex = 0;              ///< Offset into the transformed vertices
+    };
+    
+    /**
+     * @brief A transformed vertex
+     */
+    struct ClipVertex {
+        float position[4];        ///< Clip space x, y, z, w
+        float normal[3];          ///< World space normal
+        float color[3];           ///< Vertex color
+        std::uint32_t outside;    ///< Bit per view volume plane the vertex is outside of
+        float invW;               ///< 1 / w, set for vertices inside the view volume
+        std::int32_t x;           ///< Column in 28.4 fixed point, set with invW
+        std::int32_t y;           ///< Row in 28.4 fixed point, set with invW
+    };
+    
+    static constexpr int kAttributeCount = 8;   ///< Depth, 1/w, normal / w, color / w
+    
+    /**
+     * @brief A triangle ready for rasterization
+     */
+    struct SetupTriangle {
+        std::int32_t x[3];                     ///< Vertex columns, 28.4 fixed point, ordered for a positive area
+        std::int32_t y[3];                     ///< Vertex rows, 28.4 fixed point
+        std::int32_t bounds[4];                ///< Covered pixels, min x, min y, max x, max y inclusive
+        float originX;                         ///< Position of vertex 0 in pixels
+        float originY;
+        float value[kAttributeCount];          ///< Attributes at vertex 0
+        float ddx[kAttributeCount];            ///< Attribute change per pixel to the right
+        float ddy[kAttributeCount];            ///< Attribute change per pixel down
+    };
+    
+    /**
+     * @brief Triangles set up by one task, binned by tile
+     */
+    struct SetupBatch {
+        std::size_t draw = 0;                        ///< Draw the triangles come from
+        std::size_t firstTriangle = 0;
+        std::size_t endTriangle = 0;
+        std::vector<SetupTriangle> triangles;
+        std::vector<std::uint32_t> binOffsets;       ///< Per tile start in binTriangles, tile count + 1 entries
+        std::vector<std::uint32_t> binTriangles;     ///< Triangle indices grouped by tile
+        std::vector<std::uint32_t> binCursor;        ///< Scratch for filling the bins
+    };
+    
+    /**
+     * @brief Run func(begin, end, chunk) over count items on the thread pool or inline
+     */
+    template <typename Func>
+    void RunParallel(std::size_t count, std::size_t chunkCount, Func&& func);
+    
+    void TransformVertices();
+    void SetupTriangles();
+    void RasterizeTiles();
+    
+    /**
+     * @brief Clip a triangle and append the resulting triangles of the batch
+     */
+    void ClipTriangle(const DrawCall& draw, const ClipVertex* const vertices[3],
+                      std::vector<SetupTriangle>& output) const;
+    
+    /**
+     * @brief Compute the snapped viewport position of a vertex inside the view volume
+     */
+    static void ProjectVertex(const int viewport[4], ClipVertex& vertex);
+    
+    /**
+     * @brief Cull and set up one projected triangle
+     */
+    void AddTriangle(const DrawCall& draw, const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2,
+                     std::vector<SetupTriangle>& output) const;
+    
+    /**
+     * @brief Rasterize the part of a triangle inside one tile
+     * @return Number of pixels written
+     */
+    std::uint64_t RasterizeTriangle(const SetupTriangle& triangle, const SoftwareLighting& lighting,
+                                    int tileX, int tileY);
+    
+    ThreadPool* threadPool_;
+    int width_ = 0;
+    int height_ = 0;
+    int stride_ = 0;                   ///< Row pitch of the buffers, a multiple of kTileSize
+    int tilesX_ = 0;
+    int tilesY_ = 0;
+    int viewport_[4] = { 0, 0, 0, 0 };
+    bool cullBackFaces_ = false;
+    SoftwareLighting lighting_;
+    
+    std::vector<std::uint32_t> color_;   ///< RGBA8 pixels, padded to whole tiles
+    std::vector<float> depth_;           ///< Depth values, padded to whole tiles
+    
+    std::unordered_map<ResourceId, std::shared_ptr<const std::vector<Vertex>>> vertexBuffers_;
+    std::unordered_map<ResourceId, std::shared_ptr<const std::vector<std::uint32_t>>> indexBuffers_;
+    
+    std::vector<DrawCall> draws_;
+    std::vector<ClipVertex> clipVertices_;
+    std::vector<SetupBatch> batches_;
+    SoftwareRasterizerStats stats_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,108 @@
+/**
+ * @file ThreadPool.h
+ * @brief Fixed-size worker thread pool
+ * @details Shared by rendering components for parallel command recording and CPU-side processing
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief Fixed-size worker thread pool
+ * @details Tasks are executed in FIFO order by a fixed set of worker threads.
+ *          Tasks must not block on other tasks of the same pool.
+ */
+class RENDERING_PLUGIN_API ThreadPool {
+public:
+    /**
+     * @brief Constructor
+     * @param threadCount Number of worker threads, 0 to use the hardware concurrency
+     */
+    explicit ThreadPool(std::size_t threadCount = 0);
+    
+    /**
+     * @brief Destructor, finishes queued tasks and joins all workers
+     */
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * @brief Get number of worker threads
+     * @return Worker thread count
+     */
+    std::size_t GetThreadCount() const;
+    
+    /**
+     * @brief Queue a task for execution
+     * @param task Callable without arguments
+     * @return Future for the task result
+     */
+    template <typename Task>
+    auto Enqueue(Task&& task) -> std::future<std::invoke_result_t<std::decay_t<Task>>>;
+    
+    /**
+     * @brief Split a range into chunks and process them in parallel
+     * @details The calling thread processes the first chunk itself and returns once all chunks are done.
+     *          Must not be called from a task running on this pool.
+     * @param count Number of items in the range
+     * @param func Function called with (begin, end, chunkIndex) for each chunk
+     * @param chunkCount Number of chunks, 0 for one chunk per worker thread
+     */
+    void ParallelFor(std::size_t count,
+                     const std::function<void(std::size_t, std::size_t, std::size_t)>& func,
+                     std::size_t chunkCount = 0);
+    
+    /**
+     * @brief Block until all queued tasks have finished
+     */
+    void WaitIdle();
+
+private:
+    /**
+     * @brief Worker thread main loop
+     */
+    void WorkerLoop();
+    
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable taskCondition_;
+    std::condition_variable idleCondition_;
+    std::size_t activeTasks_;
+    bool stopping_;
+};
+
+// === Template Implementation ===
+
+template <typename Task>
+auto ThreadPool::Enqueue(Task&& task) -> std::future<std::invoke_result_t<std::decay_t<Task>>> {
+    using Result = std::invoke_result_t<std::decay_t<Task>>;
+    
+    auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+    std::future<Result> result = packagedTask->get_future();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.emplace([packagedTask]() { (*packagedTask)(); });
+    }
+    taskCondition_.notify_one();
+    
+    return result;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,205 @@
+/**
+ * @file UploadAllocator.h
+ * @brief Transient per-frame upload allocator for dynamic buffer data
+ * @details Per-draw constants and other short-lived data are sub-allocated with a bump pointer
+ *          from one large buffer per frame in flight. Allocations are written into a CPU-side
+ *          staging copy and reach the GPU with a single buffer write per frame in Flush().
+ */
+
+#pragma once
+
+#include "RenderingPluginExport.h"
+#include <LLGL/LLGL.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RenderingPlugin {
+
+/**
+ * @brief A sub-allocation of the current frame's upload buffer
+ */
+struct UploadAllocation {
+    LLGL::Buffer* buffer = nullptr;  ///< Upload buffer of the current frame
+    std::uint64_t offset = 0;        ///< Byte offset of the allocation in buffer
+    std::uint64_t size = 0;          ///< Requested size in bytes
+    void* data = nullptr;            ///< CPU address to write the allocation's contents to
+    
+    /**
+     * @brief Check if the allocation succeeded
+     * @return true if data can be written, false if the frame's buffer is exhausted
+     */
+    bool IsValid() const { return data != nullptr; }
+};
+
+/**
+ * @brief Upload allocator statistics for the current frame
+ */
+struct UploadAllocatorStats {
+    std::uint32_t allocations = 0;    ///< Sub-allocations this frame
+    std::uint32_t failedAllocations = 0;  ///< Allocations rejected because the buffer was full
+    std::uint64_t bytesAllocated = 0; ///< Requested bytes
+    std::uint64_t bytesPadding = 0;   ///< Bytes lost to alignment
+    std::uint64_t bytesFlushed = 0;   ///< Bytes written to the GPU by Flush()
+    std::uint32_t bufferWrites = 0;   ///< Buffer writes issued by Flush()
+};
+
+/**
+ * @brief Linear per-frame upload allocator
+ * @details Usage per frame: BeginFrame(frameIndex), Allocate/Upload while recording, then Flush()
+ *          before the command buffer is submitted. Allocations are only valid until the same
+ *          frame slot begins again. Not thread-safe.
+ */
+class RENDERING_PLUGIN_API UploadAllocator {
+public:
+    /**
+     * @brief Constructor
+     * @param renderSystem LLGL render system used to create the upload buffers
+     * @param capacityPerFrame Size of each frame's upload buffer in bytes
+     * @param framesInFlight Number of upload buffers (see RenderingSystem::GetFramesInFlight)
+     * @param bindFlags How the upload buffers are bound (constant and vertex buffer by default)
+     */
+    UploadAllocator(LLGL::RenderSystem* renderSystem, std::uint64_t capacityPerFrame,
+                    std::uint32_t framesInFlight = 2,
+                    long bindFlags = LLGL::BindFlags::ConstantBuffer | LLGL::BindFlags::VertexBuffer);
+    
+    /**
+     * @brief Destructor
+     */
+    ~UploadAllocator();
+    
+    UploadAllocator(const UploadAllocator&) = delete;
+    UploadAllocator& operator=(const UploadAllocator&) = delete;
+    
+    /**
+     * @brief Start allocating from a frame slot's buffer
+     * @details The caller guarantees the GPU has finished the frame that last used this slot
+     *          (RenderingSystem::BeginFrame waits on the slot's fence).
+     * @param frameIndex Frame-in-flight slot
+     */
+    void BeginFrame(std::uint32_t frameIndex);
+    
+    /**
+     * @brief Sub-allocate from the current frame's buffer
+     * @param size Size in bytes
+     * @param alignment Offset alignment in bytes, 0 for the constant buffer alignment
+     * @return Allocation, invalid if the frame's buffer is exhausted
+     */
+    UploadAllocation Allocate(std::uint64_t size, std::uint64_t alignment = 0);
+    
+    /**
+     * @brief Sub-allocate and copy data in one step
+     * @param data Source data
+     * @param size Size in bytes
+     * @param alignment Offset alignment in bytes, 0 for the constant buffer alignment
+     * @return Allocation, invalid if the frame's buffer is exhausted
+     */
+    UploadAllocation Upload(const void* data, std::uint64_t size, std::uint64_t alignment = 0);
+    
+    /**
+     * @brief Write all allocations of the current frame to the GPU
+     * @details Issues one buffer write covering every allocation made since BeginFrame.
+     *          Must be called before the frame's command buffer is submitted.
+     */
+    void Flush();
+    
+    /**
+     * @brief Get a resource heap whose descriptor sets view consecutive blocks of the current buffer
+     * @details Offset binding for constant buffers: an allocation made with alignment
+     *          GetBlockStride(blockSize) is bound with SetResourceHeap(heap, GetBlockIndex(...)).
+     *          The pipeline layout must have a single heap binding (the constant buffer).
+     *          Heaps are created on first use and cached per frame slot.
+     * @param pipelineLayout Pipeline layout with one constant buffer heap binding
+     * @param blockSize Size of the constant buffer block in bytes
+     * @return Resource heap, or nullptr on failure
+     */
+    LLGL::ResourceHeap* GetBlockHeap(LLGL::PipelineLayout* pipelineLayout, std::uint64_t blockSize);
+    
+    /**
+     * @brief Get the distance between consecutive blocks of a block heap
+     * @param blockSize Size of the constant buffer block in bytes
+     * @return blockSize rounded up to the constant buffer alignment
+     */
+    std::uint64_t GetBlockStride(std::uint64_t blockSize) const;
+    
+    /**
+     * @brief Get the descriptor set of a block heap that views an allocation
+     * @param allocation Allocation made with alignment GetBlockStride(blockSize)
+     * @param blockSize Size of the constant buffer block in bytes
+     * @return Descriptor set index
+     */
+    std::uint32_t GetBlockIndex(const UploadAllocation& allocation, std::uint64_t blockSize) const;
+    
+    /**
+     * @brief Check if a block heap can be bound while a material heap stays bound
+     * @details OpenGL and Direct3D 11 bind heaps slot by slot, so a block heap only replaces its
+     *          own slot, and the Null renderer binds nothing. On Vulkan, Direct3D 12 and Metal a
+     *          heap is the descriptor set of a pipeline layout, so binding a block heap of another
+     *          layout replaces the material heap's textures and samplers.
+     * @param rendererName Renderer name as in LLGL::RendererInfo
+     * @return true for OpenGL, OpenGL ES, WebGL, Direct3D 11 and the Null renderer
+     */
+    static bool SupportsBlockBinding(const std::string& rendererName);
+    
+    /**
+     * @brief Check if this allocator's render system supports block binding
+     * @return SupportsBlockBinding() for the render system's renderer name
+     */
+    bool SupportsBlockBinding() const;
+    
+    /**
+     * @brief Get the upload buffer of the current frame
+     * @return Upload buffer, or nullptr if not available
+     */
+    LLGL::Buffer* GetBuffer() const;
+    
+    /**
+     * @brief Get the capacity of each frame's buffer
+     * @return Capacity in bytes
+     */
+    std::uint64_t GetCapacity() const;
+    
+    /**
+     * @brief Get the bytes used in the current frame, including alignment padding
+     * @return Used bytes
+     */
+    std::uint64_t GetUsedBytes() const;
+    
+    /**
+     * @brief Get the default (constant buffer) alignment
+     * @return Alignment in bytes
+     */
+    std::uint64_t GetAlignment() const;
+    
+    /**
+     * @brief Get statistics of the current frame
+     * @return Upload allocator statistics
+     */
+    const UploadAllocatorStats& GetStatistics() const;
+
+private:
+    /**
+     * @brief Upload buffer and staging memory of one frame slot
+     */
+    struct FrameBuffer {
+        LLGL::Buffer* buffer = nullptr;
+        std::vector<std::uint8_t> staging;
+        std::map<std::pair<LLGL::PipelineLayout*, std::uint64_t>, LLGL::ResourceHeap*> blockHeaps;  ///< (layout, block size) -> heap
+    };
+    
+    LLGL::RenderSystem* renderSystem_;
+    std::uint64_t capacity_;
+    std::uint64_t alignment_;
+    
+    std::vector<FrameBuffer> frames_;
+    std::uint32_t frameIndex_;
+    std::uint64_t cursor_;
+    std::uint64_t flushedBytes_;
+    
+    UploadAllocatorStats stats_;
+};
+
+} // namespace RenderingPlugin
@@ -0,0 +1,390 @@
+/**
+ * @file AsyncResourceLoader.cpp
+ * @brief Implementation of AsyncResourceLoader class
+ */
+
+#include "../include/AsyncResourceLoader.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace RenderingPlugin {
+
+namespace {
+
+bool ReadFileBytes(const std::string& filename, std::vector<std::uint8_t>& data) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * @brief Read the next whitespace-separated PPM header field, skipping comments
+ */
+bool ReadPpmField(const std::vector<std::uint8_t>& data, std::size_t& pos, std::uint32_t& value) {
+    while (pos < data.size()) {
+        if (data[pos] == '#') {
+            while (pos < data.size() && data[pos] != '\n') {
+                ++pos;
+            }
+        } else if (std::isspace(data[pos])) {
+            ++pos;
+        } else {
+            break;
+        }
+    }
+    
+    if (pos >= data.size() || !std::isdigit(data[pos])) {
+        return false;
+    }
+    
+    value = 0;
+    while (pos < data.size() && std::isdigit(data[pos])) {
+        value = value * 10 + static_cast<std::uint32_t>(data[pos] - '0');
+        ++pos;
+    }
+    return true;
+}
+
+/**
+ * @brief Decode binary PPM (P6, 8 bits per channel) to RGBA8
+ */
+bool DecodePpm(const std::vector<std::uint8_t>& data, DecodedImage& image) {
+    if (data.size() < 2 || data[0] != 'P' || data[1] != '6') {
+        return false;
+    }
+    
+    std::size_t pos = 2;
+    std::uint32_t width = 0, height = 0, maxValue = 0;
+    if (!ReadPpmField(data, pos, width) || !ReadPpmField(data, pos, height) ||
+        !ReadPpmField(data, pos, maxValue) || maxValue != 255 || width == 0 || height == 0) {
+        return false;
+    }
+    
+    // Exactly one whitespace byte separates the header from the pixel data
+    ++pos;
+    const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+    if (pos > data.size() || data.size() - pos < pixelCount * 3) {
+        return false;
+    }
+    
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(pixelCount * 4);
+    const std::uint8_t* src = data.data() + pos;
+    std::uint8_t* dst = image.pixels.data();
+    for (std::size_t i = 0; i < pixelCount; ++i) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+    return true;
+}
+
+} // namespace
+
+// === AsyncResourceLoader Implementation ===
+
+AsyncResourceLoader::AsyncResourceLoader(ResourceManager* resourceManager, std::size_t workerCount)
+    : resourceManager_(resourceManager)
+    , placeholderTexture_(0)
+    , requests_(static_cast<std::uint8_t>(ResourceKind::LoadRequest))
+    , nextSequence_(0)
+    , decoder_(DecodePpm) {
+    
+    if (resourceManager_) {
+        const std::uint32_t whitePixels[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+        placeholderTexture_ = resourceManager_->CreateTexture2D(2, 2, LLGL::Format::RGBA8UNorm, whitePixels);
+    }
+    
+    workers_.reset(new ThreadPool(std::max<std::size_t>(1, workerCount)));
+    
+    std::cout << "AsyncResourceLoader initialized with " << workers_->GetThreadCount() << " workers" << std::endl;
+}
+
+AsyncResourceLoader::~AsyncResourceLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const RequestPtr& request : queued_) {
+            request->cancelled = true;
+        }
+        queued_.clear();
+        completed_.clear();
+    }
+    
+    // Join the workers before the queues they use go away
+    workers_.reset();
+    
+    if (placeholderTexture_ != 0) {
+        resourceManager_->ReleaseTexture(placeholderTexture_);
+    }
+    
+    std::cout << "AsyncResourceLoader destroyed" << std::endl;
+}
+
+// === Requests ===
+
+LoadHandle AsyncResourceLoader::LoadTexture(const std::string& filename, int priority) {
+    RequestPtr request = std::make_shared<LoadRequest>();
+    request->type = RequestType::Texture;
+    request->filename = filename;
+    request->priority = priority;
+    return Submit(std::move(request));
+}
+
+LoadHandle AsyncResourceLoader::LoadShader(LLGL::ShaderType type, const std::string& filename,
+                                           const std::string& entryPoint, int priority) {
+    RequestPtr request = std::make_shared<LoadRequest>();
+    request->type = RequestType::Shader;
+    request->filename = filename;
+    request->entryPoint = entryPoint;
+    request->shaderType = type;
+    request->priority = priority;
+    return Submit(std::move(request));
+}
+
+bool AsyncResourceLoader::SetPriority(LoadHandle handle, int priority) {
+    RequestPtr* request = requests_.Get(handle);
+    if (!request) {
+        return false;
+    }
+    
+    // Workers read the priority under the lock when picking the next request
+    std::lock_guard<std::mutex> lock(mutex_);
+    (*request)->priority = priority;
+    return true;
+}
+
+bool AsyncResourceLoader::Cancel(LoadHandle handle) {
+    RequestPtr* request = requests_.Get(handle);
+    if (!request) {
+        return false;
+    }
+    
+    const LoadState state = (*request)->state;
+    if (state == LoadState::Ready || state == LoadState::Failed || state == LoadState::Cancelled) {
+        return false;
+    }
+    
+    // Workers and Update() drop cancelled requests when they reach them
+    (*request)->cancelled = true;
+    (*request)->state = LoadState::Cancelled;
+    stats_.cancelled++;
+    return true;
+}
+
+void AsyncResourceLoader::Release(LoadHandle handle) {
+    RequestPtr request;
+    if (!requests_.Erase(handle, &request)) {
+        return;
+    }
+    
+    if (request->state == LoadState::Ready && request->resourceId != 0) {
+        if (request->type == RequestType::Texture) {
+            resourceManager_->ReleaseTexture(request->resourceId);
+        } else {
+            resourceManager_->ReleaseShader(request->resourceId);
+        }
+    } else if (request->state != LoadState::Failed && request->state != LoadState::Cancelled) {
+        request->cancelled = true;
+        request->state = LoadState::Cancelled;
+        stats_.cancelled++;
+    }
+}
+
+// === Frame Processing ===
+
+std::size_t AsyncResourceLoader::Update(std::uint64_t uploadBudgetBytes) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    std::vector<RequestPtr> completed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed.swap(completed_);
+        
+        // Requests decoded this frame compete with leftovers from earlier frames by priority
+        std::stable_sort(completed.begin(), completed.end(), [](const RequestPtr& a, const RequestPtr& b) {
+            return a->priority > b->priority;
+        });
+    }
+    
+    std::size_t created = 0;
+    std::uint64_t bytes = 0;
+    std::size_t index = 0;
+    for (; index < completed.size(); ++index) {
+        LoadRequest& request = *completed[index];
+        if (request.cancelled) {
+            continue;
+        }
+        
+        const std::uint64_t size = (request.type == RequestType::Texture) ? request.image.pixels.size() : request.source.size();
+        if (created > 0 && bytes + size > uploadBudgetBytes) {
+            break;
+        }
+        
+        CreateResource(request);
+        bytes += size;
+        created++;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_.insert(completed_.begin(), completed.begin() + index, completed.end());
+        stats_.queued = queued_.size();
+        stats_.awaitingCreation = completed_.size();
+    }
+    
+    stats_.createdLastUpdate = static_cast<std::uint32_t>(created);
+    stats_.bytesLastUpdate = bytes;
+    stats_.lastUpdateMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    
+    return created;
+}
+
+void AsyncResourceLoader::WaitIdle() {
+    workers_->WaitIdle();
+}
+
+// === Access ===
+
+LoadState AsyncResourceLoader::GetState(LoadHandle handle) const {
+    const RequestPtr* request = requests_.Get(handle);
+    return request ? (*request)->state.load() : LoadState::Failed;
+}
+
+ResourceId AsyncResourceLoader::GetResourceId(LoadHandle handle) const {
+    const RequestPtr* request = requests_.Get(handle);
+    if (!request) {
+        return 0;
+    }
+    
+    if ((*request)->state == LoadState::Ready) {
+        return (*request)->resourceId;
+    }
+    return ((*request)->type == RequestType::Texture) ? placeholderTexture_ : 0;
+}
+
+ResourceId AsyncResourceLoader::GetPlaceholderTexture() const {
+    return placeholderTexture_;
+}
+
+void AsyncResourceLoader::SetImageDecoder(ImageDecoder decoder) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    decoder_ = decoder ? std::move(decoder) : ImageDecoder(DecodePpm);
+}
+
+const AsyncLoaderStats& AsyncResourceLoader::GetStatistics() const {
+    return stats_;
+}
+
+// === Private Methods ===
+
+LoadHandle AsyncResourceLoader::Submit(RequestPtr request) {
+    LoadHandle handle = requests_.Insert(request);
+    if (handle == 0) {
+        std::cerr << "Load request limit reached" << std::endl;
+        return 0;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        request->sequence = nextSequence_++;
+        queued_.push_back(request);
+    }
+    stats_.requested++;
+    
+    // One task per request; each task takes whichever queued request has the highest priority
+    workers_->Enqueue([this]() { ProcessNext(); });
+    return handle;
+}
+
+void AsyncResourceLoader::ProcessNext() {
+    RequestPtr request;
+    ImageDecoder decoder;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Drop cancelled requests, then pick the highest priority (oldest first on ties)
+        queued_.erase(std::remove_if(queued_.begin(), queued_.end(), [](const RequestPtr& queued) {
+            return queued->cancelled.load();
+        }), queued_.end());
+        
+        if (queued_.empty()) {
+            return;
+        }
+        
+        auto next = std::max_element(queued_.begin(), queued_.end(), [](const RequestPtr& a, const RequestPtr& b) {
+            return (a->priority != b->priority) ? a->priority < b->priority : a->sequence > b->sequence;
+        });
+        request = *next;
+        queued_.erase(next);
+        decoder = decoder_;
+    }
+    
+    LoadState expected = LoadState::Placeholder;
+    if (!request->state.compare_exchange_strong(expected, LoadState::Loading)) {
+        return;
+    }
+    
+    std::vector<std::uint8_t> fileData;
+    if (ReadFileBytes(request->filename, fileData)) {
+        if (request->type == RequestType::Texture) {
+            request->decoded = decoder(fileData, request->image);
+        } else {
+            request->source.assign(fileData.begin(), fileData.end());
+            request->decoded = true;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.push_back(std::move(request));
+}
+
+void AsyncResourceLoader::CreateResource(LoadRequest& request) {
+    if (!request.decoded) {
+        std::cerr << "Failed to load " << request.filename << std::endl;
+        request.state = LoadState::Failed;
+        stats_.failed++;
+        return;
+    }
+    
+    if (!resourceManager_) {
+        // CPU-only use: the request is done once it is decoded
+        request.image.pixels = std::vector<std::uint8_t>();
+        request.source = std::string();
+        request.state = LoadState::Ready;
+        stats_.completed++;
+        return;
+    }
+    
+    if (request.type == RequestType::Texture) {
+        request.resourceId = resourceManager_->CreateTexture2D(static_cast<int>(request.image.width),
+                                                               static_cast<int>(request.image.height),
+                                                               LLGL::Format::RGBA8UNorm, request.image.pixels.data());
+    } else {
+        request.resourceId = resourceManager_->CreateShader(request.shaderType, request.source, request.entryPoint);
+    }
+    
+    // The decoded data is no longer needed once the GPU owns a copy
+    request.image.pixels = std::vector<std::uint8_t>();
+    request.source = std::string();
+    
+    if (request.resourceId == 0) {
+        request.state = LoadState::Failed;
+        stats_.failed++;
+        return;
+    }
+    
+    request.state = LoadState::Ready;
+    stats_.completed++;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,560 @@
+/**
+ * @file BatchRenderer.cpp
+ * @brief Implementation of BatchRenderer class
+ */
+
+#include "../include/BatchRenderer.h"
+#include "../include/RenderCommands.h"
+#include "../include/ThreadPool.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace RenderingPlugin {
+
+namespace {
+
+// Row pitch alignment required for texture-to-buffer copies on Direct3D 12; harmless elsewhere
+constexpr std::uint32_t kRowPitchAlignment = 256;
+
+constexpr std::size_t kDefaultMaxIdleTargets = 16;
+
+} // namespace
+
+// === BatchRenderer Implementation ===
+
+BatchRenderer::BatchRenderer(ThreadPool* threadPool)
+    : backend_(BatchBackend::Software)
+    , threadPool_(threadPool)
+    , renderSystem_(nullptr)
+    , resourceManager_(nullptr)
+    , pendingJobs_(0)
+    , maxIdleTargets_(kDefaultMaxIdleTargets) {
+    
+    if (!threadPool_) {
+        throw std::invalid_argument("ThreadPool cannot be null");
+    }
+}
+
+BatchRenderer::BatchRenderer(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager,
+                             std::uint32_t maxJobsInFlight)
+    : backend_(BatchBackend::Device)
+    , threadPool_(nullptr)
+    , renderSystem_(renderSystem)
+    , resourceManager_(resourceManager)
+    , pendingJobs_(0)
+    , maxIdleTargets_(kDefaultMaxIdleTargets) {
+    
+    if (!renderSystem_ || !resourceManager_) {
+        throw std::invalid_argument("RenderSystem and ResourceManager cannot be null");
+    }
+    if (maxJobsInFlight == 0) {
+        throw std::invalid_argument("BatchRenderer needs at least one job in flight");
+    }
+    
+    slots_.resize(maxJobsInFlight);
+    for (DeviceSlot& slot : slots_) {
+        slot.commandBuffer = renderSystem_->CreateCommandBuffer();
+        // Without a fence a job is only delivered after waiting for the whole queue
+        slot.fence = renderSystem_->CreateFence();
+        if (!slot.commandBuffer) {
+            for (DeviceSlot& created : slots_) {
+                if (created.fence) {
+                    renderSystem_->Release(*created.fence);
+                }
+                if (created.commandBuffer) {
+                    renderSystem_->Release(*created.commandBuffer);
+                }
+            }
+            throw std::runtime_error("Failed to create batch command buffers");
+        }
+    }
+    
+    // Each slot records into its own command buffer and instance stream
+    commands_ = std::make_unique<RenderCommands>(slots_.front().commandBuffer, resourceManager_);
+}
+
+BatchRenderer::~BatchRenderer() {
+    WaitIdle();
+    ReleaseIdleTargets();
+    
+    commands_.reset();
+    for (DeviceSlot& slot : slots_) {
+        if (slot.fence) {
+            renderSystem_->Release(*slot.fence);
+        }
+        if (slot.commandBuffer) {
+            renderSystem_->Release(*slot.commandBuffer);
+        }
+    }
+}
+
+BatchBackend BatchRenderer::GetBackend() const {
+    return backend_;
+}
+
+// === Scene Data ===
+
+void BatchRenderer::SetVertexBuffer(ResourceId id, std::vector<Vertex> vertices) {
+    auto shared = std::make_shared<const std::vector<Vertex>>(std::move(vertices));
+    std::lock_guard<std::mutex> lock(mutex_);
+    vertexBuffers_[id] = std::move(shared);
+}
+
+void BatchRenderer::SetIndexBuffer(ResourceId id, std::vector<std::uint32_t> indices) {
+    auto shared = std::make_shared<const std::vector<std::uint32_t>>(std::move(indices));
+    std::lock_guard<std::mutex> lock(mutex_);
+    indexBuffers_[id] = std::move(shared);
+}
+
+void BatchRenderer::SetLighting(const SoftwareLighting& lighting) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lighting_ = lighting;
+}
+
+void BatchRenderer::SetMatrixBuffer(ResourceId constantBufferId) {
+    if (!commands_) {
+        std::cerr << "Matrix buffers are only used by the device backend" << std::endl;
+        return;
+    }
+    commands_->SetMatrixBuffer(constantBufferId);
+}
+
+// === Jobs ===
+
+std::future<BatchRenderResult> BatchRenderer::Submit(BatchRenderJob job) {
+    std::future<BatchRenderResult> future;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PendingJob pending;
+        pending.job = std::move(job);
+        future = pending.promise.get_future();
+        queue_.push_back(std::move(pending));
+        ++pendingJobs_;
+        ++stats_.jobsSubmitted;
+    }
+    
+    // One task per job: whichever worker runs it takes the oldest queued job
+    if (backend_ == BatchBackend::Software) {
+        threadPool_->Enqueue([this] { RenderNextSoftwareJob(); });
+    }
+    return future;
+}
+
+std::size_t BatchRenderer::Update() {
+    if (backend_ != BatchBackend::Device) {
+        return 0;
+    }
+    
+    std::size_t delivered = 0;
+    while (FinishDeviceJob(false)) {
+        ++delivered;
+    }
+    
+    // A job failing before submission leaves its slot free for the next one
+    for (std::size_t i = 0; i < slots_.size(); ) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.empty()) {
+                break;
+            }
+        }
+        if (slots_[i].target) {
+            ++i;
+            continue;
+        }
+        StartDeviceJob(i);
+        if (slots_[i].target) {
+            ++i;
+        }
+    }
+    return delivered;
+}
+
+void BatchRenderer::WaitIdle() {
+    if (backend_ == BatchBackend::Software) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idleCondition_.wait(lock, [this] { return pendingJobs_ == 0; });
+        return;
+    }
+    
+    Update();
+    while (!runningSlots_.empty()) {
+        FinishDeviceJob(true);
+        Update();
+    }
+}
+
+std::size_t BatchRenderer::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pendingJobs_;
+}
+
+void BatchRenderer::RenderNextSoftwareJob() {
+    PendingJob pending;
+    SoftwareLighting lighting;
+    std::vector<std::pair<ResourceId, std::shared_ptr<const std::vector<Vertex>>>> vertexBuffers;
+    std::vector<std::pair<ResourceId, std::shared_ptr<const std::vector<std::uint32_t>>>> indexBuffers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return;
+        }
+        pending = std::move(queue_.front());
+        queue_.pop_front();
+        
+        // Snapshot the meshes so later SetVertexBuffer calls do not affect this job
+        lighting = lighting_;
+        for (const RenderObject& object : pending.job.objects) {
+            auto vertices = vertexBuffers_.find(object.vertexBufferId);
+            if (vertices != vertexBuffers_.end()) {
+                vertexBuffers.emplace_back(vertices->first, vertices->second);
+            }
+            auto indices = indexBuffers_.find(object.indexBufferId);
+            if (indices != indexBuffers_.end()) {
+                indexBuffers.emplace_back(indices->first, indices->second);
+            }
+        }
+    }
+    
+    const BatchRenderJob& job = pending.job;
+    BatchRenderResult result;
+    result.width = job.width;
+    result.height = job.height;
+    
+    std::unique_ptr<SoftwareRasterizer> rasterizer = AcquireRasterizer(job.width, job.height);
+    if (rasterizer) {
+        rasterizer->SetLighting(lighting);
+        for (auto& buffer : vertexBuffers) {
+            rasterizer->SetVertexBuffer(buffer.first, std::move(buffer.second));
+        }
+        for (auto& buffer : indexBuffers) {
+            rasterizer->SetIndexBuffer(buffer.first, std::move(buffer.second));
+        }
+        
+        rasterizer->Clear(job.clearColor);
+        result.success = true;
+        for (const RenderObject& object : job.objects) {
+            result.success = rasterizer->Draw(object) && result.success;
+        }
+        rasterizer->Flush();
+        rasterizer->ReadPixels(result.pixels);
+        ReleaseRasterizer(std::move(rasterizer));
+    }
+    
+    const bool success = result.success;
+    pending.promise.set_value(std::move(result));
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.jobsCompleted;
+    if (!success) {
+        ++stats_.jobsFailed;
+    }
+    if (--pendingJobs_ == 0) {
+        idleCondition_.notify_all();
+    }
+}
+
+void BatchRenderer::StartDeviceJob(std::size_t slotIndex) {
+    PendingJob pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return;
+        }
+        pending = std::move(queue_.front());
+        queue_.pop_front();
+    }
+    
+    const BatchRenderJob& job = pending.job;
+    std::unique_ptr<DeviceTarget> target = AcquireDeviceTarget(job.width, job.height);
+    if (!target) {
+        BatchRenderResult result;
+        result.width = job.width;
+        result.height = job.height;
+        pending.promise.set_value(std::move(result));
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.jobsCompleted;
+        ++stats_.jobsFailed;
+        if (--pendingJobs_ == 0) {
+            idleCondition_.notify_all();
+        }
+        return;
+    }
+    
+    DeviceSlot& slot = slots_[slotIndex];
+    slot.success = true;
+    LLGL::CommandBuffer& commandBuffer = *slot.commandBuffer;
+    
+    commandBuffer.Begin();
+    commands_->SetCommandBuffer(&commandBuffer);
+    commands_->BeginFrame(static_cast<std::uint32_t>(slotIndex));
+    commandBuffer.BeginRenderPass(*target->renderTarget);
+    // Cleared directly: RenderCommands::Clear takes the plugin base Color, not RenderingPlugin::Color
+    LLGL::ClearValue clearValue;
+    clearValue.color[0] = job.clearColor.r;
+    clearValue.color[1] = job.clearColor.g;
+    clearValue.color[2] = job.clearColor.b;
+    clearValue.color[3] = job.clearColor.a;
+    clearValue.depth = 1.0f;
+    commandBuffer.Clear(LLGL::ClearFlags::ColorDepth, clearValue);
+    commands_->SetViewport(0, 0, static_cast<int>(job.width), static_cast<int>(job.height));
+    for (const RenderObject& object : job.objects) {
+        if (!resourceManager_->GetVertexBuffer(object.vertexBufferId) ||
+            !resourceManager_->GetPipelineState(object.pipelineStateId)) {
+            slot.success = false;
+        }
+        commands_->RenderObject(object, object.transform);
+    }
+    commandBuffer.EndRenderPass();
+    
+    LLGL::TextureRegion region;
+    region.extent = { job.width, job.height, 1 };
+    commandBuffer.CopyBufferFromTexture(*target->readback, 0, *target->color, region, target->rowPitch);
+    commandBuffer.End();
+    
+    LLGL::CommandQueue* commandQueue = renderSystem_->GetCommandQueue();
+    commandQueue->Submit(commandBuffer);
+    if (slot.fence) {
+        commandQueue->Submit(*slot.fence);
+    }
+    
+    slot.target = std::move(target);
+    slot.pending = std::move(pending);
+    runningSlots_.push_back(slotIndex);
+}
+
+bool BatchRenderer::FinishDeviceJob(bool wait) {
+    if (runningSlots_.empty()) {
+        return false;
+    }
+    
+    // Fences signal in submission order, so only the oldest job can be the next to finish
+    DeviceSlot& slot = slots_[runningSlots_.front()];
+    LLGL::CommandQueue* commandQueue = renderSystem_->GetCommandQueue();
+    if (slot.fence) {
+        if (!commandQueue->WaitFence(*slot.fence, wait ? ~0ull : 0)) {
+            return false;
+        }
+    } else if (wait) {
+        commandQueue->WaitIdle();
+    } else {
+        return false;
+    }
+    runningSlots_.pop_front();
+    
+    std::unique_ptr<DeviceTarget> target = std::move(slot.target);
+    PendingJob pending = std::move(slot.pending);
+    
+    BatchRenderResult result;
+    result.width = target->width;
+    result.height = target->height;
+    result.success = slot.success;
+    
+    const std::size_t rowSize = static_cast<std::size_t>(target->width) * 4;
+    const void* mapped = renderSystem_->MapBuffer(*target->readback, LLGL::CPUAccess::ReadOnly);
+    if (mapped) {
+        result.pixels.resize(rowSize * target->height);
+        const auto* source = static_cast<const std::uint8_t*>(mapped);
+        for (std::uint32_t y = 0; y < target->height; ++y) {
+            std::memcpy(result.pixels.data() + y * rowSize, source + static_cast<std::size_t>(y) * target->rowPitch, rowSize);
+        }
+        renderSystem_->UnmapBuffer(*target->readback);
+    } else {
+        std::cerr << "Failed to map batch readback buffer (" << target->width << "x" << target->height << ")" << std::endl;
+        result.success = false;
+    }
+    ReleaseDeviceTarget(std::move(target));
+    
+    const bool success = result.success;
+    pending.promise.set_value(std::move(result));
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.jobsCompleted;
+    if (!success) {
+        ++stats_.jobsFailed;
+    }
+    if (--pendingJobs_ == 0) {
+        idleCondition_.notify_all();
+    }
+    return true;
+}
+
+// === Target Pool ===
+
+void BatchRenderer::SetMaxIdleTargets(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxIdleTargets_ = count;
+}
+
+std::size_t BatchRenderer::GetIdleTargetCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idleRasterizers_.size() + idleTargets_.size();
+}
+
+void BatchRenderer::ReleaseIdleTargets() {
+    std::vector<std::unique_ptr<DeviceTarget>> targets;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idleRasterizers_.clear();
+        targets = std::move(idleTargets_);
+        idleTargets_.clear();
+    }
+    for (auto& target : targets) {
+        DestroyDeviceTarget(*target);
+    }
+}
+
+std::unique_ptr<SoftwareRasterizer> BatchRenderer::AcquireRasterizer(std::uint32_t width, std::uint32_t height) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Most recently released first, so the least recently used ones age out
+        for (auto it = idleRasterizers_.rbegin(); it != idleRasterizers_.rend(); ++it) {
+            if (static_cast<std::uint32_t>((*it)->GetWidth()) == width &&
+                static_cast<std::uint32_t>((*it)->GetHeight()) == height) {
+                std::unique_ptr<SoftwareRasterizer> rasterizer = std::move(*it);
+                idleRasterizers_.erase(std::next(it).base());
+                ++stats_.targetsReused;
+                return rasterizer;
+            }
+        }
+    }
+    
+    // Jobs run in parallel already, so each rasterizer stays on its worker thread
+    auto rasterizer = std::make_unique<SoftwareRasterizer>(nullptr);
+    if (!rasterizer->Resize(static_cast<int>(width), static_cast<int>(height))) {
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.targetsCreated;
+    return rasterizer;
+}
+
+void BatchRenderer::ReleaseRasterizer(std::unique_ptr<SoftwareRasterizer> rasterizer) {
+    // Idle rasterizers would otherwise hold on to every mesh they ever drew
+    rasterizer->RemoveAllBuffers();
+    
+    std::vector<std::unique_ptr<SoftwareRasterizer>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idleRasterizers_.push_back(std::move(rasterizer));
+        while (idleRasterizers_.size() > maxIdleTargets_) {
+            evicted.push_back(std::move(idleRasterizers_.front()));
+            idleRasterizers_.erase(idleRasterizers_.begin());
+            ++stats_.targetsEvicted;
+        }
+    }
+}
+
+std::unique_ptr<BatchRenderer::DeviceTarget> BatchRenderer::AcquireDeviceTarget(std::uint32_t width, std::uint32_t height) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = idleTargets_.rbegin(); it != idleTargets_.rend(); ++it) {
+            if ((*it)->width == width && (*it)->height == height) {
+                std::unique_ptr<DeviceTarget> target = std::move(*it);
+                idleTargets_.erase(std::next(it).base());
+                ++stats_.targetsReused;
+                return target;
+            }
+        }
+    }
+    
+    if (width == 0 || height == 0) {
+        std::cerr << "Invalid batch target size: " << width << "x" << height << std::endl;
+        return nullptr;
+    }
+    
+    auto target = std::make_unique<DeviceTarget>();
+    target->width = width;
+    target->height = height;
+    target->rowPitch = (width * 4 + kRowPitchAlignment - 1) / kRowPitchAlignment * kRowPitchAlignment;
+    
+    LLGL::TextureDescriptor colorDesc;
+    colorDesc.type = LLGL::TextureType::Texture2D;
+    colorDesc.format = LLGL::Format::RGBA8UNorm;
+    colorDesc.extent = { width, height, 1 };
+    colorDesc.mipLevels = 1;
+    colorDesc.bindFlags = LLGL::BindFlags::ColorAttachment | LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc;
+    target->color = renderSystem_->CreateTexture(colorDesc);
+    
+    LLGL::TextureDescriptor depthDesc;
+    depthDesc.type = LLGL::TextureType::Texture2D;
+    depthDesc.format = LLGL::Format::D32Float;
+    depthDesc.extent = { width, height, 1 };
+    depthDesc.mipLevels = 1;
+    depthDesc.bindFlags = LLGL::BindFlags::DepthStencilAttachment;
+    target->depth = renderSystem_->CreateTexture(depthDesc);
+    
+    if (target->color && target->depth) {
+        LLGL::RenderTargetDescriptor renderTargetDesc;
+        renderTargetDesc.resolution = { width, height };
+        renderTargetDesc.colorAttachments[0] = LLGL::AttachmentDescriptor(target->color);
+        renderTargetDesc.depthStencilAttachment = LLGL::AttachmentDescriptor(target->depth);
+        target->renderTarget = renderSystem_->CreateRenderTarget(renderTargetDesc);
+    }
+    
+    LLGL::BufferDescriptor bufferDesc;
+    bufferDesc.size = static_cast<std::uint64_t>(target->rowPitch) * height;
+    bufferDesc.bindFlags = LLGL::BindFlags::CopyDst;
+    bufferDesc.cpuAccessFlags = LLGL::CPUAccessFlags::Read;
+    target->readback = renderSystem_->CreateBuffer(bufferDesc);
+    
+    if (!target->renderTarget || !target->readback) {
+        std::cerr << "Failed to create batch target (" << width << "x" << height << ")" << std::endl;
+        DestroyDeviceTarget(*target);
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.targetsCreated;
+    return target;
+}
+
+void BatchRenderer::ReleaseDeviceTarget(std::unique_ptr<DeviceTarget> target) {
+    std::vector<std::unique_ptr<DeviceTarget>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idleTargets_.push_back(std::move(target));
+        while (idleTargets_.size() > maxIdleTargets_) {
+            evicted.push_back(std::move(idleTargets_.front()));
+            idleTargets_.erase(idleTargets_.begin());
+            ++stats_.targetsEvicted;
+        }
+    }
+    for (auto& old : evicted) {
+        DestroyDeviceTarget(*old);
+    }
+}
+
+void BatchRenderer::DestroyDeviceTarget(DeviceTarget& target) {
+    if (target.renderTarget) {
+        renderSystem_->Release(*target.renderTarget);
+    }
+    if (target.color) {
+        renderSystem_->Release(*target.color);
+    }
+    if (target.depth) {
+        renderSystem_->Release(*target.depth);
+    }
+    if (target.readback) {
+        renderSystem_->Release(*target.readback);
+    }
+    target = DeviceTarget();
+}
+
+// === Statistics ===
+
+BatchRendererStats BatchRenderer::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void BatchRenderer::ResetStatistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = BatchRendererStats();
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,42 @@
+/**
+ * @file DrawBindState.cpp
+ * @brief Implementation of DrawBindState class
+ */
+
+#include "../include/DrawBindState.h"
+
+namespace RenderingPlugin {
+
+void DrawBindState::PipelineBound(LLGL::PipelineState* pipelineState) {
+    pipelineState_ = pipelineState;
+    resourceHeap_ = nullptr;
+    matrixBlockBound_ = false;
+}
+
+void DrawBindState::ResourceHeapBound(LLGL::ResourceHeap* resourceHeap) {
+    resourceHeap_ = resourceHeap;
+    matrixBlockBound_ = false;
+}
+
+void DrawBindState::SetMatrixBlock(LLGL::ResourceHeap* blockHeap, std::uint32_t blockIndex) {
+    matrixBlockHeap_ = blockHeap;
+    matrixBlockIndex_ = blockIndex;
+    matrixBlockBound_ = false;
+}
+
+bool DrawBindState::TakeMatrixBlock(LLGL::ResourceHeap*& blockHeap, std::uint32_t& blockIndex) {
+    if (!matrixBlockHeap_ || matrixBlockBound_) {
+        return false;
+    }
+    
+    blockHeap = matrixBlockHeap_;
+    blockIndex = matrixBlockIndex_;
+    matrixBlockBound_ = true;
+    return true;
+}
+
+void DrawBindState::Reset() {
+    *this = DrawBindState();
+}
+
+} // namespace RenderingPlugin
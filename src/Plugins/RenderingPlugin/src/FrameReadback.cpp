@@ -0,0 +1,440 @@
+/**
+ * @file FrameReadback.cpp
+ * @brief Implementation of FrameReadback class
+ */
+
+#include "../include/FrameReadback.h"
+#include "../include/SoftwareRasterizer.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace RenderingPlugin {
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Row pitch alignment required for texture-to-buffer copies on Direct3D 12; harmless elsewhere
+constexpr std::uint32_t kRowPitchAlignment = 256;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+// === FrameReadback Implementation ===
+
+FrameReadback::FrameReadback(LLGL::RenderSystem* renderSystem, std::uint32_t ringSize)
+    : renderSystem_(renderSystem)
+    , ringSize_(ringSize)
+    , width_(0)
+    , height_(0)
+    , rowPitch_(0)
+    , dropFramesWhenBehind_(false)
+    , nextSlot_(0)
+    , imagesInUse_(0)
+    , framesInUse_(0)
+    , stopping_(false) {
+    
+    if (ringSize_ == 0) {
+        throw std::invalid_argument("FrameReadback needs at least one staging buffer");
+    }
+}
+
+FrameReadback::~FrameReadback() {
+    Flush();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    queueCondition_.notify_all();
+    if (deliveryThread_.joinable()) {
+        deliveryThread_.join();
+    }
+    
+    ReleaseSlots();
+}
+
+// === Configuration ===
+
+void FrameReadback::SetSink(ReadbackSink sink) {
+    Flush();
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    sink_ = std::move(sink);
+}
+
+void FrameReadback::SetDropFramesWhenBehind(bool enabled) {
+    dropFramesWhenBehind_ = enabled;
+}
+
+bool FrameReadback::Resize(std::uint32_t width, std::uint32_t height) {
+    if (width == 0 || height == 0) {
+        std::cerr << "Invalid readback size: " << width << "x" << height << std::endl;
+        return false;
+    }
+    
+    Flush();
+    ReleaseSlots();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeImages_.clear();
+    }
+    
+    width_ = width;
+    height_ = height;
+    rowPitch_ = (width * 4 + kRowPitchAlignment - 1) / kRowPitchAlignment * kRowPitchAlignment;
+    
+    // Staging buffers are only needed for texture readbacks
+    if (!renderSystem_) {
+        return true;
+    }
+    
+    slots_.resize(ringSize_);
+    for (Slot& slot : slots_) {
+        LLGL::BufferDescriptor bufferDesc;
+        bufferDesc.size = static_cast<std::uint64_t>(rowPitch_) * height_;
+        bufferDesc.bindFlags = LLGL::BindFlags::CopyDst;
+        bufferDesc.cpuAccessFlags = LLGL::CPUAccessFlags::Read;
+        
+        slot.buffer = renderSystem_->CreateBuffer(bufferDesc);
+        slot.commandBuffer = renderSystem_->CreateCommandBuffer();
+        // Without a fence a slot is only reused after waiting for the whole queue
+        slot.fence = renderSystem_->CreateFence();
+        if (!slot.buffer || !slot.commandBuffer) {
+            std::cerr << "Failed to create readback staging buffers (" << width_ << "x" << height_ << ")" << std::endl;
+            ReleaseSlots();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint32_t FrameReadback::GetWidth() const {
+    return width_;
+}
+
+std::uint32_t FrameReadback::GetHeight() const {
+    return height_;
+}
+
+std::uint32_t FrameReadback::GetRingSize() const {
+    return ringSize_;
+}
+
+// === Readback ===
+
+bool FrameReadback::Request(LLGL::Texture& texture, std::uint64_t frameNumber) {
+    if (!renderSystem_) {
+        std::cerr << "Texture readback requires a render system" << std::endl;
+        return false;
+    }
+    
+    if (texture.GetFormat() != LLGL::Format::RGBA8UNorm) {
+        std::cerr << "Texture readback requires an RGBA8 texture" << std::endl;
+        return false;
+    }
+    
+    const LLGL::Extent3D extent = texture.GetMipExtent(0);
+    if (extent.width != width_ || extent.height != height_ || slots_.empty()) {
+        if (!Resize(extent.width, extent.height)) {
+            return false;
+        }
+    }
+    
+    RecycleSlots();
+    
+    // Slots are used in ring order, so a busy next slot is the oldest readback
+    Slot& slot = slots_[nextSlot_];
+    if (!copyingSlots_.empty() && copyingSlots_.front() == nextSlot_) {
+        DeliverOldestCopy();
+    }
+    
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++stats_.framesRequested;
+        if (slot.state == SlotState::Delivering) {
+            if (dropFramesWhenBehind_) {
+                ++stats_.framesDropped;
+                return true;
+            }
+            const auto waitStart = Clock::now();
+            releaseCondition_.wait(lock, [&slot] { return slot.state == SlotState::Delivered; });
+            stats_.stallTimeMs += ElapsedMs(waitStart);
+        }
+    }
+    RecycleSlots();
+    
+    LLGL::TextureRegion region;
+    region.extent = { width_, height_, 1 };
+    
+    slot.commandBuffer->Begin();
+    slot.commandBuffer->CopyBufferFromTexture(*slot.buffer, 0, texture, region, rowPitch_);
+    slot.commandBuffer->End();
+    
+    LLGL::CommandQueue* commandQueue = renderSystem_->GetCommandQueue();
+    commandQueue->Submit(*slot.commandBuffer);
+    if (slot.fence) {
+        commandQueue->Submit(*slot.fence);
+    }
+    slot.frameNumber = frameNumber;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot.state = SlotState::Copying;
+    }
+    copyingSlots_.push_back(nextSlot_);
+    nextSlot_ = (nextSlot_ + 1) % slots_.size();
+    return true;
+}
+
+bool FrameReadback::Request(SoftwareRasterizer& rasterizer, std::uint64_t frameNumber) {
+    const std::uint32_t width = static_cast<std::uint32_t>(rasterizer.GetWidth());
+    const std::uint32_t height = static_cast<std::uint32_t>(rasterizer.GetHeight());
+    if (width != width_ || height != height_) {
+        if (!Resize(width, height)) {
+            return false;
+        }
+    }
+    
+    rasterizer.Flush();
+    
+    QueuedFrame frame;
+    frame.frameNumber = frameNumber;
+    frame.width = width;
+    frame.height = height;
+    frame.rowPitch = width * 4;
+    if (AcquireImage(frame)) {
+        const auto copyStart = Clock::now();
+        rasterizer.ReadPixels(frame.pixels);
+        const double copyMs = ElapsedMs(copyStart);
+        
+        QueueFrame(std::move(frame));
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.copyTimeMs += copyMs;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.framesRequested;
+    return true;
+}
+
+std::size_t FrameReadback::Poll() {
+    RecycleSlots();
+    
+    // Fences signal in submission order, so stop at the first unfinished copy
+    std::size_t queued = 0;
+    while (!copyingSlots_.empty()) {
+        Slot& slot = slots_[copyingSlots_.front()];
+        if (!slot.fence || !renderSystem_->GetCommandQueue()->WaitFence(*slot.fence, 0)) {
+            break;
+        }
+        DeliverOldestCopy();
+        ++queued;
+    }
+    return queued;
+}
+
+void FrameReadback::Flush() {
+    while (!copyingSlots_.empty()) {
+        DeliverOldestCopy();
+    }
+    
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        releaseCondition_.wait(lock, [this] { return framesInUse_ == 0; });
+    }
+    RecycleSlots();
+}
+
+std::size_t FrameReadback::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return copyingSlots_.size() + framesInUse_;
+}
+
+void FrameReadback::DeliverOldestCopy() {
+    const std::size_t index = copyingSlots_.front();
+    copyingSlots_.pop_front();
+    Slot& slot = slots_[index];
+    LLGL::CommandQueue* commandQueue = renderSystem_->GetCommandQueue();
+    
+    const auto waitStart = Clock::now();
+    if (slot.fence) {
+        commandQueue->WaitFence(*slot.fence, ~0ull);
+    } else {
+        commandQueue->WaitIdle();
+    }
+    const auto mapStart = Clock::now();
+    const void* mapped = renderSystem_->MapBuffer(*slot.buffer, LLGL::CPUAccess::ReadOnly);
+    const auto mapEnd = Clock::now();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.stallTimeMs += std::chrono::duration<double, std::milli>(mapStart - waitStart).count();
+        stats_.copyTimeMs += std::chrono::duration<double, std::milli>(mapEnd - mapStart).count();
+        slot.state = mapped ? SlotState::Delivering : SlotState::Idle;
+    }
+    if (!mapped) {
+        std::cerr << "Failed to map readback buffer of frame " << slot.frameNumber << std::endl;
+        return;
+    }
+    
+    // The sink reads the staging memory in place; the slot is unmapped once it returns
+    QueuedFrame frame;
+    frame.frameNumber = slot.frameNumber;
+    frame.width = width_;
+    frame.height = height_;
+    frame.rowPitch = rowPitch_;
+    frame.mapped = static_cast<const std::uint8_t*>(mapped);
+    frame.slot = index;
+    QueueFrame(std::move(frame));
+}
+
+void FrameReadback::RecycleSlots() {
+    std::vector<std::size_t> delivered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].state == SlotState::Delivered) {
+                delivered.push_back(i);
+            }
+        }
+    }
+    
+    // Only the render thread may unmap, and only it moves a slot out of Delivered
+    for (std::size_t index : delivered) {
+        renderSystem_->UnmapBuffer(*slots_[index].buffer);
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t index : delivered) {
+        slots_[index].state = SlotState::Idle;
+    }
+}
+
+bool FrameReadback::AcquireImage(QueuedFrame& frame) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (imagesInUse_ >= ringSize_) {
+        if (dropFramesWhenBehind_) {
+            ++stats_.framesDropped;
+            return false;
+        }
+        const auto waitStart = Clock::now();
+        releaseCondition_.wait(lock, [this] { return imagesInUse_ < ringSize_; });
+        stats_.stallTimeMs += ElapsedMs(waitStart);
+    }
+    
+    if (!freeImages_.empty()) {
+        frame.pixels = std::move(freeImages_.back());
+        freeImages_.pop_back();
+    }
+    ++imagesInUse_;
+    return true;
+}
+
+void FrameReadback::QueueFrame(QueuedFrame&& frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++framesInUse_;
+        queue_.push_back(std::move(frame));
+        if (!deliveryThread_.joinable()) {
+            deliveryThread_ = std::thread(&FrameReadback::DeliveryLoop, this);
+        }
+    }
+    queueCondition_.notify_one();
+}
+
+void FrameReadback::DeliveryLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        queueCondition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;
+        }
+        
+        QueuedFrame frame = std::move(queue_.front());
+        queue_.pop_front();
+        ReadbackSink sink = sink_;
+        lock.unlock();
+        
+        const auto sinkStart = Clock::now();
+        if (sink) {
+            ReadbackFrame readbackFrame;
+            readbackFrame.frameNumber = frame.frameNumber;
+            readbackFrame.width = frame.width;
+            readbackFrame.height = frame.height;
+            readbackFrame.rowPitch = frame.rowPitch;
+            readbackFrame.data = frame.mapped ? frame.mapped : frame.pixels.data();
+            sink(readbackFrame);
+        }
+        const double sinkMs = ElapsedMs(sinkStart);
+        
+        lock.lock();
+        if (sink) {
+            ++stats_.framesDelivered;
+            stats_.bytesDelivered += static_cast<std::uint64_t>(frame.width) * frame.height * 4;
+            stats_.sinkTimeMs += sinkMs;
+        }
+        if (frame.mapped) {
+            slots_[frame.slot].state = SlotState::Delivered;
+        } else {
+            freeImages_.push_back(std::move(frame.pixels));
+            --imagesInUse_;
+        }
+        --framesInUse_;
+        releaseCondition_.notify_all();
+    }
+}
+
+void FrameReadback::ReleaseSlots() {
+    for (Slot& slot : slots_) {
+        if (slot.fence) {
+            renderSystem_->Release(*slot.fence);
+        }
+        if (slot.commandBuffer) {
+            renderSystem_->Release(*slot.commandBuffer);
+        }
+        if (slot.buffer) {
+            renderSystem_->Release(*slot.buffer);
+        }
+    }
+    slots_.clear();
+    nextSlot_ = 0;
+    copyingSlots_.clear();
+}
+
+// === Sinks ===
+
+ReadbackSink FrameReadback::CreateFileSink(std::FILE* file) {
+    return [file](const ReadbackFrame& frame) {
+        const std::size_t rowSize = static_cast<std::size_t>(frame.width) * 4;
+        bool written = true;
+        if (frame.rowPitch == rowSize) {
+            written = std::fwrite(frame.data, rowSize, frame.height, file) == frame.height;
+        } else {
+            for (std::uint32_t y = 0; y < frame.height && written; ++y) {
+                written = std::fwrite(frame.data + static_cast<std::size_t>(y) * frame.rowPitch, 1, rowSize, file) == rowSize;
+            }
+        }
+        if (!written) {
+            std::cerr << "Failed to write frame " << frame.frameNumber << std::endl;
+        }
+    };
+}
+
+// === Statistics ===
+
+FrameReadbackStats FrameReadback::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void FrameReadback::ResetStatistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = FrameReadbackStats();
+}
+
+} // namespace RenderingPlugin
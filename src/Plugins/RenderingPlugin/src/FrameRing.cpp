@@ -0,0 +1,113 @@
+/**
+ * @file FrameRing.cpp
+ * @brief Implementation of FrameRing class
+ */
+
+#include "../include/FrameRing.h"
+
+namespace RenderingPlugin {
+
+FrameRing::FrameRing(std::uint32_t slotCount)
+    : slots_(slotCount)
+    , slotIndex_(0) {
+}
+
+FrameRing::~FrameRing() {
+    ReleaseAll();
+}
+
+void FrameRing::Reset(std::uint32_t slotCount) {
+    ReleaseAll();
+    
+    slots_.clear();
+    slots_.resize(slotCount);
+    slotIndex_ = 0;
+}
+
+bool FrameRing::BeginSlot(const WaitFunction& wait) {
+    if (slots_.empty()) {
+        return false;
+    }
+    
+    Slot& slot = slots_[slotIndex_];
+    
+    // Only block if the GPU still uses this slot from GetSlotCount() frames ago
+    bool waited = false;
+    if (slot.submitted) {
+        if (wait) {
+            wait(slotIndex_);
+        }
+        slot.submitted = false;
+        waited = true;
+    }
+    
+    // Resources released while recording this slot's previous frame are no longer in use
+    RunReleases(slot);
+    return waited;
+}
+
+void FrameRing::MarkSubmitted() {
+    if (!slots_.empty()) {
+        slots_[slotIndex_].submitted = true;
+    }
+}
+
+void FrameRing::Advance() {
+    if (!slots_.empty()) {
+        slotIndex_ = (slotIndex_ + 1) % static_cast<std::uint32_t>(slots_.size());
+    }
+}
+
+void FrameRing::DeferRelease(std::function<void()> release) {
+    if (!release) {
+        return;
+    }
+    
+    if (slots_.empty()) {
+        // Nothing is in flight without frame slots
+        release();
+        return;
+    }
+    
+    slots_[slotIndex_].pendingReleases.push_back(std::move(release));
+}
+
+void FrameRing::ReleaseAll() {
+    for (Slot& slot : slots_) {
+        RunReleases(slot);
+        slot.submitted = false;
+    }
+}
+
+std::uint32_t FrameRing::GetSlotCount() const {
+    return static_cast<std::uint32_t>(slots_.size());
+}
+
+std::uint32_t FrameRing::GetSlotIndex() const {
+    return slotIndex_;
+}
+
+bool FrameRing::IsSubmitted(std::uint32_t slot) const {
+    return slot < slots_.size() && slots_[slot].submitted;
+}
+
+std::size_t FrameRing::GetPendingReleaseCount() const {
+    std::size_t count = 0;
+    for (const Slot& slot : slots_) {
+        count += slot.pendingReleases.size();
+    }
+    return count;
+}
+
+// === Private Methods ===
+
+void FrameRing::RunReleases(Slot& slot) {
+    // A release may queue further releases, which belong to the next use of the slot
+    std::vector<std::function<void()>> releases;
+    releases.swap(slot.pendingReleases);
+    for (auto& release : releases) {
+        release();
+    }
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,358 @@
+/**
+ * @file GeometryCache.cpp
+ * @brief Implementation of GeometryCache class
+ */
+
+#include "../include/GeometryCache.h"
+#include <LLGL/Utils/VertexFormat.h>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+namespace RenderingPlugin {
+
+namespace {
+
+GeometryKey MakeKey(GeometryType type, const GeometryParams& params,
+                    float size0 = 0.0f, float size1 = 0.0f, float size2 = 0.0f,
+                    std::uint32_t count0 = 0, std::uint32_t count1 = 0) {
+    GeometryKey key;
+    key.type = type;
+    key.sizes[0] = size0;
+    key.sizes[1] = size1;
+    key.sizes[2] = size2;
+    key.counts[0] = count0;
+    key.counts[1] = count1;
+    key.params = params;
+    return key;
+}
+
+void HashCombine(std::size_t& seed, std::size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+std::size_t HashFloat(float value) {
+    // Hash the bit pattern so the hash agrees with operator== for every value except +0/-0
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return std::hash<std::uint32_t>()(value == 0.0f ? 0u : bits);
+}
+
+std::size_t GetMeshMemorySize(const MeshData& mesh) {
+    return mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(std::uint32_t);
+}
+
+} // namespace
+
+// === GeometryKey Implementation ===
+
+GeometryKey GeometryKey::Triangle(float size, const GeometryParams& params) {
+    return MakeKey(GeometryType::Triangle, params, size);
+}
+
+GeometryKey GeometryKey::Quad(float width, float height, const GeometryParams& params) {
+    return MakeKey(GeometryType::Quad, params, width, height);
+}
+
+GeometryKey GeometryKey::Cube(float size, const GeometryParams& params) {
+    return MakeKey(GeometryType::Cube, params, size);
+}
+
+GeometryKey GeometryKey::Box(float width, float height, float depth, const GeometryParams& params) {
+    return MakeKey(GeometryType::Box, params, width, height, depth);
+}
+
+GeometryKey GeometryKey::Sphere(float radius, std::uint32_t slices, std::uint32_t stacks, const GeometryParams& params) {
+    return MakeKey(GeometryType::Sphere, params, radius, 0.0f, 0.0f, slices, stacks);
+}
+
+GeometryKey GeometryKey::UVSphere(float radius, std::uint32_t longitudeSegments, std::uint32_t latitudeSegments,
+                                  const GeometryParams& params) {
+    return MakeKey(GeometryType::UVSphere, params, radius, 0.0f, 0.0f, longitudeSegments, latitudeSegments);
+}
+
+GeometryKey GeometryKey::Icosphere(float radius, std::uint32_t subdivisions, const GeometryParams& params) {
+    return MakeKey(GeometryType::Icosphere, params, radius, 0.0f, 0.0f, subdivisions);
+}
+
+GeometryKey GeometryKey::Cylinder(float topRadius, float bottomRadius, float height, std::uint32_t slices,
+                                  std::uint32_t stacks, const GeometryParams& params) {
+    return MakeKey(GeometryType::Cylinder, params, topRadius, bottomRadius, height, slices, stacks);
+}
+
+GeometryKey GeometryKey::Cone(float radius, float height, std::uint32_t slices, std::uint32_t stacks,
+                              const GeometryParams& params) {
+    return MakeKey(GeometryType::Cone, params, radius, height, 0.0f, slices, stacks);
+}
+
+GeometryKey GeometryKey::Capsule(float radius, float height, std::uint32_t slices, std::uint32_t stacks,
+                                 const GeometryParams& params) {
+    return MakeKey(GeometryType::Capsule, params, radius, height, 0.0f, slices, stacks);
+}
+
+GeometryKey GeometryKey::Torus(float majorRadius, float minorRadius, std::uint32_t majorSegments,
+                               std::uint32_t minorSegments, const GeometryParams& params) {
+    return MakeKey(GeometryType::Torus, params, majorRadius, minorRadius, 0.0f, majorSegments, minorSegments);
+}
+
+GeometryKey GeometryKey::Plane(float width, float depth, std::uint32_t widthSegments, std::uint32_t depthSegments,
+                               const GeometryParams& params) {
+    return MakeKey(GeometryType::Plane, params, width, depth, 0.0f, widthSegments, depthSegments);
+}
+
+GeometryKey GeometryKey::Circle(float radius, std::uint32_t segments, const GeometryParams& params) {
+    return MakeKey(GeometryType::Circle, params, radius, 0.0f, 0.0f, segments);
+}
+
+GeometryKey GeometryKey::Ring(float innerRadius, float outerRadius, std::uint32_t segments, const GeometryParams& params) {
+    return MakeKey(GeometryType::Ring, params, innerRadius, outerRadius, 0.0f, segments);
+}
+
+GeometryKey GeometryKey::Tetrahedron(float size, const GeometryParams& params) {
+    return MakeKey(GeometryType::Tetrahedron, params, size);
+}
+
+GeometryKey GeometryKey::Octahedron(float size, const GeometryParams& params) {
+    return MakeKey(GeometryType::Octahedron, params, size);
+}
+
+GeometryKey GeometryKey::Dodecahedron(float size, const GeometryParams& params) {
+    return MakeKey(GeometryType::Dodecahedron, params, size);
+}
+
+GeometryKey GeometryKey::Icosahedron(float size, const GeometryParams& params) {
+    return MakeKey(GeometryType::Icosahedron, params, size);
+}
+
+bool GeometryKey::operator==(const GeometryKey& other) const {
+    return type == other.type &&
+           sizes[0] == other.sizes[0] && sizes[1] == other.sizes[1] && sizes[2] == other.sizes[2] &&
+           counts[0] == other.counts[0] && counts[1] == other.counts[1] &&
+           params.generateNormals == other.params.generateNormals &&
+           params.generateTexCoords == other.params.generateTexCoords &&
+           params.generateTangents == other.params.generateTangents &&
+           params.flipWindingOrder == other.params.flipWindingOrder &&
+           params.textureScale == other.params.textureScale;
+}
+
+std::size_t GeometryKeyHash::operator()(const GeometryKey& key) const {
+    std::size_t seed = static_cast<std::size_t>(key.type);
+    HashCombine(seed, HashFloat(key.sizes[0]));
+    HashCombine(seed, HashFloat(key.sizes[1]));
+    HashCombine(seed, HashFloat(key.sizes[2]));
+    HashCombine(seed, key.counts[0]);
+    HashCombine(seed, key.counts[1]);
+    
+    const std::size_t flags = (key.params.generateNormals ? 1u : 0u) | (key.params.generateTexCoords ? 2u : 0u) |
+                              (key.params.generateTangents ? 4u : 0u) | (key.params.flipWindingOrder ? 8u : 0u);
+    HashCombine(seed, flags);
+    HashCombine(seed, HashFloat(key.params.textureScale));
+    return seed;
+}
+
+// === GeometryCache Implementation ===
+
+GeometryCache::GeometryCache(ResourceManager* resourceManager, std::size_t memoryBudget)
+    : resourceManager_(resourceManager) {
+    stats_.memoryBudget = memoryBudget;
+}
+
+GeometryCache::~GeometryCache() {
+    for (Entry& entry : entries_) {
+        ReleaseBuffers(entry);
+    }
+}
+
+std::shared_ptr<const MeshData> GeometryCache::GetMesh(const GeometryKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Acquire(key).mesh;
+}
+
+GeometryBuffers GeometryCache::GetBuffers(const GeometryKey& key) {
+    if (!resourceManager_) {
+        std::cerr << "GeometryCache has no resource manager for GPU buffers" << std::endl;
+        return GeometryBuffers();
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = Acquire(key);
+    if (entry.buffers.IsValid()) {
+        return entry.buffers;
+    }
+    
+    const MeshData& mesh = *entry.mesh;
+    if (mesh.IsEmpty()) {
+        return GeometryBuffers();
+    }
+    
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "position", LLGL::Format::RGB32Float });
+    vertexFormat.AppendAttribute({ "normal", LLGL::Format::RGB32Float });
+    vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float });
+    vertexFormat.AppendAttribute({ "color", LLGL::Format::RGB32Float });
+    
+    GeometryBuffers buffers;
+    buffers.vertexBufferId = resourceManager_->CreateVertexBuffer(mesh.vertices.data(),
+                                                                  mesh.vertices.size() * sizeof(Vertex), vertexFormat);
+    buffers.indexBufferId = resourceManager_->CreateIndexBuffer(mesh.indices.data(),
+                                                                mesh.indices.size() * sizeof(std::uint32_t),
+                                                                LLGL::Format::R32UInt);
+    buffers.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+    buffers.pin = std::make_shared<const GeometryKey>(key);
+    
+    if (!buffers.IsValid()) {
+        entry.buffers = buffers;
+        ReleaseBuffers(entry);
+        return GeometryBuffers();
+    }
+    
+    // GPU copies count against the same budget as the CPU data
+    entry.buffers = buffers;
+    entry.memorySize += GetMeshMemorySize(mesh);
+    stats_.memoryUsed += GetMeshMemorySize(mesh);
+    EvictToBudget(&entry);
+    
+    return buffers;
+}
+
+bool GeometryCache::Contains(const GeometryKey& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lookup_.find(key) != lookup_.end();
+}
+
+void GeometryCache::SetMemoryBudget(std::size_t memoryBudget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.memoryBudget = memoryBudget;
+    EvictToBudget(nullptr);
+}
+
+void GeometryCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (IsPinned(*it)) {
+            ++it;
+            continue;
+        }
+        ReleaseBuffers(*it);
+        stats_.memoryUsed -= it->memorySize;
+        lookup_.erase(it->key);
+        it = entries_.erase(it);
+    }
+    stats_.entryCount = entries_.size();
+}
+
+void GeometryCache::SetReleaseScheduler(ReleaseScheduler scheduler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    releaseScheduler_ = std::move(scheduler);
+}
+
+GeometryCacheStats GeometryCache::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+MeshData GeometryCache::Generate(const GeometryKey& key) {
+    const float* s = key.sizes;
+    const std::uint32_t* n = key.counts;
+    const GeometryParams& p = key.params;
+    
+    switch (key.type) {
+        case GeometryType::Triangle:     return GeometryGenerator::GenerateTriangle(s[0], p);
+        case GeometryType::Quad:         return GeometryGenerator::GenerateQuad(s[0], s[1], p);
+        case GeometryType::Cube:         return GeometryGenerator::GenerateCube(s[0], p);
+        case GeometryType::Box:          return GeometryGenerator::GenerateBox(s[0], s[1], s[2], p);
+        case GeometryType::Sphere:       return GeometryGenerator::GenerateSphere(s[0], n[0], n[1], p);
+        case GeometryType::UVSphere:     return GeometryGenerator::GenerateUVSphere(s[0], n[0], n[1], p);
+        case GeometryType::Icosphere:    return GeometryGenerator::GenerateIcosphere(s[0], n[0], p);
+        case GeometryType::Cylinder:     return GeometryGenerator::GenerateCylinder(s[0], s[1], s[2], n[0], n[1], p);
+        case GeometryType::Cone:         return GeometryGenerator::GenerateCone(s[0], s[1], n[0], n[1], p);
+        case GeometryType::Capsule:      return GeometryGenerator::GenerateCapsule(s[0], s[1], n[0], n[1], p);
+        case GeometryType::Torus:        return GeometryGenerator::GenerateTorus(s[0], s[1], n[0], n[1], p);
+        case GeometryType::Plane:        return GeometryGenerator::GeneratePlane(s[0], s[1], n[0], n[1], p);
+        case GeometryType::Circle:       return GeometryGenerator::GenerateCircle(s[0], n[0], p);
+        case GeometryType::Ring:         return GeometryGenerator::GenerateRing(s[0], s[1], n[0], p);
+        case GeometryType::Tetrahedron:  return GeometryGenerator::GenerateTetrahedron(s[0], p);
+        case GeometryType::Octahedron:   return GeometryGenerator::GenerateOctahedron(s[0], p);
+        case GeometryType::Dodecahedron: return GeometryGenerator::GenerateDodecahedron(s[0], p);
+        case GeometryType::Icosahedron:  return GeometryGenerator::GenerateIcosahedron(s[0], p);
+    }
+    return MeshData();
+}
+
+// === Private Methods ===
+
+GeometryCache::Entry& GeometryCache::Acquire(const GeometryKey& key) {
+    auto it = lookup_.find(key);
+    if (it != lookup_.end()) {
+        stats_.hits++;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return entries_.front();
+    }
+    
+    stats_.misses++;
+    
+    Entry entry;
+    entry.key = key;
+    entry.mesh = std::make_shared<const MeshData>(Generate(key));
+    entry.memorySize = GetMeshMemorySize(*entry.mesh);
+    
+    entries_.push_front(std::move(entry));
+    lookup_[key] = entries_.begin();
+    stats_.entryCount = entries_.size();
+    stats_.memoryUsed += entries_.front().memorySize;
+    
+    EvictToBudget(&entries_.front());
+    return entries_.front();
+}
+
+void GeometryCache::EvictToBudget(const Entry* keep) {
+    // The entry being returned stays even if it alone exceeds the budget, and so do entries
+    // whose buffers are still in use
+    auto it = entries_.end();
+    while (stats_.memoryUsed > stats_.memoryBudget && it != entries_.begin()) {
+        --it;
+        if (&*it == keep || IsPinned(*it)) {
+            continue;
+        }
+        
+        ReleaseBuffers(*it);
+        stats_.memoryUsed -= it->memorySize;
+        stats_.evictions++;
+        lookup_.erase(it->key);
+        it = entries_.erase(it);
+    }
+    stats_.entryCount = entries_.size();
+}
+
+bool GeometryCache::IsPinned(const Entry& entry) {
+    // The entry holds one reference itself
+    return entry.buffers.pin.use_count() > 1;
+}
+
+void GeometryCache::ReleaseBuffers(Entry& entry) {
+    const ResourceId vertexBufferId = entry.buffers.vertexBufferId;
+    const ResourceId indexBufferId = entry.buffers.indexBufferId;
+    entry.buffers = GeometryBuffers();
+    
+    if (!resourceManager_ || (vertexBufferId == 0 && indexBufferId == 0)) {
+        return;
+    }
+    
+    ResourceManager* resourceManager = resourceManager_;
+    auto release = [resourceManager, vertexBufferId, indexBufferId]() {
+        if (vertexBufferId != 0) {
+            resourceManager->ReleaseBuffer(vertexBufferId);
+        }
+        if (indexBufferId != 0) {
+            resourceManager->ReleaseBuffer(indexBufferId);
+        }
+    };
+    
+    if (releaseScheduler_) {
+        releaseScheduler_(release);
+    } else {
+        release();
+    }
+}
+
+} // namespace RenderingPlugin
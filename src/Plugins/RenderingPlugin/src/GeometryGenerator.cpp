@@ -6,11 +6,14 @@
 #include "../include/GeometryGenerator.h"
 #include "ResourceManager.h"
 #include "MathTypes.h"
+#include "../include/ThreadPool.h"
 #include <LLGL/LLGL.h>
 #include <LLGL/Utils/VertexFormat.h>
 #include <cmath>
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
 
 namespace RenderingPlugin {
@@ -63,6 +66,127 @@ static Gs::Vector3f Cross(const Gs::Vector3f& a, const Gs::Vector3f& b) {
     };
 }
 
+// === Mesh Processing Kernels ===
+
+// Vertices are deinterleaved into per-component blocks so the arithmetic runs as plain
+// vectorizable loops over the AoS Vertex layout
+static constexpr std::size_t kKernelBlockSize = 256;
+static constexpr std::size_t kKernelLaneCount = 8;
+
+// Below this many items per chunk the pool dispatch costs more than it saves
+static constexpr std::size_t kMinItemsPerChunk = 32768;
+
+static std::size_t GetKernelChunkCount(ThreadPool* threadPool, std::size_t count) {
+    if (!threadPool) {
+        return 1;
+    }
+    return std::max<std::size_t>(1, std::min(threadPool->GetThreadCount(), count / kMinItemsPerChunk));
+}
+
+static void RunKernelChunks(ThreadPool* threadPool, std::size_t count, std::size_t chunkCount,
+                            const std::function<void(std::size_t, std::size_t, std::size_t)>& func) {
+    if (chunkCount <= 1) {
+        func(0, count, 0);
+    } else {
+        threadPool->ParallelFor(count, func, chunkCount);
+    }
+}
+
+/**
+ * @brief Min/max reduction over a vertex range; count must be greater than zero
+ */
+static void ReduceBounds(const Vertex* vertices, std::size_t count, float minBounds[3], float maxBounds[3]) {
+    alignas(32) float xs[kKernelBlockSize], ys[kKernelBlockSize], zs[kKernelBlockSize];
+    alignas(32) float minX[kKernelLaneCount], minY[kKernelLaneCount], minZ[kKernelLaneCount];
+    alignas(32) float maxX[kKernelLaneCount], maxY[kKernelLaneCount], maxZ[kKernelLaneCount];
+    
+    for (std::size_t lane = 0; lane < kKernelLaneCount; ++lane) {
+        minX[lane] = maxX[lane] = vertices[0].position.x;
+        minY[lane] = maxY[lane] = vertices[0].position.y;
+        minZ[lane] = maxZ[lane] = vertices[0].position.z;
+    }
+    
+    for (std::size_t start = 0; start < count; start += kKernelBlockSize) {
+        const std::size_t blockCount = std::min(kKernelBlockSize, count - start);
+        const Vertex* block = vertices + start;
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            xs[i] = block[i].position.x;
+            ys[i] = block[i].position.y;
+            zs[i] = block[i].position.z;
+        }
+        
+        // Pad the tail with a value already in range so every lane stays valid
+        const std::size_t paddedCount = (blockCount + kKernelLaneCount - 1) / kKernelLaneCount * kKernelLaneCount;
+        for (std::size_t i = blockCount; i < paddedCount; ++i) {
+            xs[i] = xs[0];
+            ys[i] = ys[0];
+            zs[i] = zs[0];
+        }
+        
+        for (std::size_t i = 0; i < paddedCount; i += kKernelLaneCount) {
+            for (std::size_t lane = 0; lane < kKernelLaneCount; ++lane) {
+                minX[lane] = std::min(minX[lane], xs[i + lane]);
+                minY[lane] = std::min(minY[lane], ys[i + lane]);
+                minZ[lane] = std::min(minZ[lane], zs[i + lane]);
+                maxX[lane] = std::max(maxX[lane], xs[i + lane]);
+                maxY[lane] = std::max(maxY[lane], ys[i + lane]);
+                maxZ[lane] = std::max(maxZ[lane], zs[i + lane]);
+            }
+        }
+    }
+    
+    minBounds[0] = *std::min_element(minX, minX + kKernelLaneCount);
+    minBounds[1] = *std::min_element(minY, minY + kKernelLaneCount);
+    minBounds[2] = *std::min_element(minZ, minZ + kKernelLaneCount);
+    maxBounds[0] = *std::max_element(maxX, maxX + kKernelLaneCount);
+    maxBounds[1] = *std::max_element(maxY, maxY + kKernelLaneCount);
+    maxBounds[2] = *std::max_element(maxZ, maxZ + kKernelLaneCount);
+}
+
+/**
+ * @brief Transform positions by a row-major 3x4 affine matrix and normals by a row-major 3x3 matrix
+ */
+static void TransformVertices(Vertex* vertices, std::size_t count, const float (&m)[12], const float (&n)[9]) {
+    alignas(32) float px[kKernelBlockSize], py[kKernelBlockSize], pz[kKernelBlockSize];
+    alignas(32) float nx[kKernelBlockSize], ny[kKernelBlockSize], nz[kKernelBlockSize];
+    
+    for (std::size_t start = 0; start < count; start += kKernelBlockSize) {
+        const std::size_t blockCount = std::min(kKernelBlockSize, count - start);
+        Vertex* block = vertices + start;
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            px[i] = block[i].position.x;
+            py[i] = block[i].position.y;
+            pz[i] = block[i].position.z;
+            nx[i] = block[i].normal.x;
+            ny[i] = block[i].normal.y;
+            nz[i] = block[i].normal.z;
+        }
+        
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            const float x = px[i], y = py[i], z = pz[i];
+            px[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+            py[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+            pz[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+        }
+        
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            const float x = n[0] * nx[i] + n[1] * ny[i] + n[2] * nz[i];
+            const float y = n[3] * nx[i] + n[4] * ny[i] + n[5] * nz[i];
+            const float z = n[6] * nx[i] + n[7] * ny[i] + n[8] * nz[i];
+            const float lengthSq = x * x + y * y + z * z;
+            const float invLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+            nx[i] = x * invLength;
+            ny[i] = y * invLength;
+            nz[i] = z * invLength;
+        }
+        
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            block[i].position = { px[i], py[i], pz[i] };
+            block[i].normal = { nx[i], ny[i], nz[i] };
+        }
+    }
+}
+
 // === GeometryGenerator Implementation ===
 
 // === Basic Primitives ===
@@ -835,24 +959,38 @@ bool GeometryGenerator::CreateBuffersFromMesh(const MeshData& meshData, Resource
     }
 }
 
-void GeometryGenerator::CalculateBounds(const MeshData& meshData, Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds) {
+void GeometryGenerator::CalculateBounds(const MeshData& meshData, Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds,
+                                        ThreadPool* threadPool) {
     if (meshData.vertices.empty()) {
         minBounds = Gs::Vector3f(0, 0, 0);
         maxBounds = Gs::Vector3f(0, 0, 0);
         return;
     }
     
+    const std::size_t vertexCount = meshData.vertices.size();
+    const std::size_t chunkCount = GetKernelChunkCount(threadPool, vertexCount);
+    
+    // Chunks are ceil-sized, so each one is non-empty; unused slots keep the first vertex
+    std::vector<float> chunkBounds(chunkCount * 6);
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const Gs::Vector3f& first = meshData.vertices[0].position;
+        float* bounds = &chunkBounds[chunk * 6];
+        bounds[0] = bounds[3] = first.x;
+        bounds[1] = bounds[4] = first.y;
+        bounds[2] = bounds[5] = first.z;
+    }
+    
+    RunKernelChunks(threadPool, vertexCount, chunkCount, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        float* bounds = &chunkBounds[chunk * 6];
+        ReduceBounds(meshData.vertices.data() + begin, end - begin, bounds, bounds + 3);
+    });
+    
     minBounds = meshData.vertices[0].position;
     maxBounds = meshData.vertices[0].position;
-    
-    for (const auto& vertex : meshData.vertices) {
-        if (vertex.position.x < minBounds.x) minBounds.x = vertex.position.x;
-        if (vertex.position.y < minBounds.y) minBounds.y = vertex.position.y;
-        if (vertex.position.z < minBounds.z) minBounds.z = vertex.position.z;
-        
-        if (vertex.position.x > maxBounds.x) maxBounds.x = vertex.position.x;
-        if (vertex.position.y > maxBounds.y) maxBounds.y = vertex.position.y;
-        if (vertex.position.z > maxBounds.z) maxBounds.z = vertex.position.z;
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const float* bounds = &chunkBounds[chunk * 6];
+        minBounds = { std::min(minBounds.x, bounds[0]), std::min(minBounds.y, bounds[1]), std::min(minBounds.z, bounds[2]) };
+        maxBounds = { std::max(maxBounds.x, bounds[3]), std::max(maxBounds.y, bounds[4]), std::max(maxBounds.z, bounds[5]) };
     }
 }
 
@@ -866,76 +1004,152 @@ Gs::Vector3f GeometryGenerator::CalculateCenter(const MeshData& meshData) {
     };
 }
 
-void GeometryGenerator::TransformMesh(MeshData& meshData, const Gs::Matrix4f& transform) {
-    // This is a simplified transform - in practice you'd want proper matrix math
-    // For now, just apply translation from the matrix
-    float tx = transform.At(3, 0);
-    float ty = transform.At(3, 1);
-    float tz = transform.At(3, 2);
-    
-    for (auto& vertex : meshData.vertices) {
-        vertex.position.x += tx;
-        vertex.position.y += ty;
-        vertex.position.z += tz;
+void GeometryGenerator::TransformMesh(MeshData& meshData, const Gs::Matrix4f& transform, ThreadPool* threadPool) {
+    float m[12];
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            m[row * 4 + col] = transform.At(row, col);
+        }
     }
+    
+    // The cofactor matrix is the inverse transpose scaled by the determinant; only the sign of
+    // the scale matters because the normals are renormalized
+    const Gs::Vector3f r0 = { m[0], m[1], m[2] };
+    const Gs::Vector3f r1 = { m[4], m[5], m[6] };
+    const Gs::Vector3f r2 = { m[8], m[9], m[10] };
+    const Gs::Vector3f c0 = Cross(r1, r2);
+    const Gs::Vector3f c1 = Cross(r2, r0);
+    const Gs::Vector3f c2 = Cross(r0, r1);
+    const float sign = (Dot(r0, c0) < 0.0f) ? -1.0f : 1.0f;
+    const float n[9] = {
+        c0.x * sign, c0.y * sign, c0.z * sign,
+        c1.x * sign, c1.y * sign, c1.z * sign,
+        c2.x * sign, c2.y * sign, c2.z * sign
+    };
+    
+    const std::size_t vertexCount = meshData.vertices.size();
+    RunKernelChunks(threadPool, vertexCount, GetKernelChunkCount(threadPool, vertexCount),
+                    [&](std::size_t begin, std::size_t end, std::size_t) {
+        TransformVertices(meshData.vertices.data() + begin, end - begin, m, n);
+    });
 }
 
-MeshData GeometryGenerator::MergeMeshes(const MeshData* meshes, std::size_t meshCount) {
+MeshData GeometryGenerator::MergeMeshes(const MeshData* meshes, std::size_t meshCount, ThreadPool* threadPool) {
     MeshData result;
     
-    uint32_t vertexOffset = 0;
+    // Prefix sums give every mesh its destination range up front
+    std::vector<std::size_t> vertexOffsets(meshCount + 1, 0);
+    std::vector<std::size_t> indexOffsets(meshCount + 1, 0);
+    for (std::size_t i = 0; i < meshCount; ++i) {
+        vertexOffsets[i + 1] = vertexOffsets[i] + meshes[i].vertices.size();
+        indexOffsets[i + 1] = indexOffsets[i] + meshes[i].indices.size();
+    }
     
+    if (vertexOffsets[meshCount] > std::numeric_limits<std::uint32_t>::max()) {
+        std::cerr << "Merged mesh exceeds the 32-bit index range" << std::endl;
+        return result;
+    }
+    
+    result.vertices.reserve(vertexOffsets[meshCount]);
     for (std::size_t i = 0; i < meshCount; ++i) {
-        const auto& mesh = meshes[i];
-        // Add vertices
-        result.vertices.insert(result.vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        result.vertices.insert(result.vertices.end(), meshes[i].vertices.begin(), meshes[i].vertices.end());
+    }
+    
+    // Chunks split the merged index range evenly, regardless of how large each source mesh is
+    const std::size_t indexCount = indexOffsets[meshCount];
+    result.indices.resize(indexCount);
+    RunKernelChunks(threadPool, indexCount, GetKernelChunkCount(threadPool, indexCount),
+                    [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::size_t mesh = static_cast<std::size_t>(
+            std::upper_bound(indexOffsets.begin(), indexOffsets.end(), begin) - indexOffsets.begin()) - 1;
         
-        // Add indices with offset
-        for (uint32_t index : mesh.indices) {
-            result.indices.push_back(index + vertexOffset);
+        std::size_t position = begin;
+        while (position < end) {
+            const std::size_t meshEnd = std::min(end, indexOffsets[mesh + 1]);
+            const std::uint32_t* source = meshes[mesh].indices.data() + (position - indexOffsets[mesh]);
+            std::uint32_t* destination = result.indices.data() + position;
+            const std::uint32_t vertexOffset = static_cast<std::uint32_t>(vertexOffsets[mesh]);
+            for (std::size_t i = 0, count = meshEnd - position; i < count; ++i) {
+                destination[i] = source[i] + vertexOffset;
+            }
+            position = meshEnd;
+            ++mesh;
         }
-        
-        vertexOffset += static_cast<uint32_t>(mesh.vertices.size());
-    }
+    });
     
     return result;
 }
 
-void GeometryGenerator::GenerateNormals(MeshData& meshData, bool smooth) {
+void GeometryGenerator::GenerateNormals(MeshData& meshData, bool smooth, ThreadPool* threadPool) {
     // Reset all normals
     for (auto& vertex : meshData.vertices) {
         vertex.normal = { 0.0f, 0.0f, 0.0f };
     }
     
-    // Calculate face normals and accumulate
-    for (size_t i = 0; i < meshData.indices.size(); i += 3) {
-        uint32_t i0 = meshData.indices[i];
-        uint32_t i1 = meshData.indices[i + 1];
-        uint32_t i2 = meshData.indices[i + 2];
-        
-        Gs::Vector3f normal = CalculateFaceNormal(
-            meshData.vertices[i0].position,
-            meshData.vertices[i1].position,
-            meshData.vertices[i2].position
-        );
-        
-        if (smooth) {
-            meshData.vertices[i0].normal = meshData.vertices[i0].normal + normal;
-            meshData.vertices[i1].normal = meshData.vertices[i1].normal + normal;
-            meshData.vertices[i2].normal = meshData.vertices[i2].normal + normal;
-        } else {
+    const std::size_t triangleCount = meshData.indices.size() / 3;
+    
+    if (!smooth) {
+        // Shared vertices take the normal of the last triangle using them, so this stays serial
+        for (std::size_t i = 0; i < triangleCount * 3; i += 3) {
+            uint32_t i0 = meshData.indices[i];
+            uint32_t i1 = meshData.indices[i + 1];
+            uint32_t i2 = meshData.indices[i + 2];
+            
+            Gs::Vector3f normal = CalculateFaceNormal(
+                meshData.vertices[i0].position,
+                meshData.vertices[i1].position,
+                meshData.vertices[i2].position
+            );
+            
             meshData.vertices[i0].normal = normal;
             meshData.vertices[i1].normal = normal;
             meshData.vertices[i2].normal = normal;
         }
+        return;
     }
     
-    // Normalize all normals
-    if (smooth) {
-        for (auto& vertex : meshData.vertices) {
-            vertex.normal = Normalize(vertex.normal);
+    // The first chunk accumulates into the vertices, every other chunk into its own buffer, so
+    // no two threads write the same normal and the merge order is fixed
+    const std::size_t vertexCount = meshData.vertices.size();
+    const std::size_t chunkCount = GetKernelChunkCount(threadPool, triangleCount);
+    std::vector<float> partialNormals((chunkCount - 1) * vertexCount * 3, 0.0f);
+    
+    RunKernelChunks(threadPool, triangleCount, chunkCount, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        float* accumulated = (chunk > 0) ? &partialNormals[(chunk - 1) * vertexCount * 3] : nullptr;
+        for (std::size_t triangle = begin; triangle < end; ++triangle) {
+            const uint32_t* corners = &meshData.indices[triangle * 3];
+            Gs::Vector3f normal = CalculateFaceNormal(
+                meshData.vertices[corners[0]].position,
+                meshData.vertices[corners[1]].position,
+                meshData.vertices[corners[2]].position
+            );
+            
+            for (int corner = 0; corner < 3; ++corner) {
+                if (accumulated) {
+                    float* target = accumulated + static_cast<std::size_t>(corners[corner]) * 3;
+                    target[0] += normal.x;
+                    target[1] += normal.y;
+                    target[2] += normal.z;
+                } else {
+                    Gs::Vector3f& target = meshData.vertices[corners[corner]].normal;
+                    target = target + normal;
+                }
+            }
         }
-    }
+    });
+    
+    // Merge the chunk buffers and normalize
+    RunKernelChunks(threadPool, vertexCount, GetKernelChunkCount(threadPool, vertexCount),
+                    [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Gs::Vector3f& normal = meshData.vertices[i].normal;
+            for (std::size_t chunk = 1; chunk < chunkCount; ++chunk) {
+                const float* partial = &partialNormals[((chunk - 1) * vertexCount + i) * 3];
+                normal = { normal.x + partial[0], normal.y + partial[1], normal.z + partial[2] };
+            }
+            normal = Normalize(normal);
+        }
+    });
 }
 
 void GeometryGenerator::GenerateTangents(MeshData& mesh) {
@@ -985,4 +1199,10 @@ bool GeometryGenerator::ValidateMesh(const MeshData& mesh) {
     return true;
 }
 
+// === Private Helper Functions ===
+
+Gs::Vector3f GeometryGenerator::CalculateFaceNormal(const Gs::Vector3f& v0, const Gs::Vector3f& v1, const Gs::Vector3f& v2) {
+    return CalculateNormal(v0, v1, v2);
+}
+
 } // namespace RenderingPlugin
\ No newline at end of file
@@ -0,0 +1,634 @@
+/**
+ * @file GpuCulling.cpp
+ * @brief Implementation of GpuCulling class
+ */
+
+#include "../include/GpuCulling.h"
+#include "../include/RenderCommands.h"
+#include "../include/SceneStore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace RenderingPlugin {
+
+namespace {
+
+// Largest update the command buffer records in-stream
+constexpr std::uint64_t kMaxUpdateSize = 65536;
+
+constexpr std::uint32_t kMinObjectCapacity = 1024;
+constexpr std::uint32_t kMinGroupCapacity = 64;
+constexpr std::uint32_t kWorkGroupSize = 64;
+
+// One invocation per object: frustum test, then append the world matrix to the group's range
+const char* const kCullShaderSource = R"(#version 430
+layout(local_size_x = 64) in;
+
+struct ObjectData {
+    mat4 world;
+    vec4 sphere;
+    uvec4 info;
+};
+
+struct DrawArgs {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std140, binding = 0) uniform CullParams {
+    vec4 planes[6];
+    uvec4 counts;
+};
+
+layout(std430, binding = 1) readonly buffer Objects {
+    ObjectData objects[];
+};
+
+layout(std430, binding = 2) buffer Draws {
+    DrawArgs draws[];
+};
+
+layout(std430, binding = 3) writeonly buffer Instances {
+    mat4 instances[];
+};
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= counts.x) {
+        return;
+    }
+    
+    vec4 sphere = objects[index].sphere;
+    if (sphere.w < 0.0) {
+        return;
+    }
+    for (int plane = 0; plane < 6; ++plane) {
+        if (dot(planes[plane].xyz, sphere.xyz) + planes[plane].w + sphere.w < 0.0) {
+            return;
+        }
+    }
+    
+    uint group = objects[index].info.x;
+    uint slot = atomicAdd(draws[group].instanceCount, 1u);
+    instances[draws[group].firstInstance + slot] = objects[index].world;
+}
+)";
+
+std::uint32_t GrowCapacity(std::uint32_t current, std::uint32_t required, std::uint32_t minimum) {
+    std::uint32_t capacity = std::max(current, minimum);
+    while (capacity < required) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+} // namespace
+
+static_assert(sizeof(LLGL::DrawIndexedIndirectArguments) == 20, "Draw records must match the culling shader");
+
+// === GpuCulling Implementation ===
+
+GpuCulling::GpuCulling(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager)
+    : renderSystem_(renderSystem)
+    , resourceManager_(resourceManager)
+    , supported_(false)
+    , enabled_(true)
+    , shaderId_(0)
+    , pipelineLayoutId_(0)
+    , pipelineId_(0)
+    , paramsBuffer_(nullptr)
+    , objectBuffer_(nullptr)
+    , drawBuffer_(nullptr)
+    , instanceBuffer_(nullptr)
+    , resourceHeap_(nullptr)
+    , objectCapacity_(0)
+    , groupCapacity_(0)
+    , mirrorValid_(false) {
+    
+    if (!renderSystem_ || !resourceManager_) {
+        throw std::invalid_argument("RenderSystem and ResourceManager cannot be null");
+    }
+    
+    if (IsSupported(renderSystem_)) {
+        supported_ = CreatePipeline();
+        if (!supported_) {
+            std::cerr << "GPU culling pipeline unavailable, culling on the CPU" << std::endl;
+        }
+    }
+}
+
+GpuCulling::~GpuCulling() {
+    ReleaseBuffers();
+    
+    if (pipelineId_) {
+        resourceManager_->ReleasePipelineState(pipelineId_);
+    }
+    if (pipelineLayoutId_) {
+        resourceManager_->ReleasePipelineLayout(pipelineLayoutId_);
+    }
+    if (shaderId_) {
+        resourceManager_->ReleaseShader(shaderId_);
+    }
+}
+
+bool GpuCulling::IsSupported(const LLGL::RenderSystem* renderSystem) {
+    if (!renderSystem) {
+        return false;
+    }
+    
+    const LLGL::RenderingCapabilities& caps = renderSystem->GetRenderingCaps();
+    const LLGL::RenderingFeatures& features = caps.features;
+    if (!features.hasComputeShaders || !features.hasStorageBuffers ||
+        !features.hasIndirectDrawing || !features.hasOffsetInstancing) {
+        return false;
+    }
+    
+    // The built-in culling shader needs GLSL 4.30 for compute and storage blocks
+    return std::find(caps.shadingLanguages.begin(), caps.shadingLanguages.end(),
+                     LLGL::ShadingLanguage::GLSL_430) != caps.shadingLanguages.end();
+}
+
+bool GpuCulling::IsGpuCullingActive() const {
+    return supported_ && enabled_;
+}
+
+void GpuCulling::SetGpuCullingEnabled(bool enabled) {
+    if (enabled && !enabled_) {
+        // Scene changes were not tracked while disabled
+        ResetMirror();
+    }
+    enabled_ = enabled;
+}
+
+void GpuCulling::SetReleaseScheduler(ReleaseScheduler scheduler) {
+    releaseScheduler_ = std::move(scheduler);
+}
+
+// === Frame ===
+
+void GpuCulling::Cull(RenderCommands& commands, SceneStore& scene) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    stats_.gpuCulling = IsGpuCullingActive();
+    stats_.objectCount = scene.GetObjectCount();
+    stats_.uploadedObjects = 0;
+    stats_.uploadedBytes = 0;
+    
+    if (!stats_.gpuCulling) {
+        scene.Cull();
+        stats_.drawGroups = 0;
+        stats_.cullCpuTimeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        return;
+    }
+    
+    if (!SyncScene(commands, scene)) {
+        // Without buffers nothing is drawn this frame; retry the full upload next frame
+        ResetMirror();
+        return;
+    }
+    stats_.drawGroups = groups_.size();
+    
+    const std::uint32_t objectCount = static_cast<std::uint32_t>(scene.GetObjectCount());
+    if (objectCount == 0) {
+        stats_.cullCpuTimeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        return;
+    }
+    
+    // Reset the instance counts; the culling pass counts them up again
+    drawRecords_.resize(groups_.size());
+    for (std::size_t i = 0; i < groups_.size(); ++i) {
+        const DrawGroup& group = groups_[i];
+        LLGL::DrawIndexedIndirectArguments& record = drawRecords_[i];
+        record.numIndices = group.draw.indexCount;
+        record.numInstances = 0;
+        record.firstIndex = group.draw.firstIndex;
+        // Non-indexed groups are drawn with DrawIndirect, which reads firstInstance from this field
+        record.vertexOffset = group.draw.indexBufferId ? 0 : static_cast<std::int32_t>(group.firstInstance);
+        record.firstInstance = group.firstInstance;
+    }
+    UploadBuffer(commands, drawBuffer_, drawRecords_.data(), drawRecords_.size() * sizeof(LLGL::DrawIndexedIndirectArguments), 0);
+    
+    CullParams params;
+    std::memcpy(params.planes, scene.GetFrustumPlanes(), sizeof(params.planes));
+    params.objectCount = objectCount;
+    params.padding[0] = params.padding[1] = params.padding[2] = 0;
+    UploadBuffer(commands, paramsBuffer_, &params, sizeof(params), 0);
+    
+    commands.BindPipelineState(resourceManager_->GetPipelineState(pipelineId_));
+    commands.BindResourceHeap(resourceHeap_);
+    commands.Dispatch((objectCount + kWorkGroupSize - 1) / kWorkGroupSize);
+    
+    // Draw records and instances are consumed by indirect draws and vertex fetch
+    LLGL::Buffer* const outputs[] = { drawBuffer_, instanceBuffer_ };
+    commands.GetCommandBuffer()->ResourceBarrier(2, outputs, 0, nullptr);
+    
+    stats_.cullCpuTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+void GpuCulling::Submit(RenderCommands& commands, SceneStore& scene, LLGL::PipelineState* defaultPipeline) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    const std::uint32_t drawCallsBefore = commands.GetStatistics().drawCalls;
+    
+    if (!IsGpuCullingActive() || !mirrorValid_) {
+        if (!IsGpuCullingActive()) {
+            scene.Submit(commands, defaultPipeline);
+        }
+        stats_.drawCommands = commands.GetStatistics().drawCalls - drawCallsBefore;
+        stats_.submitCpuTimeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        return;
+    }
+    
+    // Only queues the camera block; each indirect draw binds it after the pipeline and material
+    // heap it follows, so rebinding either cannot leave the block unbound
+    if (scene.GetObjectCount() > 0) {
+        commands.SetCameraMatrices(scene.GetViewMatrix(), scene.GetProjectionMatrix());
+    }
+    
+    // One indirect draw per run of adjacent groups that share pipeline, heap and buffers
+    std::size_t runStart = 0;
+    while (runStart < groups_.size() && scene.GetObjectCount() > 0) {
+        const MeshDraw& draw = groups_[runStart].draw;
+        std::size_t runEnd = runStart + 1;
+        while (runEnd < groups_.size()) {
+            const MeshDraw& next = groups_[runEnd].draw;
+            if (next.pipelineStateId != draw.pipelineStateId || next.resourceHeapId != draw.resourceHeapId ||
+                next.vertexBufferId != draw.vertexBufferId || next.indexBufferId != draw.indexBufferId) {
+                break;
+            }
+            ++runEnd;
+        }
+        
+        LLGL::PipelineState* pipelineState = draw.pipelineStateId
+            ? resourceManager_->GetPipelineState(draw.pipelineStateId)
+            : defaultPipeline;
+        LLGL::BufferArray* bufferArray = GetBufferArray(draw.vertexBufferId);
+        LLGL::Buffer* indexBuffer = draw.indexBufferId ? resourceManager_->GetIndexBuffer(draw.indexBufferId) : nullptr;
+        
+        if (pipelineState && bufferArray && (indexBuffer || !draw.indexBufferId)) {
+            commands.BindPipelineState(pipelineState);
+            if (LLGL::ResourceHeap* resourceHeap = resourceManager_->GetResourceHeap(draw.resourceHeapId)) {
+                commands.BindResourceHeap(resourceHeap);
+            }
+            commands.BindVertexBufferArray(bufferArray);
+            
+            const std::uint64_t offset = runStart * sizeof(LLGL::DrawIndexedIndirectArguments);
+            const std::uint32_t drawCount = static_cast<std::uint32_t>(runEnd - runStart);
+            if (indexBuffer) {
+                commands.BindIndexBuffer(indexBuffer);
+                commands.DrawIndexedIndirect(drawBuffer_, offset, drawCount);
+            } else {
+                commands.DrawIndirect(drawBuffer_, offset, drawCount, sizeof(LLGL::DrawIndexedIndirectArguments));
+            }
+        }
+        
+        runStart = runEnd;
+    }
+    
+    stats_.drawCommands = commands.GetStatistics().drawCalls - drawCallsBefore;
+    stats_.submitCpuTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+// === Statistics ===
+
+const GpuCullingStats& GpuCulling::GetStatistics() const {
+    return stats_;
+}
+
+// === Private Methods ===
+
+bool GpuCulling::CreatePipeline() {
+    shaderId_ = resourceManager_->CreateShader(LLGL::ShaderType::Compute, kCullShaderSource);
+    LLGL::Shader* shader = resourceManager_->GetShader(shaderId_);
+    if (!shader) {
+        return false;
+    }
+    if (const LLGL::Report* report = shader->GetReport()) {
+        if (report->HasErrors()) {
+            std::cerr << "GPU culling shader errors:\n" << report->GetText() << std::endl;
+            return false;
+        }
+    }
+    
+    LLGL::PipelineLayoutDescriptor layoutDesc;
+    layoutDesc.heapBindings = {
+        LLGL::BindingDescriptor("CullParams", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::ComputeStage, 0),
+        LLGL::BindingDescriptor("Objects", LLGL::ResourceType::Buffer, LLGL::BindFlags::Storage, LLGL::StageFlags::ComputeStage, 1),
+        LLGL::BindingDescriptor("Draws", LLGL::ResourceType::Buffer, LLGL::BindFlags::Storage, LLGL::StageFlags::ComputeStage, 2),
+        LLGL::BindingDescriptor("Instances", LLGL::ResourceType::Buffer, LLGL::BindFlags::Storage, LLGL::StageFlags::ComputeStage, 3)
+    };
+    pipelineLayoutId_ = resourceManager_->CreatePipelineLayout(layoutDesc);
+    if (!pipelineLayoutId_) {
+        return false;
+    }
+    
+    LLGL::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.pipelineLayout = resourceManager_->GetPipelineLayout(pipelineLayoutId_);
+    pipelineDesc.computeShader = shader;
+    pipelineId_ = resourceManager_->CreateComputePipelineState(pipelineDesc);
+    LLGL::PipelineState* pipeline = resourceManager_->GetPipelineState(pipelineId_);
+    if (!pipeline) {
+        return false;
+    }
+    if (const LLGL::Report* report = pipeline->GetReport()) {
+        if (report->HasErrors()) {
+            std::cerr << "GPU culling pipeline errors:\n" << report->GetText() << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GpuCulling::EnsureCapacity(std::uint32_t objectCount, std::uint32_t groupCount) {
+    if (resourceHeap_ && objectCount <= objectCapacity_ && groupCount <= groupCapacity_) {
+        return true;
+    }
+    
+    const std::uint32_t objectCapacity = GrowCapacity(objectCapacity_, objectCount, kMinObjectCapacity);
+    const std::uint32_t groupCapacity = GrowCapacity(groupCapacity_, groupCount, kMinGroupCapacity);
+    
+    // Frames in flight may still read the old buffers
+    ReleaseBuffers();
+    
+    try {
+        LLGL::BufferDescriptor paramsDesc;
+        paramsDesc.size = sizeof(CullParams);
+        paramsDesc.bindFlags = LLGL::BindFlags::ConstantBuffer;
+        paramsBuffer_ = renderSystem_->CreateBuffer(paramsDesc);
+        
+        LLGL::BufferDescriptor objectDesc;
+        objectDesc.size = static_cast<std::uint64_t>(objectCapacity) * sizeof(ObjectRecord);
+        objectDesc.stride = sizeof(ObjectRecord);
+        objectDesc.bindFlags = LLGL::BindFlags::Storage;
+        objectBuffer_ = renderSystem_->CreateBuffer(objectDesc);
+        
+        LLGL::BufferDescriptor drawDesc;
+        drawDesc.size = static_cast<std::uint64_t>(groupCapacity) * sizeof(LLGL::DrawIndexedIndirectArguments);
+        drawDesc.stride = sizeof(LLGL::DrawIndexedIndirectArguments);
+        drawDesc.bindFlags = LLGL::BindFlags::Storage | LLGL::BindFlags::IndirectBuffer;
+        drawBuffer_ = renderSystem_->CreateBuffer(drawDesc);
+        
+        LLGL::BufferDescriptor instanceDesc;
+        instanceDesc.size = static_cast<std::uint64_t>(objectCapacity) * sizeof(Gs::Matrix4f);
+        instanceDesc.stride = sizeof(Gs::Matrix4f);
+        instanceDesc.bindFlags = LLGL::BindFlags::Storage | LLGL::BindFlags::VertexBuffer;
+        instanceDesc.vertexAttribs = RenderCommands::GetInstanceVertexFormat().attributes;
+        instanceBuffer_ = renderSystem_->CreateBuffer(instanceDesc);
+        
+        if (!paramsBuffer_ || !objectBuffer_ || !drawBuffer_ || !instanceBuffer_) {
+            std::cerr << "Failed to create GPU culling buffers for " << objectCapacity << " objects" << std::endl;
+            ReleaseBuffers();
+            return false;
+        }
+        
+        const std::vector<LLGL::ResourceViewDescriptor> resourceViews = {
+            paramsBuffer_, objectBuffer_, drawBuffer_, instanceBuffer_
+        };
+        LLGL::ResourceHeapDescriptor heapDesc;
+        heapDesc.pipelineLayout = resourceManager_->GetPipelineLayout(pipelineLayoutId_);
+        heapDesc.numResourceViews = static_cast<std::uint32_t>(resourceViews.size());
+        resourceHeap_ = renderSystem_->CreateResourceHeap(heapDesc, resourceViews);
+        if (!resourceHeap_) {
+            std::cerr << "Failed to create GPU culling resource heap" << std::endl;
+            ReleaseBuffers();
+            return false;
+        }
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Exception creating GPU culling buffers: " << e.what() << std::endl;
+        ReleaseBuffers();
+        return false;
+    }
+    
+    objectCapacity_ = objectCapacity;
+    groupCapacity_ = groupCapacity;
+    return true;
+}
+
+void GpuCulling::ReleaseBuffers() {
+    std::vector<LLGL::Buffer*> buffers;
+    for (LLGL::Buffer* buffer : { paramsBuffer_, objectBuffer_, drawBuffer_, instanceBuffer_ }) {
+        if (buffer) {
+            buffers.push_back(buffer);
+        }
+    }
+    std::vector<LLGL::BufferArray*> bufferArrays;
+    for (const auto& entry : bufferArrays_) {
+        bufferArrays.push_back(entry.second);
+    }
+    LLGL::ResourceHeap* resourceHeap = resourceHeap_;
+    
+    paramsBuffer_ = nullptr;
+    objectBuffer_ = nullptr;
+    drawBuffer_ = nullptr;
+    instanceBuffer_ = nullptr;
+    resourceHeap_ = nullptr;
+    bufferArrays_.clear();
+    objectCapacity_ = 0;
+    groupCapacity_ = 0;
+    
+    if (buffers.empty() && bufferArrays.empty() && !resourceHeap) {
+        return;
+    }
+    
+    // Captures no member, so the release may run after this instance is destroyed
+    LLGL::RenderSystem* renderSystem = renderSystem_;
+    auto release = [renderSystem, buffers, bufferArrays, resourceHeap]() {
+        // Heap and buffer arrays before the buffers they reference
+        if (resourceHeap) {
+            renderSystem->Release(*resourceHeap);
+        }
+        for (LLGL::BufferArray* bufferArray : bufferArrays) {
+            renderSystem->Release(*bufferArray);
+        }
+        for (LLGL::Buffer* buffer : buffers) {
+            renderSystem->Release(*buffer);
+        }
+    };
+    
+    if (releaseScheduler_) {
+        releaseScheduler_(release);
+    } else {
+        release();
+    }
+}
+
+bool GpuCulling::SyncScene(RenderCommands& commands, SceneStore& scene) {
+    const std::uint32_t objectCount = static_cast<std::uint32_t>(scene.GetObjectCount());
+    
+    std::uint32_t dirtyBegin = 0;
+    std::uint32_t dirtyEnd = 0;
+    const bool changed = scene.TakeDirtyRange(dirtyBegin, dirtyEnd);
+    if (!mirrorValid_) {
+        // Everything the GPU holds is stale
+        ResetMirror();
+        dirtyBegin = 0;
+        dirtyEnd = objectCount;
+    } else if (!changed) {
+        return true;
+    }
+    
+    // Removed objects leave their groups
+    const std::uint32_t oldCount = static_cast<std::uint32_t>(objectGroups_.size());
+    for (std::uint32_t i = std::max(dirtyBegin, objectCount); i < std::min(dirtyEnd, oldCount); ++i) {
+        --groups_[objectGroups_[i]].objectCount;
+    }
+    objectGroups_.resize(objectCount, UINT32_MAX);
+    
+    // Changed objects may have moved to another group
+    const std::size_t groupCount = groups_.size();
+    const std::uint32_t uploadEnd = std::min(dirtyEnd, objectCount);
+    for (std::uint32_t i = dirtyBegin; i < uploadEnd; ++i) {
+        if (objectGroups_[i] != UINT32_MAX) {
+            --groups_[objectGroups_[i]].objectCount;
+        }
+        const std::uint32_t group = AcquireGroup(scene.GetDraw(i));
+        ++groups_[group].objectCount;
+        objectGroups_[i] = group;
+    }
+    
+    // Groups are numbered in state order so that Submit can merge neighbours into one multi-draw.
+    // New groups and a majority of empty ones renumber them, which re-uploads every object.
+    std::size_t emptyGroups = 0;
+    for (const DrawGroup& group : groups_) {
+        emptyGroups += (group.objectCount == 0) ? 1 : 0;
+    }
+    const bool renumber = groups_.size() > groupCount ||
+                          (emptyGroups > kMinGroupCapacity && emptyGroups * 2 > groups_.size());
+    if (renumber) {
+        std::vector<std::uint32_t> remap(groups_.size(), UINT32_MAX);
+        std::vector<DrawGroup> sortedGroups;
+        auto it = groupLookup_.begin();
+        while (it != groupLookup_.end()) {
+            if (groups_[it->second].objectCount == 0) {
+                it = groupLookup_.erase(it);
+                continue;
+            }
+            remap[it->second] = static_cast<std::uint32_t>(sortedGroups.size());
+            sortedGroups.push_back(groups_[it->second]);
+            it->second = remap[it->second];
+            ++it;
+        }
+        groups_.swap(sortedGroups);
+        for (std::uint32_t& group : objectGroups_) {
+            group = remap[group];
+        }
+    }
+    
+    // Each group owns a range of the instance buffer large enough for all of its objects
+    std::uint32_t firstInstance = 0;
+    for (DrawGroup& group : groups_) {
+        group.firstInstance = firstInstance;
+        firstInstance += group.objectCount;
+    }
+    
+    const bool fresh = !resourceHeap_ || objectCount > objectCapacity_ || groups_.size() > groupCapacity_;
+    if (!EnsureCapacity(objectCount, static_cast<std::uint32_t>(groups_.size()))) {
+        return false;
+    }
+    
+    // Object records of the changed range, or of all objects if the buffers or groups are new
+    const bool uploadAll = fresh || renumber;
+    const std::uint32_t uploadBegin = uploadAll ? 0 : std::min(dirtyBegin, uploadEnd);
+    const std::uint32_t uploadCount = (uploadAll ? objectCount : uploadEnd) - uploadBegin;
+    staging_.resize(uploadCount);
+    for (std::uint32_t i = 0; i < uploadCount; ++i) {
+        const std::uint32_t index = uploadBegin + i;
+        ObjectRecord& record = staging_[i];
+        std::memcpy(record.world, &scene.GetWorldMatrix(index), sizeof(record.world));
+        
+        Gs::Vector3f center;
+        float radius = 0.0f;
+        scene.GetWorldBounds(index, center, radius);
+        record.sphere[0] = center.x;
+        record.sphere[1] = center.y;
+        record.sphere[2] = center.z;
+        record.sphere[3] = scene.IsEnabledAt(index) ? radius : -1.0f;
+        record.group = objectGroups_[index];
+        record.padding[0] = record.padding[1] = record.padding[2] = 0;
+    }
+    
+    if (uploadCount > 0) {
+        const std::uint64_t size = static_cast<std::uint64_t>(uploadCount) * sizeof(ObjectRecord);
+        const std::uint64_t offset = static_cast<std::uint64_t>(uploadBegin) * sizeof(ObjectRecord);
+        if (fresh) {
+            // Nothing reads new buffers yet, so write them directly instead of through the command stream
+            renderSystem_->WriteBuffer(*objectBuffer_, offset, staging_.data(), size);
+            stats_.uploadedBytes += size;
+        } else {
+            UploadBuffer(commands, objectBuffer_, staging_.data(), size, offset);
+        }
+        stats_.uploadedObjects = uploadCount;
+    }
+    
+    mirrorValid_ = true;
+    return true;
+}
+
+void GpuCulling::ResetMirror() {
+    groups_.clear();
+    groupLookup_.clear();
+    objectGroups_.clear();
+    mirrorValid_ = false;
+}
+
+std::uint32_t GpuCulling::AcquireGroup(const MeshDraw& draw) {
+    const GroupKey key(draw.pipelineStateId, draw.resourceHeapId, draw.vertexBufferId,
+                       draw.indexBufferId, draw.firstIndex, draw.indexCount);
+    auto it = groupLookup_.find(key);
+    if (it != groupLookup_.end()) {
+        return it->second;
+    }
+    
+    const std::uint32_t group = static_cast<std::uint32_t>(groups_.size());
+    DrawGroup entry;
+    entry.draw = draw;
+    groups_.push_back(entry);
+    groupLookup_.emplace(key, group);
+    return group;
+}
+
+void GpuCulling::UploadBuffer(RenderCommands& commands, LLGL::Buffer* buffer, const void* data,
+                              std::uint64_t size, std::uint64_t offset) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::uint64_t written = 0; written < size; written += kMaxUpdateSize) {
+        const std::uint64_t chunk = std::min(kMaxUpdateSize, size - written);
+        commands.UpdateBuffer(buffer, bytes + written, static_cast<std::uint32_t>(chunk),
+                              static_cast<std::uint32_t>(offset + written));
+    }
+    stats_.uploadedBytes += size;
+}
+
+LLGL::BufferArray* GpuCulling::GetBufferArray(ResourceId vertexBufferId) {
+    auto it = bufferArrays_.find(vertexBufferId);
+    if (it != bufferArrays_.end()) {
+        return it->second;
+    }
+    
+    LLGL::Buffer* vertexBuffer = resourceManager_->GetVertexBuffer(vertexBufferId);
+    if (!vertexBuffer || !instanceBuffer_) {
+        return nullptr;
+    }
+    
+    LLGL::Buffer* const buffers[] = { vertexBuffer, instanceBuffer_ };
+    LLGL::BufferArray* bufferArray = renderSystem_->CreateBufferArray(2, buffers);
+    if (!bufferArray) {
+        std::cerr << "Failed to create GPU culling buffer array" << std::endl;
+        return nullptr;
+    }
+    
+    bufferArrays_[vertexBufferId] = bufferArray;
+    return bufferArray;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,232 @@
+/**
+ * @file LodChain.cpp
+ * @brief Implementation of LOD chain generation and selection
+ */
+
+#include "../include/LodChain.h"
+#include "../include/MeshOptimizer.h"
+#include <LLGL/Utils/VertexFormat.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace RenderingPlugin {
+
+// === LodChain Implementation ===
+
+MeshDraw LodChain::GetDraw(std::uint32_t level, ResourceId pipelineStateId, ResourceId resourceHeapId) const {
+    MeshDraw draw;
+    draw.vertexBufferId = vertexBufferId;
+    draw.indexBufferId = indexBufferId;
+    draw.pipelineStateId = pipelineStateId;
+    draw.resourceHeapId = resourceHeapId;
+    
+    if (!levels.empty()) {
+        const LodLevel& selected = levels[std::min<std::size_t>(level, levels.size() - 1)];
+        draw.firstIndex = selected.firstIndex;
+        draw.indexCount = selected.indexCount;
+    }
+    return draw;
+}
+
+// === LodGenerator Implementation ===
+
+LodMesh LodGenerator::Generate(const MeshData& meshData, const LodChainSettings& settings) {
+    LodMesh result;
+    result.mesh.vertices = meshData.vertices;
+    
+    Gs::Vector3f minBounds, maxBounds;
+    GeometryGenerator::CalculateBounds(meshData, minBounds, maxBounds);
+    result.boundsCenter = {
+        (minBounds.x + maxBounds.x) * 0.5f,
+        (minBounds.y + maxBounds.y) * 0.5f,
+        (minBounds.z + maxBounds.z) * 0.5f
+    };
+    
+    float radiusSq = 0.0f;
+    for (const Vertex& vertex : meshData.vertices) {
+        const float dx = vertex.position.x - result.boundsCenter.x;
+        const float dy = vertex.position.y - result.boundsCenter.y;
+        const float dz = vertex.position.z - result.boundsCenter.z;
+        radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+    }
+    result.boundsRadius = std::sqrt(radiusSq);
+    
+    // Levels are simplified from their predecessor; result.mesh.indices holds the level being reduced
+    std::vector<std::vector<std::uint32_t>> levelIndices;
+    std::vector<float> levelErrors;
+    levelIndices.push_back(meshData.indices);
+    levelErrors.push_back(0.0f);
+    
+    const float maxError = settings.maxError * result.boundsRadius;
+    while (levelIndices.size() < settings.maxLevels) {
+        const std::vector<std::uint32_t>& previous = levelIndices.back();
+        const std::size_t targetIndexCount = static_cast<std::size_t>(static_cast<float>(previous.size()) * settings.reduction) / 3 * 3;
+        if (targetIndexCount / 3 < settings.minTriangles) {
+            break;
+        }
+        
+        result.mesh.indices = previous;
+        float error = 0.0f;
+        std::vector<std::uint32_t> simplified = MeshOptimizer::Simplify(result.mesh, targetIndexCount,
+                                                                         maxError - levelErrors.back(), &error);
+        
+        // Stop once locked borders/seams or the error budget prevent meaningful reduction
+        if (simplified.size() * 10 > previous.size() * 9) {
+            break;
+        }
+        
+        levelErrors.push_back(levelErrors.back() + error);
+        levelIndices.push_back(std::move(simplified));
+    }
+    
+    std::size_t totalIndices = 0;
+    for (const std::vector<std::uint32_t>& indices : levelIndices) {
+        totalIndices += indices.size();
+    }
+    
+    std::vector<std::uint32_t> combined;
+    combined.reserve(totalIndices);
+    for (std::size_t level = 0; level < levelIndices.size(); ++level) {
+        if (settings.optimizeVertexCache) {
+            result.mesh.indices.swap(levelIndices[level]);
+            MeshOptimizer::OptimizeVertexCache(result.mesh);
+            result.mesh.indices.swap(levelIndices[level]);
+        }
+        
+        LodLevel lodLevel;
+        lodLevel.firstIndex = static_cast<std::uint32_t>(combined.size());
+        lodLevel.indexCount = static_cast<std::uint32_t>(levelIndices[level].size());
+        lodLevel.error = levelErrors[level];
+        result.levels.push_back(lodLevel);
+        
+        combined.insert(combined.end(), levelIndices[level].begin(), levelIndices[level].end());
+    }
+    result.mesh.indices.swap(combined);
+    
+    return result;
+}
+
+LodChain LodGenerator::CreateChain(const LodMesh& lodMesh, ResourceManager& resourceManager) {
+    LodChain chain;
+    if (lodMesh.mesh.IsEmpty() || lodMesh.levels.empty()) {
+        std::cerr << "LOD mesh is empty" << std::endl;
+        return chain;
+    }
+    
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "position", LLGL::Format::RGB32Float });
+    vertexFormat.AppendAttribute({ "normal", LLGL::Format::RGB32Float });
+    vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float });
+    vertexFormat.AppendAttribute({ "color", LLGL::Format::RGB32Float });
+    
+    chain.vertexBufferId = resourceManager.CreateVertexBuffer(lodMesh.mesh.vertices.data(),
+                                                              lodMesh.mesh.vertices.size() * sizeof(Vertex), vertexFormat);
+    chain.indexBufferId = resourceManager.CreateIndexBuffer(lodMesh.mesh.indices.data(),
+                                                            lodMesh.mesh.indices.size() * sizeof(std::uint32_t),
+                                                            LLGL::Format::R32UInt);
+    chain.levels = lodMesh.levels;
+    chain.boundsCenter = lodMesh.boundsCenter;
+    chain.boundsRadius = lodMesh.boundsRadius;
+    
+    if (!chain.IsValid()) {
+        ReleaseChain(chain, resourceManager);
+    }
+    return chain;
+}
+
+void LodGenerator::ReleaseChain(LodChain& chain, ResourceManager& resourceManager) {
+    if (chain.vertexBufferId != 0) {
+        resourceManager.ReleaseBuffer(chain.vertexBufferId);
+    }
+    if (chain.indexBufferId != 0) {
+        resourceManager.ReleaseBuffer(chain.indexBufferId);
+    }
+    chain = LodChain();
+}
+
+// === LodSelector Implementation ===
+
+LodSelector::LodSelector()
+    : cameraPosition_(0, 0, 0)
+    , pixelsPerUnit_(540.0f)
+    , pixelError_(1.0f) {
+}
+
+void LodSelector::SetCamera(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix, float viewportHeight) {
+    // Rigid view matrix: the camera sits at -R^T * t
+    const float tx = viewMatrix.At(0, 3);
+    const float ty = viewMatrix.At(1, 3);
+    const float tz = viewMatrix.At(2, 3);
+    cameraPosition_ = {
+        -(viewMatrix.At(0, 0) * tx + viewMatrix.At(1, 0) * ty + viewMatrix.At(2, 0) * tz),
+        -(viewMatrix.At(0, 1) * tx + viewMatrix.At(1, 1) * ty + viewMatrix.At(2, 1) * tz),
+        -(viewMatrix.At(0, 2) * tx + viewMatrix.At(1, 2) * ty + viewMatrix.At(2, 2) * tz)
+    };
+    
+    // At(1, 1) is cot(fovY / 2), mapping view-space height at distance 1 to half the viewport
+    pixelsPerUnit_ = std::abs(projectionMatrix.At(1, 1)) * viewportHeight * 0.5f;
+}
+
+void LodSelector::SetPixelError(float pixels) {
+    pixelError_ = std::max(pixels, 0.0f);
+}
+
+std::uint32_t LodSelector::SelectLevel(const std::vector<LodLevel>& levels, const Gs::Vector3f& worldCenter,
+                                       float worldRadius, float worldScale) const {
+    if (levels.size() < 2) {
+        return 0;
+    }
+    
+    // Measure from the nearest point of the bounding sphere, so no part of the mesh exceeds the threshold
+    const float dx = worldCenter.x - cameraPosition_.x;
+    const float dy = worldCenter.y - cameraPosition_.y;
+    const float dz = worldCenter.z - cameraPosition_.z;
+    const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) - worldRadius;
+    if (distance <= 0.0f) {
+        return 0;
+    }
+    if (worldScale <= 0.0f) {
+        return static_cast<std::uint32_t>(levels.size() - 1);
+    }
+    
+    const float maxLevelError = pixelError_ * distance / (pixelsPerUnit_ * worldScale);
+    std::uint32_t selected = 0;
+    for (std::uint32_t level = 1; level < levels.size() && levels[level].error <= maxLevelError; ++level) {
+        selected = level;
+    }
+    return selected;
+}
+
+std::uint32_t LodSelector::SelectLevel(const LodChain& chain, const Gs::Matrix4f& worldMatrix) const {
+    const Gs::Vector3f& center = chain.boundsCenter;
+    const Gs::Vector3f worldCenter = {
+        worldMatrix.At(0, 0) * center.x + worldMatrix.At(0, 1) * center.y + worldMatrix.At(0, 2) * center.z + worldMatrix.At(0, 3),
+        worldMatrix.At(1, 0) * center.x + worldMatrix.At(1, 1) * center.y + worldMatrix.At(1, 2) * center.z + worldMatrix.At(1, 3),
+        worldMatrix.At(2, 0) * center.x + worldMatrix.At(2, 1) * center.y + worldMatrix.At(2, 2) * center.z + worldMatrix.At(2, 3)
+    };
+    
+    float maxScaleSq = 0.0f;
+    for (int column = 0; column < 3; ++column) {
+        const float scaleSq = worldMatrix.At(0, column) * worldMatrix.At(0, column) +
+                              worldMatrix.At(1, column) * worldMatrix.At(1, column) +
+                              worldMatrix.At(2, column) * worldMatrix.At(2, column);
+        maxScaleSq = std::max(maxScaleSq, scaleSq);
+    }
+    const float scale = std::sqrt(maxScaleSq);
+    
+    return SelectLevel(chain.levels, worldCenter, chain.boundsRadius * scale, scale);
+}
+
+std::uint32_t LodSelector::Apply(RenderObject& renderObject, const LodChain& chain) const {
+    const std::uint32_t level = SelectLevel(chain, renderObject.transform.world);
+    const MeshDraw draw = chain.GetDraw(level);
+    
+    renderObject.vertexBufferId = draw.vertexBufferId;
+    renderObject.indexBufferId = draw.indexBufferId;
+    renderObject.firstIndex = draw.firstIndex;
+    renderObject.indexCount = draw.indexCount;
+    return level;
+}
+
+} // namespace RenderingPlugin
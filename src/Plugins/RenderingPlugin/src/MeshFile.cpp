@@ -0,0 +1,395 @@
+/**
+ * @file MeshFile.cpp
+ * @brief Implementation of MeshFile class
+ */
+
+#include "../include/MeshFile.h"
+#include "../include/GeometryGenerator.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace RenderingPlugin {
+
+namespace {
+
+std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+const char* GetAttributeName(MeshAttribute semantic) {
+    switch (semantic) {
+        case MeshAttribute::Position: return "position";
+        case MeshAttribute::Normal:   return "normal";
+        case MeshAttribute::TexCoord: return "texCoord";
+        case MeshAttribute::Color:    return "color";
+        case MeshAttribute::Tangent:  return "tangent";
+    }
+    return "attribute";
+}
+
+/**
+ * @brief Layout of RenderingPlugin::Vertex, matching GeometryGenerator::CreateBuffersFromMesh
+ */
+const MeshFileAttribute kStandardLayout[] = {
+    { MeshAttribute::Position, LLGL::Format::RGB32Float, static_cast<std::uint32_t>(offsetof(Vertex, position)), 0 },
+    { MeshAttribute::Normal,   LLGL::Format::RGB32Float, static_cast<std::uint32_t>(offsetof(Vertex, normal)),   0 },
+    { MeshAttribute::TexCoord, LLGL::Format::RG32Float,  static_cast<std::uint32_t>(offsetof(Vertex, texCoord)), 0 },
+    { MeshAttribute::Color,    LLGL::Format::RGB32Float, static_cast<std::uint32_t>(offsetof(Vertex, color)),    0 },
+};
+
+const std::uint32_t kStandardAttributeCount = sizeof(kStandardLayout) / sizeof(kStandardLayout[0]);
+const std::uint32_t kMaxAttributes = 16;
+
+bool WritePadding(std::ofstream& file, std::uint64_t targetOffset) {
+    static const char zeros[kMeshFileBlobAlignment] = {};
+    const std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+    if (targetOffset > position) {
+        file.write(zeros, static_cast<std::streamsize>(targetOffset - position));
+    }
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+// === MeshFile Implementation ===
+
+MeshFile::MeshFile()
+    : data_(nullptr)
+    , size_(0)
+    , header_(nullptr)
+    , attributes_(nullptr)
+#if defined(_WIN32)
+    , fileHandle_(nullptr)
+    , mappingHandle_(nullptr)
+#endif
+{
+}
+
+MeshFile::~MeshFile() {
+    Close();
+}
+
+// === Writing ===
+
+bool MeshFile::Write(const std::string& filename, const MeshData& meshData) {
+    if (meshData.IsEmpty()) {
+        std::cerr << "Cannot write empty mesh: " << filename << std::endl;
+        return false;
+    }
+    
+    MeshFileHeader header;
+    header.attributeCount = kStandardAttributeCount;
+    header.vertexStride = sizeof(Vertex);
+    header.vertexCount = meshData.vertices.size();
+    header.indexCount = meshData.indices.size();
+    
+    Gs::Vector3f minBounds, maxBounds;
+    GeometryGenerator::CalculateBounds(meshData, minBounds, maxBounds);
+    header.boundsMin[0] = minBounds.x;
+    header.boundsMin[1] = minBounds.y;
+    header.boundsMin[2] = minBounds.z;
+    header.boundsMax[0] = maxBounds.x;
+    header.boundsMax[1] = maxBounds.y;
+    header.boundsMax[2] = maxBounds.z;
+    
+    // Halve the index blob when every vertex is addressable with 16 bits
+    if (meshData.vertices.size() <= 0x10000) {
+        std::vector<std::uint16_t> indices(meshData.indices.begin(), meshData.indices.end());
+        header.indexSize = sizeof(std::uint16_t);
+        return Write(filename, header, kStandardLayout, meshData.vertices.data(), indices.data());
+    }
+    
+    header.indexSize = sizeof(std::uint32_t);
+    return Write(filename, header, kStandardLayout, meshData.vertices.data(), meshData.indices.data());
+}
+
+bool MeshFile::Write(const std::string& filename, MeshFileHeader header, const MeshFileAttribute* attributes,
+                     const void* vertexData, const void* indexData) {
+    if (!attributes || !vertexData || !indexData || header.attributeCount == 0 ||
+        header.attributeCount > kMaxAttributes || header.vertexStride == 0 ||
+        (header.indexSize != 2 && header.indexSize != 4)) {
+        std::cerr << "Invalid mesh file parameters: " << filename << std::endl;
+        return false;
+    }
+    
+    const std::uint64_t vertexBytes = header.vertexCount * header.vertexStride;
+    const std::uint64_t indexBytes = header.indexCount * header.indexSize;
+    
+    header.magic = kMeshFileMagic;
+    header.version = kMeshFileVersion;
+    header.vertexOffset = AlignUp(sizeof(MeshFileHeader) + header.attributeCount * sizeof(MeshFileAttribute),
+                                  kMeshFileBlobAlignment);
+    header.indexOffset = AlignUp(header.vertexOffset + vertexBytes, kMeshFileBlobAlignment);
+    
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to create mesh file: " << filename << std::endl;
+        return false;
+    }
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(attributes), header.attributeCount * sizeof(MeshFileAttribute));
+    WritePadding(file, header.vertexOffset);
+    file.write(static_cast<const char*>(vertexData), static_cast<std::streamsize>(vertexBytes));
+    WritePadding(file, header.indexOffset);
+    file.write(static_cast<const char*>(indexData), static_cast<std::streamsize>(indexBytes));
+    
+    if (!file) {
+        std::cerr << "Failed to write mesh file: " << filename << std::endl;
+        return false;
+    }
+    
+    std::cout << "Wrote mesh file " << filename << " (" << header.vertexCount << " vertices, "
+              << header.indexCount << " indices)" << std::endl;
+    return true;
+}
+
+// === Loading ===
+
+bool MeshFile::Open(const std::string& filename) {
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Failed to open mesh file: " << filename << std::endl;
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        std::cerr << "Failed to read mesh file size: " << filename << std::endl;
+        return false;
+    }
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        std::cerr << "Failed to map mesh file: " << filename << std::endl;
+        return false;
+    }
+    
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    const int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0) {
+        std::cerr << "Failed to open mesh file: " << filename << std::endl;
+        return false;
+    }
+    
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(file);
+        std::cerr << "Failed to read mesh file size: " << filename << std::endl;
+        return false;
+    }
+    
+    void* view = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) {
+        std::cerr << "Failed to map mesh file: " << filename << std::endl;
+        return false;
+    }
+    
+    size_ = static_cast<std::size_t>(fileStat.st_size);
+#if defined(MADV_WILLNEED)
+    // The blobs are read front to back by the buffer upload; start paging them in now
+    madvise(view, size_, MADV_WILLNEED);
+#endif
+#endif
+
+    data_ = static_cast<const std::uint8_t*>(view);
+    header_ = reinterpret_cast<const MeshFileHeader*>(data_);
+    attributes_ = reinterpret_cast<const MeshFileAttribute*>(data_ + sizeof(MeshFileHeader));
+    
+    if (!Validate()) {
+        std::cerr << "Invalid mesh file: " << filename << std::endl;
+        Close();
+        return false;
+    }
+    
+    return true;
+}
+
+void MeshFile::Close() {
+    if (!data_) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mappingHandle_));
+    CloseHandle(static_cast<HANDLE>(fileHandle_));
+    mappingHandle_ = nullptr;
+    fileHandle_ = nullptr;
+#else
+    munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+    header_ = nullptr;
+    attributes_ = nullptr;
+}
+
+bool MeshFile::IsOpen() const {
+    return data_ != nullptr;
+}
+
+bool MeshFile::CreateBuffers(ResourceManager& resourceManager, ResourceId& vertexBufferId, ResourceId& indexBufferId) const {
+    vertexBufferId = 0;
+    indexBufferId = 0;
+    
+    if (!IsOpen()) {
+        return false;
+    }
+    
+    // The mapped blobs go to the driver as-is; no staging copy is made on our side
+    vertexBufferId = resourceManager.CreateVertexBuffer(GetVertexData(), header_->vertexCount * header_->vertexStride,
+                                                        GetVertexFormat());
+    if (vertexBufferId == 0) {
+        return false;
+    }
+    
+    indexBufferId = resourceManager.CreateIndexBuffer(GetIndexData(), header_->indexCount * header_->indexSize,
+                                                      GetIndexFormat());
+    if (indexBufferId == 0) {
+        resourceManager.ReleaseBuffer(vertexBufferId);
+        vertexBufferId = 0;
+        return false;
+    }
+    
+    return true;
+}
+
+bool MeshFile::ToMeshData(MeshData& meshData) const {
+    if (!IsOpen()) {
+        return false;
+    }
+    
+    if (header_->vertexStride != sizeof(Vertex) || header_->attributeCount != kStandardAttributeCount ||
+        std::memcmp(attributes_, kStandardLayout, sizeof(kStandardLayout)) != 0) {
+        std::cerr << "Mesh file does not use the standard vertex layout" << std::endl;
+        return false;
+    }
+    
+    meshData.vertices.resize(static_cast<std::size_t>(header_->vertexCount));
+    std::memcpy(meshData.vertices.data(), GetVertexData(), meshData.vertices.size() * sizeof(Vertex));
+    
+    meshData.indices.resize(static_cast<std::size_t>(header_->indexCount));
+    if (header_->indexSize == sizeof(std::uint16_t)) {
+        const std::uint16_t* indices = static_cast<const std::uint16_t*>(GetIndexData());
+        std::copy(indices, indices + meshData.indices.size(), meshData.indices.begin());
+    } else {
+        std::memcpy(meshData.indices.data(), GetIndexData(), meshData.indices.size() * sizeof(std::uint32_t));
+    }
+    
+    return true;
+}
+
+// === Access ===
+
+const MeshFileHeader& MeshFile::GetHeader() const {
+    static const MeshFileHeader emptyHeader;
+    return header_ ? *header_ : emptyHeader;
+}
+
+const MeshFileAttribute& MeshFile::GetAttribute(std::uint32_t index) const {
+    return attributes_[index];
+}
+
+LLGL::VertexFormat MeshFile::GetVertexFormat() const {
+    LLGL::VertexFormat vertexFormat;
+    if (!IsOpen()) {
+        return vertexFormat;
+    }
+    
+    for (std::uint32_t i = 0; i < header_->attributeCount; ++i) {
+        const MeshFileAttribute& attribute = attributes_[i];
+        vertexFormat.attributes.push_back(LLGL::VertexAttribute(GetAttributeName(attribute.semantic), attribute.format,
+                                                                i, attribute.offset, header_->vertexStride));
+    }
+    return vertexFormat;
+}
+
+LLGL::Format MeshFile::GetIndexFormat() const {
+    return (header_ && header_->indexSize == sizeof(std::uint16_t)) ? LLGL::Format::R16UInt : LLGL::Format::R32UInt;
+}
+
+const void* MeshFile::GetVertexData() const {
+    return data_ ? data_ + header_->vertexOffset : nullptr;
+}
+
+const void* MeshFile::GetIndexData() const {
+    return data_ ? data_ + header_->indexOffset : nullptr;
+}
+
+void MeshFile::GetBounds(Gs::Vector3f& minBounds, Gs::Vector3f& maxBounds) const {
+    const MeshFileHeader& header = GetHeader();
+    minBounds = Gs::Vector3f(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    maxBounds = Gs::Vector3f(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+}
+
+// === Private Methods ===
+
+bool MeshFile::Validate() const {
+    if (size_ < sizeof(MeshFileHeader) || header_->magic != kMeshFileMagic) {
+        return false;
+    }
+    
+    if (header_->version != kMeshFileVersion) {
+        std::cerr << "Unsupported mesh file version " << header_->version << std::endl;
+        return false;
+    }
+    
+    if (header_->attributeCount == 0 || header_->attributeCount > kMaxAttributes || header_->vertexStride == 0 ||
+        (header_->indexSize != 2 && header_->indexSize != 4)) {
+        return false;
+    }
+    
+    if (sizeof(MeshFileHeader) + header_->attributeCount * sizeof(MeshFileAttribute) > size_) {
+        return false;
+    }
+    
+    // Blob ranges; counts are checked against the file size first so the products cannot overflow
+    if (header_->vertexOffset % kMeshFileBlobAlignment != 0 || header_->indexOffset % kMeshFileBlobAlignment != 0 ||
+        header_->vertexOffset > size_ || header_->indexOffset > size_) {
+        return false;
+    }
+    
+    if (header_->vertexCount > (size_ - header_->vertexOffset) / header_->vertexStride ||
+        header_->indexCount > (size_ - header_->indexOffset) / header_->indexSize) {
+        return false;
+    }
+    
+    for (std::uint32_t i = 0; i < header_->attributeCount; ++i) {
+        if (attributes_[i].offset >= header_->vertexStride) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,767 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @brief Implementation of MeshOptimizer class
+ */
+
+#include "../include/MeshOptimizer.h"
+#include "ResourceManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace RenderingPlugin {
+
+namespace {
+
+// Forsyth's scoring constants
+const float kCacheDecayPower = 1.5f;
+const float kLastTriangleScore = 0.75f;
+const float kValenceBoostScale = 2.0f;
+const float kValenceBoostPower = 0.5f;
+
+const std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+float ScoreVertex(int cachePosition, std::uint32_t remainingValence, std::uint32_t cacheSize) {
+    if (remainingValence == 0) {
+        return -1.0f;
+    }
+    
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // The last triangle's vertices get a fixed score so its neighbours are not favoured
+            // over triangles that reuse older cache entries
+            score = kLastTriangleScore;
+        } else {
+            const float scale = 1.0f / static_cast<float>(cacheSize - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, kCacheDecayPower);
+        }
+    }
+    
+    // Prefer vertices with few remaining triangles so they leave the working set early
+    score += kValenceBoostScale * std::pow(static_cast<float>(remainingValence), -kValenceBoostPower);
+    return score;
+}
+
+/**
+ * @brief Vertex attributes reduced to comparable integers for welding
+ */
+struct WeldKey {
+    std::int64_t values[11];
+    
+    bool operator==(const WeldKey& other) const {
+        return std::memcmp(values, other.values, sizeof(values)) == 0;
+    }
+};
+
+struct WeldKeyHash {
+    std::size_t operator()(const WeldKey& key) const {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::int64_t value : key.values) {
+            hash ^= static_cast<std::uint64_t>(value);
+            hash *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(hash ^ (hash >> 32));
+    }
+};
+
+WeldKey MakeWeldKey(const Vertex& vertex, float epsilon) {
+    const float attributes[11] = {
+        vertex.position.x, vertex.position.y, vertex.position.z,
+        vertex.normal.x, vertex.normal.y, vertex.normal.z,
+        vertex.texCoord.x, vertex.texCoord.y,
+        vertex.color.x, vertex.color.y, vertex.color.z
+    };
+    
+    WeldKey key;
+    for (int i = 0; i < 11; ++i) {
+        if (epsilon > 0.0f) {
+            key.values[i] = static_cast<std::int64_t>(std::llround(attributes[i] / epsilon));
+        } else {
+            // Adding zero turns -0 into +0 so both compare equal
+            const float value = attributes[i] + 0.0f;
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            key.values[i] = bits;
+        }
+    }
+    return key;
+}
+
+/**
+ * @brief Symmetric 4x4 error quadric of a set of planes, weighted by triangle area
+ */
+struct Quadric {
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+    double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+    double a22 = 0.0, a23 = 0.0;
+    double a33 = 0.0;
+    double weight = 0.0;
+    
+    void AddPlane(double a, double b, double c, double d, double w) {
+        a00 += w * a * a; a01 += w * a * b; a02 += w * a * c; a03 += w * a * d;
+        a11 += w * b * b; a12 += w * b * c; a13 += w * b * d;
+        a22 += w * c * c; a23 += w * c * d;
+        a33 += w * d * d;
+        weight += w;
+    }
+    
+    void Add(const Quadric& other) {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+        a11 += other.a11; a12 += other.a12; a13 += other.a13;
+        a22 += other.a22; a23 += other.a23;
+        a33 += other.a33;
+        weight += other.weight;
+    }
+    
+    /**
+     * @brief Root mean square distance of a point to the planes
+     */
+    float Error(const Gs::Vector3f& p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        const double sum = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x +
+                           a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y +
+                           a22 * z * z + 2.0 * a23 * z +
+                           a33;
+        return (weight > 0.0) ? static_cast<float>(std::sqrt(std::max(sum, 0.0) / weight)) : 0.0f;
+    }
+};
+
+Gs::Vector3f TriangleNormal(const Gs::Vector3f& p0, const Gs::Vector3f& p1, const Gs::Vector3f& p2) {
+    const Gs::Vector3f e1 = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+    const Gs::Vector3f e2 = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+    return {
+        e1.y * e2.z - e1.z * e2.y,
+        e1.z * e2.x - e1.x * e2.z,
+        e1.x * e2.y - e1.y * e2.x
+    };
+}
+
+struct PositionKey {
+    std::uint32_t bits[3];
+    
+    bool operator==(const PositionKey& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct PositionKeyHash {
+    std::size_t operator()(const PositionKey& key) const {
+        return static_cast<std::size_t>(key.bits[0] * 73856093u ^ key.bits[1] * 19349663u ^ key.bits[2] * 83492791u);
+    }
+};
+
+PositionKey MakePositionKey(const Gs::Vector3f& position) {
+    const float values[3] = { position.x + 0.0f, position.y + 0.0f, position.z + 0.0f };
+    PositionKey key;
+    std::memcpy(key.bits, values, sizeof(key.bits));
+    return key;
+}
+
+} // namespace
+
+// === Pipeline ===
+
+MeshOptimizerStats MeshOptimizer::Optimize(MeshData& meshData, const MeshOptimizerSettings& settings) {
+    MeshOptimizerStats stats;
+    stats.vertexCountBefore = meshData.vertices.size();
+    stats.vertexCountAfter = meshData.vertices.size();
+    
+    if (!IsValidTriangleList(meshData)) {
+        std::cerr << "MeshOptimizer: mesh is not a valid triangle list" << std::endl;
+        return stats;
+    }
+    
+    stats.before = AnalyzeVertexCache(meshData);
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    if (settings.weldVertices) {
+        WeldVertices(meshData, settings.weldEpsilon);
+    }
+    if (settings.optimizeVertexCache) {
+        OptimizeVertexCache(meshData, settings.cacheSize);
+    }
+    if (settings.optimizeOverdraw) {
+        OptimizeOverdraw(meshData, settings.overdrawThreshold, settings.cacheSize);
+    }
+    if (settings.optimizeVertexFetch) {
+        OptimizeVertexFetch(meshData);
+    }
+    
+    stats.optimizeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    stats.after = AnalyzeVertexCache(meshData);
+    stats.vertexCountAfter = meshData.vertices.size();
+    return stats;
+}
+
+// === Passes ===
+
+std::size_t MeshOptimizer::WeldVertices(MeshData& meshData, float epsilon) {
+    if (!IsValidTriangleList(meshData)) {
+        return 0;
+    }
+    
+    const std::size_t vertexCount = meshData.vertices.size();
+    std::unordered_map<WeldKey, std::uint32_t, WeldKeyHash> unique;
+    unique.reserve(vertexCount);
+    
+    std::vector<std::uint32_t> remap(vertexCount);
+    std::vector<Vertex> welded;
+    welded.reserve(vertexCount);
+    
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        auto result = unique.emplace(MakeWeldKey(meshData.vertices[i], epsilon), static_cast<std::uint32_t>(welded.size()));
+        if (result.second) {
+            welded.push_back(meshData.vertices[i]);
+        }
+        remap[i] = result.first->second;
+    }
+    
+    for (std::uint32_t& index : meshData.indices) {
+        index = remap[index];
+    }
+    
+    const std::size_t removed = vertexCount - welded.size();
+    meshData.vertices.swap(welded);
+    return removed;
+}
+
+void MeshOptimizer::OptimizeVertexCache(MeshData& meshData, std::uint32_t cacheSize) {
+    if (!IsValidTriangleList(meshData) || meshData.indices.empty()) {
+        return;
+    }
+    
+    cacheSize = std::max<std::uint32_t>(cacheSize, 4);
+    const std::vector<std::uint32_t>& indices = meshData.indices;
+    const std::size_t vertexCount = meshData.vertices.size();
+    const std::size_t triangleCount = indices.size() / 3;
+    
+    // Vertex to triangle adjacency; each vertex's live triangles are kept at the front of its range
+    std::vector<std::uint32_t> valence(vertexCount, 0);
+    for (std::uint32_t index : indices) {
+        valence[index]++;
+    }
+    
+    std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + valence[i];
+    }
+    
+    std::vector<std::uint32_t> adjacency(indices.size());
+    std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        for (int corner = 0; corner < 3; ++corner) {
+            adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<std::uint32_t>(triangle);
+        }
+    }
+    
+    // Scores only depend on cache position and remaining valence, so common cases come from a table
+    const std::uint32_t tableValence = 32;
+    std::vector<float> scoreTable((cacheSize + 1) * tableValence);
+    for (std::uint32_t position = 0; position <= cacheSize; ++position) {
+        for (std::uint32_t remaining = 0; remaining < tableValence; ++remaining) {
+            const int cachePosition = (position < cacheSize) ? static_cast<int>(position) : -1;
+            scoreTable[position * tableValence + remaining] = ScoreVertex(cachePosition, remaining, cacheSize);
+        }
+    }
+    auto score = [&](int cachePosition, std::uint32_t remaining) {
+        if (remaining >= tableValence) {
+            return ScoreVertex(cachePosition, remaining, cacheSize);
+        }
+        const std::uint32_t position = (cachePosition >= 0) ? static_cast<std::uint32_t>(cachePosition) : cacheSize;
+        return scoreTable[position * tableValence + remaining];
+    };
+    
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        vertexScore[i] = score(-1, valence[i]);
+    }
+    
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    std::uint32_t bestTriangle = kInvalidIndex;
+    float bestScore = -1.0f;
+    for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        triangleScore[triangle] = vertexScore[indices[triangle * 3]] +
+                                  vertexScore[indices[triangle * 3 + 1]] +
+                                  vertexScore[indices[triangle * 3 + 2]];
+        if (triangleScore[triangle] > bestScore) {
+            bestScore = triangleScore[triangle];
+            bestTriangle = static_cast<std::uint32_t>(triangle);
+        }
+    }
+    
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> nextCache;
+    cache.reserve(cacheSize + 3);
+    nextCache.reserve(cacheSize + 3);
+    
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    std::size_t scanCursor = 0;
+    
+    for (std::size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestTriangle == kInvalidIndex) {
+            // Nothing in the cache has triangles left; continue with the next triangle in input order
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            bestTriangle = static_cast<std::uint32_t>(scanCursor);
+        }
+        
+        const std::uint32_t* corners = &indices[bestTriangle * 3];
+        output.insert(output.end(), corners, corners + 3);
+        emitted[bestTriangle] = true;
+        
+        // Remove the triangle from its vertices' live ranges
+        for (int corner = 0; corner < 3; ++corner) {
+            const std::uint32_t vertex = corners[corner];
+            std::uint32_t* live = &adjacency[adjacencyOffsets[vertex]];
+            std::uint32_t* end = live + valence[vertex];
+            std::uint32_t* found = std::find(live, end, bestTriangle);
+            if (found != end) {
+                std::swap(*found, *(end - 1));
+                valence[vertex]--;
+            }
+        }
+        
+        // Move the triangle's vertices to the front of the LRU cache
+        nextCache.assign(corners, corners + 3);
+        for (std::uint32_t vertex : cache) {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+        
+        // Rescore every vertex whose position changed, including the ones that just fell out
+        for (std::size_t position = 0; position < nextCache.size(); ++position) {
+            const std::uint32_t vertex = nextCache[position];
+            cachePosition[vertex] = (position < cacheSize) ? static_cast<int>(position) : -1;
+            
+            const float newScore = score(cachePosition[vertex], valence[vertex]);
+            const float delta = newScore - vertexScore[vertex];
+            vertexScore[vertex] = newScore;
+            
+            const std::uint32_t* live = &adjacency[adjacencyOffsets[vertex]];
+            for (std::uint32_t i = 0; i < valence[vertex]; ++i) {
+                triangleScore[live[i]] += delta;
+            }
+        }
+        
+        if (nextCache.size() > cacheSize) {
+            nextCache.resize(cacheSize);
+        }
+        cache.swap(nextCache);
+        
+        // The next triangle is the best one touching the cache
+        bestTriangle = kInvalidIndex;
+        bestScore = -1.0f;
+        for (std::uint32_t vertex : cache) {
+            const std::uint32_t* live = &adjacency[adjacencyOffsets[vertex]];
+            for (std::uint32_t i = 0; i < valence[vertex]; ++i) {
+                if (triangleScore[live[i]] > bestScore) {
+                    bestScore = triangleScore[live[i]];
+                    bestTriangle = live[i];
+                }
+            }
+        }
+    }
+    
+    meshData.indices.swap(output);
+}
+
+void MeshOptimizer::OptimizeOverdraw(MeshData& meshData, float threshold, std::uint32_t cacheSize) {
+    if (!IsValidTriangleList(meshData) || meshData.indices.empty()) {
+        return;
+    }
+    
+    const std::vector<std::uint32_t>& indices = meshData.indices;
+    const std::size_t triangleCount = indices.size() / 3;
+    const float meshAcmr = AnalyzeVertexCache(meshData, cacheSize).acmr;
+    
+    // Split where the FIFO cache restarts (all three vertices miss); drawing a cluster that starts
+    // there in another position costs little. A split is only taken once the current cluster is
+    // cache efficient enough, which bounds the ACMR increase.
+    std::vector<std::uint32_t> clusterStarts;
+    {
+        std::vector<std::uint32_t> cacheTime(meshData.vertices.size(), 0);
+        std::uint32_t time = cacheSize + 1;
+        std::uint32_t clusterMisses = 0;
+        std::uint32_t clusterTriangles = 0;
+        
+        for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+            std::uint32_t misses = 0;
+            for (int corner = 0; corner < 3; ++corner) {
+                const std::uint32_t vertex = indices[triangle * 3 + corner];
+                if (time - cacheTime[vertex] > cacheSize) {
+                    cacheTime[vertex] = time++;
+                    misses++;
+                }
+            }
+            
+            const bool efficient = clusterTriangles > 0 &&
+                static_cast<float>(clusterMisses) <= meshAcmr * threshold * static_cast<float>(clusterTriangles);
+            if (clusterStarts.empty() || (misses == 3 && efficient)) {
+                clusterStarts.push_back(static_cast<std::uint32_t>(triangle));
+                clusterMisses = 0;
+                clusterTriangles = 0;
+            }
+            clusterMisses += misses;
+            clusterTriangles++;
+        }
+    }
+    
+    const std::size_t clusterCount = clusterStarts.size();
+    clusterStarts.push_back(static_cast<std::uint32_t>(triangleCount));
+    if (clusterCount < 2) {
+        return;
+    }
+    
+    // Area weighted centroid and normal per cluster
+    std::vector<Gs::Vector3f> clusterCentroids(clusterCount, Gs::Vector3f(0, 0, 0));
+    std::vector<Gs::Vector3f> clusterNormals(clusterCount, Gs::Vector3f(0, 0, 0));
+    std::vector<float> clusterAreas(clusterCount, 0.0f);
+    Gs::Vector3f meshCentroid(0, 0, 0);
+    float meshArea = 0.0f;
+    
+    for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        for (std::uint32_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle) {
+            const Gs::Vector3f& p0 = meshData.vertices[indices[triangle * 3]].position;
+            const Gs::Vector3f& p1 = meshData.vertices[indices[triangle * 3 + 1]].position;
+            const Gs::Vector3f& p2 = meshData.vertices[indices[triangle * 3 + 2]].position;
+            
+            const Gs::Vector3f e1 = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            const Gs::Vector3f e2 = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            const Gs::Vector3f normal = {
+                e1.y * e2.z - e1.z * e2.y,
+                e1.z * e2.x - e1.x * e2.z,
+                e1.x * e2.y - e1.y * e2.x
+            };
+            const float area = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+            const float weight = area / 3.0f;
+            
+            Gs::Vector3f& centroid = clusterCentroids[cluster];
+            centroid.x += (p0.x + p1.x + p2.x) * weight;
+            centroid.y += (p0.y + p1.y + p2.y) * weight;
+            centroid.z += (p0.z + p1.z + p2.z) * weight;
+            clusterNormals[cluster] = clusterNormals[cluster] + normal;
+            clusterAreas[cluster] += area;
+        }
+        
+        meshCentroid = meshCentroid + clusterCentroids[cluster];
+        meshArea += clusterAreas[cluster];
+    }
+    
+    if (meshArea > 0.0f) {
+        meshCentroid = { meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea };
+    }
+    
+    // Clusters facing away from the center are on the outside and occlude the inner ones
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        if (clusterAreas[cluster] <= 0.0f) {
+            continue;
+        }
+        
+        const float area = clusterAreas[cluster];
+        const Gs::Vector3f centroid = {
+            clusterCentroids[cluster].x / area - meshCentroid.x,
+            clusterCentroids[cluster].y / area - meshCentroid.y,
+            clusterCentroids[cluster].z / area - meshCentroid.z
+        };
+        const Gs::Vector3f& normal = clusterNormals[cluster];
+        const float normalLength = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (normalLength > 0.0f) {
+            sortKeys[cluster] = (centroid.x * normal.x + centroid.y * normal.y + centroid.z * normal.z) / normalLength;
+        }
+    }
+    
+    std::vector<std::uint32_t> order(clusterCount);
+    for (std::size_t i = 0; i < clusterCount; ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](std::uint32_t a, std::uint32_t b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+    
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    for (std::uint32_t cluster : order) {
+        output.insert(output.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + clusterStarts[cluster + 1] * 3);
+    }
+    meshData.indices.swap(output);
+}
+
+std::size_t MeshOptimizer::OptimizeVertexFetch(MeshData& meshData) {
+    if (!IsValidTriangleList(meshData)) {
+        return 0;
+    }
+    
+    const std::size_t vertexCount = meshData.vertices.size();
+    std::vector<std::uint32_t> remap(vertexCount, kInvalidIndex);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertexCount);
+    
+    for (std::uint32_t& index : meshData.indices) {
+        if (remap[index] == kInvalidIndex) {
+            remap[index] = static_cast<std::uint32_t>(reordered.size());
+            reordered.push_back(meshData.vertices[index]);
+        }
+        index = remap[index];
+    }
+    
+    const std::size_t removed = vertexCount - reordered.size();
+    meshData.vertices.swap(reordered);
+    return removed;
+}
+
+std::vector<std::uint32_t> MeshOptimizer::Simplify(const MeshData& meshData, std::size_t targetIndexCount,
+                                                   float maxError, float* resultError) {
+    std::vector<std::uint32_t> indices = meshData.indices;
+    float error = 0.0f;
+    if (resultError) {
+        *resultError = 0.0f;
+    }
+    
+    if (!IsValidTriangleList(meshData) || indices.size() <= targetIndexCount) {
+        return indices;
+    }
+    
+    const std::vector<Vertex>& vertices = meshData.vertices;
+    const std::size_t vertexCount = vertices.size();
+    
+    // Lock seam vertices: moving one copy of a position would tear the mesh apart
+    std::vector<std::uint8_t> locked(vertexCount, 0);
+    {
+        std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> firstAtPosition;
+        firstAtPosition.reserve(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            auto result = firstAtPosition.emplace(MakePositionKey(vertices[i].position), static_cast<std::uint32_t>(i));
+            if (!result.second) {
+                locked[i] = 1;
+                locked[result.first->second] = 1;
+            }
+        }
+    }
+    
+    // Lock border and non-manifold vertices: edges not shared by exactly two triangles
+    {
+        std::unordered_map<std::uint64_t, std::uint32_t> edgeUses;
+        edgeUses.reserve(indices.size());
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            for (int corner = 0; corner < 3; ++corner) {
+                const std::uint32_t a = indices[i + corner];
+                const std::uint32_t b = indices[i + (corner + 1) % 3];
+                edgeUses[(static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b)]++;
+            }
+        }
+        for (const auto& edge : edgeUses) {
+            if (edge.second != 2) {
+                locked[static_cast<std::uint32_t>(edge.first >> 32)] = 1;
+                locked[static_cast<std::uint32_t>(edge.first & 0xFFFFFFFFu)] = 1;
+            }
+        }
+    }
+    
+    std::vector<Quadric> quadrics(vertexCount);
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        const Gs::Vector3f& p0 = vertices[indices[i]].position;
+        const Gs::Vector3f normal = TriangleNormal(p0, vertices[indices[i + 1]].position, vertices[indices[i + 2]].position);
+        const double length = std::sqrt(static_cast<double>(normal.x) * normal.x +
+                                        static_cast<double>(normal.y) * normal.y +
+                                        static_cast<double>(normal.z) * normal.z);
+        if (length <= 0.0) {
+            continue;
+        }
+        
+        const double a = normal.x / length, b = normal.y / length, c = normal.z / length;
+        const double d = -(a * p0.x + b * p0.y + c * p0.z);
+        for (int corner = 0; corner < 3; ++corner) {
+            quadrics[indices[i + corner]].AddPlane(a, b, c, d, length * 0.5);
+        }
+    }
+    
+    std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1);
+    std::vector<std::uint32_t> adjacency;
+    std::vector<std::uint32_t> collapseTarget(vertexCount);
+    std::vector<float> collapseError(vertexCount);
+    std::vector<std::uint32_t> candidates;
+    std::vector<std::uint32_t> remap(vertexCount);
+    std::vector<std::uint8_t> touched(vertexCount);
+    
+    // Each pass collapses an independent set of edges, cheapest first, then compacts the indices
+    while (indices.size() > targetIndexCount) {
+        const std::size_t triangleCount = indices.size() / 3;
+        
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+        for (std::uint32_t index : indices) {
+            adjacencyOffsets[index + 1]++;
+        }
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        }
+        adjacency.resize(indices.size());
+        {
+            std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+                for (int corner = 0; corner < 3; ++corner) {
+                    adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<std::uint32_t>(triangle);
+                }
+            }
+        }
+        
+        // Cheapest neighbour to collapse each unlocked vertex onto
+        std::fill(collapseTarget.begin(), collapseTarget.end(), kInvalidIndex);
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            for (int corner = 0; corner < 3; ++corner) {
+                const std::uint32_t from = indices[i + corner];
+                if (locked[from]) {
+                    continue;
+                }
+                for (int other = 1; other < 3; ++other) {
+                    const std::uint32_t to = indices[i + (corner + other) % 3];
+                    const float cost = quadrics[from].Error(vertices[to].position);
+                    if (collapseTarget[from] == kInvalidIndex || cost < collapseError[from]) {
+                        collapseTarget[from] = to;
+                        collapseError[from] = cost;
+                    }
+                }
+            }
+        }
+        
+        candidates.clear();
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            if (collapseTarget[i] != kInvalidIndex && collapseError[i] <= maxError) {
+                candidates.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [&collapseError](std::uint32_t a, std::uint32_t b) {
+            return collapseError[a] < collapseError[b] || (collapseError[a] == collapseError[b] && a < b);
+        });
+        
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            remap[i] = static_cast<std::uint32_t>(i);
+        }
+        std::fill(touched.begin(), touched.end(), 0);
+        
+        const std::size_t trianglesToRemove = (indices.size() - targetIndexCount + 2) / 3;
+        std::size_t trianglesRemoved = 0;
+        std::size_t collapses = 0;
+        
+        for (std::uint32_t from : candidates) {
+            const std::uint32_t to = collapseTarget[from];
+            if (touched[from] || touched[to]) {
+                continue;
+            }
+            
+            // Reject collapses that flip a remaining triangle
+            const std::uint32_t* begin = &adjacency[adjacencyOffsets[from]];
+            const std::uint32_t* end = &adjacency[0] + adjacencyOffsets[from + 1];
+            bool flips = false;
+            std::size_t sharedTriangles = 0;
+            for (const std::uint32_t* triangle = begin; triangle != end && !flips; ++triangle) {
+                const std::uint32_t* corners = &indices[*triangle * 3];
+                if (corners[0] == to || corners[1] == to || corners[2] == to) {
+                    sharedTriangles++;
+                    continue;
+                }
+                
+                Gs::Vector3f p[3], q[3];
+                for (int corner = 0; corner < 3; ++corner) {
+                    p[corner] = vertices[corners[corner]].position;
+                    q[corner] = (corners[corner] == from) ? vertices[to].position : p[corner];
+                }
+                const Gs::Vector3f before = TriangleNormal(p[0], p[1], p[2]);
+                const Gs::Vector3f after = TriangleNormal(q[0], q[1], q[2]);
+                flips = (before.x * after.x + before.y * after.y + before.z * after.z) <= 0.0f;
+            }
+            if (flips) {
+                continue;
+            }
+            
+            remap[from] = to;
+            quadrics[to].Add(quadrics[from]);
+            error = std::max(error, collapseError[from]);
+            
+            // Freeze the one-ring so later flip checks in this pass see final positions
+            for (const std::uint32_t* triangle = begin; triangle != end; ++triangle) {
+                const std::uint32_t* corners = &indices[*triangle * 3];
+                touched[corners[0]] = touched[corners[1]] = touched[corners[2]] = 1;
+            }
+            
+            collapses++;
+            trianglesRemoved += sharedTriangles;
+            if (trianglesRemoved >= trianglesToRemove) {
+                break;
+            }
+        }
+        
+        if (collapses == 0) {
+            break;
+        }
+        
+        // Apply the collapses and drop triangles that became degenerate
+        std::size_t write = 0;
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            const std::uint32_t a = remap[indices[i]];
+            const std::uint32_t b = remap[indices[i + 1]];
+            const std::uint32_t c = remap[indices[i + 2]];
+            if (a != b && b != c && a != c) {
+                indices[write++] = a;
+                indices[write++] = b;
+                indices[write++] = c;
+            }
+        }
+        indices.resize(write);
+    }
+    
+    if (resultError) {
+        *resultError = error;
+    }
+    return indices;
+}
+
+// === Analysis ===
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const MeshData& meshData, std::uint32_t cacheSize) {
+    VertexCacheStats stats;
+    if (!IsValidTriangleList(meshData) || meshData.indices.empty()) {
+        return stats;
+    }
+    
+    // A vertex is cached if fewer than cacheSize misses happened since it was loaded
+    std::vector<std::uint32_t> cacheTime(meshData.vertices.size(), 0);
+    std::uint32_t time = cacheSize + 1;
+    for (std::uint32_t index : meshData.indices) {
+        if (time - cacheTime[index] > cacheSize) {
+            cacheTime[index] = time++;
+            stats.verticesTransformed++;
+        }
+    }
+    
+    stats.acmr = static_cast<float>(stats.verticesTransformed) / static_cast<float>(meshData.GetTriangleCount());
+    stats.atvr = static_cast<float>(stats.verticesTransformed) / static_cast<float>(meshData.vertices.size());
+    return stats;
+}
+
+// === Private Methods ===
+
+bool MeshOptimizer::IsValidTriangleList(const MeshData& meshData) {
+    if (meshData.indices.size() % 3 != 0) {
+        return false;
+    }
+    
+    const std::size_t vertexCount = meshData.vertices.size();
+    return std::all_of(meshData.indices.begin(), meshData.indices.end(), [vertexCount](std::uint32_t index) {
+        return index < vertexCount;
+    });
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,245 @@
+/**
+ * @file ParallelCommandRecorder.cpp
+ * @brief Implementation of ParallelCommandRecorder class
+ */
+
+#include "../include/ParallelCommandRecorder.h"
+#include "../include/RenderCommands.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace RenderingPlugin {
+
+// === ParallelCommandRecorder Implementation ===
+
+ParallelCommandRecorder::ParallelCommandRecorder(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager,
+                                                 ThreadPool* threadPool, const LLGL::RenderPass* renderPass,
+                                                 std::size_t minItemsPerChunk)
+    : renderSystem_(renderSystem)
+    , resourceManager_(resourceManager)
+    , threadPool_(threadPool)
+    , renderPass_(renderPass)
+    , minItemsPerChunk_(std::max<std::size_t>(1, minItemsPerChunk))
+    , recordedChunks_(0)
+    , secondaryBuffersSupported_(false)
+    , deferredItemCount_(0)
+    , deferredFrameIndex_(0)
+    , matrixBufferId_(0) {
+    
+    if (!renderSystem_) {
+        throw std::invalid_argument("RenderSystem cannot be null");
+    }
+    
+    if (!resourceManager_) {
+        throw std::invalid_argument("ResourceManager cannot be null");
+    }
+    
+    if (!threadPool_) {
+        throw std::invalid_argument("ThreadPool cannot be null");
+    }
+    
+    secondaryBuffersSupported_ = CreateChunkContexts(threadPool_->GetThreadCount());
+    
+    if (secondaryBuffersSupported_) {
+        std::cout << "ParallelCommandRecorder initialized (" << chunks_.size() << " secondary command buffers)" << std::endl;
+    } else {
+        std::cout << "ParallelCommandRecorder initialized (secondary command buffers unavailable, recording on primary)" << std::endl;
+    }
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder() {
+    for (ChunkContext& chunk : chunks_) {
+        chunk.commands.reset();
+        if (chunk.commandBuffer) {
+            renderSystem_->Release(*chunk.commandBuffer);
+        }
+    }
+    chunks_.clear();
+    
+    std::cout << "ParallelCommandRecorder destroyed" << std::endl;
+}
+
+bool ParallelCommandRecorder::Record(std::size_t itemCount, const RecordFunction& record, std::uint32_t frameIndex) {
+    stats_ = ParallelRecordStats();
+    stats_.itemCount = itemCount;
+    recordedChunks_ = 0;
+    
+    if (!record) {
+        std::cerr << "Invalid record function" << std::endl;
+        return false;
+    }
+    
+    if (itemCount == 0) {
+        return true;
+    }
+    
+    if (!secondaryBuffersSupported_) {
+        // Recorded single-threaded into the primary command buffer during Execute()
+        deferredRecord_ = record;
+        deferredItemCount_ = itemCount;
+        deferredFrameIndex_ = frameIndex;
+        stats_.chunkCount = 1;
+        return true;
+    }
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    const std::size_t chunkLimit = (itemCount + minItemsPerChunk_ - 1) / minItemsPerChunk_;
+    const std::size_t chunkCount = std::min(chunks_.size(), chunkLimit);
+    
+    // Same split as ThreadPool::ParallelFor, so chunk i always covers the same items
+    const std::size_t chunkSize = (itemCount + chunkCount - 1) / chunkCount;
+    recordedChunks_ = (itemCount + chunkSize - 1) / chunkSize;
+    
+    // BeginFrame releases the buffers a chunk retired in this slot, which modifies ResourceManager
+    for (std::size_t i = 0; i < recordedChunks_; ++i) {
+        chunks_[i].commands->BeginFrame(frameIndex);
+    }
+    
+    try {
+        threadPool_->ParallelFor(itemCount, [this, &record](std::size_t begin, std::size_t end, std::size_t chunkIndex) {
+            auto chunkStart = std::chrono::high_resolution_clock::now();
+            
+            ChunkContext& chunk = chunks_[chunkIndex];
+            chunk.commandBuffer->Begin();
+            record(*chunk.commands, begin, end);
+            chunk.commandBuffer->End();
+            
+            auto chunkEnd = std::chrono::high_resolution_clock::now();
+            chunk.recordTimeMs = std::chrono::duration<double, std::milli>(chunkEnd - chunkStart).count();
+        }, chunkCount);
+        
+        // Back on this thread: write the staged instances, and re-record chunks that needed
+        // a larger instance buffer or new buffer arrays with resource creation allowed
+        for (std::size_t i = 0; i < recordedChunks_; ++i) {
+            ChunkContext& chunk = chunks_[i];
+            if (!chunk.commands->NeedsResourceCreation()) {
+                chunk.commands->FlushStagedInstances();
+                continue;
+            }
+            
+            const std::size_t begin = i * chunkSize;
+            const std::size_t end = std::min(begin + chunkSize, itemCount);
+            chunk.commands->SetWorkerRecording(false);
+            chunk.commandBuffer->Begin();
+            chunk.commands->BeginFrame(frameIndex);
+            record(*chunk.commands, begin, end);
+            chunk.commandBuffer->End();
+            chunk.commands->SetWorkerRecording(true);
+            stats_.rerecordedChunks++;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Exception during parallel command recording: " << e.what() << std::endl;
+        recordedChunks_ = 0;
+        return false;
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    
+    stats_.chunkCount = recordedChunks_;
+    stats_.usedSecondaryBuffers = true;
+    stats_.wallTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    for (std::size_t i = 0; i < recordedChunks_; ++i) {
+        stats_.totalChunkTimeMs += chunks_[i].recordTimeMs;
+        stats_.maxChunkTimeMs = std::max(stats_.maxChunkTimeMs, chunks_[i].recordTimeMs);
+    }
+    
+    return true;
+}
+
+void ParallelCommandRecorder::Execute(LLGL::CommandBuffer& primaryCommandBuffer) {
+    if (!secondaryBuffersSupported_) {
+        if (!deferredRecord_) {
+            return;
+        }
+        
+        if (!primaryCommands_) {
+            primaryCommands_ = std::make_unique<RenderCommands>(&primaryCommandBuffer, resourceManager_);
+            primaryCommands_->SetMatrixBuffer(matrixBufferId_);
+        } else if (primaryCommands_->GetCommandBuffer() != &primaryCommandBuffer) {
+            // Frames in flight alternate primary command buffers; keep the instance streams
+            primaryCommands_->SetCommandBuffer(&primaryCommandBuffer);
+        }
+        
+        auto startTime = std::chrono::high_resolution_clock::now();
+        primaryCommands_->BeginFrame(deferredFrameIndex_);
+        deferredRecord_(*primaryCommands_, 0, deferredItemCount_);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        
+        stats_.wallTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        stats_.totalChunkTimeMs = stats_.wallTimeMs;
+        stats_.maxChunkTimeMs = stats_.wallTimeMs;
+        
+        deferredRecord_ = nullptr;
+        deferredItemCount_ = 0;
+        return;
+    }
+    
+    // Chunk order equals item order, independent of which thread recorded what
+    for (std::size_t i = 0; i < recordedChunks_; ++i) {
+        primaryCommandBuffer.Execute(*chunks_[i].commandBuffer);
+    }
+    recordedChunks_ = 0;
+}
+
+void ParallelCommandRecorder::SetMatrixBuffer(ResourceId constantBufferId) {
+    matrixBufferId_ = constantBufferId;
+    
+    for (ChunkContext& chunk : chunks_) {
+        chunk.commands->SetMatrixBuffer(constantBufferId);
+    }
+    
+    if (primaryCommands_) {
+        primaryCommands_->SetMatrixBuffer(constantBufferId);
+    }
+}
+
+bool ParallelCommandRecorder::SupportsParallelRecording() const {
+    return secondaryBuffersSupported_;
+}
+
+const ParallelRecordStats& ParallelCommandRecorder::GetStatistics() const {
+    return stats_;
+}
+
+// === Private Methods ===
+
+bool ParallelCommandRecorder::CreateChunkContexts(std::size_t chunkCount) {
+    try {
+        for (std::size_t i = 0; i < chunkCount; ++i) {
+            LLGL::CommandBufferDescriptor commandBufferDesc;
+            commandBufferDesc.flags = LLGL::CommandBufferFlags::Secondary;
+            commandBufferDesc.renderPass = renderPass_;
+            
+            LLGL::CommandBuffer* commandBuffer = renderSystem_->CreateCommandBuffer(commandBufferDesc);
+            if (!commandBuffer) {
+                throw std::runtime_error("secondary command buffer creation failed");
+            }
+            
+            ChunkContext chunk;
+            chunk.commandBuffer = commandBuffer;
+            chunk.commands = std::make_unique<RenderCommands>(commandBuffer, resourceManager_);
+            chunk.commands->SetWorkerRecording(true);
+            chunks_.push_back(std::move(chunk));
+        }
+        
+        return true;
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create secondary command buffers: " << e.what() << std::endl;
+        
+        for (ChunkContext& chunk : chunks_) {
+            chunk.commands.reset();
+            if (chunk.commandBuffer) {
+                renderSystem_->Release(*chunk.commandBuffer);
+            }
+        }
+        chunks_.clear();
+        return false;
+    }
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,273 @@
+/**
+ * @file QuantizedMesh.cpp
+ * @brief Implementation of the quantized vertex layout conversions
+ */
+
+#include "../include/QuantizedMesh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace RenderingPlugin {
+
+namespace {
+
+const float kUnorm16Max = 65535.0f;
+const float kSnorm16Max = 32767.0f;
+const float kUnorm8Max = 255.0f;
+
+std::uint16_t QuantizeUnorm16(float value, float offset, float scale) {
+    if (scale <= 0.0f) {
+        return 0;
+    }
+    const float normalized = std::min(std::max((value - offset) / scale, 0.0f), 1.0f);
+    return static_cast<std::uint16_t>(normalized * kUnorm16Max + 0.5f);
+}
+
+std::uint8_t QuantizeUnorm8(float value) {
+    const float normalized = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<std::uint8_t>(normalized * kUnorm8Max + 0.5f);
+}
+
+float SignNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+float DecodeSnorm16(std::int16_t value) {
+    // -32768 and -32767 both map to -1, as on the GPU
+    return std::max(static_cast<float>(value) / kSnorm16Max, -1.0f);
+}
+
+} // namespace
+
+// === Conversion ===
+
+QuantizedMeshData VertexQuantizer::Quantize(const MeshData& meshData) {
+    QuantizedMeshData result;
+    result.indices = meshData.indices;
+    if (meshData.vertices.empty()) {
+        return result;
+    }
+    
+    Gs::Vector3f minBounds, maxBounds;
+    GeometryGenerator::CalculateBounds(meshData, minBounds, maxBounds);
+    result.positionOffset = minBounds;
+    result.positionScale = maxBounds - minBounds;
+    
+    const Gs::Vector3f& offset = result.positionOffset;
+    const Gs::Vector3f& scale = result.positionScale;
+    
+    result.vertices.resize(meshData.vertices.size());
+    for (std::size_t i = 0; i < meshData.vertices.size(); ++i) {
+        const Vertex& source = meshData.vertices[i];
+        QuantizedVertex& target = result.vertices[i];
+        
+        target.position[0] = QuantizeUnorm16(source.position.x, offset.x, scale.x);
+        target.position[1] = QuantizeUnorm16(source.position.y, offset.y, scale.y);
+        target.position[2] = QuantizeUnorm16(source.position.z, offset.z, scale.z);
+        target.position[3] = 0;
+        
+        EncodeOctahedral(source.normal, target.normal);
+        
+        target.texCoord[0] = FloatToHalf(source.texCoord.x);
+        target.texCoord[1] = FloatToHalf(source.texCoord.y);
+        
+        target.color[0] = QuantizeUnorm8(source.color.x);
+        target.color[1] = QuantizeUnorm8(source.color.y);
+        target.color[2] = QuantizeUnorm8(source.color.z);
+        target.color[3] = 255;
+    }
+    
+    return result;
+}
+
+MeshData VertexQuantizer::Dequantize(const QuantizedMeshData& quantizedMesh) {
+    MeshData result;
+    result.indices = quantizedMesh.indices;
+    result.vertices.resize(quantizedMesh.vertices.size());
+    
+    const Gs::Vector3f& offset = quantizedMesh.positionOffset;
+    const Gs::Vector3f& scale = quantizedMesh.positionScale;
+    
+    for (std::size_t i = 0; i < quantizedMesh.vertices.size(); ++i) {
+        const QuantizedVertex& source = quantizedMesh.vertices[i];
+        Vertex& target = result.vertices[i];
+        
+        target.position = {
+            offset.x + scale.x * (static_cast<float>(source.position[0]) / kUnorm16Max),
+            offset.y + scale.y * (static_cast<float>(source.position[1]) / kUnorm16Max),
+            offset.z + scale.z * (static_cast<float>(source.position[2]) / kUnorm16Max)
+        };
+        target.normal = DecodeOctahedral(source.normal);
+        target.texCoord = { HalfToFloat(source.texCoord[0]), HalfToFloat(source.texCoord[1]) };
+        target.color = {
+            static_cast<float>(source.color[0]) / kUnorm8Max,
+            static_cast<float>(source.color[1]) / kUnorm8Max,
+            static_cast<float>(source.color[2]) / kUnorm8Max
+        };
+    }
+    
+    return result;
+}
+
+LLGL::VertexFormat VertexQuantizer::GetVertexFormat() {
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "position", LLGL::Format::RGBA16UNorm });
+    vertexFormat.AppendAttribute({ "normal", LLGL::Format::RG16SNorm });
+    vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG16Float });
+    vertexFormat.AppendAttribute({ "color", LLGL::Format::RGBA8UNorm });
+    return vertexFormat;
+}
+
+bool VertexQuantizer::CreateBuffers(const QuantizedMeshData& quantizedMesh, ResourceManager& resourceManager,
+                                    ResourceId& vertexBufferId, ResourceId& indexBufferId) {
+    vertexBufferId = 0;
+    indexBufferId = 0;
+    if (quantizedMesh.IsEmpty()) {
+        std::cerr << "Quantized mesh is empty" << std::endl;
+        return false;
+    }
+    
+    vertexBufferId = resourceManager.CreateVertexBuffer(quantizedMesh.vertices.data(),
+                                                        quantizedMesh.vertices.size() * sizeof(QuantizedVertex),
+                                                        GetVertexFormat());
+    indexBufferId = resourceManager.CreateIndexBuffer(quantizedMesh.indices.data(),
+                                                      quantizedMesh.indices.size() * sizeof(std::uint32_t),
+                                                      LLGL::Format::R32UInt);
+    
+    if (vertexBufferId == 0 || indexBufferId == 0) {
+        if (vertexBufferId != 0) {
+            resourceManager.ReleaseBuffer(vertexBufferId);
+        }
+        if (indexBufferId != 0) {
+            resourceManager.ReleaseBuffer(indexBufferId);
+        }
+        vertexBufferId = 0;
+        indexBufferId = 0;
+        return false;
+    }
+    return true;
+}
+
+// === Encoding Helpers ===
+
+QuantizedDecodeParams VertexQuantizer::GetDecodeParams(const QuantizedMeshData& quantizedMesh) {
+    QuantizedDecodeParams params;
+    params.positionOffset = Gs::Vector4f(quantizedMesh.positionOffset.x, quantizedMesh.positionOffset.y,
+                                         quantizedMesh.positionOffset.z, 0.0f);
+    params.positionScale = Gs::Vector4f(quantizedMesh.positionScale.x, quantizedMesh.positionScale.y,
+                                        quantizedMesh.positionScale.z, 0.0f);
+    return params;
+}
+
+ResourceId VertexQuantizer::CreateDecodeBuffer(const QuantizedMeshData& quantizedMesh, ResourceManager& resourceManager) {
+    const QuantizedDecodeParams params = GetDecodeParams(quantizedMesh);
+    return resourceManager.CreateConstantBuffer(sizeof(params), &params);
+}
+
+void VertexQuantizer::EncodeOctahedral(const Gs::Vector3f& normal, std::int16_t encoded[2]) {
+    const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (length <= 0.0f) {
+        encoded[0] = 0;
+        encoded[1] = 0;
+        return;
+    }
+    
+    // Project onto the octahedron, then fold the lower hemisphere over the diagonals
+    float u = normal.x / length;
+    float v = normal.y / length;
+    if (normal.z < 0.0f) {
+        const float foldedU = (1.0f - std::abs(v)) * SignNotZero(u);
+        const float foldedV = (1.0f - std::abs(u)) * SignNotZero(v);
+        u = foldedU;
+        v = foldedV;
+    }
+    
+    // Try the four floor/ceil roundings and keep the one with the smallest angular error
+    const float scaledU = std::min(std::max(u, -1.0f), 1.0f) * kSnorm16Max;
+    const float scaledV = std::min(std::max(v, -1.0f), 1.0f) * kSnorm16Max;
+    const float normalLength = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    
+    float bestDot = -2.0f;
+    for (int candidate = 0; candidate < 4; ++candidate) {
+        const float roundedU = (candidate & 1) ? std::ceil(scaledU) : std::floor(scaledU);
+        const float roundedV = (candidate & 2) ? std::ceil(scaledV) : std::floor(scaledV);
+        const std::int16_t trial[2] = {
+            static_cast<std::int16_t>(std::min(std::max(roundedU, -kSnorm16Max), kSnorm16Max)),
+            static_cast<std::int16_t>(std::min(std::max(roundedV, -kSnorm16Max), kSnorm16Max))
+        };
+        
+        const Gs::Vector3f decoded = DecodeOctahedral(trial);
+        const float dot = (decoded.x * normal.x + decoded.y * normal.y + decoded.z * normal.z) / normalLength;
+        if (dot > bestDot) {
+            bestDot = dot;
+            encoded[0] = trial[0];
+            encoded[1] = trial[1];
+        }
+    }
+}
+
+Gs::Vector3f VertexQuantizer::DecodeOctahedral(const std::int16_t encoded[2]) {
+    float x = DecodeSnorm16(encoded[0]);
+    float y = DecodeSnorm16(encoded[1]);
+    const float z = 1.0f - std::abs(x) - std::abs(y);
+    
+    // Unfold the lower hemisphere
+    const float t = std::max(-z, 0.0f);
+    x += (x >= 0.0f) ? -t : t;
+    y += (y >= 0.0f) ? -t : t;
+    
+    const float length = std::sqrt(x * x + y * y + z * z);
+    return Gs::Vector3f(x / length, y / length, z / length);
+}
+
+std::uint16_t VertexQuantizer::FloatToHalf(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    
+    const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+    const std::uint32_t magnitude = bits & 0x7FFFFFFFu;
+    
+    if (magnitude >= 0x7F800000u) {
+        // Infinity stays infinity, NaN stays a (quiet) NaN
+        return static_cast<std::uint16_t>(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x0200u : 0u));
+    }
+    if (magnitude >= 0x477FF000u) {
+        // 65520 and above round past the largest half (65504)
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+    if (magnitude < 0x38800000u) {
+        // Below the smallest normal half: subnormal in units of 2^-24, rounded to nearest even
+        float absolute;
+        std::memcpy(&absolute, &magnitude, sizeof(absolute));
+        return static_cast<std::uint16_t>(sign | static_cast<std::uint16_t>(std::nearbyint(absolute * 16777216.0f)));
+    }
+    
+    // Rebias the exponent from 127 to 15 and round the mantissa from 23 to 10 bits, ties to even
+    const std::uint32_t rebiased = magnitude - 0x38000000u;
+    const std::uint32_t rounded = (rebiased + 0x0FFFu + ((rebiased >> 13) & 1u)) >> 13;
+    return static_cast<std::uint16_t>(sign | rounded);
+}
+
+float VertexQuantizer::HalfToFloat(std::uint16_t half) {
+    const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+    const std::uint32_t exponent = (half >> 10) & 0x1Fu;
+    const std::uint32_t mantissa = half & 0x3FFu;
+    
+    std::uint32_t bits;
+    if (exponent == 0) {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    } else if (exponent == 31) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace RenderingPlugin
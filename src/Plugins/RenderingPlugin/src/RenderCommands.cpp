@@ -5,20 +5,47 @@
 
 #include "../include/RenderCommands.h"
 #include "../include/ResourceManager.h"
+#include "../include/UploadAllocator.h"
+#include <LLGL/Utils/VertexFormat.h>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cstring>
 
 namespace RenderingPlugin {
 
+namespace {
+
+// LLGL limit for buffer updates recorded into a command buffer
+constexpr std::uint32_t kMaxCommandBufferUpdateSize = 65536;
+
+bool SameCamera(const Matrices& a, const Matrices& b) {
+    return std::memcmp(&a.view, &b.view, sizeof(a.view)) == 0 &&
+           std::memcmp(&a.projection, &b.projection, sizeof(a.projection)) == 0;
+}
+
+} // namespace
+
 // === RenderCommands Implementation ===
 
 RenderCommands::RenderCommands(LLGL::CommandBuffer* commandBuffer, ResourceManager* resourceManager)
     : commandBuffer_(commandBuffer)
     , resourceManager_(resourceManager)
-    , currentPipelineState_(nullptr)
-    , currentResourceHeap_(nullptr)
+    , currentIndexBuffer_(nullptr)
+    , currentVertexBufferId_(0)
     , debugGroupDepth_(0)
-    , batchingEnabled_(false) {
+    , batchingEnabled_(false)
+    , batchPipelineState_(nullptr)
+    , matrixBufferId_(0)
+    , uploadAllocator_(nullptr)
+    , matrixLayout_(nullptr)
+    , instanceStreams_(1)
+    , streamIndex_(0)
+    , workerRecording_(false)
+    , needsResourceCreation_(false)
+    , stagedBaseInstance_(0) {
     
     if (!commandBuffer_) {
         throw std::invalid_argument("CommandBuffer cannot be null");
@@ -37,9 +64,101 @@ RenderCommands::~RenderCommands() {
         EndDebugGroup();
     }
     
+    // Release instance stream resources
+    for (InstanceStream& stream : instanceStreams_) {
+        ReleaseInstanceStream(stream);
+    }
+    
     std::cout << "RenderCommands destroyed" << std::endl;
 }
 
+// === Frame Management ===
+
+void RenderCommands::BeginFrame(std::uint32_t frameIndex) {
+    if (frameIndex >= instanceStreams_.size()) {
+        instanceStreams_.resize(frameIndex + 1);
+    }
+    streamIndex_ = frameIndex;
+    
+    // The GPU has finished the frame that last used this slot, so its retired buffers are unreferenced
+    InstanceStream& stream = instanceStreams_[streamIndex_];
+    for (ResourceId id : stream.retiredBufferArrays) {
+        resourceManager_->ReleaseBufferArray(id);
+    }
+    stream.retiredBufferArrays.clear();
+    
+    for (ResourceId id : stream.retiredBuffers) {
+        resourceManager_->ReleaseBuffer(id);
+    }
+    stream.retiredBuffers.clear();
+    
+    stream.cursor = 0;
+    needsResourceCreation_ = false;
+    stagedBaseInstance_ = 0;
+    stagedInstances_.clear();
+    bindState_.Reset();
+    currentIndexBuffer_ = nullptr;
+    currentVertexBufferId_ = 0;
+}
+
+bool RenderCommands::SetUploadAllocator(UploadAllocator* allocator, LLGL::PipelineLayout* matrixLayout) {
+    if (allocator && !matrixLayout) {
+        std::cerr << "Upload allocator requires a matrix pipeline layout" << std::endl;
+        return false;
+    }
+    if (allocator && !allocator->SupportsBlockBinding()) {
+        std::cerr << "Matrix blocks would replace material heaps on this backend, using the matrix buffer" << std::endl;
+        return false;
+    }
+    
+    uploadAllocator_ = allocator;
+    matrixLayout_ = allocator ? matrixLayout : nullptr;
+    bindState_.SetMatrixBlock(nullptr, 0);
+    return true;
+}
+
+void RenderCommands::SetCommandBuffer(LLGL::CommandBuffer* commandBuffer) {
+    if (!commandBuffer) {
+        std::cerr << "CommandBuffer cannot be null" << std::endl;
+        return;
+    }
+    
+    commandBuffer_ = commandBuffer;
+    bindState_.Reset();
+    currentIndexBuffer_ = nullptr;
+    currentVertexBufferId_ = 0;
+}
+
+void RenderCommands::SetMatrixBuffer(ResourceId constantBufferId) {
+    if (constantBufferId != 0 && !resourceManager_->GetConstantBuffer(constantBufferId)) {
+        std::cerr << "Constant buffer with ID " << constantBufferId << " not found" << std::endl;
+        return;
+    }
+    
+    matrixBufferId_ = constantBufferId;
+}
+
+void RenderCommands::SetWorkerRecording(bool enabled) {
+    workerRecording_ = enabled;
+}
+
+bool RenderCommands::NeedsResourceCreation() const {
+    return needsResourceCreation_;
+}
+
+bool RenderCommands::FlushStagedInstances() {
+    if (stagedInstances_.empty()) {
+        return true;
+    }
+    
+    const InstanceStream& stream = instanceStreams_[streamIndex_];
+    const bool written = resourceManager_->UpdateBuffer(stream.bufferId, stagedInstances_.data(),
+                                                        stagedInstances_.size() * sizeof(Gs::Matrix4f),
+                                                        stagedBaseInstance_ * sizeof(Gs::Matrix4f));
+    stagedInstances_.clear();
+    return written;
+}
+
 // === Basic Render Commands ===
 
 void RenderCommands::Clear(const Color& color, bool clearDepth, bool clearStencil) {
@@ -105,7 +224,8 @@ void RenderCommands::BindPipelineState(LLGL::PipelineState* pipelineState) {
     }
     
     commandBuffer_->SetPipelineState(*pipelineState);
-    currentPipelineState_ = pipelineState;
+    bindState_.PipelineBound(pipelineState);
+    stats_.pipelineBinds++;
 }
 
 void RenderCommands::BindResourceHeap(LLGL::ResourceHeap* resourceHeap, std::uint32_t firstSet) {
@@ -115,7 +235,8 @@ void RenderCommands::BindResourceHeap(LLGL::ResourceHeap* resourceHeap, std::uin
     }
     
     commandBuffer_->SetResourceHeap(*resourceHeap, firstSet);
-    currentResourceHeap_ = resourceHeap;
+    bindState_.ResourceHeapBound(resourceHeap);
+    stats_.resourceHeapBinds++;
 }
 
 void RenderCommands::BindVertexBuffer(LLGL::Buffer* vertexBuffer, std::uint32_t slot) {
@@ -125,6 +246,8 @@ void RenderCommands::BindVertexBuffer(LLGL::Buffer* vertexBuffer, std::uint32_t
     }
     
     commandBuffer_->SetVertexBuffer(*vertexBuffer);
+    currentVertexBufferId_ = 0;
+    stats_.vertexBufferBinds++;
 }
 
 // Note: BindVertexBuffers function removed as it's not in the header file
@@ -136,45 +259,117 @@ void RenderCommands::BindIndexBuffer(LLGL::Buffer* indexBuffer, LLGL::Format for
     }
     
     commandBuffer_->SetIndexBuffer(*indexBuffer, format);
+    currentIndexBuffer_ = indexBuffer;
+}
+
+void RenderCommands::BindVertexBufferArray(LLGL::BufferArray* bufferArray) {
+    if (!bufferArray) {
+        std::cerr << "Buffer array cannot be null" << std::endl;
+        return;
+    }
+    
+    commandBuffer_->SetVertexBufferArray(*bufferArray);
+    currentVertexBufferId_ = 0;
+    stats_.vertexBufferBinds++;
 }
 
 // === Draw Commands ===
 
 void RenderCommands::Draw(uint32_t vertexCount, uint32_t firstVertex) {
-    if (!currentPipelineState_) {
+    if (!bindState_.GetPipelineState()) {
         std::cerr << "No pipeline state bound" << std::endl;
         return;
     }
     
+    BindMatrixBlock();
     commandBuffer_->Draw(vertexCount, firstVertex);
+    stats_.drawCalls++;
 }
 
 void RenderCommands::DrawIndexed(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset) {
-    if (!currentPipelineState_) {
+    if (!bindState_.GetPipelineState()) {
         std::cerr << "No pipeline state bound" << std::endl;
         return;
     }
     
+    BindMatrixBlock();
     commandBuffer_->DrawIndexed(indexCount, firstIndex, vertexOffset);
+    stats_.drawCalls++;
 }
 
 void RenderCommands::DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
-    if (!currentPipelineState_) {
+    if (!bindState_.GetPipelineState()) {
         std::cerr << "No pipeline state bound" << std::endl;
         return;
     }
     
+    BindMatrixBlock();
     commandBuffer_->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
+    stats_.drawCalls++;
 }
 
 void RenderCommands::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, 
                                          uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
-    if (!currentPipelineState_) {
+    if (!bindState_.GetPipelineState()) {
         std::cerr << "No pipeline state bound" << std::endl;
         return;
     }
     
+    BindMatrixBlock();
     commandBuffer_->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    stats_.drawCalls++;
+}
+
+void RenderCommands::DrawIndirect(LLGL::Buffer* argumentsBuffer, std::uint64_t offset, std::uint32_t drawCount,
+                                  std::uint32_t stride) {
+    if (!bindState_.GetPipelineState()) {
+        std::cerr << "No pipeline state bound" << std::endl;
+        return;
+    }
+    if (!argumentsBuffer || drawCount == 0) {
+        return;
+    }
+    
+    BindMatrixBlock();
+    if (drawCount == 1) {
+        commandBuffer_->DrawIndirect(*argumentsBuffer, offset);
+    } else {
+        commandBuffer_->DrawIndirect(*argumentsBuffer, offset, drawCount, stride);
+    }
+    stats_.drawCalls++;
+    stats_.indirectDraws += drawCount;
+}
+
+void RenderCommands::DrawIndexedIndirect(LLGL::Buffer* argumentsBuffer, std::uint64_t offset, std::uint32_t drawCount,
+                                         std::uint32_t stride) {
+    if (!bindState_.GetPipelineState()) {
+        std::cerr << "No pipeline state bound" << std::endl;
+        return;
+    }
+    if (!argumentsBuffer || drawCount == 0) {
+        return;
+    }
+    
+    BindMatrixBlock();
+    if (drawCount == 1) {
+        commandBuffer_->DrawIndexedIndirect(*argumentsBuffer, offset);
+    } else {
+        commandBuffer_->DrawIndexedIndirect(*argumentsBuffer, offset, drawCount, stride);
+    }
+    stats_.drawCalls++;
+    stats_.indirectDraws += drawCount;
+}
+
+// === Compute Commands ===
+
+void RenderCommands::Dispatch(std::uint32_t groupsX, std::uint32_t groupsY, std::uint32_t groupsZ) {
+    if (!bindState_.GetPipelineState()) {
+        std::cerr << "No pipeline state bound" << std::endl;
+        return;
+    }
+    
+    commandBuffer_->Dispatch(groupsX, groupsY, groupsZ);
+    stats_.dispatches++;
 }
 
 // === High-Level Render Commands ===
@@ -183,28 +378,83 @@ void RenderCommands::RenderObject(const struct RenderObject& renderObject,
                                  const Gs::Matrix4f& worldMatrix,
                                  const Gs::Matrix4f& viewMatrix,
                                  const Gs::Matrix4f& projectionMatrix) {
-    // RenderObject function simplified - placeholder implementation
-    std::cerr << "RenderObject not implemented" << std::endl;
+    Matrices matrices;
+    matrices.world = worldMatrix;
+    matrices.view = viewMatrix;
+    matrices.projection = projectionMatrix;
+    
+    RenderObject(renderObject, matrices);
 }
 
 void RenderCommands::RenderObject(const struct RenderObject& renderObject, const Matrices& matrices) {
-    // RenderObject function simplified - placeholder implementation
-    std::cerr << "RenderObject not implemented" << std::endl;
+    if (!renderObject.visible) {
+        return;
+    }
+    
+    LLGL::PipelineState* pipelineState = resourceManager_->GetPipelineState(renderObject.pipelineStateId);
+    LLGL::Buffer* vertexBuffer = resourceManager_->GetVertexBuffer(renderObject.vertexBufferId);
+    if (!pipelineState || !vertexBuffer) {
+        std::cerr << "Render object references missing pipeline state or vertex buffer" << std::endl;
+        return;
+    }
+    
+    DrawSingle(pipelineState,
+               resourceManager_->GetResourceHeap(renderObject.resourceHeapId),
+               vertexBuffer,
+               resourceManager_->GetIndexBuffer(renderObject.indexBufferId),
+               renderObject.indexCount,
+               renderObject.firstIndex,
+               matrices);
 }
 
 void RenderCommands::RenderObjects(const struct RenderObject* renderObjects, std::uint32_t objectCount,
                                    const Matrices* matrices) {
-    // RenderObjects function simplified - placeholder implementation
-    std::cerr << "RenderObjects not implemented" << std::endl;
+    if (!renderObjects || !matrices || objectCount == 0) {
+        return;
+    }
+    
+    if (batchingEnabled_) {
+        std::cerr << "RenderObjects cannot be called while a batch is open" << std::endl;
+        return;
+    }
+    
+    // One batch per run of entries sharing a camera; only world matrices vary per instance
+    std::uint32_t runStart = 0;
+    while (runStart < objectCount) {
+        std::uint32_t runEnd = runStart + 1;
+        while (runEnd < objectCount && SameCamera(matrices[runStart], matrices[runEnd])) {
+            ++runEnd;
+        }
+        
+        batchingEnabled_ = true;
+        batchPipelineState_ = bindState_.GetPipelineState();
+        batchItems_.clear();
+        for (std::uint32_t i = runStart; i < runEnd; ++i) {
+            if (renderObjects[i].visible) {
+                AddToBatch(renderObjects[i], matrices[i].world);
+            }
+        }
+        EndBatch(matrices[runStart].view, matrices[runStart].projection);
+        
+        runStart = runEnd;
+    }
 }
 
 void RenderCommands::RenderMesh(LLGL::Buffer* vertexBuffer, LLGL::Buffer* indexBuffer, std::uint32_t indexCount,
                                LLGL::PipelineState* pipelineState, LLGL::ResourceHeap* resourceHeap,
                                const Gs::Matrix4f& worldMatrix, const Gs::Matrix4f& viewMatrix,
                                const Gs::Matrix4f& projectionMatrix) {
-    // Implementation for rendering mesh with custom transformation
-    // This is a placeholder implementation
-    std::cerr << "RenderMesh not yet implemented" << std::endl;
+    if (!vertexBuffer || !pipelineState) {
+        std::cerr << "RenderMesh requires a vertex buffer and pipeline state" << std::endl;
+        return;
+    }
+    
+    Matrices matrices;
+    matrices.world = worldMatrix;
+    matrices.view = viewMatrix;
+    matrices.projection = projectionMatrix;
+    
+    DrawSingle(pipelineState, resourceHeap, vertexBuffer, indexBuffer, indexCount, 0, matrices);
 }
 
 // === Utility Commands ===
@@ -238,14 +488,19 @@ void RenderCommands::SetUniform(std::uint32_t location, const void* data, std::u
 }
 
 void RenderCommands::UpdateBuffer(LLGL::Buffer* buffer, const void* data, std::uint32_t size, std::uint32_t offset) {
-    if (!buffer) {
+    if (!buffer || !data) {
         std::cerr << "Invalid buffer pointer" << std::endl;
         return;
     }
     
-    // LLGL doesn't have a direct UpdateBuffer method, so we need to map and update
-    // This is a simplified implementation
-    std::cerr << "UpdateBuffer not fully implemented" << std::endl;
+    // In-stream updates are limited to small blocks; larger data goes through an UploadAllocator
+    if (size == 0 || size > kMaxCommandBufferUpdateSize) {
+        std::cerr << "UpdateBuffer size must be between 1 and " << kMaxCommandBufferUpdateSize << " bytes" << std::endl;
+        return;
+    }
+    
+    commandBuffer_->UpdateBuffer(*buffer, offset, data, size);
+    stats_.bufferUpdates++;
 }
 
 // === State Query ===
@@ -268,36 +523,348 @@ void RenderCommands::BeginBatch(LLGL::PipelineState* pipelineState) {
         return;
     }
     
+    if (batchingEnabled_) {
+        std::cerr << "Batch already in progress" << std::endl;
+        return;
+    }
+    
     batchingEnabled_ = true;
-    BindPipelineState(pipelineState);
+    batchPipelineState_ = pipelineState;
+    batchItems_.clear();
 }
 
 void RenderCommands::AddToBatch(const struct RenderObject& renderObject, const Gs::Matrix4f& worldMatrix) {
+    MeshDraw draw;
+    draw.vertexBufferId = renderObject.vertexBufferId;
+    draw.indexBufferId = renderObject.indexBufferId;
+    draw.pipelineStateId = renderObject.pipelineStateId;
+    draw.resourceHeapId = renderObject.resourceHeapId;
+    draw.indexCount = renderObject.indexCount;
+    draw.firstIndex = renderObject.firstIndex;
+    
+    AddToBatch(draw, worldMatrix);
+}
+
+void RenderCommands::AddToBatch(const MeshDraw& draw, const Gs::Matrix4f& worldMatrix) {
     if (!batchingEnabled_) {
         std::cerr << "Batching is not enabled" << std::endl;
         return;
     }
     
-    // AddToBatch function simplified - batching functionality removed
-    std::cerr << "AddToBatch not implemented - batching functionality removed" << std::endl;
+    LLGL::PipelineState* pipelineState = resourceManager_->GetPipelineState(draw.pipelineStateId);
+    if (!pipelineState) {
+        pipelineState = batchPipelineState_;
+    }
+    
+    if (!pipelineState || draw.vertexBufferId == 0) {
+        std::cerr << "Render object cannot be batched without pipeline state and vertex buffer" << std::endl;
+        return;
+    }
+    
+    BatchItem item;
+    item.pipelineState = pipelineState;
+    item.resourceHeap = resourceManager_->GetResourceHeap(draw.resourceHeapId);
+    item.vertexBufferId = draw.vertexBufferId;
+    item.indexBuffer = resourceManager_->GetIndexBuffer(draw.indexBufferId);
+    item.indexCount = draw.indexCount;
+    item.firstIndex = draw.firstIndex;
+    item.worldMatrix = worldMatrix;
+    
+    batchItems_.push_back(item);
 }
 
-
-
 void RenderCommands::EndBatch(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix) {
     if (!batchingEnabled_) {
         std::cerr << "Batching not enabled" << std::endl;
         return;
     }
     
-    // Render all batched objects with the provided view and projection matrices
-    // This is a simplified implementation
-    std::cerr << "EndBatch not fully implemented" << std::endl;
-    
     batchingEnabled_ = false;
+    batchPipelineState_ = nullptr;
+    
+    if (batchItems_.empty()) {
+        return;
+    }
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    const std::uint32_t itemCount = static_cast<std::uint32_t>(batchItems_.size());
+    
+    // Sort indices instead of items so the matrices are only moved once, into the instance stream
+    batchOrder_.resize(itemCount);
+    std::iota(batchOrder_.begin(), batchOrder_.end(), 0u);
+    
+    auto sameGroup = [this](std::uint32_t a, std::uint32_t b) {
+        const BatchItem& lhs = batchItems_[a];
+        const BatchItem& rhs = batchItems_[b];
+        return lhs.pipelineState == rhs.pipelineState &&
+               lhs.resourceHeap == rhs.resourceHeap &&
+               lhs.vertexBufferId == rhs.vertexBufferId &&
+               lhs.indexBuffer == rhs.indexBuffer &&
+               lhs.indexCount == rhs.indexCount &&
+               lhs.firstIndex == rhs.firstIndex;
+    };
+    
+    std::sort(batchOrder_.begin(), batchOrder_.end(), [this](std::uint32_t a, std::uint32_t b) {
+        const BatchItem& lhs = batchItems_[a];
+        const BatchItem& rhs = batchItems_[b];
+        if (lhs.pipelineState != rhs.pipelineState) return std::less<const void*>()(lhs.pipelineState, rhs.pipelineState);
+        if (lhs.resourceHeap != rhs.resourceHeap) return std::less<const void*>()(lhs.resourceHeap, rhs.resourceHeap);
+        if (lhs.vertexBufferId != rhs.vertexBufferId) return lhs.vertexBufferId < rhs.vertexBufferId;
+        if (lhs.indexBuffer != rhs.indexBuffer) return std::less<const void*>()(lhs.indexBuffer, rhs.indexBuffer);
+        if (lhs.indexCount != rhs.indexCount) return lhs.indexCount < rhs.indexCount;
+        if (lhs.firstIndex != rhs.firstIndex) return lhs.firstIndex < rhs.firstIndex;
+        return a < b;
+    });
+    
+    // Pack world matrices in draw order and upload them with a single write
+    instanceData_.resize(itemCount);
+    for (std::uint32_t i = 0; i < itemCount; ++i) {
+        instanceData_[i] = batchItems_[batchOrder_[i]].worldMatrix;
+    }
+    
+    if (!EnsureInstanceCapacity(itemCount)) {
+        batchItems_.clear();
+        return;
+    }
+    
+    InstanceStream& stream = instanceStreams_[streamIndex_];
+    const std::uint32_t baseInstance = stream.cursor;
+    if (workerRecording_) {
+        // Instances of consecutive batches are contiguous, so one write covers the frame
+        if (stagedInstances_.empty()) {
+            stagedBaseInstance_ = baseInstance;
+        }
+        stagedInstances_.insert(stagedInstances_.end(), instanceData_.begin(), instanceData_.end());
+    } else if (!resourceManager_->UpdateBuffer(stream.bufferId, instanceData_.data(),
+                                               itemCount * sizeof(Gs::Matrix4f),
+                                               baseInstance * sizeof(Gs::Matrix4f))) {
+        batchItems_.clear();
+        return;
+    }
+    stream.cursor += itemCount;
+    
+    // Camera matrices are shared by the whole batch; each draw rebinds the block if needed
+    Matrices matrices;
+    matrices.view = viewMatrix;
+    matrices.projection = projectionMatrix;
+    SetupMatrices(matrices);
+    
+    // Emit one instanced draw per group, only rebinding state that changed
+    std::uint32_t groupStart = 0;
+    while (groupStart < itemCount) {
+        std::uint32_t groupEnd = groupStart + 1;
+        while (groupEnd < itemCount && sameGroup(batchOrder_[groupStart], batchOrder_[groupEnd])) {
+            ++groupEnd;
+        }
+        
+        const BatchItem& item = batchItems_[batchOrder_[groupStart]];
+        
+        if (item.pipelineState != bindState_.GetPipelineState()) {
+            BindPipelineState(item.pipelineState);
+        }
+        
+        if (item.resourceHeap && item.resourceHeap != bindState_.GetResourceHeap()) {
+            BindResourceHeap(item.resourceHeap);
+        }
+        
+        if (item.vertexBufferId != currentVertexBufferId_) {
+            LLGL::BufferArray* bufferArray = GetInstancedBufferArray(item.vertexBufferId);
+            if (!bufferArray) {
+                groupStart = groupEnd;
+                continue;
+            }
+            commandBuffer_->SetVertexBufferArray(*bufferArray);
+            currentVertexBufferId_ = item.vertexBufferId;
+            stats_.vertexBufferBinds++;
+        }
+        
+        const std::uint32_t instanceCount = groupEnd - groupStart;
+        if (item.indexBuffer) {
+            if (item.indexBuffer != currentIndexBuffer_) {
+                BindIndexBuffer(item.indexBuffer);
+            }
+            DrawIndexedInstanced(item.indexCount, instanceCount, item.firstIndex, 0, baseInstance + groupStart);
+        } else {
+            DrawInstanced(item.indexCount, instanceCount, item.firstIndex, baseInstance + groupStart);
+        }
+        
+        stats_.batchGroups++;
+        groupStart = groupEnd;
+    }
+    
+    stats_.batchedObjects += itemCount;
+    batchItems_.clear();
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    stats_.batchCpuTimeMs += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+void RenderCommands::SetCameraMatrices(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix) {
+    Matrices matrices;
+    matrices.view = viewMatrix;
+    matrices.projection = projectionMatrix;
+    SetupMatrices(matrices);
+}
+
+const LLGL::VertexFormat& RenderCommands::GetInstanceVertexFormat() {
+    static const LLGL::VertexFormat format = []() {
+        LLGL::VertexFormat instanceFormat;
+        for (std::uint32_t column = 0; column < 4; ++column) {
+            instanceFormat.AppendAttribute({ "world", column, LLGL::Format::RGBA32Float, 4 + column, 1 });
+        }
+        instanceFormat.SetSlot(1);
+        return instanceFormat;
+    }();
+    return format;
+}
+
+const RenderCommandStats& RenderCommands::GetStatistics() const {
+    return stats_;
+}
+
+void RenderCommands::ResetStatistics() {
+    stats_ = RenderCommandStats();
+}
+
+// === Private Methods ===
+
+void RenderCommands::SetupMatrices(const Matrices& matrices) {
+    if (uploadAllocator_) {
+        // Append to the frame's upload stream; the next draw binds the block by offset
+        const std::uint64_t stride = uploadAllocator_->GetBlockStride(sizeof(Matrices));
+        UploadAllocation allocation = uploadAllocator_->Upload(&matrices, sizeof(Matrices), stride);
+        LLGL::ResourceHeap* blockHeap = uploadAllocator_->GetBlockHeap(matrixLayout_, sizeof(Matrices));
+        if (!allocation.IsValid() || !blockHeap) {
+            bindState_.SetMatrixBlock(nullptr, 0);
+            return;
+        }
+        
+        bindState_.SetMatrixBlock(blockHeap, uploadAllocator_->GetBlockIndex(allocation, sizeof(Matrices)));
+        stats_.uploadAllocations++;
+        return;
+    }
+    
+    // Without a matrix buffer the caller supplies matrices through its own resources
+    LLGL::Buffer* matrixBuffer = resourceManager_->GetConstantBuffer(matrixBufferId_);
+    if (!matrixBuffer) {
+        return;
+    }
+    
+    UpdateBuffer(matrixBuffer, &matrices, sizeof(Matrices));
+}
+
+void RenderCommands::BindMatrixBlock() {
+    LLGL::ResourceHeap* blockHeap = nullptr;
+    std::uint32_t blockIndex = 0;
+    if (bindState_.TakeMatrixBlock(blockHeap, blockIndex)) {
+        // Replaces only its own slot, since SetUploadAllocator rejects set-based backends
+        commandBuffer_->SetResourceHeap(*blockHeap, blockIndex);
+        stats_.resourceHeapBinds++;
+    }
+}
+
+void RenderCommands::DrawSingle(LLGL::PipelineState* pipelineState, LLGL::ResourceHeap* resourceHeap,
+                                LLGL::Buffer* vertexBuffer, LLGL::Buffer* indexBuffer,
+                                std::uint32_t indexCount, std::uint32_t firstIndex, const Matrices& matrices) {
+    if (pipelineState != bindState_.GetPipelineState()) {
+        BindPipelineState(pipelineState);
+    }
+    
+    if (resourceHeap && resourceHeap != bindState_.GetResourceHeap()) {
+        BindResourceHeap(resourceHeap);
+    }
+    
+    BindVertexBuffer(vertexBuffer);
+    SetupMatrices(matrices);
+    
+    if (indexBuffer) {
+        if (indexBuffer != currentIndexBuffer_) {
+            BindIndexBuffer(indexBuffer);
+        }
+        DrawIndexed(indexCount, firstIndex);
+    } else {
+        Draw(indexCount, firstIndex);
+    }
+}
+
+bool RenderCommands::EnsureInstanceCapacity(std::uint32_t instanceCount) {
+    InstanceStream& stream = instanceStreams_[streamIndex_];
+    if (stream.bufferId != 0 && stream.cursor + instanceCount <= stream.capacity) {
+        return true;
+    }
+    
+    if (workerRecording_) {
+        needsResourceCreation_ = true;
+        return false;
+    }
+    
+    // Grow geometrically; the old buffer may still be referenced by commands recorded this frame
+    std::uint32_t newCapacity = std::max<std::uint32_t>(1024, stream.capacity * 2);
+    while (newCapacity < instanceCount) {
+        newCapacity *= 2;
+    }
+    
+    ResourceId newBufferId = resourceManager_->CreateInstanceBuffer(
+        static_cast<size_t>(newCapacity) * sizeof(Gs::Matrix4f), GetInstanceVertexFormat());
+    if (newBufferId == 0) {
+        std::cerr << "Failed to grow instance buffer to " << newCapacity << " instances" << std::endl;
+        return false;
+    }
+    
+    if (stream.bufferId != 0) {
+        stream.retiredBuffers.push_back(stream.bufferId);
+    }
+    for (const auto& entry : stream.bufferArrays) {
+        stream.retiredBufferArrays.push_back(entry.second);
+    }
+    stream.bufferArrays.clear();
+    
+    stream.bufferId = newBufferId;
+    stream.capacity = newCapacity;
+    stream.cursor = 0;
+    currentVertexBufferId_ = 0;
+    return true;
 }
 
+LLGL::BufferArray* RenderCommands::GetInstancedBufferArray(ResourceId vertexBufferId) {
+    InstanceStream& stream = instanceStreams_[streamIndex_];
+    auto it = stream.bufferArrays.find(vertexBufferId);
+    if (it != stream.bufferArrays.end()) {
+        return resourceManager_->GetBufferArray(it->second);
+    }
+    
+    if (workerRecording_) {
+        needsResourceCreation_ = true;
+        return nullptr;
+    }
+    
+    ResourceId arrayId = resourceManager_->CreateBufferArray({ vertexBufferId, stream.bufferId });
+    if (arrayId == 0) {
+        return nullptr;
+    }
+    
+    stream.bufferArrays[vertexBufferId] = arrayId;
+    return resourceManager_->GetBufferArray(arrayId);
+}
 
+void RenderCommands::ReleaseInstanceStream(InstanceStream& stream) {
+    // Buffer arrays before the buffers they reference
+    for (const auto& entry : stream.bufferArrays) {
+        resourceManager_->ReleaseBufferArray(entry.second);
+    }
+    for (ResourceId id : stream.retiredBufferArrays) {
+        resourceManager_->ReleaseBufferArray(id);
+    }
+    for (ResourceId id : stream.retiredBuffers) {
+        resourceManager_->ReleaseBuffer(id);
+    }
+    if (stream.bufferId != 0) {
+        resourceManager_->ReleaseBuffer(stream.bufferId);
+    }
+    
+    stream = InstanceStream();
+}
 
 // Advanced rendering functions removed - not declared in header file
 
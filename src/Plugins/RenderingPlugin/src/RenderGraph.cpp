@@ -0,0 +1,714 @@
+/**
+ * @file RenderGraph.cpp
+ * @brief Implementation of RenderGraph class
+ */
+
+#include "../include/RenderGraph.h"
+#include "../include/RenderCommands.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace RenderingPlugin {
+
+namespace {
+
+// Graph frames a pooled texture may go unused before it is released, so textures of passes that
+// are skipped for a frame or two are not recreated; the release scheduler keeps them alive until
+// the GPU finished the frames that used them
+constexpr std::uint64_t kUnusedFramesBeforeRelease = 5;
+
+constexpr std::uint32_t kMaxColorAttachments = 8;
+
+constexpr std::uint32_t kNoPass = std::numeric_limits<std::uint32_t>::max();
+
+long UsageBindFlags(RenderGraphUsage usage) {
+    switch (usage) {
+        case RenderGraphUsage::ColorAttachment: return LLGL::BindFlags::ColorAttachment;
+        case RenderGraphUsage::DepthAttachment: return LLGL::BindFlags::DepthStencilAttachment;
+        case RenderGraphUsage::Sampled:         return LLGL::BindFlags::Sampled;
+        case RenderGraphUsage::Storage:         return LLGL::BindFlags::Storage;
+        default:                                return 0;
+    }
+}
+
+} // namespace
+
+// === RenderGraphBuilder Implementation ===
+
+RenderGraphBuilder::RenderGraphBuilder(RenderGraph& graph, std::uint32_t pass)
+    : graph_(graph)
+    , pass_(pass) {
+}
+
+void RenderGraphBuilder::Read(RenderGraphResource resource) {
+    if (!graph_.FindResource(resource)) {
+        std::cerr << "Render graph pass reads unknown resource " << resource << std::endl;
+        return;
+    }
+    graph_.passes_[pass_].reads.push_back(resource);
+}
+
+void RenderGraphBuilder::ReadWrite(RenderGraphResource resource) {
+    const RenderGraph::ResourceNode* node = graph_.FindResource(resource);
+    if (!node || node->importedTarget) {
+        std::cerr << "Render graph pass writes invalid storage texture " << resource << std::endl;
+        return;
+    }
+    graph_.passes_[pass_].storage.push_back(resource);
+}
+
+void RenderGraphBuilder::WriteColor(RenderGraphResource resource) {
+    RenderGraph::PassNode& pass = graph_.passes_[pass_];
+    if (!graph_.FindResource(resource) || pass.colorAttachments.size() >= kMaxColorAttachments) {
+        std::cerr << "Render graph pass writes invalid color attachment " << resource << std::endl;
+        return;
+    }
+    RenderGraph::Attachment attachment;
+    attachment.resource = resource;
+    pass.colorAttachments.push_back(attachment);
+}
+
+void RenderGraphBuilder::WriteColor(RenderGraphResource resource, const Color& clearColor) {
+    const std::size_t count = graph_.passes_[pass_].colorAttachments.size();
+    WriteColor(resource);
+    
+    std::vector<RenderGraph::Attachment>& attachments = graph_.passes_[pass_].colorAttachments;
+    if (attachments.size() > count) {
+        RenderGraph::Attachment& attachment = attachments.back();
+        attachment.clear = true;
+        attachment.clearColor[0] = clearColor.r;
+        attachment.clearColor[1] = clearColor.g;
+        attachment.clearColor[2] = clearColor.b;
+        attachment.clearColor[3] = clearColor.a;
+    }
+}
+
+void RenderGraphBuilder::WriteDepth(RenderGraphResource resource, bool clear) {
+    const RenderGraph::ResourceNode* node = graph_.FindResource(resource);
+    if (!node || node->importedTarget) {
+        std::cerr << "Render graph pass writes invalid depth attachment " << resource << std::endl;
+        return;
+    }
+    RenderGraph::Attachment& attachment = graph_.passes_[pass_].depthAttachment;
+    attachment.resource = resource;
+    attachment.clear = clear;
+}
+
+void RenderGraphBuilder::SetSideEffect() {
+    graph_.passes_[pass_].sideEffect = true;
+}
+
+// === RenderGraphContext Implementation ===
+
+RenderGraphContext::RenderGraphContext(const RenderGraph& graph, RenderCommands& commands, std::uint32_t width, std::uint32_t height)
+    : graph_(graph)
+    , commands_(commands)
+    , width_(width)
+    , height_(height) {
+}
+
+RenderCommands& RenderGraphContext::GetCommands() const {
+    return commands_;
+}
+
+LLGL::CommandBuffer& RenderGraphContext::GetCommandBuffer() const {
+    return *commands_.GetCommandBuffer();
+}
+
+LLGL::Texture* RenderGraphContext::GetTexture(RenderGraphResource resource) const {
+    return graph_.GetTexture(resource);
+}
+
+std::uint32_t RenderGraphContext::GetWidth() const {
+    return width_;
+}
+
+std::uint32_t RenderGraphContext::GetHeight() const {
+    return height_;
+}
+
+// === RenderGraph Implementation ===
+
+RenderGraph::RenderGraph(LLGL::RenderSystem* renderSystem)
+    : renderSystem_(renderSystem)
+    , compiled_(false)
+    , frame_(0) {
+}
+
+RenderGraph::~RenderGraph() {
+    ReleaseTextures();
+}
+
+// === Graph Building ===
+
+void RenderGraph::Reset() {
+    resources_.clear();
+    passes_.clear();
+    compiled_ = false;
+    ++frame_;
+}
+
+RenderGraphResource RenderGraph::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc) {
+    if (desc.width == 0 || desc.height == 0) {
+        std::cerr << "Invalid render graph texture size for " << name << ": " << desc.width << "x" << desc.height << std::endl;
+        return 0;
+    }
+    
+    ResourceNode node;
+    node.name = name;
+    node.desc = desc;
+    resources_.push_back(node);
+    compiled_ = false;
+    return static_cast<RenderGraphResource>(resources_.size());
+}
+
+RenderGraphResource RenderGraph::ImportTexture(const std::string& name, LLGL::Texture* texture) {
+    if (!texture) {
+        std::cerr << "Cannot import null texture " << name << " into render graph" << std::endl;
+        return 0;
+    }
+    
+    const LLGL::Extent3D extent = texture->GetMipExtent(0);
+    ResourceNode node;
+    node.name = name;
+    node.desc.width = extent.width;
+    node.desc.height = extent.height;
+    node.desc.format = texture->GetFormat();
+    node.importedTexture = texture;
+    resources_.push_back(node);
+    compiled_ = false;
+    return static_cast<RenderGraphResource>(resources_.size());
+}
+
+RenderGraphResource RenderGraph::ImportRenderTarget(const std::string& name, LLGL::RenderTarget* renderTarget) {
+    if (!renderTarget) {
+        std::cerr << "Cannot import null render target " << name << " into render graph" << std::endl;
+        return 0;
+    }
+    
+    const LLGL::Extent2D resolution = renderTarget->GetResolution();
+    ResourceNode node;
+    node.name = name;
+    node.desc.width = resolution.width;
+    node.desc.height = resolution.height;
+    node.importedTarget = renderTarget;
+    resources_.push_back(node);
+    compiled_ = false;
+    return static_cast<RenderGraphResource>(resources_.size());
+}
+
+std::uint32_t RenderGraph::AddPass(const std::string& name, const RenderGraphSetup& setup, RenderGraphExecute execute) {
+    PassNode pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    passes_.push_back(std::move(pass));
+    compiled_ = false;
+    
+    const std::uint32_t index = static_cast<std::uint32_t>(passes_.size() - 1);
+    if (setup) {
+        RenderGraphBuilder builder(*this, index);
+        setup(builder);
+    }
+    return index;
+}
+
+// === Compilation and Execution ===
+
+bool RenderGraph::Compile() {
+    if (compiled_) {
+        return true;
+    }
+    
+    // All attachments of a pass must cover the same area
+    for (const PassNode& pass : passes_) {
+        const std::size_t attachmentCount = pass.colorAttachments.size() + (pass.depthAttachment.resource ? 1 : 0);
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        for (std::size_t i = 0; i < attachmentCount; ++i) {
+            const RenderGraphResource resource = (i < pass.colorAttachments.size())
+                ? pass.colorAttachments[i].resource
+                : pass.depthAttachment.resource;
+            const ResourceNode& node = resources_[resource - 1];
+            if (node.importedTarget && attachmentCount > 1) {
+                std::cerr << "Render graph pass " << pass.name << " combines render target " << node.name << " with other attachments" << std::endl;
+                return false;
+            }
+            if (i > 0 && (node.desc.width != width || node.desc.height != height)) {
+                std::cerr << "Render graph pass " << pass.name << " has attachments of different sizes" << std::endl;
+                return false;
+            }
+            width = node.desc.width;
+            height = node.desc.height;
+        }
+    }
+    
+    stats_ = RenderGraphStats();
+    stats_.passesDeclared = static_cast<std::uint32_t>(passes_.size());
+    
+    CullPasses();
+    ReleaseUnusedTextures();
+    AssignPhysicalTextures();
+    ComputeBarriers();
+    
+    for (const PassNode& pass : passes_) {
+        if (!pass.culled) {
+            ++stats_.passesExecuted;
+            stats_.barriers += static_cast<std::uint32_t>(pass.barriers.size());
+        }
+    }
+    for (const ResourceNode& node : resources_) {
+        if (node.physical != kNone) {
+            ++stats_.transientTextures;
+            stats_.unaliasedMemoryBytes += GetTextureMemory(node.desc);
+        }
+    }
+    for (const PhysicalTexture& physical : physicalTextures_) {
+        if (physical.assigned) {
+            ++stats_.physicalTextures;
+            stats_.transientMemoryBytes += GetTextureMemory(physical.desc);
+        }
+        stats_.pooledMemoryBytes += GetTextureMemory(physical.desc);
+    }
+    
+    compiled_ = true;
+    return true;
+}
+
+bool RenderGraph::Execute(RenderCommands& commands) {
+    if (!Compile()) {
+        return false;
+    }
+    if (!renderSystem_) {
+        std::cerr << "Executing a render graph requires a render system" << std::endl;
+        return false;
+    }
+    
+    LLGL::CommandBuffer* commandBuffer = commands.GetCommandBuffer();
+    if (!commandBuffer) {
+        std::cerr << "Render graph executed without a command buffer" << std::endl;
+        return false;
+    }
+    
+    for (PhysicalTexture& physical : physicalTextures_) {
+        if (!physical.assigned || physical.texture) {
+            continue;
+        }
+        
+        LLGL::TextureDescriptor textureDesc;
+        textureDesc.type = LLGL::TextureType::Texture2D;
+        textureDesc.format = physical.desc.format;
+        textureDesc.extent = { physical.desc.width, physical.desc.height, 1 };
+        textureDesc.mipLevels = 1;
+        textureDesc.bindFlags = physical.bindFlags;
+        physical.texture = renderSystem_->CreateTexture(textureDesc);
+        if (!physical.texture) {
+            std::cerr << "Failed to create render graph texture (" << physical.desc.width << "x" << physical.desc.height << ")" << std::endl;
+            return false;
+        }
+        ++stats_.texturesCreated;
+    }
+    
+    std::vector<LLGL::Texture*> storageTextures;
+    for (const PassNode& pass : passes_) {
+        if (pass.culled) {
+            continue;
+        }
+        
+        // Storage writes are not tracked by the backends; everything else transitions at pass boundaries
+        storageTextures.clear();
+        for (const RenderGraphBarrier& barrier : pass.barriers) {
+            LLGL::Texture* texture = GetTexture(barrier.resource);
+            if (barrier.before == RenderGraphUsage::Storage && texture) {
+                storageTextures.push_back(texture);
+            }
+        }
+        if (!storageTextures.empty()) {
+            commandBuffer->ResourceBarrier(0, nullptr, static_cast<std::uint32_t>(storageTextures.size()), storageTextures.data());
+        }
+        
+        const bool hasAttachments = !pass.colorAttachments.empty() || pass.depthAttachment.resource;
+        const RenderGraphResource areaResource = !pass.colorAttachments.empty()
+            ? pass.colorAttachments.front().resource
+            : pass.depthAttachment.resource;
+        const std::uint32_t width = hasAttachments ? resources_[areaResource - 1].desc.width : 0;
+        const std::uint32_t height = hasAttachments ? resources_[areaResource - 1].desc.height : 0;
+        
+        // Bindings of the previous pass do not carry over into a new render pass
+        commands.SetCommandBuffer(commandBuffer);
+        commands.BeginDebugGroup(pass.name);
+        
+        if (hasAttachments) {
+            LLGL::RenderTarget* renderTarget = AcquireRenderTarget(pass, width, height);
+            if (!renderTarget) {
+                commands.EndDebugGroup();
+                return false;
+            }
+            commandBuffer->BeginRenderPass(*renderTarget);
+            
+            std::vector<LLGL::AttachmentClear> clears;
+            for (std::uint32_t i = 0; i < pass.colorAttachments.size(); ++i) {
+                const Attachment& attachment = pass.colorAttachments[i];
+                if (attachment.clear) {
+                    LLGL::AttachmentClear clear;
+                    clear.flags = LLGL::ClearFlags::Color;
+                    clear.colorAttachment = i;
+                    std::copy(attachment.clearColor, attachment.clearColor + 4, clear.clearValue.color);
+                    clears.push_back(clear);
+                }
+            }
+            if (pass.depthAttachment.resource && pass.depthAttachment.clear) {
+                LLGL::AttachmentClear clear;
+                clear.flags = LLGL::ClearFlags::Depth;
+                clear.clearValue.depth = 1.0f;
+                clears.push_back(clear);
+            }
+            
+            // Imported render targets such as the swap chain bring their own depth buffer
+            if (resources_[areaResource - 1].importedTarget && !clears.empty()) {
+                commandBuffer->Clear(LLGL::ClearFlags::ColorDepth, clears.front().clearValue);
+            } else if (!clears.empty()) {
+                commandBuffer->ClearAttachments(static_cast<std::uint32_t>(clears.size()), clears.data());
+            }
+            commands.SetViewport(0, 0, static_cast<int>(width), static_cast<int>(height));
+        }
+        
+        if (pass.execute) {
+            RenderGraphContext context(*this, commands, width, height);
+            pass.execute(context);
+        }
+        
+        if (hasAttachments) {
+            commandBuffer->EndRenderPass();
+        }
+        commands.EndDebugGroup();
+    }
+    return true;
+}
+
+bool RenderGraph::IsPassCulled(std::uint32_t pass) const {
+    return pass >= passes_.size() || passes_[pass].culled;
+}
+
+const std::vector<RenderGraphBarrier>& RenderGraph::GetBarriers(std::uint32_t pass) const {
+    static const std::vector<RenderGraphBarrier> kNoBarriers;
+    return (pass < passes_.size()) ? passes_[pass].barriers : kNoBarriers;
+}
+
+bool RenderGraph::AreAliased(RenderGraphResource first, RenderGraphResource second) const {
+    const ResourceNode* firstNode = FindResource(first);
+    const ResourceNode* secondNode = FindResource(second);
+    return firstNode && secondNode && firstNode->physical != kNone && firstNode->physical == secondNode->physical;
+}
+
+LLGL::Texture* RenderGraph::GetTexture(RenderGraphResource resource) const {
+    const ResourceNode* node = FindResource(resource);
+    if (!node) {
+        return nullptr;
+    }
+    if (node->importedTexture) {
+        return node->importedTexture;
+    }
+    return (node->physical != kNone) ? physicalTextures_[node->physical].texture : nullptr;
+}
+
+void RenderGraph::ReleaseTextures() {
+    std::vector<LLGL::RenderTarget*> renderTargets;
+    std::vector<LLGL::Texture*> textures;
+    for (CachedRenderTarget& cached : renderTargets_) {
+        renderTargets.push_back(cached.renderTarget);
+    }
+    renderTargets_.clear();
+    for (PhysicalTexture& physical : physicalTextures_) {
+        if (physical.texture) {
+            textures.push_back(physical.texture);
+        }
+    }
+    physicalTextures_.clear();
+    ReleaseObjects(std::move(renderTargets), std::move(textures));
+    
+    for (ResourceNode& node : resources_) {
+        node.physical = kNone;
+    }
+    compiled_ = false;
+}
+
+void RenderGraph::SetReleaseScheduler(ReleaseScheduler scheduler) {
+    releaseScheduler_ = std::move(scheduler);
+}
+
+// === Statistics ===
+
+const RenderGraphStats& RenderGraph::GetStatistics() const {
+    return stats_;
+}
+
+std::uint64_t RenderGraph::GetTextureMemory(const RenderGraphTextureDesc& desc) {
+    const std::uint64_t bytesPerPixel = LLGL::GetFormatAttribs(desc.format).bitSize / 8;
+    return static_cast<std::uint64_t>(desc.width) * desc.height * bytesPerPixel;
+}
+
+// === Private Methods ===
+
+RenderGraph::ResourceNode* RenderGraph::FindResource(RenderGraphResource resource) {
+    return (resource > 0 && resource <= resources_.size()) ? &resources_[resource - 1] : nullptr;
+}
+
+const RenderGraph::ResourceNode* RenderGraph::FindResource(RenderGraphResource resource) const {
+    return (resource > 0 && resource <= resources_.size()) ? &resources_[resource - 1] : nullptr;
+}
+
+void RenderGraph::CullPasses() {
+    // Walk backwards, keeping a pass if it writes something a kept later pass needs
+    std::vector<bool> needed(resources_.size(), false);
+    for (std::size_t i = passes_.size(); i-- > 0;) {
+        PassNode& pass = passes_[i];
+        
+        bool kept = pass.sideEffect;
+        auto checkWrite = [&](RenderGraphResource resource) {
+            kept = kept || resources_[resource - 1].IsImported() || needed[resource - 1];
+        };
+        for (const Attachment& attachment : pass.colorAttachments) {
+            checkWrite(attachment.resource);
+        }
+        if (pass.depthAttachment.resource) {
+            checkWrite(pass.depthAttachment.resource);
+        }
+        for (RenderGraphResource resource : pass.storage) {
+            checkWrite(resource);
+        }
+        
+        pass.culled = !kept;
+        if (!kept) {
+            continue;
+        }
+        
+        // A cleared attachment hides earlier writes; a loaded one depends on them
+        for (const Attachment& attachment : pass.colorAttachments) {
+            needed[attachment.resource - 1] = !attachment.clear;
+        }
+        if (pass.depthAttachment.resource) {
+            needed[pass.depthAttachment.resource - 1] = !pass.depthAttachment.clear;
+        }
+        for (RenderGraphResource resource : pass.storage) {
+            needed[resource - 1] = true;
+        }
+        for (RenderGraphResource resource : pass.reads) {
+            needed[resource - 1] = true;
+        }
+    }
+}
+
+void RenderGraph::AssignPhysicalTextures() {
+    for (ResourceNode& node : resources_) {
+        node.firstPass = kNoPass;
+        node.lastPass = 0;
+        node.bindFlags = 0;
+        node.physical = kNone;
+    }
+    
+    auto use = [this](RenderGraphResource resource, std::uint32_t pass, RenderGraphUsage usage) {
+        ResourceNode& node = resources_[resource - 1];
+        node.firstPass = std::min(node.firstPass, pass);
+        node.lastPass = std::max(node.lastPass, pass);
+        node.bindFlags |= UsageBindFlags(usage);
+    };
+    for (std::uint32_t i = 0; i < passes_.size(); ++i) {
+        const PassNode& pass = passes_[i];
+        if (pass.culled) {
+            continue;
+        }
+        for (RenderGraphResource resource : pass.reads) {
+            use(resource, i, RenderGraphUsage::Sampled);
+        }
+        for (RenderGraphResource resource : pass.storage) {
+            use(resource, i, RenderGraphUsage::Storage);
+        }
+        for (const Attachment& attachment : pass.colorAttachments) {
+            use(attachment.resource, i, RenderGraphUsage::ColorAttachment);
+        }
+        if (pass.depthAttachment.resource) {
+            use(pass.depthAttachment.resource, i, RenderGraphUsage::DepthAttachment);
+        }
+    }
+    
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < resources_.size(); ++i) {
+        if (!resources_[i].IsImported() && resources_[i].firstPass != kNoPass) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return resources_[a].firstPass < resources_[b].firstPass;
+    });
+    
+    // In order of first use, any pooled texture whose last user ended before is free again
+    for (PhysicalTexture& physical : physicalTextures_) {
+        physical.assigned = false;
+    }
+    for (std::size_t index : order) {
+        ResourceNode& node = resources_[index];
+        std::size_t match = kNone;
+        for (std::size_t p = 0; p < physicalTextures_.size(); ++p) {
+            const PhysicalTexture& physical = physicalTextures_[p];
+            if (physical.desc.width == node.desc.width &&
+                physical.desc.height == node.desc.height &&
+                physical.desc.format == node.desc.format &&
+                (physical.bindFlags & node.bindFlags) == node.bindFlags &&
+                (!physical.assigned || physical.lastPass < node.firstPass)) {
+                match = p;
+                break;
+            }
+        }
+        if (match == kNone) {
+            PhysicalTexture physical;
+            physical.desc = node.desc;
+            physical.bindFlags = node.bindFlags;
+            physicalTextures_.push_back(physical);
+            match = physicalTextures_.size() - 1;
+        }
+        
+        PhysicalTexture& physical = physicalTextures_[match];
+        physical.assigned = true;
+        physical.lastPass = node.lastPass;
+        physical.lastFrame = frame_;
+        node.physical = match;
+    }
+}
+
+void RenderGraph::ComputeBarriers() {
+    std::vector<RenderGraphUsage> importedUsage(resources_.size(), RenderGraphUsage::Undefined);
+    std::vector<RenderGraphResource> physicalOwner(physicalTextures_.size(), 0);
+    for (PhysicalTexture& physical : physicalTextures_) {
+        physical.usage = RenderGraphUsage::Undefined;
+    }
+    
+    for (PassNode& pass : passes_) {
+        pass.barriers.clear();
+        if (pass.culled) {
+            continue;
+        }
+        
+        auto access = [&](RenderGraphResource resource, RenderGraphUsage usage) {
+            const ResourceNode& node = resources_[resource - 1];
+            RenderGraphUsage& current = node.IsImported() ? importedUsage[resource - 1] : physicalTextures_[node.physical].usage;
+            const bool aliasChange = !node.IsImported() && physicalOwner[node.physical] != resource;
+            if (current != RenderGraphUsage::Undefined &&
+                (current != usage || usage == RenderGraphUsage::Storage || aliasChange)) {
+                RenderGraphBarrier barrier;
+                barrier.resource = resource;
+                barrier.before = current;
+                barrier.after = usage;
+                pass.barriers.push_back(barrier);
+            }
+            current = usage;
+            if (!node.IsImported()) {
+                physicalOwner[node.physical] = resource;
+            }
+        };
+        for (RenderGraphResource resource : pass.reads) {
+            access(resource, RenderGraphUsage::Sampled);
+        }
+        for (RenderGraphResource resource : pass.storage) {
+            access(resource, RenderGraphUsage::Storage);
+        }
+        for (const Attachment& attachment : pass.colorAttachments) {
+            access(attachment.resource, RenderGraphUsage::ColorAttachment);
+        }
+        if (pass.depthAttachment.resource) {
+            access(pass.depthAttachment.resource, RenderGraphUsage::DepthAttachment);
+        }
+    }
+}
+
+void RenderGraph::ReleaseUnusedTextures() {
+    std::vector<LLGL::RenderTarget*> renderTargets;
+    std::vector<LLGL::Texture*> textures;
+    for (std::size_t i = renderTargets_.size(); i-- > 0;) {
+        if (renderTargets_[i].lastFrame + kUnusedFramesBeforeRelease <= frame_) {
+            renderTargets.push_back(renderTargets_[i].renderTarget);
+            renderTargets_.erase(renderTargets_.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+    for (std::size_t i = physicalTextures_.size(); i-- > 0;) {
+        PhysicalTexture& physical = physicalTextures_[i];
+        if (physical.lastFrame + kUnusedFramesBeforeRelease <= frame_) {
+            if (physical.texture) {
+                textures.push_back(physical.texture);
+                ++stats_.texturesReleased;
+            }
+            physicalTextures_.erase(physicalTextures_.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+    ReleaseObjects(std::move(renderTargets), std::move(textures));
+}
+
+void RenderGraph::ReleaseObjects(std::vector<LLGL::RenderTarget*> renderTargets, std::vector<LLGL::Texture*> textures) {
+    if (!renderSystem_ || (renderTargets.empty() && textures.empty())) {
+        return;
+    }
+    
+    // Captures no member, so the release may run after this instance is destroyed
+    LLGL::RenderSystem* renderSystem = renderSystem_;
+    auto release = [renderSystem, renderTargets, textures]() {
+        // Render targets before the textures they reference
+        for (LLGL::RenderTarget* renderTarget : renderTargets) {
+            renderSystem->Release(*renderTarget);
+        }
+        for (LLGL::Texture* texture : textures) {
+            renderSystem->Release(*texture);
+        }
+    };
+    
+    if (releaseScheduler_) {
+        releaseScheduler_(release);
+    } else {
+        release();
+    }
+}
+
+LLGL::RenderTarget* RenderGraph::AcquireRenderTarget(const PassNode& pass, std::uint32_t width, std::uint32_t height) {
+    if (!pass.colorAttachments.empty()) {
+        LLGL::RenderTarget* imported = resources_[pass.colorAttachments.front().resource - 1].importedTarget;
+        if (imported) {
+            return imported;
+        }
+    }
+    
+    std::vector<LLGL::Texture*> attachments;
+    for (const Attachment& attachment : pass.colorAttachments) {
+        attachments.push_back(GetTexture(attachment.resource));
+    }
+    attachments.push_back(pass.depthAttachment.resource ? GetTexture(pass.depthAttachment.resource) : nullptr);
+    
+    for (CachedRenderTarget& cached : renderTargets_) {
+        if (cached.attachments == attachments) {
+            cached.lastFrame = frame_;
+            return cached.renderTarget;
+        }
+    }
+    
+    LLGL::RenderTargetDescriptor renderTargetDesc;
+    renderTargetDesc.resolution = { width, height };
+    for (std::size_t i = 0; i < pass.colorAttachments.size(); ++i) {
+        renderTargetDesc.colorAttachments[i] = LLGL::AttachmentDescriptor(attachments[i]);
+    }
+    if (attachments.back()) {
+        renderTargetDesc.depthStencilAttachment = LLGL::AttachmentDescriptor(attachments.back());
+    }
+    
+    LLGL::RenderTarget* renderTarget = renderSystem_->CreateRenderTarget(renderTargetDesc);
+    if (!renderTarget) {
+        std::cerr << "Failed to create render target for render graph pass " << pass.name << std::endl;
+        return nullptr;
+    }
+    
+    CachedRenderTarget cached;
+    cached.attachments = std::move(attachments);
+    cached.renderTarget = renderTarget;
+    cached.lastFrame = frame_;
+    renderTargets_.push_back(std::move(cached));
+    return renderTarget;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,215 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of RenderQueue class
+ */
+
+#include "../include/RenderQueue.h"
+#include "../include/RenderCommands.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace RenderingPlugin {
+
+// === RenderQueue Implementation ===
+
+RenderQueue::RenderQueue(std::size_t initialCapacity)
+    : sorted_(true) {
+    packets_.reserve(initialCapacity);
+    sortEntries_.reserve(initialCapacity);
+    sortScratch_.reserve(initialCapacity);
+    sortedIndices_.reserve(initialCapacity);
+}
+
+RenderQueue::~RenderQueue() = default;
+
+// === Sort Keys ===
+
+std::uint64_t RenderQueue::MakeSortKey(std::uint8_t layer, std::uint16_t pipeline, std::uint16_t material,
+                                       float depth, bool backToFront) {
+    const float clampedDepth = std::min(std::max(depth, 0.0f), 1.0f);
+    std::uint64_t depthBits = static_cast<std::uint64_t>(clampedDepth * 16777215.0f);
+    if (backToFront) {
+        depthBits = 0xFFFFFFull - depthBits;
+    }
+    
+    return (static_cast<std::uint64_t>(layer) << 56) |
+           (static_cast<std::uint64_t>(pipeline) << 40) |
+           (static_cast<std::uint64_t>(material) << 24) |
+           depthBits;
+}
+
+// === Submission ===
+
+void RenderQueue::Submit(const DrawPacket& packet) {
+    if (!packet.pipelineState || !packet.vertexBuffer) {
+        std::cerr << "Draw packet requires a pipeline state and vertex buffer" << std::endl;
+        return;
+    }
+    
+    packets_.push_back(packet);
+    sorted_ = false;
+}
+
+const std::vector<std::uint32_t>& RenderQueue::Sort() {
+    if (sorted_ && sortedIndices_.size() == packets_.size()) {
+        return sortedIndices_;
+    }
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    const std::size_t count = packets_.size();
+    sortEntries_.resize(count);
+    sortScratch_.resize(count);
+    
+    std::uint64_t allOr = 0;
+    std::uint64_t allAnd = ~0ull;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t key = packets_[i].sortKey;
+        sortEntries_[i] = { key, static_cast<std::uint32_t>(i) };
+        allOr |= key;
+        allAnd &= key;
+    }
+    
+    // Only digits that differ between keys need a pass
+    const std::uint64_t varyingBits = allOr ^ allAnd;
+    
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varyingBits >> shift) & 0xFF) == 0) {
+            continue;
+        }
+        
+        std::uint32_t offsets[256] = {};
+        for (const SortEntry& entry : sortEntries_) {
+            offsets[(entry.key >> shift) & 0xFF]++;
+        }
+        
+        std::uint32_t sum = 0;
+        for (std::uint32_t& offset : offsets) {
+            const std::uint32_t digitCount = offset;
+            offset = sum;
+            sum += digitCount;
+        }
+        
+        for (const SortEntry& entry : sortEntries_) {
+            sortScratch_[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        
+        sortEntries_.swap(sortScratch_);
+    }
+    
+    sortedIndices_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sortedIndices_[i] = sortEntries_[i].index;
+    }
+    sorted_ = true;
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    stats_.sortTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    
+    return sortedIndices_;
+}
+
+void RenderQueue::Flush(RenderCommands& commands) {
+    // Keep the sort time if Sort() was already called for this set of packets
+    const double previousSortTime = (sorted_ && !packets_.empty()) ? stats_.sortTimeMs : 0.0;
+    stats_ = RenderQueueStats();
+    stats_.sortTimeMs = previousSortTime;
+    
+    if (packets_.empty()) {
+        return;
+    }
+    
+    const std::vector<std::uint32_t>& order = Sort();
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    LLGL::PipelineState* boundPipeline = nullptr;
+    LLGL::ResourceHeap* boundHeap = nullptr;
+    LLGL::Buffer* boundVertexBuffer = nullptr;
+    LLGL::Buffer* boundIndexBuffer = nullptr;
+    std::uint32_t naiveBinds = 0;
+    
+    for (std::uint32_t index : order) {
+        const DrawPacket& packet = packets_[index];
+        
+        // Binding cost when every packet sets its own state
+        naiveBinds += 2 + (packet.resourceHeap ? 1 : 0) + (packet.indexBuffer ? 1 : 0);
+        
+        if (packet.pipelineState != boundPipeline) {
+            commands.BindPipelineState(packet.pipelineState);
+            boundPipeline = packet.pipelineState;
+            // Bindings are not guaranteed to survive a pipeline change
+            boundHeap = nullptr;
+            stats_.pipelineBinds++;
+        }
+        
+        if (packet.resourceHeap && packet.resourceHeap != boundHeap) {
+            commands.BindResourceHeap(packet.resourceHeap);
+            boundHeap = packet.resourceHeap;
+            stats_.resourceHeapBinds++;
+        }
+        
+        if (packet.vertexBuffer != boundVertexBuffer) {
+            commands.BindVertexBuffer(packet.vertexBuffer);
+            boundVertexBuffer = packet.vertexBuffer;
+            stats_.vertexBufferBinds++;
+        }
+        
+        if (packet.indexBuffer) {
+            if (packet.indexBuffer != boundIndexBuffer) {
+                commands.BindIndexBuffer(packet.indexBuffer);
+                boundIndexBuffer = packet.indexBuffer;
+                stats_.indexBufferBinds++;
+            }
+            
+            if (packet.instanceCount > 1 || packet.firstInstance > 0) {
+                commands.DrawIndexedInstanced(packet.indexCount, packet.instanceCount, packet.firstIndex,
+                                              packet.vertexOffset, packet.firstInstance);
+            } else {
+                commands.DrawIndexed(packet.indexCount, packet.firstIndex, packet.vertexOffset);
+            }
+        } else {
+            if (packet.instanceCount > 1 || packet.firstInstance > 0) {
+                commands.DrawInstanced(packet.indexCount, packet.instanceCount, packet.firstIndex,
+                                       packet.firstInstance);
+            } else {
+                commands.Draw(packet.indexCount, packet.firstIndex);
+            }
+        }
+    }
+    
+    const std::uint32_t actualBinds = stats_.pipelineBinds + stats_.resourceHeapBinds +
+                                      stats_.vertexBufferBinds + stats_.indexBufferBinds;
+    stats_.packetCount = static_cast<std::uint32_t>(packets_.size());
+    stats_.bindsSaved = naiveBinds - actualBinds;
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    stats_.recordTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    
+    packets_.clear();
+    sortedIndices_.clear();
+    sorted_ = true;
+}
+
+void RenderQueue::Clear() {
+    packets_.clear();
+    sortedIndices_.clear();
+    sorted_ = true;
+}
+
+// === State Queries ===
+
+std::size_t RenderQueue::GetPacketCount() const {
+    return packets_.size();
+}
+
+const DrawPacket& RenderQueue::GetPacket(std::size_t index) const {
+    return packets_.at(index);
+}
+
+const RenderQueueStats& RenderQueue::GetStatistics() const {
+    return stats_;
+}
+
+} // namespace RenderingPlugin
@@ -4,9 +4,14 @@
  */
 
 #include "../include/RenderingSystem.h"
+#include "../include/RenderCommands.h"
+#include "../include/RenderGraph.h"
+#include "../include/SoftwareRasterizer.h"
+#include "../include/ThreadPool.h"
 #include <iostream>
 #include <stdexcept>
 #include <cstdlib>
+#include <algorithm>
 
 #ifdef __APPLE__
 // Metal headers should be included in .mm files only
@@ -29,7 +34,11 @@ RenderingSystem::RenderingSystem()
     , initialized_(false)
     , currentAPI_(RenderAPI::None)
     , currentMode_(RenderingMode::Hardware)
-    , softwareRenderingEnabled_(false) {
+    , softwareRenderingEnabled_(false)
+    , offscreenRenderTarget_(nullptr)
+    , framesInFlight_(2)
+    , frameNumber_(0)
+    , swapChainPassActive_(false) {
     
     // Initialize window description with default values
     windowDesc_.title = "LLGL Rendering Window";
@@ -179,11 +188,19 @@ bool RenderingSystem::InitializeSoftwareRenderer() {
     // Software rendering is typically handled by OpenGL with software drivers
     std::string errorMsg;
     if (TryInitializeAPI(RenderAPI::OpenGL, errorMsg)) {
+        currentAPI_ = RenderAPI::OpenGL;
+        currentMode_ = RenderingMode::Software;
+        initialized_ = true;
         softwareRenderingEnabled_ = true;
         std::cout << "Software rendering initialized successfully" << std::endl;
         return true;
     }
     
+    // Without any usable driver the frames are rasterized on the CPU
+    if (InitializeCpuRasterizer(RenderingMode::Software)) {
+        return true;
+    }
+    
     std::cerr << "Failed to initialize software renderer" << std::endl;
     return false;
 }
@@ -204,20 +221,38 @@ bool RenderingSystem::InitializeHeadlessRenderer() {
         }
     }
     
+    if (InitializeCpuRasterizer(RenderingMode::Headless)) {
+        return true;
+    }
+    
     std::cerr << "Failed to initialize headless renderer" << std::endl;
     return false;
 }
 
+bool RenderingSystem::InitializeCpuRasterizer(RenderingMode mode) {
+    auto rasterizer = std::make_unique<SoftwareRasterizer>(GetThreadPool());
+    if (!rasterizer->Resize(windowDesc_.width, windowDesc_.height)) {
+        return false;
+    }
+    
+    softwareRasterizer_ = std::move(rasterizer);
+    currentAPI_ = RenderAPI::None;
+    currentMode_ = mode;
+    initialized_ = true;
+    softwareRenderingEnabled_ = true;
+    systemInfo_.rendererName = "CPU rasterizer";
+    
+    std::cout << "Rendering on the CPU with " << threadPool_->GetThreadCount() << " worker threads" << std::endl;
+    return true;
+}
+
 void RenderingSystem::Shutdown() {
     if (!initialized_) {
         return;
     }
     
     // Clean up in reverse order of creation
-    if (commandBuffer_) {
-        renderSystem_->Release(*commandBuffer_);
-        commandBuffer_ = nullptr;
-    }
+    ReleaseFrameResources();
     
     if (swapChain_) {
         renderSystem_->Release(*swapChain_);
@@ -227,6 +262,8 @@ void RenderingSystem::Shutdown() {
     // Surface and CommandBuffer are managed by RenderSystem, no explicit release needed
     surface_ = nullptr;
     
+    softwareRasterizer_.reset();
+    
     if (renderSystem_) {
         LLGL::RenderSystem::Unload(std::move(renderSystem_));
         renderSystem_.reset();
@@ -246,6 +283,15 @@ bool RenderingSystem::CreateWindow(const WindowDesc& desc) {
         return false;
     }
     
+    if (softwareRasterizer_) {
+        // Nothing to present to without a render system; the window size is the image size
+        if (!softwareRasterizer_->Resize(desc.width, desc.height)) {
+            return false;
+        }
+        windowDesc_ = desc;
+        return true;
+    }
+    
     if (currentMode_ == RenderingMode::Headless) {
         std::cout << "Skipping window creation for headless mode" << std::endl;
         return true;
@@ -285,9 +331,8 @@ bool RenderingSystem::CreateWindow(const WindowDesc& desc) {
             return false;
         }
         
-        // Create command buffer
-        commandBuffer_ = renderSystem_->CreateCommandBuffer();
-        if (!commandBuffer_) {
+        // Create command buffers and fences for frames in flight
+        if (!CreateFrameResources()) {
             std::cerr << "Failed to create command buffer" << std::endl;
             return false;
         }
@@ -307,14 +352,57 @@ bool RenderingSystem::CreateWindow(const WindowDesc& desc) {
 }
 
 bool RenderingSystem::BeginFrame() {
-    if (!commandBuffer_ || currentMode_ == RenderingMode::Headless) {
+    if (softwareRasterizer_) {
+        const auto frameStart = std::chrono::high_resolution_clock::now();
+        frameStats_.frameNumber = frameNumber_;
+        frameStats_.frameIndex = 0;
+        frameStats_.cpuWaitMs = 0.0;
+        frameStats_.cpuFrameMs = (frameNumber_ > 0)
+            ? std::chrono::duration<double, std::milli>(frameStart - lastFrameStart_).count()
+            : 0.0;
+        lastFrameStart_ = frameStart;
+        
+        softwareRasterizer_->SetViewport(0, 0, windowDesc_.width, windowDesc_.height);
+        return true;
+    }
+    
+    if (frames_.empty() || currentMode_ == RenderingMode::Headless) {
         return false;
     }
     
+    auto frameStart = std::chrono::high_resolution_clock::now();
+    
+    FrameContext& frame = frames_[frameRing_.GetSlotIndex()];
+    
+    // Waits only if the GPU still uses the slot, then runs the releases queued in it
+    std::chrono::high_resolution_clock::time_point waitEnd = frameStart;
+    frameRing_.BeginSlot([this, &frame, &waitEnd](std::uint32_t) {
+        auto* commandQueue = renderSystem_->GetCommandQueue();
+        if (frame.fence) {
+            commandQueue->WaitFence(*frame.fence, ~0ull);
+        } else {
+            commandQueue->WaitIdle();
+        }
+        waitEnd = std::chrono::high_resolution_clock::now();
+    });
+    
+    frameStats_.frameNumber = frameNumber_;
+    frameStats_.frameIndex = frameRing_.GetSlotIndex();
+    frameStats_.cpuWaitMs = std::chrono::duration<double, std::milli>(waitEnd - frameStart).count();
+    frameStats_.cpuFrameMs = (frameNumber_ > 0)
+        ? std::chrono::duration<double, std::milli>(frameStart - lastFrameStart_).count()
+        : 0.0;
+    lastFrameStart_ = frameStart;
+    frameStats_.transientMemoryBytes = 0;
+    frameStats_.unaliasedMemoryBytes = 0;
+    frameStats_.pooledMemoryBytes = 0;
+    
+    commandBuffer_ = frame.commandBuffer;
     commandBuffer_->Begin();
     
     if (swapChain_) {
         commandBuffer_->BeginRenderPass(*swapChain_);
+        swapChainPassActive_ = true;
         
         // Set viewport to window size
         LLGL::Viewport viewport;
@@ -332,23 +420,43 @@ bool RenderingSystem::BeginFrame() {
 }
 
 bool RenderingSystem::EndFrame() {
+    if (softwareRasterizer_) {
+        softwareRasterizer_->Flush();
+        frameNumber_++;
+        return true;
+    }
+    
     if (!initialized_ || !swapChain_ || !commandBuffer_) {
         return false;
     }
     
     try {
+        FrameContext& frame = frames_[frameRing_.GetSlotIndex()];
+        
         // End command recording
+        if (swapChainPassActive_) {
+            commandBuffer_->EndRenderPass();
+            swapChainPassActive_ = false;
+        }
         commandBuffer_->End();
         
-        // Submit commands through command queue
+        // Submit commands and signal this slot's fence once the GPU is done with them
         auto* commandQueue = renderSystem_->GetCommandQueue();
         if (commandQueue) {
             commandQueue->Submit(*commandBuffer_);
+            if (frame.fence) {
+                commandQueue->Submit(*frame.fence);
+            }
+            frameRing_.MarkSubmitted();
         }
         
         // Present the frame
         swapChain_->Present();
         
+        // Advance to the next slot without waiting for the GPU
+        frameRing_.Advance();
+        frameNumber_++;
+        
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Error ending frame: " << e.what() << std::endl;
@@ -356,7 +464,69 @@ bool RenderingSystem::EndFrame() {
     }
 }
 
+void RenderingSystem::SetFramesInFlight(std::uint32_t count) {
+    const std::uint32_t clampedCount = std::min<std::uint32_t>(std::max<std::uint32_t>(count, 1), 4);
+    
+    if (!frames_.empty()) {
+        std::cerr << "Frames in flight must be set before the window is created" << std::endl;
+        return;
+    }
+    
+    framesInFlight_ = clampedCount;
+}
+
+std::uint32_t RenderingSystem::GetFramesInFlight() const {
+    return framesInFlight_;
+}
+
+std::uint32_t RenderingSystem::GetFrameIndex() const {
+    return frameRing_.GetSlotIndex();
+}
+
+std::uint64_t RenderingSystem::GetFrameNumber() const {
+    return frameNumber_;
+}
+
+void RenderingSystem::DeferRelease(std::function<void()> release) {
+    // Runs immediately without frame resources, since nothing is in flight
+    frameRing_.DeferRelease(std::move(release));
+}
+
+const FrameStats& RenderingSystem::GetFrameStats() const {
+    return frameStats_;
+}
+
+bool RenderingSystem::ExecuteRenderGraph(RenderGraph& graph, RenderCommands& commands) {
+    if (softwareRasterizer_) {
+        std::cerr << "Render graphs require a GPU renderer" << std::endl;
+        return false;
+    }
+    
+    if (!swapChainPassActive_ || !commandBuffer_) {
+        std::cerr << "Render graph executed outside of BeginFrame/EndFrame" << std::endl;
+        return false;
+    }
+    
+    // The graph begins its own render passes, including the one of an imported swap chain
+    commandBuffer_->EndRenderPass();
+    swapChainPassActive_ = false;
+    
+    commands.SetCommandBuffer(commandBuffer_);
+    const bool success = graph.Execute(commands);
+    
+    const RenderGraphStats& stats = graph.GetStatistics();
+    frameStats_.transientMemoryBytes += stats.transientMemoryBytes;
+    frameStats_.unaliasedMemoryBytes += stats.unaliasedMemoryBytes;
+    frameStats_.pooledMemoryBytes += stats.pooledMemoryBytes;
+    return success;
+}
+
 void RenderingSystem::Clear(const Color& color) {
+    if (softwareRasterizer_) {
+        softwareRasterizer_->Clear(color);
+        return;
+    }
+    
     if (!initialized_ || !commandBuffer_) {
         return;
     }
@@ -383,6 +553,11 @@ void RenderingSystem::Clear(const Color& color) {
 }
 
 void RenderingSystem::SetViewport(int x, int y, int width, int height) {
+    if (softwareRasterizer_) {
+        softwareRasterizer_->SetViewport(x, y, width, height);
+        return;
+    }
+    
     if (!commandBuffer_) {
         return;
     }
@@ -541,4 +716,64 @@ LLGL::Surface* RenderingSystem::GetSurface() const {
     return surface_;
 }
 
+// === Private Methods ===
+
+bool RenderingSystem::CreateFrameResources() {
+    ReleaseFrameResources();
+    
+    frames_.resize(framesInFlight_);
+    for (FrameContext& frame : frames_) {
+        frame.commandBuffer = renderSystem_->CreateCommandBuffer();
+        if (!frame.commandBuffer) {
+            ReleaseFrameResources();
+            return false;
+        }
+        
+        // Without fences, reusing a slot falls back to waiting for the whole queue
+        frame.fence = renderSystem_->CreateFence();
+    }
+    
+    frameRing_.Reset(framesInFlight_);
+    commandBuffer_ = frames_[0].commandBuffer;
+    
+    std::cout << "Created frame resources (" << framesInFlight_ << " frames in flight)" << std::endl;
+    return true;
+}
+
+void RenderingSystem::ReleaseFrameResources() {
+    if (frames_.empty()) {
+        return;
+    }
+    
+    if (auto* commandQueue = renderSystem_->GetCommandQueue()) {
+        commandQueue->WaitIdle();
+    }
+    
+    frameRing_.Reset(0);
+    
+    for (FrameContext& frame : frames_) {
+        if (frame.fence) {
+            renderSystem_->Release(*frame.fence);
+        }
+        if (frame.commandBuffer) {
+            renderSystem_->Release(*frame.commandBuffer);
+        }
+    }
+    
+    frames_.clear();
+    commandBuffer_ = nullptr;
+}
+
+ThreadPool* RenderingSystem::GetThreadPool() {
+    if (!threadPool_) {
+        threadPool_ = std::make_unique<ThreadPool>();
+        std::cout << "Created rendering thread pool (" << threadPool_->GetThreadCount() << " threads)" << std::endl;
+    }
+    return threadPool_.get();
+}
+
+SoftwareRasterizer* RenderingSystem::GetSoftwareRasterizer() const {
+    return softwareRasterizer_.get();
+}
+
 } // namespace RenderingPlugin
\ No newline at end of file
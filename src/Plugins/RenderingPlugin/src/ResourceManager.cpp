@@ -17,7 +17,18 @@ namespace RenderingPlugin {
 
 ResourceManager::ResourceManager(LLGL::RenderSystem* renderSystem)
     : renderSystem_(renderSystem)
-    , nextResourceId_(1) {
+    , vertexBuffers_(static_cast<std::uint8_t>(ResourceKind::VertexBuffer))
+    , indexBuffers_(static_cast<std::uint8_t>(ResourceKind::IndexBuffer))
+    , constantBuffers_(static_cast<std::uint8_t>(ResourceKind::ConstantBuffer))
+    , textures_(static_cast<std::uint8_t>(ResourceKind::Texture))
+    , samplers_(static_cast<std::uint8_t>(ResourceKind::Sampler))
+    , shaders_(static_cast<std::uint8_t>(ResourceKind::Shader))
+    , pipelineLayouts_(static_cast<std::uint8_t>(ResourceKind::PipelineLayout))
+    , pipelineStates_(static_cast<std::uint8_t>(ResourceKind::PipelineState))
+    , resourceHeaps_(static_cast<std::uint8_t>(ResourceKind::ResourceHeap))
+    , bufferArrays_(static_cast<std::uint8_t>(ResourceKind::BufferArray))
+    , constantBufferRings_(static_cast<std::uint8_t>(ResourceKind::ConstantBufferRing))
+    , renderObjects_(static_cast<std::uint8_t>(ResourceKind::RenderObject)) {
     
     if (!renderSystem_) {
         throw std::invalid_argument("RenderSystem cannot be null");
@@ -33,71 +44,80 @@ ResourceManager::~ResourceManager() {
 
 void ResourceManager::ReleaseAllResources() {
     // Release render objects first (they may reference other resources)
-    renderObjects_.clear();
+    renderObjects_.Clear();
+    
+    // Release buffer arrays before the buffers they reference
+    bufferArrays_.ForEach([this](ResourceId, auto* bufferArray) {
+        if (bufferArray) {
+            renderSystem_->Release(*bufferArray);
+        }
+    });
+    bufferArrays_.Clear();
     
     // Release LLGL resources
-    for (auto& buffer : vertexBuffers_) {
-        if (buffer.second) {
-            renderSystem_->Release(*buffer.second);
+    vertexBuffers_.ForEach([this](ResourceId, auto* buffer) {
+        if (buffer) {
+            renderSystem_->Release(*buffer);
         }
-    }
-    vertexBuffers_.clear();
+    });
+    vertexBuffers_.Clear();
     
-    for (auto& buffer : indexBuffers_) {
-        if (buffer.second) {
-            renderSystem_->Release(*buffer.second);
+    indexBuffers_.ForEach([this](ResourceId, auto* buffer) {
+        if (buffer) {
+            renderSystem_->Release(*buffer);
         }
-    }
-    indexBuffers_.clear();
+    });
+    indexBuffers_.Clear();
     
-    for (auto& buffer : constantBuffers_) {
-        if (buffer.second) {
-            renderSystem_->Release(*buffer.second);
+    constantBuffers_.ForEach([this](ResourceId, auto* buffer) {
+        if (buffer) {
+            renderSystem_->Release(*buffer);
         }
-    }
-    constantBuffers_.clear();
+    });
+    constantBuffers_.Clear();
+    constantBufferRings_.Clear();
     
-    for (auto& texture : textures_) {
-        if (texture.second) {
-            renderSystem_->Release(*texture.second);
+    textures_.ForEach([this](ResourceId, auto* texture) {
+        if (texture) {
+            renderSystem_->Release(*texture);
         }
-    }
-    textures_.clear();
+    });
+    textures_.Clear();
     
-    for (auto& sampler : samplers_) {
-        if (sampler.second) {
-            renderSystem_->Release(*sampler.second);
+    samplers_.ForEach([this](ResourceId, auto* sampler) {
+        if (sampler) {
+            renderSystem_->Release(*sampler);
         }
-    }
-    samplers_.clear();
+    });
+    samplers_.Clear();
     
-    for (auto& shader : shaders_) {
-        if (shader.second) {
-            renderSystem_->Release(*shader.second);
+    shaders_.ForEach([this](ResourceId, auto* shader) {
+        if (shader) {
+            renderSystem_->Release(*shader);
         }
-    }
-    shaders_.clear();
+    });
+    shaders_.Clear();
     
-    for (auto& layout : pipelineLayouts_) {
-        if (layout.second) {
-            renderSystem_->Release(*layout.second);
+    pipelineLayouts_.ForEach([this](ResourceId, auto* layout) {
+        if (layout) {
+            renderSystem_->Release(*layout);
         }
-    }
-    pipelineLayouts_.clear();
+    });
+    pipelineLayouts_.Clear();
     
-    for (auto& heap : resourceHeaps_) {
-        if (heap.second) {
-            renderSystem_->Release(*heap.second);
+    resourceHeaps_.ForEach([this](ResourceId, auto* heap) {
+        if (heap) {
+            renderSystem_->Release(*heap);
         }
-    }
-    resourceHeaps_.clear();
+    });
+    resourceHeaps_.Clear();
     
-    for (auto& pipeline : pipelineStates_) {
-        if (pipeline.second) {
-            renderSystem_->Release(*pipeline.second);
+    pipelineStates_.ForEach([this](ResourceId, auto* pipeline) {
+        if (pipeline) {
+            renderSystem_->Release(*pipeline);
         }
-    }
-    pipelineStates_.clear();
+    });
+    pipelineStates_.Clear();
     
     std::cout << "All resources released" << std::endl;
 }
@@ -121,8 +141,7 @@ ResourceId ResourceManager::CreateVertexBuffer(const void* data, size_t size, co
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        vertexBuffers_[id] = buffer;
+        ResourceId id = vertexBuffers_.Insert(buffer);
         
         std::cout << "Created vertex buffer (ID: " << id << ", Size: " << size << " bytes)" << std::endl;
         return id;
@@ -150,8 +169,7 @@ ResourceId ResourceManager::CreateIndexBuffer(const void* data, size_t size, con
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        indexBuffers_[id] = buffer;
+        ResourceId id = indexBuffers_.Insert(buffer);
         
         std::cout << "Created index buffer (ID: " << id << ", Size: " << size << " bytes)" << std::endl;
         return id;
@@ -178,8 +196,7 @@ ResourceId ResourceManager::CreateConstantBuffer(size_t size, const void* initia
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        constantBuffers_[id] = buffer;
+        ResourceId id = constantBuffers_.Insert(buffer);
         
         std::cout << "Created constant buffer (ID: " << id << ", Size: " << size << " bytes)" << std::endl;
         return id;
@@ -190,23 +207,110 @@ ResourceId ResourceManager::CreateConstantBuffer(size_t size, const void* initia
     }
 }
 
-bool ResourceManager::UpdateBuffer(ResourceId bufferId, const void* data, size_t size, size_t offset) {
-    LLGL::Buffer* buffer = nullptr;
+ResourceId ResourceManager::CreateConstantBufferRing(size_t size, std::uint32_t frameCount) {
+    if (frameCount == 0) {
+        std::cerr << "Constant buffer ring needs at least one slot" << std::endl;
+        return 0;
+    }
     
-    // Find the buffer in any of the buffer maps
-    auto vertexIt = vertexBuffers_.find(bufferId);
-    if (vertexIt != vertexBuffers_.end()) {
-        buffer = vertexIt->second;
-    } else {
-        auto indexIt = indexBuffers_.find(bufferId);
-        if (indexIt != indexBuffers_.end()) {
-            buffer = indexIt->second;
-        } else {
-            auto constantIt = constantBuffers_.find(bufferId);
-            if (constantIt != constantBuffers_.end()) {
-                buffer = constantIt->second;
+    std::vector<ResourceId> slots;
+    slots.reserve(frameCount);
+    
+    for (std::uint32_t i = 0; i < frameCount; ++i) {
+        ResourceId bufferId = CreateConstantBuffer(size);
+        if (bufferId == 0) {
+            for (ResourceId slotId : slots) {
+                ReleaseBuffer(slotId);
             }
+            return 0;
+        }
+        slots.push_back(bufferId);
+    }
+    
+    ResourceId id = constantBufferRings_.Insert(std::move(slots));
+    
+    std::cout << "Created constant buffer ring (ID: " << id << ", Slots: " << frameCount << ")" << std::endl;
+    return id;
+}
+
+ResourceId ResourceManager::GetConstantBufferRing(ResourceId ringId, std::uint32_t frameIndex) const {
+    const std::vector<ResourceId>* slots = constantBufferRings_.Get(ringId);
+    if (!slots) {
+        return 0;
+    }
+    return (*slots)[frameIndex % slots->size()];
+}
+
+ResourceId ResourceManager::CreateInstanceBuffer(size_t size, const LLGL::VertexFormat& format) {
+    try {
+        LLGL::BufferDescriptor bufferDesc;
+        bufferDesc.size = size;
+        bufferDesc.bindFlags = LLGL::BindFlags::VertexBuffer;
+        bufferDesc.miscFlags = LLGL::MiscFlags::DynamicUsage;
+        bufferDesc.vertexAttribs = format.attributes;
+        
+        LLGL::Buffer* buffer = renderSystem_->CreateBuffer(bufferDesc);
+        if (!buffer) {
+            std::cerr << "Failed to create instance buffer" << std::endl;
+            return 0;
         }
+        
+        ResourceId id = vertexBuffers_.Insert(buffer);
+        
+        std::cout << "Created instance buffer (ID: " << id << ", Size: " << size << " bytes)" << std::endl;
+        return id;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Exception creating instance buffer: " << e.what() << std::endl;
+        return 0;
+    }
+}
+
+ResourceId ResourceManager::CreateBufferArray(const std::vector<ResourceId>& vertexBufferIds) {
+    if (vertexBufferIds.empty()) {
+        std::cerr << "Cannot create buffer array without buffers" << std::endl;
+        return 0;
+    }
+    
+    std::vector<LLGL::Buffer*> buffers;
+    buffers.reserve(vertexBufferIds.size());
+    
+    for (ResourceId bufferId : vertexBufferIds) {
+        LLGL::Buffer* buffer = GetVertexBuffer(bufferId);
+        if (!buffer) {
+            std::cerr << "Vertex buffer with ID " << bufferId << " not found" << std::endl;
+            return 0;
+        }
+        buffers.push_back(buffer);
+    }
+    
+    try {
+        LLGL::BufferArray* bufferArray = renderSystem_->CreateBufferArray(
+            static_cast<std::uint32_t>(buffers.size()), buffers.data());
+        if (!bufferArray) {
+            std::cerr << "Failed to create buffer array" << std::endl;
+            return 0;
+        }
+        
+        ResourceId id = bufferArrays_.Insert(bufferArray);
+        
+        std::cout << "Created buffer array (ID: " << id << ", Buffers: " << buffers.size() << ")" << std::endl;
+        return id;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Exception creating buffer array: " << e.what() << std::endl;
+        return 0;
+    }
+}
+
+bool ResourceManager::UpdateBuffer(ResourceId bufferId, const void* data, size_t size, size_t offset) {
+    // Find the buffer in any of the buffer pools
+    LLGL::Buffer* buffer = GetVertexBuffer(bufferId);
+    if (!buffer) {
+        buffer = GetIndexBuffer(bufferId);
+    }
+    if (!buffer) {
+        buffer = GetConstantBuffer(bufferId);
     }
     
     if (!buffer) {
@@ -223,6 +327,19 @@ bool ResourceManager::UpdateBuffer(ResourceId bufferId, const void* data, size_t
     }
 }
 
+void ResourceManager::UpdateConstantBuffer(LLGL::Buffer* constantBuffer, const Matrices& matrices) {
+    if (!constantBuffer) {
+        std::cerr << "Cannot update null constant buffer" << std::endl;
+        return;
+    }
+    
+    try {
+        renderSystem_->WriteBuffer(*constantBuffer, 0, &matrices, sizeof(Matrices));
+    } catch (const std::exception& e) {
+        std::cerr << "Exception updating constant buffer: " << e.what() << std::endl;
+    }
+}
+
 // === Texture Management ===
 
 ResourceId ResourceManager::CreateTexture2D(int width, int height, LLGL::Format format, const void* data) {
@@ -251,8 +368,7 @@ ResourceId ResourceManager::CreateTexture2D(int width, int height, LLGL::Format
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        textures_[id] = texture;
+        ResourceId id = textures_.Insert(texture);
         
         std::cout << "Created 2D texture (ID: " << id << ", Size: " << width << "x" << height << ")" << std::endl;
         return id;
@@ -306,8 +422,7 @@ ResourceId ResourceManager::CreateTextureCube(int size, LLGL::Format format, con
             }
         }
         
-        ResourceId id = nextResourceId_++;
-        textures_[id] = texture;
+        ResourceId id = textures_.Insert(texture);
         
         std::cout << "Created cube texture (ID: " << id << ", Size: " << size << "x" << size << ")" << std::endl;
         return id;
@@ -326,8 +441,7 @@ ResourceId ResourceManager::CreateSampler(const LLGL::SamplerDescriptor& desc) {
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        samplers_[id] = sampler;
+        ResourceId id = samplers_.Insert(sampler);
         
         std::cout << "Created sampler (ID: " << id << ")" << std::endl;
         return id;
@@ -346,6 +460,7 @@ ResourceId ResourceManager::CreateShader(LLGL::ShaderType type, const std::strin
         shaderDesc.type = type;
         shaderDesc.source = source.c_str();
         shaderDesc.sourceSize = source.length();
+        shaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
         shaderDesc.entryPoint = entryPoint.c_str();
         
         LLGL::Shader* shader = renderSystem_->CreateShader(shaderDesc);
@@ -360,8 +475,7 @@ ResourceId ResourceManager::CreateShader(LLGL::ShaderType type, const std::strin
             std::cout << "Shader compilation log: " << report->GetText() << std::endl;
         }
         
-        ResourceId id = nextResourceId_++;
-        shaders_[id] = shader;
+        ResourceId id = shaders_.Insert(shader);
         
         std::cout << "Created shader (ID: " << id << ", Type: " << static_cast<int>(type) << ")" << std::endl;
         return id;
@@ -396,8 +510,7 @@ ResourceId ResourceManager::CreatePipelineLayout(const LLGL::PipelineLayoutDescr
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        pipelineLayouts_[id] = layout;
+        ResourceId id = pipelineLayouts_.Insert(layout);
         
         std::cout << "Created pipeline layout (ID: " << id << ")" << std::endl;
         return id;
@@ -416,8 +529,7 @@ ResourceId ResourceManager::CreateResourceHeap(const LLGL::ResourceHeapDescripto
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        resourceHeaps_[id] = heap;
+        ResourceId id = resourceHeaps_.Insert(heap);
         
         std::cout << "Created resource heap (ID: " << id << ")" << std::endl;
         return id;
@@ -442,8 +554,7 @@ ResourceId ResourceManager::CreateGraphicsPipelineState(const LLGL::GraphicsPipe
             std::cout << "Pipeline creation log: " << report->GetText() << std::endl;
         }
         
-        ResourceId id = nextResourceId_++;
-        pipelineStates_[id] = pipeline;
+        ResourceId id = pipelineStates_.Insert(pipeline);
         
         std::cout << "Created graphics pipeline state (ID: " << id << ")" << std::endl;
         return id;
@@ -462,8 +573,7 @@ ResourceId ResourceManager::CreateComputePipelineState(const LLGL::ComputePipeli
             return 0;
         }
         
-        ResourceId id = nextResourceId_++;
-        pipelineStates_[id] = pipeline;
+        ResourceId id = pipelineStates_.Insert(pipeline);
         
         std::cout << "Created compute pipeline state (ID: " << id << ")" << std::endl;
         return id;
@@ -479,17 +589,17 @@ ResourceId ResourceManager::CreateComputePipelineState(const LLGL::ComputePipeli
 ResourceId ResourceManager::CreateRenderObject(ResourceId vertexBufferId, ResourceId indexBufferId, 
                                               ResourceId pipelineStateId, uint32_t indexCount) {
     // Validate that all required resources exist
-    if (vertexBuffers_.find(vertexBufferId) == vertexBuffers_.end()) {
+    if (!vertexBuffers_.Contains(vertexBufferId)) {
         std::cerr << "Vertex buffer with ID " << vertexBufferId << " not found" << std::endl;
         return 0;
     }
     
-    if (indexBufferId != 0 && indexBuffers_.find(indexBufferId) == indexBuffers_.end()) {
+    if (indexBufferId != 0 && !indexBuffers_.Contains(indexBufferId)) {
         std::cerr << "Index buffer with ID " << indexBufferId << " not found" << std::endl;
         return 0;
     }
     
-    if (pipelineStates_.find(pipelineStateId) == pipelineStates_.end()) {
+    if (!pipelineStates_.Contains(pipelineStateId)) {
         std::cerr << "Pipeline state with ID " << pipelineStateId << " not found" << std::endl;
         return 0;
     }
@@ -501,39 +611,36 @@ ResourceId ResourceManager::CreateRenderObject(ResourceId vertexBufferId, Resour
     renderObj.indexCount = indexCount;
     renderObj.visible = true;
     
-    ResourceId id = nextResourceId_++;
-    renderObjects_[id] = std::make_unique<RenderObject>(renderObj);
+    ResourceId id = renderObjects_.Insert(renderObj);
     
     std::cout << "Created render object (ID: " << id << ")" << std::endl;
     return id;
 }
 
 bool ResourceManager::UpdateRenderObjectTransform(ResourceId objectId, const Matrices& transform) {
-    auto it = renderObjects_.find(objectId);
-    if (it == renderObjects_.end()) {
+    RenderObject* renderObject = renderObjects_.Get(objectId);
+    if (!renderObject) {
         std::cerr << "Render object with ID " << objectId << " not found" << std::endl;
         return false;
     }
     
-    it->second->transform = transform;
+    renderObject->transform = transform;
     return true;
 }
 
 bool ResourceManager::SetRenderObjectVisibility(ResourceId objectId, bool visible) {
-    auto it = renderObjects_.find(objectId);
-    if (it == renderObjects_.end()) {
+    RenderObject* renderObject = renderObjects_.Get(objectId);
+    if (!renderObject) {
         std::cerr << "Render object with ID " << objectId << " not found" << std::endl;
         return false;
     }
     
-    it->second->visible = visible;
+    renderObject->visible = visible;
     return true;
 }
 
 void ResourceManager::ReleaseRenderObject(ResourceId objectId) {
-    auto it = renderObjects_.find(objectId);
-    if (it != renderObjects_.end()) {
-        renderObjects_.erase(it);
+    if (renderObjects_.Erase(objectId)) {
         std::cout << "Released render object (ID: " << objectId << ")" << std::endl;
     }
 }
@@ -541,101 +648,111 @@ void ResourceManager::ReleaseRenderObject(ResourceId objectId) {
 // === Resource Access ===
 
 LLGL::Buffer* ResourceManager::GetVertexBuffer(ResourceId id) const {
-    auto it = vertexBuffers_.find(id);
-    return (it != vertexBuffers_.end()) ? it->second : nullptr;
+    const auto* entry = vertexBuffers_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::Buffer* ResourceManager::GetIndexBuffer(ResourceId id) const {
-    auto it = indexBuffers_.find(id);
-    return (it != indexBuffers_.end()) ? it->second : nullptr;
+    const auto* entry = indexBuffers_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::Buffer* ResourceManager::GetConstantBuffer(ResourceId id) const {
-    auto it = constantBuffers_.find(id);
-    return (it != constantBuffers_.end()) ? it->second : nullptr;
+    const auto* entry = constantBuffers_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::Texture* ResourceManager::GetTexture(ResourceId id) const {
-    auto it = textures_.find(id);
-    return (it != textures_.end()) ? it->second : nullptr;
+    const auto* entry = textures_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::Sampler* ResourceManager::GetSampler(ResourceId id) const {
-    auto it = samplers_.find(id);
-    return (it != samplers_.end()) ? it->second : nullptr;
+    const auto* entry = samplers_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::Shader* ResourceManager::GetShader(ResourceId id) const {
-    auto it = shaders_.find(id);
-    return (it != shaders_.end()) ? it->second : nullptr;
+    const auto* entry = shaders_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::PipelineLayout* ResourceManager::GetPipelineLayout(ResourceId id) const {
-    auto it = pipelineLayouts_.find(id);
-    return (it != pipelineLayouts_.end()) ? it->second : nullptr;
+    const auto* entry = pipelineLayouts_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::ResourceHeap* ResourceManager::GetResourceHeap(ResourceId id) const {
-    auto it = resourceHeaps_.find(id);
-    return (it != resourceHeaps_.end()) ? it->second : nullptr;
+    const auto* entry = resourceHeaps_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 LLGL::PipelineState* ResourceManager::GetPipelineState(ResourceId id) const {
-    auto it = pipelineStates_.find(id);
-    return (it != pipelineStates_.end()) ? it->second : nullptr;
+    const auto* entry = pipelineStates_.Get(id);
+    return entry ? *entry : nullptr;
+}
+
+LLGL::BufferArray* ResourceManager::GetBufferArray(ResourceId id) const {
+    const auto* entry = bufferArrays_.Get(id);
+    return entry ? *entry : nullptr;
 }
 
 const RenderObject* ResourceManager::GetRenderObject(ResourceId id) const {
-    auto it = renderObjects_.find(id);
-    return (it != renderObjects_.end()) ? it->second.get() : nullptr;
+    return renderObjects_.Get(id);
 }
 
 // === Resource Release ===
 
 void ResourceManager::ReleaseBuffer(ResourceId id) {
     // Try to find and release from vertex buffers
-    auto vertexIt = vertexBuffers_.find(id);
-    if (vertexIt != vertexBuffers_.end()) {
-        if (vertexIt->second) {
-            renderSystem_->Release(*vertexIt->second);
+    LLGL::Buffer* vertexBuffer = nullptr;
+    if (vertexBuffers_.Erase(id, &vertexBuffer)) {
+        if (vertexBuffer) {
+            renderSystem_->Release(*vertexBuffer);
         }
-        vertexBuffers_.erase(vertexIt);
         std::cout << "Released vertex buffer (ID: " << id << ")" << std::endl;
         return;
     }
     
     // Try to find and release from index buffers
-    auto indexIt = indexBuffers_.find(id);
-    if (indexIt != indexBuffers_.end()) {
-        if (indexIt->second) {
-            renderSystem_->Release(*indexIt->second);
+    LLGL::Buffer* indexBuffer = nullptr;
+    if (indexBuffers_.Erase(id, &indexBuffer)) {
+        if (indexBuffer) {
+            renderSystem_->Release(*indexBuffer);
         }
-        indexBuffers_.erase(indexIt);
         std::cout << "Released index buffer (ID: " << id << ")" << std::endl;
         return;
     }
     
     // Try to find and release from constant buffers
-    auto constantIt = constantBuffers_.find(id);
-    if (constantIt != constantBuffers_.end()) {
-        if (constantIt->second) {
-            renderSystem_->Release(*constantIt->second);
+    LLGL::Buffer* constantBuffer = nullptr;
+    if (constantBuffers_.Erase(id, &constantBuffer)) {
+        if (constantBuffer) {
+            renderSystem_->Release(*constantBuffer);
         }
-        constantBuffers_.erase(constantIt);
         std::cout << "Released constant buffer (ID: " << id << ")" << std::endl;
         return;
     }
     
+    // Try to find and release a constant buffer ring with all of its slots
+    std::vector<ResourceId> slots;
+    if (constantBufferRings_.Erase(id, &slots)) {
+        for (ResourceId slotId : slots) {
+            ReleaseBuffer(slotId);
+        }
+        std::cout << "Released constant buffer ring (ID: " << id << ")" << std::endl;
+        return;
+    }
+    
     std::cerr << "Buffer with ID " << id << " not found" << std::endl;
 }
 
 void ResourceManager::ReleaseTexture(ResourceId id) {
-    auto it = textures_.find(id);
-    if (it != textures_.end()) {
-        if (it->second) {
-            renderSystem_->Release(*it->second);
+    LLGL::Texture* resource = nullptr;
+    if (textures_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
         }
-        textures_.erase(it);
         std::cout << "Released texture (ID: " << id << ")" << std::endl;
     } else {
         std::cerr << "Texture with ID " << id << " not found" << std::endl;
@@ -643,12 +760,11 @@ void ResourceManager::ReleaseTexture(ResourceId id) {
 }
 
 void ResourceManager::ReleaseSampler(ResourceId id) {
-    auto it = samplers_.find(id);
-    if (it != samplers_.end()) {
-        if (it->second) {
-            renderSystem_->Release(*it->second);
+    LLGL::Sampler* resource = nullptr;
+    if (samplers_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
         }
-        samplers_.erase(it);
         std::cout << "Released sampler (ID: " << id << ")" << std::endl;
     } else {
         std::cerr << "Sampler with ID " << id << " not found" << std::endl;
@@ -656,12 +772,11 @@ void ResourceManager::ReleaseSampler(ResourceId id) {
 }
 
 void ResourceManager::ReleaseShader(ResourceId id) {
-    auto it = shaders_.find(id);
-    if (it != shaders_.end()) {
-        if (it->second) {
-            renderSystem_->Release(*it->second);
+    LLGL::Shader* resource = nullptr;
+    if (shaders_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
         }
-        shaders_.erase(it);
         std::cout << "Released shader (ID: " << id << ")" << std::endl;
     } else {
         std::cerr << "Shader with ID " << id << " not found" << std::endl;
@@ -669,12 +784,11 @@ void ResourceManager::ReleaseShader(ResourceId id) {
 }
 
 void ResourceManager::ReleasePipelineLayout(ResourceId id) {
-    auto it = pipelineLayouts_.find(id);
-    if (it != pipelineLayouts_.end()) {
-        if (it->second) {
-            renderSystem_->Release(*it->second);
+    LLGL::PipelineLayout* resource = nullptr;
+    if (pipelineLayouts_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
         }
-        pipelineLayouts_.erase(it);
         std::cout << "Released pipeline layout (ID: " << id << ")" << std::endl;
     } else {
         std::cerr << "Pipeline layout with ID " << id << " not found" << std::endl;
@@ -682,12 +796,11 @@ void ResourceManager::ReleasePipelineLayout(ResourceId id) {
 }
 
 void ResourceManager::ReleaseResourceHeap(ResourceId id) {
-    auto it = resourceHeaps_.find(id);
-    if (it != resourceHeaps_.end()) {
-        if (it->second) {
-            renderSystem_->Release(*it->second);
+    LLGL::ResourceHeap* resource = nullptr;
+    if (resourceHeaps_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
         }
-        resourceHeaps_.erase(it);
         std::cout << "Released resource heap (ID: " << id << ")" << std::endl;
     } else {
         std::cerr << "Resource heap with ID " << id << " not found" << std::endl;
@@ -695,37 +808,50 @@ void ResourceManager::ReleaseResourceHeap(ResourceId id) {
 }
 
 void ResourceManager::ReleasePipelineState(ResourceId id) {
-    auto it = pipelineStates_.find(id);
-    if (it != pipelineStates_.end()) {
-        if (it->second) {
-            renderSystem_->Release(*it->second);
+    LLGL::PipelineState* resource = nullptr;
+    if (pipelineStates_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
         }
-        pipelineStates_.erase(it);
         std::cout << "Released pipeline state (ID: " << id << ")" << std::endl;
     } else {
         std::cerr << "Pipeline state with ID " << id << " not found" << std::endl;
     }
 }
 
+void ResourceManager::ReleaseBufferArray(ResourceId id) {
+    LLGL::BufferArray* resource = nullptr;
+    if (bufferArrays_.Erase(id, &resource)) {
+        if (resource) {
+            renderSystem_->Release(*resource);
+        }
+        std::cout << "Released buffer array (ID: " << id << ")" << std::endl;
+    } else {
+        std::cerr << "Buffer array with ID " << id << " not found" << std::endl;
+    }
+}
+
 // === Resource Statistics ===
 
 ResourceStats ResourceManager::GetResourceStats() const {
     ResourceStats stats;
-    stats.vertexBufferCount = vertexBuffers_.size();
-    stats.indexBufferCount = indexBuffers_.size();
-    stats.constantBufferCount = constantBuffers_.size();
-    stats.textureCount = textures_.size();
-    stats.samplerCount = samplers_.size();
-    stats.shaderCount = shaders_.size();
-    stats.pipelineLayoutCount = pipelineLayouts_.size();
-    stats.resourceHeapCount = resourceHeaps_.size();
-    stats.pipelineStateCount = pipelineStates_.size();
-    stats.renderObjectCount = renderObjects_.size();
+    stats.vertexBufferCount = vertexBuffers_.Size();
+    stats.indexBufferCount = indexBuffers_.Size();
+    stats.constantBufferCount = constantBuffers_.Size();
+    stats.textureCount = textures_.Size();
+    stats.samplerCount = samplers_.Size();
+    stats.shaderCount = shaders_.Size();
+    stats.pipelineLayoutCount = pipelineLayouts_.Size();
+    stats.resourceHeapCount = resourceHeaps_.Size();
+    stats.pipelineStateCount = pipelineStates_.Size();
+    stats.bufferArrayCount = bufferArrays_.Size();
+    stats.renderObjectCount = renderObjects_.Size();
     stats.totalResourceCount = stats.vertexBufferCount + stats.indexBufferCount + 
                               stats.constantBufferCount + stats.textureCount + 
                               stats.samplerCount + stats.shaderCount + 
                               stats.pipelineLayoutCount + stats.resourceHeapCount + 
-                              stats.pipelineStateCount + stats.renderObjectCount;
+                              stats.pipelineStateCount + stats.bufferArrayCount + 
+                              stats.renderObjectCount;
     
     return stats;
 }
@@ -743,6 +869,7 @@ void ResourceManager::PrintResourceStats() const {
     std::cout << "Pipeline Layouts: " << stats.pipelineLayoutCount << std::endl;
     std::cout << "Resource Heaps: " << stats.resourceHeapCount << std::endl;
     std::cout << "Pipeline States: " << stats.pipelineStateCount << std::endl;
+    std::cout << "Buffer Arrays: " << stats.bufferArrayCount << std::endl;
     std::cout << "Render Objects: " << stats.renderObjectCount << std::endl;
     std::cout << "Total Resources: " << stats.totalResourceCount << std::endl;
     std::cout << "==========================" << std::endl;
@@ -750,11 +877,11 @@ void ResourceManager::PrintResourceStats() const {
 
 std::vector<ResourceId> ResourceManager::GetAllRenderObjects() const {
     std::vector<ResourceId> objectIds;
-    objectIds.reserve(renderObjects_.size());
+    objectIds.reserve(renderObjects_.Size());
     
-    for (const auto& pair : renderObjects_) {
-        objectIds.push_back(pair.first);
-    }
+    renderObjects_.ForEach([&objectIds](ResourceId id, const RenderObject&) {
+        objectIds.push_back(id);
+    });
     
     return objectIds;
 }
@@ -762,11 +889,11 @@ std::vector<ResourceId> ResourceManager::GetAllRenderObjects() const {
 std::vector<ResourceId> ResourceManager::GetVisibleRenderObjects() const {
     std::vector<ResourceId> visibleObjects;
     
-    for (const auto& pair : renderObjects_) {
-        if (pair.second->visible) {
-            visibleObjects.push_back(pair.first);
+    renderObjects_.ForEach([&visibleObjects](ResourceId id, const RenderObject& renderObject) {
+        if (renderObject.visible) {
+            visibleObjects.push_back(id);
         }
-    }
+    });
     
     return visibleObjects;
 }
@@ -0,0 +1,400 @@
+/**
+ * @file SceneStore.cpp
+ * @brief Implementation of SceneStore class
+ */
+
+#include "../include/SceneStore.h"
+#include "../include/RenderCommands.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace RenderingPlugin {
+
+// === SceneStore Implementation ===
+
+SceneStore::SceneStore()
+    : handles_(static_cast<std::uint8_t>(ResourceKind::SceneObject))
+    , viewportHeight_(1080.0f)
+    , dirtyBegin_(0)
+    , dirtyEnd_(0) {
+    
+    viewMatrix_.LoadIdentity();
+    projectionMatrix_.LoadIdentity();
+    SetCamera(viewMatrix_, projectionMatrix_);
+}
+
+// === Object Management ===
+
+ResourceId SceneStore::AddObject(const MeshDraw& draw, const Gs::Matrix4f& worldMatrix,
+                                 const Gs::Vector3f& boundsCenter, float boundsRadius, std::uint64_t drawKey) {
+    const std::uint32_t index = static_cast<std::uint32_t>(worldMatrices_.size());
+    
+    ResourceId objectId = handles_.Insert(index);
+    if (objectId == 0) {
+        std::cerr << "Scene object limit reached" << std::endl;
+        return 0;
+    }
+    
+    indexToHandle_.push_back(objectId);
+    worldMatrices_.push_back(worldMatrix);
+    localCenters_.push_back(boundsCenter);
+    localRadii_.push_back(boundsRadius);
+    centerX_.push_back(0.0f);
+    centerY_.push_back(0.0f);
+    centerZ_.push_back(0.0f);
+    radii_.push_back(0.0f);
+    enabled_.push_back(1);
+    visible_.push_back(0);
+    drawKeys_.push_back(drawKey);
+    draws_.push_back(draw);
+    lodChains_.push_back(nullptr);
+    
+    UpdateWorldBounds(index);
+    MarkDirty(index, index + 1);
+    return objectId;
+}
+
+bool SceneStore::RemoveObject(ResourceId objectId) {
+    std::uint32_t index = 0;
+    if (!handles_.Erase(objectId, &index)) {
+        return false;
+    }
+    
+    // Keep the arrays dense: move the last object into the hole
+    const std::uint32_t lastIndex = static_cast<std::uint32_t>(worldMatrices_.size() - 1);
+    if (index != lastIndex) {
+        indexToHandle_[index] = indexToHandle_[lastIndex];
+        worldMatrices_[index] = worldMatrices_[lastIndex];
+        localCenters_[index] = localCenters_[lastIndex];
+        localRadii_[index] = localRadii_[lastIndex];
+        centerX_[index] = centerX_[lastIndex];
+        centerY_[index] = centerY_[lastIndex];
+        centerZ_[index] = centerZ_[lastIndex];
+        radii_[index] = radii_[lastIndex];
+        enabled_[index] = enabled_[lastIndex];
+        visible_[index] = visible_[lastIndex];
+        drawKeys_[index] = drawKeys_[lastIndex];
+        draws_[index] = draws_[lastIndex];
+        lodChains_[index] = lodChains_[lastIndex];
+        
+        *handles_.Get(indexToHandle_[index]) = index;
+    }
+    
+    indexToHandle_.pop_back();
+    worldMatrices_.pop_back();
+    localCenters_.pop_back();
+    localRadii_.pop_back();
+    centerX_.pop_back();
+    centerY_.pop_back();
+    centerZ_.pop_back();
+    radii_.pop_back();
+    enabled_.pop_back();
+    visible_.pop_back();
+    drawKeys_.pop_back();
+    draws_.pop_back();
+    lodChains_.pop_back();
+    
+    // The hole now holds the last object, and the last index is gone
+    MarkDirty(index, lastIndex + 1);
+    
+    // Storage indices changed, the previous draw list is stale
+    drawList_.clear();
+    return true;
+}
+
+bool SceneStore::SetTransform(ResourceId objectId, const Gs::Matrix4f& worldMatrix) {
+    const std::uint32_t* index = handles_.Get(objectId);
+    if (!index) {
+        return false;
+    }
+    
+    worldMatrices_[*index] = worldMatrix;
+    UpdateWorldBounds(*index);
+    MarkDirty(*index, *index + 1);
+    return true;
+}
+
+bool SceneStore::SetEnabled(ResourceId objectId, bool enabled) {
+    const std::uint32_t* index = handles_.Get(objectId);
+    if (!index) {
+        return false;
+    }
+    
+    enabled_[*index] = enabled ? 1 : 0;
+    MarkDirty(*index, *index + 1);
+    return true;
+}
+
+bool SceneStore::SetDrawKey(ResourceId objectId, std::uint64_t drawKey) {
+    const std::uint32_t* index = handles_.Get(objectId);
+    if (!index) {
+        return false;
+    }
+    
+    drawKeys_[*index] = drawKey;
+    return true;
+}
+
+bool SceneStore::SetLodChain(ResourceId objectId, const LodChain* chain) {
+    const std::uint32_t* index = handles_.Get(objectId);
+    if (!index) {
+        return false;
+    }
+    
+    lodChains_[*index] = chain;
+    if (chain) {
+        MeshDraw& draw = draws_[*index];
+        draw = chain->GetDraw(0, draw.pipelineStateId, draw.resourceHeapId);
+        localCenters_[*index] = chain->boundsCenter;
+        localRadii_[*index] = chain->boundsRadius;
+        UpdateWorldBounds(*index);
+        MarkDirty(*index, *index + 1);
+    }
+    return true;
+}
+
+void SceneStore::Clear() {
+    MarkDirty(0, static_cast<std::uint32_t>(worldMatrices_.size()));
+    handles_.Clear();
+    indexToHandle_.clear();
+    worldMatrices_.clear();
+    localCenters_.clear();
+    localRadii_.clear();
+    centerX_.clear();
+    centerY_.clear();
+    centerZ_.clear();
+    radii_.clear();
+    enabled_.clear();
+    visible_.clear();
+    drawKeys_.clear();
+    draws_.clear();
+    lodChains_.clear();
+    drawList_.clear();
+}
+
+// === Camera ===
+
+void SceneStore::SetCamera(const Gs::Matrix4f& viewMatrix, const Gs::Matrix4f& projectionMatrix) {
+    viewMatrix_ = viewMatrix;
+    projectionMatrix_ = projectionMatrix;
+    lodSelector_.SetCamera(viewMatrix_, projectionMatrix_, viewportHeight_);
+    
+    // Gribb-Hartmann plane extraction from the clip matrix (clip = projection * view * position)
+    const Gs::Matrix4f clip = projectionMatrix_ * viewMatrix_;
+    for (int plane = 0; plane < 6; ++plane) {
+        const int row = plane / 2;
+        const float sign = (plane % 2 == 0) ? 1.0f : -1.0f;
+        
+        float a = clip.At(3, 0) + sign * clip.At(row, 0);
+        float b = clip.At(3, 1) + sign * clip.At(row, 1);
+        float c = clip.At(3, 2) + sign * clip.At(row, 2);
+        float d = clip.At(3, 3) + sign * clip.At(row, 3);
+        
+        // Normalize so the plane equation yields distances comparable to sphere radii
+        const float length = std::sqrt(a * a + b * b + c * c);
+        if (length > 0.0f) {
+            a /= length;
+            b /= length;
+            c /= length;
+            d /= length;
+        }
+        
+        frustumPlanes_[plane][0] = a;
+        frustumPlanes_[plane][1] = b;
+        frustumPlanes_[plane][2] = c;
+        frustumPlanes_[plane][3] = d;
+    }
+}
+
+void SceneStore::SetLodParameters(float viewportHeight, float pixelError) {
+    viewportHeight_ = viewportHeight;
+    lodSelector_.SetCamera(viewMatrix_, projectionMatrix_, viewportHeight_);
+    lodSelector_.SetPixelError(pixelError);
+}
+
+// === Visibility ===
+
+const std::vector<std::uint32_t>& SceneStore::Cull(bool sortByDrawKey) {
+    const std::size_t objectCount = worldMatrices_.size();
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    // Branch-free sphere/frustum test over plain float arrays, so the compiler can vectorize it
+    const float* centerX = centerX_.data();
+    const float* centerY = centerY_.data();
+    const float* centerZ = centerZ_.data();
+    const float* radii = radii_.data();
+    const std::uint8_t* enabled = enabled_.data();
+    std::uint8_t* visible = visible_.data();
+    
+    float planes[6][4];
+    std::copy(&frustumPlanes_[0][0], &frustumPlanes_[0][0] + 24, &planes[0][0]);
+    
+    for (std::size_t i = 0; i < objectCount; ++i) {
+        const float x = centerX[i];
+        const float y = centerY[i];
+        const float z = centerZ[i];
+        const float r = radii[i];
+        
+        float minDistance = planes[0][0] * x + planes[0][1] * y + planes[0][2] * z + planes[0][3] + r;
+        for (int plane = 1; plane < 6; ++plane) {
+            const float distance = planes[plane][0] * x + planes[plane][1] * y + planes[plane][2] * z + planes[plane][3] + r;
+            minDistance = std::min(minDistance, distance);
+        }
+        
+        visible[i] = static_cast<std::uint8_t>((minDistance >= 0.0f) & (enabled[i] != 0));
+    }
+    
+    auto cullEndTime = std::chrono::high_resolution_clock::now();
+    
+    // Compact the visibility flags into the draw list
+    drawList_.clear();
+    drawList_.reserve(objectCount);
+    for (std::size_t i = 0; i < objectCount; ++i) {
+        if (visible[i]) {
+            drawList_.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    
+    if (sortByDrawKey) {
+        std::stable_sort(drawList_.begin(), drawList_.end(), [this](std::uint32_t a, std::uint32_t b) {
+            return drawKeys_[a] < drawKeys_[b];
+        });
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    
+    stats_.objectCount = objectCount;
+    stats_.visibleCount = drawList_.size();
+    stats_.cullTimeMs = std::chrono::duration<double, std::milli>(cullEndTime - startTime).count();
+    stats_.buildTimeMs = std::chrono::duration<double, std::milli>(endTime - cullEndTime).count();
+    
+    return drawList_;
+}
+
+void SceneStore::Submit(RenderCommands& commands, LLGL::PipelineState* defaultPipeline) {
+    if (drawList_.empty()) {
+        return;
+    }
+    
+    std::uint64_t triangles = 0;
+    
+    commands.BeginBatch(defaultPipeline);
+    for (std::uint32_t index : drawList_) {
+        MeshDraw& draw = draws_[index];
+        
+        // World bounds are already up to date; the scale is the one UpdateWorldBounds applied
+        if (const LodChain* chain = lodChains_[index]) {
+            const float scale = (localRadii_[index] > 0.0f) ? radii_[index] / localRadii_[index] : 1.0f;
+            const Gs::Vector3f center(centerX_[index], centerY_[index], centerZ_[index]);
+            const LodLevel& level = chain->levels[lodSelector_.SelectLevel(chain->levels, center, radii_[index], scale)];
+            draw.firstIndex = level.firstIndex;
+            draw.indexCount = level.indexCount;
+        }
+        
+        triangles += draw.indexCount / 3;
+        commands.AddToBatch(draw, worldMatrices_[index]);
+    }
+    commands.EndBatch(viewMatrix_, projectionMatrix_);
+    
+    stats_.trianglesSubmitted = triangles;
+}
+
+bool SceneStore::IsVisible(ResourceId objectId) const {
+    const std::uint32_t* index = handles_.Get(objectId);
+    return index && visible_[*index] != 0;
+}
+
+// === Access ===
+
+std::size_t SceneStore::GetObjectCount() const {
+    return worldMatrices_.size();
+}
+
+const Gs::Matrix4f& SceneStore::GetWorldMatrix(std::uint32_t index) const {
+    return worldMatrices_[index];
+}
+
+const MeshDraw& SceneStore::GetDraw(std::uint32_t index) const {
+    return draws_[index];
+}
+
+const std::vector<std::uint32_t>& SceneStore::GetDrawList() const {
+    return drawList_;
+}
+
+void SceneStore::GetWorldBounds(std::uint32_t index, Gs::Vector3f& center, float& radius) const {
+    center = Gs::Vector3f(centerX_[index], centerY_[index], centerZ_[index]);
+    radius = radii_[index];
+}
+
+bool SceneStore::IsEnabledAt(std::uint32_t index) const {
+    return enabled_[index] != 0;
+}
+
+const Gs::Matrix4f& SceneStore::GetViewMatrix() const {
+    return viewMatrix_;
+}
+
+const Gs::Matrix4f& SceneStore::GetProjectionMatrix() const {
+    return projectionMatrix_;
+}
+
+const float* SceneStore::GetFrustumPlanes() const {
+    return &frustumPlanes_[0][0];
+}
+
+bool SceneStore::TakeDirtyRange(std::uint32_t& begin, std::uint32_t& end) {
+    if (dirtyBegin_ >= dirtyEnd_) {
+        return false;
+    }
+    
+    begin = dirtyBegin_;
+    end = dirtyEnd_;
+    dirtyBegin_ = 0;
+    dirtyEnd_ = 0;
+    return true;
+}
+
+const SceneCullStats& SceneStore::GetStatistics() const {
+    return stats_;
+}
+
+// === Private Methods ===
+
+void SceneStore::UpdateWorldBounds(std::uint32_t index) {
+    const Gs::Matrix4f& world = worldMatrices_[index];
+    const Gs::Vector3f& center = localCenters_[index];
+    
+    centerX_[index] = world.At(0, 0) * center.x + world.At(0, 1) * center.y + world.At(0, 2) * center.z + world.At(0, 3);
+    centerY_[index] = world.At(1, 0) * center.x + world.At(1, 1) * center.y + world.At(1, 2) * center.z + world.At(1, 3);
+    centerZ_[index] = world.At(2, 0) * center.x + world.At(2, 1) * center.y + world.At(2, 2) * center.z + world.At(2, 3);
+    
+    // Conservative radius under non-uniform scale: scale by the longest basis vector
+    float maxScaleSq = 0.0f;
+    for (int column = 0; column < 3; ++column) {
+        const float scaleSq = world.At(0, column) * world.At(0, column) +
+                              world.At(1, column) * world.At(1, column) +
+                              world.At(2, column) * world.At(2, column);
+        maxScaleSq = std::max(maxScaleSq, scaleSq);
+    }
+    radii_[index] = localRadii_[index] * std::sqrt(maxScaleSq);
+}
+
+void SceneStore::MarkDirty(std::uint32_t begin, std::uint32_t end) {
+    if (begin >= end) {
+        return;
+    }
+    
+    if (dirtyBegin_ >= dirtyEnd_) {
+        dirtyBegin_ = begin;
+        dirtyEnd_ = end;
+    } else {
+        dirtyBegin_ = std::min(dirtyBegin_, begin);
+        dirtyEnd_ = std::max(dirtyEnd_, end);
+    }
+}
+
+} // namespace RenderingPlugin
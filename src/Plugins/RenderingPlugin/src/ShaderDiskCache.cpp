@@ -0,0 +1,195 @@
+/**
+ * @file ShaderDiskCache.cpp
+ * @brief Implementation of ShaderDiskCache class
+ */
+
+#include "../include/ShaderDiskCache.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <system_error>
+#include <thread>
+
+namespace RenderingPlugin {
+
+namespace {
+
+const char* const kEntryExtension = ".pssc";
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+ShaderDiskCache::ShaderDiskCache()
+    : backendHash_(0) {
+}
+
+// === Setup ===
+
+bool ShaderDiskCache::Open(const std::string& directory, const std::string& backendId) {
+    Close();
+    if (directory.empty()) {
+        return false;
+    }
+    
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error || !std::filesystem::is_directory(directory, error)) {
+        std::cerr << "Failed to create shader cache directory: " << directory << std::endl;
+        return false;
+    }
+    
+    directory_ = directory;
+    backendHash_ = ShaderHasher().Update(backendId).Finalize().low;
+    ResetStatistics();
+    return true;
+}
+
+void ShaderDiskCache::Close() {
+    directory_.clear();
+    backendHash_ = 0;
+}
+
+bool ShaderDiskCache::IsOpen() const {
+    return !directory_.empty();
+}
+
+const std::string& ShaderDiskCache::GetDirectory() const {
+    return directory_;
+}
+
+// === Entries ===
+
+bool ShaderDiskCache::Load(const ShaderHash& key, std::vector<std::uint8_t>& blob) {
+    blob.clear();
+    if (!IsOpen()) {
+        return false;
+    }
+    
+    const auto start = std::chrono::steady_clock::now();
+    const std::string path = GetEntryPath(key);
+    
+    bool found = false;
+    bool valid = false;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (file.is_open()) {
+            found = true;
+            
+            ShaderCacheEntryHeader header;
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            
+            // The size check guards the allocation against corrupt headers
+            std::error_code error;
+            const std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+            if (file && !error && header.magic == kShaderCacheMagic && header.version == kShaderCacheVersion &&
+                header.backendHash == backendHash_ && header.payloadSize == fileSize - sizeof(header)) {
+                blob.resize(static_cast<std::size_t>(header.payloadSize));
+                file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+                valid = file && ShaderHasher::Hash(blob.data(), blob.size()).low == header.payloadHash;
+            }
+        }
+    }
+    
+    if (found && !valid) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        blob.clear();
+    }
+    
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    if (valid) {
+        ++stats_.hits;
+    } else {
+        ++stats_.misses;
+        if (found) {
+            ++stats_.rejected;
+        }
+    }
+    stats_.readTimeMs += ElapsedMs(start);
+    return valid;
+}
+
+bool ShaderDiskCache::Store(const ShaderHash& key, const void* data, std::size_t size) {
+    if (!IsOpen() || (!data && size > 0)) {
+        return false;
+    }
+    
+    const auto start = std::chrono::steady_clock::now();
+    const std::string path = GetEntryPath(key);
+    
+    // Unique per writer thread; the rename below replaces the entry atomically
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp",
+                  static_cast<unsigned long long>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+    const std::string tempPath = path + suffix;
+    
+    ShaderCacheEntryHeader header;
+    header.backendHash = backendHash_;
+    header.payloadSize = size;
+    header.payloadHash = ShaderHasher::Hash(data, size).low;
+    
+    bool written = false;
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (file.is_open()) {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            file.close();
+            written = !file.fail();
+        }
+    }
+    
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(tempPath, path, error);
+    }
+    if (!written || error) {
+        std::filesystem::remove(tempPath, error);
+        std::cerr << "Failed to write shader cache entry: " << path << std::endl;
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    ++stats_.writes;
+    stats_.writeTimeMs += ElapsedMs(start);
+    return true;
+}
+
+std::size_t ShaderDiskCache::Clear() {
+    if (!IsOpen()) {
+        return 0;
+    }
+    
+    std::size_t removed = 0;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory_, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() == kEntryExtension && std::filesystem::remove(it->path(), error)) {
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+// === Statistics ===
+
+ShaderDiskCacheStats ShaderDiskCache::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+void ShaderDiskCache::ResetStatistics() {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_ = ShaderDiskCacheStats();
+}
+
+std::string ShaderDiskCache::GetEntryPath(const ShaderHash& key) const {
+    return (std::filesystem::path(directory_) / (key.ToString() + kEntryExtension)).string();
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,246 @@
+/**
+ * @file ShaderFileWatcher.cpp
+ * @brief Implementation of ShaderFileWatcher class
+ */
+
+#include "../include/ShaderFileWatcher.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace RenderingPlugin {
+
+namespace {
+
+#if defined(__linux__)
+const std::uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY | IN_CREATE;
+#endif
+
+std::string GetDirectory(const std::string& normalizedPath) {
+    return std::filesystem::path(normalizedPath).parent_path().string();
+}
+
+} // namespace
+
+ShaderFileWatcher::ShaderFileWatcher()
+    : inotifyFd_(-1)
+    , wakeFd_(-1)
+    , running_(false)
+    , debounce_(100)
+    , hasChanges_(false) {
+}
+
+ShaderFileWatcher::~ShaderFileWatcher() {
+    Stop();
+}
+
+// === Setup ===
+
+bool ShaderFileWatcher::IsSupported() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ShaderFileWatcher::Start(std::chrono::milliseconds debounce) {
+    Stop();
+    debounce_ = debounce;
+
+#if defined(__linux__)
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd_ < 0 || wakeFd_ < 0) {
+        std::cerr << "Failed to initialize shader file watcher" << std::endl;
+        Stop();
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const std::string& file : files_) {
+            WatchDirectory(GetDirectory(file));
+        }
+    }
+    
+    running_ = true;
+    thread_ = std::thread(&ShaderFileWatcher::WatchLoop, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ShaderFileWatcher::Stop() {
+#if defined(__linux__)
+    if (thread_.joinable()) {
+        running_ = false;
+        const std::uint64_t wake = 1;
+        if (write(wakeFd_, &wake, sizeof(wake)) < 0) {
+            std::cerr << "Failed to wake shader file watcher" << std::endl;
+        }
+        thread_.join();
+    }
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+    }
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+    }
+#endif
+    inotifyFd_ = -1;
+    wakeFd_ = -1;
+    running_ = false;
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    watchDirectories_.clear();
+    directoryWatches_.clear();
+}
+
+bool ShaderFileWatcher::IsRunning() const {
+    return running_;
+}
+
+// === Files ===
+
+bool ShaderFileWatcher::AddFile(const std::string& filePath) {
+    const std::string path = NormalizePath(filePath);
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.insert(path);
+    return inotifyFd_ < 0 || WatchDirectory(GetDirectory(path));
+}
+
+std::size_t ShaderFileWatcher::GetFileCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
+
+std::string ShaderFileWatcher::NormalizePath(const std::string& filePath) {
+    std::error_code error;
+    const std::filesystem::path absolute = std::filesystem::absolute(filePath, error);
+    return (error ? std::filesystem::path(filePath) : absolute).lexically_normal().string();
+}
+
+// === Changes ===
+
+bool ShaderFileWatcher::HasChanges() const {
+    return hasChanges_.load(std::memory_order_acquire);
+}
+
+std::vector<std::string> ShaderFileWatcher::TakeChanges() {
+    std::vector<std::string> changes;
+    if (!HasChanges()) {
+        return changes;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes.swap(changes_);
+    hasChanges_.store(false, std::memory_order_release);
+    return changes;
+}
+
+bool ShaderFileWatcher::WatchDirectory(const std::string& directory) {
+#if defined(__linux__)
+    if (directoryWatches_.count(directory) != 0) {
+        return true;
+    }
+    
+    const int watch = inotify_add_watch(inotifyFd_, directory.c_str(), kWatchMask);
+    if (watch < 0) {
+        std::cerr << "Failed to watch shader directory: " << directory << std::endl;
+        return false;
+    }
+    directoryWatches_[directory] = watch;
+    watchDirectories_[watch] = directory;
+    return true;
+#else
+    (void)directory;
+    return false;
+#endif
+}
+
+void ShaderFileWatcher::WatchLoop() {
+#if defined(__linux__)
+    using Clock = std::chrono::steady_clock;
+    
+    std::unordered_set<std::string> pending;
+    Clock::time_point lastEvent;
+    alignas(inotify_event) char buffer[16384];
+    
+    while (running_) {
+        // Block indefinitely while idle; wake up only to end a debounce interval
+        int timeout = -1;
+        if (!pending.empty()) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(lastEvent + debounce_ - Clock::now());
+            timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(remaining.count(), 0));
+        }
+        
+        pollfd fds[2] = { { inotifyFd_, POLLIN, 0 }, { wakeFd_, POLLIN, 0 } };
+        if (poll(fds, 2, timeout) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Shader file watcher stopped: poll failed" << std::endl;
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            ssize_t size;
+            while ((size = read(inotifyFd_, buffer, sizeof(buffer))) > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (char* cursor = buffer; cursor < buffer + size;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+                    cursor += sizeof(inotify_event) + event->len;
+                    
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        // Events were dropped; report every file rather than miss one
+                        pending.insert(files_.begin(), files_.end());
+                    } else if (event->mask & IN_IGNORED) {
+                        auto directory = watchDirectories_.find(event->wd);
+                        if (directory != watchDirectories_.end()) {
+                            directoryWatches_.erase(directory->second);
+                            watchDirectories_.erase(directory);
+                        }
+                    } else if (event->len > 0) {
+                        auto directory = watchDirectories_.find(event->wd);
+                        if (directory != watchDirectories_.end()) {
+                            std::string path = (std::filesystem::path(directory->second) / event->name).string();
+                            if (files_.count(path) != 0) {
+                                pending.insert(std::move(path));
+                            }
+                        }
+                    }
+                }
+            }
+            lastEvent = Clock::now();
+        }
+        
+        if (!pending.empty() && Clock::now() - lastEvent >= debounce_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const std::string& path : pending) {
+                if (std::find(changes_.begin(), changes_.end(), path) == changes_.end()) {
+                    changes_.push_back(path);
+                }
+            }
+            pending.clear();
+            hasChanges_.store(true, std::memory_order_release);
+        }
+    }
+    running_ = false;
+#endif
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,194 @@
+/**
+ * @file ShaderHash.cpp
+ * @brief Implementation of the 128-bit shader content hash
+ */
+
+#include "../include/ShaderHash.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace RenderingPlugin {
+
+namespace {
+
+const std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+const std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+const std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+const std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+const std::uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+inline std::uint64_t RotateLeft(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t Read64(const std::uint8_t* data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t Read32(const std::uint8_t* data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t Round(std::uint64_t lane, std::uint64_t input) {
+    lane += input * kPrime2;
+    lane = RotateLeft(lane, 31);
+    return lane * kPrime1;
+}
+
+inline std::uint64_t MergeRound(std::uint64_t hash, std::uint64_t lane) {
+    hash ^= Round(0, lane);
+    return hash * kPrime1 + kPrime4;
+}
+
+inline std::uint64_t Avalanche(std::uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**
+ * @brief Mix the unconsumed tail (< 32 bytes) into a folded lane value, as xxHash64 does
+ */
+std::uint64_t MixTail(std::uint64_t hash, const std::uint8_t* tail, std::size_t size) {
+    while (size >= 8) {
+        hash ^= Round(0, Read64(tail));
+        hash = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+        tail += 8;
+        size -= 8;
+    }
+    if (size >= 4) {
+        hash ^= static_cast<std::uint64_t>(Read32(tail)) * kPrime1;
+        hash = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+        tail += 4;
+        size -= 4;
+    }
+    while (size > 0) {
+        hash ^= (*tail) * kPrime5;
+        hash = RotateLeft(hash, 11) * kPrime1;
+        ++tail;
+        --size;
+    }
+    return hash;
+}
+
+} // namespace
+
+// === ShaderHash Implementation ===
+
+std::string ShaderHash::ToString() const {
+    char text[33];
+    std::snprintf(text, sizeof(text), "%016llx%016llx",
+                  static_cast<unsigned long long>(high), static_cast<unsigned long long>(low));
+    return text;
+}
+
+// === ShaderHasher Implementation ===
+
+ShaderHasher::ShaderHasher(std::uint64_t seed)
+    : bufferSize_(0)
+    , totalSize_(0)
+    , seed_(seed) {
+    lanes_[0] = seed + kPrime1 + kPrime2;
+    lanes_[1] = seed + kPrime2;
+    lanes_[2] = seed;
+    lanes_[3] = seed - kPrime1;
+}
+
+ShaderHasher& ShaderHasher::Update(const void* data, std::size_t size) {
+    if (size == 0) {
+        return *this;
+    }
+    
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    totalSize_ += size;
+    
+    // Top up a partial stripe first
+    if (bufferSize_ > 0) {
+        const std::size_t fill = std::min(size, sizeof(buffer_) - bufferSize_);
+        std::memcpy(buffer_ + bufferSize_, bytes, fill);
+        bufferSize_ += fill;
+        bytes += fill;
+        size -= fill;
+        if (bufferSize_ < sizeof(buffer_)) {
+            return *this;
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            lanes_[lane] = Round(lanes_[lane], Read64(buffer_ + lane * 8));
+        }
+        bufferSize_ = 0;
+    }
+    
+    // Whole stripes straight from the input; the four lanes are independent dependency chains
+    std::uint64_t lane0 = lanes_[0];
+    std::uint64_t lane1 = lanes_[1];
+    std::uint64_t lane2 = lanes_[2];
+    std::uint64_t lane3 = lanes_[3];
+    while (size >= 32) {
+        lane0 = Round(lane0, Read64(bytes));
+        lane1 = Round(lane1, Read64(bytes + 8));
+        lane2 = Round(lane2, Read64(bytes + 16));
+        lane3 = Round(lane3, Read64(bytes + 24));
+        bytes += 32;
+        size -= 32;
+    }
+    lanes_[0] = lane0;
+    lanes_[1] = lane1;
+    lanes_[2] = lane2;
+    lanes_[3] = lane3;
+    
+    if (size > 0) {
+        std::memcpy(buffer_, bytes, size);
+        bufferSize_ = size;
+    }
+    return *this;
+}
+
+ShaderHasher& ShaderHasher::Update(const std::string& text) {
+    const std::uint64_t length = text.size();
+    Update(&length, sizeof(length));
+    return Update(text.data(), text.size());
+}
+
+ShaderHasher& ShaderHasher::Update(const ShaderHash& hash) {
+    Update(&hash.low, sizeof(hash.low));
+    return Update(&hash.high, sizeof(hash.high));
+}
+
+ShaderHash ShaderHasher::Finalize() const {
+    // Fold the four lanes two different ways to get two independent 64-bit halves
+    std::uint64_t low;
+    std::uint64_t high;
+    if (totalSize_ >= 32) {
+        low = RotateLeft(lanes_[0], 1) + RotateLeft(lanes_[1], 7) + RotateLeft(lanes_[2], 12) + RotateLeft(lanes_[3], 18);
+        high = RotateLeft(lanes_[0], 18) + RotateLeft(lanes_[1], 12) + RotateLeft(lanes_[2], 7) + RotateLeft(lanes_[3], 1);
+        for (int lane = 0; lane < 4; ++lane) {
+            low = MergeRound(low, lanes_[lane]);
+            high = MergeRound(high, lanes_[3 - lane] ^ kPrime3);
+        }
+    } else {
+        low = seed_ + kPrime5;
+        high = (seed_ ^ kPrime4) + kPrime5;
+    }
+    
+    low = MixTail(low + totalSize_, buffer_, bufferSize_);
+    high = MixTail((high + totalSize_) ^ kPrime2, buffer_, bufferSize_);
+    
+    ShaderHash hash;
+    hash.low = Avalanche(low);
+    hash.high = Avalanche(high ^ (hash.low >> 1));
+    return hash;
+}
+
+ShaderHash ShaderHasher::Hash(const void* data, std::size_t size, std::uint64_t seed) {
+    return ShaderHasher(seed).Update(data, size).Finalize();
+}
+
+} // namespace RenderingPlugin
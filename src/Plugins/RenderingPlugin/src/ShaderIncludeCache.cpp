@@ -0,0 +1,217 @@
+/**
+ * @file ShaderIncludeCache.cpp
+ * @brief Implementation of ShaderIncludeCache class
+ */
+
+#include "../include/ShaderIncludeCache.h"
+#include "../include/ShaderFileWatcher.h"
+#include <algorithm>
+#include <iostream>
+#include <regex>
+#include <system_error>
+
+namespace RenderingPlugin {
+
+namespace {
+
+const std::regex& IncludePattern() {
+    // Compiling the pattern costs more than most scans; matching against a const regex is thread-safe
+    static const std::regex pattern(R"(#include\s*["<]([^\s">]+)[">])");
+    return pattern;
+}
+
+std::string ResolveIncludePath(const std::string& includePath, const std::string& currentPath) {
+    return (std::filesystem::path(currentPath).parent_path() / includePath).string();
+}
+
+} // namespace
+
+// === Expansion ===
+
+std::string ShaderIncludeCache::Expand(const std::string& source, const std::string& currentPath, const Loader& loader,
+                                       std::vector<std::string>* includedFiles) {
+    std::vector<std::shared_ptr<const Entry>> children;
+    std::vector<std::string> stack;
+    std::string result = ExpandSource(source, currentPath, loader, children, stack);
+    
+    if (includedFiles) {
+        for (const std::shared_ptr<const Entry>& child : children) {
+            for (const auto& file : child->files) {
+                includedFiles->push_back(file.first);
+            }
+        }
+    }
+    return result;
+}
+
+std::string ShaderIncludeCache::ExpandSource(const std::string& source, const std::string& currentPath,
+                                             const Loader& loader, std::vector<std::shared_ptr<const Entry>>& children,
+                                             std::vector<std::string>& stack) {
+    std::sregex_iterator iter(source.begin(), source.end(), IncludePattern());
+    std::sregex_iterator end;
+    if (iter == end) {
+        return source;
+    }
+    
+    std::string result;
+    result.reserve(source.size());
+    std::size_t copied = 0;
+    for (; iter != end; ++iter) {
+        std::shared_ptr<const Entry> entry = GetEntry((*iter)[1].str(), currentPath, loader, stack);
+        result.append(source, copied, static_cast<std::size_t>(iter->position()) - copied);
+        result += entry->expanded;
+        copied = static_cast<std::size_t>(iter->position() + iter->length());
+        children.push_back(std::move(entry));
+    }
+    result.append(source, copied, std::string::npos);
+    return result;
+}
+
+std::shared_ptr<const ShaderIncludeCache::Entry> ShaderIncludeCache::GetEntry(const std::string& includePath,
+                                                                              const std::string& currentPath,
+                                                                              const Loader& loader,
+                                                                              std::vector<std::string>& stack) {
+    const std::string resolvedPath = ResolveIncludePath(includePath, currentPath);
+    const std::string key = ShaderFileWatcher::NormalizePath(resolvedPath);
+    
+    if (std::find(stack.begin(), stack.end(), key) != stack.end()) {
+        std::cerr << "Circular shader include: " << key << std::endl;
+        auto entry = std::make_shared<Entry>();
+        entry->files.emplace_back(key, std::filesystem::file_time_type());
+        entry->cacheable = false;
+        return entry;
+    }
+    
+    std::shared_ptr<const Entry> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            cached = it->second;
+        }
+    }
+    // Checked outside the lock: the stats are the expensive part
+    if (cached && IsCurrent(*cached)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.hits;
+        return cached;
+    }
+    
+    auto entry = std::make_shared<Entry>();
+    std::error_code error;
+    const auto writeTime = std::filesystem::last_write_time(resolvedPath, error);
+    entry->cacheable = !error;
+    entry->files.emplace_back(key, writeTime);
+    
+    std::vector<std::shared_ptr<const Entry>> children;
+    stack.push_back(key);
+    entry->expanded = ExpandSource(loader(includePath, currentPath), resolvedPath, loader, children, stack);
+    stack.pop_back();
+    
+    // A diamond include appears once in the list of files to check
+    std::unordered_set<std::string> seen = { key };
+    for (const std::shared_ptr<const Entry>& child : children) {
+        entry->includes.push_back(child->files.front().first);
+        entry->cacheable = entry->cacheable && child->cacheable;
+        for (const auto& file : child->files) {
+            if (seen.insert(file.first).second) {
+                entry->files.push_back(file);
+            }
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.loads;
+    if (entry->cacheable) {
+        auto previous = entries_.find(key);
+        if (previous != entries_.end()) {
+            for (const std::string& include : previous->second->includes) {
+                dependents_[include].erase(key);
+            }
+        }
+        for (const std::string& include : entry->includes) {
+            dependents_[include].insert(key);
+        }
+        entries_[key] = entry;
+    }
+    return entry;
+}
+
+bool ShaderIncludeCache::IsCurrent(const Entry& entry) {
+    for (const auto& file : entry.files) {
+        std::error_code error;
+        if (std::filesystem::last_write_time(file.first, error) != file.second || error) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// === Dependency Graph ===
+
+std::vector<std::string> ShaderIncludeCache::GetIncludes(const std::string& filePath) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(ShaderFileWatcher::NormalizePath(filePath));
+    return it != entries_.end() ? it->second->includes : std::vector<std::string>();
+}
+
+std::vector<std::string> ShaderIncludeCache::GetDependents(const std::string& filePath) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_set<std::string> visited;
+    std::vector<std::string> open = { ShaderFileWatcher::NormalizePath(filePath) };
+    while (!open.empty()) {
+        const std::string current = std::move(open.back());
+        open.pop_back();
+        auto it = dependents_.find(current);
+        if (it == dependents_.end()) {
+            continue;
+        }
+        for (const std::string& dependent : it->second) {
+            if (visited.insert(dependent).second) {
+                open.push_back(dependent);
+            }
+        }
+    }
+    
+    std::vector<std::string> dependents(visited.begin(), visited.end());
+    std::sort(dependents.begin(), dependents.end());
+    return dependents;
+}
+
+std::size_t ShaderIncludeCache::Invalidate(const std::string& filePath) {
+    std::vector<std::string> files = GetDependents(filePath);
+    files.push_back(ShaderFileWatcher::NormalizePath(filePath));
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t removed = 0;
+    for (const std::string& file : files) {
+        removed += entries_.erase(file);
+    }
+    stats_.invalidations += removed;
+    return removed;
+}
+
+void ShaderIncludeCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    dependents_.clear();
+}
+
+std::size_t ShaderIncludeCache::GetEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+// === Statistics ===
+
+ShaderIncludeCacheStats ShaderIncludeCache::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ShaderIncludeCache::ResetStatistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = ShaderIncludeCacheStats();
+}
+
+} // namespace RenderingPlugin
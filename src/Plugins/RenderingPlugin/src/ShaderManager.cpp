@@ -1,4 +1,6 @@
 #include "../include/ShaderManager.h"
+#include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -8,46 +10,71 @@
 
 namespace RenderingPlugin {
 
+namespace {
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void HashCompileOptions(ShaderHasher& hasher, const ShaderCompileOptions& options) {
+    const std::uint8_t flags[3] = {
+        options.enableOptimization, options.enableDebugInfo, options.treatWarningsAsErrors
+    };
+    hasher.Update(flags, sizeof(flags));
+    
+    const std::uint64_t defineCount = options.defines.size();
+    hasher.UpdateValue(defineCount);
+    for (const std::string& define : options.defines) {
+        hasher.Update(define);
+    }
+    const std::uint64_t includePathCount = options.includePaths.size();
+    hasher.UpdateValue(includePathCount);
+    for (const std::string& includePath : options.includePaths) {
+        hasher.Update(includePath);
+    }
+}
+
+} // namespace
+
 // ShaderManager Implementation
 ShaderManager::ShaderManager(LLGL::RenderSystem* renderSystem, ResourceManager* resourceManager)
     : renderSystem_(renderSystem)
     , resourceManager_(resourceManager)
     , cachingEnabled_(true)
-    , hotReloadEnabled_(false) {
+    , programCacheHits_(0)
+    , hotReloadEnabled_(false)
+    , threadPool_(nullptr)
+    , parallelCreationEnabled_(false)
+    , contextBoundBackend_(true)
+    , asyncCompilations_(0)
+    , reflectionHits_(0)
+    , reflectionMisses_(0) {
     if (!renderSystem_) {
         throw std::runtime_error("ShaderManager: RenderSystem cannot be null");
     }
+    
+    InitializeBuiltInShaders();
 }
 
 ShaderManager::~ShaderManager() {
+    // Unfinished asynchronous compilations report a broken promise
+    WaitForAsyncCompilations();
+    pendingCompilations_.clear();
     ReleaseAllShaders();
 }
 
 void ShaderManager::ReleaseAllShaders() {
-    // Note: Individual shader caching is not implemented in this version
-    // shaderCache_ stores CompiledShaderProgram, not individual shaders
-    shaderCache_.clear();
+    ReleaseCachedPrograms();
     
     // Release all shader programs
-    for (const auto& pair : shaderPrograms_) {
-        const CompiledShaderProgram& program = pair.second;
-        if (program.pipelineState) {
-            renderSystem_->Release(*program.pipelineState);
-        }
-        if (program.vertexShader) {
-            renderSystem_->Release(*program.vertexShader);
-        }
-        if (program.fragmentShader) {
-            renderSystem_->Release(*program.fragmentShader);
-        }
-        if (program.geometryShader) {
-            renderSystem_->Release(*program.geometryShader);
-        }
+    for (auto& pair : shaderPrograms_) {
+        ReleaseShaderProgram(pair.second);
     }
     shaderPrograms_.clear();
     
     // Clear file timestamps
     fileModificationTimes_.clear();
+    programFiles_.clear();
 }
 
 // Shader Loading
@@ -65,7 +92,7 @@ ShaderSource ShaderManager::LoadShaderFromFile(const std::string& filePath, Shad
     // Update file timestamp for hot reload
     if (hotReloadEnabled_) {
         auto writeTime = std::filesystem::last_write_time(filePath);
-        fileModificationTimes_[filePath] = writeTime;
+        fileModificationTimes_[ShaderFileWatcher::NormalizePath(filePath)] = writeTime;
     }
     
     ShaderSource source;
@@ -77,13 +104,81 @@ ShaderSource ShaderManager::LoadShaderFromFile(const std::string& filePath, Shad
     return source;
 }
 
-LLGL::Shader* ShaderManager::CreateShader(const ShaderSource& source, const ShaderCompileOptions& options) {
-    // Generate cache key
-    std::string cacheKey = GenerateCacheKey(source, options);
+ShaderSource ShaderManager::LoadShaderFromString(const std::string& source, ShaderType type,
+                                                 const std::string& entryPoint) {
+    ShaderSource shaderSource;
+    shaderSource.type = type;
+    shaderSource.source = source;
+    shaderSource.entryPoint = entryPoint;
+    return shaderSource;
+}
+
+std::vector<ShaderSource> ShaderManager::LoadShadersFromDirectory(const std::string& directoryPath,
+        const std::unordered_map<std::string, ShaderType>& fileExtensions) {
+    std::vector<ShaderSource> sources;
+    
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directoryPath, error), end; !error && it != end; it.increment(error)) {
+        auto type = fileExtensions.find(it->path().extension().string());
+        if (type != fileExtensions.end() && it->is_regular_file(error)) {
+            ShaderSource source;
+            source.type = type->second;
+            source.filePath = it->path().string();
+            sources.push_back(source);
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to read shader directory: " << directoryPath << std::endl;
+        return {};
+    }
     
-    // Note: Individual shader caching is not implemented in this version
-    // since shaderCache_ stores CompiledShaderProgram instead of individual shaders
+    // Directory iteration order is unspecified
+    std::sort(sources.begin(), sources.end(), [](const ShaderSource& a, const ShaderSource& b) {
+        return a.filePath < b.filePath;
+    });
     
+    // Files are independent: read and resolve includes on the pool
+    auto load = [this, &sources](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::string content = ReadFileContents(sources[i].filePath);
+            if (!content.empty()) {
+                sources[i].source = ProcessIncludes(content, sources[i].filePath);
+            }
+        }
+    };
+    if (threadPool_ && sources.size() > 1) {
+        threadPool_->ParallelFor(sources.size(), load, sources.size());
+    } else {
+        load(0, sources.size(), 0);
+    }
+    
+    sources.erase(std::remove_if(sources.begin(), sources.end(), [](const ShaderSource& source) {
+        return source.source.empty();
+    }), sources.end());
+    
+    if (hotReloadEnabled_) {
+        for (const ShaderSource& source : sources) {
+            fileModificationTimes_[ShaderFileWatcher::NormalizePath(source.filePath)] =
+                std::filesystem::last_write_time(source.filePath, error);
+        }
+    }
+    
+    return sources;
+}
+
+std::string ShaderManager::ReadFileContents(const std::string& filePath) const {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open shader file: " << filePath << std::endl;
+        return "";
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+LLGL::Shader* ShaderManager::CreateShader(const ShaderSource& source, const ShaderCompileOptions& options) {
     // Create shader descriptor
     LLGL::ShaderDescriptor shaderDesc;
     shaderDesc.type = ConvertShaderType(source.type);
@@ -124,6 +219,7 @@ LLGL::Shader* ShaderManager::CreateShader(const ShaderSource& source, const Shad
     }
     
     // Create shader
+    std::lock_guard<std::mutex> lock(creationMutex_);
     LLGL::Shader* shader = renderSystem_->CreateShader(shaderDesc);
     if (!shader) {
         throw std::runtime_error("Failed to create shader");
@@ -137,9 +233,6 @@ LLGL::Shader* ShaderManager::CreateShader(const ShaderSource& source, const Shad
         throw std::runtime_error("Shader compilation failed: " + infoLog);
     }
     
-    // Note: Individual shader caching is handled differently
-    // For now, we'll skip individual shader caching and rely on program caching
-    
     return shader;
 }
 
@@ -148,128 +241,329 @@ LLGL::Shader* ShaderManager::CreateShader(const ShaderSource& source, const Shad
 // Shader Program Management
 CompiledShaderProgram ShaderManager::CompileShaderProgram(const ShaderProgramDesc& programDesc,
                                                               const ShaderCompileOptions& options) {
+    auto compileStart = std::chrono::steady_clock::now();
+    
+    // Without an include resolver the sources and options determine the program, so the memoized
+    // stage hashes form the key; included files may change, so with one the resolved sources do
+    ShaderHash cacheKey;
     CompiledShaderProgram program;
-    program.name = programDesc.name;
-    program.isValid = false;
+    bool cacheHit = false;
+    if (cachingEnabled_ && !includeResolver_) {
+        cacheKey = GenerateProgramCacheKey(programDesc, options);
+        cacheHit = AcquireCachedProgram(cacheKey, program);
+    }
     
-    LLGL::Shader* vertexShader = nullptr;
-    LLGL::Shader* fragmentShader = nullptr;
-    LLGL::Shader* geometryShader = nullptr;
-    
-    // Create vertex shader
-    if (!programDesc.vertexShader.source.empty()) {
-        LLGL::ShaderDescriptor shaderDesc;
-        shaderDesc.type = LLGL::ShaderType::Vertex;
-        shaderDesc.source = programDesc.vertexShader.source.c_str();
-        shaderDesc.sourceSize = programDesc.vertexShader.source.length();
-        shaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
-        shaderDesc.entryPoint = programDesc.vertexShader.entryPoint.c_str();
-        shaderDesc.profile = programDesc.vertexShader.profile.c_str();
-        
-        vertexShader = renderSystem_->CreateShader(shaderDesc);
-        if (!vertexShader) {
-            program.errorLog += "Vertex shader compilation failed: Failed to create vertex shader\n";
-            return program;
+    double prepareTimeMs = 0.0;
+    double compileTimeMs = 0.0;
+    if (!cacheHit) {
+        PreparedShaderProgram prepared = PrepareShaderProgram(programDesc, options, true);
+        prepareTimeMs = prepared.prepareTimeMs;
+        if (cachingEnabled_ && includeResolver_) {
+            cacheKey = GenerateProgramCacheKey(prepared.desc, options);
+            cacheHit = AcquireCachedProgram(cacheKey, program);
         }
-        
-        const LLGL::Report* vertexReport = vertexShader->GetReport();
-        if (vertexReport && vertexReport->HasErrors()) {
-            program.errorLog += "Vertex shader compilation failed: ";
-            program.errorLog += vertexReport->GetText();
-            program.errorLog += "\n";
-            return program;
+        if (!cacheHit) {
+            program = CreateShaderProgramObjects(prepared, compileTimeMs);
+            if (cachingEnabled_ && program.isValid) {
+                AddCachedProgram(cacheKey, program);
+            }
         }
     }
     
-    // Create fragment shader
-    if (!programDesc.fragmentShader.source.empty()) {
-        LLGL::ShaderDescriptor shaderDesc;
-        shaderDesc.type = LLGL::ShaderType::Fragment;
-        shaderDesc.source = programDesc.fragmentShader.source.c_str();
-        shaderDesc.sourceSize = programDesc.fragmentShader.source.length();
-        shaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
-        shaderDesc.entryPoint = programDesc.fragmentShader.entryPoint.c_str();
-        shaderDesc.profile = programDesc.fragmentShader.profile.c_str();
-        
-        fragmentShader = renderSystem_->CreateShader(shaderDesc);
-        if (!fragmentShader) {
-            program.errorLog += "Fragment shader compilation failed: Failed to create fragment shader\n";
-            return program;
+    // A cache hit may come from a program compiled under another name
+    program.name = programDesc.name;
+    
+    ShaderCompileTiming timing;
+    timing.programCount = 1;
+    timing.wallTimeMs = ElapsedMs(compileStart);
+    timing.summedTimeMs = prepareTimeMs + compileTimeMs;
+    timing.preprocessTimeMs = prepareTimeMs;
+    
+    RecordCompilationTime(program, timing.summedTimeMs);
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    lastCompileTiming_ = timing;
+    return program;
+}
+
+ShaderManager::PreparedShaderProgram ShaderManager::PrepareShaderProgram(const ShaderProgramDesc& programDesc,
+                                                                         const ShaderCompileOptions& options,
+                                                                         bool parallelStages) {
+    auto prepareStart = std::chrono::steady_clock::now();
+    
+    PreparedShaderProgram prepared;
+    prepared.desc = programDesc;
+    prepared.options = options;
+    
+    // Program defines (e.g. variant keywords) first, then the defines passed with the call
+    std::vector<std::string> defines = programDesc.compileOptions.defines;
+    defines.insert(defines.end(), options.defines.begin(), options.defines.end());
+    
+    if (includeResolver_ || !defines.empty()) {
+        std::vector<ShaderSource*> stages;
+        for (ShaderSource* stage : { &prepared.desc.vertexShader, &prepared.desc.fragmentShader,
+                                     &prepared.desc.geometryShader, &prepared.desc.tessControlShader,
+                                     &prepared.desc.tessEvaluationShader, &prepared.desc.computeShader }) {
+            if (!stage->source.empty()) {
+                stages.push_back(stage);
+            }
         }
         
-        const LLGL::Report* fragmentReport = fragmentShader->GetReport();
-        if (fragmentReport && fragmentReport->HasErrors()) {
-            program.errorLog += "Fragment shader compilation failed: ";
-            program.errorLog += fragmentReport->GetText();
-            program.errorLog += "\n";
-            return program;
+        // One include list per stage, so stages preprocessed in parallel never share a vector
+        std::vector<std::vector<std::string>> stageIncludes(stages.size());
+        auto preprocess = [this, &stages, &stageIncludes, &defines](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                if (includeResolver_) {
+                    stages[i]->source = ProcessIncludes(stages[i]->source, stages[i]->filePath, &stageIncludes[i]);
+                }
+                if (!defines.empty()) {
+                    stages[i]->source = PreprocessShader(stages[i]->source, defines);
+                }
+                stages[i]->InvalidateHash();
+            }
+        };
+        if (parallelStages && threadPool_ && stages.size() > 1) {
+            threadPool_->ParallelFor(stages.size(), preprocess, stages.size());
+        } else {
+            preprocess(0, stages.size(), 0);
+        }
+        for (const std::vector<std::string>& includes : stageIncludes) {
+            prepared.includedFiles.insert(prepared.includedFiles.end(), includes.begin(), includes.end());
         }
     }
     
-    // Create geometry shader if specified
-    if (!programDesc.geometryShader.source.empty()) {
-        LLGL::ShaderDescriptor shaderDesc;
-        shaderDesc.type = LLGL::ShaderType::Geometry;
-        shaderDesc.source = programDesc.geometryShader.source.c_str();
-        shaderDesc.sourceSize = programDesc.geometryShader.source.length();
-        shaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
-        shaderDesc.entryPoint = programDesc.geometryShader.entryPoint.c_str();
-        shaderDesc.profile = programDesc.geometryShader.profile.c_str();
-        
-        geometryShader = renderSystem_->CreateShader(shaderDesc);
-        if (!geometryShader) {
-            program.errorLog += "Geometry shader compilation failed: Failed to create geometry shader\n";
-            return program;
+    // The key hashes every stage here, so the memoized stage hashes are never computed concurrently
+    if (cachingEnabled_ && diskCache_.IsOpen()) {
+        prepared.useDiskCache = true;
+        prepared.diskCacheKey = GenerateDiskCacheKey(prepared.desc, options);
+        prepared.diskCacheHit = diskCache_.Load(prepared.diskCacheKey, prepared.cachedBlob);
+    }
+    
+    prepared.prepareTimeMs = ElapsedMs(prepareStart);
+    return prepared;
+}
+
+CompiledShaderProgram ShaderManager::CreateShaderProgramObjects(const PreparedShaderProgram& prepared,
+                                                                double& compileTimeMs) {
+    const ShaderProgramDesc& programDesc = prepared.desc;
+    
+    CompiledShaderProgram program;
+    program.name = programDesc.name;
+    program.isValid = false;
+    
+    // Recorded even when compilation fails, so fixing any of these files triggers a reload
+    for (const ShaderSource* stage : { &programDesc.vertexShader, &programDesc.fragmentShader, &programDesc.geometryShader,
+                                       &programDesc.tessControlShader, &programDesc.tessEvaluationShader,
+                                       &programDesc.computeShader }) {
+        if (!stage->filePath.empty()) {
+            program.sourceFiles.push_back(ShaderFileWatcher::NormalizePath(stage->filePath));
         }
-        
-        const LLGL::Report* geometryReport = geometryShader->GetReport();
-        if (geometryReport && geometryReport->HasErrors()) {
-            program.errorLog += "Geometry shader compilation failed: ";
-            program.errorLog += geometryReport->GetText();
-            program.errorLog += "\n";
-            return program;
+    }
+    program.sourceFiles.insert(program.sourceFiles.end(), prepared.includedFiles.begin(), prepared.includedFiles.end());
+    std::sort(program.sourceFiles.begin(), program.sourceFiles.end());
+    program.sourceFiles.erase(std::unique(program.sourceFiles.begin(), program.sourceFiles.end()), program.sourceFiles.end());
+    
+    struct StageJob {
+        const ShaderSource* source;
+        LLGL::ShaderType type;
+        const char* name;
+        LLGL::Shader** shader;
+        std::string errorLog;
+        double timeMs;
+    };
+    
+    StageJob stageJobs[] = {
+        { &programDesc.vertexShader, LLGL::ShaderType::Vertex, "Vertex", &program.vertexShader, "", 0.0 },
+        { &programDesc.fragmentShader, LLGL::ShaderType::Fragment, "Fragment", &program.fragmentShader, "", 0.0 },
+        { &programDesc.geometryShader, LLGL::ShaderType::Geometry, "Geometry", &program.geometryShader, "", 0.0 },
+        { &programDesc.tessControlShader, LLGL::ShaderType::TessControl, "Tessellation control", &program.tessControlShader, "", 0.0 },
+        { &programDesc.tessEvaluationShader, LLGL::ShaderType::TessEvaluation, "Tessellation evaluation", &program.tessEvaluationShader, "", 0.0 }
+    };
+    
+    std::vector<StageJob*> jobs;
+    for (StageJob& job : stageJobs) {
+        if (!job.source->source.empty()) {
+            jobs.push_back(&job);
         }
     }
     
+    // LLGL calls are serialized, so the stages are created one after another
+    for (StageJob* job : jobs) {
+        auto stageStart = std::chrono::steady_clock::now();
+        *job->shader = CreateStageShader(*job->source, job->type, job->name, job->errorLog);
+        job->timeMs = ElapsedMs(stageStart);
+    }
+    
+    compileTimeMs = 0.0;
+    for (const StageJob* job : jobs) {
+        program.errorLog += job->errorLog;
+        compileTimeMs += job->timeMs;
+    }
+    if (!program.errorLog.empty()) {
+        ReleaseProgramObjects(program);
+        return program;
+    }
+    
     // Create graphics pipeline state
-    if (vertexShader) {
+    auto pipelineStart = std::chrono::steady_clock::now();
+    if (program.vertexShader) {
         LLGL::GraphicsPipelineDescriptor pipelineDesc;
-        pipelineDesc.vertexShader = vertexShader;
-        pipelineDesc.fragmentShader = fragmentShader;
-        pipelineDesc.geometryShader = geometryShader;
+        pipelineDesc.vertexShader = program.vertexShader;
+        pipelineDesc.fragmentShader = program.fragmentShader;
+        pipelineDesc.geometryShader = program.geometryShader;
+        pipelineDesc.tessControlShader = program.tessControlShader;
+        pipelineDesc.tessEvaluationShader = program.tessEvaluationShader;
+        
+        // Seed the pipeline cache from disk; a cold entry is written once the pipeline exists
+        LLGL::Blob blob;
+        {
+            std::lock_guard<std::mutex> lock(creationMutex_);
+            LLGL::PipelineCache* pipelineCache = nullptr;
+            if (prepared.useDiskCache) {
+                if (prepared.diskCacheHit) {
+                    pipelineCache = renderSystem_->CreatePipelineCache(
+                        LLGL::Blob::CreateCopy(prepared.cachedBlob.data(), prepared.cachedBlob.size()));
+                } else {
+                    pipelineCache = renderSystem_->CreatePipelineCache();
+                }
+            }
+            
+            program.pipelineState = renderSystem_->CreatePipelineState(pipelineDesc, pipelineCache);
+            if (pipelineCache) {
+                if (program.pipelineState && !prepared.diskCacheHit) {
+                    blob = pipelineCache->GetBlob();
+                }
+                renderSystem_->Release(*pipelineCache);
+            }
+        }
         
-        program.pipelineState = renderSystem_->CreatePipelineState(pipelineDesc);
         if (program.pipelineState) {
             program.isValid = true;
+            ExtractShaderReflection(programDesc, program);
         } else {
             program.errorLog = "Failed to create graphics pipeline state";
         }
+        
+        // Backends without program binaries return an empty blob; nothing is stored then
+        if (blob) {
+            diskCache_.Store(prepared.diskCacheKey, blob.GetData(), blob.GetSize());
+        }
     } else {
         program.errorLog = "Vertex shader is required for graphics pipeline";
     }
-    
-    // Store compiled shaders for cleanup
-    program.vertexShader = vertexShader;
-    program.fragmentShader = fragmentShader;
-    program.geometryShader = geometryShader;
+    compileTimeMs += ElapsedMs(pipelineStart);
     
     return program;
 }
 
+LLGL::Shader* ShaderManager::CreateStageShader(const ShaderSource& source, LLGL::ShaderType type,
+                                               const std::string& stageName, std::string& errorLog) {
+    LLGL::ShaderDescriptor shaderDesc;
+    shaderDesc.type = type;
+    shaderDesc.source = source.source.c_str();
+    shaderDesc.sourceSize = source.source.length();
+    shaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+    shaderDesc.entryPoint = source.entryPoint.c_str();
+    shaderDesc.profile = source.profile.c_str();
+    
+    std::lock_guard<std::mutex> lock(creationMutex_);
+    LLGL::Shader* shader = renderSystem_->CreateShader(shaderDesc);
+    if (!shader) {
+        std::string lowerName = stageName;
+        lowerName[0] = static_cast<char>(std::tolower(static_cast<unsigned char>(lowerName[0])));
+        errorLog += stageName + " shader compilation failed: Failed to create " + lowerName + " shader\n";
+        return nullptr;
+    }
+    
+    const LLGL::Report* report = shader->GetReport();
+    if (report && report->HasErrors()) {
+        errorLog += stageName + " shader compilation failed: ";
+        errorLog += report->GetText();
+        errorLog += "\n";
+        renderSystem_->Release(*shader);
+        return nullptr;
+    }
+    
+    return shader;
+}
+
+void ShaderManager::ReleaseShaderProgram(CompiledShaderProgram& program) {
+    if (program.pipelineState) {
+        std::lock_guard<std::mutex> lock(shaderCacheMutex_);
+        auto shared = sharedPrograms_.find(program.pipelineState);
+        if (shared != sharedPrograms_.end()) {
+            // The cache or other copies still use the objects
+            if (--shared->second.references > 0) {
+                program.isValid = false;
+                program.pipelineState = nullptr;
+                program.vertexShader = nullptr;
+                program.fragmentShader = nullptr;
+                program.geometryShader = nullptr;
+                program.tessControlShader = nullptr;
+                program.tessEvaluationShader = nullptr;
+                return;
+            }
+            sharedPrograms_.erase(shared);
+        }
+    }
+    ReleaseProgramObjects(program);
+}
+
+void ShaderManager::ReleaseProgramObjects(CompiledShaderProgram& program) {
+    std::lock_guard<std::mutex> lock(creationMutex_);
+    program.isValid = false;
+    if (program.pipelineState) {
+        renderSystem_->Release(*program.pipelineState);
+        program.pipelineState = nullptr;
+    }
+    for (LLGL::Shader** shader : { &program.vertexShader, &program.fragmentShader, &program.geometryShader,
+                                   &program.tessControlShader, &program.tessEvaluationShader }) {
+        if (*shader) {
+            renderSystem_->Release(**shader);
+            *shader = nullptr;
+        }
+    }
+}
+
 CompiledShaderProgram ShaderManager::CompileShaderProgramFromFiles(const std::string& programName,
         const std::unordered_map<ShaderType, std::string>& shaderFiles,
         const std::vector<LLGL::VertexAttribute>& vertexAttributes,
         const ShaderCompileOptions& options) {
     
+    // The options travel in the description, so defines are inserted once
+    ShaderProgramDesc desc = MakeProgramDescFromFiles(programName, shaderFiles, options);
+    CompiledShaderProgram program = CompileShaderProgram(desc);
+    program.name = programName;
+    
+    // Remember the files and arguments so ReloadShaderProgram rebuilds the same program
+    ProgramFiles& sources = programFileSources_[programName];
+    sources.shaderFiles = shaderFiles;
+    sources.vertexAttributes = vertexAttributes;
+    sources.options = options;
+    if (program.isValid) {
+        TrackProgramFiles(programName, program.sourceFiles);
+    }
+    return program;
+}
+
+ShaderProgramDesc ShaderManager::MakeProgramDescFromFiles(const std::string& programName,
+        const std::unordered_map<ShaderType, std::string>& shaderFiles,
+        const ShaderCompileOptions& options) const {
+    
     ShaderProgramDesc desc;
+    desc.name = programName;
     desc.compileOptions = options;
     
     for (const auto& pair : shaderFiles) {
         ShaderType type = pair.first;
         const std::string& filePath = pair.second;
         
-        ShaderSource source = LoadShaderFromFile(filePath, type, "");
+        ShaderSource source;
+        source.type = type;
+        source.source = ReadFileContents(filePath);
         source.filePath = filePath;
+        if (source.source.empty()) {
+            throw std::runtime_error("Failed to open shader file: " + filePath);
+        }
         
         // Set default entry points and profiles based on shader type
         switch (type) {
@@ -306,24 +600,359 @@ CompiledShaderProgram ShaderManager::CompileShaderProgramFromFiles(const std::st
         }
     }
     
-    CompiledShaderProgram program = CompileShaderProgram(desc, options);
-    program.name = programName;
-    return program;
+    return desc;
 }
 
-// Hot Reload
-void ShaderManager::SetHotReloadEnabled(bool enable) {
-    hotReloadEnabled_ = enable;
+// Parallel Compilation
+void ShaderManager::SetThreadPool(ThreadPool* threadPool) {
+    // Queued tasks run on the old pool and reference this manager
+    WaitForAsyncCompilations();
+    threadPool_ = threadPool;
+}
+
+ThreadPool* ShaderManager::GetThreadPool() const {
+    return threadPool_;
+}
+
+void ShaderManager::SetParallelCreationEnabled(bool enable) {
+    parallelCreationEnabled_ = enable;
     if (enable) {
-        // Update timestamps for all cached shader programs
-        for (const auto& pair : shaderPrograms_) {
-            // For simplicity, we'll track all shader files that might be used
-            // This is a basic implementation - a more sophisticated version would
-            // track individual shader file dependencies
+        const LLGL::RendererInfo& info = renderSystem_->GetRendererInfo();
+        contextBoundBackend_ = info.rendererName.find("OpenGL") != std::string::npos;
+    }
+}
+
+bool ShaderManager::IsParallelCreationSupported() const {
+    return threadPool_ && parallelCreationEnabled_ && !contextBoundBackend_;
+}
+
+std::vector<CompiledShaderProgram> ShaderManager::CompileShaderPrograms(const std::vector<ShaderProgramDesc>& programDescs,
+                                                                        const ShaderCompileOptions& options) {
+    auto batchStart = std::chrono::steady_clock::now();
+    const std::size_t count = programDescs.size();
+    
+    std::vector<PreparedShaderProgram> prepared(count);
+    std::vector<CompiledShaderProgram> programs(count);
+    std::vector<double> compileTimes(count, 0.0);
+    
+    // Programs are spread over the pool one at a time; their stages stay on the program's worker
+    auto prepare = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            prepared[i] = PrepareShaderProgram(programDescs[i], options, false);
+        }
+    };
+    auto create = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            programs[i] = CreateShaderProgramObjects(prepared[i], compileTimes[i]);
         }
+    };
+    
+    if (threadPool_ && count > 1) {
+        threadPool_->ParallelFor(count, prepare, count);
     } else {
-        fileModificationTimes_.clear();
+        prepare(0, count, 0);
+    }
+    if (IsParallelCreationSupported() && count > 1) {
+        threadPool_->ParallelFor(count, create, count);
+    } else {
+        create(0, count, 0);
+    }
+    
+    ShaderCompileTiming timing;
+    timing.programCount = count;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double programTimeMs = prepared[i].prepareTimeMs + compileTimes[i];
+        RecordCompilationTime(programs[i], programTimeMs);
+        timing.summedTimeMs += programTimeMs;
+        timing.preprocessTimeMs += prepared[i].prepareTimeMs;
+    }
+    timing.wallTimeMs = ElapsedMs(batchStart);
+    
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    lastCompileTiming_ = timing;
+    return programs;
+}
+
+std::future<CompiledShaderProgram> ShaderManager::CompileShaderProgramAsync(const ShaderProgramDesc& programDesc,
+                                                                            const ShaderCompileOptions& options) {
+    return StartAsyncCompilation([programDesc]() { return programDesc; }, options);
+}
+
+std::future<CompiledShaderProgram> ShaderManager::StartAsyncCompilation(std::function<ShaderProgramDesc()> makeDesc,
+                                                                        const ShaderCompileOptions& options) {
+    if (!threadPool_) {
+        std::promise<CompiledShaderProgram> result;
+        try {
+            result.set_value(CompileShaderProgram(makeDesc(), options));
+        } catch (...) {
+            result.set_exception(std::current_exception());
+        }
+        return result.get_future();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+        ++asyncCompilations_;
+    }
+    
+    if (IsParallelCreationSupported()) {
+        return threadPool_->Enqueue([this, makeDesc, options]() {
+            CompiledShaderProgram program;
+            try {
+                PreparedShaderProgram prepared = PrepareShaderProgram(makeDesc(), options, false);
+                double compileTimeMs = 0.0;
+                program = CreateShaderProgramObjects(prepared, compileTimeMs);
+                RecordCompilationTime(program, prepared.prepareTimeMs + compileTimeMs);
+            } catch (...) {
+                EndAsyncCompilation();
+                throw;
+            }
+            EndAsyncCompilation();
+            return program;
+        });
+    }
+    
+    // LLGL objects are created on this thread by ProcessPendingCompilations
+    PendingCompilation pending;
+    pending.prepared = threadPool_->Enqueue([this, makeDesc, options]() {
+        PreparedShaderProgram prepared;
+        try {
+            prepared = PrepareShaderProgram(makeDesc(), options, false);
+        } catch (...) {
+            EndAsyncCompilation();
+            throw;
+        }
+        EndAsyncCompilation();
+        return prepared;
+    });
+    std::future<CompiledShaderProgram> result = pending.result.get_future();
+    pendingCompilations_.push_back(std::move(pending));
+    return result;
+}
+
+std::size_t ShaderManager::ProcessPendingCompilations(std::size_t maxPrograms) {
+    std::size_t completed = 0;
+    for (auto it = pendingCompilations_.begin(); it != pendingCompilations_.end() && completed < maxPrograms;) {
+        if (it->prepared.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        
+        try {
+            PreparedShaderProgram prepared = it->prepared.get();
+            double compileTimeMs = 0.0;
+            CompiledShaderProgram program = CreateShaderProgramObjects(prepared, compileTimeMs);
+            RecordCompilationTime(program, prepared.prepareTimeMs + compileTimeMs);
+            it->result.set_value(std::move(program));
+        } catch (...) {
+            it->result.set_exception(std::current_exception());
+        }
+        
+        it = pendingCompilations_.erase(it);
+        ++completed;
+    }
+    return completed;
+}
+
+std::size_t ShaderManager::GetPendingCompilationCount() const {
+    return pendingCompilations_.size();
+}
+
+ShaderCompileTiming ShaderManager::GetLastCompileTiming() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return lastCompileTiming_;
+}
+
+void ShaderManager::RecordCompilationTime(const CompiledShaderProgram& program, double timeMs) {
+    if (program.isValid && !program.name.empty()) {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        compilationTimes_[program.name] = timeMs;
+    }
+}
+
+void ShaderManager::WaitForAsyncCompilations() {
+    std::unique_lock<std::mutex> lock(asyncMutex_);
+    asyncCondition_.wait(lock, [this]() { return asyncCompilations_ == 0; });
+}
+
+void ShaderManager::EndAsyncCompilation() {
+    // Notify under the lock: the manager may be destroyed as soon as the count reaches zero
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    --asyncCompilations_;
+    asyncCondition_.notify_all();
+}
+
+// Shader Management
+bool ShaderManager::RegisterShaderProgram(const CompiledShaderProgram& program) {
+    if (!program.isValid || program.name.empty()) {
+        std::cerr << "Cannot register invalid or unnamed shader program" << std::endl;
+        return false;
+    }
+    
+    auto existing = shaderPrograms_.find(program.name);
+    if (existing != shaderPrograms_.end()) {
+        // Registering the same program twice must not release it
+        if (existing->second.pipelineState != program.pipelineState) {
+            ReleaseShaderProgram(existing->second);
+        }
+        existing->second = program;
+    } else {
+        shaderPrograms_.emplace(program.name, program);
+    }
+    return true;
+}
+
+const CompiledShaderProgram* ShaderManager::GetShaderProgram(const std::string& name) const {
+    auto it = shaderPrograms_.find(name);
+    return it != shaderPrograms_.end() ? &it->second : nullptr;
+}
+
+bool ShaderManager::RemoveShaderProgram(const std::string& name) {
+    auto it = shaderPrograms_.find(name);
+    if (it == shaderPrograms_.end()) {
+        return false;
+    }
+    ReleaseShaderProgram(it->second);
+    shaderPrograms_.erase(it);
+    return true;
+}
+
+bool ShaderManager::HasShaderProgram(const std::string& name) const {
+    return shaderPrograms_.count(name) > 0;
+}
+
+std::vector<std::string> ShaderManager::GetShaderProgramNames() const {
+    std::vector<std::string> names;
+    names.reserve(shaderPrograms_.size());
+    for (const auto& pair : shaderPrograms_) {
+        names.push_back(pair.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+void ShaderManager::ClearAllShaderPrograms() {
+    for (auto& pair : shaderPrograms_) {
+        ReleaseShaderProgram(pair.second);
     }
+    shaderPrograms_.clear();
+}
+
+// Caching
+std::unordered_map<std::string, double> ShaderManager::GetCompilationStatistics() const {
+    std::unordered_map<std::string, double> statistics;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        statistics = compilationTimes_;
+        statistics["lastBatch.wallTimeMs"] = lastCompileTiming_.wallTimeMs;
+        statistics["lastBatch.summedTimeMs"] = lastCompileTiming_.summedTimeMs;
+    }
+    
+    const ShaderDiskCacheStats diskStats = diskCache_.GetStatistics();
+    statistics["diskCache.hits"] = static_cast<double>(diskStats.hits);
+    statistics["diskCache.misses"] = static_cast<double>(diskStats.misses);
+    statistics["diskCache.writes"] = static_cast<double>(diskStats.writes);
+    statistics["diskCache.rejected"] = static_cast<double>(diskStats.rejected);
+    
+    const ShaderIncludeCacheStats includeStats = includeCache_.GetStatistics();
+    statistics["includeCache.hits"] = static_cast<double>(includeStats.hits);
+    statistics["includeCache.loads"] = static_cast<double>(includeStats.loads);
+    
+    {
+        std::lock_guard<std::mutex> lock(shaderCacheMutex_);
+        statistics["programCache.hits"] = static_cast<double>(programCacheHits_);
+        statistics["programCache.entries"] = static_cast<double>(shaderCache_.size());
+    }
+    
+    std::lock_guard<std::mutex> lock(reflectionMutex_);
+    statistics["reflection.hits"] = static_cast<double>(reflectionHits_);
+    statistics["reflection.misses"] = static_cast<double>(reflectionMisses_);
+    return statistics;
+}
+
+void ShaderManager::SetCachingEnabled(bool enable) {
+    cachingEnabled_ = enable;
+}
+
+bool ShaderManager::IsCachingEnabled() const {
+    return cachingEnabled_;
+}
+
+void ShaderManager::ClearCache() {
+    ReleaseCachedPrograms();
+    diskCache_.Clear();
+}
+
+bool ShaderManager::SetDiskCacheDirectory(const std::string& directory) {
+    if (directory.empty()) {
+        diskCache_.Close();
+        return false;
+    }
+    
+    // Driver updates change the renderer/device strings and so invalidate every entry
+    const LLGL::RendererInfo& info = renderSystem_->GetRendererInfo();
+    backendId_ = info.rendererName + "|" + info.deviceName + "|" + info.vendorName + "|" + info.shadingLanguageName;
+    return diskCache_.Open(directory, backendId_);
+}
+
+ShaderDiskCacheStats ShaderManager::GetDiskCacheStatistics() const {
+    return diskCache_.GetStatistics();
+}
+
+// Hot Reload
+void ShaderManager::SetHotReloadEnabled(bool enable) {
+    hotReloadEnabled_ = enable;
+    fileWatcher_.Stop();
+    fileModificationTimes_.clear();
+    if (!enable) {
+        return;
+    }
+    
+    if (!fileWatcher_.Start()) {
+        std::cerr << "Shader hot reload falls back to polling file modification times" << std::endl;
+    }
+    for (const auto& pair : programFiles_) {
+        TrackProgramFiles(pair.first, pair.second);
+    }
+}
+
+bool ShaderManager::IsHotReloadEnabled() const {
+    return hotReloadEnabled_;
+}
+
+bool ShaderManager::IsFileWatcherActive() const {
+    return hotReloadEnabled_ && fileWatcher_.IsRunning();
+}
+
+bool ShaderManager::ReloadShaderProgram(const std::string& programName) {
+    auto sources = programFileSources_.find(programName);
+    auto existing = shaderPrograms_.find(programName);
+    if (sources == programFileSources_.end() || existing == shaderPrograms_.end()) {
+        return false;
+    }
+    
+    // Keep the old program if the edited source does not compile
+    CompiledShaderProgram program;
+    try {
+        // Copied, since compiling from files replaces the stored arguments
+        const ProgramFiles files = sources->second;
+        program = CompileShaderProgramFromFiles(programName, files.shaderFiles, files.vertexAttributes, files.options);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to reload shader program " << programName << ": " << e.what() << std::endl;
+        return false;
+    }
+    if (!program.isValid) {
+        std::cerr << "Failed to reload shader program " << programName << ": " << program.errorLog << std::endl;
+        return false;
+    }
+    
+    ReleaseReplacedProgram(std::move(existing->second));
+    existing->second = program;
+    return true;
+}
+
+void ShaderManager::SetReleaseScheduler(ReleaseScheduler scheduler) {
+    releaseScheduler_ = std::move(scheduler);
 }
 
 bool ShaderManager::CheckForShaderChanges() {
@@ -331,56 +960,136 @@ bool ShaderManager::CheckForShaderChanges() {
         return false;
     }
     
-    bool hasChanges = false;
-    
-    for (const auto& pair : fileModificationTimes_) {
-        const std::string& filePath = pair.first;
-        const auto& cachedTime = pair.second;
-        
-        if (std::filesystem::exists(filePath)) {
-            auto currentTime = std::filesystem::last_write_time(filePath);
-            if (currentTime != cachedTime) {
-                hasChanges = true;
-                break;
+    // The watcher thread has done the work; nothing to do until it publishes a change
+    if (fileWatcher_.IsRunning()) {
+        if (fileWatcher_.HasChanges()) {
+            for (const std::string& filePath : fileWatcher_.TakeChanges()) {
+                ReloadAffectedPrograms(filePath);
             }
         }
+    } else {
+        for (const std::string& filePath : PollChangedFiles()) {
+            ReloadAffectedPrograms(filePath);
+        }
     }
     
-    return hasChanges;
+    if (pendingReloads_.empty()) {
+        return false;
+    }
+    if (!IsParallelCreationSupported()) {
+        ProcessPendingCompilations();
+    }
+    return FinishProgramReloads() > 0;
 }
 
-void ShaderManager::ReloadChangedShaders() {
-    if (!hotReloadEnabled_) {
+std::vector<std::string> ShaderManager::PollChangedFiles() {
+    std::vector<std::string> changedFiles;
+    for (auto& pair : fileModificationTimes_) {
+        std::error_code error;
+        const auto currentTime = std::filesystem::last_write_time(pair.first, error);
+        if (!error && currentTime != pair.second) {
+            changedFiles.push_back(pair.first);
+            pair.second = currentTime;
+        }
+    }
+    return changedFiles;
+}
+
+void ShaderManager::StartProgramReload(const std::string& programName) {
+    auto sources = programFileSources_.find(programName);
+    if (sources == programFileSources_.end()) {
         return;
     }
     
-    std::vector<std::string> changedFiles;
+    // A burst of edits during a compile results in one more compile, not one per edit
+    for (PendingReload& pending : pendingReloads_) {
+        if (pending.programName == programName) {
+            pending.reloadAgain = true;
+            return;
+        }
+    }
     
-    // Find changed files
-    for (auto& pair : fileModificationTimes_) {
-        const std::string& filePath = pair.first;
-        auto& cachedTime = pair.second;
+    // Built like CompileShaderProgramFromFiles, so the reload keeps the program's defines
+    const ProgramFiles files = sources->second;
+    PendingReload reload;
+    reload.programName = programName;
+    reload.result = StartAsyncCompilation([this, programName, files]() {
+        return MakeProgramDescFromFiles(programName, files.shaderFiles, files.options);
+    }, ShaderCompileOptions());
+    pendingReloads_.push_back(std::move(reload));
+}
+
+std::size_t ShaderManager::FinishProgramReloads() {
+    std::size_t replaced = 0;
+    std::vector<std::string> restart;
+    
+    for (auto it = pendingReloads_.begin(); it != pendingReloads_.end();) {
+        if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
         
-        if (std::filesystem::exists(filePath)) {
-            auto currentTime = std::filesystem::last_write_time(filePath);
-            if (currentTime != cachedTime) {
-                changedFiles.push_back(filePath);
-                cachedTime = currentTime;
-            }
+        // Keep the old program if the edited source does not compile
+        CompiledShaderProgram program;
+        try {
+            program = it->result.get();
+        } catch (const std::exception& e) {
+            program.errorLog = e.what();
+        }
+        
+        auto existing = shaderPrograms_.find(it->programName);
+        if (!program.isValid) {
+            std::cerr << "Failed to reload shader program " << it->programName << ": " << program.errorLog << std::endl;
+            ReleaseShaderProgram(program);
+        } else if (existing == shaderPrograms_.end()) {
+            // Removed while compiling
+            ReleaseShaderProgram(program);
+        } else {
+            TrackProgramFiles(it->programName, program.sourceFiles);
+            ReleaseReplacedProgram(std::move(existing->second));
+            existing->second = std::move(program);
+            ++replaced;
+        }
+        
+        if (it->reloadAgain) {
+            restart.push_back(it->programName);
         }
+        it = pendingReloads_.erase(it);
     }
     
-    // Reload affected shaders
-    for (const std::string& filePath : changedFiles) {
-        ReloadShader(filePath);
+    for (const std::string& programName : restart) {
+        StartProgramReload(programName);
     }
+    return replaced;
 }
 
-void ShaderManager::ReloadShader(const std::string& filePath) {
-    // Note: Individual shader reloading is not implemented in this version
-    // since shaderCache_ stores CompiledShaderProgram instead of CachedShader
-    // For now, we'll just reload affected shader programs
-    ReloadAffectedPrograms(filePath);
+void ShaderManager::ReleaseReplacedProgram(CompiledShaderProgram program) {
+    if (!releaseScheduler_) {
+        ReleaseShaderProgram(program);
+        return;
+    }
+    
+    // Frames recorded before the reload may still use the old pipeline
+    auto replaced = std::make_shared<CompiledShaderProgram>(std::move(program));
+    releaseScheduler_([this, replaced]() {
+        ReleaseShaderProgram(*replaced);
+    });
+}
+
+void ShaderManager::TrackProgramFiles(const std::string& programName, const std::vector<std::string>& sourceFiles) {
+    programFiles_[programName] = sourceFiles;
+    if (!hotReloadEnabled_) {
+        return;
+    }
+    
+    for (const std::string& filePath : sourceFiles) {
+        if (fileWatcher_.IsRunning()) {
+            fileWatcher_.AddFile(filePath);
+        } else if (fileModificationTimes_.count(filePath) == 0) {
+            std::error_code error;
+            fileModificationTimes_[filePath] = std::filesystem::last_write_time(filePath, error);
+        }
+    }
 }
 
 // Built-in Shaders
@@ -410,7 +1119,7 @@ void main() {
     gl_Position = projectionMatrix * viewMatrix * worldPos;
 }
 )";
-    
+
     // Basic fragment shader
     const std::string basicFragmentShader = R"(
 #version 330 core
@@ -439,10 +1148,106 @@ void main() {
     fragColor = vec4(finalColor, texColor.a);
 }
 )";
+
+    // Instanced vertex shader (world matrix per instance, see RenderCommands::GetInstanceVertexFormat)
+    const std::string instancedVertexShader = R"(
+#version 330 core
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec2 texCoord;
+layout(location = 4) in mat4 world;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec3 fragNormal;
+out vec2 fragTexCoord;
+out vec3 fragWorldPos;
+
+void main() {
+    vec4 worldPos = world * vec4(position, 1.0);
+    fragWorldPos = worldPos.xyz;
+    fragNormal = mat3(world) * normal;
+    fragTexCoord = texCoord;
     
+    gl_Position = projectionMatrix * viewMatrix * worldPos;
+}
+)";
+
+    // Quantized vertex shader (layout of VertexQuantizer::GetVertexFormat, decoded by the input assembler
+    // to unorm/snorm/float, then rebuilt from the mesh's position offset/scale and octahedral normal;
+    // the QuantizedDecode block holds QuantizedDecodeParams, see VertexQuantizer::CreateDecodeBuffer)
+    const std::string quantizedDecode = R"(
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 normal;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in vec4 color;
+
+layout(std140) uniform QuantizedDecode {
+    vec4 positionOffset;
+    vec4 positionScale;
+};
+
+vec3 DecodePosition() {
+    return positionOffset.xyz + positionScale.xyz * position.xyz;
+}
+
+vec3 DecodeNormal() {
+    vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+)";
+
+    const std::string quantizedVertexShader = quantizedDecode + R"(
+uniform mat4 modelMatrix;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec3 fragNormal;
+out vec2 fragTexCoord;
+out vec3 fragWorldPos;
+
+void main() {
+    vec4 worldPos = modelMatrix * vec4(DecodePosition(), 1.0);
+    fragWorldPos = worldPos.xyz;
+    fragNormal = mat3(modelMatrix) * DecodeNormal();
+    fragTexCoord = texCoord;
+    
+    gl_Position = projectionMatrix * viewMatrix * worldPos;
+}
+)";
+
+    const std::string quantizedInstancedVertexShader = quantizedDecode + R"(
+layout(location = 4) in mat4 world;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec3 fragNormal;
+out vec2 fragTexCoord;
+out vec3 fragWorldPos;
+
+void main() {
+    vec4 worldPos = world * vec4(DecodePosition(), 1.0);
+    fragWorldPos = worldPos.xyz;
+    fragNormal = mat3(world) * DecodeNormal();
+    fragTexCoord = texCoord;
+    
+    gl_Position = projectionMatrix * viewMatrix * worldPos;
+}
+)";
+
     // Store built-in shaders
     builtInShaders_["basic_vertex"] = basicVertexShader;
     builtInShaders_["basic_fragment"] = basicFragmentShader;
+    builtInShaders_["instanced_vertex"] = instancedVertexShader;
+    builtInShaders_["quantized_vertex"] = quantizedVertexShader;
+    builtInShaders_["quantized_instanced_vertex"] = quantizedInstancedVertexShader;
 }
 
 std::string ShaderManager::GetBuiltInShader(const std::string& name) const {
@@ -462,13 +1267,28 @@ std::vector<std::string> ShaderManager::GetBuiltInShaderNames() const {
 }
 
 // Utility Functions
+std::string ShaderManager::PreprocessShaderSource(const std::string& source, const ShaderCompileOptions& options) {
+    return PreprocessShader(ProcessIncludes(source, ""), options.defines);
+}
+
+ShaderProgramDesc ShaderManager::PreprocessShaderProgram(const ShaderProgramDesc& programDesc,
+                                                         const ShaderCompileOptions& options) {
+    return PrepareShaderProgram(programDesc, options, true).desc;
+}
+
 std::string ShaderManager::PreprocessShader(const std::string& source, const std::vector<std::string>& defines) {
     std::string result = source;
     
     // Add defines at the beginning
     std::string defineBlock;
     for (const auto& define : defines) {
-        defineBlock += "#define " + define + "\n";
+        // "NAME=VALUE" becomes "#define NAME VALUE"
+        const size_t separator = define.find('=');
+        if (separator != std::string::npos) {
+            defineBlock += "#define " + define.substr(0, separator) + " " + define.substr(separator + 1) + "\n";
+        } else {
+            defineBlock += "#define " + define + "\n";
+        }
     }
     
     // Insert defines after version directive
@@ -500,7 +1320,7 @@ bool ShaderManager::ValidateShaderSource(const std::string& source, ShaderType t
 
 std::vector<std::string> ShaderManager::ExtractUniforms(const std::string& source) {
     std::vector<std::string> uniforms;
-    std::regex uniformRegex(R"(uniform\s+\w+\s+(\w+)\s*;)");
+    static const std::regex uniformRegex(R"(uniform\s+\w+\s+(\w+)\s*;)");
     std::sregex_iterator iter(source.begin(), source.end(), uniformRegex);
     std::sregex_iterator end;
     
@@ -513,7 +1333,7 @@ std::vector<std::string> ShaderManager::ExtractUniforms(const std::string& sourc
 
 std::vector<std::string> ShaderManager::ExtractAttributes(const std::string& source) {
     std::vector<std::string> attributes;
-    std::regex attributeRegex(R"((?:attribute|in)\s+\w+\s+(\w+)\s*;)");
+    static const std::regex attributeRegex(R"((?:attribute|in)\s+\w+\s+(\w+)\s*;)");
     std::sregex_iterator iter(source.begin(), source.end(), attributeRegex);
     std::sregex_iterator end;
     
@@ -524,42 +1344,66 @@ std::vector<std::string> ShaderManager::ExtractAttributes(const std::string& sou
     return attributes;
 }
 
+std::shared_ptr<const ShaderManager::ShaderReflection> ShaderManager::GetShaderReflection(const ShaderSource& source) {
+    const ShaderHash key = source.GetHash();
+    {
+        std::lock_guard<std::mutex> lock(reflectionMutex_);
+        auto it = reflectionCache_.find(key);
+        if (it != reflectionCache_.end()) {
+            ++reflectionHits_;
+            return it->second;
+        }
+        ++reflectionMisses_;
+    }
+    
+    auto reflection = std::make_shared<ShaderReflection>();
+    reflection->uniforms = ExtractUniforms(source.source);
+    reflection->attributes = ExtractAttributes(source.source);
+    
+    std::lock_guard<std::mutex> lock(reflectionMutex_);
+    return reflectionCache_.emplace(key, std::move(reflection)).first->second;
+}
+
+void ShaderManager::ExtractShaderReflection(const ShaderProgramDesc& programDesc, CompiledShaderProgram& program) {
+    program.uniformLocations.clear();
+    program.attributeLocations.clear();
+    
+    for (const ShaderSource* stage : { &programDesc.vertexShader, &programDesc.fragmentShader, &programDesc.geometryShader,
+                                       &programDesc.tessControlShader, &programDesc.tessEvaluationShader,
+                                       &programDesc.computeShader }) {
+        if (stage->source.empty()) {
+            continue;
+        }
+        std::shared_ptr<const ShaderReflection> reflection = GetShaderReflection(*stage);
+        
+        // A uniform shared by several stages keeps the location of its first declaration
+        for (const std::string& uniform : reflection->uniforms) {
+            program.uniformLocations.emplace(uniform, static_cast<std::uint32_t>(program.uniformLocations.size()));
+        }
+        if (stage == &programDesc.vertexShader) {
+            for (const std::string& attribute : reflection->attributes) {
+                program.attributeLocations.emplace(attribute, static_cast<std::uint32_t>(program.attributeLocations.size()));
+            }
+        }
+    }
+}
+
 // Include Processing
 void ShaderManager::SetIncludeResolver(IncludeResolver resolver) {
     includeResolver_ = resolver;
+    includeCache_.Clear();
 }
 
-std::string ShaderManager::ProcessIncludes(const std::string& source, const std::string& currentPath) {
+const ShaderIncludeCache& ShaderManager::GetIncludeCache() const {
+    return includeCache_;
+}
+
+std::string ShaderManager::ProcessIncludes(const std::string& source, const std::string& currentPath,
+                                           std::vector<std::string>* includedFiles) {
     if (!includeResolver_) {
         return source;
     }
-    
-    std::string result = source;
-    std::regex includeRegex(R"(#include\s*["<]([^\s">]+)[">])");
-    std::sregex_iterator iter(result.begin(), result.end(), includeRegex);
-    std::sregex_iterator end;
-    
-    // Process includes from back to front to maintain positions
-    std::vector<std::pair<size_t, size_t>> replacements;
-    std::vector<std::string> includeContents;
-    
-    for (; iter != end; ++iter) {
-        std::string includePath = (*iter)[1].str();
-        std::string includeContent = includeResolver_(includePath, currentPath);
-        
-        // Recursively process includes in the included file
-        includeContent = ProcessIncludes(includeContent, includePath);
-        
-        replacements.push_back({iter->position(), iter->length()});
-        includeContents.push_back(includeContent);
-    }
-    
-    // Apply replacements from back to front
-    for (int i = static_cast<int>(replacements.size()) - 1; i >= 0; --i) {
-        result.replace(replacements[i].first, replacements[i].second, includeContents[i]);
-    }
-    
-    return result;
+    return includeCache_.Expand(source, currentPath, includeResolver_, includedFiles);
 }
 
 // Private Helper Methods
@@ -575,60 +1419,92 @@ LLGL::ShaderType ShaderManager::ConvertShaderType(ShaderType type) const {
     }
 }
 
-std::string ShaderManager::GenerateCacheKey(const ShaderSource& source, const ShaderCompileOptions& options) const {
-    std::string key = source.source + "|" + source.entryPoint + "|" + source.profile + "|" + std::to_string(static_cast<int>(source.type));
-    
-    // Add compile options to key
-    key += "|" + std::to_string(options.enableDebugInfo) + "|" + std::to_string(options.enableOptimization) + "|" + std::to_string(options.treatWarningsAsErrors);
-    
-    // Add defines to key
-    for (const auto& define : options.defines) {
-        key += "|" + define + "=1";
+ShaderHash ShaderManager::GenerateCacheKey(const ShaderSource& source, const ShaderCompileOptions& options) const {
+    ShaderHasher hasher;
+    hasher.Update(source.GetHash());
+    HashCompileOptions(hasher, options);
+    return hasher.Finalize();
+}
+
+ShaderHash ShaderManager::GenerateProgramCacheKey(const ShaderProgramDesc& programDesc) const {
+    // Stage hashes are memoized; options are hashed once for the whole program
+    ShaderHasher hasher;
+    const ShaderSource* stages[] = {
+        &programDesc.vertexShader, &programDesc.fragmentShader, &programDesc.geometryShader,
+        &programDesc.tessControlShader, &programDesc.tessEvaluationShader, &programDesc.computeShader
+    };
+    for (std::uint32_t stage = 0; stage < 6; ++stage) {
+        if (!stages[stage]->source.empty()) {
+            hasher.UpdateValue(stage).Update(stages[stage]->GetHash());
+        }
+    }
+    HashCompileOptions(hasher, programDesc.compileOptions);
+    return hasher.Finalize();
+}
+
+ShaderHash ShaderManager::GenerateProgramCacheKey(const ShaderProgramDesc& programDesc,
+                                                  const ShaderCompileOptions& options) const {
+    ShaderHasher hasher;
+    hasher.Update(GenerateProgramCacheKey(programDesc));
+    HashCompileOptions(hasher, options);
+    return hasher.Finalize();
+}
+
+ShaderHash ShaderManager::GenerateDiskCacheKey(const ShaderProgramDesc& programDesc, const ShaderCompileOptions& options) const {
+    // PrepareShaderProgram resolves includes first, so editing an included file changes the key
+    ShaderHasher hasher;
+    hasher.Update(backendId_).Update(GenerateProgramCacheKey(programDesc));
+    HashCompileOptions(hasher, options);
+    return hasher.Finalize();
+}
+
+bool ShaderManager::AcquireCachedProgram(const ShaderHash& key, CompiledShaderProgram& program) {
+    std::lock_guard<std::mutex> lock(shaderCacheMutex_);
+    auto entry = shaderCache_.find(key);
+    if (entry == shaderCache_.end()) {
+        return false;
     }
     
-    return key;
+    SharedProgram& shared = sharedPrograms_.at(entry->second);
+    ++shared.references;
+    ++programCacheHits_;
+    program = shared.program;
+    return true;
 }
 
-std::string ShaderManager::GenerateProgramCacheKey(const ShaderProgramDesc& programDesc) const {
-    std::string key;
+void ShaderManager::AddCachedProgram(const ShaderHash& key, const CompiledShaderProgram& program) {
+    std::lock_guard<std::mutex> lock(shaderCacheMutex_);
     
-    if (!programDesc.vertexShader.source.empty()) {
-        key += "VS:" + GenerateCacheKey(programDesc.vertexShader, programDesc.compileOptions) + "|";
-    }
-    if (!programDesc.fragmentShader.source.empty()) {
-        key += "FS:" + GenerateCacheKey(programDesc.fragmentShader, programDesc.compileOptions) + "|";
-    }
-    if (!programDesc.geometryShader.source.empty()) {
-        key += "GS:" + GenerateCacheKey(programDesc.geometryShader, programDesc.compileOptions) + "|";
-    }
-    if (!programDesc.tessControlShader.source.empty()) {
-        key += "HS:" + GenerateCacheKey(programDesc.tessControlShader, programDesc.compileOptions) + "|";
-    }
-    if (!programDesc.tessEvaluationShader.source.empty()) {
-        key += "DS:" + GenerateCacheKey(programDesc.tessEvaluationShader, programDesc.compileOptions) + "|";
+    // Another thread may have compiled the same program meanwhile; this copy then stays unshared
+    if (!shaderCache_.emplace(key, program.pipelineState).second) {
+        return;
     }
-    if (!programDesc.computeShader.source.empty()) {
-        key += "CS:" + GenerateCacheKey(programDesc.computeShader, programDesc.compileOptions) + "|";
+    SharedProgram& shared = sharedPrograms_[program.pipelineState];
+    shared.program = program;
+    shared.references = 2;
+}
+
+void ShaderManager::ReleaseCachedPrograms() {
+    std::lock_guard<std::mutex> lock(shaderCacheMutex_);
+    for (const auto& entry : shaderCache_) {
+        auto shared = sharedPrograms_.find(entry.second);
+        if (--shared->second.references == 0) {
+            ReleaseProgramObjects(shared->second.program);
+            sharedPrograms_.erase(shared);
+        }
     }
-    
-    return key;
+    shaderCache_.clear();
 }
 
 void ShaderManager::ReloadAffectedPrograms(const std::string& filePath) {
-    std::vector<std::string> programsToReload;
-    
-    // Find all programs that might use this shader file
-    // This is a simplified implementation - in practice, you'd need to track
-    // which shader files belong to which programs
-    for (const auto& programPair : shaderPrograms_) {
-        // For now, we'll reload all programs when any shader file changes
-        // A more sophisticated implementation would track dependencies
-        programsToReload.push_back(programPair.first);
-    }
-    
-    // Reload affected programs
-    for (const std::string& programName : programsToReload) {
-        ReloadShaderProgram(programName);
+    const std::string changedFile = ShaderFileWatcher::NormalizePath(filePath);
+    includeCache_.Invalidate(changedFile);
+    for (const auto& pair : programFiles_) {
+        const std::vector<std::string>& files = pair.second;
+        if (shaderPrograms_.count(pair.first) != 0 &&
+            std::find(files.begin(), files.end(), changedFile) != files.end()) {
+            StartProgramReload(pair.first);
+        }
     }
 }
 
@@ -0,0 +1,234 @@
+/**
+ * @file ShaderVariants.cpp
+ * @brief Implementation of ShaderVariantSet class
+ */
+
+#include "../include/ShaderVariants.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace RenderingPlugin {
+
+namespace {
+
+bool IsReady(std::future<CompiledShaderProgram>& future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace
+
+ShaderVariantSet::ShaderVariantSet(ShaderManager& shaderManager, const ShaderProgramDesc& baseDesc,
+                                   const std::vector<std::string>& keywords)
+    : shaderManager_(shaderManager)
+    , baseDesc_(baseDesc)
+    , keywordMask_(0)
+    , fallbackMask_(0) {
+    if (keywords.size() > kMaxKeywords) {
+        std::cerr << "Shader variant set " << baseDesc.name << " declares " << keywords.size()
+                  << " keywords, only the first " << kMaxKeywords << " are used" << std::endl;
+    }
+    keywords_.assign(keywords.begin(), keywords.begin() + std::min(keywords.size(), kMaxKeywords));
+    keywordMask_ = keywords_.size() == kMaxKeywords ? ~ShaderVariantMask(0) : (ShaderVariantMask(1) << keywords_.size()) - 1;
+}
+
+ShaderVariantSet::~ShaderVariantSet() {
+    WaitForPendingVariants();
+    for (auto& pair : variants_) {
+        shaderManager_.ReleaseShaderProgram(pair.second.program);
+    }
+}
+
+// === Keywords ===
+
+const std::vector<std::string>& ShaderVariantSet::GetKeywords() const {
+    return keywords_;
+}
+
+ShaderVariantMask ShaderVariantSet::GetKeywordMask(const std::string& keyword) const {
+    auto it = std::find(keywords_.begin(), keywords_.end(), keyword);
+    return it != keywords_.end() ? ShaderVariantMask(1) << (it - keywords_.begin()) : 0;
+}
+
+ShaderVariantMask ShaderVariantSet::MakeMask(const std::vector<std::string>& keywords) const {
+    ShaderVariantMask mask = 0;
+    for (const std::string& keyword : keywords) {
+        mask |= GetKeywordMask(keyword);
+    }
+    return mask;
+}
+
+std::string ShaderVariantSet::GetVariantName(ShaderVariantMask mask) const {
+    std::string name = baseDesc_.name + "[";
+    bool first = true;
+    for (std::size_t i = 0; i < keywords_.size(); ++i) {
+        if (mask & (ShaderVariantMask(1) << i)) {
+            name += first ? "" : "|";
+            name += keywords_[i];
+            first = false;
+        }
+    }
+    return name + "]";
+}
+
+// === Variants ===
+
+void ShaderVariantSet::SetFallbackVariant(ShaderVariantMask mask) {
+    fallbackMask_ = mask & keywordMask_;
+}
+
+ShaderVariantMask ShaderVariantSet::GetFallbackVariant() const {
+    return fallbackMask_;
+}
+
+const CompiledShaderProgram* ShaderVariantSet::GetVariant(ShaderVariantMask mask) {
+    mask &= keywordMask_;
+    if (mask == fallbackMask_) {
+        return GetFallback();
+    }
+    
+    auto it = variants_.find(mask);
+    if (it == variants_.end()) {
+        RequestVariant(mask);
+        it = variants_.find(mask);
+    }
+    
+    VariantEntry& entry = it->second;
+    if (entry.compiling && IsReady(entry.pending)) {
+        FinishVariant(mask, entry, entry.pending.get());
+    }
+    if (entry.program.isValid) {
+        return &entry.program;
+    }
+    
+    ++stats_.fallbackUses;
+    return GetFallback();
+}
+
+const CompiledShaderProgram* ShaderVariantSet::FindVariant(ShaderVariantMask mask) const {
+    auto it = variants_.find(mask & keywordMask_);
+    return (it != variants_.end() && it->second.program.isValid) ? &it->second.program : nullptr;
+}
+
+void ShaderVariantSet::RequestVariant(ShaderVariantMask mask) {
+    mask &= keywordMask_;
+    if (variants_.count(mask) != 0) {
+        return;
+    }
+    if (mask == fallbackMask_) {
+        GetFallback();
+        return;
+    }
+    
+    VariantEntry& entry = variants_[mask];
+    entry.pending = shaderManager_.CompileShaderProgramAsync(MakeVariantDesc(mask));
+    entry.compiling = true;
+    ++stats_.pending;
+}
+
+std::size_t ShaderVariantSet::Precompile(const std::vector<ShaderVariantMask>& masks) {
+    std::vector<ShaderVariantMask> missing;
+    std::vector<ShaderProgramDesc> descs;
+    for (ShaderVariantMask mask : masks) {
+        mask &= keywordMask_;
+        if (variants_.count(mask) == 0 && std::find(missing.begin(), missing.end(), mask) == missing.end()) {
+            missing.push_back(mask);
+            descs.push_back(MakeVariantDesc(mask));
+        }
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<CompiledShaderProgram> programs = shaderManager_.CompileShaderPrograms(descs);
+    stats_.compileTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    std::size_t compiled = 0;
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        compiled += programs[i].isValid ? 1 : 0;
+        FinishVariant(missing[i], variants_[missing[i]], std::move(programs[i]));
+    }
+    return compiled;
+}
+
+std::size_t ShaderVariantSet::Update() {
+    std::size_t finished = 0;
+    for (auto& pair : variants_) {
+        VariantEntry& entry = pair.second;
+        if (entry.compiling && IsReady(entry.pending)) {
+            FinishVariant(pair.first, entry, entry.pending.get());
+            ++finished;
+        }
+    }
+    return finished;
+}
+
+void ShaderVariantSet::WaitForPendingVariants() {
+    while (stats_.pending > 0) {
+        shaderManager_.ProcessPendingCompilations();
+        if (Update() == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::vector<ShaderVariantMask> ShaderVariantSet::GetRequestedVariants() const {
+    std::vector<ShaderVariantMask> masks;
+    masks.reserve(variants_.size());
+    for (const auto& pair : variants_) {
+        masks.push_back(pair.first);
+    }
+    std::sort(masks.begin(), masks.end());
+    return masks;
+}
+
+ShaderVariantStats ShaderVariantSet::GetStatistics() const {
+    return stats_;
+}
+
+ShaderProgramDesc ShaderVariantSet::MakeVariantDesc(ShaderVariantMask mask) const {
+    ShaderProgramDesc desc = baseDesc_;
+    desc.name = GetVariantName(mask);
+    for (std::size_t i = 0; i < keywords_.size(); ++i) {
+        if (mask & (ShaderVariantMask(1) << i)) {
+            desc.compileOptions.AddDefine(keywords_[i]);
+        }
+    }
+    return desc;
+}
+
+void ShaderVariantSet::FinishVariant(ShaderVariantMask mask, VariantEntry& entry, CompiledShaderProgram program) {
+    if (entry.compiling) {
+        entry.compiling = false;
+        --stats_.pending;
+    }
+    
+    entry.program = std::move(program);
+    if (entry.program.isValid) {
+        ++stats_.compiled;
+    } else {
+        // Failed variants stay in the map, so they are served by the fallback and not retried
+        ++stats_.failed;
+        std::cerr << "Failed to compile shader variant " << GetVariantName(mask) << ": " << entry.program.errorLog << std::endl;
+    }
+}
+
+const CompiledShaderProgram* ShaderVariantSet::GetFallback() {
+    auto it = variants_.find(fallbackMask_);
+    if (it == variants_.end()) {
+        auto start = std::chrono::steady_clock::now();
+        CompiledShaderProgram program = shaderManager_.CompileShaderProgram(MakeVariantDesc(fallbackMask_));
+        stats_.compileTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        it = variants_.emplace(fallbackMask_, VariantEntry()).first;
+        FinishVariant(fallbackMask_, it->second, std::move(program));
+    } else if (it->second.compiling) {
+        // Requested asynchronously before it became the fallback
+        while (!IsReady(it->second.pending)) {
+            shaderManager_.ProcessPendingCompilations();
+            std::this_thread::yield();
+        }
+        FinishVariant(fallbackMask_, it->second, it->second.pending.get());
+    }
+    return it->second.program.isValid ? &it->second.program : nullptr;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,779 @@
+/**
+ * @file SoftwareRasterizer.cpp
+ * @brief Implementation of SoftwareRasterizer class
+ */
+
+#include "../include/SoftwareRasterizer.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWARE_RASTERIZER_SSE2 1
+#endif
+
+namespace RenderingPlugin {
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr std::size_t kVerticesPerTask = 4096;
+constexpr std::size_t kTrianglesPerBatch = 2048;
+
+// Vertex positions are snapped to 1/16 pixel
+constexpr std::int32_t kSubpixels = 16;
+
+// Edge values at the first pixel of a tile are clamped to this. Stepping across a tile changes a
+// value by less than half of it, so a clamped value keeps its sign and never overflows 32 bits.
+constexpr std::int64_t kEdgeClamp = std::int64_t(1) << 29;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Signed distance to one of the six planes of the view volume, negative outside
+ */
+float PlaneDistance(const float* position, int plane) {
+    const float w = position[3];
+    const float value = position[plane >> 1];
+    return (plane & 1) ? w - value : w + value;
+}
+
+std::uint32_t PackColor(float r, float g, float b, float a) {
+    auto channel = [](float value) {
+        return static_cast<std::uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (channel(a) << 24);
+}
+
+} // namespace
+
+// === SoftwareRasterizer Implementation ===
+
+SoftwareRasterizer::SoftwareRasterizer(ThreadPool* threadPool)
+    : threadPool_(threadPool) {
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() = default;
+
+// === Configuration ===
+
+bool SoftwareRasterizer::Resize(int width, int height) {
+    if (width < 1 || height < 1 || width > kMaxSize || height > kMaxSize) {
+        std::cerr << "Unsupported software rasterizer size: " << width << "x" << height << std::endl;
+        return false;
+    }
+    
+    Flush();
+    
+    width_ = width;
+    height_ = height;
+    tilesX_ = (width + kTileSize - 1) / kTileSize;
+    tilesY_ = (height + kTileSize - 1) / kTileSize;
+    stride_ = tilesX_ * kTileSize;
+    
+    const std::size_t pixelCount = static_cast<std::size_t>(stride_) * tilesY_ * kTileSize;
+    color_.assign(pixelCount, PackColor(0.0f, 0.0f, 0.0f, 1.0f));
+    depth_.assign(pixelCount, 1.0f);
+    
+    SetViewport(0, 0, width, height);
+    return true;
+}
+
+void SoftwareRasterizer::SetViewport(int x, int y, int width, int height) {
+    // Bounding the viewport bounds the fixed-point vertex positions the edge functions rely on
+    viewport_[0] = std::min(std::max(x, 0), kMaxSize);
+    viewport_[1] = std::min(std::max(y, 0), kMaxSize);
+    viewport_[2] = std::min(std::max(width, 0), kMaxSize - viewport_[0]);
+    viewport_[3] = std::min(std::max(height, 0), kMaxSize - viewport_[1]);
+}
+
+void SoftwareRasterizer::SetThreadPool(ThreadPool* threadPool) {
+    threadPool_ = threadPool;
+}
+
+void SoftwareRasterizer::SetLighting(const SoftwareLighting& lighting) {
+    lighting_ = lighting;
+}
+
+void SoftwareRasterizer::SetBackFaceCulling(bool enabled) {
+    cullBackFaces_ = enabled;
+}
+
+// === Buffers ===
+
+void SoftwareRasterizer::SetVertexBuffer(ResourceId id, std::vector<Vertex> vertices) {
+    SetVertexBuffer(id, std::make_shared<const std::vector<Vertex>>(std::move(vertices)));
+}
+
+void SoftwareRasterizer::SetVertexBuffer(ResourceId id, std::shared_ptr<const std::vector<Vertex>> vertices) {
+    // Pending draws point into the buffer being replaced
+    if (!draws_.empty() && vertexBuffers_.count(id)) {
+        Flush();
+    }
+    vertexBuffers_[id] = std::move(vertices);
+}
+
+void SoftwareRasterizer::SetIndexBuffer(ResourceId id, std::vector<std::uint32_t> indices) {
+    SetIndexBuffer(id, std::make_shared<const std::vector<std::uint32_t>>(std::move(indices)));
+}
+
+void SoftwareRasterizer::SetIndexBuffer(ResourceId id, std::shared_ptr<const std::vector<std::uint32_t>> indices) {
+    if (!draws_.empty() && indexBuffers_.count(id)) {
+        Flush();
+    }
+    indexBuffers_[id] = std::move(indices);
+}
+
+void SoftwareRasterizer::RemoveBuffer(ResourceId id) {
+    if (!draws_.empty() && (vertexBuffers_.count(id) || indexBuffers_.count(id))) {
+        Flush();
+    }
+    vertexBuffers_.erase(id);
+    indexBuffers_.erase(id);
+}
+
+void SoftwareRasterizer::RemoveAllBuffers() {
+    if (!draws_.empty()) {
+        Flush();
+    }
+    vertexBuffers_.clear();
+    indexBuffers_.clear();
+}
+
+// === Drawing ===
+
+void SoftwareRasterizer::Clear(const Color& color, float depth) {
+    Flush();
+    std::fill(color_.begin(), color_.end(), PackColor(color.r, color.g, color.b, color.a));
+    std::fill(depth_.begin(), depth_.end(), depth);
+}
+
+bool SoftwareRasterizer::Draw(const RenderObject& object) {
+    return Draw(object, object.transform);
+}
+
+bool SoftwareRasterizer::Draw(const RenderObject& object, const Matrices& matrices) {
+    if (!object.visible) {
+        return true;
+    }
+    
+    auto vertexBuffer = vertexBuffers_.find(object.vertexBufferId);
+    if (vertexBuffer == vertexBuffers_.end()) {
+        std::cerr << "Vertex buffer " << object.vertexBufferId << " is not registered with the software rasterizer" << std::endl;
+        return false;
+    }
+    const std::vector<Vertex>& vertices = *vertexBuffer->second;
+    const std::size_t end = static_cast<std::size_t>(object.firstIndex) + object.indexCount;
+    
+    if (object.indexBufferId == 0) {
+        if (end > vertices.size()) {
+            std::cerr << "Draw range exceeds vertex buffer " << object.vertexBufferId << std::endl;
+            return false;
+        }
+        return DrawMesh(vertices.data() + object.firstIndex, object.indexCount, nullptr, object.indexCount, matrices);
+    }
+    
+    auto indexBuffer = indexBuffers_.find(object.indexBufferId);
+    if (indexBuffer == indexBuffers_.end()) {
+        std::cerr << "Index buffer " << object.indexBufferId << " is not registered with the software rasterizer" << std::endl;
+        return false;
+    }
+    const std::vector<std::uint32_t>& indices = *indexBuffer->second;
+    if (end > indices.size()) {
+        std::cerr << "Draw range exceeds index buffer " << object.indexBufferId << std::endl;
+        return false;
+    }
+    return DrawMesh(vertices.data(), vertices.size(), indices.data() + object.firstIndex,
+                    object.indexCount, matrices);
+}
+
+bool SoftwareRasterizer::DrawMesh(const Vertex* vertices, std::size_t vertexCount, const std::uint32_t* indices,
+                                  std::size_t indexCount, const Matrices& matrices) {
+    if ((!vertices && vertexCount > 0) || (!indices && indexCount > vertexCount)) {
+        std::cerr << "Software rasterizer draw has fewer vertices than it uses" << std::endl;
+        return false;
+    }
+    if (indexCount < 3) {
+        return true;
+    }
+    
+    DrawCall draw;
+    draw.vertices = vertices;
+    draw.vertexCount = vertexCount;
+    draw.indices = indices;
+    draw.indexCount = indexCount;
+    draw.matrices = matrices;
+    draw.lighting = lighting_;
+    std::copy(viewport_, viewport_ + 4, draw.viewport);
+    draw.cullBackFaces = cullBackFaces_;
+    draws_.push_back(draw);
+    return true;
+}
+
+void SoftwareRasterizer::Flush() {
+    if (draws_.empty()) {
+        return;
+    }
+    
+    stats_ = SoftwareRasterizerStats();
+    stats_.drawCount = static_cast<std::uint32_t>(draws_.size());
+    for (const DrawCall& draw : draws_) {
+        stats_.trianglesSubmitted += draw.indexCount / 3;
+    }
+    
+    auto start = Clock::now();
+    TransformVertices();
+    stats_.vertexTimeMs = ElapsedMs(start);
+    
+    start = Clock::now();
+    SetupTriangles();
+    stats_.setupTimeMs = ElapsedMs(start);
+    
+    start = Clock::now();
+    RasterizeTiles();
+    stats_.rasterTimeMs = ElapsedMs(start);
+    
+    draws_.clear();
+}
+
+// === Readback ===
+
+void SoftwareRasterizer::ReadPixels(std::vector<std::uint8_t>& pixels) const {
+    pixels.resize(static_cast<std::size_t>(width_) * height_ * 4);
+    std::uint8_t* output = pixels.data();
+    const std::size_t rowSize = static_cast<std::size_t>(width_) * 4;
+    
+    // Packed pixels are already RGBA in memory on little-endian machines
+    const std::uint32_t byteOrder = 1;
+    if (*reinterpret_cast<const std::uint8_t*>(&byteOrder) == 1) {
+        for (int y = 0; y < height_; ++y) {
+            std::memcpy(output + y * rowSize, &color_[static_cast<std::size_t>(y) * stride_], rowSize);
+        }
+        return;
+    }
+    
+    for (int y = 0; y < height_; ++y) {
+        const std::uint32_t* row = &color_[static_cast<std::size_t>(y) * stride_];
+        for (int x = 0; x < width_; ++x) {
+            const std::uint32_t pixel = row[x];
+            *output++ = static_cast<std::uint8_t>(pixel);
+            *output++ = static_cast<std::uint8_t>(pixel >> 8);
+            *output++ = static_cast<std::uint8_t>(pixel >> 16);
+            *output++ = static_cast<std::uint8_t>(pixel >> 24);
+        }
+    }
+}
+
+std::uint32_t SoftwareRasterizer::GetPixel(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return 0;
+    }
+    return color_[static_cast<std::size_t>(y) * stride_ + x];
+}
+
+float SoftwareRasterizer::GetDepth(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return 1.0f;
+    }
+    return depth_[static_cast<std::size_t>(y) * stride_ + x];
+}
+
+// === Pipeline ===
+
+template <typename Func>
+void SoftwareRasterizer::RunParallel(std::size_t count, std::size_t chunkCount, Func&& func) {
+    if (threadPool_ && count > 1) {
+        threadPool_->ParallelFor(count, func, chunkCount);
+    } else if (count > 0) {
+        func(0, count, 0);
+    }
+}
+
+void SoftwareRasterizer::TransformVertices() {
+    struct Task {
+        std::size_t draw;
+        std::size_t begin;
+        std::size_t end;
+    };
+    std::vector<Task> tasks;
+    
+    std::size_t vertexCount = 0;
+    for (std::size_t i = 0; i < draws_.size(); ++i) {
+        DrawCall& draw = draws_[i];
+        draw.firstVertex = vertexCount;
+        vertexCount += draw.vertexCount;
+        for (std::size_t begin = 0; begin < draw.vertexCount; begin += kVerticesPerTask) {
+            tasks.push_back({ i, begin, std::min(draw.vertexCount, begin + kVerticesPerTask) });
+        }
+    }
+    clipVertices_.resize(vertexCount);
+    
+    RunParallel(tasks.size(), tasks.size(), [this, &tasks](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t t = begin; t < end; ++t) {
+            const DrawCall& draw = draws_[tasks[t].draw];
+            const Gs::Matrix4f mvp = draw.matrices.projection * draw.matrices.view * draw.matrices.world;
+            const Gs::Matrix4f& world = draw.matrices.world;
+            
+            for (std::size_t i = tasks[t].begin; i < tasks[t].end; ++i) {
+                const Vertex& vertex = draw.vertices[i];
+                ClipVertex& output = clipVertices_[draw.firstVertex + i];
+                const Gs::Vector3f& p = vertex.position;
+                const Gs::Vector3f& n = vertex.normal;
+                for (int r = 0; r < 4; ++r) {
+                    output.position[r] = mvp.At(r, 0) * p.x + mvp.At(r, 1) * p.y + mvp.At(r, 2) * p.z + mvp.At(r, 3);
+                }
+                // Like the default vertex shader, mat3(world) without inverse transpose
+                for (int r = 0; r < 3; ++r) {
+                    output.normal[r] = world.At(r, 0) * n.x + world.At(r, 1) * n.y + world.At(r, 2) * n.z;
+                }
+                output.color[0] = vertex.color.x;
+                output.color[1] = vertex.color.y;
+                output.color[2] = vertex.color.z;
+                
+                // Shared vertices are classified and snapped once instead of per triangle
+                output.outside = 0;
+                for (int plane = 0; plane < 6; ++plane) {
+                    if (PlaneDistance(output.position, plane) < 0.0f) {
+                        output.outside |= 1u << plane;
+                    }
+                }
+                if (output.outside == 0) {
+                    ProjectVertex(draw.viewport, output);
+                }
+            }
+        }
+    });
+}
+
+void SoftwareRasterizer::SetupTriangles() {
+    // Batches of consecutive triangles of one draw are set up and binned independently;
+    // walking the batches in order per tile keeps the submission order
+    std::size_t batchCount = 0;
+    for (const DrawCall& draw : draws_) {
+        batchCount += (draw.indexCount / 3 + kTrianglesPerBatch - 1) / kTrianglesPerBatch;
+    }
+    batches_.resize(batchCount);
+    
+    std::size_t batchIndex = 0;
+    for (std::size_t i = 0; i < draws_.size(); ++i) {
+        const std::size_t triangleCount = draws_[i].indexCount / 3;
+        for (std::size_t first = 0; first < triangleCount; first += kTrianglesPerBatch) {
+            SetupBatch& batch = batches_[batchIndex++];
+            batch.draw = i;
+            batch.firstTriangle = first;
+            batch.endTriangle = std::min(triangleCount, first + kTrianglesPerBatch);
+        }
+    }
+    
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX_) * tilesY_;
+    RunParallel(batchCount, batchCount, [this, tileCount](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t b = begin; b < end; ++b) {
+            SetupBatch& batch = batches_[b];
+            const DrawCall& draw = draws_[batch.draw];
+            const ClipVertex* vertices = clipVertices_.data() + draw.firstVertex;
+            
+            batch.triangles.clear();
+            for (std::size_t t = batch.firstTriangle; t < batch.endTriangle; ++t) {
+                std::size_t index[3] = { t * 3, t * 3 + 1, t * 3 + 2 };
+                if (draw.indices) {
+                    for (std::size_t& i : index) {
+                        i = draw.indices[i];
+                    }
+                    if (index[0] >= draw.vertexCount || index[1] >= draw.vertexCount || index[2] >= draw.vertexCount) {
+                        continue;
+                    }
+                }
+                const ClipVertex* const corners[3] = { vertices + index[0], vertices + index[1], vertices + index[2] };
+                ClipTriangle(draw, corners, batch.triangles);
+            }
+            
+            // Counting sort by tile, stable so each tile sees the triangles in order
+            batch.binOffsets.assign(tileCount + 1, 0);
+            for (const SetupTriangle& triangle : batch.triangles) {
+                for (int ty = triangle.bounds[1] / kTileSize; ty <= triangle.bounds[3] / kTileSize; ++ty) {
+                    for (int tx = triangle.bounds[0] / kTileSize; tx <= triangle.bounds[2] / kTileSize; ++tx) {
+                        ++batch.binOffsets[static_cast<std::size_t>(ty) * tilesX_ + tx + 1];
+                    }
+                }
+            }
+            for (std::size_t tile = 0; tile < tileCount; ++tile) {
+                batch.binOffsets[tile + 1] += batch.binOffsets[tile];
+            }
+            batch.binCursor.assign(batch.binOffsets.begin(), batch.binOffsets.end() - 1);
+            batch.binTriangles.resize(batch.binOffsets.back());
+            for (std::size_t i = 0; i < batch.triangles.size(); ++i) {
+                const SetupTriangle& triangle = batch.triangles[i];
+                for (int ty = triangle.bounds[1] / kTileSize; ty <= triangle.bounds[3] / kTileSize; ++ty) {
+                    for (int tx = triangle.bounds[0] / kTileSize; tx <= triangle.bounds[2] / kTileSize; ++tx) {
+                        batch.binTriangles[batch.binCursor[static_cast<std::size_t>(ty) * tilesX_ + tx]++] =
+                            static_cast<std::uint32_t>(i);
+                    }
+                }
+            }
+        }
+    });
+    
+    for (const SetupBatch& batch : batches_) {
+        stats_.trianglesRasterized += batch.triangles.size();
+    }
+}
+
+void SoftwareRasterizer::ClipTriangle(const DrawCall& draw, const ClipVertex* const vertices[3],
+                                      std::vector<SetupTriangle>& output) const {
+    if (vertices[0]->outside & vertices[1]->outside & vertices[2]->outside) {
+        return;
+    }
+    const std::uint32_t crossed = vertices[0]->outside | vertices[1]->outside | vertices[2]->outside;
+    if (crossed == 0) {
+        AddTriangle(draw, *vertices[0], *vertices[1], *vertices[2], output);
+        return;
+    }
+    
+    // Sutherland-Hodgman against the crossed planes; each plane adds at most one vertex
+    ClipVertex polygons[2][9];
+    int count = 3;
+    int current = 0;
+    for (int i = 0; i < 3; ++i) {
+        polygons[0][i] = *vertices[i];
+    }
+    
+    for (int plane = 0; plane < 6; ++plane) {
+        if (!(crossed & (1u << plane))) {
+            continue;
+        }
+        const ClipVertex* input = polygons[current];
+        ClipVertex* result = polygons[current ^ 1];
+        int resultCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const ClipVertex& a = input[i];
+            const ClipVertex& b = input[(i + 1) % count];
+            const float da = PlaneDistance(a.position, plane);
+            const float db = PlaneDistance(b.position, plane);
+            if (da >= 0.0f) {
+                result[resultCount++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                // Always interpolate from the inside vertex so neighbours sharing the edge agree
+                const ClipVertex& from = (da >= 0.0f) ? a : b;
+                const ClipVertex& to = (da >= 0.0f) ? b : a;
+                const float dFrom = (da >= 0.0f) ? da : db;
+                const float dTo = (da >= 0.0f) ? db : da;
+                const float t = dFrom / (dFrom - dTo);
+                ClipVertex& v = result[resultCount++];
+                for (int k = 0; k < 4; ++k) {
+                    v.position[k] = from.position[k] + (to.position[k] - from.position[k]) * t;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    v.normal[k] = from.normal[k] + (to.normal[k] - from.normal[k]) * t;
+                    v.color[k] = from.color[k] + (to.color[k] - from.color[k]) * t;
+                }
+            }
+        }
+        count = resultCount;
+        current ^= 1;
+        if (count < 3) {
+            return;
+        }
+    }
+    
+    ClipVertex* polygon = polygons[current];
+    for (int i = 0; i < count; ++i) {
+        if (!(polygon[i].position[3] > 0.0f)) {
+            return;
+        }
+        ProjectVertex(draw.viewport, polygon[i]);
+    }
+    for (int i = 1; i + 1 < count; ++i) {
+        AddTriangle(draw, polygon[0], polygon[i], polygon[i + 1], output);
+    }
+}
+
+void SoftwareRasterizer::ProjectVertex(const int viewport[4], ClipVertex& vertex) {
+    vertex.invW = 1.0f / vertex.position[3];
+    const float screenX = viewport[0] + (vertex.position[0] * vertex.invW * 0.5f + 0.5f) * viewport[2];
+    const float screenY = viewport[1] + (0.5f - vertex.position[1] * vertex.invW * 0.5f) * viewport[3];
+    vertex.x = static_cast<std::int32_t>(std::lrint(screenX * kSubpixels));
+    vertex.y = static_cast<std::int32_t>(std::lrint(screenY * kSubpixels));
+}
+
+void SoftwareRasterizer::AddTriangle(const DrawCall& draw, const ClipVertex& v0, const ClipVertex& v1,
+                                     const ClipVertex& v2, std::vector<SetupTriangle>& output) const {
+    const ClipVertex* corners[3] = { &v0, &v1, &v2 };
+    const int* viewport = draw.viewport;
+    const std::int32_t x[3] = { v0.x, v1.x, v2.x };
+    const std::int32_t y[3] = { v0.y, v1.y, v2.y };
+    
+    // Rows grow downwards, so front faces, clockwise in NDC, have a positive area here
+    std::int64_t area = std::int64_t(x[1] - x[0]) * (y[2] - y[0]) - std::int64_t(x[2] - x[0]) * (y[1] - y[0]);
+    if (area == 0 || (area < 0 && draw.cullBackFaces)) {
+        return;
+    }
+    int order[3] = { 0, 1, 2 };
+    if (area < 0) {
+        std::swap(order[1], order[2]);
+        area = -area;
+    }
+    
+    // Pixels whose centers lie within the snapped bounding box, the viewport and the image
+    const std::int32_t minX = std::min({ x[0], x[1], x[2] });
+    const std::int32_t minY = std::min({ y[0], y[1], y[2] });
+    const std::int32_t maxX = std::max({ x[0], x[1], x[2] });
+    const std::int32_t maxY = std::max({ y[0], y[1], y[2] });
+    SetupTriangle triangle;
+    triangle.bounds[0] = std::max((minX + kSubpixels / 2 - 1) >> 4, viewport[0]);
+    triangle.bounds[1] = std::max((minY + kSubpixels / 2 - 1) >> 4, viewport[1]);
+    triangle.bounds[2] = std::min((maxX - kSubpixels / 2) >> 4, std::min(viewport[0] + viewport[2], width_) - 1);
+    triangle.bounds[3] = std::min((maxY - kSubpixels / 2) >> 4, std::min(viewport[1] + viewport[3], height_) - 1);
+    if (triangle.bounds[0] > triangle.bounds[2] || triangle.bounds[1] > triangle.bounds[3]) {
+        return;
+    }
+    
+    for (int i = 0; i < 3; ++i) {
+        triangle.x[i] = x[order[i]];
+        triangle.y[i] = y[order[i]];
+    }
+    
+    float attributes[3][kAttributeCount];
+    for (int i = 0; i < 3; ++i) {
+        const ClipVertex& v = *corners[i];
+        float* a = attributes[i];
+        a[0] = v.position[2] * v.invW * 0.5f + 0.5f;
+        a[1] = v.invW;
+        for (int k = 0; k < 3; ++k) {
+            a[2 + k] = v.normal[k] * v.invW;
+            a[5 + k] = v.color[k] * v.invW;
+        }
+    }
+    
+    // Attribute planes from the snapped positions, so interpolation matches coverage
+    const float x0 = static_cast<float>(triangle.x[0]) / kSubpixels;
+    const float y0 = static_cast<float>(triangle.y[0]) / kSubpixels;
+    const float e1x = static_cast<float>(triangle.x[1] - triangle.x[0]) / kSubpixels;
+    const float e1y = static_cast<float>(triangle.y[1] - triangle.y[0]) / kSubpixels;
+    const float e2x = static_cast<float>(triangle.x[2] - triangle.x[0]) / kSubpixels;
+    const float e2y = static_cast<float>(triangle.y[2] - triangle.y[0]) / kSubpixels;
+    const float invArea = static_cast<float>(kSubpixels * kSubpixels) / static_cast<float>(area);
+    triangle.originX = x0;
+    triangle.originY = y0;
+    for (int k = 0; k < kAttributeCount; ++k) {
+        const float a0 = attributes[order[0]][k];
+        const float d1 = attributes[order[1]][k] - a0;
+        const float d2 = attributes[order[2]][k] - a0;
+        triangle.value[k] = a0;
+        triangle.ddx[k] = (d1 * e2y - d2 * e1y) * invArea;
+        triangle.ddy[k] = (d2 * e1x - d1 * e2x) * invArea;
+    }
+    output.push_back(triangle);
+}
+
+void SoftwareRasterizer::RasterizeTiles() {
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX_) * tilesY_;
+    
+    // Tiles differ a lot in cost, so every participant keeps taking the next unclaimed tile
+    const std::size_t participants = threadPool_ ? threadPool_->GetThreadCount() + 1 : 1;
+    std::vector<std::uint64_t> pixelsWritten(participants, 0);
+    std::atomic<std::size_t> nextTile{0};
+    
+    RunParallel(participants, participants, [&](std::size_t, std::size_t, std::size_t chunk) {
+        std::uint64_t written = 0;
+        for (std::size_t tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            const int tileX = static_cast<int>(tile % tilesX_);
+            const int tileY = static_cast<int>(tile / tilesX_);
+            for (const SetupBatch& batch : batches_) {
+                const SoftwareLighting& lighting = draws_[batch.draw].lighting;
+                for (std::uint32_t i = batch.binOffsets[tile]; i < batch.binOffsets[tile + 1]; ++i) {
+                    written += RasterizeTriangle(batch.triangles[batch.binTriangles[i]], lighting, tileX, tileY);
+                }
+            }
+        }
+        pixelsWritten[chunk] = written;
+    });
+    
+    for (std::uint64_t written : pixelsWritten) {
+        stats_.pixelsWritten += written;
+    }
+}
+
+std::uint64_t SoftwareRasterizer::RasterizeTriangle(const SetupTriangle& triangle, const SoftwareLighting& lighting,
+                                                    int tileX, int tileY) {
+    const int x0 = std::max(triangle.bounds[0], tileX * kTileSize);
+    const int y0 = std::max(triangle.bounds[1], tileY * kTileSize);
+    const int x1 = std::min(triangle.bounds[2], tileX * kTileSize + kTileSize - 1);
+    const int y1 = std::min(triangle.bounds[3], tileY * kTileSize + kTileSize - 1);
+    if (x0 > x1 || y0 > y1) {
+        return 0;
+    }
+    // Columns are walked in aligned groups of four, which never leave the tile
+    const int startX = x0 & ~3;
+    
+    // Edge functions at the center of pixel (startX, y0), non-negative inside. Pixel centers on
+    // an edge belong to the triangle only for top and left edges, so shared edges are drawn once.
+    std::int32_t edge[3];
+    std::int32_t stepX[3];
+    std::int32_t stepY[3];
+    for (int e = 0; e < 3; ++e) {
+        const int a = e;
+        const int b = (e + 1) % 3;
+        const std::int64_t dx = triangle.x[b] - triangle.x[a];
+        const std::int64_t dy = triangle.y[b] - triangle.y[a];
+        const bool topLeft = (dy == 0 && dx > 0) || dy < 0;
+        const std::int64_t value = dx * (std::int64_t(y0) * kSubpixels + kSubpixels / 2 - triangle.y[a])
+                                 - dy * (std::int64_t(startX) * kSubpixels + kSubpixels / 2 - triangle.x[a])
+                                 - (topLeft ? 0 : 1);
+        stepX[e] = static_cast<std::int32_t>(-dy * kSubpixels);
+        stepY[e] = static_cast<std::int32_t>(dx * kSubpixels);
+        
+        const std::int64_t maxValue = value + std::int64_t(std::max(stepX[e], 0)) * (x1 - startX)
+                                            + std::int64_t(std::max(stepY[e], 0)) * (y1 - y0);
+        if (maxValue < 0) {
+            return 0;
+        }
+        edge[e] = static_cast<std::int32_t>(std::min(std::max(value, -kEdgeClamp), kEdgeClamp));
+    }
+    
+    const float lightX = -lighting.lightDirection.x;
+    const float lightY = -lighting.lightDirection.y;
+    const float lightZ = -lighting.lightDirection.z;
+    const float* diffuse = &lighting.lightColor.x;
+    const float* ambient = &lighting.ambientColor.x;
+    const float offsetX = static_cast<float>(startX) + 0.5f - triangle.originX;
+    std::uint64_t written = 0;
+
+#if defined(SOFTWARE_RASTERIZER_SSE2)
+    const __m128i edgeStep0 = _mm_set1_epi32(stepX[0] * 4);
+    const __m128i edgeStep1 = _mm_set1_epi32(stepX[1] * 4);
+    const __m128i edgeStep2 = _mm_set1_epi32(stepX[2] * 4);
+    const __m128i firstColumn = _mm_set1_epi32(x0 - 1);
+    const __m128i lastColumn = _mm_set1_epi32(x1 + 1);
+    __m128 steps[kAttributeCount];
+    for (int k = 0; k < kAttributeCount; ++k) {
+        steps[k] = _mm_set1_ps(triangle.ddx[k]);
+    }
+#endif
+
+    for (int y = y0; y <= y1; ++y) {
+        const std::int32_t rowEdge[3] = {
+            edge[0] + stepY[0] * (y - y0),
+            edge[1] + stepY[1] * (y - y0),
+            edge[2] + stepY[2] * (y - y0)
+        };
+        const float offsetY = static_cast<float>(y) + 0.5f - triangle.originY;
+        float rowValue[kAttributeCount];
+        for (int k = 0; k < kAttributeCount; ++k) {
+            rowValue[k] = triangle.value[k] + triangle.ddx[k] * offsetX + triangle.ddy[k] * offsetY;
+        }
+        std::uint32_t* colorRow = &color_[static_cast<std::size_t>(y) * stride_];
+        float* depthRow = &depth_[static_cast<std::size_t>(y) * stride_];
+
+#if defined(SOFTWARE_RASTERIZER_SSE2)
+        __m128i edge0 = _mm_setr_epi32(rowEdge[0], rowEdge[0] + stepX[0], rowEdge[0] + stepX[0] * 2, rowEdge[0] + stepX[0] * 3);
+        __m128i edge1 = _mm_setr_epi32(rowEdge[1], rowEdge[1] + stepX[1], rowEdge[1] + stepX[1] * 2, rowEdge[1] + stepX[1] * 3);
+        __m128i edge2 = _mm_setr_epi32(rowEdge[2], rowEdge[2] + stepX[2], rowEdge[2] + stepX[2] * 2, rowEdge[2] + stepX[2] * 3);
+        __m128i columns = _mm_setr_epi32(startX, startX + 1, startX + 2, startX + 3);
+        __m128 offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        auto attribute = [&](int k, __m128 offset) {
+            return _mm_add_ps(_mm_set1_ps(rowValue[k]), _mm_mul_ps(steps[k], offset));
+        };
+        
+        for (int x = startX; x <= x1; x += 4) {
+            const __m128i e0 = edge0;
+            const __m128i e1 = edge1;
+            const __m128i e2 = edge2;
+            const __m128i column = columns;
+            const __m128 offset = offsets;
+            edge0 = _mm_add_epi32(edge0, edgeStep0);
+            edge1 = _mm_add_epi32(edge1, edgeStep1);
+            edge2 = _mm_add_epi32(edge2, edgeStep2);
+            columns = _mm_add_epi32(columns, _mm_set1_epi32(4));
+            offsets = _mm_add_ps(offsets, _mm_set1_ps(4.0f));
+            
+            // A pixel is covered if no edge function is negative, i.e. no sign bit is set
+            const __m128i outside = _mm_srai_epi32(_mm_or_si128(_mm_or_si128(e0, e1), e2), 31);
+            const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(column, firstColumn), _mm_cmplt_epi32(column, lastColumn));
+            const __m128i covered = _mm_andnot_si128(outside, inRange);
+            if (_mm_movemask_epi8(covered) == 0) {
+                continue;
+            }
+            
+            const __m128 z = attribute(0, offset);
+            const __m128 oldDepth = _mm_loadu_ps(depthRow + x);
+            const __m128 pass = _mm_and_ps(_mm_castsi128_ps(covered), _mm_cmplt_ps(z, oldDepth));
+            const int passMask = _mm_movemask_ps(pass);
+            if (passMask == 0) {
+                continue;
+            }
+            _mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, oldDepth)));
+            
+            // Perspective-correct attributes and the default fragment shader
+            const __m128 w = _mm_div_ps(_mm_set1_ps(1.0f), attribute(1, offset));
+            const __m128 nx = _mm_mul_ps(attribute(2, offset), w);
+            const __m128 ny = _mm_mul_ps(attribute(3, offset), w);
+            const __m128 nz = _mm_mul_ps(attribute(4, offset), w);
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz));
+            const __m128 length = _mm_sqrt_ps(_mm_max_ps(lengthSq, _mm_set1_ps(1e-30f)));
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_set1_ps(lightX)), _mm_mul_ps(ny, _mm_set1_ps(lightY))),
+                                          _mm_mul_ps(nz, _mm_set1_ps(lightZ)));
+            const __m128 nDotL = _mm_max_ps(_mm_div_ps(dot, length), _mm_setzero_ps());
+            
+            __m128i channels[3];
+            for (int c = 0; c < 3; ++c) {
+                const __m128 light = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(diffuse[c]), nDotL), _mm_set1_ps(ambient[c]));
+                const __m128 value = _mm_mul_ps(light, _mm_mul_ps(attribute(5 + c, offset), w));
+                const __m128 clamped = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+                channels[c] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+            }
+            const __m128i packed = _mm_or_si128(_mm_or_si128(channels[0], _mm_slli_epi32(channels[1], 8)),
+                                                _mm_or_si128(_mm_slli_epi32(channels[2], 16), _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+            
+            const __m128i passBits = _mm_castps_si128(pass);
+            __m128i* colorPtr = reinterpret_cast<__m128i*>(colorRow + x);
+            const __m128i oldColor = _mm_loadu_si128(colorPtr);
+            _mm_storeu_si128(colorPtr, _mm_or_si128(_mm_and_si128(passBits, packed), _mm_andnot_si128(passBits, oldColor)));
+            
+            written += (passMask & 1) + ((passMask >> 1) & 1) + ((passMask >> 2) & 1) + ((passMask >> 3) & 1);
+        }
+#else
+        for (int x = x0; x <= x1; ++x) {
+            const std::int32_t column = x - startX;
+            if (((rowEdge[0] + stepX[0] * column) | (rowEdge[1] + stepX[1] * column) | (rowEdge[2] + stepX[2] * column)) < 0) {
+                continue;
+            }
+            
+            float value[kAttributeCount];
+            for (int k = 0; k < kAttributeCount; ++k) {
+                value[k] = rowValue[k] + triangle.ddx[k] * static_cast<float>(column);
+            }
+            if (!(value[0] < depthRow[x])) {
+                continue;
+            }
+            depthRow[x] = value[0];
+            
+            // Perspective-correct attributes and the default fragment shader
+            const float w = 1.0f / value[1];
+            const float nx = value[2] * w;
+            const float ny = value[3] * w;
+            const float nz = value[4] * w;
+            const float length = std::sqrt(std::max(nx * nx + ny * ny + nz * nz, 1e-30f));
+            const float nDotL = std::max((nx * lightX + ny * lightY + nz * lightZ) / length, 0.0f);
+            float color[3];
+            for (int c = 0; c < 3; ++c) {
+                color[c] = (diffuse[c] * nDotL + ambient[c]) * (value[5 + c] * w);
+            }
+            colorRow[x] = PackColor(color[0], color[1], color[2], 1.0f);
+            ++written;
+        }
+#endif
+    }
+    return written;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,132 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of ThreadPool class
+ */
+
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+namespace RenderingPlugin {
+
+// === ThreadPool Implementation ===
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : activeTasks_(0)
+    , stopping_(false) {
+    
+    if (threadCount == 0) {
+        threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    taskCondition_.notify_all();
+    
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::size_t ThreadPool::GetThreadCount() const {
+    return workers_.size();
+}
+
+void ThreadPool::ParallelFor(std::size_t count,
+                             const std::function<void(std::size_t, std::size_t, std::size_t)>& func,
+                             std::size_t chunkCount) {
+    if (count == 0) {
+        return;
+    }
+    
+    if (chunkCount == 0) {
+        chunkCount = workers_.size();
+    }
+    chunkCount = std::min(chunkCount, count);
+    
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunkCount);
+    
+    for (std::size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = std::min(count, begin + chunkSize);
+        if (begin >= end) {
+            break;
+        }
+        pending.push_back(Enqueue([&func, begin, end, chunk]() { func(begin, end, chunk); }));
+    }
+    
+    // The calling thread takes the first chunk instead of idling
+    std::exception_ptr error;
+    try {
+        func(0, std::min(count, chunkSize), 0);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    
+    // Always wait for every chunk, the tasks reference func
+    for (std::future<void>& result : pending) {
+        try {
+            result.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCondition_.wait(lock, [this]() { return tasks_.empty() && activeTasks_ == 0; });
+}
+
+// === Private Methods ===
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskCondition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            
+            task = std::move(tasks_.front());
+            tasks_.pop();
+            activeTasks_++;
+        }
+        
+        task();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            activeTasks_--;
+            if (tasks_.empty() && activeTasks_ == 0) {
+                idleCondition_.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,240 @@
+/**
+ * @file UploadAllocator.cpp
+ * @brief Implementation of UploadAllocator class
+ */
+
+#include "../include/UploadAllocator.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace RenderingPlugin {
+
+namespace {
+
+std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// === UploadAllocator Implementation ===
+
+UploadAllocator::UploadAllocator(LLGL::RenderSystem* renderSystem, std::uint64_t capacityPerFrame,
+                                 std::uint32_t framesInFlight, long bindFlags)
+    : renderSystem_(renderSystem)
+    , capacity_(capacityPerFrame)
+    , alignment_(256)
+    , frameIndex_(0)
+    , cursor_(0)
+    , flushedBytes_(0) {
+    
+    if (!renderSystem_) {
+        throw std::invalid_argument("RenderSystem cannot be null");
+    }
+    
+    if (capacity_ == 0 || framesInFlight == 0) {
+        throw std::invalid_argument("UploadAllocator needs a non-zero capacity and frame count");
+    }
+    
+    const std::uint64_t constantBufferAlignment = renderSystem_->GetRenderingCaps().limits.minConstantBufferAlignment;
+    if (constantBufferAlignment > 0) {
+        alignment_ = constantBufferAlignment;
+    }
+    
+    frames_.resize(framesInFlight);
+    for (FrameBuffer& frame : frames_) {
+        LLGL::BufferDescriptor bufferDesc;
+        bufferDesc.size = capacity_;
+        bufferDesc.bindFlags = bindFlags;
+        bufferDesc.cpuAccessFlags = LLGL::CPUAccessFlags::Write;
+        bufferDesc.miscFlags = LLGL::MiscFlags::DynamicUsage;
+        
+        frame.buffer = renderSystem_->CreateBuffer(bufferDesc);
+        if (!frame.buffer) {
+            for (FrameBuffer& created : frames_) {
+                if (created.buffer) {
+                    renderSystem_->Release(*created.buffer);
+                }
+            }
+            frames_.clear();
+            throw std::runtime_error("Failed to create upload buffer");
+        }
+        frame.staging.resize(static_cast<std::size_t>(capacity_));
+    }
+    
+    std::cout << "UploadAllocator initialized (" << framesInFlight << " x " << capacity_ << " bytes, alignment "
+              << alignment_ << ")" << std::endl;
+}
+
+UploadAllocator::~UploadAllocator() {
+    for (FrameBuffer& frame : frames_) {
+        for (auto& entry : frame.blockHeaps) {
+            renderSystem_->Release(*entry.second);
+        }
+        if (frame.buffer) {
+            renderSystem_->Release(*frame.buffer);
+        }
+    }
+    frames_.clear();
+    
+    std::cout << "UploadAllocator destroyed" << std::endl;
+}
+
+void UploadAllocator::BeginFrame(std::uint32_t frameIndex) {
+    frameIndex_ = frameIndex % static_cast<std::uint32_t>(frames_.size());
+    cursor_ = 0;
+    flushedBytes_ = 0;
+    stats_ = UploadAllocatorStats();
+}
+
+UploadAllocation UploadAllocator::Allocate(std::uint64_t size, std::uint64_t alignment) {
+    UploadAllocation allocation;
+    
+    if (size == 0) {
+        return allocation;
+    }
+    
+    if (alignment == 0) {
+        alignment = alignment_;
+    }
+    
+    const std::uint64_t offset = AlignUp(cursor_, alignment);
+    if (offset + size > capacity_) {
+        stats_.failedAllocations++;
+        std::cerr << "Upload allocator out of memory (" << size << " bytes requested, "
+                  << (capacity_ - std::min(capacity_, offset)) << " available)" << std::endl;
+        return allocation;
+    }
+    
+    FrameBuffer& frame = frames_[frameIndex_];
+    allocation.buffer = frame.buffer;
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.data = frame.staging.data() + offset;
+    
+    stats_.allocations++;
+    stats_.bytesAllocated += size;
+    stats_.bytesPadding += offset - cursor_;
+    
+    cursor_ = offset + size;
+    return allocation;
+}
+
+UploadAllocation UploadAllocator::Upload(const void* data, std::uint64_t size, std::uint64_t alignment) {
+    UploadAllocation allocation = Allocate(size, alignment);
+    if (allocation.IsValid() && data) {
+        std::memcpy(allocation.data, data, static_cast<std::size_t>(size));
+    }
+    return allocation;
+}
+
+void UploadAllocator::Flush() {
+    if (cursor_ <= flushedBytes_) {
+        return;
+    }
+    
+    FrameBuffer& frame = frames_[frameIndex_];
+    
+    try {
+        // Everything allocated since the last flush is contiguous, so one write covers it
+        renderSystem_->WriteBuffer(*frame.buffer, flushedBytes_, frame.staging.data() + flushedBytes_,
+                                   cursor_ - flushedBytes_);
+        
+        stats_.bytesFlushed += cursor_ - flushedBytes_;
+        stats_.bufferWrites++;
+        flushedBytes_ = cursor_;
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Exception flushing upload buffer: " << e.what() << std::endl;
+    }
+}
+
+bool UploadAllocator::SupportsBlockBinding(const std::string& rendererName) {
+    return rendererName.find("OpenGL") != std::string::npos ||
+           rendererName.find("WebGL") != std::string::npos ||
+           rendererName.find("Direct3D 11") != std::string::npos ||
+           rendererName == "Null";
+}
+
+bool UploadAllocator::SupportsBlockBinding() const {
+    return SupportsBlockBinding(renderSystem_->GetRendererInfo().rendererName);
+}
+
+LLGL::ResourceHeap* UploadAllocator::GetBlockHeap(LLGL::PipelineLayout* pipelineLayout, std::uint64_t blockSize) {
+    if (!pipelineLayout || blockSize == 0) {
+        std::cerr << "Invalid block heap parameters" << std::endl;
+        return nullptr;
+    }
+    
+    FrameBuffer& frame = frames_[frameIndex_];
+    const auto key = std::make_pair(pipelineLayout, blockSize);
+    
+    auto it = frame.blockHeaps.find(key);
+    if (it != frame.blockHeaps.end()) {
+        return it->second;
+    }
+    
+    try {
+        const std::uint64_t stride = GetBlockStride(blockSize);
+        const std::uint64_t blockCount = capacity_ / stride;
+        
+        // One descriptor set per block, each viewing the buffer at a different offset
+        std::vector<LLGL::ResourceViewDescriptor> resourceViews;
+        resourceViews.reserve(static_cast<std::size_t>(blockCount));
+        for (std::uint64_t block = 0; block < blockCount; ++block) {
+            LLGL::BufferViewDescriptor bufferView;
+            bufferView.offset = block * stride;
+            bufferView.size = blockSize;
+            resourceViews.emplace_back(frame.buffer, bufferView);
+        }
+        
+        LLGL::ResourceHeapDescriptor heapDesc;
+        heapDesc.pipelineLayout = pipelineLayout;
+        heapDesc.numResourceViews = static_cast<std::uint32_t>(blockCount);
+        
+        LLGL::ResourceHeap* heap = renderSystem_->CreateResourceHeap(heapDesc, resourceViews);
+        if (!heap) {
+            std::cerr << "Failed to create upload block heap" << std::endl;
+            return nullptr;
+        }
+        
+        frame.blockHeaps[key] = heap;
+        return heap;
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Exception creating upload block heap: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+std::uint64_t UploadAllocator::GetBlockStride(std::uint64_t blockSize) const {
+    return AlignUp(blockSize, alignment_);
+}
+
+std::uint32_t UploadAllocator::GetBlockIndex(const UploadAllocation& allocation, std::uint64_t blockSize) const {
+    return static_cast<std::uint32_t>(allocation.offset / GetBlockStride(blockSize));
+}
+
+LLGL::Buffer* UploadAllocator::GetBuffer() const {
+    return frames_.empty() ? nullptr : frames_[frameIndex_].buffer;
+}
+
+std::uint64_t UploadAllocator::GetCapacity() const {
+    return capacity_;
+}
+
+std::uint64_t UploadAllocator::GetUsedBytes() const {
+    return cursor_;
+}
+
+std::uint64_t UploadAllocator::GetAlignment() const {
+    return alignment_;
+}
+
+const UploadAllocatorStats& UploadAllocator::GetStatistics() const {
+    return stats_;
+}
+
+} // namespace RenderingPlugin
@@ -0,0 +1,2153 @@
+/**
+ * @file rendering_components_test.cpp
+ * @brief Unit tests for the CPU-side RenderingPlugin components
+ */
+
+#include <gtest/gtest.h>
+#include "AsyncResourceLoader.h"
+#include "BatchRenderer.h"
+#include "DrawBindState.h"
+#include "FrameReadback.h"
+#include "FrameRing.h"
+#include "GeometryCache.h"
+#include "GeometryGenerator.h"
+#include "HandlePool.h"
+#include "LodChain.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+#include "QuantizedMesh.h"
+#include "RenderGraph.h"
+#include "RenderQueue.h"
+#include "SceneStore.h"
+#include "ShaderDiskCache.h"
+#include "ShaderFileWatcher.h"
+#include "ShaderHash.h"
+#include "ShaderIncludeCache.h"
+#include "ShaderManager.h"
+#include "ShaderVariants.h"
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+#include "UploadAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace RenderingPlugin;
+
+namespace {
+
+// Non-null placeholders; the queue only compares these pointers when sorting
+LLGL::PipelineState* FakePipeline(std::uintptr_t value) {
+    return reinterpret_cast<LLGL::PipelineState*>(value * 16);
+}
+
+LLGL::Buffer* FakeBuffer(std::uintptr_t value) {
+    return reinterpret_cast<LLGL::Buffer*>(value * 16);
+}
+
+LLGL::ResourceHeap* FakeHeap(std::uintptr_t value) {
+    return reinterpret_cast<LLGL::ResourceHeap*>(value * 16);
+}
+
+} // namespace
+
+// === RenderQueue Tests ===
+
+TEST(RenderQueueTest, SortKeyFieldOrder) {
+    // Layer dominates pipeline, pipeline dominates material, material dominates depth
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 0xFFFF, 0xFFFF, 1.0f), RenderQueue::MakeSortKey(1, 0, 0, 0.0f));
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 1, 0xFFFF, 1.0f), RenderQueue::MakeSortKey(0, 2, 0, 0.0f));
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 1, 1, 1.0f), RenderQueue::MakeSortKey(0, 1, 2, 0.0f));
+    EXPECT_LT(RenderQueue::MakeSortKey(0, 1, 1, 0.25f), RenderQueue::MakeSortKey(0, 1, 1, 0.5f));
+    EXPECT_GT(RenderQueue::MakeSortKey(0, 1, 1, 0.25f, true), RenderQueue::MakeSortKey(0, 1, 1, 0.5f, true));
+}
+
+TEST(RenderQueueTest, RadixSortMatchesStableSort) {
+    RenderQueue queue;
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys;
+
+    for (int i = 0; i < 5000; ++i) {
+        DrawPacket packet;
+        packet.pipelineState = FakePipeline(1 + rng() % 4);
+        packet.vertexBuffer = FakeBuffer(1 + rng() % 8);
+        packet.sortKey = RenderQueue::MakeSortKey(static_cast<std::uint8_t>(rng() % 3),
+                                                  static_cast<std::uint16_t>(rng() % 4),
+                                                  static_cast<std::uint16_t>(rng() % 16),
+                                                  static_cast<float>(rng() % 1000) / 1000.0f);
+        keys.push_back(packet.sortKey);
+        queue.Submit(packet);
+    }
+
+    std::vector<std::uint32_t> expected(keys.size());
+    for (std::uint32_t i = 0; i < expected.size(); ++i) {
+        expected[i] = i;
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&keys](std::uint32_t a, std::uint32_t b) {
+        return keys[a] < keys[b];
+    });
+
+    EXPECT_EQ(expected, queue.Sort());
+}
+
+TEST(RenderQueueTest, IdenticalKeysKeepSubmissionOrder) {
+    RenderQueue queue;
+    for (int i = 0; i < 10; ++i) {
+        DrawPacket packet;
+        packet.pipelineState = FakePipeline(1);
+        packet.vertexBuffer = FakeBuffer(1);
+        packet.sortKey = RenderQueue::MakeSortKey(1, 2, 3, 0.5f);
+        queue.Submit(packet);
+    }
+
+    const std::vector<std::uint32_t>& order = queue.Sort();
+    ASSERT_EQ(10u, order.size());
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+TEST(RenderQueueTest, RejectsIncompletePackets) {
+    RenderQueue queue;
+    DrawPacket packet;
+    queue.Submit(packet);
+    EXPECT_EQ(0u, queue.GetPacketCount());
+}
+
+// === ThreadPool Tests ===
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10007);
+    for (auto& visit : visits) {
+        visit = 0;
+    }
+
+    pool.ParallelFor(visits.size(), [&visits](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            visits[i]++;
+        }
+    });
+
+    for (const auto& visit : visits) {
+        ASSERT_EQ(1, visit.load());
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForChunksAreDeterministic) {
+    ThreadPool pool(4);
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(4);
+
+    pool.ParallelFor(1000, [&ranges](std::size_t begin, std::size_t end, std::size_t chunk) {
+        ranges[chunk] = { begin, end };
+    }, 4);
+
+    const std::vector<std::pair<std::size_t, std::size_t>> expected = {
+        { 0, 250 }, { 250, 500 }, { 500, 750 }, { 750, 1000 }
+    };
+    EXPECT_EQ(expected, ranges);
+}
+
+TEST(ThreadPoolTest, EnqueueReturnsResult) {
+    ThreadPool pool(2);
+    std::future<int> result = pool.Enqueue([]() { return 42; });
+    EXPECT_EQ(42, result.get());
+}
+
+// === HandlePool Tests ===
+
+TEST(HandlePoolTest, InsertAndLookup) {
+    HandlePool<int> pool(1);
+    const std::uint32_t a = pool.Insert(10);
+    const std::uint32_t b = pool.Insert(20);
+
+    ASSERT_NE(0u, a);
+    ASSERT_NE(a, b);
+    ASSERT_NE(nullptr, pool.Get(a));
+    EXPECT_EQ(10, *pool.Get(a));
+    EXPECT_EQ(20, *pool.Get(b));
+    EXPECT_EQ(2u, pool.Size());
+}
+
+TEST(HandlePoolTest, StaleHandleIsRejected) {
+    HandlePool<int> pool(1);
+    const std::uint32_t stale = pool.Insert(10);
+    ASSERT_TRUE(pool.Erase(stale));
+
+    // The slot is reused with a new generation
+    const std::uint32_t fresh = pool.Insert(30);
+    EXPECT_NE(stale, fresh);
+    EXPECT_EQ(nullptr, pool.Get(stale));
+    EXPECT_FALSE(pool.Erase(stale));
+    EXPECT_EQ(30, *pool.Get(fresh));
+}
+
+TEST(HandlePoolTest, ForeignTypeTagIsRejected) {
+    HandlePool<int> buffers(1);
+    HandlePool<int> textures(2);
+    const std::uint32_t buffer = buffers.Insert(1);
+    textures.Insert(2);
+
+    EXPECT_EQ(nullptr, textures.Get(buffer));
+    EXPECT_EQ(1u, HandlePool<int>::GetTypeTag(buffer));
+}
+
+TEST(HandlePoolTest, EraseKeepsRemainingValuesReachable) {
+    HandlePool<int> pool(3);
+    std::vector<std::uint32_t> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(pool.Insert(i));
+    }
+    for (int i = 0; i < 100; i += 3) {
+        int removed = -1;
+        ASSERT_TRUE(pool.Erase(handles[i], &removed));
+        EXPECT_EQ(i, removed);
+    }
+
+    int visited = 0;
+    pool.ForEach([&visited](std::uint32_t, int) { visited++; });
+    EXPECT_EQ(static_cast<int>(pool.Size()), visited);
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_EQ(nullptr, pool.Get(handles[i]));
+        } else {
+            ASSERT_NE(nullptr, pool.Get(handles[i]));
+            EXPECT_EQ(i, *pool.Get(handles[i]));
+        }
+    }
+}
+
+// === SceneStore Tests ===
+
+namespace {
+
+Gs::Matrix4f Translation(float x, float y, float z) {
+    Gs::Matrix4f matrix;
+    matrix.LoadIdentity();
+    matrix.At(0, 3) = x;
+    matrix.At(1, 3) = y;
+    matrix.At(2, 3) = z;
+    return matrix;
+}
+
+Gs::Matrix4f Identity() {
+    return Translation(0.0f, 0.0f, 0.0f);
+}
+
+} // namespace
+
+TEST(SceneStoreTest, CullsAgainstClipVolume) {
+    // Identity camera: the visible volume is the [-1, 1] cube
+    SceneStore scene;
+    const ResourceId inside = scene.AddObject(MeshDraw(), Identity(), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f);
+    const ResourceId outside = scene.AddObject(MeshDraw(), Translation(5.0f, 0.0f, 0.0f), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f);
+    const ResourceId straddling = scene.AddObject(MeshDraw(), Translation(1.2f, 0.0f, 0.0f), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f);
+
+    const std::vector<std::uint32_t>& drawList = scene.Cull();
+    EXPECT_EQ(2u, drawList.size());
+    EXPECT_TRUE(scene.IsVisible(inside));
+    EXPECT_FALSE(scene.IsVisible(outside));
+    EXPECT_TRUE(scene.IsVisible(straddling));
+
+    // Moving the object updates its world bounds
+    ASSERT_TRUE(scene.SetTransform(outside, Translation(0.0f, 0.5f, 0.0f)));
+    scene.Cull();
+    EXPECT_TRUE(scene.IsVisible(outside));
+    EXPECT_EQ(3u, scene.GetStatistics().visibleCount);
+}
+
+TEST(SceneStoreTest, DisabledObjectsAreCulled) {
+    SceneStore scene;
+    const ResourceId objectId = scene.AddObject(MeshDraw(), Identity(), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f);
+
+    ASSERT_TRUE(scene.SetEnabled(objectId, false));
+    EXPECT_TRUE(scene.Cull().empty());
+
+    ASSERT_TRUE(scene.SetEnabled(objectId, true));
+    EXPECT_EQ(1u, scene.Cull().size());
+}
+
+TEST(SceneStoreTest, DrawListSortsByDrawKey) {
+    SceneStore scene;
+    for (std::uint64_t key : {30u, 10u, 20u}) {
+        MeshDraw draw;
+        draw.indexCount = static_cast<std::uint32_t>(key);
+        scene.AddObject(draw, Identity(), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f, key);
+    }
+
+    const std::vector<std::uint32_t>& drawList = scene.Cull(true);
+    ASSERT_EQ(3u, drawList.size());
+    EXPECT_EQ(10u, scene.GetDraw(drawList[0]).indexCount);
+    EXPECT_EQ(20u, scene.GetDraw(drawList[1]).indexCount);
+    EXPECT_EQ(30u, scene.GetDraw(drawList[2]).indexCount);
+}
+
+TEST(SceneStoreTest, RemovalKeepsOtherHandlesValid) {
+    SceneStore scene;
+    const ResourceId first = scene.AddObject(MeshDraw(), Identity(), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f);
+    const ResourceId second = scene.AddObject(MeshDraw(), Translation(5.0f, 0.0f, 0.0f), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f);
+
+    ASSERT_TRUE(scene.RemoveObject(first));
+    EXPECT_FALSE(scene.RemoveObject(first));
+    EXPECT_FALSE(scene.SetEnabled(first, true));
+    EXPECT_EQ(1u, scene.GetObjectCount());
+
+    // The remaining object was moved into the freed slot but keeps its handle and bounds
+    scene.Cull();
+    EXPECT_FALSE(scene.IsVisible(second));
+    ASSERT_TRUE(scene.SetTransform(second, Identity()));
+    scene.Cull();
+    EXPECT_TRUE(scene.IsVisible(second));
+}
+
+TEST(SceneStoreTest, DirtyRangeCoversChangedIndices) {
+    SceneStore scene;
+    std::vector<ResourceId> objects;
+    for (int i = 0; i < 4; ++i) {
+        objects.push_back(scene.AddObject(MeshDraw(), Identity(), Gs::Vector3f(0.0f, 0.0f, 0.0f), 0.5f));
+    }
+
+    std::uint32_t begin = 0;
+    std::uint32_t end = 0;
+    ASSERT_TRUE(scene.TakeDirtyRange(begin, end));
+    EXPECT_EQ(0u, begin);
+    EXPECT_EQ(4u, end);
+    EXPECT_FALSE(scene.TakeDirtyRange(begin, end));
+
+    // Culling does not change what a GPU copy holds
+    scene.Cull();
+    EXPECT_FALSE(scene.TakeDirtyRange(begin, end));
+
+    ASSERT_TRUE(scene.SetTransform(objects[2], Translation(1.0f, 0.0f, 0.0f)));
+    ASSERT_TRUE(scene.TakeDirtyRange(begin, end));
+    EXPECT_EQ(2u, begin);
+    EXPECT_EQ(3u, end);
+
+    // Removal moves the last object into the hole and drops the last index
+    ASSERT_TRUE(scene.RemoveObject(objects[1]));
+    ASSERT_TRUE(scene.TakeDirtyRange(begin, end));
+    EXPECT_EQ(1u, begin);
+    EXPECT_EQ(4u, end);
+    EXPECT_EQ(3u, scene.GetObjectCount());
+
+    Gs::Vector3f center;
+    float radius = 0.0f;
+    scene.GetWorldBounds(2, center, radius);
+    EXPECT_FLOAT_EQ(1.0f, center.x);
+    EXPECT_FLOAT_EQ(0.5f, radius);
+
+    ASSERT_TRUE(scene.SetEnabled(objects[0], false));
+    scene.Clear();
+    ASSERT_TRUE(scene.TakeDirtyRange(begin, end));
+    EXPECT_EQ(0u, begin);
+    EXPECT_EQ(3u, end);
+}
+
+// === MeshFile Tests ===
+
+namespace {
+
+MeshData MakeTestMesh(std::uint32_t quadCount) {
+    MeshData mesh;
+    for (std::uint32_t i = 0; i < quadCount; ++i) {
+        const float x = static_cast<float>(i);
+        const std::uint32_t base = static_cast<std::uint32_t>(mesh.vertices.size());
+        mesh.vertices.push_back(Vertex(Gs::Vector3f(x, 0.0f, 0.0f)));
+        mesh.vertices.push_back(Vertex(Gs::Vector3f(x + 1.0f, 0.0f, 0.0f)));
+        mesh.vertices.push_back(Vertex(Gs::Vector3f(x + 1.0f, 1.0f, -2.0f)));
+        mesh.vertices.push_back(Vertex(Gs::Vector3f(x, 1.0f, -2.0f)));
+        for (std::uint32_t index : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+            mesh.indices.push_back(base + index);
+        }
+    }
+    return mesh;
+}
+
+} // namespace
+
+TEST(MeshFileTest, RoundTripThroughMapping) {
+    const std::string filename = testing::TempDir() + "mesh_file_round_trip.psmf";
+    const MeshData mesh = MakeTestMesh(4);
+    ASSERT_TRUE(MeshFile::Write(filename, mesh));
+
+    MeshFile file;
+    ASSERT_TRUE(file.Open(filename));
+    EXPECT_EQ(mesh.vertices.size(), file.GetHeader().vertexCount);
+    EXPECT_EQ(mesh.indices.size(), file.GetHeader().indexCount);
+    EXPECT_EQ(LLGL::Format::R16UInt, file.GetIndexFormat());
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(file.GetVertexData()) % kMeshFileBlobAlignment);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(file.GetIndexData()) % kMeshFileBlobAlignment);
+
+    Gs::Vector3f minBounds, maxBounds;
+    file.GetBounds(minBounds, maxBounds);
+    EXPECT_FLOAT_EQ(0.0f, minBounds.x);
+    EXPECT_FLOAT_EQ(-2.0f, minBounds.z);
+    EXPECT_FLOAT_EQ(4.0f, maxBounds.x);
+    EXPECT_FLOAT_EQ(1.0f, maxBounds.y);
+
+    MeshData loaded;
+    ASSERT_TRUE(file.ToMeshData(loaded));
+    ASSERT_EQ(mesh.vertices.size(), loaded.vertices.size());
+    EXPECT_EQ(mesh.indices, loaded.indices);
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+        EXPECT_FLOAT_EQ(mesh.vertices[i].position.x, loaded.vertices[i].position.x);
+        EXPECT_FLOAT_EQ(mesh.vertices[i].position.y, loaded.vertices[i].position.y);
+    }
+
+    file.Close();
+    std::remove(filename.c_str());
+}
+
+TEST(MeshFileTest, RejectsTruncatedFile) {
+    const std::string filename = testing::TempDir() + "mesh_file_truncated.psmf";
+    ASSERT_TRUE(MeshFile::Write(filename, MakeTestMesh(64)));
+
+    // Cut the file in the middle of the vertex blob
+    std::vector<char> contents;
+    {
+        std::ifstream input(filename, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+        output.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+    }
+
+    MeshFile file;
+    EXPECT_FALSE(file.Open(filename));
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_EQ(nullptr, file.GetVertexData());
+
+    std::remove(filename.c_str());
+}
+
+// === GeometryCache Tests ===
+
+TEST(GeometryCacheTest, IdenticalKeysShareMesh) {
+    GeometryCache cache;
+    std::shared_ptr<const MeshData> first = cache.GetMesh(GeometryKey::Sphere(1.0f, 16, 8));
+    std::shared_ptr<const MeshData> second = cache.GetMesh(GeometryKey::Sphere(1.0f, 16, 8));
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(first.get(), second.get());
+
+    const MeshData generated = GeometryGenerator::GenerateSphere(1.0f, 16, 8);
+    EXPECT_EQ(generated.GetVertexCount(), first->GetVertexCount());
+    EXPECT_EQ(generated.indices, first->indices);
+
+    const GeometryCacheStats stats = cache.GetStatistics();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.entryCount);
+}
+
+TEST(GeometryCacheTest, ParametersArePartOfTheKey) {
+    GeometryParams flipped;
+    flipped.flipWindingOrder = true;
+
+    GeometryCache cache;
+    std::shared_ptr<const MeshData> sphere = cache.GetMesh(GeometryKey::Sphere(1.0f, 16, 8));
+    EXPECT_NE(sphere.get(), cache.GetMesh(GeometryKey::Sphere(1.0f, 16, 8, flipped)).get());
+    EXPECT_NE(sphere.get(), cache.GetMesh(GeometryKey::Sphere(2.0f, 16, 8)).get());
+    EXPECT_NE(sphere.get(), cache.GetMesh(GeometryKey::UVSphere(1.0f, 16, 8)).get());
+    EXPECT_EQ(4u, cache.GetStatistics().misses);
+    EXPECT_EQ(0u, cache.GetStatistics().hits);
+}
+
+TEST(GeometryCacheTest, EvictsLeastRecentlyUsed) {
+    const GeometryKey a = GeometryKey::Plane(1.0f, 1.0f, 8, 8);
+    const GeometryKey b = GeometryKey::Plane(2.0f, 1.0f, 8, 8);
+    const GeometryKey c = GeometryKey::Plane(3.0f, 1.0f, 8, 8);
+
+    // Room for exactly two planes
+    const MeshData plane = GeometryCache::Generate(a);
+    const std::size_t planeSize = plane.vertices.size() * sizeof(Vertex) + plane.indices.size() * sizeof(std::uint32_t);
+    GeometryCache cache(nullptr, planeSize * 2);
+
+    std::shared_ptr<const MeshData> meshA = cache.GetMesh(a);
+    cache.GetMesh(b);
+    cache.GetMesh(a);
+    cache.GetMesh(c);
+
+    EXPECT_TRUE(cache.Contains(a));
+    EXPECT_FALSE(cache.Contains(b));
+    EXPECT_TRUE(cache.Contains(c));
+    EXPECT_EQ(1u, cache.GetStatistics().evictions);
+    EXPECT_LE(cache.GetStatistics().memoryUsed, planeSize * 2);
+
+    // Handed-out meshes outlive their eviction
+    cache.SetMemoryBudget(0);
+    EXPECT_EQ(0u, cache.GetStatistics().entryCount);
+    EXPECT_EQ(plane.indices, meshA->indices);
+}
+
+TEST(GeometryCacheTest, HeldBuffersSurviveEvictionPressure) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "Null renderer not available";
+    }
+    ResourceManager resources(renderSystem.get());
+
+    const GeometryKey a = GeometryKey::Plane(1.0f, 1.0f, 8, 8);
+    const GeometryKey b = GeometryKey::Plane(2.0f, 1.0f, 8, 8);
+    const GeometryKey c = GeometryKey::Plane(3.0f, 1.0f, 8, 8);
+
+    // Room for one plane with its GPU copy
+    const MeshData plane = GeometryCache::Generate(a);
+    const std::size_t planeSize = plane.vertices.size() * sizeof(Vertex) + plane.indices.size() * sizeof(std::uint32_t);
+    GeometryCache cache(&resources, planeSize * 2);
+
+    std::vector<std::function<void()>> deferred;
+    cache.SetReleaseScheduler([&](std::function<void()> release) { deferred.push_back(std::move(release)); });
+
+    GeometryBuffers held = cache.GetBuffers(a);
+    ASSERT_TRUE(held.IsValid());
+    const ResourceId droppedVertexBuffer = cache.GetBuffers(b).vertexBufferId;
+    cache.GetMesh(c);
+    cache.SetMemoryBudget(0);
+
+    // The held entry stays, the others go and release their buffers through the scheduler
+    EXPECT_TRUE(cache.Contains(a));
+    EXPECT_FALSE(cache.Contains(b));
+    EXPECT_FALSE(cache.Contains(c));
+    EXPECT_NE(nullptr, resources.GetVertexBuffer(held.vertexBufferId));
+    EXPECT_NE(nullptr, resources.GetIndexBuffer(held.indexBufferId));
+    ASSERT_EQ(1u, deferred.size());
+    EXPECT_NE(nullptr, resources.GetVertexBuffer(droppedVertexBuffer));
+    deferred[0]();
+    EXPECT_EQ(nullptr, resources.GetVertexBuffer(droppedVertexBuffer));
+
+    // A hit hands out the same buffers; Clear() keeps them while held
+    EXPECT_EQ(held.vertexBufferId, cache.GetBuffers(a).vertexBufferId);
+    cache.Clear();
+    EXPECT_TRUE(cache.Contains(a));
+
+    // Once released by its users the entry can be evicted
+    held = GeometryBuffers();
+    cache.SetMemoryBudget(0);
+    EXPECT_FALSE(cache.Contains(a));
+    EXPECT_EQ(2u, deferred.size());
+    EXPECT_EQ(0u, cache.GetStatistics().memoryUsed);
+}
+
+// === GeometryGenerator Tests ===
+
+TEST(GeometryGeneratorTest, ParallelKernelsMatchSerial) {
+    // Enough vertices and triangles to be split into several chunks
+    MeshData mesh = GeometryGenerator::GeneratePlane(4.0f, 4.0f, 300, 300);
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> height(-0.5f, 0.5f);
+    for (Vertex& vertex : mesh.vertices) {
+        vertex.position.y = height(random);
+    }
+
+    ThreadPool pool(4);
+
+    Gs::Vector3f serialMin, serialMax, parallelMin, parallelMax;
+    GeometryGenerator::CalculateBounds(mesh, serialMin, serialMax);
+    GeometryGenerator::CalculateBounds(mesh, parallelMin, parallelMax, &pool);
+    EXPECT_EQ(serialMin.y, parallelMin.y);
+    EXPECT_EQ(serialMax.y, parallelMax.y);
+    EXPECT_FLOAT_EQ(-2.0f, parallelMin.x);
+    EXPECT_FLOAT_EQ(2.0f, parallelMax.z);
+
+    MeshData serial = mesh;
+    MeshData parallel = mesh;
+    GeometryGenerator::GenerateNormals(serial);
+    GeometryGenerator::GenerateNormals(parallel, true, &pool);
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+        ASSERT_NEAR(serial.vertices[i].normal.x, parallel.vertices[i].normal.x, 1e-5f);
+        ASSERT_NEAR(serial.vertices[i].normal.y, parallel.vertices[i].normal.y, 1e-5f);
+        ASSERT_NEAR(serial.vertices[i].normal.z, parallel.vertices[i].normal.z, 1e-5f);
+    }
+
+    const MeshData parts[3] = { mesh, GeometryGenerator::GenerateCube(), mesh };
+    const MeshData serialMerged = GeometryGenerator::MergeMeshes(parts, 3);
+    const MeshData parallelMerged = GeometryGenerator::MergeMeshes(parts, 3, &pool);
+    ASSERT_EQ(mesh.indices.size() * 2 + parts[1].indices.size(), parallelMerged.indices.size());
+    EXPECT_EQ(serialMerged.indices, parallelMerged.indices);
+    EXPECT_EQ(mesh.vertices.size() + parts[1].vertices.size(), parallelMerged.indices.back() - mesh.indices.back());
+}
+
+TEST(GeometryGeneratorTest, TransformMeshAppliesAffineMatrix) {
+    MeshData mesh;
+    mesh.vertices.push_back(Vertex(Gs::Vector3f(1.0f, 1.0f, 0.0f), Gs::Vector3f(0.7071068f, 0.7071068f, 0.0f)));
+
+    // Non-uniform scale (2, 1, 1) followed by a translation of (5, 6, 7)
+    Gs::Matrix4f transform;
+    transform.LoadIdentity();
+    transform.At(0, 0) = 2.0f;
+    transform.At(0, 3) = 5.0f;
+    transform.At(1, 3) = 6.0f;
+    transform.At(2, 3) = 7.0f;
+    GeometryGenerator::TransformMesh(mesh, transform);
+
+    const Vertex& vertex = mesh.vertices[0];
+    EXPECT_FLOAT_EQ(7.0f, vertex.position.x);
+    EXPECT_FLOAT_EQ(7.0f, vertex.position.y);
+    EXPECT_FLOAT_EQ(7.0f, vertex.position.z);
+
+    // Normals use the inverse transpose, so stretching x tilts the normal towards y
+    EXPECT_NEAR(0.4472136f, vertex.normal.x, 1e-5f);
+    EXPECT_NEAR(0.8944272f, vertex.normal.y, 1e-5f);
+    EXPECT_NEAR(0.0f, vertex.normal.z, 1e-5f);
+}
+
+// === MeshOptimizer Tests ===
+
+namespace {
+
+// Triangles as sorted position triples, to compare meshes independent of vertex and triangle order
+std::vector<std::vector<float>> TriangleSet(const MeshData& mesh) {
+    std::vector<std::vector<float>> triangles;
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+        std::vector<float> triangle;
+        // Rotate so the smallest index comes first; keeps the winding in the comparison
+        std::size_t first = 0;
+        for (std::size_t corner = 1; corner < 3; ++corner) {
+            const Gs::Vector3f& a = mesh.vertices[mesh.indices[i + corner]].position;
+            const Gs::Vector3f& b = mesh.vertices[mesh.indices[i + first]].position;
+            if (std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z)) {
+                first = corner;
+            }
+        }
+        for (std::size_t corner = 0; corner < 3; ++corner) {
+            const Gs::Vector3f& p = mesh.vertices[mesh.indices[i + (first + corner) % 3]].position;
+            triangle.insert(triangle.end(), { p.x, p.y, p.z });
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, WeldMergesDuplicatesAndFetchDropsUnused) {
+    MeshData mesh;
+    mesh.vertices = { Vertex(Gs::Vector3f(0, 0, 0)), Vertex(Gs::Vector3f(1, 0, 0)), Vertex(Gs::Vector3f(0, 1, 0)),
+                      Vertex(Gs::Vector3f(1, 0, 0)), Vertex(Gs::Vector3f(5, 5, 5)), Vertex(Gs::Vector3f(1, 1, 0)),
+                      Vertex(Gs::Vector3f(0, 1.0001f, 0)) };
+    mesh.indices = { 0, 1, 2, 3, 5, 6 };
+
+    EXPECT_EQ(1u, MeshOptimizer::WeldVertices(mesh));
+    EXPECT_EQ(mesh.indices[1], mesh.indices[3]);
+
+    EXPECT_EQ(1u, MeshOptimizer::WeldVertices(mesh, 0.01f));
+    EXPECT_EQ(mesh.indices[2], mesh.indices[5]);
+
+    // The (5, 5, 5) vertex is unreferenced
+    EXPECT_EQ(1u, MeshOptimizer::OptimizeVertexFetch(mesh));
+    ASSERT_EQ(4u, mesh.vertices.size());
+    const std::vector<std::uint32_t> expected = { 0, 1, 2, 1, 3, 2 };
+    EXPECT_EQ(expected, mesh.indices);
+}
+
+TEST(MeshOptimizerTest, OptimizeImprovesCacheAndKeepsTriangles) {
+    MeshData mesh = GeometryGenerator::GenerateSphere(1.0f, 64, 32);
+
+    // Shuffle triangles to mimic an importer that emits them in arbitrary order
+    std::vector<std::size_t> order(mesh.GetTriangleCount());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(5));
+    std::vector<std::uint32_t> shuffled;
+    for (std::size_t triangle : order) {
+        shuffled.insert(shuffled.end(), mesh.indices.begin() + triangle * 3, mesh.indices.begin() + triangle * 3 + 3);
+    }
+    mesh.indices = shuffled;
+
+    const std::vector<std::vector<float>> triangles = TriangleSet(mesh);
+    const MeshOptimizerStats stats = MeshOptimizer::Optimize(mesh);
+
+    EXPECT_GT(stats.before.acmr, 1.5f);
+    EXPECT_LT(stats.after.acmr, 0.9f);
+    EXPECT_LT(stats.after.atvr, stats.before.atvr);
+    EXPECT_LE(stats.vertexCountAfter, stats.vertexCountBefore);
+    EXPECT_EQ(triangles, TriangleSet(mesh));
+
+    // Vertex fetch order follows the index buffer
+    std::uint32_t highest = 0;
+    for (std::uint32_t index : mesh.indices) {
+        ASSERT_LE(index, highest + 1);
+        highest = std::max(highest, index);
+    }
+}
+
+TEST(MeshOptimizerTest, SimplifyKeepsBordersAndReachesTarget) {
+    const MeshData plane = GeometryGenerator::GeneratePlane(2.0f, 2.0f, 40, 40);
+    const std::size_t target = plane.indices.size() / 4 / 3 * 3;
+
+    float error = -1.0f;
+    MeshData simplified = plane;
+    simplified.indices = MeshOptimizer::Simplify(plane, target, 0.01f, &error);
+
+    EXPECT_LE(simplified.indices.size(), target + 6);
+    EXPECT_EQ(0u, simplified.indices.size() % 3);
+    EXPECT_NEAR(0.0f, error, 1e-5f);
+
+    // The flat plane keeps its outline because border vertices never move
+    Gs::Vector3f minBefore, maxBefore, minAfter, maxAfter;
+    GeometryGenerator::CalculateBounds(plane, minBefore, maxBefore);
+    MeshOptimizer::OptimizeVertexFetch(simplified);
+    GeometryGenerator::CalculateBounds(simplified, minAfter, maxAfter);
+    EXPECT_FLOAT_EQ(minBefore.x, minAfter.x);
+    EXPECT_FLOAT_EQ(maxBefore.z, maxAfter.z);
+
+    // An error budget of zero forbids collapses that move the curved surface of a sphere
+    const MeshData sphere = GeometryGenerator::GenerateSphere(1.0f, 32, 16);
+    EXPECT_EQ(sphere.indices.size(), MeshOptimizer::Simplify(sphere, sphere.indices.size() / 2, 0.0f).size());
+}
+
+// === LodChain Tests ===
+
+TEST(LodChainTest, LevelsShareVerticesAndShrink) {
+    const MeshData sphere = GeometryGenerator::GenerateSphere(1.0f, 64, 32);
+    const LodMesh lod = LodGenerator::Generate(sphere);
+
+    ASSERT_GE(lod.levels.size(), 3u);
+    EXPECT_EQ(sphere.vertices.size(), lod.mesh.vertices.size());
+    EXPECT_EQ(sphere.indices.size(), lod.levels[0].indexCount);
+    EXPECT_NEAR(1.0f, lod.boundsRadius, 1e-3f);
+
+    std::size_t totalIndices = 0;
+    for (std::size_t i = 0; i < lod.levels.size(); ++i) {
+        const LodLevel& level = lod.levels[i];
+        EXPECT_EQ(totalIndices, level.firstIndex);
+        totalIndices += level.indexCount;
+        if (i > 0) {
+            EXPECT_LT(level.indexCount, lod.levels[i - 1].indexCount);
+            EXPECT_GE(level.error, lod.levels[i - 1].error);
+        }
+        EXPECT_LE(level.error, LodChainSettings().maxError * lod.boundsRadius + 1e-5f);
+    }
+    EXPECT_EQ(totalIndices, lod.mesh.indices.size());
+    for (std::uint32_t index : lod.mesh.indices) {
+        ASSERT_LT(index, lod.mesh.vertices.size());
+    }
+}
+
+TEST(LodChainTest, SelectorPicksCoarserLevelsWithDistance) {
+    std::vector<LodLevel> levels(3);
+    levels[1].error = 0.01f;
+    levels[2].error = 0.1f;
+
+    // Camera at the origin; a projection scale of 1 on a 1000 pixel viewport gives 500 pixels per unit at distance 1
+    Gs::Matrix4f view, projection;
+    view.LoadIdentity();
+    projection.LoadIdentity();
+    LodSelector selector;
+    selector.SetCamera(view, projection, 1000.0f);
+    selector.SetPixelError(1.0f);
+
+    EXPECT_EQ(0u, selector.SelectLevel(levels, Gs::Vector3f(0, 0, -3), 1.0f, 1.0f));
+    EXPECT_EQ(1u, selector.SelectLevel(levels, Gs::Vector3f(0, 0, -10), 1.0f, 1.0f));
+    EXPECT_EQ(2u, selector.SelectLevel(levels, Gs::Vector3f(0, 0, -101), 1.0f, 1.0f));
+
+    // Scaling an object up scales its error on screen
+    EXPECT_EQ(1u, selector.SelectLevel(levels, Gs::Vector3f(0, 0, -101), 1.0f, 10.0f));
+
+    // Inside the bounding sphere always uses full detail
+    EXPECT_EQ(0u, selector.SelectLevel(levels, Gs::Vector3f(0, 0, -0.5f), 1.0f, 1.0f));
+}
+
+// === QuantizedMesh Tests ===
+
+TEST(QuantizedMeshTest, RoundTripStaysWithinQuantizationError) {
+    MeshData mesh = GeometryGenerator::GenerateTorus(3.0f, 1.0f, 64, 32);
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (Vertex& vertex : mesh.vertices) {
+        vertex.texCoord = Gs::Vector2f(vertex.texCoord.x * 8.0f, vertex.texCoord.y * 8.0f - 4.0f);
+        vertex.color = Gs::Vector3f(unit(rng), unit(rng), unit(rng));
+    }
+    
+    const QuantizedMeshData quantized = VertexQuantizer::Quantize(mesh);
+    ASSERT_EQ(mesh.vertices.size(), quantized.vertices.size());
+    EXPECT_EQ(mesh.indices, quantized.indices);
+    EXPECT_LE(quantized.vertices.size() * sizeof(QuantizedVertex) * 2, mesh.vertices.size() * sizeof(Vertex));
+    
+    const MeshData decoded = VertexQuantizer::Dequantize(quantized);
+    ASSERT_EQ(mesh.vertices.size(), decoded.vertices.size());
+    
+    // Half a unorm16 step of the largest extent, with float slack
+    const Gs::Vector3f& scale = quantized.positionScale;
+    const float positionTolerance = std::max(scale.x, std::max(scale.y, scale.z)) * (0.5f / 65535.0f) * 1.01f;
+    
+    float maxPositionError = 0.0f;
+    float maxNormalSine = 0.0f;
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const Vertex& original = mesh.vertices[i];
+        const Vertex& restored = decoded.vertices[i];
+        
+        maxPositionError = std::max(maxPositionError, std::abs(original.position.x - restored.position.x));
+        maxPositionError = std::max(maxPositionError, std::abs(original.position.y - restored.position.y));
+        maxPositionError = std::max(maxPositionError, std::abs(original.position.z - restored.position.z));
+        
+        const Gs::Vector3f& n = original.normal;
+        const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        const Gs::Vector3f& r = restored.normal;
+        const float cx = n.y * r.z - n.z * r.y;
+        const float cy = n.z * r.x - n.x * r.z;
+        const float cz = n.x * r.y - n.y * r.x;
+        EXPECT_GT(n.x * r.x + n.y * r.y + n.z * r.z, 0.0f);
+        maxNormalSine = std::max(maxNormalSine, std::sqrt(cx * cx + cy * cy + cz * cz) / length);
+        
+        // Half floats keep 11 significant bits
+        EXPECT_NEAR(original.texCoord.x, restored.texCoord.x, std::abs(original.texCoord.x) / 2048.0f + 1e-7f);
+        EXPECT_NEAR(original.texCoord.y, restored.texCoord.y, std::abs(original.texCoord.y) / 2048.0f + 1e-7f);
+        
+        EXPECT_NEAR(original.color.x, restored.color.x, 0.5f / 255.0f + 1e-6f);
+        EXPECT_NEAR(original.color.z, restored.color.z, 0.5f / 255.0f + 1e-6f);
+    }
+    EXPECT_LE(maxPositionError, positionTolerance);
+    
+    // Octahedral snorm16 normals stay within a hundredth of a degree
+    EXPECT_LT(maxNormalSine, std::sin(0.01f * 3.14159265f / 180.0f));
+}
+
+TEST(QuantizedMeshTest, EncodesSpecialValues) {
+    // Poles, axes and the octahedron's folded edges
+    const Gs::Vector3f normals[] = {
+        { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 },
+        { 0.577f, -0.577f, -0.577f }, { -0.707f, 0.0f, -0.707f }
+    };
+    for (const Gs::Vector3f& normal : normals) {
+        std::int16_t encoded[2];
+        VertexQuantizer::EncodeOctahedral(normal, encoded);
+        const Gs::Vector3f decoded = VertexQuantizer::DecodeOctahedral(encoded);
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        EXPECT_NEAR(normal.x / length, decoded.x, 1e-4f);
+        EXPECT_NEAR(normal.y / length, decoded.y, 1e-4f);
+        EXPECT_NEAR(normal.z / length, decoded.z, 1e-4f);
+    }
+    
+    EXPECT_EQ(0x3C00, VertexQuantizer::FloatToHalf(1.0f));
+    EXPECT_EQ(0xC000, VertexQuantizer::FloatToHalf(-2.0f));
+    EXPECT_EQ(0x7BFF, VertexQuantizer::FloatToHalf(65504.0f));
+    EXPECT_EQ(0x7C00, VertexQuantizer::FloatToHalf(1.0e6f));
+    EXPECT_EQ(0x0001, VertexQuantizer::FloatToHalf(5.9604645e-8f));
+    EXPECT_EQ(0x3C00, VertexQuantizer::FloatToHalf(1.0f + 1.0f / 4096.0f));  // Tie rounds to even
+    EXPECT_FLOAT_EQ(0.099975586f, VertexQuantizer::HalfToFloat(VertexQuantizer::FloatToHalf(0.1f)));
+    EXPECT_FLOAT_EQ(5.9604645e-8f, VertexQuantizer::HalfToFloat(0x0001));
+    
+    // A flat mesh has zero extent on one axis and must not divide by it
+    const QuantizedMeshData plane = VertexQuantizer::Quantize(GeometryGenerator::GeneratePlane(1.0f, 1.0f, 2, 2));
+    const MeshData decoded = VertexQuantizer::Dequantize(plane);
+    EXPECT_FLOAT_EQ(0.0f, plane.positionScale.y);
+    EXPECT_FLOAT_EQ(0.0f, decoded.vertices[0].position.y);
+}
+
+TEST(QuantizedMeshTest, DecodeBlockReproducesDequantize) {
+    const QuantizedMeshData quantized = VertexQuantizer::Quantize(GeometryGenerator::GenerateSphere(2.0f, 16, 8));
+    const MeshData decoded = VertexQuantizer::Dequantize(quantized);
+    const QuantizedDecodeParams params = VertexQuantizer::GetDecodeParams(quantized);
+    EXPECT_FLOAT_EQ(0.0f, params.positionOffset.w);
+    EXPECT_FLOAT_EQ(0.0f, params.positionScale.w);
+    
+    // Same arithmetic as DecodePosition() of the quantized vertex shaders
+    for (std::size_t i = 0; i < quantized.vertices.size(); ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            const float unorm = static_cast<float>(quantized.vertices[i].position[axis]) / 65535.0f;
+            EXPECT_NEAR(decoded.vertices[i].position[axis],
+                        params.positionOffset[axis] + params.positionScale[axis] * unorm, 1e-6f);
+        }
+    }
+}
+
+// === ShaderDiskCache Tests ===
+
+TEST(ShaderDiskCacheTest, StoresAndReloadsAcrossInstances) {
+    const std::string directory = testing::TempDir() + "shader_disk_cache_round_trip";
+    std::filesystem::remove_all(directory);
+    
+    std::vector<std::uint8_t> payload(4096);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<std::uint8_t>(i * 31);
+    }
+    const ShaderHash key = ShaderHasher().Update(std::string("void main() {}")).Finalize();
+    const ShaderHash otherKey = ShaderHasher().Update(std::string("void main() { }")).Finalize();
+    
+    {
+        ShaderDiskCache cache;
+        ASSERT_TRUE(cache.Open(directory, "OpenGL|Device|Vendor|GLSL"));
+        std::vector<std::uint8_t> blob;
+        EXPECT_FALSE(cache.Load(key, blob));
+        EXPECT_TRUE(cache.Store(key, payload.data(), payload.size()));
+        EXPECT_EQ(1u, cache.GetStatistics().misses);
+        EXPECT_EQ(1u, cache.GetStatistics().writes);
+    }
+    
+    // A new instance, as after a process restart, finds the entry
+    ShaderDiskCache cache;
+    ASSERT_TRUE(cache.Open(directory, "OpenGL|Device|Vendor|GLSL"));
+    std::vector<std::uint8_t> blob;
+    EXPECT_TRUE(cache.Load(key, blob));
+    EXPECT_EQ(payload, blob);
+    EXPECT_EQ(1u, cache.GetStatistics().hits);
+    EXPECT_FALSE(cache.Load(otherKey, blob));
+    EXPECT_TRUE(blob.empty());
+    
+    EXPECT_EQ(1u, cache.Clear());
+    EXPECT_FALSE(cache.Load(key, blob));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ShaderDiskCacheTest, RejectsStaleAndCorruptEntries) {
+    const std::string directory = testing::TempDir() + "shader_disk_cache_reject";
+    std::filesystem::remove_all(directory);
+    const std::uint8_t payload[64] = { 1, 2, 3, 4 };
+    const ShaderHash key1 = ShaderHasher::Hash("a", 1);
+    const ShaderHash key2 = ShaderHasher::Hash("b", 1);
+    
+    ShaderDiskCache cache;
+    ASSERT_TRUE(cache.Open(directory, "driver 1.0"));
+    ASSERT_TRUE(cache.Store(key1, payload, sizeof(payload)));
+    ASSERT_TRUE(cache.Store(key2, payload, sizeof(payload)));
+    
+    // Flip a payload byte of entry 2
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().filename().string().find(key2.ToString()) == 0) {
+            std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(sizeof(ShaderCacheEntryHeader) + 10);
+            file.put(static_cast<char>(0x7F));
+        }
+    }
+    std::vector<std::uint8_t> blob;
+    EXPECT_FALSE(cache.Load(key2, blob));
+    EXPECT_EQ(1u, cache.GetStatistics().rejected);
+    
+    // A driver update invalidates entries written by the old driver, which are then deleted
+    ASSERT_TRUE(cache.Open(directory, "driver 1.1"));
+    EXPECT_FALSE(cache.Load(key1, blob));
+    EXPECT_EQ(1u, cache.GetStatistics().rejected);
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+}
+
+// === ShaderHash Tests ===
+
+TEST(ShaderHashTest, StreamingMatchesOneShot) {
+    std::string text(10000, ' ');
+    std::mt19937 rng(3);
+    for (char& c : text) {
+        c = static_cast<char>('a' + rng() % 26);
+    }
+    
+    const ShaderHash oneShot = ShaderHasher::Hash(text.data(), text.size());
+    for (std::size_t pieceSize : { 1u, 7u, 31u, 32u, 33u, 4096u }) {
+        ShaderHasher hasher;
+        for (std::size_t offset = 0; offset < text.size(); offset += pieceSize) {
+            hasher.Update(text.data() + offset, std::min(pieceSize, text.size() - offset));
+        }
+        EXPECT_EQ(oneShot, hasher.Finalize()) << "piece size " << pieceSize;
+    }
+    
+    // Every length up to two stripes, and single-character edits, give distinct hashes
+    std::vector<ShaderHash> hashes;
+    for (std::size_t length = 0; length <= 64; ++length) {
+        hashes.push_back(ShaderHasher::Hash(text.data(), length));
+    }
+    for (std::size_t i = 0; i < 64; ++i) {
+        std::string edited = text.substr(0, 64);
+        edited[i] ^= 1;
+        hashes.push_back(ShaderHasher::Hash(edited.data(), edited.size()));
+    }
+    std::sort(hashes.begin(), hashes.end());
+    EXPECT_EQ(hashes.end(), std::adjacent_find(hashes.begin(), hashes.end()));
+    
+    // Length prefixes keep field boundaries apart
+    EXPECT_NE(ShaderHasher().Update(std::string("ab")).Update(std::string("c")).Finalize(),
+              ShaderHasher().Update(std::string("a")).Update(std::string("bc")).Finalize());
+    EXPECT_EQ(32u, oneShot.ToString().size());
+}
+
+TEST(ShaderHashTest, ShaderSourceMemoizesHash) {
+    ShaderSource source(ShaderType::Vertex, "void main() {}");
+    const ShaderHash first = source.GetHash();
+    EXPECT_EQ(first, source.GetHash());
+    EXPECT_EQ(first, ShaderSource(ShaderType::Vertex, "void main() {}").GetHash());
+    EXPECT_NE(first, ShaderSource(ShaderType::Fragment, "void main() {}").GetHash());
+    EXPECT_NE(first, ShaderSource(ShaderType::Vertex, "void main() {}", "VSMain").GetHash());
+    
+    // Edits are only picked up after invalidation
+    source.source += "\n";
+    EXPECT_EQ(first, source.GetHash());
+    source.InvalidateHash();
+    EXPECT_NE(first, source.GetHash());
+}
+
+TEST(ShaderFileWatcherTest, ReportsOneChangePerBurstOfWrites) {
+    if (!ShaderFileWatcher::IsSupported()) {
+        GTEST_SKIP() << "No native file watching on this platform";
+    }
+    const std::string directory = testing::TempDir() + "shader_file_watcher";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::string watchedPath = directory + "/lit.frag";
+    const std::string otherPath = directory + "/other.frag";
+    std::ofstream(watchedPath) << "void main() {}";
+    std::ofstream(otherPath) << "void main() {}";
+    
+    ShaderFileWatcher watcher;
+    ASSERT_TRUE(watcher.Start(std::chrono::milliseconds(50)));
+    ASSERT_TRUE(watcher.AddFile(watchedPath));
+    EXPECT_EQ(1u, watcher.GetFileCount());
+    EXPECT_FALSE(watcher.HasChanges());
+    
+    // Unwatched files in the same directory are filtered out
+    std::ofstream(otherPath) << "void main() { }";
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(watcher.HasChanges());
+    
+    // An editor saving twice in quick succession yields one change
+    std::ofstream(watchedPath) << "void main() { }";
+    std::ofstream(watchedPath) << "void main() {  }";
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!watcher.HasChanges() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    const std::vector<std::string> changes = watcher.TakeChanges();
+    ASSERT_EQ(1u, changes.size());
+    EXPECT_EQ(ShaderFileWatcher::NormalizePath(watchedPath), changes[0]);
+    EXPECT_FALSE(watcher.HasChanges());
+    
+    watcher.Stop();
+    EXPECT_FALSE(watcher.IsRunning());
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ShaderIncludeCacheTest, SharedIncludesAreLoadedOnce) {
+    const std::string directory = testing::TempDir() + "shader_include_cache";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory + "/include");
+    std::ofstream(directory + "/include/lighting.glsl") << "#include \"common.glsl\"\nvec3 Light();\n";
+    std::ofstream(directory + "/include/common.glsl") << "float Saturate(float x);\n";
+    
+    std::atomic<int> loads{0};
+    auto loader = [&loads](const std::string& includePath, const std::string& currentPath) {
+        ++loads;
+        std::ifstream file(std::filesystem::path(currentPath).parent_path() / includePath);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    
+    ShaderIncludeCache cache;
+    const std::string shaderPath = directory + "/lit.frag";
+    const std::string source = "#include \"include/lighting.glsl\"\nvoid main() {}\n";
+    std::string expanded;
+    for (int i = 0; i < 100; ++i) {
+        expanded = cache.Expand(source, shaderPath, loader);
+    }
+    EXPECT_EQ("float Saturate(float x);\n\nvec3 Light();\n\nvoid main() {}\n", expanded);
+    EXPECT_EQ(2, loads.load());
+    EXPECT_EQ(2u, cache.GetEntryCount());
+    
+    std::vector<std::string> includedFiles;
+    cache.Expand(source, shaderPath, loader, &includedFiles);
+    const std::string lighting = ShaderFileWatcher::NormalizePath(directory + "/include/lighting.glsl");
+    const std::string common = ShaderFileWatcher::NormalizePath(directory + "/include/common.glsl");
+    EXPECT_EQ((std::vector<std::string>{ lighting, common }), includedFiles);
+    EXPECT_EQ(std::vector<std::string>{ common }, cache.GetIncludes(lighting));
+    EXPECT_EQ(std::vector<std::string>{ lighting }, cache.GetDependents(common));
+    
+    // A changed nested include reloads it and everything that includes it
+    std::ofstream(directory + "/include/common.glsl") << "float Saturate(float value);\n";
+    std::filesystem::last_write_time(directory + "/include/common.glsl",
+                                     std::filesystem::last_write_time(common) + std::chrono::seconds(1));
+    expanded = cache.Expand(source, shaderPath, loader);
+    EXPECT_NE(std::string::npos, expanded.find("float value"));
+    EXPECT_EQ(4, loads.load());
+    
+    EXPECT_EQ(2u, cache.Invalidate(common));
+    EXPECT_EQ(0u, cache.GetEntryCount());
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ShaderIncludeCacheTest, IncludesWithoutFilesAreNotCached) {
+    int loads = 0;
+    auto loader = [&loads](const std::string& includePath, const std::string&) {
+        ++loads;
+        return "// " + includePath;
+    };
+    
+    ShaderIncludeCache cache;
+    EXPECT_EQ("// generated.glsl\n", cache.Expand("#include <generated.glsl>\n", "", loader));
+    EXPECT_EQ("// generated.glsl\n", cache.Expand("#include <generated.glsl>\n", "", loader));
+    EXPECT_EQ(2, loads);
+    EXPECT_EQ(0u, cache.GetEntryCount());
+}
+
+// === ShaderManager Tests ===
+
+TEST(ShaderManagerTest, ProgramCacheSharesObjectsUntilLastRelease) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ShaderProgramDesc desc;
+    desc.name = "first";
+    desc.vertexShader = ShaderSource(ShaderType::Vertex, "#version 330 core\nvoid main() {}\n");
+    desc.fragmentShader = ShaderSource(ShaderType::Fragment, "#version 330 core\nvoid main() {}\n");
+    
+    CompiledShaderProgram first = shaderManager.CompileShaderProgram(desc);
+    desc.name = "second";
+    CompiledShaderProgram second = shaderManager.CompileShaderProgram(desc);
+    ASSERT_TRUE(first.isValid);
+    ASSERT_TRUE(second.isValid);
+    EXPECT_EQ(first.pipelineState, second.pipelineState);
+    EXPECT_EQ("second", second.name);
+    
+    // Options are part of the key
+    ShaderCompileOptions options;
+    options.AddDefine("SHADOWS");
+    CompiledShaderProgram shadowed = shaderManager.CompileShaderProgram(desc, options);
+    ASSERT_TRUE(shadowed.isValid);
+    EXPECT_NE(first.pipelineState, shadowed.pipelineState);
+    
+    auto statistics = shaderManager.GetCompilationStatistics();
+    EXPECT_EQ(1.0, statistics["programCache.hits"]);
+    EXPECT_EQ(2.0, statistics["programCache.entries"]);
+    
+    // Neither releasing one copy nor clearing the cache releases the objects of the other copy
+    shaderManager.ReleaseShaderProgram(first);
+    EXPECT_FALSE(first.isValid);
+    EXPECT_EQ(nullptr, first.pipelineState);
+    shaderManager.ClearCache();
+    EXPECT_EQ(0.0, shaderManager.GetCompilationStatistics()["programCache.entries"]);
+    EXPECT_TRUE(shaderManager.RegisterShaderProgram(second));
+    EXPECT_TRUE(shaderManager.RemoveShaderProgram("second"));
+    shaderManager.ReleaseShaderProgram(shadowed);
+    
+    CompiledShaderProgram recompiled = shaderManager.CompileShaderProgram(desc);
+    EXPECT_TRUE(recompiled.isValid);
+    EXPECT_EQ(1.0, shaderManager.GetCompilationStatistics()["programCache.hits"]);
+    shaderManager.ReleaseShaderProgram(recompiled);
+}
+
+TEST(ShaderManagerTest, PreprocessingResolvesIncludesThenInsertsProgramAndCallDefines) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ThreadPool threadPool(2);
+    shaderManager.SetThreadPool(&threadPool);
+    shaderManager.SetIncludeResolver([](const std::string& includePath, const std::string&) {
+        return "uniform float " + includePath.substr(0, includePath.find('.')) + ";";
+    });
+    
+    ShaderProgramDesc desc;
+    desc.vertexShader = ShaderSource(ShaderType::Vertex, "#version 330 core\n#include \"common.glsl\"\nvoid main() {}\n");
+    desc.fragmentShader = ShaderSource(ShaderType::Fragment, "#version 330 core\n#include \"lighting.glsl\"\nvoid main() {}\n");
+    desc.compileOptions.AddDefine("VARIANT=3");
+    ShaderCompileOptions options;
+    options.AddDefine("SHADOWS");
+    
+    const ShaderProgramDesc prepared = shaderManager.PreprocessShaderProgram(desc, options);
+    EXPECT_EQ("#version 330 core\n#define VARIANT 3\n#define SHADOWS\nuniform float common;\nvoid main() {}\n",
+              prepared.vertexShader.source);
+    EXPECT_EQ("#version 330 core\n#define VARIANT 3\n#define SHADOWS\nuniform float lighting;\nvoid main() {}\n",
+              prepared.fragmentShader.source);
+    EXPECT_TRUE(prepared.geometryShader.source.empty());
+    
+    // The description itself is left untouched
+    EXPECT_EQ("#version 330 core\n#include \"common.glsl\"\nvoid main() {}\n", desc.vertexShader.source);
+}
+
+TEST(ShaderManagerTest, BatchResultsFollowDescriptionOrder) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    std::vector<ShaderProgramDesc> descs(16);
+    for (std::size_t i = 0; i < descs.size(); ++i) {
+        descs[i].name = "program" + std::to_string(i);
+        descs[i].vertexShader = ShaderSource(ShaderType::Vertex, "#version 330 core\nvoid main() {}\n");
+        descs[i].fragmentShader = ShaderSource(ShaderType::Fragment,
+            "#version 330 core\nuniform float value" + std::to_string(i) + ";\nvoid main() {}\n");
+    }
+    
+    ThreadPool threadPool(4);
+    for (bool parallelCreation : { false, true }) {
+        ShaderManager shaderManager(renderSystem.get(), nullptr);
+        shaderManager.SetThreadPool(&threadPool);
+        shaderManager.SetParallelCreationEnabled(parallelCreation);
+        
+        std::vector<CompiledShaderProgram> programs = shaderManager.CompileShaderPrograms(descs);
+        ASSERT_EQ(descs.size(), programs.size());
+        for (std::size_t i = 0; i < programs.size(); ++i) {
+            EXPECT_TRUE(programs[i].isValid);
+            EXPECT_EQ(descs[i].name, programs[i].name);
+            EXPECT_NE(UINT32_MAX, programs[i].GetUniformLocation("value" + std::to_string(i)));
+            shaderManager.ReleaseShaderProgram(programs[i]);
+        }
+        EXPECT_EQ(descs.size(), shaderManager.GetLastCompileTiming().programCount);
+    }
+}
+
+TEST(ShaderManagerTest, PendingCompilationsRespectTheBudget) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ThreadPool threadPool(2);
+    shaderManager.SetThreadPool(&threadPool);
+    
+    std::vector<std::future<CompiledShaderProgram>> results;
+    for (int i = 0; i < 5; ++i) {
+        ShaderProgramDesc desc;
+        desc.name = "async" + std::to_string(i);
+        desc.vertexShader = ShaderSource(ShaderType::Vertex, "#version 330 core\nvoid main() {}\n");
+        results.push_back(shaderManager.CompileShaderProgramAsync(desc));
+    }
+    
+    // Without parallel creation nothing is created until the render thread pumps the queue
+    threadPool.WaitIdle();
+    EXPECT_EQ(5u, shaderManager.GetPendingCompilationCount());
+    EXPECT_NE(std::future_status::ready, results[0].wait_for(std::chrono::seconds(0)));
+    
+    // Oldest first, at most two per call
+    EXPECT_EQ(2u, shaderManager.ProcessPendingCompilations(2));
+    EXPECT_EQ(std::future_status::ready, results[1].wait_for(std::chrono::seconds(0)));
+    EXPECT_NE(std::future_status::ready, results[2].wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(2u, shaderManager.ProcessPendingCompilations(2));
+    EXPECT_EQ(1u, shaderManager.ProcessPendingCompilations(2));
+    EXPECT_EQ(0u, shaderManager.ProcessPendingCompilations(2));
+    EXPECT_EQ(0u, shaderManager.GetPendingCompilationCount());
+    
+    for (int i = 0; i < 5; ++i) {
+        CompiledShaderProgram program = results[i].get();
+        EXPECT_TRUE(program.isValid);
+        EXPECT_EQ("async" + std::to_string(i), program.name);
+        shaderManager.ReleaseShaderProgram(program);
+    }
+}
+
+TEST(ShaderManagerTest, ReloadDefersReleaseOfTheReplacedProgram) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "shader_reload_release";
+    std::filesystem::create_directories(dir);
+    const std::string vertexPath = (dir / "reload.vert").string();
+    std::ofstream(vertexPath) << "#version 330 core\nvoid main() {}\n";
+    
+    std::vector<std::function<void()>> releases;
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    shaderManager.SetReleaseScheduler([&releases](std::function<void()> release) {
+        releases.push_back(std::move(release));
+    });
+    
+    CompiledShaderProgram program = shaderManager.CompileShaderProgramFromFiles("reload", { { ShaderType::Vertex, vertexPath } });
+    ASSERT_TRUE(program.isValid);
+    ASSERT_TRUE(shaderManager.RegisterShaderProgram(program));
+    
+    std::ofstream(vertexPath) << "#version 330 core\nuniform float scale;\nvoid main() {}\n";
+    ASSERT_TRUE(shaderManager.ReloadShaderProgram("reload"));
+    const CompiledShaderProgram* reloaded = shaderManager.GetShaderProgram("reload");
+    ASSERT_NE(nullptr, reloaded);
+    EXPECT_NE(program.pipelineState, reloaded->pipelineState);
+    ASSERT_EQ(1u, releases.size());
+    
+    // The old program is released when the frame slot comes around again
+    releases[0]();
+    EXPECT_NE(nullptr, shaderManager.GetShaderProgram("reload")->pipelineState);
+    
+    // Failed reloads keep the old program and release nothing
+    std::filesystem::remove(vertexPath);
+    EXPECT_FALSE(shaderManager.ReloadShaderProgram("reload"));
+    EXPECT_EQ(1u, releases.size());
+    
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ShaderManagerTest, ReloadKeepsTheDefinesOfTheFirstCompile) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "shader_reload_defines";
+    std::filesystem::create_directories(dir);
+    const std::string vertexPath = (dir / "lit.vert").string();
+    std::ofstream(vertexPath) << "#version 330 core\nvoid main() {}\n";
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ShaderCompileOptions options;
+    options.AddDefine("SHADOWS=1");
+    CompiledShaderProgram shadowed = shaderManager.CompileShaderProgramFromFiles("shadowed", { { ShaderType::Vertex, vertexPath } },
+                                                                                 {}, options);
+    CompiledShaderProgram plain = shaderManager.CompileShaderProgramFromFiles("plain", { { ShaderType::Vertex, vertexPath } });
+    ASSERT_TRUE(shadowed.isValid);
+    ASSERT_TRUE(plain.isValid);
+    ASSERT_NE(shadowed.pipelineState, plain.pipelineState);
+    ASSERT_TRUE(shaderManager.RegisterShaderProgram(shadowed));
+    ASSERT_TRUE(shaderManager.RegisterShaderProgram(plain));
+    
+    // The program cache is keyed on sources and defines, so only the same define finds the original
+    ASSERT_TRUE(shaderManager.ReloadShaderProgram("shadowed"));
+    EXPECT_EQ(shadowed.pipelineState, shaderManager.GetShaderProgram("shadowed")->pipelineState);
+    ASSERT_TRUE(shaderManager.ReloadShaderProgram("plain"));
+    EXPECT_EQ(plain.pipelineState, shaderManager.GetShaderProgram("plain")->pipelineState);
+    
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ShaderManagerTest, HotReloadKeepsTheDefinesOfTheFirstCompile) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "shader_hot_reload_defines";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const std::string vertexPath = (dir / "lit.vert").string();
+    std::ofstream(vertexPath) << "#version 330 core\nvoid main() {}\n";
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ThreadPool threadPool(2);
+    shaderManager.SetThreadPool(&threadPool);
+    shaderManager.SetHotReloadEnabled(true);
+    ShaderCompileOptions options;
+    options.AddDefine("SHADOWS=1");
+    CompiledShaderProgram shadowed = shaderManager.CompileShaderProgramFromFiles("shadowed", { { ShaderType::Vertex, vertexPath } },
+                                                                                 {}, options);
+    ASSERT_TRUE(shadowed.isValid);
+    ASSERT_TRUE(shaderManager.RegisterShaderProgram(shadowed));
+    
+    // Saving the same source rebuilds the same preprocessed stage, whose reflection is cached;
+    // a reload without the define would preprocess to different content and miss
+    const double reflectionMisses = shaderManager.GetCompilationStatistics()["reflection.misses"];
+    std::ofstream(vertexPath) << "#version 330 core\nvoid main() {}\n";
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    bool replaced = false;
+    while (!replaced && std::chrono::steady_clock::now() < deadline) {
+        replaced = shaderManager.CheckForShaderChanges();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(replaced);
+    EXPECT_EQ(reflectionMisses, shaderManager.GetCompilationStatistics()["reflection.misses"]);
+    
+    shaderManager.SetHotReloadEnabled(false);
+    std::filesystem::remove_all(dir);
+}
+
+// === ShaderVariants Tests ===
+
+TEST(ShaderVariantSetTest, KeywordsMapToMaskBitsAndNames) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ShaderProgramDesc desc;
+    desc.name = "lit";
+    ShaderVariantSet variants(shaderManager, desc, { "NORMAL_MAP", "SKINNED", "FOG" });
+    
+    EXPECT_EQ(1u, variants.GetKeywordMask("NORMAL_MAP"));
+    EXPECT_EQ(4u, variants.GetKeywordMask("FOG"));
+    EXPECT_EQ(0u, variants.GetKeywordMask("SHADOWS"));
+    
+    // Undeclared keywords are ignored
+    EXPECT_EQ(5u, variants.MakeMask({ "FOG", "SHADOWS", "NORMAL_MAP" }));
+    EXPECT_EQ(0u, variants.MakeMask({}));
+    
+    EXPECT_EQ("lit[NORMAL_MAP|SKINNED]", variants.GetVariantName(variants.MakeMask({ "SKINNED", "NORMAL_MAP" })));
+    EXPECT_EQ("lit[]", variants.GetVariantName(0));
+    EXPECT_EQ("lit[FOG]", variants.GetVariantName(4u | (ShaderVariantMask(1) << 40)));
+}
+
+TEST(ShaderVariantSetTest, KeywordsBeyondTheMaskWidthAreIgnored) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    std::vector<std::string> keywords;
+    for (std::size_t i = 0; i < ShaderVariantSet::kMaxKeywords + 3; ++i) {
+        keywords.push_back("KEYWORD" + std::to_string(i));
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ShaderVariantSet variants(shaderManager, ShaderProgramDesc(), keywords);
+    ASSERT_EQ(ShaderVariantSet::kMaxKeywords, variants.GetKeywords().size());
+    EXPECT_EQ(ShaderVariantMask(1) << 63, variants.GetKeywordMask("KEYWORD63"));
+    EXPECT_EQ(0u, variants.GetKeywordMask("KEYWORD64"));
+    EXPECT_EQ(ShaderVariantMask(1) << 63, variants.MakeMask({ "KEYWORD63", "KEYWORD64", "KEYWORD66" }));
+    
+    // All 64 bits are valid, so setting the fallback keeps every bit
+    variants.SetFallbackVariant(~ShaderVariantMask(0));
+    EXPECT_EQ(~ShaderVariantMask(0), variants.GetFallbackVariant());
+}
+
+TEST(ShaderVariantSetTest, FallbackServesUndeclaredBitsAndPendingVariants) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ThreadPool threadPool(2);
+    shaderManager.SetThreadPool(&threadPool);
+    
+    ShaderProgramDesc desc;
+    desc.name = "lit";
+    desc.vertexShader = ShaderSource(ShaderType::Vertex, "#version 330 core\nvoid main() {}\n");
+    desc.fragmentShader = ShaderSource(ShaderType::Fragment, "#version 330 core\nvoid main() {}\n");
+    ShaderVariantSet variants(shaderManager, desc, { "NORMAL_MAP", "SKINNED" });
+    
+    // Bits of undeclared keywords are dropped, so these masks all select the fallback
+    variants.SetFallbackVariant(0x10);
+    EXPECT_EQ(0u, variants.GetFallbackVariant());
+    const CompiledShaderProgram* fallback = variants.GetVariant(0);
+    ASSERT_NE(nullptr, fallback);
+    EXPECT_EQ("lit[]", fallback->name);
+    EXPECT_EQ(fallback, variants.GetVariant(0x30));
+    EXPECT_EQ(0u, variants.GetStatistics().fallbackUses);
+    
+    // The fallback is served until the requested variant is created on the render thread
+    const ShaderVariantMask skinned = variants.MakeMask({ "SKINNED" });
+    EXPECT_EQ(fallback, variants.GetVariant(skinned | 0x40));
+    threadPool.WaitIdle();
+    EXPECT_EQ(fallback, variants.GetVariant(skinned));
+    EXPECT_EQ(2u, variants.GetStatistics().fallbackUses);
+    EXPECT_EQ(1u, variants.GetStatistics().pending);
+    EXPECT_EQ(nullptr, variants.FindVariant(skinned));
+    
+    variants.WaitForPendingVariants();
+    const CompiledShaderProgram* variant = variants.GetVariant(skinned);
+    ASSERT_NE(nullptr, variant);
+    EXPECT_NE(fallback, variant);
+    EXPECT_EQ("lit[SKINNED]", variant->name);
+    EXPECT_EQ(variant, variants.FindVariant(skinned | 0x40));
+    EXPECT_EQ(2u, variants.GetStatistics().fallbackUses);
+    EXPECT_EQ(2u, variants.GetStatistics().compiled);
+    EXPECT_EQ((std::vector<ShaderVariantMask>{ 0, skinned }), variants.GetRequestedVariants());
+}
+
+TEST(ShaderVariantSetTest, KeywordValuesBecomeDefinesAfterTheVersionDirective) {
+    LLGL::Report report;
+    LLGL::RenderSystemPtr renderSystem = LLGL::RenderSystem::Load("Null", &report);
+    if (!renderSystem) {
+        GTEST_SKIP() << "LLGL Null renderer not available";
+    }
+    
+    ShaderManager shaderManager(renderSystem.get(), nullptr);
+    ShaderCompileOptions options;
+    options.AddDefine("LIGHT_COUNT=4");
+    options.AddDefine("SKINNED");
+    options.AddDefine("BIAS=0.5 * scale");
+    
+    EXPECT_EQ("#version 450\n#define LIGHT_COUNT 4\n#define SKINNED\n#define BIAS 0.5 * scale\nvoid main() {}\n",
+              shaderManager.PreprocessShaderSource("#version 450\nvoid main() {}\n", options));
+    
+    // Without a version directive the defines lead the source
+    EXPECT_EQ("#define LIGHT_COUNT 4\n#define SKINNED\n#define BIAS 0.5 * scale\nvoid main() {}\n",
+              shaderManager.PreprocessShaderSource("void main() {}\n", options));
+}
+
+// === SoftwareRasterizer Tests ===
+
+TEST(SoftwareRasterizerTest, SharedEdgesAreCoveredOnceAndDepthTested) {
+    SoftwareRasterizer rasterizer;
+    ASSERT_TRUE(rasterizer.Resize(100, 70));
+    SoftwareLighting lighting;
+    lighting.lightDirection = Gs::Vector3f(0.0f, 0.0f, -1.0f);
+    lighting.ambientColor = Gs::Vector3f(0.0f, 0.0f, 0.0f);
+    rasterizer.SetLighting(lighting);
+    rasterizer.Clear(Color(0.0f, 0.0f, 1.0f));
+    
+    // Identity matrices place the vertices directly in normalized device coordinates
+    auto vertex = [](float x, float y, float z, const Gs::Vector3f& color) {
+        return Vertex(Gs::Vector3f(x, y, z), Gs::Vector3f(0.0f, 0.0f, 1.0f), Gs::Vector2f(0.0f, 0.0f), color);
+    };
+    const Gs::Vector3f red(1.0f, 0.0f, 0.0f);
+    const Gs::Vector3f green(0.0f, 1.0f, 0.0f);
+    const std::vector<Vertex> far = { vertex(-1, -1, 0.5f, red), vertex(1, -1, 0.5f, red), vertex(1, 1, 0.5f, red) };
+    const std::vector<Vertex> near = { vertex(-1, -1, 0.0f, red), vertex(1, 1, 0.0f, red), vertex(-1, 1, 0.0f, red) };
+    
+    // The nearer second half would overwrite pixels on the diagonal if both halves covered them
+    ASSERT_TRUE(rasterizer.DrawMesh(far.data(), far.size(), nullptr, far.size(), Matrices()));
+    ASSERT_TRUE(rasterizer.DrawMesh(near.data(), near.size(), nullptr, near.size(), Matrices()));
+    rasterizer.Flush();
+    EXPECT_EQ(2u, rasterizer.GetStatistics().trianglesRasterized);
+    EXPECT_EQ(100u * 70u, rasterizer.GetStatistics().pixelsWritten);
+    EXPECT_EQ(0xFF0000FFu, rasterizer.GetPixel(0, 0));
+    EXPECT_EQ(0xFF0000FFu, rasterizer.GetPixel(99, 69));
+    EXPECT_FLOAT_EQ(0.5f, rasterizer.GetDepth(2, 60));
+    EXPECT_FLOAT_EQ(0.75f, rasterizer.GetDepth(97, 60));
+    
+    // Behind the quad nothing passes the depth test; in front everything does
+    const std::vector<Vertex> behind = { vertex(-1, -1, 0.9f, green), vertex(3, -1, 0.9f, green), vertex(-1, 3, 0.9f, green) };
+    const std::vector<Vertex> front = { vertex(-1, -1, -0.5f, green), vertex(3, -1, -0.5f, green), vertex(-1, 3, -0.5f, green) };
+    rasterizer.DrawMesh(behind.data(), behind.size(), nullptr, behind.size(), Matrices());
+    rasterizer.Flush();
+    EXPECT_EQ(0u, rasterizer.GetStatistics().pixelsWritten);
+    rasterizer.DrawMesh(front.data(), front.size(), nullptr, front.size(), Matrices());
+    rasterizer.Flush();
+    EXPECT_EQ(100u * 70u, rasterizer.GetStatistics().pixelsWritten);
+    EXPECT_EQ(0xFF00FF00u, rasterizer.GetPixel(50, 35));
+    EXPECT_FLOAT_EQ(0.25f, rasterizer.GetDepth(50, 35));
+    
+    // Lit from behind only the ambient term remains
+    lighting.lightDirection = Gs::Vector3f(0.0f, 0.0f, 1.0f);
+    lighting.ambientColor = Gs::Vector3f(0.2f, 0.2f, 0.2f);
+    rasterizer.SetLighting(lighting);
+    rasterizer.Clear(Color(0.0f, 0.0f, 0.0f));
+    rasterizer.DrawMesh(front.data(), front.size(), nullptr, front.size(), Matrices());
+    rasterizer.Flush();
+    EXPECT_EQ(0xFF003300u, rasterizer.GetPixel(50, 35));
+}
+
+TEST(SoftwareRasterizerTest, RenderObjectsMatchAcrossThreadCounts) {
+    const MeshData sphere = GeometryGenerator::GenerateSphere(1.0f, 64, 32);
+    RenderObject object;
+    object.vertexBufferId = 1;
+    object.indexBufferId = 2;
+    object.indexCount = static_cast<std::uint32_t>(sphere.indices.size());
+    
+    // Perspective camera at the origin looking down -z
+    const float f = 1.0f / std::tan(0.5f);
+    const float nearPlane = 0.1f;
+    const float farPlane = 100.0f;
+    object.transform.projection.At(0, 0) = f * 200.0f / 320.0f;
+    object.transform.projection.At(1, 1) = f;
+    object.transform.projection.At(2, 2) = (farPlane + nearPlane) / (nearPlane - farPlane);
+    object.transform.projection.At(2, 3) = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    object.transform.projection.At(3, 2) = -1.0f;
+    object.transform.projection.At(3, 3) = 0.0f;
+    
+    ThreadPool pool(4);
+    std::vector<std::uint8_t> images[2];
+    SoftwareRasterizerStats stats[2];
+    for (int run = 0; run < 2; ++run) {
+        SoftwareRasterizer rasterizer(run == 0 ? nullptr : &pool);
+        ASSERT_TRUE(rasterizer.Resize(320, 200));
+        rasterizer.SetVertexBuffer(object.vertexBufferId, sphere.vertices);
+        rasterizer.SetIndexBuffer(object.indexBufferId, sphere.indices);
+        rasterizer.SetBackFaceCulling(true);
+        
+        // Overlapping spheres, some crossing the near plane and the image border
+        for (int i = 0; i < 24; ++i) {
+            object.transform.world.At(0, 3) = static_cast<float>(i % 6) - 2.5f;
+            object.transform.world.At(1, 3) = static_cast<float>(i / 6) - 1.5f;
+            object.transform.world.At(2, 3) = -1.0f - static_cast<float>(i % 5);
+            ASSERT_TRUE(rasterizer.Draw(object));
+        }
+        rasterizer.Flush();
+        rasterizer.ReadPixels(images[run]);
+        stats[run] = rasterizer.GetStatistics();
+        
+        RenderObject missing = object;
+        missing.vertexBufferId = 3;
+        EXPECT_FALSE(rasterizer.Draw(missing));
+    }
+    
+    ASSERT_EQ(320u * 200u * 4u, images[0].size());
+    EXPECT_TRUE(images[0] == images[1]);
+    EXPECT_EQ(stats[0].pixelsWritten, stats[1].pixelsWritten);
+    EXPECT_EQ(24u, stats[0].drawCount);
+    EXPECT_GT(stats[0].pixelsWritten, 320u * 200u / 2);
+    EXPECT_LT(stats[0].trianglesRasterized, stats[0].trianglesSubmitted * 3 / 4);
+}
+
+TEST(SoftwareRasterizerTest, RemoveAllBuffersDrawsPendingAndDropsMeshes) {
+    const MeshData sphere = GeometryGenerator::GenerateSphere(0.5f, 24, 12);
+    auto vertices = std::make_shared<const std::vector<Vertex>>(sphere.vertices);
+    auto indices = std::make_shared<const std::vector<std::uint32_t>>(sphere.indices);
+    RenderObject object;
+    object.vertexBufferId = 1;
+    object.indexBufferId = 2;
+    object.indexCount = static_cast<std::uint32_t>(sphere.indices.size());
+    
+    SoftwareRasterizer rasterizer;
+    ASSERT_TRUE(rasterizer.Resize(64, 64));
+    rasterizer.SetVertexBuffer(object.vertexBufferId, vertices);
+    rasterizer.SetIndexBuffer(object.indexBufferId, indices);
+    rasterizer.Clear(Color(0.0f, 0.0f, 0.0f));
+    ASSERT_TRUE(rasterizer.Draw(object));
+    
+    // The recorded draw still reads the meshes, so it runs before they are dropped
+    rasterizer.RemoveAllBuffers();
+    EXPECT_EQ(0u, rasterizer.GetPendingDrawCount());
+    EXPECT_EQ(1u, rasterizer.GetStatistics().drawCount);
+    EXPECT_NE(0xFF000000u, rasterizer.GetPixel(32, 32));
+    EXPECT_EQ(1, vertices.use_count());
+    EXPECT_EQ(1, indices.use_count());
+    EXPECT_FALSE(rasterizer.Draw(object));
+}
+
+// === FrameReadback Tests ===
+
+TEST(FrameReadbackTest, DeliversRasterizerFramesInOrder) {
+    SoftwareRasterizer rasterizer;
+    ASSERT_TRUE(rasterizer.Resize(64, 48));
+    
+    std::vector<std::uint64_t> frameNumbers;
+    std::vector<std::uint8_t> reds;
+    FrameReadback readback(nullptr, 2);
+    readback.SetSink([&](const ReadbackFrame& frame) {
+        // A slow sink makes the render thread wait for free frames
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_EQ(64u, frame.width);
+        EXPECT_EQ(48u, frame.height);
+        EXPECT_EQ(64u * 4u, frame.rowPitch);
+        EXPECT_EQ(255, frame.data[64 * 48 * 4 - 1]);
+        frameNumbers.push_back(frame.frameNumber);
+        reds.push_back(frame.data[0]);
+    });
+    
+    for (std::uint64_t frame = 0; frame < 8; ++frame) {
+        rasterizer.Clear(Color(static_cast<float>(frame) / 7.0f, 0.0f, 0.0f));
+        ASSERT_TRUE(readback.Request(rasterizer, frame));
+    }
+    readback.Flush();
+    
+    EXPECT_EQ(0u, readback.GetPendingCount());
+    ASSERT_EQ(8u, frameNumbers.size());
+    for (std::uint64_t frame = 0; frame < 8; ++frame) {
+        EXPECT_EQ(frame, frameNumbers[frame]);
+        EXPECT_EQ(static_cast<int>(std::lround(frame * 255.0 / 7.0)), reds[frame]);
+    }
+    
+    const FrameReadbackStats stats = readback.GetStatistics();
+    EXPECT_EQ(8u, stats.framesRequested);
+    EXPECT_EQ(8u, stats.framesDelivered);
+    EXPECT_EQ(0u, stats.framesDropped);
+    EXPECT_EQ(8u * 64u * 48u * 4u, stats.bytesDelivered);
+}
+
+TEST(FrameReadbackTest, DropsFramesWhenSinkFallsBehind) {
+    SoftwareRasterizer rasterizer;
+    ASSERT_TRUE(rasterizer.Resize(16, 16));
+    
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<std::uint64_t> frameNumbers;
+    FrameReadback readback(nullptr, 2);
+    readback.SetDropFramesWhenBehind(true);
+    readback.SetSink([&](const ReadbackFrame& frame) {
+        released.wait();
+        frameNumbers.push_back(frame.frameNumber);
+    });
+    
+    // Both frames of the ring stay in use until the sink is released
+    for (std::uint64_t frame = 0; frame < 4; ++frame) {
+        EXPECT_TRUE(readback.Request(rasterizer, frame));
+    }
+    EXPECT_EQ(2u, readback.GetPendingCount());
+    release.set_value();
+    readback.Flush();
+    
+    EXPECT_EQ((std::vector<std::uint64_t>{ 0, 1 }), frameNumbers);
+    const FrameReadbackStats stats = readback.GetStatistics();
+    EXPECT_EQ(4u, stats.framesRequested);
+    EXPECT_EQ(2u, stats.framesDelivered);
+    EXPECT_EQ(2u, stats.framesDropped);
+}
+
+// === BatchRenderer Tests ===
+
+TEST(BatchRendererTest, MixedSizeJobsMatchDirectRendering) {
+    const MeshData sphere = GeometryGenerator::GenerateSphere(0.5f, 24, 12);
+    ThreadPool pool(4);
+    BatchRenderer batch(&pool);
+    batch.SetVertexBuffer(1, sphere.vertices);
+    batch.SetIndexBuffer(2, sphere.indices);
+    
+    const std::uint32_t sizes[3][2] = { { 64, 64 }, { 96, 48 }, { 32, 80 } };
+    std::vector<BatchRenderJob> jobs;
+    for (int i = 0; i < 12; ++i) {
+        BatchRenderJob job;
+        job.width = sizes[i % 3][0];
+        job.height = sizes[i % 3][1];
+        job.clearColor = Color(static_cast<float>(i) / 11.0f, 0.2f, 0.4f);
+        RenderObject object;
+        object.vertexBufferId = 1;
+        object.indexBufferId = 2;
+        object.indexCount = static_cast<std::uint32_t>(sphere.indices.size());
+        object.transform.world.At(0, 3) = static_cast<float>(i % 4) * 0.2f - 0.3f;
+        job.objects.push_back(object);
+        jobs.push_back(job);
+    }
+    
+    std::vector<std::future<BatchRenderResult>> futures;
+    for (const BatchRenderJob& job : jobs) {
+        futures.push_back(batch.Submit(job));
+    }
+    BatchRenderJob missing = jobs[0];
+    missing.objects[0].vertexBufferId = 3;
+    std::future<BatchRenderResult> failed = batch.Submit(missing);
+    batch.WaitIdle();
+    EXPECT_EQ(0u, batch.GetPendingCount());
+    
+    std::vector<BatchRenderResult> results;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        SoftwareRasterizer rasterizer;
+        ASSERT_TRUE(rasterizer.Resize(static_cast<int>(jobs[i].width), static_cast<int>(jobs[i].height)));
+        rasterizer.SetVertexBuffer(1, sphere.vertices);
+        rasterizer.SetIndexBuffer(2, sphere.indices);
+        rasterizer.Clear(jobs[i].clearColor);
+        ASSERT_TRUE(rasterizer.Draw(jobs[i].objects[0]));
+        rasterizer.Flush();
+        std::vector<std::uint8_t> expected;
+        rasterizer.ReadPixels(expected);
+        
+        results.push_back(futures[i].get());
+        EXPECT_TRUE(results[i].success);
+        EXPECT_EQ(jobs[i].width, results[i].width);
+        EXPECT_EQ(jobs[i].height, results[i].height);
+        EXPECT_TRUE(results[i].pixels == expected) << "job " << i;
+    }
+    EXPECT_FALSE(failed.get().success);
+    
+    // Every rasterizer created for the burst stays pooled under the default limit
+    BatchRendererStats stats = batch.GetStatistics();
+    EXPECT_EQ(13u, stats.jobsSubmitted);
+    EXPECT_EQ(13u, stats.jobsCompleted);
+    EXPECT_EQ(1u, stats.jobsFailed);
+    EXPECT_EQ(13u, stats.targetsCreated + stats.targetsReused);
+    EXPECT_GE(stats.targetsCreated, 3u);
+    EXPECT_EQ(0u, stats.targetsEvicted);
+    EXPECT_EQ(stats.targetsCreated, batch.GetIdleTargetCount());
+    
+    // A pooled rasterizer of the size is reused, then the pool shrinks to the new limit
+    const std::uint64_t created = stats.targetsCreated;
+    batch.SetMaxIdleTargets(2);
+    EXPECT_TRUE(batch.Submit(jobs[1]).get().pixels == results[1].pixels);
+    batch.WaitIdle();
+    stats = batch.GetStatistics();
+    EXPECT_EQ(created, stats.targetsCreated);
+    EXPECT_EQ(14u - created, stats.targetsReused);
+    EXPECT_EQ(created - 2, stats.targetsEvicted);
+    EXPECT_EQ(2u, batch.GetIdleTargetCount());
+    
+    batch.ReleaseIdleTargets();
+    EXPECT_EQ(0u, batch.GetIdleTargetCount());
+}
+
+// === RenderGraph Tests ===
+
+TEST(RenderGraphTest, CullsUnusedPassesAndAliasesDisjointTextures) {
+    RenderGraph graph(nullptr);
+    
+    const RenderGraphTextureDesc colorDesc{640, 360, LLGL::Format::RGBA8UNorm};
+    const RenderGraphTextureDesc depthDesc{640, 360, LLGL::Format::D32Float};
+    const RenderGraphTextureDesc hdrDesc{640, 360, LLGL::Format::RGBA16Float};
+    
+    const RenderGraphResource shadow = graph.CreateTexture("Shadow", {1024, 1024, LLGL::Format::D32Float});
+    const RenderGraphResource albedo = graph.CreateTexture("Albedo", colorDesc);
+    const RenderGraphResource depth = graph.CreateTexture("Depth", depthDesc);
+    const RenderGraphResource hdr = graph.CreateTexture("HDR", hdrDesc);
+    const RenderGraphResource ldr = graph.CreateTexture("LDR", colorDesc);
+    const RenderGraphResource overlay = graph.CreateTexture("Overlay", colorDesc);
+    const RenderGraphResource debug = graph.CreateTexture("Debug", colorDesc);
+    
+    const std::uint32_t shadowPass = graph.AddPass("Shadow", [&](RenderGraphBuilder& builder) {
+        builder.WriteDepth(shadow);
+    }, nullptr);
+    const std::uint32_t gbufferPass = graph.AddPass("GBuffer", [&](RenderGraphBuilder& builder) {
+        builder.Read(shadow);
+        builder.WriteColor(albedo, Color(0.0f, 0.0f, 0.0f, 1.0f));
+        builder.WriteDepth(depth);
+    }, nullptr);
+    const std::uint32_t debugPass = graph.AddPass("DebugView", [&](RenderGraphBuilder& builder) {
+        builder.Read(albedo);
+        builder.WriteColor(debug, Color(0.0f, 0.0f, 0.0f, 1.0f));
+    }, nullptr);
+    const std::uint32_t lightingPass = graph.AddPass("Lighting", [&](RenderGraphBuilder& builder) {
+        builder.Read(albedo);
+        builder.Read(depth);
+        builder.WriteColor(hdr, Color(0.0f, 0.0f, 0.0f, 1.0f));
+    }, nullptr);
+    const std::uint32_t overwrittenPass = graph.AddPass("Overwritten", [&](RenderGraphBuilder& builder) {
+        builder.WriteColor(overlay, Color(1.0f, 0.0f, 0.0f, 1.0f));
+    }, nullptr);
+    const std::uint32_t overlayPass = graph.AddPass("Overlay", [&](RenderGraphBuilder& builder) {
+        builder.WriteColor(overlay, Color(0.0f, 0.0f, 0.0f, 0.0f));
+    }, nullptr);
+    const std::uint32_t tonemapPass = graph.AddPass("Tonemap", [&](RenderGraphBuilder& builder) {
+        builder.Read(hdr);
+        builder.Read(overlay);
+        builder.WriteColor(ldr, Color(0.0f, 0.0f, 0.0f, 1.0f));
+    }, nullptr);
+    const std::uint32_t presentPass = graph.AddPass("Present", [&](RenderGraphBuilder& builder) {
+        builder.Read(ldr);
+        builder.SetSideEffect();
+    }, nullptr);
+    
+    ASSERT_TRUE(graph.Compile());
+    
+    // Nothing reads the debug view, and the overlay is cleared again before anyone reads it
+    EXPECT_TRUE(graph.IsPassCulled(debugPass));
+    EXPECT_TRUE(graph.IsPassCulled(overwrittenPass));
+    for (std::uint32_t pass : {shadowPass, gbufferPass, lightingPass, overlayPass, tonemapPass, presentPass}) {
+        EXPECT_FALSE(graph.IsPassCulled(pass)) << pass;
+    }
+    
+    // Albedo is dead once lighting is done, so the overlay can take its memory, while the
+    // tonemapped image is written while the overlay is still read
+    EXPECT_TRUE(graph.AreAliased(albedo, overlay));
+    EXPECT_FALSE(graph.AreAliased(overlay, ldr));
+    EXPECT_FALSE(graph.AreAliased(hdr, ldr));
+    EXPECT_FALSE(graph.AreAliased(shadow, depth));
+    
+    const std::vector<RenderGraphBarrier>& barriers = graph.GetBarriers(lightingPass);
+    const bool albedoTransition = std::any_of(barriers.begin(), barriers.end(), [&](const RenderGraphBarrier& barrier) {
+        return barrier.resource == albedo
+            && barrier.before == RenderGraphUsage::ColorAttachment
+            && barrier.after == RenderGraphUsage::Sampled;
+    });
+    EXPECT_TRUE(albedoTransition);
+    
+    const RenderGraphStats& stats = graph.GetStatistics();
+    EXPECT_EQ(8u, stats.passesDeclared);
+    EXPECT_EQ(6u, stats.passesExecuted);
+    EXPECT_EQ(6u, stats.transientTextures);
+    EXPECT_EQ(5u, stats.physicalTextures);
+    EXPECT_EQ(stats.unaliasedMemoryBytes - RenderGraph::GetTextureMemory(colorDesc), stats.transientMemoryBytes);
+    EXPECT_EQ(0u, stats.texturesCreated);
+}
+
+// === FrameRing Tests ===
+
+TEST(FrameRingTest, SlotIndexWrapsAround) {
+    FrameRing ring(3);
+    ASSERT_EQ(3u, ring.GetSlotCount());
+    
+    std::vector<std::uint32_t> slots;
+    for (int frame = 0; frame < 7; ++frame) {
+        ring.BeginSlot(nullptr);
+        slots.push_back(ring.GetSlotIndex());
+        ring.MarkSubmitted();
+        ring.Advance();
+    }
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 1, 2, 0}), slots);
+    
+    ring.Reset(2);
+    EXPECT_EQ(0u, ring.GetSlotIndex());
+    EXPECT_FALSE(ring.IsSubmitted(0));
+}
+
+TEST(FrameRingTest, ReleasesRunAfterTheirSlotWasWaitedFor) {
+    FrameRing ring(2);
+    std::vector<std::string> events;
+    const FrameRing::WaitFunction wait = [&](std::uint32_t slot) {
+        events.push_back("wait" + std::to_string(slot));
+    };
+    
+    // Frame 0 in slot 0: nothing submitted yet, so no wait
+    EXPECT_FALSE(ring.BeginSlot(wait));
+    ring.DeferRelease([&]() { events.push_back("releaseA"); });
+    ring.MarkSubmitted();
+    ring.Advance();
+    
+    // Frame 1 in slot 1 must not touch slot 0's release
+    EXPECT_FALSE(ring.BeginSlot(wait));
+    ring.DeferRelease([&]() { events.push_back("releaseB"); });
+    ring.MarkSubmitted();
+    ring.Advance();
+    EXPECT_TRUE(events.empty());
+    EXPECT_EQ(2u, ring.GetPendingReleaseCount());
+    
+    // Frame 2 reuses slot 0: wait for frame 0's fence, then release what it used
+    EXPECT_TRUE(ring.IsSubmitted(0));
+    EXPECT_TRUE(ring.BeginSlot(wait));
+    EXPECT_EQ((std::vector<std::string>{"wait0", "releaseA"}), events);
+    EXPECT_FALSE(ring.IsSubmitted(0));
+    EXPECT_EQ(1u, ring.GetPendingReleaseCount());
+    
+    // Slot 0 was not submitted again, so reusing it needs no wait
+    EXPECT_FALSE(ring.BeginSlot(wait));
+    EXPECT_EQ(2u, events.size());
+    
+    ring.ReleaseAll();
+    EXPECT_EQ((std::vector<std::string>{"wait0", "releaseA", "releaseB"}), events);
+    EXPECT_EQ(0u, ring.GetPendingReleaseCount());
+    
+    // Without slots nothing is in flight
+    FrameRing empty;
+    bool released = false;
+    empty.DeferRelease([&]() { released = true; });
+    EXPECT_TRUE(released);
+}
+
+// === DrawBindState Tests ===
+
+TEST(DrawBindStateTest, EveryDrawSeesItsMaterialHeapAndMatrixBlock) {
+    DrawBindState state;
+    std::vector<std::string> binds;
+    
+    // What a slot-based backend has bound: a pipeline change drops both heaps, a heap bind only
+    // replaces its own slots. Material heaps and the block may share a slot in the worst case.
+    LLGL::ResourceHeap* boundMaterial = nullptr;
+    std::uint32_t boundBlock = UINT32_MAX;
+    
+    // Same sequence as RenderCommands: binds are recorded as issued, a draw binds the block first
+    auto bindPipeline = [&](std::uintptr_t pipeline) {
+        if (state.GetPipelineState() != FakePipeline(pipeline)) {
+            state.PipelineBound(FakePipeline(pipeline));
+            binds.push_back("pipeline" + std::to_string(pipeline));
+            boundMaterial = nullptr;
+            boundBlock = UINT32_MAX;
+        }
+    };
+    auto bindMaterial = [&](std::uintptr_t heap) {
+        if (state.GetResourceHeap() != FakeHeap(heap)) {
+            state.ResourceHeapBound(FakeHeap(heap));
+            binds.push_back("material" + std::to_string(heap));
+            boundMaterial = FakeHeap(heap);
+            boundBlock = UINT32_MAX;
+        }
+    };
+    auto draw = [&](std::uintptr_t material, std::uint32_t block) {
+        LLGL::ResourceHeap* blockHeap = nullptr;
+        std::uint32_t blockIndex = 0;
+        if (state.TakeMatrixBlock(blockHeap, blockIndex)) {
+            EXPECT_EQ(FakeHeap(9), blockHeap);
+            binds.push_back("block" + std::to_string(blockIndex));
+            boundBlock = blockIndex;
+        }
+        binds.push_back("draw");
+        
+        // Skipped redundant binds must never leave a draw without its material or block
+        EXPECT_EQ(FakeHeap(material), boundMaterial);
+        EXPECT_EQ(block, boundBlock);
+    };
+    
+    // The camera block is queued before the batch binds anything, as EndBatch and GPU culling do
+    state.SetMatrixBlock(FakeHeap(9), 3);
+    bindPipeline(1);
+    bindMaterial(1);
+    draw(1, 3);
+    bindMaterial(1);
+    draw(1, 3);
+    bindMaterial(2);
+    draw(2, 3);
+    bindPipeline(2);
+    bindMaterial(2);
+    draw(2, 3);
+    
+    // A per-draw block replaces the queued one without touching the material heap
+    state.SetMatrixBlock(FakeHeap(9), 4);
+    draw(2, 4);
+    bindMaterial(2);
+    draw(2, 4);
+    
+    EXPECT_EQ((std::vector<std::string>{
+        "pipeline1", "material1", "block3", "draw",
+        "draw",
+        "material2", "block3", "draw",
+        "pipeline2", "material2", "block3", "draw",
+        "block4", "draw",
+        "draw"}), binds);
+    EXPECT_EQ(FakeHeap(2), state.GetResourceHeap());
+    
+    // Without a queued block nothing extra is bound
+    state.Reset();
+    LLGL::ResourceHeap* blockHeap = nullptr;
+    std::uint32_t blockIndex = 0;
+    EXPECT_FALSE(state.TakeMatrixBlock(blockHeap, blockIndex));
+    EXPECT_EQ(nullptr, state.GetPipelineState());
+}
+
+TEST(DrawBindStateTest, MatrixBlocksAreOnlyUsedWithSlotBasedBindings) {
+    // Binding the block leaves the material heap bound only where heaps do not form one descriptor set
+    EXPECT_TRUE(UploadAllocator::SupportsBlockBinding("OpenGL 4.6"));
+    EXPECT_TRUE(UploadAllocator::SupportsBlockBinding("OpenGLES 3.0"));
+    EXPECT_TRUE(UploadAllocator::SupportsBlockBinding("WebGL 2.0"));
+    EXPECT_TRUE(UploadAllocator::SupportsBlockBinding("Null"));
+    EXPECT_FALSE(UploadAllocator::SupportsBlockBinding("Vulkan 1.3"));
+    EXPECT_FALSE(UploadAllocator::SupportsBlockBinding("Direct3D 12.0"));
+    EXPECT_TRUE(UploadAllocator::SupportsBlockBinding("Direct3D 11.1"));
+    EXPECT_FALSE(UploadAllocator::SupportsBlockBinding("Metal 3"));
+}
+
+// === AsyncResourceLoader Tests ===
+
+namespace {
+
+std::string WriteTestPpm(const std::string& directory, const std::string& name, std::uint32_t width) {
+    const std::string path = directory + "/" + name;
+    std::ofstream file(path, std::ios::binary);
+    file << "P6\n" << width << " 1\n255\n" << std::string(width * 3, '\x7f');
+    return path;
+}
+
+/**
+ * @brief Decoder that holds the single worker on its first call until Release()
+ */
+class GatedDecoder {
+public:
+    GatedDecoder() : released_(gate_.get_future().share()) {}
+    
+    ImageDecoder Get() {
+        return [this](const std::vector<std::uint8_t>& fileData, DecodedImage& image) {
+            started_ = true;
+            released_.wait();
+            std::lock_guard<std::mutex> lock(mutex_);
+            order_.push_back(fileData.size());
+            image.width = 1;
+            image.height = 1;
+            image.pixels.assign(4, 0xFF);
+            return true;
+        };
+    }
+    
+    void WaitStarted() {
+        while (!started_) {
+            std::this_thread::yield();
+        }
+    }
+    
+    void Release() { gate_.set_value(); }
+    
+    std::vector<std::size_t> GetOrder() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_;
+    }
+
+private:
+    std::promise<void> gate_;
+    std::shared_future<void> released_;
+    std::atomic<bool> started_{ false };
+    std::mutex mutex_;
+    std::vector<std::size_t> order_;
+};
+
+} // namespace
+
+TEST(AsyncResourceLoaderTest, LoadsByPriorityWithinTheBudget) {
+    const std::string directory = testing::TempDir() + "async_loader_priority";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    
+    // File sizes identify the requests in the decode order: 11 header bytes for one-digit widths
+    const auto sizeOf = [](std::uint32_t width) { return std::size_t(11 + width * 3); };
+    
+    AsyncResourceLoader loader(nullptr, 1);
+    GatedDecoder decoder;
+    loader.SetImageDecoder(decoder.Get());
+    
+    // Keep the only worker busy so the remaining requests queue up
+    const LoadHandle blocker = loader.LoadTexture(WriteTestPpm(directory, "blocker.ppm", 9));
+    decoder.WaitStarted();
+    const LoadHandle low = loader.LoadTexture(WriteTestPpm(directory, "low.ppm", 1), 0);
+    const LoadHandle high = loader.LoadTexture(WriteTestPpm(directory, "high.ppm", 2), 5);
+    const LoadHandle medium = loader.LoadTexture(WriteTestPpm(directory, "medium.ppm", 3), 1);
+    const LoadHandle highLater = loader.LoadTexture(WriteTestPpm(directory, "high_later.ppm", 4), 5);
+    EXPECT_EQ(LoadState::Placeholder, loader.GetState(high));
+    
+    decoder.Release();
+    loader.WaitIdle();
+    
+    // Highest priority first, oldest first within a priority
+    EXPECT_EQ((std::vector<std::size_t>{sizeOf(9), sizeOf(2), sizeOf(4), sizeOf(3), sizeOf(1)}), decoder.GetOrder());
+    
+    // A budget below one image still creates one resource per Update, highest priority first
+    EXPECT_EQ(1u, loader.Update(1));
+    EXPECT_EQ(LoadState::Ready, loader.GetState(high));
+    EXPECT_EQ(LoadState::Loading, loader.GetState(highLater));
+    EXPECT_EQ(4u, loader.GetStatistics().awaitingCreation);
+    
+    // Raising a priority reorders creation of already decoded requests
+    EXPECT_TRUE(loader.SetPriority(low, 10));
+    EXPECT_EQ(1u, loader.Update(1));
+    EXPECT_EQ(LoadState::Ready, loader.GetState(low));
+    EXPECT_EQ(LoadState::Loading, loader.GetState(highLater));
+    
+    EXPECT_EQ(3u, loader.Update());
+    for (LoadHandle handle : {blocker, medium, highLater}) {
+        EXPECT_EQ(LoadState::Ready, loader.GetState(handle));
+    }
+    EXPECT_EQ(5u, loader.GetStatistics().completed);
+    
+    std::filesystem::remove_all(directory);
+}
+
+TEST(AsyncResourceLoaderTest, CancelledRequestsAreNeverCreated) {
+    const std::string directory = testing::TempDir() + "async_loader_cancel";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    
+    AsyncResourceLoader loader(nullptr, 1);
+    GatedDecoder decoder;
+    loader.SetImageDecoder(decoder.Get());
+    
+    const LoadHandle blocker = loader.LoadTexture(WriteTestPpm(directory, "blocker.ppm", 2));
+    decoder.WaitStarted();
+    
+    // Requests queued from here on use the built-in PPM decoder
+    loader.SetImageDecoder(nullptr);
+    const LoadHandle cancelledQueued = loader.LoadTexture(WriteTestPpm(directory, "queued.ppm", 3), 5);
+    const LoadHandle kept = loader.LoadTexture(WriteTestPpm(directory, "kept.ppm", 4));
+    const LoadHandle cancelledDecoded = loader.LoadTexture(WriteTestPpm(directory, "decoded.ppm", 5));
+    const LoadHandle missing = loader.LoadTexture(directory + "/missing.ppm");
+    
+    EXPECT_TRUE(loader.Cancel(cancelledQueued));
+    EXPECT_FALSE(loader.Cancel(cancelledQueued));
+    EXPECT_EQ(LoadState::Cancelled, loader.GetState(cancelledQueued));
+    
+    decoder.Release();
+    loader.WaitIdle();
+    
+    // Cancelling after decoding still prevents creation
+    EXPECT_TRUE(loader.Cancel(cancelledDecoded));
+    EXPECT_EQ(1u, decoder.GetOrder().size());
+    
+    EXPECT_EQ(3u, loader.Update());
+    EXPECT_EQ(LoadState::Ready, loader.GetState(blocker));
+    EXPECT_EQ(LoadState::Ready, loader.GetState(kept));
+    EXPECT_EQ(LoadState::Failed, loader.GetState(missing));
+    EXPECT_EQ(LoadState::Cancelled, loader.GetState(cancelledQueued));
+    EXPECT_EQ(LoadState::Cancelled, loader.GetState(cancelledDecoded));
+    EXPECT_FALSE(loader.Cancel(kept));
+    
+    const AsyncLoaderStats& stats = loader.GetStatistics();
+    EXPECT_EQ(2u, stats.completed);
+    EXPECT_EQ(1u, stats.failed);
+    EXPECT_EQ(2u, stats.cancelled);
+    EXPECT_EQ(0u, stats.awaitingCreation);
+    
+    // Released handles are invalid
+    loader.Release(kept);
+    EXPECT_EQ(LoadState::Failed, loader.GetState(kept));
+    
+    std::filesystem::remove_all(directory);
+}